@@ -1,10 +1,12 @@
 TEMPLATE = subdirs
-SUBDIRS = YUViewLib YUViewApp
+SUBDIRS = YUViewLib YUViewApp YUViewDecoderHost
 
 YUViewApp.subdir = YUViewApp
 YUViewLib.subdir = YUViewLib
+YUViewDecoderHost.subdir = YUViewDecoderHost
 
 YUViewApp.depends = YUViewLib
+YUViewDecoderHost.depends = YUViewLib
 
 UNITTESTS {
   SUBDIRS += Googletest
@@ -15,3 +17,9 @@ UNITTESTS {
   YUViewUnitTest.depends = Googletest
   YUViewUnitTest.depends = YUViewLib
 }
+
+BENCHMARKS {
+  SUBDIRS += YUViewBenchmark
+  YUViewBenchmark.subdir = YUViewBenchmark
+  YUViewBenchmark.depends = YUViewLib
+}
@@ -0,0 +1,24 @@
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewBenchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+CONFIG += c++17
+
+SOURCES += $$files(src/*.cpp, false) \
+           $$top_srcdir/YUViewUnitTest/common/TemporaryFile.cpp
+HEADERS += $$files(src/*.h, false) \
+           $$top_srcdir/YUViewUnitTest/common/TemporaryFile.h
+
+INCLUDEPATH += $$top_srcdir/YUViewLib/src \
+               $$top_srcdir/YUViewUnitTest/common
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
+
+win32-msvc* {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/YUViewLib.lib
+} else {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/libYUViewLib.a
+}
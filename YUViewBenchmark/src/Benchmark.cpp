@@ -0,0 +1,155 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+
+namespace benchmark
+{
+
+namespace
+{
+
+std::string escapeJSONString(const std::string &str)
+{
+  std::string escaped;
+  for (const auto c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+BenchmarkResult runBenchmark(const std::string &name,
+                             const BenchmarkCase &benchmarkCase,
+                             const RunSettings &  settings)
+{
+  using Clock = std::chrono::steady_clock;
+
+  // One run to warm up caches and lazy initializations
+  benchmarkCase.run();
+
+  std::vector<double> durationsNs;
+  const auto          start = Clock::now();
+  while (durationsNs.size() < settings.maxRuns &&
+         (durationsNs.size() < settings.minRuns || Clock::now() - start < settings.minTime))
+  {
+    const auto runStart = Clock::now();
+    benchmarkCase.run();
+    const auto runEnd = Clock::now();
+    durationsNs.push_back(
+        double(std::chrono::duration_cast<std::chrono::nanoseconds>(runEnd - runStart).count()));
+  }
+
+  std::sort(durationsNs.begin(), durationsNs.end());
+
+  BenchmarkResult result;
+  result.name        = name;
+  result.runs        = unsigned(durationsNs.size());
+  result.bytesPerRun = benchmarkCase.bytesPerRun;
+  result.minNs       = durationsNs.front();
+  result.medianNs    = durationsNs.at(durationsNs.size() / 2);
+  result.meanNs =
+      std::accumulate(durationsNs.begin(), durationsNs.end(), 0.0) / double(durationsNs.size());
+  return result;
+}
+
+} // namespace
+
+double BenchmarkResult::getThroughputMBps() const
+{
+  if (this->bytesPerRun <= 0 || this->medianNs <= 0)
+    return 0.0;
+  return double(this->bytesPerRun) / this->medianNs * 1e9 / (1024.0 * 1024.0);
+}
+
+void BenchmarkRegistry::add(const std::string &name, SetupFunction setup)
+{
+  this->benchmarks.push_back({name, std::move(setup)});
+}
+
+std::vector<std::string> BenchmarkRegistry::getNames() const
+{
+  std::vector<std::string> names;
+  for (const auto &benchmark : this->benchmarks)
+    names.push_back(benchmark.name);
+  return names;
+}
+
+std::vector<BenchmarkResult> BenchmarkRegistry::run(const RunSettings &settings,
+                                                    std::ostream &     progress) const
+{
+  std::vector<BenchmarkResult> results;
+  for (const auto &benchmark : this->benchmarks)
+  {
+    if (!settings.filter.empty() && benchmark.name.find(settings.filter) == std::string::npos)
+      continue;
+
+    progress << benchmark.name << " ... " << std::flush;
+    const auto benchmarkCase = benchmark.setup();
+    const auto result        = runBenchmark(benchmark.name, benchmarkCase, settings);
+    progress << std::fixed << std::setprecision(3) << result.medianNs / 1e6 << " ms";
+    if (const auto throughput = result.getThroughputMBps(); throughput > 0)
+      progress << " (" << std::setprecision(1) << throughput << " MB/s)";
+    progress << "\n";
+
+    results.push_back(result);
+  }
+  return results;
+}
+
+void writeResultsAsJSON(const std::vector<BenchmarkResult> &results, std::ostream &out)
+{
+  out << "{\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const auto &result = results[i];
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\"name\": \"" << escapeJSONString(result.name) << "\", ";
+    out << "\"runs\": " << result.runs << ", ";
+    out << "\"bytesPerRun\": " << result.bytesPerRun << ", ";
+    out << std::fixed << std::setprecision(0);
+    out << "\"minNs\": " << result.minNs << ", ";
+    out << "\"medianNs\": " << result.medianNs << ", ";
+    out << "\"meanNs\": " << result.meanNs << ", ";
+    out << std::setprecision(2);
+    out << "\"throughputMBps\": " << result.getThroughputMBps() << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+} // namespace benchmark
@@ -0,0 +1,118 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+// What a benchmark runs. The setup of a benchmark (generating the input data) returns this. Only
+// the run function is timed.
+struct BenchmarkCase
+{
+  std::function<void()> run;
+  // The number of input bytes that one run processes. Used to calculate the throughput.
+  int64_t bytesPerRun{};
+};
+
+using SetupFunction = std::function<BenchmarkCase()>;
+
+struct BenchmarkResult
+{
+  std::string name;
+  unsigned    runs{};
+  int64_t     bytesPerRun{};
+  double      minNs{};
+  double      medianNs{};
+  double      meanNs{};
+
+  // In MB/s based on the median run time. 0 if the benchmark did not set bytesPerRun.
+  double getThroughputMBps() const;
+};
+
+struct RunSettings
+{
+  // Only run benchmarks whose name contains this string
+  std::string filter;
+  // Repeat each benchmark until this much time was spent (but at least minRuns times)
+  std::chrono::milliseconds minTime{500};
+  unsigned                  minRuns{5};
+  unsigned                  maxRuns{10000};
+};
+
+class BenchmarkRegistry
+{
+public:
+  void add(const std::string &name, SetupFunction setup);
+
+  std::vector<std::string>     getNames() const;
+  std::vector<BenchmarkResult> run(const RunSettings &settings, std::ostream &progress) const;
+
+private:
+  struct Benchmark
+  {
+    std::string   name;
+    SetupFunction setup;
+  };
+  std::vector<Benchmark> benchmarks;
+};
+
+void writeResultsAsJSON(const std::vector<BenchmarkResult> &results, std::ostream &out);
+
+// Prevent the compiler from optimizing away the calculation of a value that is not used otherwise.
+// The value must be in a register or in memory at this point and the compiler must assume that
+// all memory is read and written here, so no work is moved across the call.
+template <typename T> void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+void registerConversionBenchmarks(BenchmarkRegistry &registry);
+void registerParserBenchmarks(BenchmarkRegistry &registry);
+void registerStatisticsBenchmarks(BenchmarkRegistry &registry);
+void registerDifferenceBenchmarks(BenchmarkRegistry &registry);
+
+} // namespace benchmark
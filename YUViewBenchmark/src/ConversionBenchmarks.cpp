@@ -0,0 +1,131 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <video/rgb/ConversionRGB.h>
+
+#include <QImage>
+
+#include <array>
+#include <memory>
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr Size FRAME_SIZE = {1920, 1080};
+
+constexpr std::array BIT_DEPTHS = {8u, 10u, 12u, 16u};
+
+void addYUVConversionBenchmark(BenchmarkRegistry &               registry,
+                               const video::yuv::PixelFormatYUV &format)
+{
+  registry.add("ConvertYUVToRGB/" + format.getName(), [format]() {
+    const auto rawData =
+        generateRandomSamples(size_t(format.bytesPerFrame(FRAME_SIZE)), format.getBitsPerSample());
+    auto handler = createYUVHandler(format, FRAME_SIZE, rawData);
+
+    BenchmarkCase benchmarkCase;
+    benchmarkCase.bytesPerRun = rawData.size();
+    benchmarkCase.run         = [handler]() {
+      QImage image;
+      handler->loadFrameForCaching(0, image);
+      doNotOptimize(image);
+    };
+    return benchmarkCase;
+  });
+}
+
+void addRGBConversionBenchmark(BenchmarkRegistry &               registry,
+                               const video::rgb::PixelFormatRGB &format)
+{
+  registry.add("ConvertRGBToARGB/" + format.getName(), [format]() {
+    const auto rawData =
+        generateRandomSamples(format.bytesPerFrame(FRAME_SIZE), format.getBitsPerSample());
+    auto outputBuffer =
+        std::make_shared<std::vector<unsigned char>>(FRAME_SIZE.width * FRAME_SIZE.height * 4);
+
+    BenchmarkCase benchmarkCase;
+    benchmarkCase.bytesPerRun = rawData.size();
+    benchmarkCase.run         = [format, rawData, outputBuffer]() {
+      const bool componentInvert[4] = {false, false, false, false};
+      const int  componentScale[4]  = {1, 1, 1, 1};
+      video::rgb::convertInputRGBToARGB(rawData,
+                                        format,
+                                        outputBuffer->data(),
+                                        FRAME_SIZE,
+                                        componentInvert,
+                                        componentScale,
+                                        false,
+                                        false,
+                                        false);
+      doNotOptimize(outputBuffer->front());
+    };
+    return benchmarkCase;
+  });
+}
+
+} // namespace
+
+void registerConversionBenchmarks(BenchmarkRegistry &registry)
+{
+  using video::yuv::PixelFormatYUV;
+  using video::yuv::Subsampling;
+
+  for (const auto subsampling : {Subsampling::YUV_444,
+                                 Subsampling::YUV_422,
+                                 Subsampling::YUV_420,
+                                 Subsampling::YUV_440,
+                                 Subsampling::YUV_410,
+                                 Subsampling::YUV_411,
+                                 Subsampling::YUV_400})
+    for (const auto bitDepth : BIT_DEPTHS)
+      addYUVConversionBenchmark(registry, PixelFormatYUV(subsampling, bitDepth));
+
+  addYUVConversionBenchmark(
+      registry, PixelFormatYUV(Subsampling::YUV_422, 8, video::yuv::PackingOrder::UYVY));
+  addYUVConversionBenchmark(registry, PixelFormatYUV(video::yuv::PredefinedPixelFormat::V210));
+
+  using video::rgb::ChannelOrder;
+  using video::rgb::PixelFormatRGB;
+
+  for (const auto dataLayout : {video::DataLayout::Planar, video::DataLayout::Packed})
+    for (const auto bitDepth : BIT_DEPTHS)
+      addRGBConversionBenchmark(registry,
+                                PixelFormatRGB(bitDepth, dataLayout, ChannelOrder::RGB));
+}
+
+} // namespace benchmark
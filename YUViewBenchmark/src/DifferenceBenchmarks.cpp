@@ -0,0 +1,84 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <QImage>
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr Size DIFFERENCE_FRAME_SIZE = {1920, 1080};
+
+void addDifferenceBenchmark(BenchmarkRegistry &               registry,
+                            const video::yuv::PixelFormatYUV &format)
+{
+  registry.add("DifferenceAndPSNR/" + format.getName(), [format]() {
+    const auto nrBytes  = size_t(format.bytesPerFrame(DIFFERENCE_FRAME_SIZE));
+    const auto bitDepth = format.getBitsPerSample();
+
+    auto handler0 = createYUVHandler(
+        format, DIFFERENCE_FRAME_SIZE, generateRandomSamples(nrBytes, bitDepth, 1));
+    auto handler1 = createYUVHandler(
+        format, DIFFERENCE_FRAME_SIZE, generateRandomSamples(nrBytes, bitDepth, 2));
+
+    BenchmarkCase benchmarkCase;
+    benchmarkCase.bytesPerRun = int64_t(nrBytes) * 2;
+    benchmarkCase.run         = [handler0, handler1]() {
+      // The difference info list contains the MSE and PSNR per component
+      QList<InfoItem> differenceInfoList;
+      const auto      image =
+          handler0->calculateDifference(handler1.get(), 0, 0, differenceInfoList, 1, false);
+      doNotOptimize(image);
+      doNotOptimize(differenceInfoList);
+    };
+    return benchmarkCase;
+  });
+}
+
+} // namespace
+
+void registerDifferenceBenchmarks(BenchmarkRegistry &registry)
+{
+  using video::yuv::PixelFormatYUV;
+  using video::yuv::Subsampling;
+
+  addDifferenceBenchmark(registry, PixelFormatYUV(Subsampling::YUV_420, 8));
+  addDifferenceBenchmark(registry, PixelFormatYUV(Subsampling::YUV_420, 10));
+  addDifferenceBenchmark(registry, PixelFormatYUV(Subsampling::YUV_444, 8));
+}
+
+} // namespace benchmark
@@ -0,0 +1,186 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <TemporaryFile.h>
+#include <filesource/FileSourceAnnexBFile.h>
+#include <parser/common/SubByteReader.h>
+
+#include <memory>
+#include <random>
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr size_t BITSTREAM_SIZE = 1024 * 1024;
+constexpr size_t ANNEXB_SIZE    = 32 * 1024 * 1024;
+
+// Make the protected reading functions accessible
+class BenchmarkSubByteReader : public parser::SubByteReader
+{
+public:
+  using SubByteReader::readBits;
+  using SubByteReader::readUE_V;
+  using SubByteReader::SubByteReader;
+};
+
+class BitWriter
+{
+public:
+  void writeBits(uint64_t value, unsigned nrBits)
+  {
+    for (unsigned i = nrBits; i > 0; i--)
+    {
+      if (this->bitPos == 0)
+        this->data.push_back(0);
+      const auto bit = (value >> (i - 1)) & 1;
+      this->data.back() |= static_cast<unsigned char>(bit << (7 - this->bitPos));
+      this->bitPos = (this->bitPos + 1) % 8;
+    }
+  }
+
+  void writeUE_V(uint64_t value)
+  {
+    const auto codeNum = value + 1;
+    unsigned   nrBits  = 0;
+    while ((codeNum >> nrBits) > 1)
+      nrBits++;
+    this->writeBits(0, nrBits);
+    this->writeBits(codeNum, nrBits + 1);
+  }
+
+  ByteVector data;
+
+private:
+  unsigned bitPos{0};
+};
+
+// Exp-Golomb codes of random values. Start code emulation (0x000000 - 0x000003) can not occur
+// because the codes of values below 128 contain at most 7 leading zero bits.
+ByteVector generateExpGolombBitstream(size_t nrBytes)
+{
+  std::mt19937                            generator(SYNTHETIC_DATA_SEED);
+  std::uniform_int_distribution<uint64_t> distribution(0, 127);
+
+  BitWriter writer;
+  while (writer.data.size() < nrBytes)
+    writer.writeUE_V(distribution(generator));
+  return writer.data;
+}
+
+// NAL units of random sizes (up to 64kB) with random payloads from which all start codes were
+// removed
+ByteVector generateAnnexBStream(size_t nrBytes)
+{
+  std::mt19937                          generator(SYNTHETIC_DATA_SEED);
+  std::uniform_int_distribution<size_t> nalSizeDistribution(16, 64 * 1024);
+
+  auto data = generateRandomBytes(nrBytes);
+  for (size_t i = 0; i + 2 < data.size(); i++)
+    if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] <= 3)
+      data[i + 2] = 4;
+
+  size_t pos = 0;
+  while (pos + 4 < data.size())
+  {
+    data[pos]     = 0;
+    data[pos + 1] = 0;
+    data[pos + 2] = 0;
+    data[pos + 3] = 1;
+    pos += nalSizeDistribution(generator);
+  }
+  return data;
+}
+
+} // namespace
+
+void registerParserBenchmarks(BenchmarkRegistry &registry)
+{
+  registry.add("SubByteReader/readBits", []() {
+    const auto data = generateRandomBytes(BITSTREAM_SIZE);
+
+    BenchmarkCase benchmarkCase;
+    benchmarkCase.bytesPerRun = int64_t(data.size());
+    benchmarkCase.run         = [data]() {
+      BenchmarkSubByteReader reader(data);
+      reader.disableEmulationPrevention();
+      uint64_t sum    = 0;
+      unsigned nrBits = 1;
+      while (reader.canReadBits(nrBits))
+      {
+        sum += std::get<0>(reader.readBits(nrBits));
+        nrBits = nrBits % 17 + 1;
+      }
+      doNotOptimize(sum);
+    };
+    return benchmarkCase;
+  });
+
+  registry.add("SubByteReader/readUE_V", []() {
+    const auto data = generateExpGolombBitstream(BITSTREAM_SIZE);
+
+    BenchmarkCase benchmarkCase;
+    benchmarkCase.bytesPerRun = int64_t(data.size());
+    benchmarkCase.run         = [data]() {
+      BenchmarkSubByteReader reader(data);
+      uint64_t               sum = 0;
+      // The longest code of the generated values has 15 bits
+      while (reader.canReadBits(15))
+        sum += std::get<0>(reader.readUE_V());
+      doNotOptimize(sum);
+    };
+    return benchmarkCase;
+  });
+
+  registry.add("AnnexB/StartCodeScanning", []() {
+    const auto file =
+        std::make_shared<yuviewTest::TemporaryFile>(generateAnnexBStream(ANNEXB_SIZE));
+
+    BenchmarkCase benchmarkCase;
+    benchmarkCase.bytesPerRun = int64_t(ANNEXB_SIZE);
+    benchmarkCase.run         = [file]() {
+      FileSourceAnnexBFile annexBFile(file->getFilePath());
+      int64_t              nrNalUnits = 0;
+      while (annexBFile.getNextNALUnit().size() > 0)
+        nrNalUnits++;
+      doNotOptimize(nrNalUnits);
+    };
+    return benchmarkCase;
+  });
+}
+
+} // namespace benchmark
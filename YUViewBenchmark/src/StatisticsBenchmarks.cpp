@@ -0,0 +1,151 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <TemporaryFile.h>
+#include <statistics/StatisticsFileCSV.h>
+#include <statistics/StatisticsFileVTMBMS.h>
+
+#include <memory>
+#include <random>
+#include <sstream>
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr Size     STATISTICS_FRAME_SIZE = {1920, 1080};
+constexpr unsigned STATISTICS_BLOCK_SIZE = 16;
+constexpr int      STATISTICS_NR_FRAMES  = 8;
+
+// One value type (ID 0) and one vector type (ID 1) for every block of every frame
+ByteVector generateCSVStatistics()
+{
+  std::mt19937                       generator(SYNTHETIC_DATA_SEED);
+  std::uniform_int_distribution<int> valueDistribution(0, 4);
+  std::uniform_int_distribution<int> vectorDistribution(-256, 256);
+
+  std::ostringstream stream;
+  stream << "%;syntax-version;v1.2\n";
+  stream << "%;seq-specs;benchmark;0;" << STATISTICS_FRAME_SIZE.width << ";"
+         << STATISTICS_FRAME_SIZE.height << ";50;\n";
+  stream << "%;type;0;PredMode;range;\n";
+  stream << "%;defaultRange;0;4;jet\n";
+  stream << "%;type;1;MVL0;vector;\n";
+  stream << "%;vectorColor;100;0;0;255\n";
+  stream << "%;scaleFactor;4\n";
+  for (int poc = 0; poc < STATISTICS_NR_FRAMES; poc++)
+    for (unsigned y = 0; y < STATISTICS_FRAME_SIZE.height; y += STATISTICS_BLOCK_SIZE)
+      for (unsigned x = 0; x < STATISTICS_FRAME_SIZE.width; x += STATISTICS_BLOCK_SIZE)
+      {
+        const auto block = std::to_string(poc) + ";" + std::to_string(x) + ";" +
+                           std::to_string(y) + ";" + std::to_string(STATISTICS_BLOCK_SIZE) + ";" +
+                           std::to_string(STATISTICS_BLOCK_SIZE) + ";";
+        stream << block << "0;" << valueDistribution(generator) << "\n";
+        stream << block << "1;" << vectorDistribution(generator) << ";"
+               << vectorDistribution(generator) << "\n";
+      }
+
+  const auto str = stream.str();
+  return ByteVector(str.begin(), str.end());
+}
+
+ByteVector generateVTMBMSStatistics()
+{
+  std::mt19937                       generator(SYNTHETIC_DATA_SEED);
+  std::uniform_int_distribution<int> valueDistribution(0, 4);
+  std::uniform_int_distribution<int> vectorDistribution(-256, 256);
+
+  std::ostringstream stream;
+  stream << "# VTMBMS Block Statistics\n";
+  stream << "# Sequence size: [" << STATISTICS_FRAME_SIZE.width << "x"
+         << STATISTICS_FRAME_SIZE.height << "]\n";
+  stream << "# Block Statistic Type: PredMode; Integer; [0, 4]\n";
+  stream << "# Block Statistic Type: MVL0; Vector; Scale: 4\n";
+  for (int poc = 0; poc < STATISTICS_NR_FRAMES; poc++)
+    for (unsigned y = 0; y < STATISTICS_FRAME_SIZE.height; y += STATISTICS_BLOCK_SIZE)
+      for (unsigned x = 0; x < STATISTICS_FRAME_SIZE.width; x += STATISTICS_BLOCK_SIZE)
+      {
+        const auto block = "BlockStat: POC " + std::to_string(poc) + " @(" + std::to_string(x) +
+                           ", " + std::to_string(y) + ") [" +
+                           std::to_string(STATISTICS_BLOCK_SIZE) + "x" +
+                           std::to_string(STATISTICS_BLOCK_SIZE) + "] ";
+        stream << block << "PredMode=" << valueDistribution(generator) << "\n";
+        stream << block << "MVL0={ " << vectorDistribution(generator) << ", "
+               << vectorDistribution(generator) << "}\n";
+      }
+
+  const auto str = stream.str();
+  return ByteVector(str.begin(), str.end());
+}
+
+// Open the file, scan it for the positions of all frames and load all frames
+template <typename StatisticsFileType>
+BenchmarkCase createStatisticsParsingCase(const ByteVector &fileData)
+{
+  const auto file = std::make_shared<yuviewTest::TemporaryFile>(fileData);
+
+  BenchmarkCase benchmarkCase;
+  benchmarkCase.bytesPerRun = int64_t(fileData.size());
+  benchmarkCase.run         = [file]() {
+    stats::StatisticsData statisticsData;
+    StatisticsFileType    statisticsFile(QString::fromStdString(file->getFilePathString()),
+                                      statisticsData);
+
+    std::atomic_bool breakFunction{false};
+    statisticsFile.readFrameAndTypePositionsFromFile(breakFunction);
+
+    for (int poc = 0; poc < STATISTICS_NR_FRAMES; poc++)
+      for (const auto &type : statisticsData.getStatisticsTypes())
+        statisticsFile.loadStatisticData(statisticsData, poc, type.typeID);
+    doNotOptimize(statisticsData);
+  };
+  return benchmarkCase;
+}
+
+} // namespace
+
+void registerStatisticsBenchmarks(BenchmarkRegistry &registry)
+{
+  registry.add("Statistics/ParseCSV", []() {
+    return createStatisticsParsingCase<stats::StatisticsFileCSV>(generateCSVStatistics());
+  });
+  registry.add("Statistics/ParseVTMBMS", []() {
+    return createStatisticsParsingCase<stats::StatisticsFileVTMBMS>(generateVTMBMSStatistics());
+  });
+}
+
+} // namespace benchmark
@@ -0,0 +1,92 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyntheticData.h"
+
+#include <random>
+
+namespace benchmark
+{
+
+ByteVector generateRandomBytes(size_t nrBytes, unsigned seed)
+{
+  std::mt19937                            generator(seed);
+  std::uniform_int_distribution<unsigned> distribution(0, 255);
+
+  ByteVector data(nrBytes);
+  for (auto &byte : data)
+    byte = static_cast<ByteVector::value_type>(distribution(generator));
+  return data;
+}
+
+QByteArray generateRandomQByteArray(size_t nrBytes, unsigned seed)
+{
+  const auto data = generateRandomBytes(nrBytes, seed);
+  return QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
+}
+
+QByteArray generateRandomSamples(size_t nrBytes, unsigned bitDepth, unsigned seed)
+{
+  if (bitDepth <= 8)
+    return generateRandomQByteArray(nrBytes, seed);
+
+  std::mt19937                            generator(seed);
+  std::uniform_int_distribution<unsigned> distribution(0, (1u << bitDepth) - 1);
+
+  QByteArray data(int(nrBytes), 0);
+  for (size_t i = 0; i + 1 < nrBytes; i += 2)
+  {
+    const auto sample = distribution(generator);
+    data[int(i)]      = char(sample & 0xff);
+    data[int(i + 1)]  = char(sample >> 8);
+  }
+  return data;
+}
+
+std::shared_ptr<video::yuv::videoHandlerYUV>
+createYUVHandler(const video::yuv::PixelFormatYUV &format, Size frameSize, QByteArray rawData)
+{
+  auto handler = std::make_shared<video::yuv::videoHandlerYUV>();
+  handler->setFrameSize(frameSize);
+  handler->setPixelFormatYUV(format, false);
+
+  auto handlerPointer = handler.get();
+  QObject::connect(handlerPointer,
+                   &video::videoHandler::signalRequestRawData,
+                   [handlerPointer, rawData](int frameIndex, bool) {
+                     handlerPointer->rawData            = rawData;
+                     handlerPointer->rawData_frameIndex = frameIndex;
+                   });
+  return handler;
+}
+
+} // namespace benchmark
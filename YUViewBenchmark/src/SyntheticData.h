@@ -0,0 +1,61 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QByteArray>
+
+#include <memory>
+
+namespace benchmark
+{
+
+// All inputs are generated from a fixed seed so that every run of the benchmarks processes the
+// same data.
+constexpr unsigned SYNTHETIC_DATA_SEED = 42;
+
+ByteVector generateRandomBytes(size_t nrBytes, unsigned seed = SYNTHETIC_DATA_SEED);
+QByteArray generateRandomQByteArray(size_t nrBytes, unsigned seed = SYNTHETIC_DATA_SEED);
+
+// Random samples with the given bit depth. Samples above 8 bit are stored in 2 bytes (little
+// endian) as in raw YUV/RGB files.
+QByteArray
+generateRandomSamples(size_t nrBytes, unsigned bitDepth, unsigned seed = SYNTHETIC_DATA_SEED);
+
+// A YUV handler that answers all requests for raw data with the given frame
+std::shared_ptr<video::yuv::videoHandlerYUV>
+createYUVHandler(const video::yuv::PixelFormatYUV &format, Size frameSize, QByteArray rawData);
+
+} // namespace benchmark
@@ -0,0 +1,144 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <QApplication>
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+/* Microbenchmarks of the performance critical parts of YUView (conversion, parsing, statistics,
+ * difference). All inputs are generated synthetically so no sample files are needed. The results
+ * are written as JSON so that they can be tracked in CI.
+ *
+ * Usage: YUViewBenchmark [--filter <substring>] [--min-time <ms>] [--output <file.json>] [--list]
+ */
+
+namespace
+{
+
+void printUsage()
+{
+  std::cout << "Usage: YUViewBenchmark [options]\n"
+               "  --filter <substring>  Only run benchmarks whose name contains the substring\n"
+               "  --min-time <ms>       Minimum time to spend on each benchmark (default 500)\n"
+               "  --output <file>       Write the results as JSON to the file (default stdout)\n"
+               "  --list                List all benchmarks and exit\n";
+}
+
+std::optional<std::chrono::milliseconds> parseMilliseconds(const std::string &text)
+{
+  int        value{};
+  const auto end    = text.data() + text.size();
+  const auto result = std::from_chars(text.data(), end, value);
+  if (result.ec != std::errc() || result.ptr != end || value < 0)
+    return {};
+  return std::chrono::milliseconds(value);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  // The conversion uses QPixmap to get the platform image format which needs a gui application.
+  // No window is ever shown, so run without a display if none is configured.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  QApplication application(argc, argv);
+  QApplication::setApplicationName("YUViewBenchmark");
+
+  benchmark::RunSettings settings;
+  std::string            outputFile;
+  bool                   listOnly = false;
+  for (int i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    const auto        hasValue = (i + 1 < argc);
+    if (argument == "--filter" && hasValue)
+      settings.filter = argv[++i];
+    else if (argument == "--min-time" && hasValue)
+    {
+      const std::string value   = argv[++i];
+      const auto        minTime = parseMilliseconds(value);
+      if (!minTime)
+      {
+        std::cerr << "Invalid value for --min-time: " << value << "\n";
+        printUsage();
+        return 1;
+      }
+      settings.minTime = *minTime;
+    }
+    else if (argument == "--output" && hasValue)
+      outputFile = argv[++i];
+    else if (argument == "--list")
+      listOnly = true;
+    else
+    {
+      printUsage();
+      return argument == "--help" ? 0 : 1;
+    }
+  }
+
+  benchmark::BenchmarkRegistry registry;
+  benchmark::registerConversionBenchmarks(registry);
+  benchmark::registerParserBenchmarks(registry);
+  benchmark::registerStatisticsBenchmarks(registry);
+  benchmark::registerDifferenceBenchmarks(registry);
+
+  if (listOnly)
+  {
+    for (const auto &name : registry.getNames())
+      std::cout << name << "\n";
+    return 0;
+  }
+
+  // Progress goes to stderr so that stdout only contains the JSON
+  const auto results = registry.run(settings, std::cerr);
+
+  if (outputFile.empty())
+    benchmark::writeResultsAsJSON(results, std::cout);
+  else
+  {
+    std::ofstream out(outputFile);
+    if (!out)
+    {
+      std::cerr << "Error opening output file " << outputFile << "\n";
+      return 1;
+    }
+    benchmark::writeResultsAsJSON(results, out);
+  }
+  return 0;
+}
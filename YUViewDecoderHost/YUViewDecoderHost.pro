@@ -0,0 +1,44 @@
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewDecoderHost
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+CONFIG += c++17
+
+SOURCES += $$files(src/*.cpp, false)
+
+INCLUDEPATH += $$top_srcdir/YUViewLib/src
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
+
+# YUView looks for the decoder host next to its own executable. On macOS, this is inside of the app
+# bundle.
+mac {
+    DESTDIR = $$top_builddir/YUViewApp/YUView.app/Contents/MacOS
+} else {
+    DESTDIR = $$top_builddir/YUViewApp
+}
+
+win32-msvc* {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/YUViewLib.lib
+} else {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/libYUViewLib.a
+}
+
+unix:!mac {
+    isEmpty(PREFIX) {
+        PREFIX = /usr/local
+    }
+    isEmpty(BINDIR) {
+        BINDIR = bin
+    }
+
+    target.path = $$PREFIX/$$BINDIR/
+    INSTALLS += target
+}
+
+win32 {
+    DEFINES += NOMINMAX
+}
@@ -43,10 +43,14 @@
 
 #include <algorithm>
 #include <charconv>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include <string_view>
 
 #include <QDir>
 #include <QFileInfo>
+#include <QSettings>
 #include <QThread>
 
 namespace functions
@@ -61,6 +65,19 @@ unsigned int getOptimalThreadCount()
     return 1;
 }
 
+unsigned int getCachingThreadCount()
+{
+  QSettings settings;
+  settings.beginGroup("VideoCache");
+  int nrThreads = getOptimalThreadCount();
+  if (settings.value("SetNrThreads", false).toBool())
+    nrThreads = settings.value("NrThreads", nrThreads).toInt();
+  if (nrThreads > 0)
+    return (unsigned int)nrThreads;
+  else
+    return 1;
+}
+
 unsigned int systemMemorySizeInMB()
 {
   static unsigned int memorySizeInMB;
@@ -91,6 +108,82 @@ unsigned int systemMemorySizeInMB()
   return memorySizeInMB;
 }
 
+std::optional<int64_t> parseMemAvailableFromMeminfo(std::istream &meminfo)
+{
+  // The lines look like this: "MemAvailable:   12345678 kB"
+  std::string line;
+  while (std::getline(meminfo, line))
+  {
+    std::istringstream lineStream(line);
+    std::string        key;
+    int64_t            value{};
+    std::string        unit;
+    if (!(lineStream >> key >> value))
+      continue;
+    if (key != "MemAvailable:")
+      continue;
+    lineStream >> unit;
+    if (unit == "kB")
+      value *= 1024;
+    return value;
+  }
+  return {};
+}
+
+std::optional<int64_t> parseCGroupMemoryValue(std::istream &cgroupFile)
+{
+  std::string text;
+  if (!(cgroupFile >> text) || text == "max")
+    return {};
+  int64_t    value{};
+  const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (result.ec != std::errc())
+    return {};
+  // Without a limit, cgroup v1 reports a huge number (close to the maximum of int64)
+  constexpr auto NO_LIMIT_THRESHOLD = std::numeric_limits<int64_t>::max() / 2;
+  if (value >= NO_LIMIT_THRESHOLD)
+    return {};
+  return value;
+}
+
+std::optional<int64_t> availableMemoryInBytes()
+{
+#if defined(Q_OS_LINUX)
+  std::optional<int64_t> available;
+  {
+    std::ifstream meminfo("/proc/meminfo");
+    if (meminfo)
+      available = parseMemAvailableFromMeminfo(meminfo);
+  }
+
+  auto readCGroupValue = [](const char *path) -> std::optional<int64_t> {
+    std::ifstream file(path);
+    if (!file)
+      return {};
+    return parseCGroupMemoryValue(file);
+  };
+
+  // cgroup v2 and then cgroup v1
+  auto limit = readCGroupValue("/sys/fs/cgroup/memory.max");
+  auto usage = readCGroupValue("/sys/fs/cgroup/memory.current");
+  if (!limit)
+  {
+    limit = readCGroupValue("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+    usage = readCGroupValue("/sys/fs/cgroup/memory/memory.usage_in_bytes");
+  }
+  if (limit && usage)
+  {
+    const auto availableInCGroup = std::max(*limit - *usage, int64_t(0));
+    if (!available || availableInCGroup < *available)
+      available = availableInCGroup;
+  }
+
+  return available;
+#else
+  return {};
+#endif
+}
+
 QStringList getThemeNameList()
 {
   QStringList ret{};
@@ -34,6 +34,7 @@
 
 #include <common/Typedef.h>
 
+#include <cstdint>
 #include <istream>
 #include <optional>
 
@@ -44,10 +45,26 @@ namespace functions
 // so that one thread is "reserved" for the main GUI. I don't know if this is optimal.
 unsigned int getOptimalThreadCount();
 
+// Get the number of threads that the video cache uses. This is the optimal thread count unless the
+// user set a different number in the settings. At least 1 is returned.
+unsigned int getCachingThreadCount();
+
 // Returns the size of system memory in megabytes.
 // This function is thread safe and inexpensive to call.
 unsigned int systemMemorySizeInMB();
 
+// Returns how many bytes can still be allocated before the system (or the cgroup that YUView is
+// running in) runs out of memory. This is read from /proc/meminfo and the cgroup (v2 or v1) memory
+// limits. So this is only available on Linux. This is not cached and reads some files so don't
+// call it too often.
+std::optional<int64_t> availableMemoryInBytes();
+
+// Get the "MemAvailable" value from the content of /proc/meminfo (in bytes).
+std::optional<int64_t> parseMemAvailableFromMeminfo(std::istream &meminfo);
+// Parse a cgroup memory value (e.g. memory.max or memory.current). These contain a number of bytes
+// or "max" if there is no limit (in which case nothing is returned).
+std::optional<int64_t> parseCGroupMemoryValue(std::istream &cgroupFile);
+
 // These are the names of the supported themes
 QStringList getThemeNameList();
 // Get the name of the theme in the resource file that we will load
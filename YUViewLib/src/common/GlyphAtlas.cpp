@@ -0,0 +1,289 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GlyphAtlas.h"
+
+#include <QCoreApplication>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QThread>
+
+#include <cmath>
+#include <mutex>
+#include <tuple>
+
+namespace
+{
+
+// Free space around every glyph so that antialiasing and overhanging glyphs are not cut off
+constexpr auto GLYPH_PADDING = 2;
+
+// Fonts rarely change. If they do, start over instead of keeping old atlases forever.
+constexpr auto MAX_NR_CACHED_ATLASES = 32u;
+// Labels in many different colors (e.g. vectors mapped to a color) are drawn directly. Rendering
+// an atlas per color would take longer than drawing the text.
+constexpr auto MAX_NR_BATCHES = 4u;
+
+bool isGuiThread()
+{
+  const auto app = QCoreApplication::instance();
+  return app != nullptr && QThread::currentThread() == app->thread();
+}
+
+qreal snapToDevicePixel(const qreal value, const qreal devicePixelRatio)
+{
+  return std::round(value * devicePixelRatio) / devicePixelRatio;
+}
+
+} // namespace
+
+std::shared_ptr<const GlyphAtlas>
+GlyphAtlas::get(const QFont &font, const QColor &color, qreal devicePixelRatio, int logicalDpi)
+{
+  using Key = std::tuple<QString, QRgb, qreal, int>;
+  static std::mutex                                       cacheMutex;
+  static std::map<Key, std::shared_ptr<const GlyphAtlas>> cache;
+
+  const auto key = Key(font.key(), color.rgba(), devicePixelRatio, logicalDpi);
+
+  std::unique_lock<std::mutex> lock(cacheMutex);
+  auto                         it = cache.find(key);
+  if (it != cache.end())
+    return it->second;
+
+  if (cache.size() >= MAX_NR_CACHED_ATLASES)
+    cache.clear();
+  auto atlas = std::make_shared<const GlyphAtlas>(font, color, devicePixelRatio, logicalDpi);
+  cache[key] = atlas;
+  return atlas;
+}
+
+GlyphAtlas::GlyphAtlas(const QFont  &font,
+                       const QColor &color,
+                       qreal         devicePixelRatio,
+                       int           logicalDpi)
+    : devicePixelRatio(devicePixelRatio)
+{
+  // Render at the DPI of the target device so that the font has the same size in pixels
+  QImage dpiImage(1, 1, QImage::Format_ARGB32_Premultiplied);
+  const auto dotsPerMeter = int(std::round(logicalDpi / 0.0254));
+  dpiImage.setDotsPerMeterX(dotsPerMeter);
+  dpiImage.setDotsPerMeterY(dotsPerMeter);
+
+  const QFontMetricsF metrics(font, &dpiImage);
+  this->lineSpacing = metrics.lineSpacing();
+  this->height      = std::ceil(metrics.height());
+
+  qreal totalWidth = 0;
+  for (size_t i = 0; i < NR_GLYPHS; i++)
+  {
+    const auto character = QChar(char16_t(FIRST_CHARACTER + i));
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+    const auto advance = metrics.horizontalAdvance(character);
+#else
+    const auto advance = metrics.width(character);
+#endif
+    const auto cellWidth = std::ceil(advance) + 2 * GLYPH_PADDING;
+
+    auto &glyph      = this->glyphs[i];
+    glyph.advance    = advance;
+    glyph.sourceRect = QRectF(totalWidth * devicePixelRatio,
+                              0,
+                              cellWidth * devicePixelRatio,
+                              this->height * devicePixelRatio);
+    totalWidth += cellWidth;
+  }
+
+  QImage image(QSize(int(std::ceil(totalWidth * devicePixelRatio)),
+                     int(std::ceil(this->height * devicePixelRatio))),
+               QImage::Format_ARGB32_Premultiplied);
+  image.setDotsPerMeterX(dotsPerMeter);
+  image.setDotsPerMeterY(dotsPerMeter);
+  image.setDevicePixelRatio(devicePixelRatio);
+  image.fill(Qt::transparent);
+
+  {
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setFont(font);
+    painter.setPen(color);
+    for (size_t i = 0; i < NR_GLYPHS; i++)
+    {
+      const auto x = this->glyphs[i].sourceRect.x() / devicePixelRatio + GLYPH_PADDING;
+      painter.drawText(QPointF(x, metrics.ascent()), QString(QChar(char16_t(FIRST_CHARACTER + i))));
+    }
+  }
+
+  this->pixmap = QPixmap::fromImage(image);
+}
+
+bool GlyphAtlas::canDraw(const QString &text) const
+{
+  for (const auto character : text)
+  {
+    const auto unicode = character.unicode();
+    if (unicode != '\n' && (unicode < FIRST_CHARACTER || unicode > LAST_CHARACTER))
+      return false;
+  }
+  return true;
+}
+
+qreal GlyphAtlas::lineWidth(const QString &text, int start, int end) const
+{
+  qreal width = 0;
+  for (int i = start; i < end; i++)
+    width += this->glyphs[text.at(i).unicode() - FIRST_CHARACTER].advance;
+  return width;
+}
+
+QSizeF GlyphAtlas::textSize(const QString &text) const
+{
+  qreal maxWidth  = 0;
+  int   nrLines   = 0;
+  int   lineStart = 0;
+  while (lineStart <= text.size())
+  {
+    auto lineEnd = text.indexOf('\n', lineStart);
+    if (lineEnd == -1)
+      lineEnd = text.size();
+    maxWidth = std::max(maxWidth, this->lineWidth(text, lineStart, lineEnd));
+    nrLines++;
+    lineStart = lineEnd + 1;
+  }
+  return QSizeF(maxWidth, this->height + (nrLines - 1) * this->lineSpacing);
+}
+
+void GlyphAtlas::addText(std::vector<QPainter::PixmapFragment> &fragments,
+                         const QRectF                          &rect,
+                         int                                    alignment,
+                         const QString                         &text) const
+{
+  const auto center = (alignment & Qt::AlignCenter) == Qt::AlignCenter;
+  const auto size   = this->textSize(text);
+  const auto origin = center ? rect.center() - QPointF(size.width(), size.height()) / 2
+                             : rect.topLeft();
+
+  const auto scale     = 1.0 / this->devicePixelRatio;
+  auto       y         = origin.y();
+  int        lineStart = 0;
+  while (lineStart <= text.size())
+  {
+    auto lineEnd = text.indexOf('\n', lineStart);
+    if (lineEnd == -1)
+      lineEnd = text.size();
+
+    auto x = origin.x();
+    if (center)
+      x += (size.width() - this->lineWidth(text, lineStart, lineEnd)) / 2;
+    x                = snapToDevicePixel(x, this->devicePixelRatio);
+    const auto lineY = snapToDevicePixel(y, this->devicePixelRatio);
+
+    for (int i = lineStart; i < lineEnd; i++)
+    {
+      const auto &glyph    = this->glyphs[text.at(i).unicode() - FIRST_CHARACTER];
+      const auto  cellSize = glyph.sourceRect.size() * scale;
+      const auto  cellCenter =
+          QPointF(x - GLYPH_PADDING + cellSize.width() / 2, lineY + cellSize.height() / 2);
+      fragments.push_back(
+          QPainter::PixmapFragment::create(cellCenter, glyph.sourceRect, scale, scale));
+      x += glyph.advance;
+    }
+
+    y += this->lineSpacing;
+    lineStart = lineEnd + 1;
+  }
+}
+
+GlyphBatch::GlyphBatch(QPainter *painter) : painter(painter)
+{
+  this->useAtlas =
+      isGuiThread() && painter->combinedTransform().type() <= QTransform::TxTranslate;
+}
+
+GlyphBatch::~GlyphBatch()
+{
+  this->flush();
+}
+
+GlyphBatch::Batch *GlyphBatch::getBatch(const QString &text)
+{
+  if (!this->useAtlas)
+    return nullptr;
+
+  const auto &font  = this->painter->font();
+  const auto  color = this->painter->pen().color();
+  const auto  key   = std::make_pair(font.key(), color.rgba());
+
+  auto it = this->batches.find(key);
+  if (it == this->batches.end())
+  {
+    if (this->batches.size() >= MAX_NR_BATCHES)
+      return nullptr;
+    const auto device = this->painter->device();
+    Batch      batch;
+    batch.atlas =
+        GlyphAtlas::get(font, color, device->devicePixelRatioF(), device->logicalDpiY());
+    it = this->batches.emplace(key, std::move(batch)).first;
+  }
+
+  if (!it->second.atlas->canDraw(text))
+    return nullptr;
+  return &it->second;
+}
+
+void GlyphBatch::drawText(const QRect &rect, int alignment, const QString &text)
+{
+  if (auto batch = this->getBatch(text))
+    batch->atlas->addText(batch->fragments, rect, alignment, text);
+  else
+    this->painter->drawText(rect, alignment, text);
+}
+
+QRect GlyphBatch::boundingRect(int alignment, const QString &text)
+{
+  if (auto batch = this->getBatch(text))
+    return QRectF(QPointF(), batch->atlas->textSize(text)).toAlignedRect();
+  return this->painter->boundingRect(QRect(), alignment, text);
+}
+
+void GlyphBatch::flush()
+{
+  for (auto &batch : this->batches)
+  {
+    auto &fragments = batch.second.fragments;
+    if (fragments.empty())
+      continue;
+    this->painter->drawPixmapFragments(
+        fragments.data(), int(fragments.size()), batch.second.atlas->getPixmap());
+    fragments.clear();
+  }
+}
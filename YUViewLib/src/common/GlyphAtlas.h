@@ -0,0 +1,131 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QPainter>
+#include <QPixmap>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* Pre-rendered glyphs of the printable ASCII characters for one font and color. Drawing many short
+ * labels (pixel values, statistics values) with QPainter::drawText lays out every string on its
+ * own. Using the atlas, every character is a copy from one pixmap and the copies of all labels are
+ * drawn with a single QPainter::drawPixmapFragments call (see GlyphBatch).
+ * The atlases are shared. get() is thread safe but the atlas can only be created in the GUI
+ * thread because it uses a QPixmap.
+ */
+class GlyphAtlas
+{
+public:
+  // The logical DPI of the target device is needed to convert the font size in points to pixels
+  static std::shared_ptr<const GlyphAtlas>
+  get(const QFont &font, const QColor &color, qreal devicePixelRatio, int logicalDpi);
+
+  GlyphAtlas(const QFont &font, const QColor &color, qreal devicePixelRatio, int logicalDpi);
+
+  // Are all characters of the text in the atlas?
+  bool canDraw(const QString &text) const;
+
+  // The size of the (multi line) text in logical pixels
+  QSizeF textSize(const QString &text) const;
+
+  // Add the fragments that draw the text into the rect. Only Qt::AlignLeft (top left) and
+  // Qt::AlignCenter are supported.
+  void addText(std::vector<QPainter::PixmapFragment> &fragments,
+               const QRectF                          &rect,
+               int                                    alignment,
+               const QString                         &text) const;
+
+  const QPixmap &getPixmap() const { return this->pixmap; }
+
+private:
+  static constexpr char16_t FIRST_CHARACTER = 32;
+  static constexpr char16_t LAST_CHARACTER  = 126;
+  static constexpr auto     NR_GLYPHS       = size_t(LAST_CHARACTER - FIRST_CHARACTER + 1);
+
+  qreal lineWidth(const QString &text, int start, int end) const;
+
+  QPixmap pixmap;
+  qreal   devicePixelRatio{1.0};
+  qreal   lineSpacing{};
+  qreal   height{};
+
+  struct Glyph
+  {
+    QRectF sourceRect; // In device pixels of the pixmap
+    qreal  advance{};
+  };
+  std::array<Glyph, NR_GLYPHS> glyphs;
+};
+
+/* Collects text labels that are drawn with the font and pen color of the painter and draws them
+ * in one go on flush() (or when destroyed). If the painter is not translation only, the text is
+ * not printable ASCII or the batch is not used in the GUI thread, the text is drawn directly with
+ * QPainter::drawText.
+ */
+class GlyphBatch
+{
+public:
+  explicit GlyphBatch(QPainter *painter);
+  ~GlyphBatch();
+  GlyphBatch(const GlyphBatch &)            = delete;
+  GlyphBatch &operator=(const GlyphBatch &) = delete;
+
+  void drawText(const QRect &rect, int alignment, const QString &text);
+  // The bounding rect (at (0,0)) that drawText will need for the text
+  QRect boundingRect(int alignment, const QString &text);
+
+  void flush();
+
+private:
+  struct Batch
+  {
+    std::shared_ptr<const GlyphAtlas>     atlas;
+    std::vector<QPainter::PixmapFragment> fragments;
+  };
+  // Get the batch for the current font and pen of the painter. Nothing if the text can not be
+  // drawn from an atlas.
+  Batch *getBatch(const QString &text);
+
+  QPainter *painter{};
+  bool      useAtlas{false};
+
+  // Per font and color
+  std::map<std::pair<QString, QRgb>, Batch> batches;
+};
@@ -0,0 +1,157 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryAccountant.h"
+
+#include <algorithm>
+
+MemoryAccountant &MemoryAccountant::instance()
+{
+  static MemoryAccountant accountant;
+  return accountant;
+}
+
+MemoryAccountant::Registration::~Registration()
+{
+  this->reset();
+}
+
+MemoryAccountant::Registration::Registration(Registration &&other) noexcept : id(other.id)
+{
+  other.id = 0;
+}
+
+MemoryAccountant::Registration &
+MemoryAccountant::Registration::operator=(Registration &&other) noexcept
+{
+  if (this != &other)
+  {
+    this->reset();
+    this->id = other.id;
+    other.id = 0;
+  }
+  return *this;
+}
+
+void MemoryAccountant::Registration::reset()
+{
+  if (this->id != 0)
+    MemoryAccountant::instance().unregisterConsumer(this->id);
+  this->id = 0;
+}
+
+MemoryAccountant::Registration MemoryAccountant::registerConsumer(const std::string &category,
+                                                                  UsageFunction      usage)
+{
+  auto consumer      = std::make_shared<Consumer>();
+  consumer->category = category;
+  consumer->usage    = std::move(usage);
+
+  std::scoped_lock lock(this->consumersMutex);
+  consumer->id = this->nextID++;
+  this->consumers.push_back(consumer);
+  if (std::find(this->categoryOrder.begin(), this->categoryOrder.end(), category) ==
+      this->categoryOrder.end())
+    this->categoryOrder.push_back(category);
+  return Registration(consumer->id);
+}
+
+void MemoryAccountant::unregisterConsumer(unsigned id)
+{
+  std::shared_ptr<Consumer> consumer;
+  {
+    std::scoped_lock lock(this->consumersMutex);
+    auto it = std::find_if(this->consumers.begin(), this->consumers.end(), [id](const auto &c) {
+      return c->id == id;
+    });
+    if (it == this->consumers.end())
+      return;
+    consumer = *it;
+    this->consumers.erase(it);
+  }
+
+  // A query that got the consumer before it was removed may still be running. Wait for it and make
+  // sure that the usage function is not called anymore.
+  std::scoped_lock lock(consumer->usageMutex);
+  consumer->usage = nullptr;
+}
+
+std::vector<std::shared_ptr<MemoryAccountant::Consumer>> MemoryAccountant::getConsumers() const
+{
+  std::scoped_lock lock(this->consumersMutex);
+  return this->consumers;
+}
+
+int64_t MemoryAccountant::queryUsage(Consumer &consumer)
+{
+  std::scoped_lock lock(consumer.usageMutex);
+  return consumer.usage ? consumer.usage() : 0;
+}
+
+std::vector<MemoryAccountant::CategoryUsage> MemoryAccountant::getUsagePerCategory() const
+{
+  std::vector<CategoryUsage>             usagePerCategory;
+  std::vector<std::shared_ptr<Consumer>> consumers;
+  {
+    std::scoped_lock lock(this->consumersMutex);
+    for (const auto &category : this->categoryOrder)
+      usagePerCategory.push_back({category, 0});
+    consumers = this->consumers;
+  }
+
+  for (const auto &consumer : consumers)
+  {
+    auto it = std::find_if(
+        usagePerCategory.begin(), usagePerCategory.end(), [&consumer](const CategoryUsage &u) {
+          return u.category == consumer->category;
+        });
+    it->bytes += queryUsage(*consumer);
+  }
+  return usagePerCategory;
+}
+
+int64_t MemoryAccountant::getTotalUsage() const
+{
+  int64_t sum = 0;
+  for (const auto &consumer : this->getConsumers())
+    sum += queryUsage(*consumer);
+  return sum;
+}
+
+int64_t MemoryAccountant::getTotalUsageExcludingCategory(const std::string &category) const
+{
+  int64_t sum = 0;
+  for (const auto &consumer : this->getConsumers())
+    if (consumer->category != category)
+      sum += queryUsage(*consumer);
+  return sum;
+}
@@ -0,0 +1,113 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* The memory accountant keeps track of all large buffers in YUView (the video cache, statistics,
+ * parser trees, decode buffers ...). Every buffer registers a function that returns its current
+ * size in bytes. The video cache uses the sum of all other consumers to adapt its own budget and
+ * the cache info widget shows the breakdown per category.
+ * The registered usage functions are called from whichever thread queries the accountant, so they
+ * must be thread safe. They are called without holding the lock of the accountant (so they may
+ * take their own locks) and never after the registration was destroyed. All functions of the
+ * accountant are thread safe.
+ */
+class MemoryAccountant
+{
+public:
+  using UsageFunction = std::function<int64_t()>;
+
+  static MemoryAccountant &instance();
+
+  // Unregisters the consumer when destroyed. If the usage function accesses members of the
+  // consumer, declare the registration as the last member so that it is destroyed first.
+  class Registration
+  {
+  public:
+    Registration() = default;
+    ~Registration();
+    Registration(Registration &&other) noexcept;
+    Registration &operator=(Registration &&other) noexcept;
+    Registration(const Registration &) = delete;
+    Registration &operator=(const Registration &) = delete;
+
+  private:
+    friend class MemoryAccountant;
+    explicit Registration(unsigned id) : id(id) {}
+    void     reset();
+    unsigned id{0};
+  };
+
+  [[nodiscard]] Registration registerConsumer(const std::string &category, UsageFunction usage);
+
+  struct CategoryUsage
+  {
+    std::string category;
+    int64_t     bytes{};
+  };
+
+  // The usage summed up per category in the order in which the categories were first registered.
+  std::vector<CategoryUsage> getUsagePerCategory() const;
+  int64_t                    getTotalUsage() const;
+  int64_t                    getTotalUsageExcludingCategory(const std::string &category) const;
+
+private:
+  MemoryAccountant() = default;
+
+  void unregisterConsumer(unsigned id);
+
+  // The usage function of a consumer is only called while holding the mutex of the consumer. This
+  // way, unregistering can wait for a running call without blocking all other consumers.
+  struct Consumer
+  {
+    unsigned      id{};
+    std::string   category;
+    std::mutex    usageMutex;
+    UsageFunction usage;
+  };
+
+  // Get the current consumers and query their usage after releasing consumersMutex
+  std::vector<std::shared_ptr<Consumer>> getConsumers() const;
+  static int64_t                         queryUsage(Consumer &consumer);
+
+  mutable std::mutex                     consumersMutex;
+  std::vector<std::shared_ptr<Consumer>> consumers;
+  std::vector<std::string> categoryOrder;
+  unsigned                 nextID{1};
+};
@@ -0,0 +1,203 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Tracing.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// The JSON format has no escaping issues as long as names do not contain quotes or backslashes
+// which is the case for all the literals that we use.
+void writeEvent(std::ostream &stream,
+                bool         &firstEvent,
+                unsigned      threadID,
+                const char   *category,
+                const char   *name,
+                int64_t       startNs,
+                int64_t       durationNs,
+                int64_t       frameIdx)
+{
+  if (!firstEvent)
+    stream << ",\n";
+  firstEvent = false;
+
+  stream << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":"
+         << double(startNs) / 1000.0 << ",\"dur\":" << double(durationNs) / 1000.0
+         << ",\"pid\":1,\"tid\":" << threadID;
+  if (frameIdx >= 0)
+    stream << ",\"args\":{\"frame\":" << frameIdx << "}";
+  stream << "}";
+}
+
+} // namespace
+
+Tracer &Tracer::instance()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+  this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::clear()
+{
+  std::lock_guard<std::mutex> lock(this->buffersMutex);
+  for (auto &buffer : this->buffers)
+    buffer->clearCounter.store(buffer->writeCounter.load(std::memory_order_acquire),
+                               std::memory_order_release);
+}
+
+void Tracer::addEvent(const char *category,
+                      const char *name,
+                      int64_t     startNs,
+                      int64_t     durationNs,
+                      int64_t     frameIdx)
+{
+  auto      &buffer  = this->getBufferOfCurrentThread();
+  const auto counter = buffer.writeCounter.load(std::memory_order_relaxed);
+
+  // Mark the slot as being written before changing any of its fields
+  auto &slot = buffer.events[counter % EVENTS_PER_THREAD];
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.category.store(category, std::memory_order_relaxed);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.startNs.store(startNs, std::memory_order_relaxed);
+  slot.durationNs.store(durationNs, std::memory_order_relaxed);
+  slot.frameIdx.store(frameIdx, std::memory_order_relaxed);
+
+  // Publish the event
+  slot.sequence.store(counter + 1, std::memory_order_release);
+  buffer.writeCounter.store(counter + 1, std::memory_order_release);
+}
+
+void Tracer::exportChromeTrace(std::ostream &stream) const
+{
+  std::lock_guard<std::mutex> lock(this->buffersMutex);
+
+  stream << "{\"traceEvents\":[\n";
+  bool firstEvent = true;
+  for (const auto &buffer : this->buffers)
+  {
+    const auto writeCounter = buffer->writeCounter.load(std::memory_order_acquire);
+    const auto firstCounter =
+        std::max(buffer->clearCounter.load(std::memory_order_acquire),
+                 writeCounter > EVENTS_PER_THREAD ? writeCounter - EVENTS_PER_THREAD : 0);
+
+    for (auto counter = firstCounter; counter < writeCounter; counter++)
+    {
+      // The thread may be writing the slot while we copy it. Only use the copy if the slot held the
+      // published event with this counter before and after copying.
+      const auto &slot     = buffer->events[counter % EVENTS_PER_THREAD];
+      const auto  sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence != counter + 1)
+        continue;
+
+      Event event;
+      event.category   = slot.category.load(std::memory_order_relaxed);
+      event.name       = slot.name.load(std::memory_order_relaxed);
+      event.startNs    = slot.startNs.load(std::memory_order_relaxed);
+      event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+      event.frameIdx   = slot.frameIdx.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        continue;
+
+      writeEvent(stream,
+                 firstEvent,
+                 buffer->threadID,
+                 event.category,
+                 event.name,
+                 event.startNs,
+                 event.durationNs,
+                 event.frameIdx);
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+int64_t Tracer::getTimestampNs()
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+size_t Tracer::getNrThreadBuffers() const
+{
+  std::lock_guard<std::mutex> lock(this->buffersMutex);
+  return this->buffers.size();
+}
+
+Tracer::ThreadBuffer &Tracer::getBufferOfCurrentThread()
+{
+  // Releases the buffer for reuse when the thread finishes
+  struct ThreadBufferReference
+  {
+    ~ThreadBufferReference()
+    {
+      if (this->buffer != nullptr)
+        this->buffer->inUse.store(false, std::memory_order_release);
+    }
+    ThreadBuffer *buffer{};
+  };
+  thread_local ThreadBufferReference reference;
+
+  if (reference.buffer == nullptr)
+  {
+    std::lock_guard<std::mutex> lock(this->buffersMutex);
+
+    // Reuse the buffer of a finished thread. Its events are kept until they are overwritten.
+    for (auto &buffer : this->buffers)
+    {
+      if (!buffer->inUse.load(std::memory_order_acquire))
+      {
+        buffer->inUse.store(true, std::memory_order_relaxed);
+        reference.buffer = buffer.get();
+        return *reference.buffer;
+      }
+    }
+
+    auto newBuffer = std::make_unique<ThreadBuffer>();
+    newBuffer->events = std::make_unique<EventSlot[]>(EVENTS_PER_THREAD);
+    newBuffer->threadID = unsigned(this->buffers.size()) + 1;
+    reference.buffer    = newBuffer.get();
+    this->buffers.push_back(std::move(newBuffer));
+  }
+  return *reference.buffer;
+}
@@ -0,0 +1,171 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/* A low overhead tracer for the hot paths (file reads, parsing, decoding, conversion, caching and
+ * drawing). Tracing is always compiled in but disabled by default. When disabled, a scoped event
+ * costs one relaxed atomic load.
+ * Every thread writes its events into its own ring buffer without any locking. If a ring buffer is
+ * full, the oldest events of that thread are overwritten. When a thread finishes, its buffer is
+ * handed to the next new thread, so there are never more buffers than threads running at the same
+ * time. The events of the finished thread can be exported until they are overwritten.
+ * The buffers can be exported in the Chrome trace JSON format which can be opened in Perfetto
+ * (ui.perfetto.dev) or chrome://tracing.
+ * Category and event names must be string literals (only the pointers are stored).
+ */
+class Tracer
+{
+public:
+  static Tracer &instance();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return this->enabled.load(std::memory_order_relaxed); }
+
+  // Drop all recorded events
+  void clear();
+
+  // Add a complete event for the current thread
+  void addEvent(const char *category,
+                const char *name,
+                int64_t     startNs,
+                int64_t     durationNs,
+                int64_t     frameIdx = -1);
+
+  // Write all recorded events in the Chrome trace event format. This can be called while tracing
+  // is running. Events that are being written or overwritten while exporting are skipped.
+  void exportChromeTrace(std::ostream &stream) const;
+
+  static int64_t getTimestampNs();
+
+  // The number of events that a ring buffer of one thread can hold
+  static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+  size_t getNrThreadBuffers() const;
+
+private:
+  Tracer() = default;
+
+  struct Event
+  {
+    const char *category{};
+    const char *name{};
+    int64_t     startNs{};
+    int64_t     durationNs{};
+    int64_t     frameIdx{-1};
+  };
+
+  // One slot of a ring buffer. The owning thread writes it while other threads may export it, so
+  // all fields are atomic. The sequence is the write counter of the event plus one once the event
+  // is completely written (0 while it is being written).
+  struct EventSlot
+  {
+    std::atomic<uint64_t>     sequence{0};
+    std::atomic<const char *> category{};
+    std::atomic<const char *> name{};
+    std::atomic<int64_t>      startNs{};
+    std::atomic<int64_t>      durationNs{};
+    std::atomic<int64_t>      frameIdx{-1};
+  };
+
+  struct ThreadBuffer
+  {
+    unsigned                     threadID{};
+    std::unique_ptr<EventSlot[]> events;
+    std::atomic<uint64_t> writeCounter{0};
+    // Events before this counter were cleared
+    std::atomic<uint64_t> clearCounter{0};
+    // Reset when the thread that writes into the buffer finishes
+    std::atomic_bool inUse{true};
+  };
+
+  ThreadBuffer &getBufferOfCurrentThread();
+
+  std::atomic_bool enabled{false};
+
+  // Only needed to add a buffer for a new thread and to iterate over the buffers
+  mutable std::mutex                         buffersMutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+namespace tracing
+{
+
+// Records the time from construction to destruction as one event of the current thread
+class ScopedEvent
+{
+public:
+  ScopedEvent(const char *category, const char *name, int64_t frameIdx = -1)
+  {
+    if (Tracer::instance().isEnabled())
+    {
+      this->category = category;
+      this->name     = name;
+      this->frameIdx = frameIdx;
+      this->startNs  = Tracer::getTimestampNs();
+    }
+  }
+  ~ScopedEvent()
+  {
+    if (this->name != nullptr)
+      Tracer::instance().addEvent(this->category,
+                                  this->name,
+                                  this->startNs,
+                                  Tracer::getTimestampNs() - this->startNs,
+                                  this->frameIdx);
+  }
+  ScopedEvent(const ScopedEvent &) = delete;
+  ScopedEvent &operator=(const ScopedEvent &) = delete;
+
+private:
+  const char *category{};
+  const char *name{};
+  int64_t     startNs{};
+  int64_t     frameIdx{-1};
+};
+
+} // namespace tracing
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Trace the current scope. An optional frame index can be given as a third argument.
+#define TRACE_SCOPE(category, ...)                                                                 \
+  tracing::ScopedEvent TRACE_CONCAT(traceScopedEvent, __LINE__)(category, __VA_ARGS__)
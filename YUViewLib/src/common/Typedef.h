@@ -45,6 +45,7 @@
 #include <map>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -165,6 +166,35 @@ template <typename T> int vectorContains(const std::vector<T> &vec, const T &ite
 
 typedef std::vector<unsigned char> ByteVector;
 
+// A non-owning view of bytes (e.g. a ByteVector or a NAL unit inside a file buffer). The view does
+// not keep the data alive, so it is only valid as long as the data it points to is.
+class ByteSpan
+{
+public:
+  ByteSpan() = default;
+  ByteSpan(const unsigned char *data, size_t size) : dataPtr(data), dataSize(size) {}
+  ByteSpan(const ByteVector &data) : dataPtr(data.data()), dataSize(data.size()) {}
+
+  const unsigned char *data() const { return this->dataPtr; }
+  size_t               size() const { return this->dataSize; }
+  bool                 empty() const { return this->dataSize == 0; }
+
+  const unsigned char *begin() const { return this->dataPtr; }
+  const unsigned char *end() const { return this->dataPtr + this->dataSize; }
+
+  const unsigned char &operator[](size_t pos) const { return this->dataPtr[pos]; }
+  const unsigned char &at(size_t pos) const
+  {
+    if (pos >= this->dataSize)
+      throw std::out_of_range("ByteSpan::at position out of range");
+    return this->dataPtr[pos];
+  }
+
+private:
+  const unsigned char *dataPtr{};
+  size_t               dataSize{};
+};
+
 template <typename T> struct Range
 {
   T min{};
@@ -32,6 +32,8 @@
 
 #include "DataSourceLocalFile.h"
 
+#include <common/Tracing.h>
+
 #ifdef Q_OS_WIN
 #include <windows.h>
 #endif
@@ -62,7 +64,10 @@ DataSourceLocalFile::DataSourceLocalFile(const std::filesystem::path &filePath)
   this->filePath = filePath;
   this->file.open(this->filePath.string(), std::ios_base::in | std::ios_base::binary);
   if (this->isOk())
+  {
     this->lastWriteTime = getLastWriteTime(this->filePath);
+    this->positionalReader.open(this->filePath);
+  }
 }
 
 std::vector<InfoItem> DataSourceLocalFile::getInfoList() const
@@ -134,7 +139,10 @@ void DataSourceLocalFile::reloadAndResetDataSource()
   this->file.close();
   this->file.open(this->filePath.string(), std::ios_base::in | std::ios_base::binary);
   if (this->isOk())
+  {
     this->lastWriteTime = getLastWriteTime(this->filePath);
+    this->positionalReader.open(this->filePath);
+  }
 }
 
 bool DataSourceLocalFile::seek(const std::int64_t pos)
@@ -154,6 +162,7 @@ std::int64_t DataSourceLocalFile::read(ByteVector &buffer, const std::int64_t nr
   if (!this->isOk())
     return 0;
 
+  TRACE_SCOPE("file", "DataSourceLocalFile::read");
   const std::lock_guard<std::mutex> readLock(this->readingMutex);
 
   const auto size = static_cast<size_t>(nrBytes);
@@ -169,6 +178,22 @@ std::int64_t DataSourceLocalFile::read(ByteVector &buffer, const std::int64_t nr
   return static_cast<std::int64_t>(bytesRead);
 }
 
+std::int64_t DataSourceLocalFile::readAt(ByteVector        &buffer,
+                                         const std::int64_t pos,
+                                         const std::int64_t nrBytes) const
+{
+  if (!this->isOk())
+    return 0;
+
+  TRACE_SCOPE("file", "DataSourceLocalFile::readAt");
+
+  buffer.resize(static_cast<size_t>(nrBytes));
+  const auto bytesRead =
+      this->positionalReader.read(reinterpret_cast<char *>(buffer.data()), pos, nrBytes);
+  buffer.resize(static_cast<size_t>(bytesRead));
+  return bytesRead;
+}
+
 std::optional<std::int64_t> DataSourceLocalFile::getFileSize() const
 {
   if (!this->isOk())
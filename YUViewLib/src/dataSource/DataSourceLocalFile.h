@@ -33,6 +33,7 @@
 #pragma once
 
 #include "IDataSource.h"
+#include "PositionalFileReader.h"
 
 #include <filesystem>
 #include <fstream>
@@ -58,6 +59,8 @@ public:
 
   [[nodiscard]] bool         seek(const std::int64_t pos) override;
   [[nodiscard]] std::int64_t read(ByteVector &buffer, const std::int64_t nrBytes) override;
+  [[nodiscard]] std::int64_t
+  readAt(ByteVector &buffer, const std::int64_t pos, const std::int64_t nrBytes) const override;
 
   [[nodiscard]] std::optional<std::int64_t> getFileSize() const;
   [[nodiscard]] std::filesystem::path       getFilePath() const;
@@ -71,6 +74,8 @@ protected:
   std::int64_t  filePosition{};
 
   std::mutex readingMutex;
+
+  PositionalFileReader positionalReader;
 };
 
 } // namespace datasource
@@ -58,6 +58,11 @@ public:
 
   [[nodiscard]] virtual bool         seek(const std::int64_t pos)                         = 0;
   [[nodiscard]] virtual std::int64_t read(ByteVector &buffer, const std::int64_t nrBytes) = 0;
+
+  // Read nrBytes starting at pos without using or changing the position of the source. This is
+  // re-entrant so that multiple threads can read different parts of the source at the same time.
+  [[nodiscard]] virtual std::int64_t
+  readAt(ByteVector &buffer, const std::int64_t pos, const std::int64_t nrBytes) const = 0;
 };
 
 } // namespace datasource
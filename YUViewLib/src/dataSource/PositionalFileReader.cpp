@@ -0,0 +1,159 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PositionalFileReader.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace datasource
+{
+
+PositionalFileReader::~PositionalFileReader()
+{
+  this->close();
+}
+
+#ifdef _WIN32
+
+bool PositionalFileReader::open(const std::filesystem::path &filePath)
+{
+  this->close();
+  const auto handle = CreateFileW(filePath.wstring().c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  NULL,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  NULL);
+  if (handle == INVALID_HANDLE_VALUE)
+    return false;
+  this->fileHandle = handle;
+  return true;
+}
+
+void PositionalFileReader::close()
+{
+  if (this->fileHandle != nullptr)
+    CloseHandle(this->fileHandle);
+  this->fileHandle = nullptr;
+}
+
+bool PositionalFileReader::isOpen() const
+{
+  return this->fileHandle != nullptr;
+}
+
+std::int64_t PositionalFileReader::read(char              *buffer,
+                                        const std::int64_t position,
+                                        const std::int64_t nrBytes) const
+{
+  if (!this->isOpen() || position < 0)
+    return 0;
+
+  // ReadFile with an OVERLAPPED offset on a synchronous handle reads from the given offset. The
+  // file pointer of the handle is not used, so concurrent reads do not interfere.
+  std::int64_t totalRead = 0;
+  while (totalRead < nrBytes)
+  {
+    const auto offset = static_cast<std::uint64_t>(position + totalRead);
+    OVERLAPPED overlapped{};
+    overlapped.Offset     = static_cast<DWORD>(offset & 0xffffffff);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    // The parentheses prevent the expansion of the min/max macros from windows.h
+    const auto chunkSize = static_cast<DWORD>(
+        (std::min<std::int64_t>)(nrBytes - totalRead, (std::numeric_limits<DWORD>::max)()));
+    DWORD      bytesRead{};
+    if (!ReadFile(this->fileHandle, buffer + totalRead, chunkSize, &bytesRead, &overlapped) ||
+        bytesRead == 0)
+      break;
+    totalRead += bytesRead;
+  }
+  return totalRead;
+}
+
+#else
+
+bool PositionalFileReader::open(const std::filesystem::path &filePath)
+{
+  this->close();
+  this->fileDescriptor = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+  return this->fileDescriptor >= 0;
+}
+
+void PositionalFileReader::close()
+{
+  if (this->fileDescriptor >= 0)
+    ::close(this->fileDescriptor);
+  this->fileDescriptor = -1;
+}
+
+bool PositionalFileReader::isOpen() const
+{
+  return this->fileDescriptor >= 0;
+}
+
+std::int64_t PositionalFileReader::read(char              *buffer,
+                                        const std::int64_t position,
+                                        const std::int64_t nrBytes) const
+{
+  if (!this->isOpen() || position < 0)
+    return 0;
+
+  std::int64_t totalRead = 0;
+  while (totalRead < nrBytes)
+  {
+    const auto chunkSize = static_cast<size_t>(std::min<std::int64_t>(
+        nrBytes - totalRead, std::numeric_limits<ssize_t>::max()));
+    const auto bytesRead =
+        ::pread(this->fileDescriptor, buffer + totalRead, chunkSize, position + totalRead);
+    if (bytesRead < 0 && errno == EINTR)
+      continue;
+    if (bytesRead <= 0)
+      break;
+    totalRead += bytesRead;
+  }
+  return totalRead;
+}
+
+#endif
+
+} // namespace datasource
@@ -0,0 +1,122 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BackwardDecodeBuffer.h"
+
+#include <algorithm>
+
+namespace decoder
+{
+
+void BackwardDecodeBuffer::setMaxBytes(int64_t bytes)
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->maxBytes = bytes;
+  this->dropOldestFramesUntilFits();
+}
+
+void BackwardDecodeBuffer::addFrame(int frameIdx, const QByteArray &rawData)
+{
+  if (rawData.isEmpty() || rawData.size() > this->maxBytes)
+    return;
+
+  QMutexLocker lock(&this->accessMutex);
+  const auto   alreadyInBuffer =
+      std::any_of(this->frames.begin(), this->frames.end(), [frameIdx](const BufferedFrame &f) {
+        return f.frameIdx == frameIdx;
+      });
+  if (alreadyInBuffer)
+    return;
+
+  this->frames.push_back({frameIdx, rawData});
+  this->usedBytes += rawData.size();
+  this->dropOldestFramesUntilFits();
+}
+
+std::optional<QByteArray> BackwardDecodeBuffer::getFrame(int frameIdx) const
+{
+  QMutexLocker lock(&this->accessMutex);
+  for (const auto &frame : this->frames)
+    if (frame.frameIdx == frameIdx)
+      return frame.rawData;
+  return {};
+}
+
+bool BackwardDecodeBuffer::contains(int frameIdx) const
+{
+  return this->getFrame(frameIdx).has_value();
+}
+
+void BackwardDecodeBuffer::clear()
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->frames.clear();
+  this->usedBytes = 0;
+}
+
+void BackwardDecodeBuffer::removeFramesFrom(int frameIdx)
+{
+  QMutexLocker lock(&this->accessMutex);
+  for (auto it = this->frames.begin(); it != this->frames.end();)
+  {
+    if (it->frameIdx >= frameIdx)
+    {
+      this->usedBytes -= it->rawData.size();
+      it = this->frames.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
+int BackwardDecodeBuffer::getNumberFrames() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return static_cast<int>(this->frames.size());
+}
+
+int64_t BackwardDecodeBuffer::getUsedBytes() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->usedBytes;
+}
+
+void BackwardDecodeBuffer::dropOldestFramesUntilFits()
+{
+  while (this->usedBytes > this->maxBytes && !this->frames.empty())
+  {
+    this->usedBytes -= this->frames.front().rawData.size();
+    this->frames.pop_front();
+  }
+}
+
+} // namespace decoder
@@ -0,0 +1,96 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <deque>
+#include <optional>
+
+#include <common/MemoryAccountant.h>
+
+#include <QByteArray>
+#include <QMutex>
+
+namespace decoder
+{
+
+/* A ring buffer of decoded raw frames used for reverse playback of compressed items.
+ * When playing backwards, a decoder can only go forward from a random access point. Instead of
+ * seeking and re-decoding from the random access point for every single frame, the whole GOP is
+ * decoded once and all decoded frames are pushed into this buffer. The frames are then presented
+ * from the buffer in reverse order. If the byte budget is exceeded, the frames that were added
+ * first are dropped. These are the frames of the previous GOP pass (which were already shown) and
+ * then the lowest frames of the current pass, so the frames right before the playhead are kept.
+ * All functions are thread-safe.
+ */
+class BackwardDecodeBuffer
+{
+public:
+  BackwardDecodeBuffer() = default;
+  BackwardDecodeBuffer(int64_t maxBytes) : maxBytes(maxBytes) {}
+
+  void    setMaxBytes(int64_t bytes);
+  int64_t getMaxBytes() const { return this->maxBytes; }
+
+  // Add the decoded frame with the given index. Frames are expected in increasing order (decode
+  // order of one GOP pass). If the frame is already in the buffer, nothing is done.
+  void addFrame(int frameIdx, const QByteArray &rawData);
+
+  std::optional<QByteArray> getFrame(int frameIdx) const;
+  bool                      contains(int frameIdx) const;
+
+  void clear();
+  // Remove all frames with an index of at least the given index
+  void removeFramesFrom(int frameIdx);
+
+  int     getNumberFrames() const;
+  int64_t getUsedBytes() const;
+
+private:
+  struct BufferedFrame
+  {
+    int        frameIdx{-1};
+    QByteArray rawData;
+  };
+
+  void dropOldestFramesUntilFits();
+
+  mutable QMutex            accessMutex;
+  std::deque<BufferedFrame> frames;
+  int64_t                   usedBytes{0};
+  int64_t                   maxBytes{0};
+
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Decode buffers", [this] { return this->getUsedBytes(); })};
+};
+
+} // namespace decoder
@@ -0,0 +1,123 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DecoderCheckpoints.h"
+
+#include <algorithm>
+
+namespace decoder
+{
+
+namespace
+{
+
+template <typename CheckpointMap> auto findFirstParked(CheckpointMap &checkpoints)
+{
+  return std::min_element(
+      checkpoints.begin(), checkpoints.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.second.parkCounter < rhs.second.parkCounter;
+      });
+}
+
+} // namespace
+
+void DecoderCheckpoints::setMaxCheckpoints(size_t maxCheckpoints)
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->maxCheckpoints = maxCheckpoints;
+  this->dropOldestCheckpointsUntilFits();
+}
+
+std::optional<DecoderCheckpoints::Checkpoint> DecoderCheckpoints::park(const Key    &key,
+                                                                       Checkpoint &&checkpoint)
+{
+  QMutexLocker lock(&this->accessMutex);
+  if (this->maxCheckpoints == 0)
+    return std::move(checkpoint);
+
+  std::optional<Checkpoint> droppedCheckpoint;
+  auto                      it = this->checkpoints.find(key);
+  if (it == this->checkpoints.end() && this->checkpoints.size() >= this->maxCheckpoints)
+    it = findFirstParked(this->checkpoints);
+  if (it != this->checkpoints.end())
+  {
+    droppedCheckpoint = std::move(it->second.checkpoint);
+    this->checkpoints.erase(it);
+  }
+
+  this->checkpoints[key] = ParkedDecoder({std::move(checkpoint), ++this->parkCounter});
+  return droppedCheckpoint;
+}
+
+std::optional<DecoderCheckpoints::Checkpoint>
+DecoderCheckpoints::take(const DecodeCostFunction &decodeCost, unsigned maxDecodeCost)
+{
+  QMutexLocker lock(&this->accessMutex);
+
+  auto bestCheckpoint = this->checkpoints.end();
+  auto bestCost       = maxDecodeCost;
+  for (auto it = this->checkpoints.begin(); it != this->checkpoints.end(); it++)
+  {
+    const auto cost = decodeCost(it->second.checkpoint.frameIdx);
+    if (cost && *cost < bestCost)
+    {
+      bestCheckpoint = it;
+      bestCost       = *cost;
+    }
+  }
+  if (bestCheckpoint == this->checkpoints.end())
+    return {};
+
+  auto checkpoint = std::move(bestCheckpoint->second.checkpoint);
+  this->checkpoints.erase(bestCheckpoint);
+  return checkpoint;
+}
+
+void DecoderCheckpoints::clear()
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->checkpoints.clear();
+}
+
+size_t DecoderCheckpoints::getNumberCheckpoints() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->checkpoints.size();
+}
+
+void DecoderCheckpoints::dropOldestCheckpointsUntilFits()
+{
+  while (this->checkpoints.size() > this->maxCheckpoints)
+    this->checkpoints.erase(findFirstParked(this->checkpoints));
+}
+
+} // namespace decoder
@@ -0,0 +1,108 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <QMutex>
+
+#include "decoderBase.h"
+
+namespace decoder
+{
+
+/* Decoders that were parked inside of long GOPs so that decoding can be resumed from there instead
+ * of from the random access point.
+ * The reference state of a decoder can not be copied. So a checkpoint is a decoder instance
+ * together with the position in the bitstream where reading continues. Long GOPs are divided into
+ * intervals of a fixed number of frames (in coding order from the random access point) and at most
+ * one decoder is parked per interval. If more than the maximum number of decoders are parked, the
+ * one that was parked first is dropped.
+ * All functions are thread-safe.
+ */
+class DecoderCheckpoints
+{
+public:
+  // The random access point (coding index) and the interval within its GOP
+  using Key = std::pair<unsigned, unsigned>;
+
+  struct Checkpoint
+  {
+    std::unique_ptr<decoderBase> decoder;
+    // The last frame (in display order) that the decoder output
+    int frameIdx{-1};
+    // Where reading of the bitstream continues. Either the position of the next NAL unit in the
+    // file or the coding index of the next frame (depending on how the file is read).
+    uint64_t filePos{};
+    int      readFrameCounterCodingOrder{-1};
+  };
+
+  // The number of frames to decode to get the target frame when continuing after the given frame.
+  // Empty if decoding can not continue from the given frame.
+  using DecodeCostFunction = std::function<std::optional<unsigned>(int frameIdx)>;
+
+  void   setMaxCheckpoints(size_t maxCheckpoints);
+  size_t getMaxCheckpoints() const { return this->maxCheckpoints; }
+
+  // Park the decoder at the given checkpoint. A decoder that was parked at the same checkpoint
+  // before or that was dropped because too many decoders are parked is returned so that it can be
+  // reused.
+  std::optional<Checkpoint> park(const Key &key, Checkpoint &&checkpoint);
+
+  // Take the parked decoder from which the target frame is decoded with the lowest cost. Only
+  // decoders with a cost below maxDecodeCost are considered.
+  std::optional<Checkpoint> take(const DecodeCostFunction &decodeCost, unsigned maxDecodeCost);
+
+  void   clear();
+  size_t getNumberCheckpoints() const;
+
+private:
+  struct ParkedDecoder
+  {
+    Checkpoint checkpoint;
+    uint64_t   parkCounter{};
+  };
+
+  void dropOldestCheckpointsUntilFits();
+
+  mutable QMutex               accessMutex;
+  std::map<Key, ParkedDecoder> checkpoints;
+  size_t                       maxCheckpoints{0};
+  uint64_t                     parkCounter{0};
+};
+
+} // namespace decoder
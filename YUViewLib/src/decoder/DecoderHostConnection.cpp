@@ -0,0 +1,314 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DecoderHostConnection.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+
+#include <common/Typedef.h>
+
+#include <new>
+
+namespace decoder::host
+{
+
+namespace
+{
+
+constexpr auto WATCHER_INTERVAL_MS = 100;
+
+DecoderHostConnection::HostSettings getDefaultHostSettings()
+{
+  DecoderHostConnection::HostSettings settings;
+  settings.program = DecoderHostConnection::getHostExecutablePath().value_or(QString());
+  return settings;
+}
+
+} // namespace
+
+DecoderHostConnection::DecoderHostConnection(DecoderEngine engine)
+    : DecoderHostConnection(engine, getDefaultHostSettings())
+{
+}
+
+DecoderHostConnection::DecoderHostConnection(DecoderEngine engine, const HostSettings &settings)
+    : decoderEngine(engine), hostSettings(settings)
+{
+  if (settings.program.isEmpty())
+  {
+    this->errorString = "The decoder host executable was not found.";
+    return;
+  }
+
+  static std::atomic_uint connectionCounter{0};
+  this->baseKey = "YUViewDecoderHost_" + std::to_string(QCoreApplication::applicationPid()) + "_" +
+                  std::to_string(connectionCounter++);
+
+  this->requestSemaphore = std::make_unique<QSystemSemaphore>(
+      QString::fromStdString(getRequestSemaphoreKey(this->baseKey)), 0, QSystemSemaphore::Create);
+  this->replySemaphore = std::make_unique<QSystemSemaphore>(
+      QString::fromStdString(getReplySemaphoreKey(this->baseKey)), 0, QSystemSemaphore::Create);
+
+  this->sharedMemory = std::make_unique<QSharedMemory>(
+      QString::fromStdString(getSharedMemoryKey(this->baseKey, this->sharedMemoryGeneration)));
+  if (!this->sharedMemory->create(static_cast<int>(sizeof(SharedHeader) + INITIAL_DATA_CAPACITY)))
+  {
+    this->errorString = "Creating the shared memory failed: " + this->sharedMemory->errorString();
+    return;
+  }
+  new (this->sharedMemory->data()) SharedHeader();
+
+  const auto arguments =
+      QStringList({QString::fromStdString(this->baseKey),
+                   this->sharedMemory->key(),
+                   QString::fromStdString(std::string(DecoderEngineMapper.getName(engine))),
+                   QString::number(QCoreApplication::applicationPid())});
+  this->hostWatcher.reset(
+      QThread::create(&DecoderHostConnection::watchHostProcess, this, arguments));
+  this->hostWatcher->start();
+
+  // The host replies once it created the decoder
+  if (!this->waitForReply())
+  {
+    this->errorString = "The decoder host process could not be started.";
+    return;
+  }
+
+  const auto header = this->getHeader();
+  const auto text   = QString::fromStdString(getText(*header));
+  if (!header->success)
+  {
+    this->errorString = text;
+    return;
+  }
+
+  const auto lines = text.split('\n');
+  if (lines.size() != 5)
+  {
+    this->errorString = "Invalid reply of the decoder host process.";
+    return;
+  }
+  this->decoderInfo.decoderName         = lines.at(0);
+  this->decoderInfo.codecName           = lines.at(1);
+  this->decoderInfo.signalNames         = lines.at(2).split('|');
+  this->decoderInfo.libraryPaths        = lines.at(3).split('|');
+  this->decoderInfo.statisticsSupported = lines.at(4) == "1";
+}
+
+DecoderHostConnection::~DecoderHostConnection()
+{
+  // Set this before taking the request mutex. If a request waits for a host that hangs, the watcher
+  // kills the host after the quit timeout which also ends the request.
+  this->quitRequested = true;
+  {
+    std::lock_guard<std::mutex> lock(this->requestMutex);
+    if (this->hostWatcher && !this->hostTerminated)
+    {
+      this->getHeader()->command = Command::Quit;
+      this->requestSemaphore->release();
+    }
+  }
+
+  if (this->hostWatcher)
+    this->hostWatcher->wait();
+}
+
+bool DecoderHostConnection::isOk() const
+{
+  std::lock_guard<std::mutex> lock(this->requestMutex);
+  return this->errorString.isEmpty() && !this->hostTerminated;
+}
+
+std::optional<DecoderHostConnection::Reply> DecoderHostConnection::request(
+    const Command command, const int32_t argument, const QByteArray &data)
+{
+  std::lock_guard<std::mutex> lock(this->requestMutex);
+  if (!this->errorString.isEmpty() || this->hostTerminated)
+    return {};
+
+  if (command == Command::PushData && data.size() > this->getDataCapacity())
+    if (!this->enlargeSharedMemory(data.size()))
+      return {};
+
+  auto header      = this->getHeader();
+  header->command  = command;
+  header->argument = argument;
+  header->dataSize = data.size();
+  if (command == Command::PushData && !data.isEmpty())
+    std::memcpy(this->getDataArea(), data.constData(), data.size());
+  if (!this->sendRequestAndWaitForReply())
+    return {};
+
+  const auto replyHasData =
+      (command == Command::GetRawFrameData || command == Command::GetStatistics);
+  if (replyHasData && !this->getHeader()->success &&
+      this->getHeader()->dataSize > this->getDataCapacity())
+  {
+    // The data does not fit. The host keeps it so we can just request it again.
+    if (!this->enlargeSharedMemory(this->getHeader()->dataSize))
+      return {};
+    this->getHeader()->command = command;
+    if (!this->sendRequestAndWaitForReply())
+      return {};
+  }
+
+  header = this->getHeader();
+  Reply reply;
+  reply.success         = header->success != 0;
+  reply.decoderState    = static_cast<DecoderState>(header->decoderState);
+  reply.frameSize       = Size(header->frameWidth, header->frameHeight);
+  reply.pixelFormatName = std::string(
+      header->pixelFormatName, strnlen(header->pixelFormatName, sizeof(header->pixelFormatName)));
+  if (reply.decoderState == DecoderState::Error)
+    reply.errorString = QString::fromStdString(getText(*header));
+  if (replyHasData && reply.success)
+    reply.data = QByteArray(this->getDataArea(), static_cast<int>(header->dataSize));
+  return reply;
+}
+
+std::optional<QString> DecoderHostConnection::getHostExecutablePath()
+{
+  QStringList searchDirs({QCoreApplication::applicationDirPath()});
+  // On macOS, the host is bundled into YUView.app/Contents/MacOS. If it is not, also look next to
+  // the app bundle.
+  if (is_Q_OS_MAC)
+    searchDirs.append(QDir(QCoreApplication::applicationDirPath()).absoluteFilePath("../../.."));
+
+  for (const auto &dir : searchDirs)
+  {
+    auto path = QDir(dir).filePath(HOST_EXECUTABLE_NAME);
+    if (is_Q_OS_WIN)
+      path += ".exe";
+    if (QFileInfo(path).isExecutable())
+      return QDir::cleanPath(path);
+  }
+  return {};
+}
+
+bool DecoderHostConnection::sendRequestAndWaitForReply()
+{
+  this->requestSemaphore->release();
+  return this->waitForReply();
+}
+
+bool DecoderHostConnection::waitForReply()
+{
+  // QSystemSemaphore can not wait with a timeout. The watcher kills the host if the reply takes too
+  // long, which releases the semaphore.
+  this->requestCounter++;
+  this->waitingForReply = true;
+  this->replySemaphore->acquire();
+  this->waitingForReply = false;
+  return !this->hostTerminated;
+}
+
+bool DecoderHostConnection::enlargeSharedMemory(const int64_t requiredCapacity)
+{
+  auto capacity = this->getDataCapacity();
+  while (capacity < requiredCapacity)
+    capacity *= 2;
+
+  const auto key = getSharedMemoryKey(this->baseKey, ++this->sharedMemoryGeneration);
+  auto       newSharedMemory = std::make_unique<QSharedMemory>(QString::fromStdString(key));
+  if (!newSharedMemory->create(static_cast<int>(sizeof(SharedHeader) + capacity)))
+    return false;
+  new (newSharedMemory->data()) SharedHeader();
+
+  auto header     = this->getHeader();
+  header->command = Command::AttachSharedMemory;
+  setText(*header, key);
+
+  // The host detaches from the old segment and writes the reply to the new one
+  const auto oldSharedMemory = std::move(this->sharedMemory);
+  this->sharedMemory         = std::move(newSharedMemory);
+  this->requestSemaphore->release();
+  return this->waitForReply() && this->getHeader()->success;
+}
+
+SharedHeader *DecoderHostConnection::getHeader() const
+{
+  return static_cast<SharedHeader *>(this->sharedMemory->data());
+}
+
+char *DecoderHostConnection::getDataArea() const
+{
+  return static_cast<char *>(this->sharedMemory->data()) + sizeof(SharedHeader);
+}
+
+int64_t DecoderHostConnection::getDataCapacity() const
+{
+  return static_cast<int64_t>(this->sharedMemory->size()) -
+         static_cast<int64_t>(sizeof(SharedHeader));
+}
+
+void DecoderHostConnection::watchHostProcess(const QStringList &arguments)
+{
+  // The process is only accessed from this thread
+  QProcess process;
+  process.setProcessChannelMode(QProcess::ForwardedChannels);
+  process.start(this->hostSettings.program, arguments);
+  if (process.waitForStarted())
+  {
+    auto     msSinceQuit       = 0;
+    auto     msWaitingForReply = 0;
+    unsigned waitingForRequest = 0;
+    while (!process.waitForFinished(WATCHER_INTERVAL_MS))
+    {
+      if (this->quitRequested)
+        msSinceQuit += WATCHER_INTERVAL_MS;
+
+      const auto request = this->requestCounter.load();
+      if (this->waitingForReply && request == waitingForRequest)
+        msWaitingForReply += WATCHER_INTERVAL_MS;
+      else
+        msWaitingForReply = 0;
+      waitingForRequest = request;
+
+      if (msSinceQuit > this->hostSettings.quitTimeoutMs ||
+          msWaitingForReply > this->hostSettings.replyTimeoutMs)
+      {
+        process.kill();
+        process.waitForFinished();
+        break;
+      }
+    }
+  }
+
+  this->hostTerminated = true;
+  // A request may be waiting for the reply of the terminated host
+  this->replySemaphore->release();
+}
+
+} // namespace decoder::host
@@ -0,0 +1,144 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "DecoderHostProtocol.h"
+#include "decoderBase.h"
+
+#include <QSharedMemory>
+#include <QSystemSemaphore>
+#include <QThread>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace decoder::host
+{
+
+/* The YUView side of a connection to a decoder host process (see DecoderHostProtocol.h). The host
+ * is started in the constructor and quit in the destructor. The process is watched by a separate
+ * thread so that a request does not wait forever if the host crashes or hangs. All functions are
+ * thread-safe. Requests are processed one after another.
+ */
+class DecoderHostConnection
+{
+public:
+  // How the host is started and how long it may take to reply before it is killed
+  struct HostSettings
+  {
+    QString program;
+    // If the host does not reply to a request within this time, it is considered hung
+    int replyTimeoutMs{30000};
+    // After Quit was sent, the host gets this much time to exit
+    int quitTimeoutMs{1000};
+  };
+
+  // Start the host executable that is shipped with YUView (see getHostExecutablePath)
+  DecoderHostConnection(DecoderEngine engine);
+  DecoderHostConnection(DecoderEngine engine, const HostSettings &settings);
+  ~DecoderHostConnection();
+
+  DecoderHostConnection(const DecoderHostConnection &)            = delete;
+  DecoderHostConnection &operator=(const DecoderHostConnection &) = delete;
+
+  // Is the host running and was the decoder created successfully?
+  bool          isOk() const;
+  QString       getErrorString() const { return this->errorString; }
+  DecoderEngine getDecoderEngine() const { return this->decoderEngine; }
+
+  struct DecoderInfo
+  {
+    QString     decoderName;
+    QString     codecName;
+    QStringList signalNames;
+    QStringList libraryPaths;
+    bool        statisticsSupported{};
+  };
+  const DecoderInfo &getDecoderInfo() const { return this->decoderInfo; }
+
+  struct Reply
+  {
+    bool         success{};
+    DecoderState decoderState{DecoderState::Error};
+    Size         frameSize{};
+    std::string  pixelFormatName;
+    QString      errorString;
+    QByteArray   data;
+  };
+
+  // Send the request and wait for the reply. For PushData, the data is transferred to the host.
+  // For GetRawFrameData and GetStatistics, the data of the reply is the raw frame or the serialized
+  // statistics. Return an empty optional if the host terminated.
+  std::optional<Reply>
+  request(const Command command, const int32_t argument = 0, const QByteArray &data = {});
+
+  // The host executable is expected next to the YUView executable (or next to the app bundle on
+  // macOS)
+  static std::optional<QString> getHostExecutablePath();
+
+private:
+  bool sendRequestAndWaitForReply();
+  // Returns false if the host terminated (or was killed because it did not reply in time)
+  bool waitForReply();
+  bool enlargeSharedMemory(const int64_t requiredCapacity);
+
+  SharedHeader *getHeader() const;
+  char         *getDataArea() const;
+  int64_t       getDataCapacity() const;
+
+  void watchHostProcess(const QStringList &arguments);
+
+  DecoderEngine decoderEngine;
+  HostSettings  hostSettings;
+  DecoderInfo   decoderInfo;
+  QString       errorString;
+
+  std::string                       baseKey;
+  unsigned                          sharedMemoryGeneration{};
+  std::unique_ptr<QSharedMemory>    sharedMemory;
+  std::unique_ptr<QSystemSemaphore> requestSemaphore;
+  std::unique_ptr<QSystemSemaphore> replySemaphore;
+
+  mutable std::mutex requestMutex;
+  std::atomic_bool   hostTerminated{false};
+  std::atomic_bool   quitRequested{false};
+  std::atomic_bool   waitingForReply{false};
+  std::atomic_uint   requestCounter{0};
+
+  // A QThread because the QProcess needs an event dispatcher
+  std::unique_ptr<QThread> hostWatcher;
+};
+
+} // namespace decoder::host
@@ -0,0 +1,130 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DecoderHostPool.h"
+
+#include <QThread>
+
+#include <algorithm>
+
+namespace decoder::host
+{
+
+namespace
+{
+
+std::unique_ptr<DecoderHostConnection> startHostExecutable(const DecoderEngine engine)
+{
+  if (!DecoderHostConnection::getHostExecutablePath())
+    return {};
+  return std::make_unique<DecoderHostConnection>(engine);
+}
+
+} // namespace
+
+DecoderHostPool::DecoderHostPool(StartHostFunction startHost, const size_t maxIdleConnections)
+    : startHost(std::move(startHost)), maxIdleConnections(maxIdleConnections)
+{
+}
+
+DecoderHostPool &DecoderHostPool::instance()
+{
+  static DecoderHostPool pool(startHostExecutable,
+                              static_cast<size_t>(std::max(QThread::idealThreadCount(), 1)));
+  return pool;
+}
+
+std::unique_ptr<DecoderHostConnection> DecoderHostPool::acquire(const DecoderEngine engine)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    if (this->isShutDown)
+      return {};
+
+    auto it = std::find_if(this->idleConnections.begin(),
+                           this->idleConnections.end(),
+                           [engine](const std::unique_ptr<DecoderHostConnection> &connection) {
+                             return connection->getDecoderEngine() == engine;
+                           });
+    if (it != this->idleConnections.end())
+    {
+      auto connection = std::move(*it);
+      this->idleConnections.erase(it);
+      if (connection->isOk())
+        return connection;
+    }
+  }
+
+  auto connection = this->startHost(engine);
+  if (!connection || !connection->isOk())
+    return {};
+  return connection;
+}
+
+void DecoderHostPool::release(std::unique_ptr<DecoderHostConnection> connection)
+{
+  if (!connection || !connection->isOk())
+    return;
+
+  std::unique_ptr<DecoderHostConnection> droppedConnection;
+  {
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    if (this->isShutDown)
+      return;
+
+    this->idleConnections.push_back(std::move(connection));
+    if (this->idleConnections.size() > this->maxIdleConnections)
+    {
+      droppedConnection = std::move(this->idleConnections.front());
+      this->idleConnections.erase(this->idleConnections.begin());
+    }
+  }
+  // The dropped host is quit without holding the lock
+}
+
+void DecoderHostPool::shutDown()
+{
+  std::vector<std::unique_ptr<DecoderHostConnection>> connections;
+  {
+    std::lock_guard<std::mutex> lock(this->poolMutex);
+    this->isShutDown = true;
+    connections.swap(this->idleConnections);
+  }
+}
+
+size_t DecoderHostPool::getNumberIdleConnections() const
+{
+  std::lock_guard<std::mutex> lock(this->poolMutex);
+  return this->idleConnections.size();
+}
+
+} // namespace decoder::host
@@ -0,0 +1,80 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "DecoderHostConnection.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace decoder::host
+{
+
+/* A pool of decoder host processes. Starting a host and loading the decoder library takes a
+ * while, so hosts that are no longer needed are kept (up to the number of cores) and handed out
+ * again for the next decoder of the same engine. All functions are thread-safe.
+ */
+class DecoderHostPool
+{
+public:
+  static DecoderHostPool &instance();
+
+  // The instance starts the host executable of YUView and keeps up to one idle host per core. A
+  // separate pool can start the hosts differently (e.g. for testing).
+  using StartHostFunction =
+      std::function<std::unique_ptr<DecoderHostConnection>(const DecoderEngine engine)>;
+  DecoderHostPool(StartHostFunction startHost, const size_t maxIdleConnections);
+
+  // Get an idle host for the given engine or start a new one. Return nullptr if no host could be
+  // started. The decoder of a host from the pool must be reset before it is used.
+  std::unique_ptr<DecoderHostConnection> acquire(const DecoderEngine engine);
+  void                                   release(std::unique_ptr<DecoderHostConnection> connection);
+
+  // Quit all idle hosts. Hosts that are released afterwards are quit right away. Call this before
+  // the application exits.
+  void shutDown();
+
+  size_t getNumberIdleConnections() const;
+
+private:
+  StartHostFunction startHost;
+  size_t            maxIdleConnections{};
+
+  mutable std::mutex                                  poolMutex;
+  std::vector<std::unique_ptr<DecoderHostConnection>> idleConnections;
+  bool                                                isShutDown{};
+};
+
+} // namespace decoder::host
@@ -0,0 +1,281 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DecoderHostProtocol.h"
+
+namespace decoder::host
+{
+
+namespace
+{
+
+class Writer
+{
+public:
+  void write(const int32_t value)
+  {
+    this->data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+  void writeBlock(const unsigned short pos[2], const unsigned short size[2])
+  {
+    this->write(pos[0]);
+    this->write(pos[1]);
+    this->write(size[0]);
+    this->write(size[1]);
+  }
+  void writePoint(const stats::Point &point)
+  {
+    this->write(point.x);
+    this->write(point.y);
+  }
+  void writePolygon(const stats::PolygonView &corners)
+  {
+    this->write(static_cast<int32_t>(corners.size()));
+    for (const auto &corner : corners)
+      this->writePoint(corner);
+  }
+
+  QByteArray data;
+};
+
+class Reader
+{
+public:
+  Reader(const QByteArray &data) : data(data) {}
+
+  bool read(int32_t &value)
+  {
+    if (this->pos + int(sizeof(value)) > this->data.size())
+      return false;
+    std::memcpy(&value, this->data.constData() + this->pos, sizeof(value));
+    this->pos += sizeof(value);
+    return true;
+  }
+  bool readCount(size_t &count)
+  {
+    int32_t value{};
+    // Every item takes at least one value so the count can not be larger than the remaining data
+    if (!this->read(value) || value < 0 ||
+        value > (this->data.size() - this->pos) / int(sizeof(int32_t)))
+      return false;
+    count = size_t(value);
+    return true;
+  }
+  bool readBlock(unsigned short pos[2], unsigned short size[2])
+  {
+    int32_t values[4]{};
+    for (auto &value : values)
+      if (!this->read(value))
+        return false;
+    pos[0]  = static_cast<unsigned short>(values[0]);
+    pos[1]  = static_cast<unsigned short>(values[1]);
+    size[0] = static_cast<unsigned short>(values[2]);
+    size[1] = static_cast<unsigned short>(values[3]);
+    return true;
+  }
+  bool readPoint(stats::Point &point) { return this->read(point.x) && this->read(point.y); }
+  bool readPolygon(stats::Polygon &corners)
+  {
+    size_t nrCorners{};
+    if (!this->readCount(nrCorners))
+      return false;
+    corners.resize(nrCorners);
+    for (auto &corner : corners)
+      if (!this->readPoint(corner))
+        return false;
+    return true;
+  }
+
+  bool atEnd() const { return this->pos == this->data.size(); }
+
+private:
+  const QByteArray &data;
+  int               pos{};
+};
+
+void writeFrameTypeData(Writer &writer, const stats::FrameTypeData &data)
+{
+  writer.write(static_cast<int32_t>(data.valueData.size()));
+  for (const auto &item : data.valueData)
+  {
+    writer.writeBlock(item.pos, item.size);
+    writer.write(item.value);
+  }
+
+  writer.write(static_cast<int32_t>(data.vectorData.size()));
+  for (const auto &item : data.vectorData)
+  {
+    writer.writeBlock(item.pos, item.size);
+    writer.write(item.isLine ? 1 : 0);
+    writer.writePoint(item.point[0]);
+    writer.writePoint(item.point[1]);
+  }
+
+  writer.write(static_cast<int32_t>(data.affineTFData.size()));
+  for (const auto &item : data.affineTFData)
+  {
+    writer.writeBlock(item.pos, item.size);
+    for (const auto &point : item.point)
+      writer.writePoint(point);
+  }
+
+  writer.write(static_cast<int32_t>(data.polygonValueData.size()));
+  for (const auto &item : data.polygonValueData)
+  {
+    writer.writePolygon(item.corners);
+    writer.write(item.value);
+  }
+
+  writer.write(static_cast<int32_t>(data.polygonVectorData.size()));
+  for (const auto &item : data.polygonVectorData)
+  {
+    writer.writePolygon(item.corners);
+    writer.writePoint(item.point);
+  }
+}
+
+// The items are added again so that the lists (and the maximum block size) are rebuilt just like
+// they were built by the decoder.
+bool readFrameTypeData(Reader &reader, stats::FrameTypeData &data)
+{
+  size_t         count{};
+  unsigned short pos[2]{};
+  unsigned short size[2]{};
+
+  if (!reader.readCount(count))
+    return false;
+  for (size_t i = 0; i < count; i++)
+  {
+    int32_t value{};
+    if (!reader.readBlock(pos, size) || !reader.read(value))
+      return false;
+    data.addBlockValue(pos[0], pos[1], size[0], size[1], value);
+  }
+
+  if (!reader.readCount(count))
+    return false;
+  for (size_t i = 0; i < count; i++)
+  {
+    int32_t      isLine{};
+    stats::Point points[2];
+    if (!reader.readBlock(pos, size) || !reader.read(isLine) || !reader.readPoint(points[0]) ||
+        !reader.readPoint(points[1]))
+      return false;
+    if (isLine)
+      data.addLine(
+          pos[0], pos[1], size[0], size[1], points[0].x, points[0].y, points[1].x, points[1].y);
+    else
+      data.addBlockVector(pos[0], pos[1], size[0], size[1], points[0].x, points[0].y);
+  }
+
+  if (!reader.readCount(count))
+    return false;
+  for (size_t i = 0; i < count; i++)
+  {
+    stats::Point points[3];
+    if (!reader.readBlock(pos, size) || !reader.readPoint(points[0]) ||
+        !reader.readPoint(points[1]) || !reader.readPoint(points[2]))
+      return false;
+    data.addBlockAffineTF(pos[0],
+                          pos[1],
+                          size[0],
+                          size[1],
+                          points[0].x,
+                          points[0].y,
+                          points[1].x,
+                          points[1].y,
+                          points[2].x,
+                          points[2].y);
+  }
+
+  if (!reader.readCount(count))
+    return false;
+  for (size_t i = 0; i < count; i++)
+  {
+    stats::Polygon corners;
+    int32_t        value{};
+    if (!reader.readPolygon(corners) || !reader.read(value))
+      return false;
+    data.addPolygonValue(corners, value);
+  }
+
+  if (!reader.readCount(count))
+    return false;
+  for (size_t i = 0; i < count; i++)
+  {
+    stats::Polygon corners;
+    stats::Point   point;
+    if (!reader.readPolygon(corners) || !reader.readPoint(point))
+      return false;
+    data.addPolygonVector(corners, point.x, point.y);
+  }
+
+  data.shrinkToFit();
+  return true;
+}
+
+} // namespace
+
+QByteArray serializeFrameStatistics(const std::map<int, stats::FrameTypeData> &frameData)
+{
+  Writer writer;
+  writer.write(static_cast<int32_t>(frameData.size()));
+  for (const auto &[typeID, data] : frameData)
+  {
+    writer.write(typeID);
+    writeFrameTypeData(writer, data);
+  }
+  return writer.data;
+}
+
+std::optional<std::map<int, stats::FrameTypeData>>
+deserializeFrameStatistics(const QByteArray &data)
+{
+  Reader reader(data);
+  size_t nrTypes{};
+  if (!reader.readCount(nrTypes))
+    return {};
+
+  std::map<int, stats::FrameTypeData> frameData;
+  for (size_t i = 0; i < nrTypes; i++)
+  {
+    int32_t typeID{};
+    if (!reader.read(typeID) || !readFrameTypeData(reader, frameData[typeID]))
+      return {};
+  }
+
+  if (!reader.atEnd())
+    return {};
+  return frameData;
+}
+
+} // namespace decoder::host
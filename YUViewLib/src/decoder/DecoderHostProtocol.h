@@ -0,0 +1,131 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <statistics/FrameTypeData.h>
+
+#include <QByteArray>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+
+/* The protocol between YUView and the decoder host processes (YUViewDecoderHost).
+ * The reference decoder libraries (HM, VTM) use global state so only one instance can run in a
+ * process at a time. The caching decoders for these libraries run in separate host processes
+ * instead. YUView and a host exchange requests and replies through a shared memory segment. It
+ * starts with the SharedHeader which is followed by the data area (bitstream data that is pushed,
+ * the raw data of a decoded frame or its statistics). Two system semaphores signal that a request
+ * or a reply is ready. There is only ever one request in flight.
+ */
+namespace decoder::host
+{
+
+constexpr auto    HOST_EXECUTABLE_NAME  = "YUViewDecoderHost";
+constexpr int64_t INITIAL_DATA_CAPACITY = 16 * 1024 * 1024;
+
+enum class Command : int32_t
+{
+  None,
+  Quit,
+  ResetDecoder,
+  SetDecodeSignal,    // argument: The signal ID
+  PushData,           // dataSize bytes in the data area. Empty data signals the end of the stream.
+  DecodeNextFrame,    // Reply: frame size and pixel format
+  GetRawFrameData,    // Reply: dataSize bytes in the data area or the required capacity
+  AttachSharedMemory, // text: The key of the new (larger) segment. The reply is written to it.
+  EnableStatistics,   // argument: 1 to retrieve the statistics of the decoded frames, 0 to stop
+  GetStatistics       // Reply: The serialized statistics of the frame (like GetRawFrameData)
+};
+
+struct SharedHeader
+{
+  // The request
+  Command command{Command::None};
+  int32_t argument{};
+
+  // The number of bytes in the data area (request and reply) or the required capacity
+  int64_t dataSize{};
+
+  // The reply
+  int32_t success{};
+  int32_t decoderState{};
+  int32_t frameWidth{};
+  int32_t frameHeight{};
+  char    pixelFormatName[128]{};
+
+  // The error string (if the decoder is in the error state), the decoder info after starting or
+  // the key for AttachSharedMemory
+  char text[2048]{};
+};
+
+inline std::string getText(const SharedHeader &header)
+{
+  return std::string(header.text, strnlen(header.text, sizeof(header.text)));
+}
+
+inline void setText(SharedHeader &header, const std::string &text)
+{
+  const auto length = std::min(text.size(), sizeof(header.text) - 1);
+  std::memcpy(header.text, text.data(), length);
+  header.text[length] = 0;
+}
+
+inline std::string getRequestSemaphoreKey(const std::string &baseKey)
+{
+  return baseKey + "_request";
+}
+
+inline std::string getReplySemaphoreKey(const std::string &baseKey)
+{
+  return baseKey + "_reply";
+}
+
+inline std::string getSharedMemoryKey(const std::string &baseKey, const unsigned generation)
+{
+  return baseKey + "_data" + std::to_string(generation);
+}
+
+// The statistics of a frame are transferred as a flat list of 32 bit values. Return an empty
+// optional if the data is not valid.
+QByteArray serializeFrameStatistics(const std::map<int, stats::FrameTypeData> &frameData);
+std::optional<std::map<int, stats::FrameTypeData>>
+deserializeFrameStatistics(const QByteArray &data);
+
+// The arguments of the host are: <baseKey> <sharedMemoryKey> <decoderEngine> <parentProcessID>
+constexpr auto NR_HOST_ARGUMENTS = 4;
+
+} // namespace decoder::host
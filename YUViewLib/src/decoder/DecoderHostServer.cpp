@@ -0,0 +1,261 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DecoderHostServer.h"
+
+#include "DecoderHostProtocol.h"
+#include "decoderHM.h"
+#include "decoderVTM.h"
+
+#include <QSharedMemory>
+#include <QSystemSemaphore>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#endif
+
+namespace decoder::host
+{
+
+namespace
+{
+
+std::unique_ptr<decoderBase> createReferenceDecoder(const DecoderEngine engine)
+{
+  if (engine == DecoderEngine::HM)
+    return std::make_unique<decoderHM>(0, true);
+  if (engine == DecoderEngine::VTM)
+    return std::make_unique<decoderVTM>(0, true);
+  return {};
+}
+
+// If YUView crashes, it can not send Quit anymore. The host must not keep on running (waiting for
+// requests) in this case.
+void quitWhenParentProcessTerminates(const qint64 parentProcessID)
+{
+  std::thread([parentProcessID]() {
+#ifdef Q_OS_WIN
+    const auto parentProcess = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(parentProcessID));
+    if (parentProcess != NULL)
+      WaitForSingleObject(parentProcess, INFINITE);
+#else
+    while (kill(static_cast<pid_t>(parentProcessID), 0) == 0 || errno == EPERM)
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+#endif
+    std::_Exit(0);
+  }).detach();
+}
+
+// The info that YUView needs about the decoder: The decoder name, the codec name, the signal
+// names, the library paths and if statistics are supported (one per line).
+std::string getDecoderInfo(const decoderBase &decoder)
+{
+  const auto join = [](const QStringList &list) { return list.join('|').toStdString(); };
+  return decoder.getDecoderName().toStdString() + "\n" + decoder.getCodecName().toStdString() +
+         "\n" + join(decoder.getSignalNames()) + "\n" + join(decoder.getLibraryPaths()) + "\n" +
+         (decoder.statisticsSupported() ? "1" : "0");
+}
+
+SharedHeader *getHeader(QSharedMemory &sharedMemory)
+{
+  return static_cast<SharedHeader *>(sharedMemory.data());
+}
+
+char *getDataArea(QSharedMemory &sharedMemory)
+{
+  return static_cast<char *>(sharedMemory.data()) + sizeof(SharedHeader);
+}
+
+int64_t getDataCapacity(const QSharedMemory &sharedMemory)
+{
+  return static_cast<int64_t>(sharedMemory.size()) - static_cast<int64_t>(sizeof(SharedHeader));
+}
+
+// If the data does not fit, the reply is the required capacity. YUView enlarges the shared memory
+// and requests the data again.
+void writeReplyData(QSharedMemory &sharedMemory, const QByteArray &data)
+{
+  auto header      = getHeader(sharedMemory);
+  header->dataSize = data.size();
+  if (header->dataSize > getDataCapacity(sharedMemory))
+    header->success = 0;
+  else
+    std::memcpy(getDataArea(sharedMemory), data.constData(), data.size());
+}
+
+} // namespace
+
+int DecoderHostServer::run(const QStringList &arguments)
+{
+  return run(arguments, createReferenceDecoder);
+}
+
+int DecoderHostServer::run(const QStringList &arguments, const DecoderFactory &createDecoder)
+{
+  if (arguments.size() != NR_HOST_ARGUMENTS)
+    return 1;
+
+  const auto baseKey = arguments.at(0).toStdString();
+  const auto engine  = DecoderEngineMapper.getValue(arguments.at(2).toStdString());
+  bool       parentProcessIDOk{};
+  const auto parentProcessID = arguments.at(3).toLongLong(&parentProcessIDOk);
+  if (!engine || !parentProcessIDOk)
+    return 1;
+
+  quitWhenParentProcessTerminates(parentProcessID);
+
+  QSystemSemaphore requestSemaphore(
+      QString::fromStdString(getRequestSemaphoreKey(baseKey)), 0, QSystemSemaphore::Open);
+  QSystemSemaphore replySemaphore(
+      QString::fromStdString(getReplySemaphoreKey(baseKey)), 0, QSystemSemaphore::Open);
+
+  auto sharedMemory = std::make_unique<QSharedMemory>(arguments.at(1));
+  if (!sharedMemory->attach())
+    return 1;
+
+  // Reply to the start with the decoder info (or the error)
+  auto decoder = createDecoder(*engine);
+  if (!decoder)
+    return 1;
+  {
+    auto header          = getHeader(*sharedMemory);
+    header->success      = !decoder->errorInDecoder();
+    header->decoderState = static_cast<int32_t>(decoder->state());
+    setText(*header,
+            decoder->errorInDecoder() ? decoder->decoderErrorString().toStdString()
+                                      : getDecoderInfo(*decoder));
+  }
+  replySemaphore.release();
+  if (decoder->errorInDecoder())
+    return 1;
+
+  // The data and the statistics of the current frame are kept in case they have to be transferred
+  // again after the shared memory was enlarged.
+  QByteArray            frameData;
+  QByteArray            frameStatistics;
+  stats::StatisticsData statisticsData;
+
+  while (true)
+  {
+    requestSemaphore.acquire();
+
+    auto header     = getHeader(*sharedMemory);
+    header->success = 1;
+
+    switch (header->command)
+    {
+    case Command::Quit:
+      return 0;
+    case Command::ResetDecoder:
+      decoder->resetDecoder();
+      frameData.clear();
+      frameStatistics.clear();
+      break;
+    case Command::SetDecodeSignal:
+    {
+      bool decoderResetNeeded{};
+      decoder->setDecodeSignal(header->argument, decoderResetNeeded);
+      if (decoderResetNeeded)
+        decoder->resetDecoder();
+      break;
+    }
+    case Command::PushData:
+    {
+      QByteArray data(getDataArea(*sharedMemory), static_cast<int>(header->dataSize));
+      header->success = decoder->pushData(data);
+      break;
+    }
+    case Command::DecodeNextFrame:
+    {
+      frameData.clear();
+      frameStatistics.clear();
+      statisticsData.setFrameData(-1, {});
+      header->success = decoder->decodeNextFrame();
+
+      const auto frameSize = decoder->getFrameSize();
+      header->frameWidth   = static_cast<int32_t>(frameSize.width);
+      header->frameHeight  = static_cast<int32_t>(frameSize.height);
+
+      const auto name   = decoder->getPixelFormatYUV().getName();
+      const auto length = std::min(name.size(), sizeof(header->pixelFormatName) - 1);
+      std::memcpy(header->pixelFormatName, name.data(), length);
+      header->pixelFormatName[length] = 0;
+      break;
+    }
+    case Command::GetRawFrameData:
+      if (frameData.isEmpty())
+        frameData = decoder->getRawFrameData();
+      writeReplyData(*sharedMemory, frameData);
+      break;
+    case Command::EnableStatistics:
+      decoder->enableStatisticsRetrieval(header->argument ? &statisticsData : nullptr);
+      break;
+    case Command::GetStatistics:
+      // Getting the frame data also retrieves the statistics of the frame from the decoder
+      if (frameData.isEmpty())
+        frameData = decoder->getRawFrameData();
+      if (frameStatistics.isEmpty())
+        frameStatistics = serializeFrameStatistics(statisticsData.getFrameData());
+      writeReplyData(*sharedMemory, frameStatistics);
+      break;
+    case Command::AttachSharedMemory:
+    {
+      const auto newKey          = QString::fromStdString(getText(*header));
+      auto       newSharedMemory = std::make_unique<QSharedMemory>(newKey);
+      if (!newSharedMemory->attach())
+        return 1;
+      // This detaches from the old segment. The reply goes to the new one.
+      sharedMemory    = std::move(newSharedMemory);
+      header          = getHeader(*sharedMemory);
+      header->success = 1;
+      break;
+    }
+    default:
+      header->success = 0;
+    }
+
+    header->decoderState = static_cast<int32_t>(decoder->state());
+    if (decoder->errorInDecoder())
+      setText(*header, decoder->decoderErrorString().toStdString());
+    replySemaphore.release();
+  }
+}
+
+} // namespace decoder::host
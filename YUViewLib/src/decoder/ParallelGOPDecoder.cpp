@@ -0,0 +1,409 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ParallelGOPDecoder.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace decoder
+{
+
+ParallelGOPDecoder::ParallelGOPDecoder(Bitstream bitstream,
+                                       unsigned  nrDecoders,
+                                       int64_t   maxBufferedBytes)
+    : bitstream(std::move(bitstream)), maxBufferedBytes(maxBufferedBytes)
+{
+  for (unsigned i = 0; i < std::max(nrDecoders, 1u); i++)
+    this->slots.push_back(std::make_unique<Slot>());
+  for (auto &slot : this->slots)
+  {
+    slot->thread.reset(QThread::create(&ParallelGOPDecoder::runSlot, this, std::ref(*slot)));
+    slot->thread->start();
+  }
+}
+
+ParallelGOPDecoder::~ParallelGOPDecoder()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->quit = true;
+  }
+  this->workAvailable.notify_all();
+  this->frameDecoded.notify_all();
+
+  for (auto &slot : this->slots)
+    slot->thread->wait();
+}
+
+std::optional<ParallelGOPDecoder::Frame> ParallelGOPDecoder::getFrame(int frameIdx)
+{
+  // The bitstream is not accessed while holding the mutex. This way, the owner of the bitstream
+  // can call clear while it holds its own lock to modify the bitstream.
+  const auto gop = this->bitstream.getGOP(frameIdx);
+  if (!gop)
+    return {};
+  std::vector<GOP> window({*gop});
+  while (window.size() < this->slots.size())
+  {
+    const auto followingGOP = this->bitstream.getGOP(window.back().lastFrame + 1);
+    if (!followingGOP)
+      break;
+    window.push_back(*followingGOP);
+  }
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->requests.push_back({*gop, frameIdx});
+  this->windowGOPs = window;
+  this->dropFramesOutsideOfWindow();
+
+  std::optional<Frame> frame;
+  while (!this->quit)
+  {
+    const auto it = this->frames.find(frameIdx);
+    if (it != this->frames.end())
+    {
+      frame = std::move(it->second);
+      this->bufferedBytes -= frame->data.size();
+      this->frames.erase(it);
+      break;
+    }
+
+    auto slot = this->findSlotForFrame(*gop, frameIdx);
+    if (!slot)
+    {
+      slot = this->findIdleSlot(*gop, true);
+      if (slot)
+        this->assignSlot(*slot, *gop);
+    }
+    if (slot && slot->failed)
+      break;
+
+    // The idle decoders decode the following GOPs
+    for (const auto &followingGOP : this->windowGOPs)
+    {
+      if (this->isDecodingOrDecoded(followingGOP))
+        continue;
+      const auto idleSlot = this->findIdleSlot(followingGOP, false);
+      if (!idleSlot)
+        break;
+      this->assignSlot(*idleSlot, followingGOP);
+    }
+
+    this->workAvailable.notify_all();
+    this->frameDecoded.wait(lock);
+  }
+
+  this->requests.erase(
+      std::find_if(this->requests.begin(), this->requests.end(), [&](const Request &request) {
+        return request.gop == *gop && request.frameIdx == frameIdx;
+      }));
+  // Paused decoders may continue now that the frame was taken
+  this->workAvailable.notify_all();
+  return frame;
+}
+
+void ParallelGOPDecoder::clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->restartAllSlots();
+}
+
+void ParallelGOPDecoder::setDecodeSignal(int signalID)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->decodeSignal == signalID)
+    return;
+  this->decodeSignal = signalID;
+  this->restartAllSlots();
+}
+
+void ParallelGOPDecoder::setRetrieveStatistics(bool retrieveStatistics)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->retrieveStatistics == retrieveStatistics)
+    return;
+  this->retrieveStatistics = retrieveStatistics;
+  this->restartAllSlots();
+}
+
+int64_t ParallelGOPDecoder::getBufferedBytes() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->bufferedBytes;
+}
+
+void ParallelGOPDecoder::runSlot(Slot &slot)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->workAvailable.wait(lock, [&]() { return this->quit || this->hasWork(slot); });
+    if (this->quit)
+    {
+      lock.unlock();
+      slot.reader.reset();
+      slot.decoder.reset();
+      return;
+    }
+
+    Job job;
+    job.gop                = *slot.gop;
+    job.seek               = std::exchange(slot.seekPending, false);
+    job.recreateReader     = std::exchange(slot.recreateReader, false);
+    job.decodeSignal       = this->decodeSignal;
+    job.retrieveStatistics = this->retrieveStatistics;
+    const auto generation  = slot.generation;
+    slot.busy              = true;
+
+    lock.unlock();
+    auto frame = this->decodeNextFrame(slot, job);
+    lock.lock();
+
+    slot.busy = false;
+    if (slot.generation != generation)
+      continue;
+
+    if (frame)
+    {
+      const auto frameIdx = ++slot.lastDecodedFrame;
+      const auto it       = this->frames.find(frameIdx);
+      if (it != this->frames.end())
+      {
+        this->bufferedBytes -= it->second.data.size();
+        this->frames.erase(it);
+      }
+      this->bufferedBytes += frame->data.size();
+      this->frames.emplace(frameIdx, std::move(*frame));
+    }
+    else
+      slot.failed = true;
+    this->frameDecoded.notify_all();
+  }
+}
+
+std::optional<ParallelGOPDecoder::Frame>
+ParallelGOPDecoder::decodeNextFrame(Slot &slot, const Job &job)
+{
+  if (!slot.decoder)
+  {
+    slot.decoder = this->bitstream.createDecoder();
+    if (!slot.decoder)
+      return {};
+  }
+  if (!slot.reader || job.recreateReader)
+  {
+    slot.reader = this->bitstream.createReader();
+    if (!slot.reader)
+      return {};
+  }
+
+  auto &decoder = *slot.decoder;
+  if (job.seek)
+  {
+    bool decoderResetNeeded{};
+    decoder.setDecodeSignal(job.decodeSignal, decoderResetNeeded);
+    decoder.enableStatisticsRetrieval(
+        (job.retrieveStatistics && decoder.statisticsSupported()) ? &slot.statisticsData : nullptr);
+    decoder.resetDecoder();
+    slot.repushData = false;
+
+    auto units = slot.reader->seekToGOP(job.gop);
+    if (!units)
+      return {};
+    for (auto &unit : *units)
+      if (!decoder.pushData(unit))
+        return {};
+  }
+
+  while (true)
+  {
+    while (decoder.state() == DecoderState::NeedsMoreData)
+    {
+      auto data       = slot.reader->getNextUnit(slot.repushData);
+      slot.repushData = !decoder.pushData(data);
+      // If pushing fails, the decoder must switch to retrieving frames. The data is pushed again
+      // afterwards.
+      if (slot.repushData && decoder.state() != DecoderState::RetrieveFrames)
+        return {};
+    }
+    if (decoder.state() != DecoderState::RetrieveFrames)
+      return {};
+
+    if (decoder.decodeNextFrame())
+    {
+      Frame frame;
+      // Getting the frame data also retrieves the statistics of the frame from the decoder
+      if (decoder.statisticsEnabled())
+        slot.statisticsData.setFrameData(-1, {});
+      frame.data = decoder.getRawFrameData();
+      if (frame.data.isEmpty())
+        return {};
+      if (decoder.statisticsEnabled())
+        frame.statistics = slot.statisticsData.getFrameData();
+      return frame;
+    }
+    if (decoder.state() == DecoderState::RetrieveFrames)
+      return {};
+  }
+}
+
+bool ParallelGOPDecoder::hasWork(const Slot &slot) const
+{
+  if (!slot.gop || slot.failed || slot.lastDecodedFrame >= slot.gop->lastFrame)
+    return false;
+  // Only decoding up to a requested frame may exceed the budget
+  if (this->isFrameRequested(slot))
+    return true;
+  return this->isInWindow(*slot.gop) && this->bufferedBytes < this->maxBufferedBytes;
+}
+
+bool ParallelGOPDecoder::isRequested(const GOP &gop) const
+{
+  return std::any_of(this->requests.begin(), this->requests.end(), [&](const Request &request) {
+    return request.gop == gop;
+  });
+}
+
+bool ParallelGOPDecoder::isFrameRequested(const Slot &slot) const
+{
+  return std::any_of(this->requests.begin(), this->requests.end(), [&](const Request &request) {
+    return request.gop == *slot.gop && request.frameIdx > slot.lastDecodedFrame;
+  });
+}
+
+bool ParallelGOPDecoder::isInWindow(const GOP &gop) const
+{
+  return std::find(this->windowGOPs.begin(), this->windowGOPs.end(), gop) !=
+         this->windowGOPs.end();
+}
+
+bool ParallelGOPDecoder::isDecodingOrDecoded(const GOP &gop) const
+{
+  for (const auto &slot : this->slots)
+    if (slot->gop == gop && !slot->failed)
+      return true;
+  const auto it = this->frames.lower_bound(gop.firstFrame);
+  return it != this->frames.end() && gop.contains(it->first);
+}
+
+ParallelGOPDecoder::Slot *ParallelGOPDecoder::findSlotForFrame(const GOP &gop, int frameIdx)
+{
+  for (auto &slot : this->slots)
+    if (slot->gop == gop && slot->lastDecodedFrame < frameIdx)
+      return slot.get();
+  return {};
+}
+
+ParallelGOPDecoder::Slot *ParallelGOPDecoder::findIdleSlot(const GOP &gop, bool forRequestedGOP)
+{
+  // The lower the better. A decoder that just finished the previous GOP can continue without
+  // seeking. Decoders of the window are only taken for a GOP that is requested right now.
+  const auto getCost = [&](const Slot &slot) -> std::optional<int> {
+    if (!slot.gop)
+      return 1;
+    const auto finished = slot.failed || slot.lastDecodedFrame >= slot.gop->lastFrame;
+    if (finished)
+      return (!slot.failed && !slot.busy && slot.lastDecodedFrame + 1 == gop.firstFrame) ? 0 : 1;
+    if (this->isRequested(*slot.gop))
+      return {};
+    if (!this->isInWindow(*slot.gop))
+      return 2;
+    if (forRequestedGOP)
+      return 3;
+    return {};
+  };
+
+  Slot *idleSlot{};
+  int   lowestCost{};
+  for (auto &slot : this->slots)
+  {
+    const auto cost = getCost(*slot);
+    if (cost && (!idleSlot || *cost < lowestCost))
+    {
+      idleSlot   = slot.get();
+      lowestCost = *cost;
+    }
+  }
+  return idleSlot;
+}
+
+void ParallelGOPDecoder::assignSlot(Slot &slot, const GOP &gop)
+{
+  const auto canContinue = slot.gop && !slot.failed && !slot.busy && !slot.seekPending &&
+                           slot.lastDecodedFrame == slot.gop->lastFrame &&
+                           slot.lastDecodedFrame + 1 == gop.firstFrame;
+
+  slot.gop    = gop;
+  slot.failed = false;
+  slot.generation++;
+  if (!canContinue)
+  {
+    slot.seekPending      = true;
+    slot.lastDecodedFrame = gop.firstFrame - 1;
+  }
+}
+
+void ParallelGOPDecoder::restartAllSlots()
+{
+  this->frames.clear();
+  this->bufferedBytes = 0;
+  for (auto &slot : this->slots)
+  {
+    slot->gop.reset();
+    slot->failed         = false;
+    slot->recreateReader = true;
+    slot->generation++;
+  }
+  // Waiting requests assign the decoders again
+  this->frameDecoded.notify_all();
+}
+
+void ParallelGOPDecoder::dropFramesOutsideOfWindow()
+{
+  for (auto it = this->frames.begin(); it != this->frames.end();)
+  {
+    const auto frameIdx           = it->first;
+    const auto isNeeded           = [frameIdx](const GOP &gop) { return gop.contains(frameIdx); };
+    const auto isNeededForRequest = [&](const Request &request) { return isNeeded(request.gop); };
+    if (std::any_of(this->windowGOPs.begin(), this->windowGOPs.end(), isNeeded) ||
+        std::any_of(this->requests.begin(), this->requests.end(), isNeededForRequest))
+      ++it;
+    else
+    {
+      this->bufferedBytes -= it->second.data.size();
+      it = this->frames.erase(it);
+    }
+  }
+}
+
+} // namespace decoder
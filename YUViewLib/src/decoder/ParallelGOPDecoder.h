@@ -0,0 +1,209 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "decoderBase.h"
+
+#include <common/MemoryAccountant.h>
+
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QThread>
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace decoder
+{
+
+/* Decodes the GOPs of a bitstream in parallel with several decoders. A GOP starts at a random
+ * access point and can be decoded independently of all other GOPs (see parser::SeekIndex). When a
+ * frame is requested, one decoder decodes its GOP while the other decoders decode the following
+ * GOPs. The decoded frames are kept until they are requested. Only decoding up to a requested
+ * frame may exceed the byte budget, all other decoders pause until frames are taken.
+ * Every decoder runs in its own QThread so that the readers may use Qt objects that need an event
+ * dispatcher (e.g. the file watcher of a file source). The decoders and readers are created and
+ * destroyed in that thread. All functions are thread-safe.
+ */
+class ParallelGOPDecoder
+{
+public:
+  // The first and last frame (display order) of a GOP
+  struct GOP
+  {
+    int firstFrame{};
+    int lastFrame{};
+
+    bool contains(int frameIdx) const
+    {
+      return frameIdx >= this->firstFrame && frameIdx <= this->lastFrame;
+    }
+    bool operator==(const GOP &other) const
+    {
+      return this->firstFrame == other.firstFrame && this->lastFrame == other.lastFrame;
+    }
+  };
+
+  // Reads the bitstream for one of the decoders. Every decoder has its own reader.
+  class BitstreamReader
+  {
+  public:
+    virtual ~BitstreamReader() = default;
+
+    // Position the reader at the random access point of the GOP. Return the data that must be
+    // pushed to the decoder first (e.g. the parameter sets) or an empty optional on errors.
+    virtual std::optional<QByteArrayList> seekToGOP(const GOP &gop) = 0;
+    // Get the next unit of data (e.g. a NAL unit). An empty array is the end of the bitstream.
+    virtual QByteArray getNextUnit(bool getLastUnitAgain) = 0;
+  };
+
+  // These functions are called from the decoding threads and must be thread-safe
+  struct Bitstream
+  {
+    // Get the GOP of the given frame. Empty if the frame does not exist.
+    std::function<std::optional<GOP>(int frameIdx)>   getGOP;
+    std::function<std::unique_ptr<BitstreamReader>()> createReader;
+    std::function<std::unique_ptr<decoderBase>()>     createDecoder;
+  };
+
+  struct Frame
+  {
+    QByteArray data;
+    // Only set if the statistics are retrieved and the decoder supports them
+    std::optional<std::map<int, stats::FrameTypeData>> statistics;
+  };
+
+  ParallelGOPDecoder(Bitstream bitstream, unsigned nrDecoders, int64_t maxBufferedBytes);
+  ~ParallelGOPDecoder();
+
+  ParallelGOPDecoder(const ParallelGOPDecoder &)            = delete;
+  ParallelGOPDecoder &operator=(const ParallelGOPDecoder &) = delete;
+
+  // Get the decoded frame. This blocks until the frame was decoded. Return an empty optional if
+  // the frame does not exist or decoding failed. Each decoded frame is handed out once.
+  std::optional<Frame> getFrame(int frameIdx);
+
+  // Drop all decoded frames. All decoders start at a random access point again and the readers
+  // are recreated (e.g. after the bitstream changed).
+  void clear();
+
+  // Changing these restarts decoding (see clear)
+  void setDecodeSignal(int signalID);
+  void setRetrieveStatistics(bool retrieveStatistics);
+
+  unsigned getNumberDecoders() const { return unsigned(this->slots.size()); }
+  int64_t  getBufferedBytes() const;
+
+private:
+  struct Slot
+  {
+    std::unique_ptr<decoderBase>     decoder;
+    std::unique_ptr<BitstreamReader> reader;
+    stats::StatisticsData            statisticsData;
+    bool                             repushData{};
+
+    // Only the members above are accessed by the thread of the slot without holding the mutex
+    std::optional<GOP> gop;
+    int                lastDecodedFrame{-1};
+    bool               seekPending{};
+    bool               recreateReader{};
+    bool               failed{};
+    bool               busy{};
+    // Changed whenever the slot is assigned to a GOP. The frame that is decoded while this changes
+    // is dropped.
+    unsigned generation{};
+
+    std::unique_ptr<QThread> thread;
+  };
+
+  // A frame that getFrame is waiting for
+  struct Request
+  {
+    GOP gop;
+    int frameIdx{};
+  };
+
+  // What the thread of a slot does next
+  struct Job
+  {
+    GOP  gop;
+    bool seek{};
+    bool recreateReader{};
+    int  decodeSignal{};
+    bool retrieveStatistics{};
+  };
+
+  void                 runSlot(Slot &slot);
+  std::optional<Frame> decodeNextFrame(Slot &slot, const Job &job);
+
+  bool  hasWork(const Slot &slot) const;
+  bool  isRequested(const GOP &gop) const;
+  bool  isFrameRequested(const Slot &slot) const;
+  bool  isInWindow(const GOP &gop) const;
+  bool  isDecodingOrDecoded(const GOP &gop) const;
+  Slot *findSlotForFrame(const GOP &gop, int frameIdx);
+  Slot *findIdleSlot(const GOP &gop, bool forRequestedGOP);
+  void  assignSlot(Slot &slot, const GOP &gop);
+  void  restartAllSlots();
+  void  dropFramesOutsideOfWindow();
+
+  Bitstream bitstream;
+  int64_t   maxBufferedBytes{};
+
+  mutable std::mutex      mutex;
+  std::condition_variable workAvailable;
+  std::condition_variable frameDecoded;
+  bool                    quit{};
+
+  std::vector<std::unique_ptr<Slot>> slots;
+  std::map<int, Frame>               frames;
+  int64_t                            bufferedBytes{};
+
+  // The frames that are waiting to be decoded. The window is the GOP of the frame that was
+  // requested last and the GOPs that follow it. Frames of other GOPs are dropped.
+  std::vector<Request> requests;
+  std::vector<GOP>     windowGOPs;
+
+  int  decodeSignal{};
+  bool retrieveStatistics{};
+
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Decode buffers", [this] { return this->getBufferedBytes(); })};
+};
+
+} // namespace decoder
@@ -119,6 +119,9 @@ public:
   // Push data to the decoder (until no more data is needed)
   // In order to make the interface generic, the pushData function accepts data only without start
   // codes
+  // The data may be a view into the read buffer of the file source (see
+  // FileSourceAnnexBFile::getNextNALUnit) which is only valid during the call. Decoders must copy
+  // everything they keep after returning.
   virtual bool pushData(QByteArray &data) = 0;
 
   DecoderState state() const { return this->decoderState; }
@@ -87,6 +87,13 @@ Subsampling convertFromInternalSubsampling(Dav1dPixelLayout layout)
   return Subsampling::UNKNOWN;
 }
 
+// The data pushed to dav1d is wrapped in a (shallow) copy of the QByteArray. dav1d holds the
+// reference until it no longer needs the data and then calls this function.
+void freeWrappedByteArray(const uint8_t *, void *cookie)
+{
+  delete static_cast<QByteArray *>(cookie);
+}
+
 } // namespace
 
 Size Dav1dPictureWrapper::getFrameSize() const
@@ -201,7 +208,9 @@ void decoderDav1d::resolveLibraryFunctionPointers()
   if (!resolve(this->lib.dav1d_flush, "dav1d_flush"))
     return;
 
-  if (!resolve(this->lib.dav1d_data_create, "dav1d_data_create"))
+  if (!resolve(this->lib.dav1d_data_wrap, "dav1d_data_wrap"))
+    return;
+  if (!resolve(this->lib.dav1d_data_unref, "dav1d_data_unref"))
     return;
 
   DEBUG_DAV1D("decoderDav1d::resolveLibraryFunctionPointers - decoding functions found");
@@ -446,23 +455,31 @@ bool decoderDav1d::pushData(QByteArray &data)
   }
   else
   {
-    // Since dav1d consumes the data (takes ownership), we need to copy it to a new buffer from
-    // dav1d
-    Dav1dData *dav1dData      = new Dav1dData;
-    uint8_t   *rawDataPointer = this->lib.dav1d_data_create(dav1dData, data.size());
-    memcpy(rawDataPointer, data.data(), data.size());
+    // dav1d takes a reference to the data. Instead of copying the data into a buffer from dav1d,
+    // the data is wrapped in a shallow copy of the QByteArray which is released by dav1d.
+    Dav1dData  dav1dData{};
+    const auto wrappedData = new QByteArray(data);
+    if (this->lib.dav1d_data_wrap(&dav1dData,
+                                  reinterpret_cast<const uint8_t *>(wrappedData->constData()),
+                                  size_t(wrappedData->size()),
+                                  freeWrappedByteArray,
+                                  wrappedData) != 0)
+    {
+      delete wrappedData;
+      return setErrorB("Error wrapping data for the decoder.");
+    }
 
-    int err = this->lib.dav1d_send_data(decoder, dav1dData);
+    int err = this->lib.dav1d_send_data(decoder, &dav1dData);
     if (err == -EAGAIN)
     {
       // The data was not consumed and must be pushed again after retrieving some frames
-      delete dav1dData;
+      this->lib.dav1d_data_unref(&dav1dData);
       DEBUG_DAV1D("decoderDav1d::pushData need to re-push data");
       return false;
     }
     else if (err != 0)
     {
-      delete dav1dData;
+      this->lib.dav1d_data_unref(&dav1dData);
       DEBUG_DAV1D("decoderDav1d::pushData error pushing data");
       return setErrorB("Error pushing data to the decoder.");
     }
@@ -34,6 +34,8 @@
 
 #include <common/Functions.h>
 
+#include <cstring>
+
 #define DECODERFFMPEG_DEBUG_OUTPUT 0
 #if DECODERFFMPEG_DEBUG_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -312,10 +314,21 @@ bool decoderFFmpeg::pushData(QByteArray &data)
   else
     DEBUG_FFMPEG("decoderFFmpeg::pushData: Pushing data length " << data.length());
 
-  // Add some padding
-  data.append(this->avPacketPaddingData);
-
-  this->raw_pkt.setData(data);
+  // Add the padding that ffmpeg requires. If there is enough room in the data, do this in place.
+  // Views (e.g. into the file buffer) can not be extended so they are copied into a reused buffer.
+  const auto paddingSize = this->avPacketPaddingData.size();
+  if (data.isDetached() && data.capacity() - data.size() >= paddingSize)
+  {
+    data.append(this->avPacketPaddingData);
+    this->raw_pkt.setData(data);
+  }
+  else
+  {
+    this->paddedPacketData.resize(data.size() + paddingSize);
+    std::memcpy(this->paddedPacketData.data(), data.constData(), size_t(data.size()));
+    std::memset(this->paddedPacketData.data() + data.size(), 0, size_t(paddingSize));
+    this->raw_pkt.setData(this->paddedPacketData);
+  }
   this->raw_pkt.setDTS(AV_NOPTS_VALUE);
   this->raw_pkt.setPTS(AV_NOPTS_VALUE);
 
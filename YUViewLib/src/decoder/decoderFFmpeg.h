@@ -106,6 +106,8 @@ protected:
 
   // An array of AV_INPUT_BUFFER_PADDING_SIZE zeros to be added as padding in pushData
   QByteArray avPacketPaddingData;
+  // Reused for data that can not be padded in place
+  QByteArray paddedPacketData;
 
   QString codecName{};
 };
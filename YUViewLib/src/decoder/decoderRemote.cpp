@@ -0,0 +1,192 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "decoderRemote.h"
+
+#include "DecoderHostPool.h"
+
+namespace decoder
+{
+
+decoderRemote::decoderRemote(std::unique_ptr<host::DecoderHostConnection> connection,
+                             bool                                         cachingDecoder)
+    : decoderBase(cachingDecoder), connection(std::move(connection))
+{
+  this->internalsSupported = this->connection->getDecoderInfo().statisticsSupported;
+}
+
+decoderRemote::~decoderRemote()
+{
+  host::DecoderHostPool::instance().release(std::move(this->connection));
+}
+
+std::unique_ptr<decoderRemote>
+decoderRemote::create(const DecoderEngine engine, const int signalID, const bool cachingDecoder)
+{
+  auto connection = host::DecoderHostPool::instance().acquire(engine);
+  if (!connection)
+    return {};
+
+  auto decoder            = std::make_unique<decoderRemote>(std::move(connection), cachingDecoder);
+  bool decoderResetNeeded = false;
+  decoder->setDecodeSignal(signalID, decoderResetNeeded);
+  return decoder;
+}
+
+void decoderRemote::resetDecoder()
+{
+  decoderBase::resetDecoder();
+  this->currentOutputBuffer.clear();
+  this->resetPending = true;
+}
+
+int decoderRemote::nrSignalsSupported() const
+{
+  return this->connection->getDecoderInfo().signalNames.size();
+}
+
+QStringList decoderRemote::getSignalNames() const
+{
+  return this->connection->getDecoderInfo().signalNames;
+}
+
+void decoderRemote::setDecodeSignal(int signalID, bool &decoderResetNeeded)
+{
+  decoderBase::setDecodeSignal(signalID, decoderResetNeeded);
+  this->decodeSignalPending = true;
+}
+
+bool decoderRemote::decodeNextFrame()
+{
+  if (this->decoderState != DecoderState::RetrieveFrames || !this->sendPendingRequests())
+    return false;
+
+  this->currentOutputBuffer.clear();
+  const auto reply = this->connection->request(host::Command::DecodeNextFrame);
+  if (!this->handleReply(reply) || !reply->success)
+    return false;
+
+  this->frameSize = reply->frameSize;
+  this->rawFormat = video::RawFormat::YUV;
+  this->formatYUV = video::yuv::PixelFormatYUV(reply->pixelFormatName);
+  return true;
+}
+
+QByteArray decoderRemote::getRawFrameData()
+{
+  if (this->decoderState != DecoderState::RetrieveFrames)
+    return {};
+
+  if (this->currentOutputBuffer.isEmpty())
+  {
+    const auto reply = this->connection->request(host::Command::GetRawFrameData);
+    if (this->handleReply(reply) && reply->success)
+      this->currentOutputBuffer = reply->data;
+
+    // Like the local decoders, the statistics of the frame are retrieved with its data
+    if (this->statisticsEnabled() && !this->retrieveStatistics())
+      return {};
+  }
+  return this->currentOutputBuffer;
+}
+
+bool decoderRemote::pushData(QByteArray &data)
+{
+  if (!this->sendPendingRequests())
+    return false;
+
+  const auto reply = this->connection->request(host::Command::PushData, 0, data);
+  return this->handleReply(reply) && reply->success;
+}
+
+QStringList decoderRemote::getLibraryPaths() const
+{
+  return this->connection->getDecoderInfo().libraryPaths;
+}
+
+QString decoderRemote::getDecoderName() const
+{
+  return this->connection->getDecoderInfo().decoderName;
+}
+
+QString decoderRemote::getCodecName() const
+{
+  return this->connection->getDecoderInfo().codecName;
+}
+
+bool decoderRemote::retrieveStatistics()
+{
+  const auto reply = this->connection->request(host::Command::GetStatistics);
+  if (!this->handleReply(reply) || !reply->success)
+    return false;
+
+  auto frameData = host::deserializeFrameStatistics(reply->data);
+  if (!frameData)
+    return this->setErrorB("Invalid statistics from the decoder host process.");
+  this->statisticsData->setFrameData(this->statisticsData->getFrameIndex(), std::move(*frameData));
+  return true;
+}
+
+bool decoderRemote::sendPendingRequests()
+{
+  if (this->decodeSignalPending.exchange(false))
+    if (!this->handleReply(
+            this->connection->request(host::Command::SetDecodeSignal, this->decodeSignal)))
+      return false;
+
+  if (this->statisticsEnabled() != this->hostStatisticsEnabled)
+  {
+    this->hostStatisticsEnabled = this->statisticsEnabled();
+    if (!this->handleReply(this->connection->request(host::Command::EnableStatistics,
+                                                     this->hostStatisticsEnabled ? 1 : 0)))
+      return false;
+  }
+
+  if (this->resetPending.exchange(false))
+    if (!this->handleReply(this->connection->request(host::Command::ResetDecoder)))
+      return false;
+
+  return true;
+}
+
+bool decoderRemote::handleReply(const std::optional<host::DecoderHostConnection::Reply> &reply)
+{
+  if (!reply)
+    return this->setErrorB("The decoder host process terminated.");
+
+  this->decoderState = reply->decoderState;
+  if (this->decoderState == DecoderState::Error)
+    return this->setErrorB(reply->errorString);
+  return true;
+}
+
+} // namespace decoder
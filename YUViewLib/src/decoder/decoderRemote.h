@@ -0,0 +1,92 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "DecoderHostConnection.h"
+#include "decoderBase.h"
+
+#include <atomic>
+#include <memory>
+
+namespace decoder
+{
+
+/* A decoder that runs in a decoder host process (see DecoderHostProtocol.h). This is used for the
+ * caching decoders of the reference decoder libraries (HM and VTM). They keep global state and
+ * can not run in the same process as the interactive decoder. Every caching decoder gets its own
+ * host so that several items can be cached at the same time. If statistics retrieval is enabled,
+ * the statistics of a frame are transferred from the host together with its raw data.
+ */
+class decoderRemote : public decoderBase
+{
+public:
+  decoderRemote(std::unique_ptr<host::DecoderHostConnection> connection,
+                bool                                         cachingDecoder = false);
+  ~decoderRemote();
+
+  // Create the decoder in a host process. Return nullptr if this is not possible (e.g. if the
+  // host executable is not available).
+  static std::unique_ptr<decoderRemote>
+  create(const DecoderEngine engine, const int signalID, const bool cachingDecoder = false);
+
+  void resetDecoder() override;
+
+  int         nrSignalsSupported() const override;
+  QStringList getSignalNames() const override;
+  void        setDecodeSignal(int signalID, bool &decoderResetNeeded) override;
+
+  bool       decodeNextFrame() override;
+  QByteArray getRawFrameData() override;
+  bool       pushData(QByteArray &data) override;
+
+  QStringList getLibraryPaths() const override;
+  QString     getDecoderName() const override;
+  QString     getCodecName() const override;
+
+private:
+  // Resetting the decoder and changing the decode signal may be requested from the main thread
+  // while the caching thread is decoding. These (and enabling the statistics retrieval) are sent to
+  // the host with the next request.
+  bool sendPendingRequests();
+  bool handleReply(const std::optional<host::DecoderHostConnection::Reply> &reply);
+  bool retrieveStatistics();
+
+  std::unique_ptr<host::DecoderHostConnection> connection;
+  std::atomic_bool                             resetPending{true};
+  std::atomic_bool                             decodeSignalPending{false};
+  bool                                         hostStatisticsEnabled{false};
+
+  QByteArray currentOutputBuffer;
+};
+
+} // namespace decoder
@@ -50,6 +50,7 @@ public:
 
   void setTypeHEVC() { this->codecName = "hevc"; }
   void setTypeAVC() { this->codecName = "h264"; }
+  void setTypeAV1() { this->codecName = "av1"; }
 
   bool isHEVC() const { return this->codecName == "hevc"; }
   bool isAVC() const { return this->codecName == "h264"; }
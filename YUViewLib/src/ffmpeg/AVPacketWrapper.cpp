@@ -83,11 +83,12 @@ bool checkForObuFormat(QByteArray &data)
   //       That should also be used here so we only have one place where we parse OBUs.
   try
   {
+    const auto byteVector = parser::reader::SubByteReaderLogging::convertToByteVector(data);
+
     size_t posInData = 0;
-    while (posInData + 2 <= size_t(data.length()))
+    while (posInData + 2 <= byteVector.size())
     {
-      parser::reader::SubByteReaderLogging reader(
-          parser::reader::SubByteReaderLogging::convertToByteVector(data), nullptr, "", posInData);
+      parser::reader::SubByteReaderLogging reader(byteVector, nullptr, "", posInData);
 
       QString bitsRead;
       auto    forbiddenBit = reader.readFlag("obu_forbidden_bit");
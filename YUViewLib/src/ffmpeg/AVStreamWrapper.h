@@ -61,7 +61,9 @@ public:
   AVPixelFormat            getPixelFormat();
   QByteArray               getExtradata();
   int                      getIndex();
+  int64_t                  getNbFrames();
   AVCodecParametersWrapper getCodecpar();
+  AVStream *               getStream() const { return this->stream; }
 
 private:
   void update();
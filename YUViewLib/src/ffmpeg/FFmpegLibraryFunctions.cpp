@@ -81,6 +81,18 @@ bool bindLibraryFunctions(QLibrary &                                 lib,
     return false;
   if (!resolveFunction(lib, functions.avformat_version, "avformat_version", log))
     return false;
+
+  // Optional. Don't log if these are missing (older versions).
+  if (!resolveFunction(lib,
+                       functions.avformat_index_get_entries_count,
+                       "avformat_index_get_entries_count",
+                       nullptr) ||
+      !resolveFunction(
+          lib, functions.avformat_index_get_entry, "avformat_index_get_entry", nullptr))
+  {
+    functions.avformat_index_get_entries_count = {};
+    functions.avformat_index_get_entry         = {};
+  }
   return true;
 }
 
@@ -67,6 +67,10 @@ public:
     std::function<int(AVFormatContext *s, int stream_index, int64_t timestamp, int flags)>
                               av_seek_frame;
     std::function<unsigned()> avformat_version;
+    // Access to the index entries of a stream. These were added in avformat 58.78 (FFmpeg 4.4).
+    // They are optional. If they are not available, the index can not be read.
+    std::function<int(const AVStream *st)>                     avformat_index_get_entries_count;
+    std::function<const AVIndexEntry *(AVStream *st, int idx)> avformat_index_get_entry;
   };
   AvFormatFunctions avformat{};
 
@@ -31,6 +31,9 @@
  */
 
 #include "FFmpegVersionHandler.h"
+
+#include <algorithm>
+
 #include <QDateTime>
 #include <QDir>
 
@@ -109,6 +112,20 @@ auto SupportedLibraryVersionCombinations = {
     LibraryVersion(54, 56, 56, 1),
 };
 
+// The accessor functions for the index entries only exist in avformat 58 and newer. The layout of
+// the entries did not change since.
+#define AVINDEX_KEYFRAME 0x0001
+#define AVINDEX_DISCARD_FRAME 0x0002
+
+typedef struct AVIndexEntry_58_60
+{
+  int64_t pos;
+  int64_t timestamp;
+  int     flags : 2;
+  int     size : 30;
+  int     min_distance;
+} AVIndexEntry_58_60;
+
 } // namespace
 
 // bool FFmpegVersionHandler::AVCodecContextCopyParameters(AVCodecContext *srcCtx, AVCodecContext
@@ -510,6 +527,31 @@ int FFmpegVersionHandler::seekBeginning(AVFormatContextWrapper &fmt)
   return lib.avformat.av_seek_frame(fmt.getFormatCtx(), -1, fmt.getStartTime(), 0);
 }
 
+std::vector<FFmpegVersionHandler::IndexEntry>
+FFmpegVersionHandler::getIndexEntries(AVStreamWrapper &stream)
+{
+  if (!this->lib.avformat.avformat_index_get_entries_count ||
+      !this->lib.avformat.avformat_index_get_entry || !stream)
+    return {};
+
+  auto avStream = stream.getStream();
+  auto count    = this->lib.avformat.avformat_index_get_entries_count(avStream);
+
+  std::vector<IndexEntry> entries;
+  entries.reserve(std::max(count, 0));
+  for (int i = 0; i < count; i++)
+  {
+    auto entry = reinterpret_cast<const AVIndexEntry_58_60 *>(
+        this->lib.avformat.avformat_index_get_entry(avStream, i));
+    if (entry == nullptr)
+      return {};
+    if (entry->flags & AVINDEX_DISCARD_FRAME)
+      continue;
+    entries.push_back({entry->timestamp, (entry->flags & AVINDEX_KEYFRAME) != 0});
+  }
+  return entries;
+}
+
 bool FFmpegVersionHandler::loadFFmpegLibraryInPath(QString path)
 {
   bool success = false;
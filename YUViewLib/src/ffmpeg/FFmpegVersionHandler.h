@@ -108,6 +108,16 @@ public:
   int seekFrame(AVFormatContextWrapper &fmt, int stream_idx, int64_t dts);
   int seekBeginning(AVFormatContextWrapper &fmt);
 
+  // The index that the demuxer read from the container (e.g. the sample tables of MP4 files). One
+  // entry per packet in decode order with the DTS in the time base of the stream. Entries that are
+  // marked as to be discarded are skipped. Empty if the libraries can not provide the index.
+  struct IndexEntry
+  {
+    int64_t dts{};
+    bool    keyframe{};
+  };
+  std::vector<IndexEntry> getIndexEntries(AVStreamWrapper &stream);
+
   // All the function pointers of the ffmpeg library
   FFmpegLibraryFunctions lib;
 
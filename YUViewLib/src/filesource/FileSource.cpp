@@ -33,6 +33,7 @@
 #include "FileSource.h"
 
 #include <common/Formatting.h>
+#include <common/Tracing.h>
 #include <common/Typedef.h>
 
 #include <QDateTime>
@@ -70,6 +71,7 @@ bool FileSource::openFile(const std::filesystem::path &filePath)
     return false;
 
   this->fullFilePath = filePath;
+  this->positionalReader.open(filePath);
 
   this->updateFileWatchSetting();
   this->fileChanged = false;
@@ -90,12 +92,31 @@ int64_t FileSource::readBytes(QByteArray &targetBuffer, int64_t startPos, int64_
   QThread::msleep(50);
 #endif
 
+  TRACE_SCOPE("file", "FileSource::readBytes");
+
   // lock the seek and read function
   QMutexLocker locker(&this->readMutex);
   this->srcFile.seek(startPos);
   return this->srcFile.read(targetBuffer.data(), nrBytes);
 }
 
+int64_t FileSource::readBytesAt(QByteArray &targetBuffer, int64_t startPos, int64_t nrBytes) const
+{
+  if (!this->isOk())
+    return 0;
+
+  if (targetBuffer.size() < nrBytes)
+    targetBuffer.resize(nrBytes);
+
+#if FILESOURCE_DEBUG_SIMULATESLOWLOADING && !NDEBUG
+  QThread::msleep(50);
+#endif
+
+  TRACE_SCOPE("file", "FileSource::readBytesAt");
+
+  return this->positionalReader.read(targetBuffer.data(), startPos, nrBytes);
+}
+
 std::vector<InfoItem> FileSource::getFileInfoList() const
 {
   if (!this->isFileOpened)
@@ -42,6 +42,7 @@
 #include <common/EnumMapper.h>
 #include <common/InfoItemAndData.h>
 #include <common/Typedef.h>
+#include <dataSource/PositionalFileReader.h>
 
 #include <filesystem>
 
@@ -51,15 +52,17 @@ enum class InputFormat
   AnnexBHEVC, // Raw HEVC annex B file
   AnnexBAVC,  // Raw AVC annex B file
   AnnexBVVC,  // Raw VVC annex B file
-  Libav       // This is some sort of container file which we will read using libavformat
+  Libav,      // This is some sort of container file which we will read using libavformat
+  AV1OBU      // Raw AV1 file (IVF, low overhead OBU or annex B)
 };
 
-constexpr EnumMapper<InputFormat, 5> InputFormatMapper = {
+constexpr EnumMapper<InputFormat, 6> InputFormatMapper = {
     std::make_pair(InputFormat::Invalid, "Invalid"),
     std::make_pair(InputFormat::AnnexBHEVC, "AnnexBHEVC"),
     std::make_pair(InputFormat::AnnexBAVC, "AnnexBAVC"),
     std::make_pair(InputFormat::AnnexBVVC, "AnnexBVVC"),
-    std::make_pair(InputFormat::Libav, "Libav")};
+    std::make_pair(InputFormat::Libav, "Libav"),
+    std::make_pair(InputFormat::AV1OBU, "AV1OBU")};
 
 /* The FileSource class provides functions for accessing files. Besides the reading of
  * certain blocks of the file, it also directly provides information on the file for the
@@ -93,6 +96,9 @@ public:
   // Read the given number of bytes starting at startPos into the QByteArray out
   // Resize the QByteArray if necessary. Return how many bytes were read.
   int64_t readBytes(QByteArray &targetBuffer, int64_t startPos, int64_t nrBytes);
+  // Same as readBytes but without locking and without using or changing the position of the file.
+  // Multiple threads can read different parts of the file at the same time.
+  int64_t readBytesAt(QByteArray &targetBuffer, int64_t startPos, int64_t nrBytes) const;
 
   void updateFileWatchSetting();
   void clearFileCache();
@@ -109,5 +115,6 @@ private:
   QFileSystemWatcher fileWatcher{};
   bool               fileChanged{};
 
-  QMutex readMutex;
+  QMutex                           readMutex;
+  datasource::PositionalFileReader positionalReader;
 };
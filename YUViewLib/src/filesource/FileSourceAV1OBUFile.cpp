@@ -0,0 +1,794 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileSourceAV1OBUFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <parser/AV1/obu_header.h>
+#include <parser/AV1/sequence_header_obu.h>
+#include <parser/common/SubByteReaderLogging.h>
+
+#define AV1OBUFILE_DEBUG_OUTPUT 0
+#if AV1OBUFILE_DEBUG_OUTPUT && !NDEBUG
+#include <QDebug>
+#define DEBUG_AV1OBUFILE(f) qDebug() << f
+#else
+#define DEBUG_AV1OBUFILE(f) ((void)0)
+#endif
+
+namespace
+{
+
+using FileFormat   = FileSourceAV1OBUFile::FileFormat;
+using TemporalUnit = FileSourceAV1OBUFile::TemporalUnit;
+
+constexpr size_t BUFFER_SIZE           = 500000;
+constexpr size_t FORMAT_DETECTION_SIZE = 64;
+constexpr size_t IVF_FILE_HEADER_SIZE  = 32;
+constexpr size_t IVF_FRAME_HEADER_SIZE = 12;
+constexpr size_t MAX_LEB128_BYTES      = 8;
+// The OBU header, the extension header and the size field
+constexpr size_t MAX_OBU_HEADER_SIZE = 2 + MAX_LEB128_BYTES;
+
+constexpr unsigned OBU_SEQUENCE_HEADER    = 1;
+constexpr unsigned OBU_TEMPORAL_DELIMITER = 2;
+constexpr unsigned OBU_FRAME_HEADER       = 3;
+constexpr unsigned OBU_FRAME              = 6;
+
+constexpr unsigned KEY_FRAME = 0;
+
+uint64_t readLittleEndian(const uint8_t *data, const unsigned nrBytes)
+{
+  uint64_t value = 0;
+  for (unsigned i = 0; i < nrBytes; i++)
+    value |= uint64_t(data[i]) << (i * 8);
+  return value;
+}
+
+struct LEB128
+{
+  uint64_t value{};
+  size_t   nrBytes{};
+};
+
+std::optional<LEB128> readLEB128(const uint8_t *data, const size_t size)
+{
+  LEB128 leb128;
+  for (size_t i = 0; i < MAX_LEB128_BYTES && i < size; i++)
+  {
+    leb128.value |= uint64_t(data[i] & 0x7f) << (i * 7);
+    if (!(data[i] & 0x80))
+    {
+      leb128.nrBytes = i + 1;
+      return leb128;
+    }
+  }
+  return {};
+}
+
+void appendLEB128(QByteArray &data, uint64_t value)
+{
+  do
+  {
+    auto byte = uint8_t(value & 0x7f);
+    value >>= 7;
+    if (value > 0)
+      byte |= 0x80;
+    data.append(char(byte));
+  } while (value > 0);
+}
+
+struct OBUHeader
+{
+  unsigned type{};
+  bool     hasSizeField{};
+  // The number of bytes of the OBU header including the extension and the size field
+  size_t                  headerSize{};
+  std::optional<uint64_t> payloadSize;
+};
+
+std::optional<OBUHeader> parseOBUHeader(const uint8_t *data, const size_t size)
+{
+  // The forbidden bit must be zero
+  if (size < 1 || (data[0] & 0x80))
+    return {};
+
+  OBUHeader header;
+  header.type         = (data[0] >> 3) & 0x0f;
+  header.hasSizeField = (data[0] & 0x02) != 0;
+  header.headerSize   = (data[0] & 0x04) ? 2 : 1;
+  if (header.headerSize > size)
+    return {};
+
+  if (header.hasSizeField)
+  {
+    const auto obuSize = readLEB128(data + header.headerSize, size - header.headerSize);
+    if (!obuSize)
+      return {};
+    header.headerSize += obuSize->nrBytes;
+    header.payloadSize = obuSize->value;
+  }
+  return header;
+}
+
+// Get the range [start, end) of an element that is prefixed with its size in leb128 (Annex B)
+std::optional<std::pair<size_t, size_t>>
+getSizePrefixedRange(const uint8_t *data, const size_t pos, const size_t end)
+{
+  const auto size = readLEB128(data + pos, end - pos);
+  if (!size)
+    return {};
+  const auto start = pos + size->nrBytes;
+  if (size->value > end - start)
+    return {};
+  return std::make_pair(start, start + size_t(size->value));
+}
+
+// Append the OBU in the low overhead format. If the OBU has no size field, one is added.
+void appendOBUWithSizeField(QByteArray      &target,
+                            const uint8_t   *obu,
+                            const OBUHeader &header,
+                            const uint64_t   payloadSize)
+{
+  if (header.hasSizeField)
+  {
+    target.append(reinterpret_cast<const char *>(obu), int(header.headerSize + payloadSize));
+    return;
+  }
+
+  target.append(char(obu[0] | 0x02));
+  if (header.headerSize == 2)
+    target.append(char(obu[1]));
+  appendLEB128(target, payloadSize);
+  target.append(reinterpret_cast<const char *>(obu + header.headerSize), int(payloadSize));
+}
+
+FileFormat detectFileFormatFromData(const QByteArray &fileStart)
+{
+  const auto data = reinterpret_cast<const uint8_t *>(fileStart.constData());
+  const auto size = size_t(fileStart.size());
+
+  if (size >= IVF_FILE_HEADER_SIZE && std::memcmp(data, "DKIF", 4) == 0 &&
+      std::memcmp(data + 8, "AV01", 4) == 0)
+    return FileFormat::IVF;
+
+  // A low overhead bitstream starts with a temporal delimiter which has no payload
+  const auto firstOBU = parseOBUHeader(data, size);
+  if (firstOBU && firstOBU->type == OBU_TEMPORAL_DELIMITER && firstOBU->payloadSize == 0u)
+    return FileFormat::LowOverhead;
+
+  // In the Annex B format, the size of the temporal unit, the frame unit and the OBU come first.
+  // The first OBU must also be a temporal delimiter.
+  const auto temporalUnit = getSizePrefixedRange(data, 0, size);
+  if (!temporalUnit)
+    return FileFormat::Unknown;
+  const auto frameUnit = getSizePrefixedRange(data, temporalUnit->first, temporalUnit->second);
+  if (!frameUnit)
+    return FileFormat::Unknown;
+  const auto obu = getSizePrefixedRange(data, frameUnit->first, frameUnit->second);
+  if (!obu)
+    return FileFormat::Unknown;
+  const auto obuLength = obu->second - obu->first;
+  const auto header    = parseOBUHeader(data + obu->first, obuLength);
+  if (header && header->type == OBU_TEMPORAL_DELIMITER && header->headerSize == obuLength)
+    return FileFormat::AnnexB;
+
+  return FileFormat::Unknown;
+}
+
+QByteArray convertAnnexBTemporalUnit(const QByteArray &temporalUnit)
+{
+  const auto data = reinterpret_cast<const uint8_t *>(temporalUnit.constData());
+  const auto size = size_t(temporalUnit.size());
+
+  QByteArray converted;
+  converted.reserve(temporalUnit.size());
+  size_t framePos = 0;
+  while (framePos < size)
+  {
+    const auto frameUnit = getSizePrefixedRange(data, framePos, size);
+    if (!frameUnit)
+      break;
+
+    auto obuPos = frameUnit->first;
+    while (obuPos < frameUnit->second)
+    {
+      const auto obu = getSizePrefixedRange(data, obuPos, frameUnit->second);
+      if (!obu)
+        return converted;
+
+      const auto obuLength = obu->second - obu->first;
+      const auto header    = parseOBUHeader(data + obu->first, obuLength);
+      if (header && header->headerSize <= obuLength)
+        appendOBUWithSizeField(
+            converted, data + obu->first, *header, obuLength - header->headerSize);
+      obuPos = obu->second;
+    }
+    framePos = frameUnit->second;
+  }
+  return converted;
+}
+
+// Reads the file through a large buffer so that reading the many small headers while scanning
+// does not result in one read call per header.
+class BufferedFileReader
+{
+public:
+  BufferedFileReader(FileSource &file) : file(file)
+  {
+    this->fileSize = uint64_t(std::max(file.getFileSize().value_or(0), int64_t(0)));
+  }
+
+  // Get (up to) nrBytes starting at the given file position. The pointer is valid until the next
+  // call. At the end of the file, fewer bytes are returned.
+  std::pair<const uint8_t *, size_t> peek(const uint64_t pos, size_t nrBytes)
+  {
+    if (pos >= this->fileSize)
+      return {nullptr, 0};
+
+    nrBytes = size_t(std::min(uint64_t(nrBytes), this->fileSize - pos));
+    if (pos < this->bufferPos || pos + nrBytes > this->bufferPos + this->bufferSize)
+    {
+      const auto nrBytesRead =
+          this->file.readBytes(this->buffer, int64_t(pos), int64_t(std::max(nrBytes, BUFFER_SIZE)));
+      this->bufferPos  = pos;
+      this->bufferSize = size_t(std::max(nrBytesRead, int64_t(0)));
+      nrBytes          = std::min(nrBytes, this->bufferSize);
+    }
+
+    const auto data = reinterpret_cast<const uint8_t *>(this->buffer.constData());
+    return {data + (pos - this->bufferPos), nrBytes};
+  }
+
+  uint64_t getFileSize() const { return this->fileSize; }
+
+private:
+  FileSource &file;
+  uint64_t    fileSize{};
+  QByteArray  buffer;
+  uint64_t    bufferPos{};
+  size_t      bufferSize{};
+};
+
+struct ScanResult
+{
+  std::vector<TemporalUnit> temporalUnits;
+  std::vector<QByteArray>   sequenceHeaders;
+  size_t                    nrOBUs{};
+  std::optional<double>     ivfFramerate;
+};
+
+// Walk through all OBUs of the file and collect the temporal units. Only the OBU headers, the
+// sequence headers and the first byte of every frame header are read.
+class FileScanner
+{
+public:
+  FileScanner(FileSource &file) : reader(file) {}
+
+  ScanResult scan(FileFormat format)
+  {
+    if (format == FileFormat::IVF)
+      this->scanIVF();
+    else if (format == FileFormat::LowOverhead)
+      this->scanLowOverhead();
+    else if (format == FileFormat::AnnexB)
+      this->scanAnnexB();
+    return std::move(this->result);
+  }
+
+private:
+  void scanIVF();
+  void scanLowOverhead();
+  void scanAnnexB();
+
+  // Scan OBUs with size fields in the range [start, end)
+  bool scanOBUsWithSizeFields(uint64_t start, const uint64_t end);
+  bool scanAnnexBFrameUnit(const uint64_t start, const uint64_t end);
+  std::optional<std::pair<uint64_t, uint64_t>> readSizePrefixedRange(const uint64_t pos,
+                                                                      const uint64_t end);
+
+  void startTemporalUnit(const uint64_t filePos, const int64_t pts);
+  void finishTemporalUnit(const uint64_t endPos);
+  void analyzeOBU(const OBUHeader &header, const uint64_t obuPos, const uint64_t payloadSize);
+
+  BufferedFileReader reader;
+  ScanResult         result;
+
+  TemporalUnit currentUnit;
+  bool         currentUnitHasFrame{};
+  bool         reducedStillPictureHeader{};
+};
+
+void FileScanner::scanIVF()
+{
+  const auto [fileHeader, fileHeaderSize] = this->reader.peek(0, IVF_FILE_HEADER_SIZE);
+  if (fileHeaderSize < IVF_FILE_HEADER_SIZE)
+    return;
+  const auto headerSize    = readLittleEndian(fileHeader + 6, 2);
+  const auto timeBaseDenum = readLittleEndian(fileHeader + 16, 4);
+  const auto timeBaseNum   = readLittleEndian(fileHeader + 20, 4);
+
+  auto pos = headerSize;
+  while (true)
+  {
+    const auto [frameHeader, size] = this->reader.peek(pos, IVF_FRAME_HEADER_SIZE);
+    if (size < IVF_FRAME_HEADER_SIZE)
+      break;
+    const auto frameSize = readLittleEndian(frameHeader, 4);
+    const auto pts       = int64_t(readLittleEndian(frameHeader + 4, 8));
+    pos += IVF_FRAME_HEADER_SIZE;
+
+    if (pos + frameSize > this->reader.getFileSize())
+    {
+      DEBUG_AV1OBUFILE("FileScanner::scanIVF The last frame is incomplete");
+      break;
+    }
+
+    this->startTemporalUnit(pos, pts);
+    if (!this->scanOBUsWithSizeFields(pos, pos + frameSize))
+    {
+      DEBUG_AV1OBUFILE("FileScanner::scanIVF Error parsing the OBUs of the frame at " << pos);
+      break;
+    }
+    this->finishTemporalUnit(pos + frameSize);
+    pos += frameSize;
+  }
+
+  // The IVF header contains the time base. The frame rate follows from the pts distance.
+  if (timeBaseNum > 0 && timeBaseDenum > 0)
+  {
+    const auto &units       = this->result.temporalUnits;
+    auto        ptsDistance = int64_t(1);
+    if (units.size() >= 2 && units[1].pts > units[0].pts)
+      ptsDistance = units[1].pts - units[0].pts;
+    this->result.ivfFramerate = double(timeBaseDenum) / double(timeBaseNum * ptsDistance);
+  }
+}
+
+void FileScanner::scanLowOverhead()
+{
+  // Every temporal unit starts with a temporal delimiter
+  const auto fileSize    = this->reader.getFileSize();
+  uint64_t   pos         = 0;
+  bool       unitStarted = false;
+  while (pos < fileSize)
+  {
+    const auto [data, size] = this->reader.peek(pos, MAX_OBU_HEADER_SIZE);
+    const auto header       = parseOBUHeader(data, size);
+    if (!header || !header->payloadSize ||
+        *header->payloadSize > fileSize - pos - header->headerSize)
+    {
+      DEBUG_AV1OBUFILE("FileScanner::scanLowOverhead Error parsing the OBU at " << pos);
+      break;
+    }
+
+    if (header->type == OBU_TEMPORAL_DELIMITER || !unitStarted)
+    {
+      if (unitStarted)
+        this->finishTemporalUnit(pos);
+      this->startTemporalUnit(pos, int64_t(this->result.temporalUnits.size()));
+      unitStarted = true;
+    }
+
+    this->analyzeOBU(*header, pos, *header->payloadSize);
+    pos += header->headerSize + *header->payloadSize;
+  }
+
+  if (unitStarted)
+    this->finishTemporalUnit(pos);
+}
+
+void FileScanner::scanAnnexB()
+{
+  const auto fileSize = this->reader.getFileSize();
+  uint64_t   pos      = 0;
+  while (pos < fileSize)
+  {
+    const auto temporalUnit = this->readSizePrefixedRange(pos, fileSize);
+    if (!temporalUnit)
+    {
+      DEBUG_AV1OBUFILE("FileScanner::scanAnnexB Error reading the temporal unit size at " << pos);
+      break;
+    }
+
+    this->startTemporalUnit(temporalUnit->first, int64_t(this->result.temporalUnits.size()));
+    auto framePos = temporalUnit->first;
+    while (framePos < temporalUnit->second)
+    {
+      const auto frameUnit = this->readSizePrefixedRange(framePos, temporalUnit->second);
+      if (!frameUnit || !this->scanAnnexBFrameUnit(frameUnit->first, frameUnit->second))
+      {
+        DEBUG_AV1OBUFILE("FileScanner::scanAnnexB Error parsing the frame unit at " << framePos);
+        return;
+      }
+      framePos = frameUnit->second;
+    }
+    this->finishTemporalUnit(temporalUnit->second);
+    pos = temporalUnit->second;
+  }
+}
+
+bool FileScanner::scanOBUsWithSizeFields(uint64_t start, const uint64_t end)
+{
+  while (start < end)
+  {
+    const auto [data, size] =
+        this->reader.peek(start, size_t(std::min(end - start, uint64_t(MAX_OBU_HEADER_SIZE))));
+    const auto header = parseOBUHeader(data, size);
+    if (!header || !header->payloadSize || *header->payloadSize > end - start - header->headerSize)
+      return false;
+
+    this->analyzeOBU(*header, start, *header->payloadSize);
+    start += header->headerSize + *header->payloadSize;
+  }
+  return true;
+}
+
+bool FileScanner::scanAnnexBFrameUnit(const uint64_t start, const uint64_t end)
+{
+  auto obuPos = start;
+  while (obuPos < end)
+  {
+    const auto obu = this->readSizePrefixedRange(obuPos, end);
+    if (!obu)
+      return false;
+
+    const auto obuLength = obu->second - obu->first;
+    const auto [data, size] =
+        this->reader.peek(obu->first, size_t(std::min(obuLength, uint64_t(MAX_OBU_HEADER_SIZE))));
+    const auto header = parseOBUHeader(data, size);
+    if (!header || header->headerSize > obuLength)
+      return false;
+
+    this->analyzeOBU(*header, obu->first, obuLength - header->headerSize);
+    obuPos = obu->second;
+  }
+  return true;
+}
+
+std::optional<std::pair<uint64_t, uint64_t>>
+FileScanner::readSizePrefixedRange(const uint64_t pos, const uint64_t end)
+{
+  const auto [data, size] =
+      this->reader.peek(pos, size_t(std::min(end - pos, uint64_t(MAX_LEB128_BYTES))));
+  const auto elementSize = readLEB128(data, size);
+  if (!elementSize)
+    return {};
+  const auto start = pos + elementSize->nrBytes;
+  if (elementSize->value > end - start)
+    return {};
+  return std::make_pair(start, start + elementSize->value);
+}
+
+void FileScanner::startTemporalUnit(const uint64_t filePos, const int64_t pts)
+{
+  this->currentUnit         = {};
+  this->currentUnit.filePos = filePos;
+  this->currentUnit.pts     = pts;
+  this->currentUnitHasFrame = false;
+}
+
+void FileScanner::finishTemporalUnit(const uint64_t endPos)
+{
+  // Temporal units without a frame (e.g. only a temporal delimiter) can not be counted as a frame.
+  // A sequence header in such a unit was already saved and is pushed to the decoder when seeking.
+  if (!this->currentUnitHasFrame)
+    return;
+  this->currentUnit.size = endPos - this->currentUnit.filePos;
+  this->result.temporalUnits.push_back(this->currentUnit);
+}
+
+void FileScanner::analyzeOBU(const OBUHeader &header,
+                             const uint64_t   obuPos,
+                             const uint64_t   payloadSize)
+{
+  this->result.nrOBUs++;
+
+  if (header.type == OBU_SEQUENCE_HEADER)
+  {
+    const auto obuSize     = header.headerSize + payloadSize;
+    const auto [obu, size] = this->reader.peek(obuPos, size_t(obuSize));
+    if (size < obuSize || payloadSize == 0)
+      return;
+
+    // Save the sequence header in the low overhead format. Usually, it is repeated with the same
+    // content before every key frame.
+    QByteArray sequenceHeader;
+    appendOBUWithSizeField(sequenceHeader, obu, header, payloadSize);
+    auto &sequenceHeaders = this->result.sequenceHeaders;
+    if (sequenceHeaders.empty() || sequenceHeaders.back() != sequenceHeader)
+      sequenceHeaders.push_back(sequenceHeader);
+
+    // seq_profile (3 bit), still_picture (1 bit), reduced_still_picture_header (1 bit)
+    this->reducedStillPictureHeader = (obu[header.headerSize] & 0x08) != 0;
+  }
+  else if ((header.type == OBU_FRAME_HEADER || header.type == OBU_FRAME) &&
+           !this->currentUnitHasFrame)
+  {
+    this->currentUnitHasFrame = true;
+    if (this->result.sequenceHeaders.empty())
+      return;
+    this->currentUnit.sequenceHeaderIndex = this->result.sequenceHeaders.size() - 1;
+
+    const auto [payload, size] = this->reader.peek(obuPos + header.headerSize, 1);
+    if (size < 1 || payloadSize == 0)
+      return;
+
+    if (this->reducedStillPictureHeader)
+      this->currentUnit.randomAccessPoint = true;
+    else
+    {
+      // show_existing_frame (1 bit), frame_type (2 bit), show_frame (1 bit)
+      const auto showExistingFrame = (payload[0] & 0x80) != 0;
+      const auto frameType         = unsigned(payload[0] >> 5) & 0x03;
+      const auto showFrame         = (payload[0] & 0x10) != 0;
+      this->currentUnit.randomAccessPoint =
+          !showExistingFrame && frameType == KEY_FRAME && showFrame;
+    }
+  }
+}
+
+} // namespace
+
+bool FileSourceAV1OBUFile::openFile(const std::filesystem::path &filePath)
+{
+  DEBUG_AV1OBUFILE("FileSourceAV1OBUFile::openFile " << QString::fromStdString(filePath.string()));
+
+  if (!FileSource::openFile(filePath))
+    return false;
+
+  QByteArray fileStart;
+  const auto nrBytesRead = this->readBytes(fileStart, 0, FORMAT_DETECTION_SIZE);
+  fileStart.resize(int(std::max(nrBytesRead, int64_t(0))));
+  this->fileFormat = detectFileFormatFromData(fileStart);
+  if (this->fileFormat == FileFormat::Unknown)
+  {
+    DEBUG_AV1OBUFILE("FileSourceAV1OBUFile::openFile Unknown file format");
+    return false;
+  }
+
+  return this->scanFile();
+}
+
+bool FileSourceAV1OBUFile::openFile(const std::filesystem::path &filePath,
+                                    const FileSourceAV1OBUFile  &other)
+{
+  if (!FileSource::openFile(filePath))
+    return false;
+
+  this->fileFormat  = other.fileFormat;
+  this->streamIndex = other.streamIndex;
+  return this->streamIndex != nullptr;
+}
+
+FileSourceAV1OBUFile::FileFormat
+FileSourceAV1OBUFile::detectFileFormat(const std::filesystem::path &filePath)
+{
+  QFile file(QString::fromStdString(filePath.string()));
+  if (!file.open(QIODevice::ReadOnly))
+    return FileFormat::Unknown;
+  return detectFileFormatFromData(file.read(FORMAT_DETECTION_SIZE));
+}
+
+bool FileSourceAV1OBUFile::atEnd() const
+{
+  return this->nextFrameIdx >= this->getNumberFrames();
+}
+
+double FileSourceAV1OBUFile::getFramerate() const
+{
+  return this->streamIndex ? this->streamIndex->framerate : DEFAULT_FRAMERATE;
+}
+
+Size FileSourceAV1OBUFile::getSequenceSizeSamples() const
+{
+  return this->streamIndex ? this->streamIndex->frameSize : Size();
+}
+
+video::yuv::PixelFormatYUV FileSourceAV1OBUFile::getPixelFormatYUV() const
+{
+  return this->streamIndex ? this->streamIndex->pixelFormat : video::yuv::PixelFormatYUV();
+}
+
+IntPair FileSourceAV1OBUFile::getProfileLevel() const
+{
+  return this->streamIndex ? this->streamIndex->profileLevel : IntPair();
+}
+
+size_t FileSourceAV1OBUFile::getNumberFrames() const
+{
+  return this->streamIndex ? this->streamIndex->temporalUnits.size() : 0;
+}
+
+size_t FileSourceAV1OBUFile::getNumberOBUs() const
+{
+  return this->streamIndex ? this->streamIndex->nrOBUs : 0;
+}
+
+std::optional<filesource::KeyFrameIndex::SeekPoint>
+FileSourceAV1OBUFile::getClosestSeekableFrameBefore(int frameIdx) const
+{
+  if (!this->streamIndex)
+    return {};
+  return this->streamIndex->keyFrames.getClosestSeekableFrameBefore(frameIdx);
+}
+
+QByteArray FileSourceAV1OBUFile::getSequenceHeader(size_t frameIdx) const
+{
+  if (!this->streamIndex || this->streamIndex->sequenceHeaders.empty())
+    return {};
+
+  size_t sequenceHeaderIndex = 0;
+  if (const auto unit = this->getTemporalUnit(frameIdx))
+    sequenceHeaderIndex = unit->sequenceHeaderIndex;
+  return this->streamIndex->sequenceHeaders.at(sequenceHeaderIndex);
+}
+
+std::optional<FileSourceAV1OBUFile::TemporalUnit>
+FileSourceAV1OBUFile::getTemporalUnit(size_t frameIdx) const
+{
+  if (!this->streamIndex || frameIdx >= this->streamIndex->temporalUnits.size())
+    return {};
+  return this->streamIndex->temporalUnits.at(frameIdx);
+}
+
+bool FileSourceAV1OBUFile::seekToFrame(size_t frameIdx)
+{
+  if (frameIdx >= this->getNumberFrames())
+    return false;
+
+  DEBUG_AV1OBUFILE("FileSourceAV1OBUFile::seekToFrame " << frameIdx);
+  this->nextFrameIdx = frameIdx;
+  this->lastReturnArray.clear();
+  return true;
+}
+
+QByteArray FileSourceAV1OBUFile::getNextTemporalUnit(bool getLastDataAgain)
+{
+  if (getLastDataAgain)
+    return this->lastReturnArray;
+
+  this->lastReturnArray.clear();
+  const auto unit = this->getTemporalUnit(this->nextFrameIdx);
+  if (!unit)
+    return {};
+
+  // The data is read directly into the returned array. Only Annex B data must be converted.
+  QByteArray data;
+  const auto nrBytesRead = this->readBytes(data, int64_t(unit->filePos), int64_t(unit->size));
+  if (nrBytesRead != int64_t(unit->size))
+  {
+    DEBUG_AV1OBUFILE("FileSourceAV1OBUFile::getNextTemporalUnit Error reading from file");
+    return {};
+  }
+
+  this->nextFrameIdx++;
+  if (this->fileFormat == FileFormat::AnnexB)
+    this->lastReturnArray = convertAnnexBTemporalUnit(data);
+  else
+    this->lastReturnArray = data;
+  return this->lastReturnArray;
+}
+
+std::vector<std::pair<size_t, size_t>>
+FileSourceAV1OBUFile::splitIntoOBUs(const QByteArray &temporalUnit)
+{
+  const auto data = reinterpret_cast<const uint8_t *>(temporalUnit.constData());
+  const auto size = size_t(temporalUnit.size());
+
+  std::vector<std::pair<size_t, size_t>> obus;
+  size_t                                 pos = 0;
+  while (pos < size)
+  {
+    const auto header = parseOBUHeader(data + pos, size - pos);
+    if (!header || !header->payloadSize || *header->payloadSize > size - pos - header->headerSize)
+      break;
+
+    const auto obuSize = header->headerSize + size_t(*header->payloadSize);
+    obus.emplace_back(pos, obuSize);
+    pos += obuSize;
+  }
+  return obus;
+}
+
+bool FileSourceAV1OBUFile::scanFile()
+{
+  FileScanner scanner(*this);
+  auto        result = scanner.scan(this->fileFormat);
+
+  auto index             = std::make_shared<StreamIndex>();
+  index->temporalUnits   = std::move(result.temporalUnits);
+  index->sequenceHeaders = std::move(result.sequenceHeaders);
+  index->nrOBUs          = result.nrOBUs;
+  for (const auto &unit : index->temporalUnits)
+    index->keyFrames.addFrame(unit.pts, unit.randomAccessPoint);
+  index->keyFrames.setComplete();
+
+  DEBUG_AV1OBUFILE("FileSourceAV1OBUFile::scanFile Found "
+                   << index->temporalUnits.size() << " temporal units with "
+                   << index->keyFrames.getNumberKeyframes() << " random access points");
+
+  if (index->temporalUnits.empty() || index->sequenceHeaders.empty())
+    return false;
+
+  try
+  {
+    using parser::reader::SubByteReaderLogging;
+    SubByteReaderLogging reader(
+        SubByteReaderLogging::convertToByteVector(index->sequenceHeaders.front()), nullptr);
+    parser::av1::obu_header header;
+    header.parse(reader);
+    parser::av1::sequence_header_obu sequenceHeader;
+    sequenceHeader.parse(reader);
+
+    index->frameSize = Size(sequenceHeader.max_frame_width_minus_1 + 1,
+                            sequenceHeader.max_frame_height_minus_1 + 1);
+
+    using video::yuv::Subsampling;
+    const auto &colorConfig = sequenceHeader.colorConfig;
+    auto        subsampling = Subsampling::YUV_444;
+    if (colorConfig.mono_chrome)
+      subsampling = Subsampling::YUV_400;
+    else if (colorConfig.subsampling_x && colorConfig.subsampling_y)
+      subsampling = Subsampling::YUV_420;
+    else if (colorConfig.subsampling_x)
+      subsampling = Subsampling::YUV_422;
+    index->pixelFormat = video::yuv::PixelFormatYUV(subsampling, colorConfig.BitDepth);
+
+    const auto level =
+        sequenceHeader.seq_level_idx.empty() ? 0 : int(sequenceHeader.seq_level_idx.front());
+    index->profileLevel = {int(sequenceHeader.seq_profile), level};
+
+    const auto &timingInfo = sequenceHeader.timing_info;
+    if (sequenceHeader.timing_info_present_flag && timingInfo.num_units_in_display_tick > 0)
+    {
+      index->framerate = double(timingInfo.time_scale) / timingInfo.num_units_in_display_tick;
+      if (timingInfo.equal_picture_interval)
+        index->framerate /= double(timingInfo.num_ticks_per_picture_minus_1 + 1);
+    }
+  }
+  catch (const std::exception &e)
+  {
+    (void)e;
+    DEBUG_AV1OBUFILE("FileSourceAV1OBUFile::scanFile Error parsing the sequence header "
+                     << e.what());
+  }
+
+  // The time base of the IVF container is more reliable than the optional timing info
+  if (result.ivfFramerate)
+    index->framerate = *result.ivfFramerate;
+
+  this->streamIndex = index;
+  return true;
+}
@@ -0,0 +1,149 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <filesource/FileSource.h>
+#include <filesource/KeyFrameIndex.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <memory>
+#include <optional>
+
+/* A FileSource for raw AV1 bitstreams. Three file formats are supported:
+ * - IVF: A 32 byte file header followed by frames with a 12 byte frame header each
+ * - Low overhead bitstream format (Section 5 of the AV1 spec, usually *.obu): OBUs with size
+ *   fields. Temporal units start with a temporal delimiter OBU.
+ * - Length delimited bitstream format (Annex B of the AV1 spec): Temporal units, frame units and
+ *   OBUs are prefixed with their size.
+ * When the file is opened, it is scanned once. Only the headers of the OBUs are read and the
+ * payloads are skipped (except for the first bytes of frame headers). This results in an index of
+ * all temporal units (one temporal unit per frame) with their position in the file and whether
+ * decoding can start at the temporal unit.
+ * The data of a temporal unit is read from the file with one read call into the returned buffer.
+ * Temporal units from IVF and low overhead files are returned as read from the file. OBUs from
+ * Annex B files are converted to the low overhead format (with size fields).
+ */
+class FileSourceAV1OBUFile : public FileSource
+{
+  Q_OBJECT
+
+public:
+  enum class FileFormat
+  {
+    Unknown,
+    IVF,
+    LowOverhead,
+    AnnexB
+  };
+
+  FileSourceAV1OBUFile() = default;
+  FileSourceAV1OBUFile(const std::filesystem::path &filePath) { this->openFile(filePath); }
+
+  // Open and scan the file. If another (already opened) instance of the same file is given, the
+  // index of the other file is used instead of scanning the file again.
+  bool openFile(const std::filesystem::path &filePath) override;
+  bool openFile(const std::filesystem::path &filePath, const FileSourceAV1OBUFile &other);
+
+  // Check the beginning of the file. Returns Unknown if this is not an AV1 file.
+  static FileFormat detectFileFormat(const std::filesystem::path &filePath);
+
+  FileFormat getFileFormat() const { return this->fileFormat; }
+  bool       atEnd() const override;
+
+  // Properties of the bitstream from the (first) sequence header
+  double                     getFramerate() const;
+  Size                       getSequenceSizeSamples() const;
+  video::yuv::PixelFormatYUV getPixelFormatYUV() const;
+  IntPair                    getProfileLevel() const;
+
+  size_t getNumberFrames() const;
+  size_t getNumberOBUs() const;
+
+  // Find the closest frame before (or equal to) the given frame where decoding can start.
+  std::optional<filesource::KeyFrameIndex::SeekPoint>
+  getClosestSeekableFrameBefore(int frameIdx) const;
+
+  // Return the sequence header OBU (in the low overhead format) that is active for the given
+  // frame. This must be pushed to a decoder before decoding can start at a random access point.
+  QByteArray getSequenceHeader(size_t frameIdx = 0) const;
+
+  struct TemporalUnit
+  {
+    // The position of the temporal unit data in the file (without the IVF frame header or the
+    // temporal unit size of Annex B)
+    uint64_t filePos{};
+    uint64_t size{};
+    int64_t  pts{};
+    bool     randomAccessPoint{};
+    size_t   sequenceHeaderIndex{};
+  };
+  std::optional<TemporalUnit> getTemporalUnit(size_t frameIdx) const;
+
+  // Set the position for getNextTemporalUnit to the given frame
+  bool seekToFrame(size_t frameIdx);
+
+  // Get all OBUs of the next temporal unit (in the low overhead format). Returns an empty array at
+  // the end of the file.
+  QByteArray getNextTemporalUnit(bool getLastDataAgain = false);
+
+  // Split the data of a temporal unit in the low overhead format into the OBUs. Each entry is the
+  // offset and size of an OBU. The OBUs can be accessed without a copy using
+  // QByteArray::fromRawData as long as the temporal unit data is alive.
+  static std::vector<std::pair<size_t, size_t>> splitIntoOBUs(const QByteArray &temporalUnit);
+
+private:
+  struct StreamIndex
+  {
+    std::vector<TemporalUnit> temporalUnits;
+    std::vector<QByteArray>   sequenceHeaders;
+    filesource::KeyFrameIndex keyFrames;
+    size_t                    nrOBUs{};
+
+    double                     framerate{DEFAULT_FRAMERATE};
+    Size                       frameSize;
+    video::yuv::PixelFormatYUV pixelFormat;
+    IntPair                    profileLevel{};
+  };
+
+  bool scanFile();
+
+  FileFormat fileFormat{FileFormat::Unknown};
+
+  // The index is shared between all instances that opened the same file. It is not modified after
+  // the file was scanned.
+  std::shared_ptr<const StreamIndex> streamIndex;
+
+  size_t     nextFrameIdx{0};
+  QByteArray lastReturnArray;
+};
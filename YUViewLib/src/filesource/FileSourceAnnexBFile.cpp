@@ -32,6 +32,10 @@
 
 #include "FileSourceAnnexBFile.h"
 
+#include <algorithm>
+
+#include <common/Tracing.h>
+
 #define ANNEXBFILE_DEBUG_OUTPUT 0
 #if ANNEXBFILE_DEBUG_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -42,6 +46,9 @@
 
 const auto BUFFERSIZE = 500000;
 const auto STARTCODE  = QByteArrayLiteral("\x00\x00\x01");
+// Spare room at the end of the frame data so that decoders can pad it in place (ffmpeg needs
+// AV_INPUT_BUFFER_PADDING_SIZE bytes)
+const auto FRAME_DATA_SPARE_CAPACITY = 64;
 
 FileSourceAnnexBFile::FileSourceAnnexBFile()
 {
@@ -194,9 +201,17 @@ QByteArray FileSourceAnnexBFile::getNextNALUnit(bool        getLastDataAgain,
   // Position found
   if (startEndPosInFile)
     startEndPosInFile->second = this->bufferStartPosInFile + nextStartCodePos;
-  if (nextStartCodePos > int(this->posInBuffer))
-    this->lastReturnArray +=
-        this->fileBuffer.mid(this->posInBuffer, nextStartCodePos - this->posInBuffer);
+  const auto nalStartInBuffer = std::max(this->posInBuffer, int64_t(0));
+  if (nextStartCodePos > nalStartInBuffer)
+  {
+    const auto nalData = this->fileBuffer.constData() + nalStartInBuffer;
+    const auto nalSize = int(nextStartCodePos - nalStartInBuffer);
+    if (this->lastReturnArray.isEmpty())
+      // The NAL unit lies completely within the current buffer. Don't copy the data.
+      this->lastReturnArray = QByteArray::fromRawData(nalData, nalSize);
+    else
+      this->lastReturnArray.append(nalData, nalSize);
+  }
   this->posInBuffer = nextStartCodePos;
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::getNextNALUnit start code found - ret size "
                    << this->lastReturnArray.size());
@@ -209,16 +224,17 @@ QByteArray FileSourceAnnexBFile::getFrameData(pairUint64 startEndFilePos)
   // We don't need to convert the format to the mp4 ISO format. The ffmpeg decoder can also accept
   // raw NAL units. When the extradata is set as raw NAL units, the AVPackets must also be raw NAL
   // units.
-  QByteArray retArray;
-
   auto start = startEndFilePos.first;
   auto end   = startEndFilePos.second;
 
+  QByteArray retArray;
+  retArray.reserve(int(end - start + 1) + FRAME_DATA_SPARE_CAPACITY);
+
   // Seek the source file to the start position
   this->seek(start);
 
   // Retrieve NAL units (and repackage them) until we reached out end position
-  while (end > this->bufferStartPosInFile + this->posInBuffer)
+  while (end > this->getNextNALUnitPos())
   {
     auto nalData = getNextNALUnit();
 
@@ -238,11 +254,17 @@ QByteArray FileSourceAnnexBFile::getFrameData(pairUint64 startEndFilePos)
     retArray += nalData;
   }
 
+  // Each 3 byte start code was extended by one byte, which may have used up the spare capacity
+  if (retArray.capacity() - retArray.size() < FRAME_DATA_SPARE_CAPACITY)
+    retArray.reserve(retArray.size() + FRAME_DATA_SPARE_CAPACITY);
+
   return retArray;
 }
 
 bool FileSourceAnnexBFile::updateBuffer()
 {
+  TRACE_SCOPE("file", "FileSourceAnnexBFile::updateBuffer");
+
   // Save the position of the first byte in this new buffer
   this->bufferStartPosInFile += this->fileBufferSize;
 
@@ -287,3 +309,8 @@ bool FileSourceAnnexBFile::seek(int64_t pos)
 
   return true;
 }
+
+uint64_t FileSourceAnnexBFile::getNextNALUnitPos() const
+{
+  return uint64_t(int64_t(this->bufferStartPosInFile) + this->posInBuffer);
+}
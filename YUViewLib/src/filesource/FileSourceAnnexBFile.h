@@ -63,6 +63,9 @@ public:
   // Also return the start and end position of the NAL unit in the file so you can seek to it.
   // startEndPosInFile: The file positions of the first byte in the NAL header and the end position
   // of the last byte
+  // If the NAL unit lies completely within the read buffer, the returned array does not copy the
+  // data but points into the buffer. It is only valid until the buffer is refilled (the next call
+  // to getNextNALUnit(), getFrameData() or seek()). Copy it if it must be kept longer.
   QByteArray getNextNALUnit(bool getLastDataAgain = false, pairUint64 *startEndPosInFile = nullptr);
 
   // Get all bytes that are needed to decode the next frame (from the given start to the given end
@@ -72,6 +75,9 @@ public:
 
   // Seek the file to the given byte position. Update the buffer.
   bool seek(int64_t pos) override;
+  // The position in the file of the NAL unit that getNextNALUnit() will return next. Seeking to
+  // this position continues reading from there.
+  uint64_t getNextNALUnitPos() const;
 
   uint64_t getNrBytesBeforeFirstNAL() const { return this->nrBytesBeforeFirstNAL; }
 
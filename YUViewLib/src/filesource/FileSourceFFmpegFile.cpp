@@ -32,8 +32,9 @@
 
 #include "FileSourceFFmpegFile.h"
 
-#include <QProgressDialog>
 #include <QSettings>
+#include <QtConcurrent>
+#include <chrono>
 #include <fstream>
 
 #include <common/Formatting.h>
@@ -57,6 +58,12 @@ namespace
 
 auto startCode = QByteArrayLiteral("\x00\x00\x01");
 
+// The background scan reads the file in chunks of this many packets. In between, it is checked if
+// the scan should be aborted and if a signalFrameIndexChanged should be emitted.
+constexpr size_t INDEX_SCAN_CHUNK_SIZE = 500;
+// The minimum time between two signalFrameIndexChanged from the background scan
+constexpr auto INDEX_SCAN_SIGNAL_INTERVAL = std::chrono::milliseconds(250);
+
 uint64_t getBoxSize(ByteVector::const_iterator iterator)
 {
   uint64_t size = 0;
@@ -396,12 +403,16 @@ QList<QByteArray> FileSourceFFmpegFile::getParameterSets()
 
 FileSourceFFmpegFile::~FileSourceFFmpegFile()
 {
+  if (this->indexScanFuture.isRunning())
+  {
+    this->breakIndexScanAtomic.store(true);
+    this->indexScanFuture.waitForFinished();
+  }
   if (this->currentPacket)
     this->ff.freePacket(this->currentPacket);
 }
 
 bool FileSourceFFmpegFile::openFile(const QString        &filePath,
-                                    QWidget              *mainWindow,
                                     FileSourceFFmpegFile *other,
                                     bool                  parseFile)
 {
@@ -427,19 +438,15 @@ bool FileSourceFFmpegFile::openFile(const QString        &filePath,
   this->updateFileWatchSetting();
   this->fileChanged = false;
 
-  // If another (already opened) bitstream is given, copy bitstream info from there; Otherwise scan
-  // the bitstream.
+  // If another (already opened) bitstream is given, share the frame index with it; Otherwise get
+  // the index from the container or scan the bitstream.
   if (other && other->isFileOpened)
+    this->frameIndex = other->frameIndex;
+  else if (parseFile && !this->loadFrameIndexFromContainer())
   {
-    this->nrFrames     = other->nrFrames;
-    this->keyFrameList = other->keyFrameList;
-  }
-  else if (parseFile)
-  {
-    if (!this->scanBitstream(mainWindow))
+    this->startFrameIndexScan();
+    if (this->frameIndex->getNumberKeyframes() == 0)
       return false;
-
-    this->seekFileToBeginning();
   }
 
   return true;
@@ -460,77 +467,113 @@ void FileSourceFFmpegFile::updateFileWatchSetting()
 
 std::pair<int64_t, size_t> FileSourceFFmpegFile::getClosestSeekableFrameBefore(int frameIdx) const
 {
-  // We are always be able to seek to the beginning of the file
-  auto bestSeekDTS    = this->keyFrameList[0].dts;
-  auto seekToFrameIdx = this->keyFrameList[0].frame;
+  if (auto seekPoint = this->frameIndex->getClosestSeekableFrameBefore(frameIdx))
+    return {seekPoint->dts, seekPoint->frame};
+  return {};
+}
+
+bool FileSourceFFmpegFile::loadFrameIndexFromContainer()
+{
+  // Only use the index if it lists all frames. Some containers (e.g. Matroska cues) only list
+  // keyframes. From these, we can not know the index of the frames.
+  const auto nrFramesInStream = this->video_stream.getNbFrames();
+  if (nrFramesInStream <= 0)
+    return false;
+
+  const auto entries = this->ff.getIndexEntries(this->video_stream);
+  if (int64_t(entries.size()) != nrFramesInStream)
+  {
+    DEBUG_FFMPEG("FileSourceFFmpegFile::loadFrameIndexFromContainer: Container index has %d "
+                 "entries but the stream has %d frames.",
+                 int(entries.size()),
+                 int(nrFramesInStream));
+    return false;
+  }
+
+  auto index = std::make_shared<filesource::KeyFrameIndex>();
+  for (const auto &entry : entries)
+    index->addFrame(entry.dts, entry.keyframe);
+  if (index->getNumberKeyframes() == 0)
+    return false;
+  index->setComplete();
+
+  DEBUG_FFMPEG("FileSourceFFmpegFile::loadFrameIndexFromContainer: Found %d frames and %d "
+               "keyframes in the container index.",
+               int(index->getNumberFrames()),
+               int(index->getNumberKeyframes()));
+  this->frameIndex = index;
+  return true;
+}
+
+void FileSourceFFmpegFile::startFrameIndexScan()
+{
+  // Scanning moves the read position in the file. Use a separate instance so that this instance
+  // can be used for decoding while the scan is running.
+  this->indexScanner = std::make_unique<FileSourceFFmpegFile>();
+  if (!this->indexScanner->openFile(this->fullFilePath, nullptr, false))
+  {
+    this->frameIndex->setComplete();
+    return;
+  }
 
-  for (const auto &pic : this->keyFrameList)
+  // Scan until the first keyframe so that the range of decodable frames is known when we return.
+  auto &index = *this->frameIndex;
+  while (index.getNumberKeyframes() == 0)
   {
-    if (frameIdx > 0 && pic.frame <= unsigned(frameIdx))
+    if (!this->indexScanner->scanBitstream(index, 1))
     {
-      // We could seek here
-      bestSeekDTS    = pic.dts;
-      seekToFrameIdx = pic.frame;
+      index.setComplete();
+      return;
     }
-    else
-      break;
   }
 
-  return {bestSeekDTS, seekToFrameIdx};
+  this->breakIndexScanAtomic.store(false);
+  this->indexScanFuture = QtConcurrent::run([this]() {
+    auto &index      = *this->frameIndex;
+    auto  lastSignal = std::chrono::steady_clock::now();
+    while (!this->breakIndexScanAtomic.load())
+    {
+      if (!this->indexScanner->scanBitstream(index, INDEX_SCAN_CHUNK_SIZE))
+      {
+        DEBUG_FFMPEG("FileSourceFFmpegFile::startFrameIndexScan: Scan done. Found %d frames and "
+                     "%d keyframes.",
+                     int(index.getNumberFrames()),
+                     int(index.getNumberKeyframes()));
+        // Emit before the index is marked complete. Whoever waits for the complete index will then
+        // also receive the last update.
+        emit this->signalFrameIndexChanged();
+        index.setComplete();
+        return;
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      if (now - lastSignal >= INDEX_SCAN_SIGNAL_INTERVAL)
+      {
+        lastSignal = now;
+        emit this->signalFrameIndexChanged();
+      }
+    }
+  });
 }
 
-bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
+bool FileSourceFFmpegFile::scanBitstream(filesource::KeyFrameIndex &index, size_t maxNrPackets)
 {
   if (!this->isFileOpened)
     return false;
 
-  // Create the dialog (if the given pointer is not null)
-  auto maxPTS = this->getMaxTS();
-  // Updating the dialog (setValue) is quite slow. Only do this if the percent value changes.
-  int                              curPercentValue = 0;
-  std::unique_ptr<QProgressDialog> progress;
-  if (mainWindow != nullptr)
+  for (size_t i = 0; i < maxNrPackets; i++)
   {
-    progress.reset(
-        new QProgressDialog("Parsing (indexing) bitstream...", "Cancel", 0, 100, mainWindow));
-    progress->setMinimumDuration(1000); // Show after 1s
-    progress->setAutoClose(false);
-    progress->setAutoReset(false);
-    progress->setWindowModality(Qt::WindowModal);
-  }
+    if (!this->goToNextPacket(true))
+      return false;
 
-  this->nrFrames = 0;
-  while (this->goToNextPacket(true))
-  {
-    DEBUG_FFMPEG("FileSourceFFmpegFile::scanBitstream: frame %d pts %d dts %d%s",
-                 this->nrFrames,
+    DEBUG_FFMPEG("FileSourceFFmpegFile::scanBitstream: pts %d dts %d%s",
                  (int)this->currentPacket.getPTS(),
                  (int)this->currentPacket.getDTS(),
                  this->currentPacket.getFlagKeyframe() ? " - keyframe" : "");
 
-    if (this->currentPacket.getFlagKeyframe())
-      this->keyFrameList.append(pictureIdx(this->nrFrames, this->currentPacket.getDTS()));
-
-    if (progress && progress->wasCanceled())
-      return false;
-
-    int newPercentValue = 0;
-    if (maxPTS != 0)
-      newPercentValue = functions::clip(int(this->currentPacket.getPTS() * 100 / maxPTS), 0, 100);
-    if (newPercentValue != curPercentValue)
-    {
-      if (progress)
-        progress->setValue(newPercentValue);
-      curPercentValue = newPercentValue;
-    }
-
-    this->nrFrames++;
+    index.addFrame(this->currentPacket.getDTS(), this->currentPacket.getFlagKeyframe());
   }
-
-  DEBUG_FFMPEG("FileSourceFFmpegFile::scanBitstream: Scan done. Found %d frames and %d keyframes.",
-               this->nrFrames,
-               this->keyFrameList.length());
-  return !progress->wasCanceled();
+  return true;
 }
 
 void FileSourceFFmpegFile::openFileAndFindVideoStream(QString fileName)
@@ -710,13 +753,14 @@ int64_t FileSourceFFmpegFile::getMaxTS()
 
 indexRange FileSourceFFmpegFile::getDecodableFrameLimits() const
 {
-  if (this->keyFrameList.isEmpty() || this->nrFrames == 0)
-    return {};
+  if (auto limits = this->frameIndex->getDecodableFrameLimits())
+    return *limits;
+  return {};
+}
 
-  indexRange range;
-  range.first  = int(this->keyFrameList.at(0).frame);
-  range.second = int(this->nrFrames);
-  return range;
+bool FileSourceFFmpegFile::isFrameIndexComplete() const
+{
+  return this->frameIndex->isComplete();
 }
 
 QList<QStringPairList> FileSourceFFmpegFile::getFileInfoForAllStreams()
@@ -33,6 +33,13 @@
 #pragma once
 
 #include "FileSource.h"
+#include "KeyFrameIndex.h"
+
+#include <atomic>
+#include <memory>
+
+#include <QFuture>
+
 #include <ffmpeg/AVCodecIDWrapper.h>
 #include <ffmpeg/AVCodecParametersWrapper.h>
 #include <ffmpeg/AVInputFormatWrapper.h>
@@ -54,10 +61,13 @@ public:
 
   // Load the ffmpeg libraries and try to open the file. The FileSource will install a watcher for
   // the file. Return false if anything goes wrong.
+  // If parseFile is set, the frame index is read from the container (if the container has an index
+  // of all frames, e.g. MP4). Otherwise, the file is scanned until the first keyframe and the rest
+  // of the file is scanned in the background. signalFrameIndexChanged is emitted while the index
+  // grows. If another (already opened) file is given, the frame index is shared with it.
   bool openFile(const QString &       filePath,
-                QWidget *             mainWindow = nullptr,
-                FileSourceFFmpegFile *other      = nullptr,
-                bool                  parseFile  = true);
+                FileSourceFFmpegFile *other     = nullptr,
+                bool                  parseFile = true);
 
   // Is the file at the end?
   // TODO: How do we do this?
@@ -103,8 +113,10 @@ public:
   bool    seekFileToBeginning();
   int64_t getMaxTS();
 
-  // Get information on the video stream
+  // Get information on the video stream. While the file is scanned in the background, the limits
+  // grow.
   indexRange getDecodableFrameLimits() const;
+  bool       isFrameIndexComplete() const;
 
   FFmpeg::AVCodecIDWrapper getVideoStreamCodecID()
   {
@@ -126,6 +138,11 @@ public:
 
   QStringList getFFmpegLoadingLog() const { return ff.getLog(); }
 
+signals:
+  // New frames were added to the frame index or the background scan finished. This is emitted from
+  // the background thread.
+  void signalFrameIndexChanged();
+
 private slots:
   void fileSystemWatcherFileChanged(const QString &) { fileChanged = true; }
 
@@ -175,27 +192,28 @@ protected:
   QFileInfo fileInfo;
   bool      isFileOpened{false};
 
-  // In order to translate from frames to PTS, we need to count the frames and keep a list of
-  // the PTS values of keyframes that we can start decoding at.
-  // If a mainWindow pointer is given, open a progress dialog. Return true on success. False if the
-  // process was canceled.
-  bool   scanBitstream(QWidget *mainWindow);
-  size_t nrFrames{0};
+  // In order to translate from frames to DTS, we need to count the frames and keep a list of
+  // the DTS values of keyframes that we can start decoding at. The index is shared between all
+  // instances that opened the same file.
+  std::shared_ptr<filesource::KeyFrameIndex> frameIndex{
+      std::make_shared<filesource::KeyFrameIndex>()};
 
-  // Private struct for navigation. We index frames by frame number and FFMpeg uses the pts.
-  // This connects both values.
-  struct pictureIdx
-  {
-    pictureIdx(size_t frame, int64_t dts) : frame(frame), dts(dts) {}
-    size_t  frame;
-    int64_t dts;
-  };
+  // Fill the frame index from the index of the container. This is only possible if the container
+  // has an entry for every frame of the video stream. Return false if this is not possible.
+  bool loadFrameIndexFromContainer();
 
-  FFmpeg::PacketDataFormat packetDataFormat{FFmpeg::PacketDataFormat::Unknown};
+  // Scan the file using a separate instance (with its own file handle) until the first keyframe
+  // is found. Then continue the scan in the background.
+  void startFrameIndexScan();
+  // Read up to maxNrPackets packets of the video stream and add them to the given index. Return
+  // false if the end of the file was reached.
+  bool scanBitstream(filesource::KeyFrameIndex &index, size_t maxNrPackets);
 
-  // These are filled after opening a file (after scanBitstream was called)
-  QList<pictureIdx> keyFrameList; //< A list of pairs (frameNr, PTS) that we can seek to.
-  // pictureIdx getClosestSeekableFrameNumberBeforeBefore(int frameIdx);
+  std::unique_ptr<FileSourceFFmpegFile> indexScanner;
+  QFuture<void>                         indexScanFuture;
+  std::atomic_bool                      breakIndexScanAtomic{false};
+
+  FFmpeg::PacketDataFormat packetDataFormat{FFmpeg::PacketDataFormat::Unknown};
 
   // For parsing NAL units from the compressed data:
   QByteArray currentPacketData;
@@ -0,0 +1,78 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HeadTailChecksums.h"
+
+#include <algorithm>
+
+namespace filesource
+{
+
+namespace
+{
+
+// Size of the windows at the start and the end of the data which are checked for modifications
+constexpr int64_t CHECK_WINDOW_SIZE = 65536;
+
+uint32_t adler32(const QByteArray &data, int64_t size)
+{
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (int64_t i = 0; i < size; i++)
+  {
+    a = (a + static_cast<uint8_t>(data.at(int(i)))) % 65521;
+    b = (b + a) % 65521;
+  }
+  return (b << 16) | a;
+}
+
+std::optional<uint32_t> checksumOfFileRange(FileSource &file, int64_t start, int64_t size)
+{
+  QByteArray buffer;
+  if (file.readBytes(buffer, start, size) != size)
+    return {};
+  return adler32(buffer, size);
+}
+
+} // namespace
+
+std::optional<HeadTailChecksums> calculateHeadTailChecksums(FileSource &file, int64_t nrBytes)
+{
+  const auto windowSize = std::min(nrBytes, CHECK_WINDOW_SIZE);
+  const auto head       = checksumOfFileRange(file, 0, windowSize);
+  const auto tail       = checksumOfFileRange(file, nrBytes - windowSize, windowSize);
+  if (!head || !tail)
+    return {};
+  return HeadTailChecksums{*head, *tail};
+}
+
+} // namespace filesource
@@ -0,0 +1,99 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "KeyFrameIndex.h"
+
+#include <algorithm>
+
+namespace filesource
+{
+
+void KeyFrameIndex::addFrame(int64_t dts, bool isKeyframe)
+{
+  QMutexLocker lock(&this->accessMutex);
+  if (isKeyframe)
+    this->keyframes.push_back({dts, this->nrFrames});
+  this->nrFrames++;
+}
+
+void KeyFrameIndex::setComplete()
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->complete = true;
+}
+
+bool KeyFrameIndex::isComplete() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->complete;
+}
+
+size_t KeyFrameIndex::getNumberFrames() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->nrFrames;
+}
+
+size_t KeyFrameIndex::getNumberKeyframes() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->keyframes.size();
+}
+
+std::optional<indexRange> KeyFrameIndex::getDecodableFrameLimits() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  if (this->keyframes.empty() || this->nrFrames == 0)
+    return {};
+  return indexRange(int(this->keyframes.front().frame), int(this->nrFrames));
+}
+
+std::optional<KeyFrameIndex::SeekPoint>
+KeyFrameIndex::getClosestSeekableFrameBefore(int frameIdx) const
+{
+  QMutexLocker lock(&this->accessMutex);
+  if (this->keyframes.empty())
+    return {};
+
+  // The keyframes are sorted by frame index so we can do a binary search
+  const auto frame = size_t(std::max(frameIdx, 0));
+  auto       it    = std::upper_bound(
+      this->keyframes.begin(),
+      this->keyframes.end(),
+      frame,
+      [](const size_t frame, const SeekPoint &seekPoint) { return frame < seekPoint.frame; });
+  if (it == this->keyframes.begin())
+    return this->keyframes.front();
+  return *(it - 1);
+}
+
+} // namespace filesource
@@ -0,0 +1,83 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <QMutex>
+
+#include <common/Typedef.h>
+
+namespace filesource
+{
+
+/* The frame index of a packetized file. It counts the frames (packets of the video stream in
+ * decode order) and keeps a list of the keyframes (and their DTS) where decoding can start.
+ * The index can either be filled at once from the index of the container or it can grow while the
+ * file is scanned in the background. All functions are thread-safe.
+ */
+class KeyFrameIndex
+{
+public:
+  struct SeekPoint
+  {
+    int64_t dts{};
+    size_t  frame{};
+  };
+
+  KeyFrameIndex() = default;
+
+  void addFrame(int64_t dts, bool isKeyframe);
+  void setComplete();
+  bool isComplete() const;
+
+  size_t getNumberFrames() const;
+  size_t getNumberKeyframes() const;
+
+  // The range of frames that can be decoded. Decoding can only start at the first keyframe.
+  // Empty if there are no keyframes yet.
+  std::optional<indexRange> getDecodableFrameLimits() const;
+
+  // Find the closest keyframe before (or equal) the given frame index where decoding can start.
+  // If there is none, the first keyframe is returned.
+  std::optional<SeekPoint> getClosestSeekableFrameBefore(int frameIdx) const;
+
+private:
+  mutable QMutex         accessMutex;
+  std::vector<SeekPoint> keyframes;
+  size_t                 nrFrames{0};
+  bool                   complete{false};
+};
+
+} // namespace filesource
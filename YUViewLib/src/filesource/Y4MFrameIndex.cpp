@@ -0,0 +1,110 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Y4MFrameIndex.h"
+
+namespace filesource
+{
+
+namespace
+{
+
+// The 'FRAME' indicator and its parameters must be within this many bytes
+constexpr int64_t MAX_FRAME_HEADER_SIZE = 20;
+
+} // namespace
+
+void Y4MFrameIndex::reset(int64_t firstFrameOffset, int64_t frameSize)
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->frameDataOffsets.clear();
+  this->nextFrameOffset = firstFrameOffset;
+  this->frameSize       = frameSize;
+}
+
+std::optional<std::string> Y4MFrameIndex::indexFrames(FileSource &file, bool stopAtIncompleteFrame)
+{
+  const auto fileSize = file.getFileSize().value_or(0);
+
+  QByteArray frameHeader;
+  while (this->nextFrameOffset < fileSize)
+  {
+    const auto nrBytesRead =
+        file.readBytes(frameHeader, this->nextFrameOffset, MAX_FRAME_HEADER_SIZE);
+    if (nrBytesRead < 5)
+    {
+      if (stopAtIncompleteFrame)
+        return {};
+      return "Error parsing the Y4M header: The file ended unexpectedly.";
+    }
+
+    if (frameHeader.left(5) != "FRAME")
+      return "Error parsing the Y4M header: Could not locate the next 'FRAME' indicator.";
+
+    // We will now ignore all frame parameters by searching for the next 0x0A byte. I don't know
+    // what we could do with these parameters.
+    const auto endOfHeader = frameHeader.indexOf(char(10), 5);
+    if (endOfHeader < 0)
+    {
+      if (stopAtIncompleteFrame && nrBytesRead < MAX_FRAME_HEADER_SIZE)
+        return {};
+      return "Error parsing the Y4M header: The file ended unexpectedly.";
+    }
+
+    // The raw data starts after the 0x0A byte
+    const auto frameDataOffset = this->nextFrameOffset + endOfHeader + 1;
+    if (stopAtIncompleteFrame && frameDataOffset + this->frameSize > fileSize)
+      return {};
+
+    QMutexLocker lock(&this->accessMutex);
+    this->frameDataOffsets.push_back(frameDataOffset);
+    this->nextFrameOffset = frameDataOffset + this->frameSize;
+  }
+
+  return {};
+}
+
+size_t Y4MFrameIndex::getNumberFrames() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->frameDataOffsets.size();
+}
+
+std::optional<int64_t> Y4MFrameIndex::getFrameDataOffset(int frameIdx) const
+{
+  QMutexLocker lock(&this->accessMutex);
+  if (frameIdx < 0 || size_t(frameIdx) >= this->frameDataOffsets.size())
+    return {};
+  return this->frameDataOffsets.at(size_t(frameIdx));
+}
+
+} // namespace filesource
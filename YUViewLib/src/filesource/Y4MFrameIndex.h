@@ -0,0 +1,76 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <QMutex>
+
+#include <filesource/FileSource.h>
+
+namespace filesource
+{
+
+/* The byte offsets of the frames in a Y4M file. Each frame starts with the indicator 'FRAME'
+ * followed by optional frame parameters which are terminated by a 0x0A byte. The raw frame data
+ * (of a fixed size) follows. The index can be extended when data was appended to the file. All
+ * functions are thread-safe.
+ */
+class Y4MFrameIndex
+{
+public:
+  Y4MFrameIndex() = default;
+
+  // Clear the index. The first frame indicator is expected at firstFrameOffset.
+  void reset(int64_t firstFrameOffset, int64_t frameSize);
+
+  // Index all frames from the first frame that is not indexed yet up to the end of the file. If
+  // stopAtIncompleteFrame is set (the file is still being written), a frame is only added once all
+  // of its data is in the file. Returns an error message if the file could not be indexed.
+  std::optional<std::string> indexFrames(FileSource &file, bool stopAtIncompleteFrame);
+
+  size_t getNumberFrames() const;
+
+  // The offset of the first byte of the raw data of the frame
+  std::optional<int64_t> getFrameDataOffset(int frameIdx) const;
+
+private:
+  mutable QMutex       accessMutex;
+  std::vector<int64_t> frameDataOffsets;
+  int64_t              nextFrameOffset{};
+  int64_t              frameSize{};
+};
+
+} // namespace filesource
@@ -0,0 +1,394 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CommandLineHandler.h"
+
+#include <filesource/FrameFormatGuess.h>
+#include <playlistitem/playlistItem.h>
+#include <playlistitem/playlistItems.h>
+#include <video/FrameExporter.h>
+#include <video/PixelFormatConverter.h>
+#include <video/rgb/PixelFormatRGBGuess.h>
+#include <video/videoHandler.h>
+#include <video/yuv/PixelFormatYUVGuess.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QThread>
+
+#include <iostream>
+#include <memory>
+
+namespace commandline
+{
+
+namespace
+{
+
+const auto EXPORT_COMMAND  = QString("-export");
+const auto CONVERT_COMMAND = QString("-convert");
+
+struct ExportArguments
+{
+  QString                   inputFile;
+  QString                   outputFile;
+  std::optional<indexRange> frameRange;
+  QString                   pixelFormat;
+  QString                   colorConversion;
+  int                       nrThreads{0};
+};
+
+void printExportUsage()
+{
+  std::cerr << "Usage: YUView -export <input file> <output file> [-frames <first>:<last>] "
+               "[-format <pixel format>] [-colorConversion <conversion>] [-threads <number>]\n";
+}
+
+std::optional<ExportArguments> parseExportArguments(const QStringList &arguments)
+{
+  ExportArguments exportArguments;
+  QStringList     files;
+  for (int i = 0; i < arguments.size(); i++)
+  {
+    const auto &argument = arguments.at(i);
+    if (!argument.startsWith("-"))
+    {
+      files.append(argument);
+      continue;
+    }
+    if (i + 1 >= arguments.size())
+      return {};
+
+    const auto value = arguments.at(++i);
+    if (argument == "-frames")
+    {
+      const auto limits = value.split(":");
+      bool       firstOk{}, lastOk{};
+      if (limits.size() != 2)
+        return {};
+      exportArguments.frameRange = {limits[0].toInt(&firstOk), limits[1].toInt(&lastOk)};
+      if (!firstOk || !lastOk)
+        return {};
+    }
+    else if (argument == "-format")
+      exportArguments.pixelFormat = value;
+    else if (argument == "-colorConversion")
+      exportArguments.colorConversion = value;
+    else if (argument == "-threads")
+      exportArguments.nrThreads = value.toInt();
+    else
+      return {};
+  }
+
+  if (files.size() != 2)
+    return {};
+  exportArguments.inputFile  = files[0];
+  exportArguments.outputFile = files[1];
+  return exportArguments;
+}
+
+// Compressed files may still be indexed in the background after opening. Wait until the whole
+// frame range is known.
+void waitForFrameIndex(playlistItem *item)
+{
+  while (!item->isFrameIndexComplete())
+    QThread::msleep(50);
+  // Deliver the queued updates of the frame range. The last one is queued before the index is
+  // complete.
+  QCoreApplication::processEvents();
+}
+
+std::optional<QString> setExportFormat(video::FrameExporter::Settings &settings,
+                                       const ExportArguments           &exportArguments,
+                                       video::videoHandler             *video)
+{
+  const auto suffix = QFileInfo(exportArguments.outputFile).suffix().toLower();
+  if (suffix == "rgb")
+  {
+    settings.outputType     = video::FrameExporter::OutputType::RawRGB;
+    settings.pixelFormatRGB = video::rgb::PixelFormatRGB(
+        exportArguments.pixelFormat.isEmpty() ? "RGB 8bit"
+                                              : exportArguments.pixelFormat.toStdString());
+    if (!settings.pixelFormatRGB.isValid())
+      return "Unknown RGB format " + exportArguments.pixelFormat;
+  }
+  else if (suffix == "yuv")
+  {
+    settings.outputType = video::FrameExporter::OutputType::RawYUV;
+    if (!exportArguments.pixelFormat.isEmpty())
+      settings.pixelFormatYUV =
+          video::yuv::PixelFormatYUV(exportArguments.pixelFormat.toStdString());
+    else if (auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(video))
+      settings.pixelFormatYUV = yuvVideo->getPixelFormatYUV();
+    else
+      settings.pixelFormatYUV = video::yuv::PixelFormatYUV(video::yuv::Subsampling::YUV_420, 8);
+    if (!settings.pixelFormatYUV.isValid())
+      return "Unknown YUV format " + exportArguments.pixelFormat;
+  }
+  else
+    settings.outputType = video::FrameExporter::OutputType::ImageSequence;
+
+  if (!exportArguments.colorConversion.isEmpty())
+  {
+    auto colorConversion = video::yuv::ColorConversionMapper.getValueCaseInsensitive(
+        exportArguments.colorConversion.toStdString());
+    if (!colorConversion)
+      return "Unknown color conversion " + exportArguments.colorConversion;
+    settings.colorConversion = *colorConversion;
+  }
+  return {};
+}
+
+int runExport(const QStringList &arguments)
+{
+  const auto exportArguments = parseExportArguments(arguments);
+  if (!exportArguments)
+  {
+    printExportUsage();
+    return 1;
+  }
+
+  std::unique_ptr<playlistItem> item(
+      playlistItems::createPlaylistItemFromFile(nullptr, exportArguments->inputFile));
+  if (!item)
+  {
+    std::cerr << "Unable to open " << exportArguments->inputFile.toStdString() << "\n";
+    return 1;
+  }
+  waitForFrameIndex(item.get());
+
+  auto video = dynamic_cast<video::videoHandler *>(item->getFrameHandler());
+  if (video == nullptr)
+  {
+    std::cerr << "The file " << exportArguments->inputFile.toStdString()
+              << " has no video that can be exported\n";
+    return 1;
+  }
+
+  const auto startEndRange = item->properties().startEndRange;
+  if (const auto frameRange = exportArguments->frameRange)
+  {
+    if (frameRange->first > frameRange->second || frameRange->first < startEndRange.first ||
+        frameRange->second > startEndRange.second)
+    {
+      std::cerr << "The frame range " << frameRange->first << ":" << frameRange->second
+                << " is not within the frames " << startEndRange.first << ":"
+                << startEndRange.second << " of the input file\n";
+      return 1;
+    }
+  }
+
+  video::FrameExporter::Settings settings;
+  settings.outputPath = exportArguments->outputFile;
+  settings.frameRange = exportArguments->frameRange.value_or(startEndRange);
+  settings.nrThreads  = exportArguments->nrThreads;
+  if (auto error = setExportFormat(settings, *exportArguments, video))
+  {
+    std::cerr << error->toStdString() << "\n";
+    return 1;
+  }
+
+  const auto nrFrames = settings.frameRange.second - settings.frameRange.first + 1;
+
+  video::FrameExporter exporter(video, settings, item->cachingThreadLimit());
+  QObject::connect(&exporter,
+                   &video::FrameExporter::signalFrameWritten,
+                   [nrFrames](int nrFramesWritten) {
+                     std::cout << "\rExported frame " << nrFramesWritten << " of " << nrFrames
+                               << std::flush;
+                   });
+  const auto success = exporter.run();
+  std::cout << "\n";
+
+  if (!success)
+  {
+    std::cerr << "Export failed: " << exporter.getErrorMessage().toStdString() << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+struct ConvertArguments
+{
+  QString             inputFile;
+  QString             outputFile;
+  QString             inputFormat;
+  QString             outputFormat;
+  std::optional<Size> frameSize;
+};
+
+void printConvertUsage()
+{
+  std::cerr << "Usage: YUView -convert <input file> <output file> -format <pixel format> "
+               "[-inputFormat <pixel format>] [-size <width>x<height>]\n";
+}
+
+std::optional<ConvertArguments> parseConvertArguments(const QStringList &arguments)
+{
+  ConvertArguments convertArguments;
+  QStringList      files;
+  for (int i = 0; i < arguments.size(); i++)
+  {
+    const auto &argument = arguments.at(i);
+    if (!argument.startsWith("-"))
+    {
+      files.append(argument);
+      continue;
+    }
+    if (i + 1 >= arguments.size())
+      return {};
+
+    const auto value = arguments.at(++i);
+    if (argument == "-format")
+      convertArguments.outputFormat = value;
+    else if (argument == "-inputFormat")
+      convertArguments.inputFormat = value;
+    else if (argument == "-size")
+    {
+      const auto dimensions = value.toLower().split("x");
+      bool       widthOk{}, heightOk{};
+      if (dimensions.size() != 2)
+        return {};
+      convertArguments.frameSize =
+          Size(dimensions[0].toUInt(&widthOk), dimensions[1].toUInt(&heightOk));
+      if (!widthOk || !heightOk)
+        return {};
+    }
+    else
+      return {};
+  }
+
+  if (files.size() != 2 || convertArguments.outputFormat.isEmpty())
+    return {};
+  convertArguments.inputFile  = files[0];
+  convertArguments.outputFile = files[1];
+  return convertArguments;
+}
+
+// The RGB parser also accepts some YUV format names (like "YUV 4:2:0 8-bit"). Try YUV first.
+std::optional<video::RawPixelFormat> parsePixelFormatName(const QString &name)
+{
+  const auto formatYUV = video::yuv::PixelFormatYUV(name.toStdString());
+  if (formatYUV.isValid())
+    return formatYUV;
+  const auto formatRGB = video::rgb::PixelFormatRGB(name.toStdString());
+  if (formatRGB.isValid())
+    return formatRGB;
+  return {};
+}
+
+int runConvert(const QStringList &arguments)
+{
+  const auto convertArguments = parseConvertArguments(arguments);
+  if (!convertArguments)
+  {
+    printConvertUsage();
+    return 1;
+  }
+
+  const auto targetFormat = parsePixelFormatName(convertArguments->outputFormat);
+  if (!targetFormat)
+  {
+    std::cerr << "Unknown pixel format " << convertArguments->outputFormat.toStdString() << "\n";
+    return 1;
+  }
+
+  // Size and input format are guessed from the file name (and size) like when opening the file
+  const auto fileInfo = filesource::frameFormatGuess::getFileInfoForGuessFromPath(
+      convertArguments->inputFile.toStdString());
+  auto guessedFormat = filesource::frameFormatGuess::guessFrameFormat(fileInfo);
+  if (convertArguments->frameSize)
+    guessedFormat.frameSize = convertArguments->frameSize;
+  if (!guessedFormat.frameSize)
+  {
+    std::cerr << "The frame size could not be guessed from the file name. Use -size.\n";
+    return 1;
+  }
+
+  std::optional<video::RawPixelFormat> sourceFormat;
+  if (!convertArguments->inputFormat.isEmpty())
+    sourceFormat = parsePixelFormatName(convertArguments->inputFormat);
+  else if (std::holds_alternative<video::yuv::PixelFormatYUV>(*targetFormat))
+    sourceFormat = video::yuv::guessPixelFormatFromSizeAndName(guessedFormat, fileInfo);
+  else
+    sourceFormat = video::rgb::guessPixelFormatFromSizeAndName(guessedFormat, fileInfo);
+  if (!sourceFormat)
+  {
+    std::cerr << "Unknown pixel format " << convertArguments->inputFormat.toStdString() << "\n";
+    return 1;
+  }
+
+  const auto converter =
+      video::PixelFormatConverter(*sourceFormat, *targetFormat, *guessedFormat.frameSize);
+  if (!converter.isValid())
+  {
+    std::cerr << "Conversion not possible: " << converter.getErrorMessage().toStdString() << "\n";
+    return 1;
+  }
+
+  QString    errorMessage;
+  const auto success = converter.convertFile(
+      convertArguments->inputFile,
+      convertArguments->outputFile,
+      [](int64_t nrFramesDone, int64_t nrFramesTotal) {
+        std::cout << "\rConverted frame " << nrFramesDone << " of " << nrFramesTotal << std::flush;
+      },
+      &errorMessage);
+  std::cout << "\n";
+
+  if (!success)
+  {
+    std::cerr << "Conversion failed: " << errorMessage.toStdString() << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace
+
+bool isHeadlessCommand(const QStringList &arguments)
+{
+  return arguments.size() > 1 &&
+         (arguments.at(1) == EXPORT_COMMAND || arguments.at(1) == CONVERT_COMMAND);
+}
+
+int runHeadlessCommand(const QStringList &arguments)
+{
+  if (arguments.size() > 1 && arguments.at(1) == EXPORT_COMMAND)
+    return runExport(arguments.mid(2));
+  if (arguments.size() > 1 && arguments.at(1) == CONVERT_COMMAND)
+    return runConvert(arguments.mid(2));
+  return 1;
+}
+
+} // namespace commandline
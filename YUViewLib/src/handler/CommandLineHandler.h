@@ -0,0 +1,63 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QStringList>
+
+/* Commands that can be run from the command line without opening the main window:
+ *
+ * YUView -export <input file> <output file> [-frames <first>:<last>] [-format <pixel format>]
+ *        [-colorConversion <conversion>] [-threads <number>]
+ *   Export frames of the input file. The output is chosen by the suffix of the output file: Raw
+ *   YUV (.yuv), raw RGB (.rgb) or a sequence of numbered images (.png, .jpg, ...). The format is
+ *   the name of a YUV or RGB pixel format as shown in the format selection (e.g. "YUV 4:2:0
+ *   10-bit"). By default the format of the input is kept (YUV 4:2:0 8-bit or RGB 8bit if the
+ *   input has no such format). The frame range must lie within the frames of the input file.
+ *
+ * YUView -convert <input file> <output file> -format <pixel format> [-inputFormat <pixel format>]
+ *        [-size <width>x<height>]
+ *   Convert a raw YUV or RGB file to another pixel format of the same kind (e.g. from planar
+ *   YUV 4:2:0 to NV12 or V210). The file is converted chunk by chunk without decoding it to RGB
+ *   images. The frame size and the input format are guessed from the file name if not given.
+ */
+namespace commandline
+{
+
+// Is the first argument (after the program name) a command that runs without the main window?
+// These commands do not need a display (the offscreen platform is used).
+bool isHeadlessCommand(const QStringList &arguments);
+
+// Run the command and return the exit code for the application
+int runHeadlessCommand(const QStringList &arguments);
+
+} // namespace commandline
@@ -32,10 +32,24 @@
 
 #include "ParserAV1OBU.h"
 
+#include <QElapsedTimer>
+
+#include <map>
+
+#include <filesource/FileSourceAV1OBUFile.h>
+
 #include "OpenBitstreamUnit.h"
 #include "frame_header_obu.h"
 #include "parser/common/SubByteReaderLogging.h"
 
+#define PARSERAV1OBU_DEBUG_OUTPUT 0
+#if PARSERAV1OBU_DEBUG_OUTPUT && !NDEBUG
+#include <QDebug>
+#define DEBUG_AV1OBU(f) qDebug() << f
+#else
+#define DEBUG_AV1OBU(f) ((void)0)
+#endif
+
 namespace parser
 {
 
@@ -48,7 +62,7 @@ ParserAV1OBU::ParserAV1OBU(QObject *parent) : Parser(parent)
 }
 
 std::pair<size_t, std::string> ParserAV1OBU::parseAndAddOBU(int                       obuID,
-                                                            ByteVector &              data,
+                                                            ByteSpan                  data,
                                                             std::shared_ptr<TreeItem> parent,
                                                             pairUint64 obuStartEndPosFile)
 {
@@ -127,4 +141,133 @@ std::pair<size_t, std::string> ParserAV1OBU::parseAndAddOBU(int
   return {sizeRead, obuTypeName};
 }
 
+bool ParserAV1OBU::runParsingOfFile(const std::filesystem::path &compressedFilePath)
+{
+  DEBUG_AV1OBU("ParserAV1OBU::runParsingOfFile");
+
+  FileSourceAV1OBUFile file;
+  if (!file.openFile(compressedFilePath))
+  {
+    emit backgroundParsingDone("Error opening raw AV1 file");
+    return false;
+  }
+
+  using FileFormat = FileSourceAV1OBUFile::FileFormat;
+
+  const auto format           = file.getFileFormat();
+  this->streamInfo.fileSize   = file.getFileSize().value_or(0);
+  this->streamInfo.fileFormat = format == FileFormat::IVF           ? "IVF"
+                                : format == FileFormat::LowOverhead ? "Low overhead OBU"
+                                                                    : "Annex B";
+  this->streamInfo.nrOBUs     = file.getNumberOBUs();
+  this->streamInfo.nrFrames   = file.getNumberFrames();
+  this->streamInfo.parsing    = true;
+  emit streamInfoUpdated();
+
+  // The file source already found all temporal units. Parse them one by one.
+  const auto    nrFrames = file.getNumberFrames();
+  int           obuID    = 0;
+  QElapsedTimer signalEmitTimer;
+  signalEmitTimer.start();
+  for (size_t frameIdx = 0; frameIdx < nrFrames; frameIdx++)
+  {
+    this->progressPercentValue = int(frameIdx * 100 / nrFrames);
+
+    const auto temporalUnit = file.getTemporalUnit(frameIdx);
+    const auto data         = file.getNextTemporalUnit();
+    if (!temporalUnit || data.isEmpty())
+      break;
+
+    std::shared_ptr<TreeItem> unitRoot;
+    if (this->packetModel->rootItem)
+      unitRoot = this->packetModel->rootItem->createChildItem();
+
+    // Parse the OBUs in place in the data of the temporal unit without copying them
+    const auto unitData = reinterpret_cast<const unsigned char *>(data.constData());
+
+    std::map<std::string, unsigned> unitNames;
+    for (const auto &[offset, size] : FileSourceAV1OBUFile::splitIntoOBUs(data))
+    {
+      const auto obuStart = temporalUnit->filePos + offset;
+      const auto obuData  = ByteSpan(unitData + offset, size);
+      try
+      {
+        const auto obuTypeName =
+            this->parseAndAddOBU(obuID, obuData, unitRoot, {obuStart, obuStart + size}).second;
+        if (!obuTypeName.empty())
+          unitNames[obuTypeName]++;
+      }
+      catch (...)
+      {
+        DEBUG_AV1OBU("ParserAV1OBU::runParsingOfFile Error parsing OBU " << obuID);
+      }
+      obuID++;
+    }
+
+    if (unitRoot)
+    {
+      auto name = "TU " + std::to_string(frameIdx) + " - OBUs:";
+      for (const auto &entry : unitNames)
+      {
+        name += " " + entry.first;
+        if (entry.second > 1)
+          name += "(x" + std::to_string(entry.second) + ")";
+      }
+      unitRoot->setProperties(name);
+    }
+
+    BitratePlotModel::BitrateEntry entry;
+    entry.dts       = int(frameIdx);
+    entry.pts       = int(frameIdx);
+    entry.bitrate   = size_t(data.size());
+    entry.keyframe  = temporalUnit->randomAccessPoint;
+    entry.frameType = temporalUnit->randomAccessPoint ? "Key" : "Frame";
+    this->bitratePlotModel->addBitratePoint(0, entry);
+
+    if (signalEmitTimer.elapsed() > 1000 && this->packetModel)
+    {
+      signalEmitTimer.start();
+      emit modelDataUpdated();
+    }
+
+    if (this->cancelBackgroundParser)
+    {
+      DEBUG_AV1OBU("ParserAV1OBU::runParsingOfFile Abort parsing by user request.");
+      break;
+    }
+    if (this->parsingLimitEnabled && frameIdx >= PARSER_FILE_FRAME_NR_LIMIT)
+    {
+      DEBUG_AV1OBU("ParserAV1OBU::runParsingOfFile Abort parsing because frame limit was reached.");
+      break;
+    }
+  }
+
+  if (this->packetModel)
+    emit modelDataUpdated();
+
+  this->progressPercentValue = 100;
+  this->streamInfo.parsing   = false;
+  emit streamInfoUpdated();
+  emit backgroundParsingDone("");
+
+  return !this->cancelBackgroundParser;
+}
+
+vector<QTreeWidgetItem *> ParserAV1OBU::getStreamInfo()
+{
+  vector<QTreeWidgetItem *> infoList;
+  infoList.push_back(new QTreeWidgetItem(
+      QStringList() << "File size" << QString::number(this->streamInfo.fileSize)));
+  infoList.push_back(new QTreeWidgetItem(
+      QStringList() << "File format" << QString::fromStdString(this->streamInfo.fileFormat)));
+  infoList.push_back(new QTreeWidgetItem(
+      QStringList() << "Number OBUs" << QString::number(this->streamInfo.nrOBUs)));
+  infoList.push_back(new QTreeWidgetItem(
+      QStringList() << "Number Frames" << QString::number(this->streamInfo.nrFrames)));
+  if (this->streamInfo.parsing)
+    infoList.push_back(new QTreeWidgetItem(QStringList() << "Parsing"
+                                                         << "..."));
+  return infoList;
+}
+
 } // namespace parser
\ No newline at end of file
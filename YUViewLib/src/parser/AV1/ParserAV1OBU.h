@@ -49,25 +49,31 @@ public:
   ParserAV1OBU(QObject *parent = nullptr);
   ~ParserAV1OBU() {}
 
+  // The data is a view that is only valid during the call
   std::pair<size_t, std::string> parseAndAddOBU(int                       obuID,
-                                                ByteVector               &data,
+                                                ByteSpan                  data,
                                                 std::shared_ptr<TreeItem> parent,
                                                 pairUint64 obuStartEndPosFile = pairUint64(-1, -1));
 
-  // So far, we only parse AV1 Obu files from the AVFormat parser so we don't need this (yet).
-  // When parsing of raw OBU files is added, we will need this.
-  bool runParsingOfFile(const std::filesystem::path &) override
-  {
-    assert(false);
-    return false;
-  }
-  vector<QTreeWidgetItem *> getStreamInfo() override { return {}; }
+  // Parse a raw AV1 file (IVF, low overhead OBU or annex B) temporal unit by temporal unit
+  bool runParsingOfFile(const std::filesystem::path &compressedFilePath) override;
+  vector<QTreeWidgetItem *> getStreamInfo() override;
   unsigned int              getNrStreams() override { return 1; }
   std::string               getShortStreamDescription(int) const override { return "Video"; }
 
 protected:
   av1::GlobalDecodingValues                 decValues;
   std::shared_ptr<av1::sequence_header_obu> active_sequence_header;
+
+  // Info about the raw file if runParsingOfFile is used
+  struct
+  {
+    int64_t     fileSize{};
+    std::string fileFormat;
+    size_t      nrOBUs{};
+    size_t      nrFrames{};
+    bool        parsing{};
+  } streamInfo;
 };
 
 } // namespace parser
@@ -179,7 +179,7 @@ video::yuv::PixelFormatYUV ParserAnnexBAVC::getPixelFormat() const
 
 ParserAnnexB::ParseResult
 ParserAnnexBAVC::parseAndAddNALUnit(int                                           nalID,
-                                    const ByteVector &                            data,
+                                    ByteSpan                                      data,
                                     std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                     std::optional<pairUint64> nalStartEndPosFile,
                                     std::shared_ptr<TreeItem> parent)
@@ -268,7 +268,7 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
                 << newSPS->seqParameterSetData.seq_parameter_set_id);
 
       nalAVC->rbsp    = newSPS;
-      nalAVC->rawData = data;
+      nalAVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalAVC);
       parseResult.nalTypeName =
           "SPS(" + std::to_string(newSPS->seqParameterSetData.seq_parameter_set_id) + ") ";
@@ -287,7 +287,7 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
                 << newPPS->pic_parameter_set_id);
 
       nalAVC->rbsp    = newPPS;
-      nalAVC->rawData = data;
+      nalAVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalAVC);
       parseResult.nalTypeName = "PPS(" + std::to_string(newPPS->pic_parameter_set_id) + ") ";
     }
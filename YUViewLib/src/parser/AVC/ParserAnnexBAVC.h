@@ -82,7 +82,7 @@ public:
   video::yuv::PixelFormatYUV getPixelFormat() const override;
 
   ParseResult parseAndAddNALUnit(int                                           nalID,
-                                 const ByteVector &                            data,
+                                 ByteSpan                                      data,
                                  std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                  std::optional<pairUint64> nalStartEndPosFile = {},
                                  std::shared_ptr<TreeItem> parent             = nullptr) override;
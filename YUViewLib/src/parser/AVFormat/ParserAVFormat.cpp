@@ -311,7 +311,9 @@ std::map<std::string, unsigned> ParserAVFormat::parseByteVectorAnnexBStartCodes(
   while (itStartCode != data.end())
   {
     auto itNextStartCode = getNextNalStart(itStartCode);
-    auto nalData         = ByteVector(itStartCode + sizeStartCode, itNextStartCode);
+    auto nalStart        = itStartCode + sizeStartCode;
+    auto nalData         = ByteSpan(data.data() + std::distance(data.begin(), nalStart),
+                                    size_t(std::distance(nalStart, itNextStartCode)));
     try
     {
       auto parseResult =
@@ -427,7 +429,9 @@ bool ParserAVFormat::parseAVPacket(unsigned         packetID,
         pairUint64 obuStartEndPosFile; // Not used
         try
         {
-          auto data = ByteVector(posInData, avpacketData.end());
+          const auto data =
+              ByteSpan(avpacketData.data() + std::distance(avpacketData.begin(), posInData),
+                       size_t(std::distance(posInData, avpacketData.end())));
           auto [nrBytesRead, obuTypeName] =
               this->obuParser->parseAndAddOBU(obuID, data, itemTree, obuStartEndPosFile);
           DEBUG_AVFORMAT(
@@ -580,8 +584,7 @@ bool ParserAVFormat::runParsingOfFile(const std::filesystem::path &compressedFil
 {
   // Open the file but don't parse it yet.
   FileSourceFFmpegFile ffmpegFile;
-  if (!ffmpegFile.openFile(
-          QString::fromStdString(compressedFilePath.string()), nullptr, nullptr, false))
+  if (!ffmpegFile.openFile(QString::fromStdString(compressedFilePath.string()), nullptr, false))
   {
     emit backgroundParsingDone("Error opening the ffmpeg file.");
     return false;
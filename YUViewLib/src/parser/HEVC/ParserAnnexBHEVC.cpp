@@ -286,7 +286,7 @@ Ratio ParserAnnexBHEVC::getSampleAspectRatio()
 
 ParserAnnexB::ParseResult
 ParserAnnexBHEVC::parseAndAddNALUnit(int                                           nalID,
-                                     const ByteVector                             &data,
+                                     ByteSpan                                      data,
                                      std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                      std::optional<pairUint64> nalStartEndPosFile,
                                      std::shared_ptr<TreeItem> parent)
@@ -353,7 +353,7 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
       specificDescription << " ID " << newVPS->vps_video_parameter_set_id;
 
       nalHEVC->rbsp    = newVPS;
-      nalHEVC->rawData = data;
+      nalHEVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalHEVC);
       parseResult.nalTypeName = "VPS(" + std::to_string(newVPS->vps_video_parameter_set_id) + ") ";
 
@@ -373,7 +373,7 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
                  << newSPS->sps_seq_parameter_set_id);
 
       nalHEVC->rbsp    = newSPS;
-      nalHEVC->rawData = data;
+      nalHEVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalHEVC);
       parseResult.nalTypeName = "SPS(" + std::to_string(newSPS->sps_seq_parameter_set_id) + ") ";
     }
@@ -390,7 +390,7 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
                  << newPPS->pps_pic_parameter_set_id);
 
       nalHEVC->rbsp    = newPPS;
-      nalHEVC->rawData = data;
+      nalHEVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalHEVC);
       parseResult.nalTypeName = "SPS(" + std::to_string(newPPS->pps_pic_parameter_set_id) + ") ";
     }
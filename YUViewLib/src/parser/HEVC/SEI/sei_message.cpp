@@ -184,7 +184,8 @@ SEIParsingResult sei_message::parse(reader::SubByteReaderLogging &          read
   // call for reparsing.
   auto payloadData = reader.readBytes("", this->payloadSize, Options().withLoggingDisabled());
   auto currentLoggingTreeItem = reader.getCurrentItemTree();
-  this->payloadReader         = SubByteReaderLogging(payloadData, currentLoggingTreeItem);
+  this->payloadReader =
+      SubByteReaderLogging(std::move(payloadData), currentLoggingTreeItem);
 
   // When reading the data above, emulation prevention was alread removed.
   this->payloadReader.disableEmulationPrevention();
@@ -58,7 +58,7 @@ using namespace mpeg2;
 
 ParserAnnexB::ParseResult
 ParserAnnexBMpeg2::parseAndAddNALUnit(int                                           nalID,
-                                      const ByteVector &                            data,
+                                      ByteSpan                                      data,
                                       std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                       std::optional<pairUint64> nalStartEndPosFile,
                                       std::shared_ptr<TreeItem> parent)
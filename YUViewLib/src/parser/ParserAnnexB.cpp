@@ -33,6 +33,7 @@
 #include "ParserAnnexB.h"
 
 #include <common/Formatting.h>
+#include <common/Tracing.h>
 #include <parser/common/SubByteReaderLogging.h>
 
 #include <QElapsedTimer>
@@ -84,7 +85,7 @@ bool ParserAnnexB::addFrameToList(int                       poc,
   return true;
 }
 
-void ParserAnnexB::logNALSize(const ByteVector         &data,
+void ParserAnnexB::logNALSize(ByteSpan                  data,
                               std::shared_ptr<TreeItem> root,
                               std::optional<pairUint64> nalStartEndPos)
 {
@@ -102,45 +103,48 @@ void ParserAnnexB::logNALSize(const ByteVector         &data,
     root->createChildItem("Start/End pos", to_string(*nalStartEndPos));
 }
 
-auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
-                                       FrameIndexDisplayOrder currentFrame) -> SeekPointInfo
+auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder                targetFrame,
+                                       std::optional<FrameIndexDisplayOrder> currentFrame)
+    -> SeekPointInfo
 {
-  if (targetFrame >= this->frameListCodingOrder.size())
-    return {};
-
   this->updateFrameListDisplayOrder();
-  auto frameTarget  = this->frameListDisplayOder[targetFrame];
-  auto frameCurrent = this->frameListDisplayOder[currentFrame];
-
-  auto bestSeekFrame = this->frameListCodingOrder.begin();
-  for (auto it = this->frameListCodingOrder.begin(); it != this->frameListCodingOrder.end(); it++)
-  {
-    if (it->randomAccessPoint && it->poc < frameTarget.poc)
-      bestSeekFrame = it;
-    if (it->poc == frameTarget.poc)
-      break;
-  }
+  const auto entry = this->seekIndex.getEntry(targetFrame);
+  if (!entry)
+    return {};
 
   SeekPointInfo seekPointInfo;
-  {
-    auto itInDisplayOrder = std::find(
-        this->frameListDisplayOder.begin(), this->frameListDisplayOder.end(), *bestSeekFrame);
-    seekPointInfo.frameIndex = std::distance(this->frameListDisplayOder.begin(), itInDisplayOrder);
-  }
-  {
-    auto itCurrentFrameCodingOrder = std::find(
-        this->frameListCodingOrder.begin(), this->frameListCodingOrder.end(), frameCurrent);
-    seekPointInfo.frameDistanceInCodingOrder =
-        std::distance(itCurrentFrameCodingOrder, bestSeekFrame);
-  }
+  seekPointInfo.frameIndex  = entry->seekPointDisplayIndex;
+  seekPointInfo.codingIndex = entry->seekPointCodingIndex;
+  seekPointInfo.decodeCost  = entry->decodeCost;
+  if (currentFrame)
+    seekPointInfo.decodeCostFromCurrentFrame =
+        this->seekIndex.getDecodeCostFromFrame(*currentFrame, targetFrame);
 
   DEBUG_ANNEXB("ParserAnnexB::getClosestSeekPoint targetFrame "
-               << targetFrame << "(POC " << frameTarget.poc << " seek to "
-               << seekPointInfo.frameIndex << " (POC " << bestSeekFrame->poc
-               << ") distance in coding order " << seekPointInfo.frameDistanceInCodingOrder);
+               << targetFrame << " seek to " << seekPointInfo.frameIndex << " decode cost "
+               << seekPointInfo.decodeCost);
   return seekPointInfo;
 }
 
+std::optional<SeekIndex::Entry> ParserAnnexB::getSeekIndexEntry(FrameIndexDisplayOrder frame)
+{
+  this->updateFrameListDisplayOrder();
+  return this->seekIndex.getEntry(frame);
+}
+
+std::optional<SeekIndex::GOP> ParserAnnexB::getGOP(FrameIndexDisplayOrder frame)
+{
+  this->updateFrameListDisplayOrder();
+  return this->seekIndex.getGOP(frame);
+}
+
+std::optional<unsigned> ParserAnnexB::getDecodeCostFromFrame(FrameIndexDisplayOrder currentFrame,
+                                                             FrameIndexDisplayOrder targetFrame)
+{
+  this->updateFrameListDisplayOrder();
+  return this->seekIndex.getDecodeCostFromFrame(currentFrame, targetFrame);
+}
+
 std::optional<pairUint64> ParserAnnexB::getFrameStartEndPos(FrameIndexCodingOrder idx)
 {
   if (idx >= this->frameListCodingOrder.size())
@@ -149,7 +153,9 @@ std::optional<pairUint64> ParserAnnexB::getFrameStartEndPos(FrameIndexCodingOrde
   return this->frameListCodingOrder[idx].fileStartEndPos;
 }
 
-bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file, QWidget *mainWindow)
+bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
+                                   QWidget                               *mainWindow,
+                                   bool                                   holdBackLastNAL)
 {
   DEBUG_ANNEXB("ParserAnnexB::parseAnnexBFile");
 
@@ -174,8 +180,9 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
   this->streamInfo.parsing   = true;
   emit streamInfoUpdated();
 
-  // Just push all NAL units from the annexBFile into the annexBParser
-  int           nalID = 0;
+  // Just push all NAL units from the annexBFile into the annexBParser. When parsing is resumed, the
+  // NAL IDs continue.
+  int           nalID = int(this->streamInfo.nrNalUnits);
   pairUint64    nalStartEndPosFile;
   bool          abortParsing = false;
   QElapsedTimer signalEmitTimer;
@@ -187,10 +194,28 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     if (this->streamInfo.file_size > 0)
       progressPercentValue = functions::clip((int)(pos * 100 / this->streamInfo.file_size), 0, 100);
 
+    const auto nalUnit = file->getNextNALUnit(false, &nalStartEndPosFile);
+    if (file->atEnd())
+    {
+      if (holdBackLastNAL)
+      {
+        DEBUG_ANNEXB("ParserAnnexB::parseAnnexBFile Holding back the last NAL at "
+                     << nalStartEndPosFile.first);
+        this->tailState.resumeFilePos = nalStartEndPosFile.first;
+        break;
+      }
+      // For the last NAL unit, the end position is the position of the last byte
+      this->tailState.resumeFilePos = nalStartEndPosFile.second + 1;
+    }
+    else
+      this->tailState.resumeFilePos = nalStartEndPosFile.second;
+
     try
     {
-      auto nalData = reader::SubByteReaderLogging::convertToByteVector(
-          file->getNextNALUnit(false, &nalStartEndPosFile));
+      TRACE_SCOPE("parser", "ParserAnnexB::parseAndAddNALUnit", nalID);
+      // The NAL unit points into the read buffer of the file. Parse it in place without copying.
+      const auto nalData = ByteSpan(reinterpret_cast<const unsigned char *>(nalUnit.constData()),
+                                    size_t(nalUnit.size()));
       auto parsingResult =
           this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr);
       if (!parsingResult.success)
@@ -252,6 +277,7 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     }
   }
 
+  this->tailState.nrFramesBeforeEndOfFile = this->frameListCodingOrder.size();
   try
   {
     auto parseResult = this->parseAndAddNALUnit(-1, {}, {}, {});
@@ -287,6 +313,37 @@ bool ParserAnnexB::runParsingOfFile(const std::filesystem::path &compressedFileP
   return this->parseAnnexBFile(file);
 }
 
+std::optional<FrameIndexDisplayOrder>
+ParserAnnexB::resumeParsingAnnexBFile(const std::filesystem::path &filePath, bool holdBackLastNAL)
+{
+  DEBUG_ANNEXB("ParserAnnexB::resumeParsingAnnexBFile at " << this->tailState.resumeFilePos);
+
+  auto file = std::make_unique<FileSourceAnnexBFile>(filePath);
+  if (!file->isOk() || !this->hasUnparsedData(file->getFileSize().value_or(0)) ||
+      !file->seek(int64_t(this->tailState.resumeFilePos)))
+    return {};
+
+  this->updateFrameListDisplayOrder();
+  const auto framesBefore = this->frameListDisplayOder;
+
+  // Parsing of the NAL units of the last frame will continue so the frame is added again later.
+  this->frameListCodingOrder.resize(this->tailState.nrFramesBeforeEndOfFile);
+  this->frameListDisplayOder.clear();
+
+  this->parseAnnexBFile(file, nullptr, holdBackLastNAL);
+
+  // New frames may have been inserted in display order before already known frames
+  this->updateFrameListDisplayOrder();
+  FrameIndexDisplayOrder firstChangedFrame = 0;
+  while (firstChangedFrame < framesBefore.size() &&
+         firstChangedFrame < this->frameListDisplayOder.size() &&
+         framesBefore[firstChangedFrame] == this->frameListDisplayOder[firstChangedFrame] &&
+         framesBefore[firstChangedFrame].fileStartEndPos ==
+             this->frameListDisplayOder[firstChangedFrame].fileStartEndPos)
+    firstChangedFrame++;
+  return firstChangedFrame;
+}
+
 vector<QTreeWidgetItem *> ParserAnnexB::createTreeItemsFromStreamInfo() const
 {
   vector<QTreeWidgetItem *> infoList;
@@ -323,6 +380,12 @@ void ParserAnnexB::updateFrameListDisplayOrder()
 
   this->frameListDisplayOder = this->frameListCodingOrder;
   std::sort(frameListDisplayOder.begin(), frameListDisplayOder.end());
+
+  std::vector<SeekIndex::CodedFrame> codedFrames;
+  codedFrames.reserve(this->frameListCodingOrder.size());
+  for (const auto &frame : this->frameListCodingOrder)
+    codedFrames.push_back({frame.poc, frame.randomAccessPoint});
+  this->seekIndex = SeekIndex(codedFrames);
 }
 
 } // namespace parser
\ No newline at end of file
@@ -41,6 +41,7 @@
 #include <filesource/FileSourceAnnexBFile.h>
 #include <parser/Parser.h>
 #include <parser/common/BitratePlotModel.h>
+#include <parser/common/SeekIndex.h>
 #include <parser/common/TreeItem.h>
 #include <video/yuv/videoHandlerYUV.h>
 
@@ -76,10 +77,12 @@ public:
    * It also adds the unit to the nalUnitList (if it is a parameter set or an RA point).
    * When there are no more NAL units in the file (the file ends), call this function one last time
    * with empty data and a nalID of -1. \nalID A counter (ID) of the nal \data The raw data of the
-   * NAL. May include the start code or not. \bitrateEntry Pass the bitrate entry data into the
-   * function that may already be known. E.g. the ffmpeg parser already decodes the DTS/PTS values
-   * from the container. \parent The tree item of the parent where the items will be appended.
-   * \nalStartEndPosFile The position of the first and last byte of the NAL.
+   * NAL. May include the start code or not. The data is a view (e.g. into the read buffer of the
+   * file) that is only valid during the call, so copy everything that must be kept. \bitrateEntry
+   * Pass the bitrate entry data into the function that may already be known. E.g. the ffmpeg
+   * parser already decodes the DTS/PTS values from the container. \parent The tree item of the
+   * parent where the items will be appended. \nalStartEndPosFile The position of the first and
+   * last byte of the NAL.
    */
   struct ParseResult
   {
@@ -89,7 +92,7 @@ public:
     std::optional<BitratePlotModel::BitrateEntry> bitrateEntry;
   };
   virtual ParseResult parseAndAddNALUnit(int                                           nalID,
-                                         const ByteVector                             &data,
+                                         ByteSpan                                      data,
                                          std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                          std::optional<pairUint64> nalStartEndPosFile = {},
                                          std::shared_ptr<TreeItem> parent = nullptr) = 0;
@@ -111,14 +114,29 @@ public:
 
   // Look through the random access points and find the closest one before (or equal)
   // the given frameIdx where we can start decoding
-  // frameIdx: The frame index in display order that we want to seek to
+  // targetFrame: The frame index in display order that we want to seek to
+  // currentFrame: The last frame that the decoder output (if any)
   struct SeekPointInfo
   {
     FrameIndexDisplayOrder frameIndex{};
-    unsigned               frameDistanceInCodingOrder{};
+    FrameIndexCodingOrder  codingIndex{};
+    // The number of frames to decode when starting at the seek point
+    unsigned decodeCost{};
+    // The number of frames to decode when continuing from the current frame. Not set if decoding
+    // can not continue because the target frame is not after the current frame.
+    std::optional<unsigned> decodeCostFromCurrentFrame;
   };
-  auto getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
-                           FrameIndexDisplayOrder currentFrame) -> SeekPointInfo;
+  auto getClosestSeekPoint(FrameIndexDisplayOrder                targetFrame,
+                           std::optional<FrameIndexDisplayOrder> currentFrame) -> SeekPointInfo;
+
+  // Get the seek index entry of the given frame (see SeekIndex)
+  std::optional<SeekIndex::Entry> getSeekIndexEntry(FrameIndexDisplayOrder frame);
+  // Get the GOP of the given frame (see SeekIndex)
+  std::optional<SeekIndex::GOP> getGOP(FrameIndexDisplayOrder frame);
+  // The number of frames to decode to get the target frame when decoding continues after the
+  // current frame was output. Empty if decoding can not continue from the current frame.
+  std::optional<unsigned> getDecodeCostFromFrame(FrameIndexDisplayOrder currentFrame,
+                                                 FrameIndexDisplayOrder targetFrame);
 
   // Get the parameters sets as extradata. The format of this depends on the underlying codec.
   virtual QByteArray getExtradata() = 0;
@@ -128,7 +146,23 @@ public:
 
   std::optional<pairUint64> getFrameStartEndPos(FrameIndexCodingOrder idx);
 
-  bool parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file, QWidget *mainWindow = nullptr);
+  // Parse all NAL units in the file. If holdBackLastNAL is set, the last NAL unit of the file is
+  // not parsed because the file is still being written and it may not be complete yet.
+  bool parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
+                       QWidget                               *mainWindow      = nullptr,
+                       bool                                   holdBackLastNAL = false);
+
+  // Tail mode for files that are still being written. Continue parsing at the first NAL unit that
+  // was not parsed yet. The last frame, which was only added provisionally when the end of the file
+  // was reached, is removed first and added again once it is complete. Returns the first frame (in
+  // display order) that changed or was added. All frames before it are unchanged. Returns nothing
+  // if there was no new data to parse.
+  std::optional<FrameIndexDisplayOrder>
+  resumeParsingAnnexBFile(const std::filesystem::path &filePath, bool holdBackLastNAL);
+  bool hasUnparsedData(int64_t fileSize) const
+  {
+    return uint64_t(fileSize) > this->tailState.resumeFilePos;
+  }
 
   // Called from the bitstream analyzer. This function can run in a background process.
   bool runParsingOfFile(const std::filesystem::path &compressedFilePath) override;
@@ -152,7 +186,7 @@ protected:
                       bool                      randomAccessPoint,
                       unsigned                  layerID);
 
-  static void logNALSize(const ByteVector         &data,
+  static void logNALSize(ByteSpan                  data,
                          std::shared_ptr<TreeItem> root,
                          std::optional<pairUint64> nalStartEndPos);
 
@@ -167,6 +201,15 @@ protected:
     bool     parsing{false};
   };
   StreamInfo                streamInfo{};
+
+  struct TailState
+  {
+    // The file position of the first NAL unit that was not parsed yet
+    uint64_t resumeFilePos{};
+    // The number of frames in the list before the last frame was added at the end of the file
+    size_t nrFramesBeforeEndOfFile{};
+  };
+  TailState tailState{};
   vector<QTreeWidgetItem *> createTreeItemsFromStreamInfo() const;
 
   int getFramePOC(FrameIndexDisplayOrder frameIdx);
@@ -176,9 +219,10 @@ private:
   // slice NAL units associated with a frame. POC's don't have to be consecutive, so the only way to
   // know how many pictures are in a sequences is to keep a list of all POCs.
   vector<AnnexBFrame> frameListCodingOrder;
-  // The same list of frames but sorted in display order. Generated from the list above whenever
-  // needed.
+  // The same list of frames but sorted in display order and the seek index. Generated from the
+  // list above whenever needed.
   vector<AnnexBFrame> frameListDisplayOder;
+  SeekIndex           seekIndex;
   void                updateFrameListDisplayOrder();
 };
 
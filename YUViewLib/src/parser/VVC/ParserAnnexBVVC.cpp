@@ -269,7 +269,7 @@ Ratio ParserAnnexBVVC::getSampleAspectRatio()
 
 ParserAnnexB::ParseResult
 ParserAnnexBVVC::parseAndAddNALUnit(int                                           nalID,
-                                    const ByteVector                             &data,
+                                    ByteSpan                                      data,
                                     std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                     std::optional<pairUint64> nalStartEndPosFile,
                                     std::shared_ptr<TreeItem> parent)
@@ -336,7 +336,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       specificDescription << " ID " << newVPS->vps_video_parameter_set_id;
 
       nalVVC->rbsp    = newVPS;
-      nalVVC->rawData = data;
+      nalVVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalVVC);
     }
     else if (nalType == NalType::SPS_NUT)
@@ -349,7 +349,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       specificDescription << " ID " << newSPS->sps_seq_parameter_set_id;
 
       nalVVC->rbsp    = newSPS;
-      nalVVC->rawData = data;
+      nalVVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalVVC);
     }
     else if (nalType == NalType::PPS_NUT)
@@ -362,7 +362,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       specificDescription << " ID " << newPPS->pps_pic_parameter_set_id;
 
       nalVVC->rbsp    = newPPS;
-      nalVVC->rawData = data;
+      nalVVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalVVC);
     }
     else if (nalType == NalType::PREFIX_APS_NUT || nalType == NalType::SUFFIX_APS_NUT)
@@ -376,7 +376,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       specificDescription << " ID " << newAPS->aps_adaptation_parameter_set_id;
 
       nalVVC->rbsp    = newAPS;
-      nalVVC->rawData = data;
+      nalVVC->rawData = ByteVector(data.begin(), data.end());
       this->nalUnitsForSeeking.push_back(nalVVC);
     }
     else if (nalType == NalType::PH_NUT)
@@ -482,7 +482,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
            nalType == NalType::CRA_NUT);
       if (updatedParsingState.currentAU.isKeyframe)
       {
-        nalVVC->rawData = data;
+        nalVVC->rawData = ByteVector(data.begin(), data.end());
         this->nalUnitsForSeeking.push_back(nalVVC);
       }
     }
@@ -97,7 +97,7 @@ public:
   Ratio                           getSampleAspectRatio() override;
 
   ParseResult parseAndAddNALUnit(int                                           nalID,
-                                 const ByteVector &                            data,
+                                 ByteSpan                                      data,
                                  std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
                                  std::optional<pairUint64> nalStartEndPosFile = {},
                                  std::shared_ptr<TreeItem> parent             = {}) override;
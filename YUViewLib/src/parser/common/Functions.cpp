@@ -67,7 +67,7 @@ std::vector<std::string> splitX26XOptionsString(const std::string str, const std
   return splitStrings;
 }
 
-size_t getStartCodeOffset(const ByteVector &data)
+size_t getStartCodeOffset(ByteSpan data)
 {
   unsigned readOffset = 0;
   if (data.at(0) == (char)0 && data.at(1) == (char)0 && data.at(2) == (char)1)
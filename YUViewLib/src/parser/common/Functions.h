@@ -63,6 +63,6 @@ template <typename... Args> std::string formatArray(std::string variableName, Ar
 
 std::string convertSliceCountsToString(const std::map<std::string, unsigned int> &sliceCounts);
 std::vector<std::string> splitX26XOptionsString(const std::string str, const std::string seperator);
-size_t                   getStartCodeOffset(const ByteVector &data);
+size_t                   getStartCodeOffset(ByteSpan data);
 
 } // namespace parser
@@ -34,6 +34,7 @@
 
 #include <common/Color.h>
 #include <common/FunctionsGui.h>
+#include <common/MemoryAccountant.h>
 #include <common/Typedef.h>
 
 #include <QBrush>
@@ -64,8 +65,17 @@ auto streamIndexColors = std::vector<Color>({Color("#90caf9"),   // blue (200)
                                              Color("#6d4c41"),   // brown (600)
                                              Color("#7cb342")}); // light green (600)
 
+// The size of one tree item including the shared pointer control block, the pointer in the parent
+// and the (mostly short) strings. This is only a rough estimate.
+constexpr int64_t APPROXIMATE_TREE_ITEM_SIZE = sizeof(TreeItem) + 64;
+
 PacketItemModel::PacketItemModel(QObject *parent) : QAbstractItemModel(parent)
 {
+  // The tree items are only counted globally so all models share one registration
+  static const auto memoryRegistration =
+      MemoryAccountant::instance().registerConsumer("Parser trees", [] {
+        return TreeItem::getNumberOfLiveItems() * APPROXIMATE_TREE_ITEM_SIZE;
+      });
 }
 
 PacketItemModel::~PacketItemModel()
@@ -0,0 +1,129 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SeekIndex.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace parser
+{
+
+SeekIndex::SeekIndex(const std::vector<CodedFrame> &framesInCodingOrder)
+{
+  const auto nrFrames = framesInCodingOrder.size();
+
+  std::vector<unsigned> codingIndicesInDisplayOrder(nrFrames);
+  std::iota(codingIndicesInDisplayOrder.begin(), codingIndicesInDisplayOrder.end(), 0u);
+  std::stable_sort(codingIndicesInDisplayOrder.begin(),
+                   codingIndicesInDisplayOrder.end(),
+                   [&framesInCodingOrder](unsigned a, unsigned b) {
+                     return framesInCodingOrder[a].poc < framesInCodingOrder[b].poc;
+                   });
+
+  std::vector<unsigned> displayIndices(nrFrames);
+  for (unsigned displayIndex = 0; displayIndex < nrFrames; displayIndex++)
+    displayIndices[codingIndicesInDisplayOrder[displayIndex]] = displayIndex;
+
+  this->entries.resize(nrFrames);
+  std::vector<unsigned> seekPointsInCodingOrder;
+  for (unsigned codingIndex = 0; codingIndex < nrFrames; codingIndex++)
+  {
+    const auto &frame = framesInCodingOrder[codingIndex];
+    if (frame.randomAccessPoint)
+      seekPointsInCodingOrder.push_back(codingIndex);
+
+    // Go back through the random access points until we find one that is not displayed after this
+    // frame. If there is none, decoding starts with the first frame.
+    const auto seekPoint = std::find_if(seekPointsInCodingOrder.rbegin(),
+                                        seekPointsInCodingOrder.rend(),
+                                        [&](unsigned seekPointCodingIndex) {
+                                          return framesInCodingOrder[seekPointCodingIndex].poc <=
+                                                 frame.poc;
+                                        });
+    const auto seekPointCodingIndex =
+        (seekPoint == seekPointsInCodingOrder.rend()) ? 0u : *seekPoint;
+
+    auto &entry                 = this->entries[displayIndices[codingIndex]];
+    entry.codingIndex           = codingIndex;
+    entry.seekPointCodingIndex  = seekPointCodingIndex;
+    entry.seekPointDisplayIndex = displayIndices[seekPointCodingIndex];
+    entry.decodeCost            = codingIndex - seekPointCodingIndex + 1;
+  }
+
+  // Before a frame can be output, all frames that are output before it must have been decoded
+  this->decodedUpToCodingIndex.resize(nrFrames);
+  unsigned maxCodingIndex = 0;
+  for (unsigned displayIndex = 0; displayIndex < nrFrames; displayIndex++)
+  {
+    maxCodingIndex = std::max(maxCodingIndex, this->entries[displayIndex].codingIndex);
+    this->decodedUpToCodingIndex[displayIndex] = maxCodingIndex;
+  }
+}
+
+std::optional<SeekIndex::Entry> SeekIndex::getEntry(unsigned displayIndex) const
+{
+  if (displayIndex >= this->entries.size())
+    return {};
+  return this->entries[displayIndex];
+}
+
+std::optional<SeekIndex::GOP> SeekIndex::getGOP(unsigned displayIndex) const
+{
+  if (displayIndex >= this->entries.size())
+    return {};
+
+  // All frames of a GOP follow each other in display order
+  const auto seekPoint = this->entries[displayIndex].seekPointDisplayIndex;
+  GOP        gop{seekPoint, displayIndex};
+  while (gop.lastFrame + 1 < this->entries.size() &&
+         this->entries[gop.lastFrame + 1].seekPointDisplayIndex == seekPoint)
+    gop.lastFrame++;
+  return gop;
+}
+
+std::optional<unsigned> SeekIndex::getDecodeCostFromFrame(unsigned currentDisplayIndex,
+                                                          unsigned targetDisplayIndex) const
+{
+  if (targetDisplayIndex <= currentDisplayIndex || targetDisplayIndex >= this->entries.size())
+    return {};
+
+  // If the target frame was coded before the frames that were already decoded, it is already
+  // decoded and waiting for output.
+  const auto decodedCodingIndex = this->decodedUpToCodingIndex[currentDisplayIndex];
+  const auto targetCodingIndex  = this->entries[targetDisplayIndex].codingIndex;
+  if (targetCodingIndex <= decodedCodingIndex)
+    return 0u;
+  return targetCodingIndex - decodedCodingIndex;
+}
+
+} // namespace parser
@@ -0,0 +1,95 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+namespace parser
+{
+
+/* A seek index for streams where the coding order differs from the display order (e.g. AnnexB).
+ * For every frame (in display order) it records the random access point where decoding has to
+ * start and the decode cost: the number of frames that have to be decoded (in coding order) from
+ * the random access point until the frame can be output. Leading pictures of a random access point
+ * (which follow it in coding order but precede it in display order) are assigned to the previous
+ * random access point.
+ * The index is built once from the list of frames and is read-only afterwards.
+ */
+class SeekIndex
+{
+public:
+  struct CodedFrame
+  {
+    int  poc{};
+    bool randomAccessPoint{};
+  };
+
+  struct Entry
+  {
+    unsigned codingIndex{};
+    unsigned seekPointDisplayIndex{};
+    unsigned seekPointCodingIndex{};
+    // The number of frames to decode from the seek point (including the seek point and the frame)
+    unsigned decodeCost{};
+  };
+
+  // The frames (display order) that are output when decoding starts at a random access point until
+  // the next random access point is output. A GOP can be decoded independently of the others.
+  struct GOP
+  {
+    unsigned firstFrame{};
+    unsigned lastFrame{};
+  };
+
+  SeekIndex() = default;
+  SeekIndex(const std::vector<CodedFrame> &framesInCodingOrder);
+
+  size_t               getNumberFrames() const { return this->entries.size(); }
+  std::optional<Entry> getEntry(unsigned displayIndex) const;
+  std::optional<GOP>   getGOP(unsigned displayIndex) const;
+
+  // The number of frames that have to be decoded to get the target frame if decoding just
+  // continues after the current frame was output. Empty if the target frame is not after the
+  // current frame in display order (so decoding can not continue).
+  std::optional<unsigned> getDecodeCostFromFrame(unsigned currentDisplayIndex,
+                                                 unsigned targetDisplayIndex) const;
+
+private:
+  std::vector<Entry> entries;
+  // For every frame in display order: The coding index up to which all frames must have been
+  // decoded when the frame is output.
+  std::vector<unsigned> decodedUpToCodingIndex;
+};
+
+} // namespace parser
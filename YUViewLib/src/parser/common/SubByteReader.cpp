@@ -40,8 +40,17 @@
 namespace parser
 {
 
-SubByteReader::SubByteReader(const ByteVector &inArr, size_t inArrOffset)
-    : byteVector(inArr), posInBufferBytes(inArrOffset), initialPosInBuffer(inArrOffset){};
+SubByteReader::SubByteReader() = default;
+
+SubByteReader::SubByteReader(ByteSpan inArr, size_t inArrOffset)
+    : data(inArr), posInBufferBytes(inArrOffset), initialPosInBuffer(inArrOffset){};
+
+SubByteReader::SubByteReader(ByteVector &&inArr, size_t inArrOffset)
+    : ownedData(std::make_shared<const ByteVector>(std::move(inArr))),
+      posInBufferBytes(inArrOffset), initialPosInBuffer(inArrOffset)
+{
+  this->data = ByteSpan(*this->ownedData);
+}
 
 std::tuple<uint64_t, std::string> SubByteReader::readBits(size_t nrBits)
 {
@@ -88,7 +97,7 @@ std::tuple<uint64_t, std::string> SubByteReader::readBits(size_t nrBits)
     // Shift output value so that the new bits fit
     out = out << readBits;
 
-    char c   = this->byteVector[this->posInBufferBytes];
+    char c   = this->data[this->posInBufferBytes];
     c        = c >> offset;
     int mask = ((1 << readBits) - 1);
 
@@ -128,7 +137,7 @@ std::tuple<ByteVector, std::string> SubByteReader::readBytes(size_t nrBytes)
   std::string code;
   for (unsigned i = 0; i < nrBytes; i++)
   {
-    auto c = this->byteVector[this->posInBufferBytes];
+    auto c = this->data[this->posInBufferBytes];
     retVector.push_back(c);
     code += std::bitset<8>(c).to_string();
 
@@ -278,7 +287,7 @@ bool SubByteReader::more_rbsp_data() const
   else if (posBits != 0)
   {
     // Check the remainder of the current byte
-    unsigned char c = this->byteVector[posBytes];
+    unsigned char c = this->data[posBytes];
     if (c & (1 << (7 - posBits)))
       terminatingBitFound = true;
     else
@@ -293,9 +302,9 @@ bool SubByteReader::more_rbsp_data() const
     }
     posBytes++;
   }
-  while (posBytes < (unsigned int)this->byteVector.size())
+  while (posBytes < (unsigned int)this->data.size())
   {
-    unsigned char c = this->byteVector[posBytes];
+    unsigned char c = this->data[posBytes];
     if (terminatingBitFound && c != 0)
       return true;
     else if (!terminatingBitFound && (c == 128))
@@ -329,13 +338,13 @@ bool SubByteReader::payload_extension_present() const
 
 bool SubByteReader::canReadBits(unsigned nrBits) const
 {
-  if (this->posInBufferBytes == this->byteVector.size())
+  if (this->posInBufferBytes == this->data.size())
     return false;
 
   assert(this->posInBufferBits <= 8);
   const auto curBitsLeft = 8 - this->posInBufferBits;
-  assert(this->byteVector.size() > this->posInBufferBytes);
-  const auto entireBytesLeft  = this->byteVector.size() - this->posInBufferBytes - 1;
+  assert(this->data.size() > this->posInBufferBytes);
+  const auto entireBytesLeft  = this->data.size() - this->posInBufferBytes - 1;
   const auto nrBitsLeftToRead = curBitsLeft + entireBytesLeft * 8;
 
   return nrBits <= nrBitsLeftToRead;
@@ -353,9 +362,9 @@ size_t SubByteReader::nrBytesRead() const
 
 size_t SubByteReader::nrBytesLeft() const
 {
-  if (this->byteVector.size() <= this->posInBufferBytes)
+  if (this->data.size() <= this->posInBufferBytes)
     return 0;
-  return this->byteVector.size() - this->posInBufferBytes - 1;
+  return this->data.size() - this->posInBufferBytes - 1;
 }
 
 ByteVector SubByteReader::peekBytes(unsigned nrBytes) const
@@ -367,19 +376,19 @@ ByteVector SubByteReader::peekBytes(unsigned nrBytes) const
   if (this->posInBufferBits == 8)
     pos++;
 
-  if (pos + nrBytes > this->byteVector.size())
+  if (pos + nrBytes > this->data.size())
     throw std::logic_error("Not enough data in the input to peek that far");
 
-  return ByteVector(this->byteVector.begin() + pos, this->byteVector.begin() + pos + nrBytes);
+  return ByteVector(this->data.begin() + pos, this->data.begin() + pos + nrBytes);
 }
 
 bool SubByteReader::gotoNextByte()
 {
   // Before we go to the neyt byte, check if the last (current) byte is a zero
   // byte.
-  if (this->posInBufferBytes >= unsigned(this->byteVector.size()))
+  if (this->posInBufferBytes >= unsigned(this->data.size()))
     throw std::out_of_range("Reading out of bounds");
-  if (this->byteVector[this->posInBufferBytes] == (char)0)
+  if (this->data[this->posInBufferBytes] == (char)0)
     this->numEmuPrevZeroBytes++;
 
   // Skip the remaining sub-byte-bits
@@ -387,18 +396,18 @@ bool SubByteReader::gotoNextByte()
   // Advance pointer
   this->posInBufferBytes++;
 
-  if (this->posInBufferBytes >= (unsigned int)this->byteVector.size())
+  if (this->posInBufferBytes >= (unsigned int)this->data.size())
     // The next byte is outside of the current buffer. Error.
     return false;
 
   if (this->skipEmulationPrevention)
   {
-    if (this->numEmuPrevZeroBytes == 2 && this->byteVector[this->posInBufferBytes] == (char)3)
+    if (this->numEmuPrevZeroBytes == 2 && this->data[this->posInBufferBytes] == (char)3)
     {
       // The current byte is an emulation prevention 3 byte. Skip it.
       this->posInBufferBytes++; // Skip byte
 
-      if (this->posInBufferBytes >= (unsigned int)this->byteVector.size())
+      if (this->posInBufferBytes >= (unsigned int)this->data.size())
       {
         // The next byte is outside of the current buffer. Error
         return false;
@@ -407,7 +416,7 @@ bool SubByteReader::gotoNextByte()
       // Reset counter
       this->numEmuPrevZeroBytes = 0;
     }
-    else if (this->byteVector[this->posInBufferBytes] != (char)0)
+    else if (this->data[this->posInBufferBytes] != (char)0)
       // No zero byte. No emulation prevention 3 byte
       this->numEmuPrevZeroBytes = 0;
   }
@@ -33,6 +33,7 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <tuple>
 
@@ -48,8 +49,11 @@ namespace parser
 class SubByteReader
 {
 public:
-  SubByteReader() = default;
-  SubByteReader(const ByteVector &inArr, size_t inArrOffset = 0);
+  SubByteReader();
+  // The reader only keeps a view of the data, so the data must outlive the reader (and all copies
+  // of it). Temporaries are moved into the reader instead.
+  SubByteReader(ByteSpan inArr, size_t inArrOffset = 0);
+  SubByteReader(ByteVector &&inArr, size_t inArrOffset = 0);
 
   [[nodiscard]] bool more_rbsp_data() const;
   [[nodiscard]] bool byte_aligned() const;
@@ -76,7 +80,9 @@ protected:
   std::tuple<uint64_t, std::string> readNS(uint64_t maxVal);
   std::tuple<int64_t, std::string>  readSU(unsigned nrBits);
 
-  ByteVector byteVector;
+  // Copies of the reader (e.g. for sub levels) share the data without copying it
+  std::shared_ptr<const ByteVector> ownedData;
+  ByteSpan                          data;
 
   bool skipEmulationPrevention{true};
 
@@ -111,24 +111,14 @@ void checkAndLog(std::shared_ptr<TreeItem> item,
 
 } // namespace
 
-ByteVector SubByteReaderLogging::convertToByteVector(QByteArray data)
+ByteVector SubByteReaderLogging::convertToByteVector(const QByteArray &data)
 {
-  ByteVector ret;
-  for (auto i = 0u; i < unsigned(data.size()); i++)
-  {
-    ret.push_back(data.at(i));
-  }
-  return ret;
+  return ByteVector(data.begin(), data.end());
 }
 
-QByteArray SubByteReaderLogging::convertToQByteArray(ByteVector data)
+QByteArray SubByteReaderLogging::convertToQByteArray(const ByteVector &data)
 {
-  QByteArray ret;
-  for (auto i = 0u; i < unsigned(data.size()); i++)
-  {
-    ret.append(data.at(i));
-  }
-  return ret;
+  return QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
 }
 
 SubByteReaderLogging::SubByteReaderLogging(SubByteReader &           reader,
@@ -145,7 +135,7 @@ SubByteReaderLogging::SubByteReaderLogging(SubByteReader &           reader,
   }
 }
 
-SubByteReaderLogging::SubByteReaderLogging(const ByteVector &        inArr,
+SubByteReaderLogging::SubByteReaderLogging(ByteSpan                  inArr,
                                            std::shared_ptr<TreeItem> item,
                                            std::string               new_sub_item_name,
                                            size_t                    inOffset)
@@ -160,6 +150,21 @@ SubByteReaderLogging::SubByteReaderLogging(const ByteVector &        inArr,
   }
 }
 
+SubByteReaderLogging::SubByteReaderLogging(ByteVector &&             inArr,
+                                           std::shared_ptr<TreeItem> item,
+                                           std::string               new_sub_item_name,
+                                           size_t                    inOffset)
+    : SubByteReader(std::move(inArr), inOffset)
+{
+  if (item)
+  {
+    if (new_sub_item_name.empty())
+      this->currentTreeLevel = item;
+    else
+      this->currentTreeLevel = item->createChildItem(new_sub_item_name);
+  }
+}
+
 void SubByteReaderLogging::addLogSubLevel(const std::string &name)
 {
   if (!this->currentTreeLevel)
@@ -58,15 +58,19 @@ public:
   SubByteReaderLogging(SubByteReader &           reader,
                        std::shared_ptr<TreeItem> item,
                        std::string               new_sub_item_name = "");
-  SubByteReaderLogging(const ByteVector &        inArr,
+  SubByteReaderLogging(ByteSpan                  inArr,
+                       std::shared_ptr<TreeItem> item,
+                       std::string               new_sub_item_name = "",
+                       size_t                    inOffset          = 0);
+  SubByteReaderLogging(ByteVector &&             inArr,
                        std::shared_ptr<TreeItem> item,
                        std::string               new_sub_item_name = "",
                        size_t                    inOffset          = 0);
 
   // DEPRECATED. This is just for backwards compatibility and will be removed once
   // everything is using std types.
-  static ByteVector convertToByteVector(QByteArray data);
-  static QByteArray convertToQByteArray(ByteVector data);
+  static ByteVector convertToByteVector(const QByteArray &data);
+  static QByteArray convertToQByteArray(const ByteVector &data);
 
   uint64_t readBits(const std::string &symbolName, size_t numBits, const Options &options = {});
   bool     readFlag(const std::string &symbolName, const Options &options = {});
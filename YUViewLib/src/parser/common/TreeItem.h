@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -42,8 +43,14 @@
 class TreeItem : public std::enable_shared_from_this<TreeItem>
 {
 public:
-  TreeItem()  = default;
-  ~TreeItem() = default;
+  TreeItem() { ++numberOfLiveItems; }
+  ~TreeItem() { --numberOfLiveItems; }
+  TreeItem(const TreeItem &) = delete;
+  TreeItem &operator=(const TreeItem &) = delete;
+
+  // The parsers can create millions of items. This count is used to estimate the memory usage of
+  // all trees.
+  static int64_t getNumberOfLiveItems() { return numberOfLiveItems; }
 
   void setProperties(std::string name    = {},
                      std::string value   = {},
@@ -166,4 +173,6 @@ private:
   bool error{};
   // This is set for the first layer items in case of AVPackets
   int streamIndex{-1};
+
+  static inline std::atomic<int64_t> numberOfLiveItems{0};
 };
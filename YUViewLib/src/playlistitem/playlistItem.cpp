@@ -36,6 +36,15 @@
 
 unsigned int playlistItem::idCounter = 0;
 
+namespace
+{
+
+// A followed file counts as still being written while it grew within this many checks of the
+// file. The items check their files once per second.
+constexpr unsigned FOLLOWED_FILE_MAX_CHECKS_WITHOUT_GROWTH = 5;
+
+} // namespace
+
 playlistItem::playlistItem(const QString &itemNameOrFileName, Type type)
 {
   this->setName(itemNameOrFileName);
@@ -199,3 +208,14 @@ void playlistItem::preparePropertiesWidget(const QString &name)
   this->propertiesWidget.reset(new QWidget);
   this->propertiesWidget->setObjectName(name);
 }
+
+void playlistItem::countFollowedFileCheck()
+{
+  if (this->followedFileChecksWithoutGrowth < std::numeric_limits<unsigned>::max())
+    this->followedFileChecksWithoutGrowth++;
+}
+
+bool playlistItem::hasFollowedFileGrownRecently() const
+{
+  return this->followedFileChecksWithoutGrowth < FOLLOWED_FILE_MAX_CHECKS_WITHOUT_GROWTH;
+}
@@ -42,6 +42,7 @@
 #include <QObject>
 #include <QTreeWidgetItem>
 
+#include <limits>
 #include <memory>
 
 #include "ui_playlistItem.h"
@@ -113,6 +114,15 @@ public:
 
   virtual Properties properties() const { return this->prop; };
 
+  // Is the startEndRange final? This is false while the frames of the file are still indexed in
+  // the background and the range may still grow.
+  virtual bool isFrameIndexComplete() const { return true; }
+  // Does the item follow a file that is still being written? New frames may then still be added
+  // at the end of the range and playback waits for them at the last frame. A followed file only
+  // counts as being written while it grew within the last few checks of the file. Otherwise
+  // playback of a finished file would wait forever.
+  virtual bool isFollowingGrowingFile() const { return false; }
+
   // Set the name of the item. This is also the name that is shown in the tree view
   void setName(const QString &name);
 
@@ -196,12 +206,17 @@ public:
   virtual bool isLoading() const { return false; }
   virtual bool isLoadingDoubleBuffer() const { return false; }
 
-  // If the needsLoading function returns LoadingNeededDoubleBuffer, this should activate the double
-  // buffer so that in the next draw operation it is drawn. This is done because loading of a new
-  // double buffer is triggered right after the call to this function. If the buffer is not
-  // activated first, it could be overwritten by the background loading process if the draw even is
-  // scheduled too late.
-  virtual void activateDoubleBuffer() {}
+  // If the needsLoading function returns LoadingNeededDoubleBuffer, this should take the given
+  // frame out of the render-ahead queue so that it is drawn in the next draw operation. This is
+  // done because loading of more frames into the queue is triggered right after the call to this
+  // function. If the frame is not activated first, it could be pushed out of the queue by the
+  // background loading process if the draw event is scheduled too late.
+  virtual void activateDoubleBuffer(int) {}
+
+  // Set the step between two frames during playback. The item will load the frames at
+  // frameIdx + step, frameIdx + 2 * step, ... into the render-ahead queue. A negative step is used
+  // for reverse playback and a step larger than one if playback skips frames.
+  virtual void setPlaybackStep(int step) { this->playbackStep = (step == 0) ? 1 : step; }
 
   // ----- Caching -----
 
@@ -228,6 +243,9 @@ public:
   // Remove the frame with the given index from the cache.
   virtual void removeFrameFromCache(int) {}
   virtual void removeAllFramesFromCache() {};
+  // When was the cached frame last shown? This is a counter that is shared by all items and
+  // increases with every access. 0 if unknown.
+  virtual uint64_t getCachedFrameLastAccess(int) const { return 0; }
 
   // ----- Detection of source/file change events -----
 
@@ -282,6 +300,9 @@ protected:
   // Is caching enabled for this item? This can be changed at any point.
   bool cachingEnabled{false};
 
+  // The step to the next frame during playback (see setPlaybackStep)
+  int playbackStep{1};
+
   // Item is being deleted. We might need to wait until all caching/loading jobs for the item are
   // finished before we can actually delete it. An item that is tagged for deletion should not be
   // cached/loaded anymore.
@@ -304,6 +325,12 @@ protected:
 
   Properties prop;
 
+  // Items that follow a growing file count how often the file was checked without it growing.
+  // Call countFollowedFileCheck for each check and resetFollowedFileChecks when the file grew.
+  void countFollowedFileCheck();
+  void resetFollowedFileChecks() { this->followedFileChecksWithoutGrowth = 0; }
+  bool hasFollowedFileGrownRecently() const;
+
 protected slots:
 
   // A control of the playlistitem (start/end/frameRate/sampling,duration) changed
@@ -319,6 +346,9 @@ private:
   QPointF savedCenterOffset[2];
   double  savedZoom[2]{1.0, 1.0};
 
+  // Until the file grows for the first time, it is not considered to be still written.
+  unsigned followedFileChecksWithoutGrowth{std::numeric_limits<unsigned>::max()};
+
   // The UI
   SafeUi<Ui::playlistItem> ui;
 };
@@ -41,11 +41,13 @@
 #include <common/Formatting.h>
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <common/Tracing.h>
 #include <common/YUViewDomElement.h>
 #include <decoder/decoderDav1d.h>
 #include <decoder/decoderFFmpeg.h>
 #include <decoder/decoderHM.h>
 #include <decoder/decoderLibde265.h>
+#include <decoder/decoderRemote.h>
 #include <decoder/decoderVTM.h>
 #include <decoder/decoderVVDec.h>
 #include <parser/AVC/ParserAnnexBAVC.h>
@@ -85,6 +87,11 @@ bool isInputFormatTypeFFmpeg(InputFormat format)
   return format == InputFormat::Libav;
 }
 
+bool isInputFormatTypeAV1(InputFormat format)
+{
+  return format == InputFormat::AV1OBU;
+}
+
 enum class Codec
 {
   AV1,
@@ -93,6 +100,87 @@ enum class Codec
   Other
 };
 
+// The maximum amount of memory that the backward decode buffer may use for one GOP pass. If a GOP
+// is larger, only the frames closest to the playhead are kept.
+constexpr int64_t BACKWARD_DECODE_BUFFER_SIZE_BYTES = 1024 * 1024 * 1024;
+
+// The maximum amount of memory for the statistics of frames that are not shown right now
+constexpr int64_t STATISTICS_CACHE_SIZE_BYTES = 512 * 1024 * 1024;
+
+// Inside of long GOPs of AnnexB streams, the interactive decoder is parked at most once per
+// interval of this many frames (in coding order from the random access point). Seeking into the GOP
+// then only has to decode from the closest parked decoder. A parked decoder keeps all of its
+// reference pictures so only a few of them are kept.
+constexpr unsigned CHECKPOINT_INTERVAL     = 16;
+constexpr size_t   MAX_DECODER_CHECKPOINTS = 4;
+
+// The maximum amount of memory for frames that the parallel GOP decoder decoded ahead of the
+// caching threads
+constexpr int64_t GOP_DECODE_BUFFER_SIZE_BYTES = 512 * 1024 * 1024;
+
+// The reference decoders (HM and VTM) keep global state. Their caching decoder runs in a decoder
+// host process (if enabled and available) so that it does not interfere with the interactive
+// decoder and so that several items can be cached in parallel.
+template <typename DecoderType>
+std::unique_ptr<decoder::decoderBase> createReferenceCachingDecoder(const DecoderEngine engine,
+                                                                    const int displayComponent)
+{
+  QSettings  settings;
+  const auto useDecoderHost = settings.value("Decoders/UseDecoderHost", true).toBool();
+  if (useDecoderHost)
+    if (auto remoteDecoder = decoder::decoderRemote::create(engine, displayComponent, true))
+      return remoteDecoder;
+  return std::make_unique<DecoderType>(displayComponent, true);
+}
+
+// Reads the NAL units of the GOPs for one decoder of the parallel GOP decoder. Every reader opens
+// the file itself. The parser belongs to the item and is only used while holding the parser lock.
+class AnnexBGOPReader : public decoder::ParallelGOPDecoder::BitstreamReader
+{
+public:
+  AnnexBGOPReader(const std::filesystem::path          &filePath,
+                  std::unique_ptr<parser::ParserAnnexB> &parser,
+                  QReadWriteLock                        &parserLock)
+      : file(filePath), parser(parser), parserLock(parserLock)
+  {
+  }
+
+  std::optional<QByteArrayList> seekToGOP(const decoder::ParallelGOPDecoder::GOP &gop) override
+  {
+    QReadLocker parserLocker(&this->parserLock);
+    const auto  seekData = this->parser->getSeekData(gop.firstFrame);
+    if (!seekData || !this->file.seek(int64_t(seekData->filePos.value_or(0))))
+      return {};
+
+    QByteArrayList parameterSets;
+    for (const auto &parameterSet : seekData->parameterSets)
+      parameterSets.push_back(
+          parser::reader::SubByteReaderLogging::convertToQByteArray(parameterSet));
+    return parameterSets;
+  }
+
+  QByteArray getNextUnit(bool getLastUnitAgain) override
+  {
+    return this->file.getNextNALUnit(getLastUnitAgain);
+  }
+
+private:
+  FileSourceAnnexBFile                   file;
+  std::unique_ptr<parser::ParserAnnexB> &parser;
+  QReadWriteLock                        &parserLock;
+};
+
+std::unique_ptr<parser::ParserAnnexB> createAnnexBParser(InputFormat format)
+{
+  if (format == InputFormat::AnnexBHEVC)
+    return std::make_unique<parser::ParserAnnexBHEVC>();
+  if (format == InputFormat::AnnexBVVC)
+    return std::make_unique<parser::ParserAnnexBVVC>();
+  if (format == InputFormat::AnnexBAVC)
+    return std::make_unique<parser::ParserAnnexBAVC>();
+  return {};
+}
+
 } // namespace
 
 // When decoding, it can make sense to seek forward to another random access point.
@@ -118,6 +206,10 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
 
   // An compressed file can be cached if nothing goes wrong
   this->cachingEnabled = true;
+  this->backwardDecodeBuffer.setMaxBytes(BACKWARD_DECODE_BUFFER_SIZE_BYTES);
+  this->frameStatisticsCache.setMaxBytes(STATISTICS_CACHE_SIZE_BYTES);
+  this->decoderCheckpoints.setMaxCheckpoints(MAX_DECODER_CHECKPOINTS);
+  this->updateSettings();
 
   // Open the input file and get some properties (size, bit depth, subsampling) from the file
   if (input == InputFormat::Invalid)
@@ -129,6 +221,11 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
       this->inputFormat = InputFormat::AnnexBVVC;
     else if (ext == "avc" || ext == "h264" || ext == "264")
       this->inputFormat = InputFormat::AnnexBAVC;
+    else if (ext == "obu" || ext == "av1" ||
+             (ext == "ivf" &&
+              FileSourceAV1OBUFile::detectFileFormat(compressedFilePath.toStdString()) ==
+                  FileSourceAV1OBUFile::FileFormat::IVF))
+      this->inputFormat = InputFormat::AV1OBU;
     else
       this->inputFormat = InputFormat::Libav;
   }
@@ -153,27 +250,34 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     if (this->inputFormat == InputFormat::AnnexBHEVC)
     {
       DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Type is HEVC");
-      this->inputFileAnnexBParser = std::make_unique<parser::ParserAnnexBHEVC>();
+      this->inputFileAnnexBParser = createAnnexBParser(this->inputFormat);
       this->ffmpegCodec.setTypeHEVC();
       codec = Codec::HEVC;
     }
     else if (this->inputFormat == InputFormat::AnnexBVVC)
     {
       DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Type is VVC");
-      this->inputFileAnnexBParser = std::make_unique<parser::ParserAnnexBVVC>();
+      this->inputFileAnnexBParser = createAnnexBParser(this->inputFormat);
       codec                       = Codec::VVC;
     }
     else if (this->inputFormat == InputFormat::AnnexBAVC)
     {
       DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Type is AVC");
-      this->inputFileAnnexBParser = std::make_unique<parser::ParserAnnexBAVC>();
+      this->inputFileAnnexBParser = createAnnexBParser(this->inputFormat);
       this->ffmpegCodec.setTypeAVC();
       codec = Codec::Other;
     }
 
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Start parsing of file");
-    this->inputFileAnnexBParser->parseAnnexBFile(this->inputFileAnnexBLoading, mainWindow);
+    // If the file may still be written, its last NAL unit may be incomplete and must not be parsed
+    // yet. The parser can only resume at the start of a NAL unit so this must be known before the
+    // file is parsed for the first time.
+    this->followGrowingFile = QSettings().value("FollowGrowingFiles", false).toBool();
+    this->inputFileAnnexBParser->parseAnnexBFile(
+        this->inputFileAnnexBLoading, mainWindow, this->followGrowingFile);
+    this->followedFileSize = this->inputFileAnnexBLoading->getFileSize().value_or(0);
+    this->updateFollowGrowingFileSetting();
 
     // Get the frame size and the pixel format
     frameSize = this->inputFileAnnexBParser->getSequenceSizeSamples();
@@ -194,13 +298,51 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
         "playlistItemCompressedVideo::playlistItemCompressedVideo sample aspect ratio ("
         << this->prop.sampleAspectRatio.num << "," << this->prop.sampleAspectRatio.den << ")");
   }
+  else if (isInputFormatTypeAV1(this->inputFormat))
+  {
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Open AV1 file");
+    const auto filePath       = std::filesystem::path(compressedFilePath.toStdString());
+    this->inputFileAV1Loading = std::make_unique<FileSourceAV1OBUFile>();
+    if (!this->inputFileAV1Loading->openFile(filePath))
+    {
+      this->setError("Error opening raw AV1 file.");
+      return;
+    }
+    if (this->cachingEnabled)
+    {
+      this->inputFileAV1Caching = std::make_unique<FileSourceAV1OBUFile>();
+      if (!this->inputFileAV1Caching->openFile(filePath, *this->inputFileAV1Loading))
+      {
+        this->setError("Error opening raw AV1 file a second time for caching.");
+        return;
+      }
+    }
+    this->ffmpegCodec.setTypeAV1();
+    codec = Codec::AV1;
+
+    const auto nrFrames      = int(this->inputFileAV1Loading->getNumberFrames());
+    frameSize                = this->inputFileAV1Loading->getSequenceSizeSamples();
+    formatYuv                = this->inputFileAV1Loading->getPixelFormatYUV();
+    this->rawFormat          = video::RawFormat::YUV;
+    this->prop.frameRate     = this->inputFileAV1Loading->getFramerate();
+    this->prop.startEndRange = indexRange(0, nrFrames - 1);
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo AV1 frame size "
+                     << frameSize.width << "x" << frameSize.height << " frames "
+                     << this->inputFileAV1Loading->getNumberFrames());
+  }
   else
   {
     // Try ffmpeg to open the file
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Open file using ffmpeg");
     this->inputFileFFmpegLoading = std::make_unique<FileSourceFFmpegFile>();
-    if (!this->inputFileFFmpegLoading->openFile(compressedFilePath, mainWindow))
+    // The frame index may still grow while the file is scanned in the background. The scan starts
+    // in openFile so the signal must be connected before.
+    this->connect(this->inputFileFFmpegLoading.get(),
+                  &FileSourceFFmpegFile::signalFrameIndexChanged,
+                  this,
+                  &playlistItemCompressedVideo::updateFrameLimitsFromFile);
+    if (!this->inputFileFFmpegLoading->openFile(compressedFilePath))
     {
       this->setError("Error opening file using libavcodec.");
       return;
@@ -249,8 +391,8 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     {
       // Open the file again for caching
       this->inputFileFFmpegCaching = std::make_unique<FileSourceFFmpegFile>();
-      if (!this->inputFileFFmpegCaching->openFile(
-              compressedFilePath, mainWindow, this->inputFileFFmpegLoading.get()))
+      if (!this->inputFileFFmpegCaching->openFile(compressedFilePath,
+                                                  this->inputFileFFmpegLoading.get()))
       {
         this->setError("Error opening file a second time using libavcodec for caching.");
         return;
@@ -372,7 +514,7 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   // extradata to the decoder)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Seek decoders to 0");
   this->seekToPosition(0, 0, false);
-  if (this->cachingEnabled)
+  if (this->cachingDecoder)
     this->seekToPosition(0, 0, true);
 
   // Connect signals for requesting data and statistics
@@ -381,6 +523,20 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
                 this,
                 &playlistItemCompressedVideo::loadRawData,
                 Qt::DirectConnection);
+  // With the parallel GOP decoder, the caching threads get the frames from it in parallel
+  this->video->setConcurrentRawDataReader([this](int frameIdx) -> std::optional<QByteArray> {
+    if (!this->parallelGOPDecoder)
+      return {};
+    const auto retrieveStatistics =
+        this->loadingDecoder && this->loadingDecoder->statisticsEnabled();
+    this->parallelGOPDecoder->setRetrieveStatistics(retrieveStatistics);
+    auto frame = this->parallelGOPDecoder->getFrame(frameIdx);
+    if (!frame)
+      return QByteArray();
+    if (frame->statistics)
+      this->frameStatisticsCache.addFrame(frameIdx, std::move(*frame->statistics));
+    return frame->data;
+  });
   this->connect(&this->statisticsUIHandler,
                 &stats::StatisticUIHandler::updateItem,
                 this,
@@ -611,11 +767,19 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     else
       return;
   }
-  if (caching && this->cachingDecoder->state() == decoder::DecoderState::Error)
+  if (caching && (!this->cachingDecoder ||
+                  this->cachingDecoder->state() == decoder::DecoderState::Error))
     return;
 
+  // The parser must not be modified by the tail mode while the frame is decoded. Loading a frame
+  // (loadFrame) already holds the lock. Caching and exporting frames end up here directly.
+  std::optional<QReadLocker> parserLocker;
+  if (caching)
+    parserLocker.emplace(&this->parserLock);
+
   DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx
                                                                << (caching ? " caching" : ""));
+  TRACE_SCOPE("decoder", "playlistItemCompressedVideo::loadRawData", frameIdx);
 
   if (frameIdx > this->properties().startEndRange.second || frameIdx < 0)
   {
@@ -623,10 +787,43 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     return;
   }
 
+  // In reverse playback, the interactive decoder decodes the whole GOP in one pass and keeps the
+  // frames in the backward decode buffer. Statistics are only available for the frame that was just
+  // decoded so in this case we have to decode the frame again.
+  const auto useBackwardBuffer = !caching && this->playbackStep < 0 &&
+                                 !this->loadingDecoder->statisticsEnabled();
+  if (useBackwardBuffer)
+  {
+    if (auto bufferedFrame = this->backwardDecodeBuffer.getFrame(frameIdx))
+    {
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData frame "
+                       << frameIdx << " from backward decode buffer");
+      this->video->rawData            = *bufferedFrame;
+      this->video->rawData_frameIndex = frameIdx;
+      return;
+    }
+  }
+
   // Get the right decoder
-  const auto dec         = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
+  auto dec = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
+
+  // Once statistics are shown, the caching decoder also retrieves them. The decoder has to start
+  // decoding again from a random access point for this.
+  if (caching && dec->statisticsSupported() && !dec->statisticsEnabled() &&
+      this->loadingDecoder->statisticsEnabled())
+  {
+    dec->enableStatisticsRetrieval(&this->cachingStatisticsData);
+    this->currentFrameIdx[1] = -1;
+  }
+
   const auto curFrameIdx = caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0];
 
+  // The interactive decoder can be parked in long GOPs and resumed from there. Statistics are only
+  // retrieved for the frames after enabling them so this is not possible with statistics.
+  const auto useDecoderCheckpoints = !caching && this->decoderCheckpointsEnabled &&
+                                     isInputFormatTypeAnnexB(this->inputFormat) &&
+                                     !dec->statisticsEnabled();
+
   // Should we seek?
   if (curFrameIdx == -1 || frameIdx < curFrameIdx ||
       frameIdx > curFrameIdx + FORWARD_SEEK_THRESHOLD)
@@ -637,13 +834,41 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     // Get the closest possible seek position
     size_t  seekToFrame = 0;
     int64_t seekToDTS   = -1;
+    // For AnnexB, the frame counter of the file reader counts frames in coding order
+    std::optional<int> seekToCodingIndex;
     if (isInputFormatTypeAnnexB(this->inputFormat))
     {
-      auto curIdx   = unsigned(std::max(curFrameIdx, 0));
-      auto seekInfo = this->inputFileAnnexBParser->getClosestSeekPoint(unsigned(frameIdx), curIdx);
-      if (seekInfo.frameDistanceInCodingOrder > FORWARD_SEEK_THRESHOLD)
+      // Only seek forward if decoding from the seek point is cheaper than just decoding on. Within
+      // the same GOP, the decoder can keep its state.
+      std::optional<unsigned> curIdx;
+      if (curFrameIdx >= 0)
+        curIdx = unsigned(curFrameIdx);
+      const auto seekInfo =
+          this->inputFileAnnexBParser->getClosestSeekPoint(unsigned(frameIdx), curIdx);
+      if (!seekInfo.decodeCostFromCurrentFrame ||
+          seekInfo.decodeCost + FORWARD_SEEK_THRESHOLD < *seekInfo.decodeCostFromCurrentFrame)
+        seek = true;
+      seekToFrame       = seekInfo.frameIndex;
+      seekToCodingIndex = int(seekInfo.codingIndex);
+
+      // A parked decoder may be closer to the target frame than the seek point and the current
+      // position of the decoder.
+      const auto maxDecodeCost =
+          seek ? seekInfo.decodeCost : seekInfo.decodeCostFromCurrentFrame.value_or(0);
+      if (useDecoderCheckpoints &&
+          this->resumeLoadingDecoderFromCheckpoint(frameIdx, maxDecodeCost))
+      {
+        seek = false;
+        dec  = this->loadingDecoder.get();
+      }
+    }
+    else if (isInputFormatTypeAV1(this->inputFormat))
+    {
+      if (const auto seekPoint =
+              this->inputFileAV1Loading->getClosestSeekableFrameBefore(frameIdx))
+        seekToFrame = seekPoint->frame;
+      if (seekToFrame > unsigned(curFrameIdx) + FORWARD_SEEK_THRESHOLD)
         seek = true;
-      seekToFrame = seekInfo.frameIndex;
     }
     else
     {
@@ -665,11 +890,19 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     {
       // Seek and update the frame counters. The seekToPosition function will update the
       // currentFrameIdx[] indices
-      this->readAnnexBFrameCounterCodingOrder = int(seekToFrame);
+      this->readAnnexBFrameCounterCodingOrder = seekToCodingIndex.value_or(int(seekToFrame));
       DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData seeking to frame "
                        << seekToFrame << " PTS " << seekToDTS << " AnnexBCnt "
                        << this->readAnnexBFrameCounterCodingOrder);
-      this->seekToPosition(this->readAnnexBFrameCounterCodingOrder, seekToDTS, caching);
+      const auto decodeSignal = dec->getDecodeSignal();
+      if (useDecoderCheckpoints && this->parkLoadingDecoder())
+      {
+        // Continue with a decoder that is not parked anymore or with a new one
+        if (!this->loadingDecoder)
+          this->loadingDecoder = this->createDecoder(decodeSignal, false);
+        dec = this->loadingDecoder.get();
+      }
+      this->seekToPosition(int(seekToFrame), seekToDTS, caching);
     }
   }
 
@@ -680,6 +913,7 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
   {
     while (dec->state() == decoder::DecoderState::NeedsMoreData)
     {
+      TRACE_SCOPE("decoder", "pushData");
       DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder needs more data");
       if (isInputFormatTypeFFmpeg(this->inputFormat) &&
           this->decoderEngine == DecoderEngine::FFMpeg)
@@ -762,6 +996,16 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
             << data.size());
         this->repushData = !dec->pushData(data);
       }
+      else if (isInputFormatTypeAV1(this->inputFormat))
+      {
+        // Push one temporal unit (all OBUs of one frame) to the decoder
+        auto data = caching ? this->inputFileAV1Caching->getNextTemporalUnit(repushData)
+                            : this->inputFileAV1Loading->getNextTemporalUnit(repushData);
+        DEBUG_COMPRESSED(
+            "playlistItemCompressedVideo::loadRawData retrieved temporal unit from file - size "
+            << data.size());
+        this->repushData = !dec->pushData(data);
+      }
       else if (isInputFormatTypeFFmpeg(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
@@ -779,6 +1023,7 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
 
     if (dec->state() == decoder::DecoderState::RetrieveFrames)
     {
+      TRACE_SCOPE("decoder", "decodeNextFrame");
       if (dec->decodeNextFrame())
       {
         if (caching)
@@ -788,14 +1033,28 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
 
         DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoded frame "
                          << (caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0]));
+        if (useBackwardBuffer)
+          this->backwardDecodeBuffer.addFrame(this->currentFrameIdx[0], dec->getRawFrameData());
+        const auto decodedFrameIdx = caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0];
+        if (caching && dec->statisticsEnabled())
+        {
+          // Getting the frame data also retrieves the statistics of the frame from the decoder
+          this->cachingStatisticsData.setFrameData(decodedFrameIdx, {});
+          dec->getRawFrameData();
+          this->frameStatisticsCache.addFrame(decodedFrameIdx,
+                                              this->cachingStatisticsData.getFrameData());
+        }
         rightFrame =
             caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
         if (rightFrame)
         {
-          if (dec->statisticsEnabled())
+          const auto retrieveStatistics = !caching && dec->statisticsEnabled();
+          if (retrieveStatistics)
             this->statisticsData.setFrameIndex(frameIdx);
           this->video->rawData            = dec->getRawFrameData();
           this->video->rawData_frameIndex = frameIdx;
+          if (retrieveStatistics)
+            this->frameStatisticsCache.addFrame(frameIdx, this->statisticsData.getFrameData());
         }
       }
     }
@@ -832,6 +1091,118 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
   }
 }
 
+void playlistItemCompressedVideo::updateSettings()
+{
+  playlistItemWithVideo::updateSettings();
+  if (this->inputFileAnnexBLoading)
+    this->inputFileAnnexBLoading->updateFileWatchSetting();
+  if (this->inputFileAV1Loading)
+    this->inputFileAV1Loading->updateFileWatchSetting();
+  if (this->inputFileFFmpegLoading)
+    this->inputFileFFmpegLoading->updateFileWatchSetting();
+  this->updateFollowGrowingFileSetting();
+
+  QSettings settings;
+  this->decoderCheckpointsEnabled = settings.value("Decoders/DecoderCheckpoints", true).toBool();
+  if (!this->decoderCheckpointsEnabled)
+    this->decoderCheckpoints.clear();
+}
+
+void playlistItemCompressedVideo::updateFollowGrowingFileSetting()
+{
+  this->followGrowingFile = QSettings().value("FollowGrowingFiles", false).toBool();
+  if (this->followGrowingFile && this->inputFileAnnexBParser)
+    this->followFileTimer.start(1000, this);
+  else
+    this->followFileTimer.stop();
+}
+
+bool playlistItemCompressedVideo::updateFromGrowingFile()
+{
+  const auto fileSize = this->inputFileAnnexBLoading->getFileSize().value_or(0);
+  if (fileSize < this->followedFileSize)
+  {
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::updateFromGrowingFile File was truncated");
+    this->followedFileTruncated = true;
+    return false;
+  }
+  if (fileSize > this->followedFileSize)
+    this->resetFollowedFileChecks();
+  if (!this->inputFileAnnexBParser->hasUnparsedData(fileSize))
+    return true;
+
+  // Don't block. If a frame is decoded right now, try again with the next check.
+  if (!this->parserLock.tryLockForWrite())
+    return true;
+
+  // While the file grows, the last NAL unit may still be incomplete. Once the file did not grow
+  // between two checks, the last NAL unit is parsed as well.
+  const auto fileGrew       = fileSize > this->followedFileSize;
+  const auto nrFramesBefore = this->inputFileAnnexBParser->getNumberPOCs();
+  this->followedFileSize    = fileSize;
+
+  const auto firstChangedFrame = this->inputFileAnnexBParser->resumeParsingAnnexBFile(
+      this->inputFileAnnexBLoading->getAbsoluteFilePath(), fileGrew);
+  if (!firstChangedFrame)
+  {
+    this->parserLock.unlock();
+    return true;
+  }
+
+  // Decoders that reached the end of the bitstream before must seek to continue decoding
+  if (this->loadingDecoder &&
+      this->loadingDecoder->state() == decoder::DecoderState::EndOfBitstream)
+    this->currentFrameIdx[0] = -1;
+  if (this->cachingDecoder &&
+      this->cachingDecoder->state() == decoder::DecoderState::EndOfBitstream)
+    this->currentFrameIdx[1] = -1;
+  this->decodingNotPossibleAfter = -1;
+
+  const auto frameOrderChanged = int(*firstChangedFrame) < int(nrFramesBefore);
+  if (frameOrderChanged)
+  {
+    // New frames were inserted in display order. The indices of the frames after the inserted
+    // frames changed. All frames before stay valid.
+    const auto firstChangedIdx = int(*firstChangedFrame);
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::updateFromGrowingFile Frame order changed at "
+                     << firstChangedIdx);
+    this->video->invalidateBuffersFrom(firstChangedIdx);
+    this->backwardDecodeBuffer.removeFramesFrom(firstChangedIdx);
+    if (this->parallelGOPDecoder)
+      this->parallelGOPDecoder->clear();
+    this->decoderCheckpoints.clear();
+    this->frameStatisticsCache.removeFramesFrom(firstChangedIdx);
+    for (auto &frameIdx : this->currentFrameIdx)
+      if (frameIdx >= firstChangedIdx)
+        frameIdx = -1;
+  }
+
+  this->prop.startEndRange = indexRange(0, int(this->inputFileAnnexBParser->getNumberPOCs() - 1));
+  this->parserLock.unlock();
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::updateFromGrowingFile startEndRange (0,"
+                   << this->inputFileAnnexBParser->getNumberPOCs() << ")");
+  emit SignalItemChanged(frameOrderChanged, RECACHE_UPDATE);
+  return true;
+}
+
+void playlistItemCompressedVideo::timerEvent(QTimerEvent *event)
+{
+  if (event->timerId() != this->followFileTimer.timerId())
+    return playlistItemWithVideo::timerEvent(event);
+
+  this->countFollowedFileCheck();
+  if (!this->updateFromGrowingFile())
+    this->followFileTimer.stop();
+}
+
+void playlistItemCompressedVideo::setPlaybackStep(int step)
+{
+  playlistItemWithVideo::setPlaybackStep(step);
+  if (step > 0)
+    this->backwardDecodeBuffer.clear();
+}
+
 void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching)
 {
   // Do the seek
@@ -842,7 +1213,7 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
 
   // Retrieval of the raw metadata is only required if the the reader or the decoder is not ffmpeg
   const bool bothFFmpeg =
-      (!isInputFormatTypeAnnexB(this->inputFormat) && this->decoderEngine == DecoderEngine::FFMpeg);
+      (isInputFormatTypeFFmpeg(this->inputFormat) && this->decoderEngine == DecoderEngine::FFMpeg);
   const bool decFFmpeg = (this->decoderEngine == DecoderEngine::FFMpeg);
 
   QByteArrayList parametersets;
@@ -872,6 +1243,16 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
     else
       this->inputFileAnnexBLoading->seek(filePos);
   }
+  else if (isInputFormatTypeAV1(this->inputFormat))
+  {
+    // Decoding starts at a key frame. The sequence header must be pushed before it.
+    auto file = caching ? this->inputFileAV1Caching.get() : this->inputFileAV1Loading.get();
+    if (!bothFFmpeg)
+      parametersets.push_back(file->getSequenceHeader(size_t(seekToFrame)));
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking AV1 file to frame "
+                     << seekToFrame);
+    file->seekToFrame(size_t(seekToFrame));
+  }
   else
   {
     if (!bothFFmpeg)
@@ -906,6 +1287,64 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
     this->currentFrameIdx[0] = seekToFrame - 1;
 }
 
+bool playlistItemCompressedVideo::parkLoadingDecoder()
+{
+  // Only decoders deep inside of a long GOP are worth parking. The reader must continue at the next
+  // NAL unit or frame.
+  const auto frameIdx = this->currentFrameIdx[0];
+  if (frameIdx < 0 || this->repushData ||
+      this->loadingDecoder->state() == decoder::DecoderState::Error)
+    return false;
+  const auto readsNALUnits = this->decoderEngine != DecoderEngine::FFMpeg;
+  if (readsNALUnits && this->inputFileAnnexBLoading->atEnd())
+    return false;
+  const auto entry = this->inputFileAnnexBParser->getSeekIndexEntry(unsigned(frameIdx));
+  if (!entry || entry->decodeCost < CHECKPOINT_INTERVAL)
+    return false;
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::parkLoadingDecoder frame " << frameIdx);
+
+  decoder::DecoderCheckpoints::Checkpoint checkpoint;
+  checkpoint.decoder                     = std::move(this->loadingDecoder);
+  checkpoint.frameIdx                    = frameIdx;
+  checkpoint.filePos                     = this->inputFileAnnexBLoading->getNextNALUnitPos();
+  checkpoint.readFrameCounterCodingOrder = this->readAnnexBFrameCounterCodingOrder;
+
+  const auto key = decoder::DecoderCheckpoints::Key(entry->seekPointCodingIndex,
+                                                    entry->decodeCost / CHECKPOINT_INTERVAL);
+  if (auto droppedCheckpoint = this->decoderCheckpoints.park(key, std::move(checkpoint)))
+    this->loadingDecoder = std::move(droppedCheckpoint->decoder);
+  this->currentFrameIdx[0] = -1;
+  return true;
+}
+
+bool playlistItemCompressedVideo::resumeLoadingDecoderFromCheckpoint(int      frameIdx,
+                                                                     unsigned maxDecodeCost)
+{
+  auto checkpoint = this->decoderCheckpoints.take(
+      [this, frameIdx](int checkpointFrameIdx) {
+        return this->inputFileAnnexBParser->getDecodeCostFromFrame(unsigned(checkpointFrameIdx),
+                                                                   unsigned(frameIdx));
+      },
+      maxDecodeCost);
+  if (!checkpoint)
+    return false;
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::resumeLoadingDecoderFromCheckpoint frame "
+                   << checkpoint->frameIdx << " for frame " << frameIdx);
+
+  // The current decoder may be worth parking itself. Otherwise it is not needed anymore.
+  this->parkLoadingDecoder();
+
+  this->loadingDecoder                    = std::move(checkpoint->decoder);
+  this->currentFrameIdx[0]                = checkpoint->frameIdx;
+  this->readAnnexBFrameCounterCodingOrder = checkpoint->readFrameCounterCodingOrder;
+  this->repushData                        = false;
+  if (this->decoderEngine != DecoderEngine::FFMpeg)
+    this->inputFileAnnexBLoading->seek(int64_t(checkpoint->filePos));
+  return true;
+}
+
 void playlistItemCompressedVideo::createPropertiesWidget()
 {
   Q_ASSERT_X(!this->propertiesWidget, "createPropertiesWidget", "Properties widget already exists");
@@ -967,68 +1406,75 @@ bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
   // Reset (existing) decoders
   this->loadingDecoder.reset();
   this->cachingDecoder.reset();
+  this->parallelGOPDecoder.reset();
+  this->decoderCheckpoints.clear();
 
+  this->loadingDecoder = this->createDecoder(displayComponent, false);
+  if (!this->loadingDecoder)
+  {
+    this->infoText        = "No valid decoder was selected.";
+    this->decodingEnabled = false;
+    return false;
+  }
+  if (this->cachingEnabled)
+  {
+    this->parallelGOPDecoder = this->createParallelGOPDecoder(displayComponent);
+    if (!this->parallelGOPDecoder)
+      this->cachingDecoder = this->createDecoder(displayComponent, true);
+  }
+
+  this->decodingEnabled = this->loadingDecoder->state() != decoder::DecoderState::Error;
+  if (!decodingEnabled)
+  {
+    this->infoText = "There was an error allocating the new decoder: \n";
+    this->infoText += loadingDecoder->decoderErrorString();
+    this->infoText += "\n";
+    return false;
+  }
+
+  return true;
+}
+
+std::unique_ptr<decoder::decoderBase>
+playlistItemCompressedVideo::createDecoder(int displayComponent, bool cachingDecoder) const
+{
   if (this->decoderEngine == DecoderEngine::Libde265)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive libde265 decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder Initializing caching libde265 decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " libde265 decoder");
+    return std::make_unique<decoder::decoderLibde265>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::HM)
+  if (this->decoderEngine == DecoderEngine::HM)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive HM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderHM>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive HM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderHM>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " HM decoder");
+    if (cachingDecoder)
+      return createReferenceCachingDecoder<decoder::decoderHM>(DecoderEngine::HM,
+                                                                displayComponent);
+    return std::make_unique<decoder::decoderHM>(displayComponent);
   }
-  else if (this->decoderEngine == DecoderEngine::VTM)
+  if (this->decoderEngine == DecoderEngine::VTM)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive VTM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive VTM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " VTM decoder");
+    if (cachingDecoder)
+      return createReferenceCachingDecoder<decoder::decoderVTM>(DecoderEngine::VTM,
+                                                                 displayComponent);
+    return std::make_unique<decoder::decoderVTM>(displayComponent);
   }
-  else if (this->decoderEngine == DecoderEngine::VVDec)
+  if (this->decoderEngine == DecoderEngine::VVDec)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive VVDec decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive VVDec decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " VVDec decoder");
+    return std::make_unique<decoder::decoderVVDec>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::Dav1d)
+  if (this->decoderEngine == DecoderEngine::Dav1d)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive dav1d decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive dav1d decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " dav1d decoder");
+    return std::make_unique<decoder::decoderDav1d>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::FFMpeg)
+  if (this->decoderEngine == DecoderEngine::FFMpeg)
   {
     if (isInputFormatTypeAnnexB(this->inputFormat))
     {
@@ -1038,55 +1484,84 @@ bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
       auto profileLevel = this->inputFileAnnexBParser->getProfileLevel();
       auto ratio        = this->inputFileAnnexBParser->getSampleAspectRatio();
 
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
-                       "ffmpeg decoder from raw anexB stream. frameSize "
-                       << frameSize.width << "x" << frameSize.height << " extradata length "
-                       << extradata.length() << " PixelFormatYUV "
-                       << QString::fromStdString(fmt.getName()) << " profile/level "
-                       << profileLevel.first << "/" << profileLevel.second << ", aspect raio "
-                       << ratio.num << "/" << ratio.den);
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio);
-      if (this->cachingEnabled)
-      {
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
-                         "decoder from raw anexB stream. Same settings.");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, true);
-      }
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                       << (cachingDecoder ? "caching" : "interactive")
+                       << " ffmpeg decoder from raw anexB stream. frameSize " << frameSize.width
+                       << "x" << frameSize.height << " extradata length " << extradata.length()
+                       << " PixelFormatYUV " << QString::fromStdString(fmt.getName())
+                       << " profile/level " << profileLevel.first << "/" << profileLevel.second
+                       << ", aspect raio " << ratio.num << "/" << ratio.den);
+      return std::make_unique<decoder::decoderFFmpeg>(
+          this->ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, cachingDecoder);
     }
-    else
+    if (isInputFormatTypeAV1(this->inputFormat))
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
-                       "ffmpeg decoder using ffmpeg as parser");
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          this->inputFileFFmpegLoading->getVideoCodecPar());
-      if (this->cachingEnabled)
-      {
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
-                         "decoder using ffmpeg as parser");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            this->inputFileFFmpegCaching->getVideoCodecPar());
-      }
+      // The sequence header is passed to ffmpeg as the extradata
+      const auto frameSize    = this->inputFileAV1Loading->getSequenceSizeSamples();
+      const auto extradata    = this->inputFileAV1Loading->getSequenceHeader();
+      const auto fmt          = this->inputFileAV1Loading->getPixelFormatYUV();
+      const auto profileLevel = this->inputFileAV1Loading->getProfileLevel();
+      const auto ratio        = Ratio({1, 1});
+
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                       << (cachingDecoder ? "caching" : "interactive")
+                       << " ffmpeg decoder from raw AV1 stream. frameSize "
+                       << frameSize.width << "x" << frameSize.height);
+      return std::make_unique<decoder::decoderFFmpeg>(
+          this->ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, cachingDecoder);
     }
-  }
-  else
-  {
-    this->infoText        = "No valid decoder was selected.";
-    this->decodingEnabled = false;
-    return false;
-  }
 
-  this->decodingEnabled = this->loadingDecoder->state() != decoder::DecoderState::Error;
-  if (!decodingEnabled)
-  {
-    this->infoText = "There was an error allocating the new decoder: \n";
-    this->infoText += loadingDecoder->decoderErrorString();
-    this->infoText += "\n";
-    return false;
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive")
+                     << " ffmpeg decoder using ffmpeg as parser");
+    const auto &inputFile =
+        cachingDecoder ? this->inputFileFFmpegCaching : this->inputFileFFmpegLoading;
+    return std::make_unique<decoder::decoderFFmpeg>(inputFile->getVideoCodecPar());
   }
 
-  return true;
+  return {};
+}
+
+std::unique_ptr<decoder::ParallelGOPDecoder>
+playlistItemCompressedVideo::createParallelGOPDecoder(int displayComponent)
+{
+  const auto nrDecoders = functions::getCachingThreadCount();
+  if (!isInputFormatTypeAnnexB(this->inputFormat) || nrDecoders < 2)
+    return {};
+  if (this->decoderEngine != DecoderEngine::HM && this->decoderEngine != DecoderEngine::VTM)
+    return {};
+  QSettings settings;
+  if (!settings.value("Decoders/UseDecoderHost", true).toBool() ||
+      !host::DecoderHostConnection::getHostExecutablePath())
+    return {};
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::createParallelGOPDecoder Initializing "
+                   << nrDecoders << " decoders");
+  decoder::ParallelGOPDecoder::Bitstream bitstream;
+  bitstream.getGOP = [this](int frameIdx) -> std::optional<decoder::ParallelGOPDecoder::GOP> {
+    if (frameIdx < 0)
+      return {};
+    QReadLocker parserLocker(&this->parserLock);
+    const auto  gop = this->inputFileAnnexBParser->getGOP(unsigned(frameIdx));
+    if (!gop)
+      return {};
+    return decoder::ParallelGOPDecoder::GOP{int(gop->firstFrame), int(gop->lastFrame)};
+  };
+  const auto filePath =
+      std::filesystem::path(this->inputFileAnnexBLoading->getAbsoluteFilePath());
+  bitstream.createReader = [this, filePath]() {
+    return std::make_unique<AnnexBGOPReader>(
+        filePath, this->inputFileAnnexBParser, this->parserLock);
+  };
+  const auto engine       = this->decoderEngine;
+  bitstream.createDecoder = [engine]() -> std::unique_ptr<decoder::decoderBase> {
+    return decoder::decoderRemote::create(engine, 0, true);
+  };
+
+  auto parallelDecoder = std::make_unique<decoder::ParallelGOPDecoder>(
+      std::move(bitstream), nrDecoders, GOP_DECODE_BUFFER_SIZE_BYTES);
+  parallelDecoder->setDecodeSignal(displayComponent);
+  return parallelDecoder;
 }
 
 void playlistItemCompressedVideo::fillStatisticList()
@@ -1110,6 +1585,8 @@ void playlistItemCompressedVideo::loadStatistics(int frameIdx)
     // this is off. Enabeling works like this: Enable collection, reset the decoder and decode the
     // current frame again. Statisitcs are always retrieved for the loading decoder.
     this->loadingDecoder->enableStatisticsRetrieval(&this->statisticsData);
+    this->backwardDecodeBuffer.clear();
+    this->decoderCheckpoints.clear();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatistics Enable loading of stats frame "
                      << frameIdx);
 
@@ -1120,6 +1597,15 @@ void playlistItemCompressedVideo::loadStatistics(int frameIdx)
 
     // The statistics should now be loaded
   }
+  else if (auto frameData = this->frameStatisticsCache.getFrame(frameIdx))
+  {
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatistics Statistics of frame "
+                     << frameIdx << " from the statistics cache");
+    // All types were retrieved from the decoder. Types without data in this frame are empty.
+    for (const auto &statsType : this->statisticsData.getStatisticsTypes())
+      (*frameData)[statsType.typeID];
+    this->statisticsData.setFrameData(frameIdx, std::move(*frameData));
+  }
   else if (frameIdx != this->currentFrameIdx[0])
   {
     // If the requested frame is not currently decoded, decode it.
@@ -1155,6 +1641,8 @@ void playlistItemCompressedVideo::getSupportedFileExtensions(QStringList &allExt
       << "vvc"
       << "h266"
       << "266"
+      << "obu"
+      << "av1"
       << "avi"
       << "avr"
       << "cdxl"
@@ -1205,21 +1693,115 @@ void playlistItemCompressedVideo::getSupportedFileExtensions(QStringList &allExt
   filters.append(filtersString);
 }
 
+bool playlistItemCompressedVideo::isSourceChanged()
+{
+  if (this->inputFileAV1Loading)
+    return this->inputFileAV1Loading->getAndResetFileChangedFlag();
+  if (this->inputFileFFmpegLoading)
+    return this->inputFileFFmpegLoading->isFileChanged();
+  if (!this->inputFileAnnexBLoading)
+    return false;
+
+  const auto fileChanged = this->inputFileAnnexBLoading->getAndResetFileChangedFlag();
+  if (!this->followGrowingFile)
+    return fileChanged;
+
+  // Data that is appended to the file is parsed while following the file. Only if the file was
+  // truncated, it must be parsed again.
+  const auto truncated        = this->followedFileTruncated;
+  this->followedFileTruncated = false;
+  return truncated;
+}
+
 void playlistItemCompressedVideo::reloadItemSource()
 {
-  // TODO: The caching decoder must also be reloaded
-  //       All items in the cache are also now invalid
+  {
+    // The frames that were read from the file are not valid anymore. Open the file again and read
+    // the frames from the start. Loading and caching of frames is blocked until this is done.
+    QWriteLocker parserLocker(&this->parserLock);
+
+    if (this->inputFileAnnexBParser)
+    {
+      const auto filePath =
+          std::filesystem::path(this->inputFileAnnexBLoading->getAbsoluteFilePath());
+      this->inputFileAnnexBLoading->openFile(filePath);
+      if (this->inputFileAnnexBCaching)
+        this->inputFileAnnexBCaching->openFile(filePath);
+
+      this->inputFileAnnexBParser = createAnnexBParser(this->inputFormat);
+      this->inputFileAnnexBParser->parseAnnexBFile(
+          this->inputFileAnnexBLoading, MainWindow::getMainWindow(), this->followGrowingFile);
+      this->followedFileSize      = this->inputFileAnnexBLoading->getFileSize().value_or(0);
+      this->followedFileTruncated = false;
+      this->prop.startEndRange =
+          indexRange(0, int(this->inputFileAnnexBParser->getNumberPOCs() - 1));
+    }
+    else if (this->inputFileAV1Loading)
+    {
+      const auto filePath = std::filesystem::path(this->inputFileAV1Loading->getAbsoluteFilePath());
+      if (!this->inputFileAV1Loading->openFile(filePath) ||
+          (this->inputFileAV1Caching &&
+           !this->inputFileAV1Caching->openFile(filePath, *this->inputFileAV1Loading)))
+      {
+        this->setError("Error reopening raw AV1 file.");
+        return;
+      }
+      this->prop.startEndRange =
+          indexRange(0, int(this->inputFileAV1Loading->getNumberFrames()) - 1);
+    }
+    else if (this->inputFileFFmpegLoading)
+    {
+      // The frame index may still be scanned in the background. Replace the file sources (which
+      // stops the scan) instead of opening the file again in place.
+      const auto filePath = this->properties().name;
+      this->inputFileFFmpegCaching.reset();
+      this->inputFileFFmpegLoading = std::make_unique<FileSourceFFmpegFile>();
+      this->connect(this->inputFileFFmpegLoading.get(),
+                    &FileSourceFFmpegFile::signalFrameIndexChanged,
+                    this,
+                    &playlistItemCompressedVideo::updateFrameLimitsFromFile);
+      if (!this->inputFileFFmpegLoading->openFile(filePath))
+      {
+        this->setError("Error reopening file using libavcodec.");
+        return;
+      }
+      if (this->cachingEnabled)
+      {
+        this->inputFileFFmpegCaching = std::make_unique<FileSourceFFmpegFile>();
+        if (!this->inputFileFFmpegCaching->openFile(filePath, this->inputFileFFmpegLoading.get()))
+        {
+          this->setError("Error reopening file a second time using libavcodec for caching.");
+          return;
+        }
+      }
+      this->prop.startEndRange = this->inputFileFFmpegLoading->getDecodableFrameLimits();
+    }
 
-  // loadingDecoder->reloadItemSource();
-  // Reset the decoder somehow
+    if (this->loadingDecoder)
+      this->loadingDecoder->resetDecoder();
+    if (this->cachingDecoder)
+      this->cachingDecoder->resetDecoder();
+    if (this->parallelGOPDecoder)
+      this->parallelGOPDecoder->clear();
+    this->currentFrameIdx[0]                = -1;
+    this->currentFrameIdx[1]                = -1;
+    this->readAnnexBFrameCounterCodingOrder = -1;
+    this->decodingNotPossibleAfter          = -1;
+  }
 
   // Reset the videoHandlerYUV source. With the next draw event, the videoHandlerYUV will request to
   // decode the frame again.
   this->video->invalidateAllBuffers();
+  this->backwardDecodeBuffer.clear();
+  this->decoderCheckpoints.clear();
+  this->frameStatisticsCache.clear();
 
   // Load frame 0. This will decode the first frame in the sequence and set the
   // correct frame size/YUV format.
   loadRawData(0, false);
+
+  this->updateFollowGrowingFileSetting();
+  emit SignalItemChanged(true, RECACHE_CLEAR);
 }
 
 void playlistItemCompressedVideo::cacheFrame(int frameIdx, bool testMode)
@@ -1228,6 +1810,11 @@ void playlistItemCompressedVideo::cacheFrame(int frameIdx, bool testMode)
     return;
 
   // Cache a certain frame. This is always called in a separate thread.
+  if (this->parallelGOPDecoder)
+  {
+    this->video->cacheFrame(frameIdx, testMode);
+    return;
+  }
   this->cachingMutex.lock();
   this->video->cacheFrame(frameIdx, testMode);
   this->cachingMutex.unlock();
@@ -1241,6 +1828,9 @@ void playlistItemCompressedVideo::loadFrame(int  frameIdx,
   // The current thread must never be the main thread but one of the interactive threads.
   Q_ASSERT(QThread::currentThread() != QApplication::instance()->thread());
 
+  // The parser must not be modified by the tail mode while a frame is loaded
+  QReadLocker parserLocker(&this->parserLock);
+
   auto stateYUV  = this->video->needsLoading(frameIdx, loadRawdata);
   auto stateStat = this->statisticsData.needsLoading(frameIdx);
 
@@ -1269,39 +1859,67 @@ void playlistItemCompressedVideo::loadFrame(int  frameIdx,
   if (playing && (stateYUV == ItemLoadingState::LoadingNeeded ||
                   stateYUV == ItemLoadingState::LoadingNeededDoubleBuffer))
   {
-    // Load the next frame into the double buffer
-    int nextFrameIdx = frameIdx + 1;
-    if (nextFrameIdx <= this->properties().startEndRange.second)
+    // Fill the render-ahead queue with the next frames
+    const auto range              = this->properties().startEndRange;
+    auto       lastLoadedFrameIdx = -1;
+    while (const auto nextFrameIdx = this->video->getNextRenderAheadFrame(frameIdx))
     {
-      DEBUG_COMPRESSED("playlistItplaylistItemCompressedVideoemRawFile::loadFrame loading frame "
-                       "into double buffer "
-                       << nextFrameIdx << (playing ? " (playing)" : ""));
+      if (*nextFrameIdx < range.first || *nextFrameIdx > range.second ||
+          *nextFrameIdx == lastLoadedFrameIdx)
+        break;
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadFrame loading frame "
+                       "into render-ahead queue "
+                       << *nextFrameIdx);
       this->isFrameLoadingDoubleBuffer = true;
-      this->video->loadFrame(nextFrameIdx, true);
+      this->video->loadFrame(*nextFrameIdx, true);
       this->isFrameLoadingDoubleBuffer = false;
+      lastLoadedFrameIdx               = *nextFrameIdx;
       if (emitSignals)
         emit signalItemDoubleBufferLoaded();
     }
   }
 }
 
+bool playlistItemCompressedVideo::isFrameIndexComplete() const
+{
+  return !this->inputFileFFmpegLoading || this->inputFileFFmpegLoading->isFrameIndexComplete();
+}
+
+void playlistItemCompressedVideo::updateFrameLimitsFromFile()
+{
+  const auto range = this->inputFileFFmpegLoading->getDecodableFrameLimits();
+  if (range == this->prop.startEndRange)
+    return;
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::updateFrameLimitsFromFile startEndRange ("
+                   << range.first << "x" << range.second << ")");
+  this->prop.startEndRange = range;
+  emit SignalItemChanged(false, RECACHE_NONE);
+}
+
 void playlistItemCompressedVideo::displaySignalComboBoxChanged(int idx)
 {
   if (this->loadingDecoder && idx != this->loadingDecoder->getDecodeSignal())
   {
     bool resetDecoder = false;
     this->loadingDecoder->setDecodeSignal(idx, resetDecoder);
-    this->cachingDecoder->setDecodeSignal(idx, resetDecoder);
+    if (this->cachingDecoder)
+      this->cachingDecoder->setDecodeSignal(idx, resetDecoder);
+    if (this->parallelGOPDecoder)
+      this->parallelGOPDecoder->setDecodeSignal(idx);
 
     if (resetDecoder)
     {
       this->loadingDecoder->resetDecoder();
-      this->cachingDecoder->resetDecoder();
+      if (this->cachingDecoder)
+        this->cachingDecoder->resetDecoder();
 
       // Reset the decoded frame indices so that decoding of the current frame is triggered
       this->currentFrameIdx[0] = -1;
       this->currentFrameIdx[1] = -1;
     }
+    this->backwardDecodeBuffer.clear();
+    this->decoderCheckpoints.clear();
 
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
@@ -1332,6 +1950,8 @@ void playlistItemCompressedVideo::decoderComboxBoxChanged(int idx)
     // Reset the decoded frame indices so that decoding of the current frame is triggered
     this->currentFrameIdx[0] = -1;
     this->currentFrameIdx[1] = -1;
+    this->backwardDecodeBuffer.clear();
+    this->frameStatisticsCache.clear();
 
     this->decodingNotPossibleAfter = -1;
 
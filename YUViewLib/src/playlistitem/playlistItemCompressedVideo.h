@@ -33,13 +33,21 @@
 #pragma once
 
 #include <common/Typedef.h>
+#include <decoder/BackwardDecodeBuffer.h>
+#include <decoder/DecoderCheckpoints.h>
+#include <decoder/ParallelGOPDecoder.h>
 #include <decoder/decoderBase.h>
+#include <filesource/FileSourceAV1OBUFile.h>
 #include <filesource/FileSourceFFmpegFile.h>
 #include <parser/ParserAnnexB.h>
+#include <statistics/FrameStatisticsCache.h>
 #include <statistics/StatisticUIHandler.h>
 #include <statistics/StatisticsData.h>
 #include <ui_playlistItemCompressedFile.h>
 
+#include <QBasicTimer>
+#include <QReadWriteLock>
+
 #include "playlistItemWithVideo.h"
 
 class videoHandler;
@@ -87,14 +95,9 @@ public:
   static void getSupportedFileExtensions(QStringList &allExtensions, QStringList &filters);
 
   // ----- Detection of source/file change events -----
-  virtual bool isSourceChanged() override
-  { /* TODO */
-    return false;
-  }
+  virtual bool isSourceChanged() override;
   virtual void reloadItemSource() override;
-  virtual void updateSettings() override
-  { /* TODO loadingDecoder->updateFileWatchSetting(); statSource.updateSettings(); */
-  }
+  virtual void updateSettings() override;
 
   // Do we need to load the given frame first?
   virtual ItemLoadingState needsLoading(int frameIdx, bool loadRawData) override;
@@ -105,15 +108,28 @@ public:
   virtual bool isLoading() const override { return isFrameLoading; }
   virtual bool isLoadingDoubleBuffer() const override { return isFrameLoadingDoubleBuffer; }
 
+  // When playing backwards, the interactive decoder decodes a GOP once into the backward decode
+  // buffer and the frames are then presented from there.
+  virtual void setPlaybackStep(int step) override;
+
   // Cache the frame with the given index.
-  // For all compressed items, a mutex must be locked when caching a frame (only one frame can be
-  // cached at a time because we only have one decoder).
+  // If there is only one caching decoder, a mutex must be locked when caching a frame (only one
+  // frame can be cached at a time). The parallel GOP decoder can be used by several threads.
   void cacheFrame(int idx, bool testMode) override;
 
-  // We only have one caching decoder so it is better if only one thread caches frames from this
-  // item. This way, the frames will always be cached in the right order and no unnecessary decoding
-  // is performed.
-  virtual int cachingThreadLimit() override { return 1; }
+  // With only one caching decoder it is better if only one thread caches frames from this item.
+  // This way, the frames will always be cached in the right order and no unnecessary decoding is
+  // performed. The parallel GOP decoder decodes one GOP per thread.
+  virtual int cachingThreadLimit() override
+  {
+    return this->parallelGOPDecoder ? int(this->parallelGOPDecoder->getNumberDecoders()) : 1;
+  }
+
+  virtual bool isFrameIndexComplete() const override;
+  virtual bool isFollowingGrowingFile() const override
+  {
+    return this->followFileTimer.isActive() && this->hasFollowedFileGrownRecently();
+  }
 
   InputFormat getInputFormat() const { return this->inputFormat; }
 
@@ -132,6 +148,14 @@ protected:
   decoder::DecoderEngine decoderEngine{decoder::DecoderEngine::Invalid};
   // Delete existing decoders and allocate decoders for the type "decoderEngineType"
   bool allocateDecoder(int displayComponent = 0);
+  // Create a single decoder of the type "decoderEngine". Return nullptr if the type is invalid.
+  std::unique_ptr<decoder::decoderBase> createDecoder(int  displayComponent,
+                                                      bool cachingDecoder) const;
+
+  // For AnnexB files that are decoded with a reference decoder (HM/VTM) in decoder host processes,
+  // caching uses several decoders that decode the GOPs in parallel instead of the caching decoder.
+  std::unique_ptr<decoder::ParallelGOPDecoder> parallelGOPDecoder;
+  std::unique_ptr<decoder::ParallelGOPDecoder> createParallelGOPDecoder(int displayComponent);
 
   // In order to parse raw annexB files, we need a file reader (that can read NAL units)
   // and a parser that can understand what the NAL units mean. We open the file source twice (once
@@ -144,6 +168,20 @@ protected:
   // count how many frames we already read.
   int readAnnexBFrameCounterCodingOrder{-1};
 
+  // Tail mode: If the annex B file is still being written, the appended NAL units are parsed and
+  // the new frames are added to the item. The file is checked every second. The parser is modified
+  // while the decoders use it so parsing is only performed while no frame is loaded or cached. If
+  // the followed file was truncated, the parsed frames are not valid anymore and the item must be
+  // reloaded.
+  bool           followGrowingFile{};
+  int64_t        followedFileSize{};
+  bool           followedFileTruncated{};
+  QBasicTimer    followFileTimer;
+  QReadWriteLock parserLock;
+  void           updateFollowGrowingFileSetting();
+  bool           updateFromGrowingFile();
+  void           timerEvent(QTimerEvent *event) override;
+
   // Which type is the input?
   InputFormat              inputFormat;
   FFmpeg::AVCodecIDWrapper ffmpegCodec;
@@ -153,6 +191,11 @@ protected:
   std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegLoading;
   std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegCaching;
 
+  // Raw AV1 files (IVF, OBU or annex B) are read temporal unit by temporal unit. The caching
+  // instance uses the index of the loading instance.
+  std::unique_ptr<FileSourceAV1OBUFile> inputFileAV1Loading;
+  std::unique_ptr<FileSourceAV1OBUFile> inputFileAV1Caching;
+
   // Is the loadFrame function currently loading?
   bool isFrameLoading{};
   bool isFrameLoadingDoubleBuffer{};
@@ -165,6 +208,12 @@ protected:
   stats::StatisticUIHandler statisticsUIHandler;
   stats::StatisticsData     statisticsData;
 
+  // Once statistics are shown, the caching decoder retrieves the statistics of every frame that it
+  // decodes into cachingStatisticsData. These and the statistics of the interactive decoder are
+  // kept in the frameStatisticsCache so that they can be shown again without decoding.
+  stats::StatisticsData       cachingStatisticsData;
+  stats::FrameStatisticsCache frameStatisticsCache;
+
   void fillStatisticList();
   void loadStatistics(int frameIdx);
 
@@ -173,6 +222,18 @@ protected:
   // The current frame index of the decoders (interactive/caching)
   int currentFrameIdx[2]{-1, -1};
 
+  // Decoded frames of the last GOP pass of the interactive decoder. Only used for reverse playback.
+  decoder::BackwardDecodeBuffer backwardDecodeBuffer;
+
+  // Inside of long AnnexB GOPs, the interactive decoder is parked instead of reset when it has to
+  // seek away. Decoding can then be resumed from the parked decoder (see parser::SeekIndex). After
+  // parking, the loading decoder is a decoder that was dropped from the checkpoints or nullptr.
+  decoder::DecoderCheckpoints decoderCheckpoints;
+  bool                        decoderCheckpointsEnabled{true};
+  bool                        parkLoadingDecoder();
+  bool                        resumeLoadingDecoderFromCheckpoint(int      frameIdx,
+                                                                 unsigned maxDecodeCost);
+
   // Seek the input file to the given position, reset the decoder and prepare it to start decoding
   // from the given position.
   void seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching);
@@ -200,6 +261,8 @@ private slots:
   virtual void loadRawData(int frameIdx, bool forceDecodingNow);
 
   void updateStatSource(bool bRedraw) { emit SignalItemChanged(bRedraw, RECACHE_NONE); }
+  // The background scan of the FFmpeg file found more frames.
+  void updateFrameLimitsFromFile();
   void displaySignalComboBoxChanged(int idx);
   void decoderComboxBoxChanged(int idx);
 };
@@ -242,8 +242,9 @@ void playlistItemDifference::loadFrame(int  frameIdx,
                   state == ItemLoadingState::LoadingNeededDoubleBuffer))
   {
     // Load the next frame into the double buffer
-    int nextFrameIdx = frameIdx + 1;
-    if (nextFrameIdx <= this->properties().startEndRange.second)
+    const auto range        = this->properties().startEndRange;
+    const auto nextFrameIdx = frameIdx + this->playbackStep;
+    if (nextFrameIdx >= range.first && nextFrameIdx <= range.second)
     {
       DEBUG_DIFF("playlistItemDifference::loadFrame loading difference into double buffer %d %s",
                  nextFrameIdx,
@@ -59,6 +59,11 @@ public:
   loadFrame(int frameIdx, bool playing, bool loadRawData, bool emitSignals = true) override;
   virtual bool isLoading() const override;
   virtual bool isLoadingDoubleBuffer() const override;
+  virtual void setPlaybackStep(int step) override
+  {
+    playlistItem::setPlaybackStep(step);
+    this->difference.setPlaybackStep(step);
+  }
 
   // Overload from playlistItem. Save the playlist item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
@@ -348,4 +348,6 @@ void playlistItemImageFileSequence::updateSettings()
   else
     // Remove watchers for all image files.
     fileWatcher.removePaths(imageFiles);
+
+  playlistItemWithVideo::updateSettings();
 }
@@ -36,11 +36,14 @@
 
 #include <QPainter>
 #include <QPointer>
+#include <QtConcurrent>
 #include <cmath>
 #include <limits>
 
 #include <common/EnumMapper.h>
+#include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <video/videoHandler.h>
 
 #define PLAYLISTITEMOVERLAY_DEBUG 0
 #if PLAYLISTITEMOVERLAY_DEBUG && !NDEBUG
@@ -65,6 +68,11 @@ std::string to_string(const QSize &size)
   return "(" + std::to_string(size.width()) + "," + std::to_string(size.height()) + ")";
 }
 
+video::videoHandler *getVideoHandler(playlistItem *item)
+{
+  return item ? dynamic_cast<video::videoHandler *>(item->getFrameHandler()) : nullptr;
+}
+
 } // namespace
 
 playlistItemOverlay::playlistItemOverlay() : playlistItemContainer("Overlay Item")
@@ -79,6 +87,8 @@ playlistItemOverlay::playlistItemOverlay() : playlistItemContainer("Overlay Item
   this->infoText =
       "Please drop some items onto this overlay. All child items will be drawn on top of "
       "each other.";
+
+  this->childLoadingThreadPool.setMaxThreadCount(functions::getCachingThreadCount());
 }
 
 /* For an overlay item, the info list is just a list of the names of the
@@ -138,30 +148,30 @@ ValuePairListSets playlistItemOverlay::getPixelValues(const QPoint &pixelPos, in
 
 ItemLoadingState playlistItemOverlay::needsLoading(int frameIdx, bool loadRawdata)
 {
-  // The overlay needs to load if one of the child items needs to load
+  // A composed frame from the cache can be drawn directly (unless raw values are drawn)
+  if (!loadRawdata && this->cacheComposedFrames && this->composedFrameCache.contains(frameIdx))
+    return ItemLoadingState::LoadingNotNeeded;
+
+  // The overlay needs to load if one of the child items needs to load. Loading the current frame
+  // has priority over loading the double buffer.
+  auto state = ItemLoadingState::LoadingNotNeeded;
   for (int i = 0; i < this->childCount(); i++)
   {
-    if (this->getChildPlaylistItem(i)->needsLoading(frameIdx, loadRawdata) ==
-        ItemLoadingState::LoadingNeeded)
+    const auto childState = this->getChildPlaylistItem(i)->needsLoading(frameIdx, loadRawdata);
+    if (childState == ItemLoadingState::LoadingNeeded)
     {
       DEBUG_OVERLAY("playlistItemOverlay::needsLoading LoadingNeeded child %s",
                     this->getChildPlaylistItem(i)->getName().toLatin1().data());
       return ItemLoadingState::LoadingNeeded;
     }
-  }
-  for (int i = 0; i < this->childCount(); i++)
-  {
-    if (this->getChildPlaylistItem(i)->needsLoading(frameIdx, loadRawdata) ==
-        ItemLoadingState::LoadingNeededDoubleBuffer)
-    {
-      DEBUG_OVERLAY("playlistItemOverlay::needsLoading LoadingNeededDoubleBuffer child %s",
-                    this->getChildPlaylistItem(i)->getName().toLatin1().data());
-      return ItemLoadingState::LoadingNeededDoubleBuffer;
-    }
+    if (childState == ItemLoadingState::LoadingNeededDoubleBuffer)
+      state = ItemLoadingState::LoadingNeededDoubleBuffer;
   }
 
-  DEBUG_OVERLAY("playlistItemOverlay::needsLoading LoadingNotNeeded");
-  return ItemLoadingState::LoadingNotNeeded;
+  DEBUG_OVERLAY("playlistItemOverlay::needsLoading %s",
+                state == ItemLoadingState::LoadingNotNeeded ? "LoadingNotNeeded"
+                                                            : "LoadingNeededDoubleBuffer");
+  return state;
 }
 
 void playlistItemOverlay::drawItem(QPainter *painter,
@@ -186,6 +196,18 @@ void playlistItemOverlay::drawItem(QPainter *painter,
   // Update the layout if the number of items changedupdateLayout
   this->updateLayout();
 
+  if (!drawRawData)
+  {
+    if (auto composedFrame = this->getComposedFrame(frameIdx))
+    {
+      const auto topLeft =
+          QPointF(this->boundingRect.topLeft() - centerRoundTL(this->boundingRect)) * zoomFactor;
+      painter->drawImage(QRectF(topLeft, QSizeF(this->boundingRect.size()) * zoomFactor),
+                         *composedFrame);
+      return;
+    }
+  }
+
   // Translate to the center of this overlay item
   painter->translate(centerRoundTL(boundingRect) * zoomFactor * -1);
 
@@ -215,6 +237,8 @@ QSize playlistItemOverlay::getSize() const
 
 void playlistItemOverlay::updateLayout(bool onlyIfItemsChanged)
 {
+  QMutexLocker lock(&this->layoutAccess);
+
   if (this->childCount() == 0)
   {
     this->childItemRects.clear();
@@ -245,6 +269,9 @@ void playlistItemOverlay::updateLayout(bool onlyIfItemsChanged)
   DEBUG_OVERLAY("playlistItemOverlay::updateLayout%s",
                 onlyIfNrItemsChanged ? " onlyIfNrItemsChanged" : "");
 
+  const auto previousBoundingRect   = this->boundingRect;
+  const auto previousChildItemRects = this->childItemRects;
+
   if (nrItemsChanged || itemOrderChanged)
   {
     // Resize the childItems/IDs list
@@ -406,6 +433,10 @@ void playlistItemOverlay::updateLayout(bool onlyIfItemsChanged)
       this->boundingRect = this->boundingRect.united(targetRect);
     }
   }
+
+  // Cached composed frames have the old layout
+  if (this->boundingRect != previousBoundingRect || this->childItemRects != previousChildItemRects)
+    this->composedFrameCache.clear();
 }
 
 void playlistItemOverlay::createPropertiesWidget()
@@ -438,6 +469,7 @@ void playlistItemOverlay::createPropertiesWidget()
   this->ui.overlayGroupBox->setChecked(this->layoutMode == OverlayLayoutMode::Overlay);
   this->ui.arangeGroupBox->setChecked(this->layoutMode == OverlayLayoutMode::Arange);
   this->ui.customGroupBox->setChecked(this->layoutMode == OverlayLayoutMode::Custom);
+  this->ui.cacheComposedFramesCheckBox->setChecked(this->cacheComposedFrames);
 
   // Create and add the grid layout for the custom positions
   this->customPositionGrid = new QGridLayout(this->ui.customGroupBox);
@@ -466,6 +498,10 @@ void playlistItemOverlay::createPropertiesWidget()
                 QOverload<int>::of(&QComboBox::currentIndexChanged),
                 this,
                 &playlistItemOverlay::slotControlChanged);
+  this->connect(this->ui.cacheComposedFramesCheckBox,
+                &QCheckBox::toggled,
+                this,
+                &playlistItemOverlay::on_cacheComposedFramesCheckBox_toggled);
 }
 
 void playlistItemOverlay::savePlaylist(QDomElement &root, const QDir &playlistDir) const
@@ -491,6 +527,8 @@ void playlistItemOverlay::savePlaylist(QDomElement &root, const QDir &playlistDi
       d.appendProperiteChild(QString("ItemPos%1Y").arg(i), QString::number(p.y()));
     }
   }
+  if (this->cacheComposedFrames)
+    d.appendProperiteChild("cacheComposedFrames", "1");
 
   playlistItemContainer::savePlaylistChildren(d, playlistDir);
 
@@ -562,6 +600,8 @@ playlistItemOverlay *playlistItemOverlay::newPlaylistItemOverlay(const YUViewDom
     }
   }
 
+  newOverlay->cacheComposedFrames = (root.findChildValue("cacheComposedFrames") == "1");
+
   playlistItem::loadPropertiesFromPlaylist(root, newOverlay);
 
   return newOverlay;
@@ -582,17 +622,27 @@ void playlistItemOverlay::slotControlChanged()
   // No new item was added but update the layout of the items
   this->updateLayout(false);
 
-  emit SignalItemChanged(true, RECACHE_NONE);
+  emit SignalItemChanged(true, this->cacheComposedFrames ? RECACHE_CLEAR : RECACHE_NONE);
 }
 
 void playlistItemOverlay::childChanged(bool redraw, recacheIndicator recache)
 {
   if (redraw)
     this->updateLayout(false);
+  if (recache == RECACHE_CLEAR)
+    this->removeAllFramesFromCache();
 
   playlistItemContainer::childChanged(redraw, recache);
 }
 
+void playlistItemOverlay::on_cacheComposedFramesCheckBox_toggled(bool on)
+{
+  this->cacheComposedFrames = on;
+  if (!on)
+    this->removeAllFramesFromCache();
+  emit SignalItemChanged(false, RECACHE_CLEAR);
+}
+
 void playlistItemOverlay::onGroupBoxToggled(int idx, bool on)
 {
   const QSignalBlocker blocker0(this->ui.overlayGroupBox);
@@ -633,23 +683,16 @@ void playlistItemOverlay::onGroupBoxToggled(int idx, bool on)
 void playlistItemOverlay::loadFrame(int frameIdx, bool playing, bool loadRawData, bool emitSignals)
 {
   // Does one of the items need loading?
-  bool itemLoadedDoubleBuffer = false;
-  bool itemLoaded             = false;
+  bool                  itemLoadedDoubleBuffer = false;
+  bool                  itemLoaded             = false;
+  QList<playlistItem *> itemsToLoad;
 
   for (int i = 0; i < this->childCount(); i++)
   {
     auto item  = this->getChildPlaylistItem(i);
     auto state = item->needsLoading(frameIdx, loadRawData);
     if (state != ItemLoadingState::LoadingNotNeeded)
-    {
-      // Load the requested current frame (or the double buffer) without emitting any signals.
-      // We will emit the signal that loading is complete when all overlay items have loaded.
-      DEBUG_OVERLAY("playlistItemWithVideo::loadFrame loading frame %d%s%s",
-                    frameIdx,
-                    playing ? " playing" : "",
-                    loadRawData ? " raw" : "");
-      item->loadFrame(frameIdx, playing, loadRawData, false);
-    }
+      itemsToLoad.append(item);
 
     if (state == ItemLoadingState::LoadingNeeded)
       itemLoaded = true;
@@ -658,12 +701,129 @@ void playlistItemOverlay::loadFrame(int frameIdx, bool playing, bool loadRawData
       itemLoadedDoubleBuffer = true;
   }
 
+  // Load the requested current frame (or the double buffer) in all items in parallel without
+  // emitting any signals. The first item is loaded in this thread. We will emit the signal that
+  // loading is complete when all overlay items have loaded.
+  DEBUG_OVERLAY("playlistItemOverlay::loadFrame loading frame %d in %d items%s%s",
+                frameIdx,
+                itemsToLoad.size(),
+                playing ? " playing" : "",
+                loadRawData ? " raw" : "");
+  QList<QFuture<void>> loadingItems;
+  for (int i = 1; i < itemsToLoad.size(); i++)
+  {
+    auto item = itemsToLoad[i];
+    loadingItems.append(QtConcurrent::run(&this->childLoadingThreadPool, [=]() {
+      item->loadFrame(frameIdx, playing, loadRawData, false);
+    }));
+  }
+  if (!itemsToLoad.isEmpty())
+    itemsToLoad.first()->loadFrame(frameIdx, playing, loadRawData, false);
+  for (auto &loading : loadingItems)
+    loading.waitForFinished();
+
   if (emitSignals && itemLoaded)
     emit SignalItemChanged(true, RECACHE_NONE);
   if (emitSignals && itemLoadedDoubleBuffer)
     emit signalItemDoubleBufferLoaded();
 }
 
+bool playlistItemOverlay::isCachable() const
+{
+  if (!this->cacheComposedFrames || this->taggedForDeletion() || this->childCount() == 0)
+    return false;
+  {
+    QMutexLocker lock(&this->layoutAccess);
+    if (this->boundingRect.isEmpty())
+      return false;
+  }
+  for (int i = 0; i < this->childCount(); i++)
+  {
+    const auto video = getVideoHandler(this->getChildPlaylistItem(i));
+    if (video == nullptr || !video->isFormatValid())
+      return false;
+  }
+  return true;
+}
+
+void playlistItemOverlay::cacheFrame(int frameIdx, bool testMode)
+{
+  if (!testMode && this->composedFrameCache.contains(frameIdx))
+    return;
+
+  const auto image = this->composeFrame(frameIdx);
+  if (image.isNull() || testMode)
+    return;
+
+  this->composedFrameCache.insert(frameIdx, image);
+}
+
+QList<int> playlistItemOverlay::getCachedFrames() const
+{
+  return this->composedFrameCache.getFrameIndices();
+}
+
+int playlistItemOverlay::getNumberCachedFrames() const
+{
+  return this->composedFrameCache.size();
+}
+
+unsigned int playlistItemOverlay::getCachingFrameSize() const
+{
+  QMutexLocker lock(&this->layoutAccess);
+  const auto   bytes = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(true));
+  return this->boundingRect.width() * this->boundingRect.height() * bytes;
+}
+
+void playlistItemOverlay::removeFrameFromCache(int frameIdx)
+{
+  this->composedFrameCache.remove(frameIdx);
+}
+
+void playlistItemOverlay::removeAllFramesFromCache()
+{
+  this->composedFrameCache.clear();
+}
+
+uint64_t playlistItemOverlay::getCachedFrameLastAccess(int frameIdx) const
+{
+  return this->composedFrameCache.getLastAccess(frameIdx);
+}
+
+QImage playlistItemOverlay::composeFrame(int frameIdx)
+{
+  QRect        composedRect;
+  QList<QRect> itemRects;
+  {
+    QMutexLocker lock(&this->layoutAccess);
+    composedRect = this->boundingRect;
+    itemRects    = this->childItemRects;
+  }
+  if (composedRect.isEmpty() || itemRects.size() != this->childCount())
+    return {};
+
+  // Load the frame of all children in parallel. This is the same path that is used for exporting
+  // so the frames that are shown are not touched. The items are drawn in the same order as drawItem
+  // does.
+  std::vector<video::ComposedItem> items;
+  for (int i = 0; i < this->childCount(); i++)
+  {
+    const auto video = getVideoHandler(this->getChildPlaylistItem(i));
+    if (video == nullptr)
+      return {};
+    items.push_back(
+        {itemRects[i], [video, frameIdx]() { return video->loadFrameForExport(frameIdx); }});
+  }
+  return video::composeImage(composedRect, items, &this->childLoadingThreadPool);
+}
+
+std::optional<QImage> playlistItemOverlay::getComposedFrame(int frameIdx)
+{
+  if (!this->cacheComposedFrames)
+    return {};
+  return this->composedFrameCache.get(frameIdx);
+}
+
 bool playlistItemOverlay::isLoading() const
 {
   // We are loading if one of the child items is loading
@@ -682,6 +842,12 @@ bool playlistItemOverlay::isLoadingDoubleBuffer() const
   return false;
 }
 
+void playlistItemOverlay::updateSettings()
+{
+  playlistItemContainer::updateSettings();
+  this->childLoadingThreadPool.setMaxThreadCount(functions::getCachingThreadCount());
+}
+
 // Returns a possibly new widget at given row and column, having a set column span.
 // Any existing widgets of other types or other span will be removed.
 template <typename W> static W *widgetAt(QGridLayout *grid, int row, int column)
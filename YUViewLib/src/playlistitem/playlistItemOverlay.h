@@ -33,11 +33,17 @@
 #pragma once
 
 #include <common/Typedef.h>
+#include <video/ImageComposition.h>
 
 #include "playlistItemContainer.h"
 #include "ui_playlistItemOverlay.h"
 
 #include <QGridLayout>
+#include <QMap>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <optional>
 
 enum class OverlayLayoutMode
 {
@@ -66,8 +72,8 @@ public:
   // The overlay item itself does not need to load anything. We just pass all of these to the child
   // items.
   virtual ItemLoadingState needsLoading(int frameIdx, bool loadRawData) override;
-  // Load the frame in the video item. Emit SignalItemChanged(true,false) when done. Always called
-  // from a thread.
+  // Load the frame in all child items in parallel. Emit SignalItemChanged(true,false) when all
+  // children are done. Always called from a thread.
   virtual void
   loadFrame(int frameIdx, bool playing, bool loadRawData, bool emitSignals = true) override;
 
@@ -75,6 +81,8 @@ public:
   virtual bool isLoading() const override;
   virtual bool isLoadingDoubleBuffer() const override;
 
+  virtual void updateSettings() override;
+
   // Overload from playlistItem. Save the playlist item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
   // Create a new playlistItemOverlay from the playlist file entry. Return nullptr if parsing
@@ -84,6 +92,18 @@ public:
 
   virtual ValuePairListSets getPixelValues(const QPoint &pixelPos, int frameIdx) override;
 
+  // -- Caching
+  // If enabled, the composed overlay is cached as one image per frame. This is only possible if
+  // all children are videos.
+  virtual bool         isCachable() const override;
+  virtual void         cacheFrame(int frameIdx, bool testMode) override;
+  virtual QList<int>   getCachedFrames() const override;
+  virtual int          getNumberCachedFrames() const override;
+  virtual unsigned int getCachingFrameSize() const override;
+  virtual void         removeFrameFromCache(int frameIdx) override;
+  virtual void         removeAllFramesFromCache() override;
+  virtual uint64_t     getCachedFrameLastAccess(int frameIdx) const override;
+
   void guessBestLayout();
 
 private:
@@ -100,6 +120,7 @@ private:
   QRect               boundingRect;   //< The bounding rect of the complete overlay
   QList<QRect>        childItemRects; //< The position and size of each child item
   QList<unsigned int> childItemsIDs;  //< The ID of every child item
+  QMutex mutable layoutAccess;        //< Lock when accessing the layout from a caching thread
 
   // Update the child item layout and this item's bounding QRect. If onlyIfItemsChanged is true the
   // values will be updated only if the number or oder of items changed.
@@ -115,6 +136,18 @@ private:
   int               arangementMode{0};
   QMap<int, QPoint> customPositions;
 
+  // The child items are loaded in parallel using this pool. It uses at most as many threads as
+  // the video cache (see updateSettings).
+  QThreadPool childLoadingThreadPool;
+
+  // Load the frame from all children (in parallel) and draw them into one image. This does not
+  // touch the frames that are shown. Return a null image if this is not possible.
+  QImage                composeFrame(int frameIdx);
+  std::optional<QImage> getComposedFrame(int frameIdx);
+
+  bool                      cacheComposedFrames{false};
+  video::ComposedFrameCache composedFrameCache;
+
 private slots:
   void slotControlChanged();
   void childChanged(bool redraw, recacheIndicator recache) override;
@@ -122,4 +155,5 @@ private slots:
   void on_overlayGroupBox_toggled(bool on) { this->onGroupBoxToggled(0, on); }
   void on_arangeGroupBox_toggled(bool on) { this->onGroupBoxToggled(1, on); };
   void on_customGroupBox_toggled(bool on) { this->onGroupBoxToggled(2, on); };
+  void on_cacheComposedFramesCheckBox_toggled(bool on);
 };
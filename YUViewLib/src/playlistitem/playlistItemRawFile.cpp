@@ -33,11 +33,13 @@
 #include "playlistItemRawFile.h"
 
 #include <QPainter>
+#include <QSettings>
 #include <QUrl>
 #include <QVBoxLayout>
 
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <common/Tracing.h>
 #include <filesource/FrameFormatGuess.h>
 #include <handler/ItemMemoryHandler.h>
 
@@ -134,10 +136,15 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
 
     if (!this->video->isFormatValid())
     {
-      // Load 24883200 bytes from the input and try to get the format from the correlation.
-      QByteArray rawData;
-      this->dataSource.readBytes(rawData, 0, 24883200);
-      this->video->setFormatFromCorrelation(rawData, this->dataSource.getFileSize().value_or(-1));
+      // Try to get the format from the correlation of the first frames. Only the parts of the file
+      // that are needed for this are read.
+      auto readBytes = [this](int64_t position, int64_t nrBytes) {
+        QByteArray data;
+        this->dataSource.readBytes(data, position, nrBytes);
+        return data;
+      };
+      this->formatDetectionConfidence = this->video->setFormatFromCorrelation(
+          readBytes, this->dataSource.getFileSize().value_or(-1));
     }
   }
   else
@@ -158,6 +165,13 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
           this,
           &playlistItemRawFile::loadRawData,
           Qt::DirectConnection);
+  // The caching threads read the frames directly from the file (in parallel)
+  this->video->setConcurrentRawDataReader([this](int frameIdx) -> std::optional<QByteArray> {
+    QByteArray data;
+    if (!this->readRawFrameData(frameIdx, data))
+      return QByteArray();
+    return data;
+  });
 
   // Connect the basic signals from the video
   playlistItemWithVideo::connectVideo();
@@ -170,6 +184,9 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
 
   // A raw file can be cached.
   this->cachingEnabled = true;
+
+  this->setFollowedFileSize(this->dataSource.getFileSize().value_or(0));
+  this->updateFollowGrowingFileSetting();
 }
 
 void playlistItemRawFile::updateStartEndRange()
@@ -182,7 +199,7 @@ void playlistItemRawFile::updateStartEndRange()
 
   auto nrFrames = 0;
   if (this->isY4MFile)
-    nrFrames = this->y4mFrameIndices.count();
+    nrFrames = int(this->y4mFrameIndex.getNumberFrames());
   else
   {
     auto bpf = this->video->getBytesPerFrame();
@@ -209,6 +226,11 @@ InfoData playlistItemRawFile::getInfo() const
       (this->properties().startEndRange.second - this->properties().startEndRange.first + 1);
   info.items.append(InfoItem("Num Frames", std::to_string(nrFrames)));
   info.items.append(InfoItem("Bytes per Frame", std::to_string(this->video->getBytesPerFrame())));
+  if (this->formatDetectionConfidence)
+    info.items.append(
+        InfoItem("Detected Format Confidence",
+                 std::to_string(int(*this->formatDetectionConfidence * 100)) + "%",
+                 "The format was detected from the raw data. This is how sure the detection is."));
 
   if (this->dataSource.isOk() && this->video->isFormatValid() && !this->isY4MFile)
   {
@@ -404,47 +426,15 @@ bool playlistItemRawFile::parseY4MFile()
   if (format.getBitsPerSample() > 8)
     stride *= 2;
 
-  while (true)
-  {
-    // Seek the file to 'offset' and read a few bytes
-    if (this->dataSource.readBytes(rawData, offset, 20) < 20)
-      return setError("Error parsing the Y4M header: The file ended unexpectedly.");
-
-    auto frameIndicator = rawData.mid(0, 5);
-    if (frameIndicator != "FRAME")
-      return setError("Error parsing the Y4M header: Could not locate the next 'FRAME' indicator.");
-
-    // We will now ignore all frame parameters by searching for the next 0x0A byte. I don't know
-    // what we could do with these parameters.
-    offset += 5;
-    int internalOffset = 5;
-    while (rawData.at(internalOffset) != 10 && internalOffset < 20)
-    {
-      offset++;
-      internalOffset++;
-    }
-
-    // Go to the first byte of the YUV frame
-    offset++;
-    internalOffset++;
-
-    if (internalOffset == 19)
-      return setError("Error parsing the Y4M header: The file ended unexpectedly.");
-
-    // Add the frame offset value
-    this->y4mFrameIndices.append(offset);
-    DEBUG_RAWFILE("playlistItemRawFile::parseY4MFile Found FRAME at offset " << offset);
-
-    offset += stride;
-    if (offset >= this->dataSource.getFileSize())
-      break;
-  }
+  this->y4mFrameIndex.reset(offset, stride);
+  if (const auto error = this->y4mFrameIndex.indexFrames(this->dataSource, false))
+    return setError(QString::fromStdString(*error));
 
   // Success. Set the format and return true;
   this->video->setFrameSize(Size(width, height));
   this->getYUVVideo()->setPixelFormatYUV(format);
   DEBUG_RAWFILE("playlistItemRawFile::parseY4MFile Y4M Parsing complete. Found "
-                << this->y4mFrameIndices.size() << " frames");
+                << this->y4mFrameIndex.getNumberFrames() << " frames");
 
   return true;
 }
@@ -537,26 +527,43 @@ playlistItemRawFile *playlistItemRawFile::newplaylistItemRawFile(const YUViewDom
 }
 
 void playlistItemRawFile::loadRawData(int frameIdx)
+{
+  TRACE_SCOPE("file", "playlistItemRawFile::loadRawData", frameIdx);
+
+  // Read into the existing buffer of the video so that no new buffer is allocated per frame
+  if (!this->readRawFrameData(frameIdx, this->video->rawData))
+  {
+    this->video->rawData_frameIndex = -1;
+    return; // Error
+  }
+  this->video->rawData_frameIndex = frameIdx;
+
+  DEBUG_RAWFILE("playlistItemRawFile::loadRawData Frame " << frameIdx << " loaded");
+}
+
+bool playlistItemRawFile::readRawFrameData(int frameIdx, QByteArray &data) const
 {
   if (!this->video->isFormatValid())
-    return;
+    return false;
 
-  auto nrBytes = this->video->getBytesPerFrame();
+  const auto nrBytes = this->video->getBytesPerFrame();
 
-  // Load the raw data for the given frameIdx from file and set it in the video
   int64_t fileStartPos;
   if (this->isY4MFile)
-    fileStartPos = this->y4mFrameIndices.at(frameIdx);
+  {
+    const auto frameDataOffset = this->y4mFrameIndex.getFrameDataOffset(frameIdx);
+    if (!frameDataOffset)
+      return false;
+    fileStartPos = *frameDataOffset;
+  }
   else
     fileStartPos = frameIdx * nrBytes;
 
-  DEBUG_RAWFILE("playlistItemRawFile::loadRawData Start loading frame " << frameIdx << " bytes "
-                                                                        << int(nrBytes));
-  if (this->dataSource.readBytes(this->video->rawData, fileStartPos, nrBytes) < nrBytes)
-    return; // Error
-  this->video->rawData_frameIndex = frameIdx;
-
-  DEBUG_RAWFILE("playlistItemRawFile::loadRawData Frame " << frameIdx << " loaded");
+  DEBUG_RAWFILE("playlistItemRawFile::readRawFrameData Start loading frame "
+                << frameIdx << " bytes " << int(nrBytes));
+  // Shrinking the buffer keeps its memory, so switching between frame sizes does not reallocate
+  data.resize(int(nrBytes));
+  return this->dataSource.readBytesAt(data, fileStartPos, nrBytes) >= nrBytes;
 }
 
 void playlistItemRawFile::slotVideoPropertiesChanged()
@@ -565,7 +572,11 @@ void playlistItemRawFile::slotVideoPropertiesChanged()
 
   auto currentPixelFormat = video->getFormatAsString();
   if (currentPixelFormat != this->pixelFormatAfterLoading)
+  {
     itemMemoryHandler::itemMemoryAddFormat(this->properties().name, currentPixelFormat);
+    // The user changed the detected format
+    this->formatDetectionConfidence.reset();
+  }
 }
 
 ValuePairListSets playlistItemRawFile::getPixelValues(const QPoint &pixelPos, int frameIdx)
@@ -591,6 +602,19 @@ void playlistItemRawFile::getSupportedFileExtensions(QStringList &allExtensions,
   filters.append("Raw CMYK File (*.cmyk)");
 }
 
+bool playlistItemRawFile::isSourceChanged()
+{
+  const auto fileChanged = this->dataSource.getAndResetFileChangedFlag();
+  if (!this->followGrowingFile)
+    return fileChanged;
+
+  // Frames that are appended to the file are added without a reload. Only if the file shrank or
+  // the already loaded part of the file was modified, it must be reloaded.
+  if (fileChanged && !this->isFollowedFileDataUnchanged())
+    return true;
+  return !this->updateFromGrowingFile();
+}
+
 void playlistItemRawFile::reloadItemSource()
 {
   // Reopen the file
@@ -601,7 +625,81 @@ void playlistItemRawFile::reloadItemSource()
 
   this->video->invalidateAllBuffers();
   this->updateStartEndRange();
+  this->setFollowedFileSize(this->dataSource.getFileSize().value_or(0));
+  this->updateFollowGrowingFileSetting();
 
   // Emit that the item needs redrawing and the cache changed.
   emit SignalItemChanged(true, RECACHE_NONE);
 }
+
+void playlistItemRawFile::updateFollowGrowingFileSetting()
+{
+  this->followGrowingFile = QSettings().value("FollowGrowingFiles", false).toBool();
+  if (this->followGrowingFile && this->dataSource.isOk())
+    this->followFileTimer.start(1000, this);
+  else
+    this->followFileTimer.stop();
+}
+
+void playlistItemRawFile::setFollowedFileSize(int64_t fileSize)
+{
+  this->followedFileSize = fileSize;
+  if (const auto checksums = filesource::calculateHeadTailChecksums(this->dataSource, fileSize))
+    this->followedFileChecksums = *checksums;
+}
+
+bool playlistItemRawFile::isFollowedFileDataUnchanged()
+{
+  const auto checksums =
+      filesource::calculateHeadTailChecksums(this->dataSource, this->followedFileSize);
+  return checksums && *checksums == this->followedFileChecksums;
+}
+
+bool playlistItemRawFile::updateFromGrowingFile()
+{
+  const auto fileSize = this->dataSource.getFileSize().value_or(0);
+  if (fileSize < this->followedFileSize)
+  {
+    DEBUG_RAWFILE("playlistItemRawFile::updateFromGrowingFile File was truncated");
+    return false;
+  }
+  if (fileSize == this->followedFileSize)
+    return true;
+  if (!this->isFollowedFileDataUnchanged())
+  {
+    DEBUG_RAWFILE("playlistItemRawFile::updateFromGrowingFile File was modified");
+    return false;
+  }
+  this->setFollowedFileSize(fileSize);
+  this->resetFollowedFileChecks();
+
+  if (this->isY4MFile)
+  {
+    if (const auto error = this->y4mFrameIndex.indexFrames(this->dataSource, true))
+    {
+      this->setError(QString::fromStdString(*error));
+      return false;
+    }
+  }
+
+  const auto previousRange = this->prop.startEndRange;
+  this->updateStartEndRange();
+  if (this->prop.startEndRange != previousRange)
+  {
+    DEBUG_RAWFILE("playlistItemRawFile::updateFromGrowingFile new range "
+                  << this->prop.startEndRange.first << "-" << this->prop.startEndRange.second);
+    // The already cached frames stay valid. Only the new frames must be cached.
+    emit SignalItemChanged(false, RECACHE_UPDATE);
+  }
+  return true;
+}
+
+void playlistItemRawFile::timerEvent(QTimerEvent *event)
+{
+  if (event->timerId() != this->followFileTimer.timerId())
+    return playlistItemWithVideo::timerEvent(event);
+
+  this->countFollowedFileCheck();
+  if (!this->updateFromGrowingFile())
+    this->followFileTimer.stop();
+}
@@ -34,7 +34,10 @@
 
 #include <common/Typedef.h>
 #include <filesource/FileSource.h>
+#include <filesource/HeadTailChecksums.h>
+#include <filesource/Y4MFrameIndex.h>
 
+#include <QBasicTimer>
 #include <QFuture>
 #include <QString>
 
@@ -74,9 +77,18 @@ public:
   static void getSupportedFileExtensions(QStringList &allExtensions, QStringList &filters);
 
   // ----- Detection of source/file change events -----
-  virtual bool isSourceChanged() override { return this->dataSource.getAndResetFileChangedFlag(); }
+  virtual bool isSourceChanged() override;
   virtual void reloadItemSource() override;
-  virtual void updateSettings() override { this->dataSource.updateFileWatchSetting(); }
+  virtual void updateSettings() override
+  {
+    playlistItemWithVideo::updateSettings();
+    this->dataSource.updateFileWatchSetting();
+    this->updateFollowGrowingFileSetting();
+  }
+  virtual bool isFollowingGrowingFile() const override
+  {
+    return this->followFileTimer.isActive() && this->hasFollowedFileGrownRecently();
+  }
 
   // Cache the given frame
   virtual void cacheFrame(int idx, bool testMode) override
@@ -105,6 +117,11 @@ private:
 
   int getNumberFrames() const;
 
+  // Read the raw data of the given frame from file into the given buffer. The buffer is resized to
+  // the frame size so its memory is reused if it is large enough. This does not lock or change the
+  // position of the file so it can be called from multiple caching threads at the same time.
+  bool readRawFrameData(int frameIdx, QByteArray &data) const;
+
   FileSource dataSource;
 
   void updateStartEndRange() override;
@@ -112,9 +129,27 @@ private:
   // A y4m file is a raw YUV file but it adds a header (which has information about the YUV format)
   // and start indicators for every frame. This file will parse the header and save all the byte
   // offsets for each raw YUV frame.
-  bool            parseY4MFile();
-  bool            isY4MFile{};
-  QList<uint64_t> y4mFrameIndices;
+  bool                      parseY4MFile();
+  bool                      isY4MFile{};
+  filesource::Y4MFrameIndex y4mFrameIndex;
+
+  // Tail mode: If the file is still being written (e.g. by an encoder or a capture process), the
+  // frames that are appended to it are added to the range of the item. Already cached frames stay
+  // valid. The file is checked every second. The checksums of the followed part of the file are
+  // used to detect if it was modified instead of only appended to.
+  bool                          followGrowingFile{};
+  int64_t                       followedFileSize{};
+  filesource::HeadTailChecksums followedFileChecksums{};
+  QBasicTimer                   followFileTimer;
+  void                          updateFollowGrowingFileSetting();
+  void                          setFollowedFileSize(int64_t fileSize);
+  bool                          isFollowedFileDataUnchanged();
+  // Returns false if the file can not be followed because it shrank or was modified
+  bool updateFromGrowingFile();
+  void timerEvent(QTimerEvent *event) override;
 
   QString pixelFormatAfterLoading{};
+
+  // If the format was detected from the raw data, this is the confidence of the detection (0 to 1)
+  std::optional<double> formatDetectionConfidence{};
 };
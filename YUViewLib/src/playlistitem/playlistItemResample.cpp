@@ -309,17 +309,21 @@ void playlistItemResample::loadFrame(int frameIdx, bool playing, bool loadRawDat
   if (playing && (state == ItemLoadingState::LoadingNeeded ||
                   state == ItemLoadingState::LoadingNeededDoubleBuffer))
   {
-    // Load the next frame into the double buffer
-    int nextFrameIdx = frameIdx + 1;
-    if (nextFrameIdx <= this->properties().startEndRange.second)
+    // Fill the render-ahead queue with the next frames
+    const auto range              = this->properties().startEndRange;
+    auto       lastLoadedFrameIdx = -1;
+    while (const auto nextFrameIdx = this->video.getNextRenderAheadFrame(frameIdx))
     {
+      if (*nextFrameIdx < range.first || *nextFrameIdx > range.second ||
+          *nextFrameIdx == lastLoadedFrameIdx)
+        break;
       DEBUG_RESAMPLE(
-          "playlistItemResample::loadFrame loading resampled frame into double buffer %d %s",
-          nextFrameIdx,
-          playing ? "(playing)" : "");
+          "playlistItemResample::loadFrame loading resampled frame into render-ahead queue %d",
+          *nextFrameIdx);
       this->isFrameLoadingDoubleBuffer = true;
-      this->video.loadResampledFrame(nextFrameIdx, true);
+      this->video.loadResampledFrame(*nextFrameIdx, true);
       this->isFrameLoadingDoubleBuffer = false;
+      lastLoadedFrameIdx               = *nextFrameIdx;
       if (emitSignals)
         emit signalItemDoubleBufferLoaded();
     }
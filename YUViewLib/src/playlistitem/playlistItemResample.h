@@ -52,7 +52,10 @@ public:
   // Overload from playlistItemVideo. We add some specific drawing functionality if the two children are not comparable.
   virtual void drawItem(QPainter *painter, int frameIdx, double zoomFactor, bool drawRawData) override;
 
-  virtual void activateDoubleBuffer() override { this->video.activateDoubleBuffer(); }
+  virtual void activateDoubleBuffer(int frameIdx) override
+  {
+    this->video.activateDoubleBuffer(frameIdx);
+  }
 
   // Do we need to load the given frame first?
   virtual ItemLoadingState needsLoading(int frameIdx, bool loadRawData) override;
@@ -60,6 +63,16 @@ public:
   virtual void loadFrame(int frameIdx, bool playing, bool loadRawData, bool emitSignals=true) override;
   virtual bool isLoading() const override { return this->isFrameLoading; }
   virtual bool isLoadingDoubleBuffer() const override { return this->isFrameLoadingDoubleBuffer; }
+  virtual void updateSettings() override
+  {
+    playlistItemContainer::updateSettings();
+    this->video.updateSettings();
+  }
+  virtual void setPlaybackStep(int step) override
+  {
+    playlistItem::setPlaybackStep(step);
+    this->video.setPlaybackStep(step);
+  }
 
   // Overload from playlistItem. Save the playlist item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
@@ -33,6 +33,7 @@
 #include "playlistItemStatisticsFile.h"
 
 #include <QDebug>
+#include <QSettings>
 #include <QTime>
 #include <QUrl>
 #include <QtConcurrent>
@@ -71,6 +72,8 @@ playlistItemStatisticsFile::playlistItemStatisticsFile(const QString &itemNameOr
   this->prop.propertiesWidgetTitle = "Statistics File Properties";
   this->prop.providesStatistics    = true;
 
+  this->followGrowingFile = QSettings().value("FollowGrowingFiles", false).toBool();
+
   // Set statistics icon
   setIcon(0, functionsGui::convertIcon(":img_stats.png"));
 
@@ -208,7 +211,21 @@ ValuePairListSets playlistItemStatisticsFile::getPixelValues(const QPoint &pixel
 
 bool playlistItemStatisticsFile::isSourceChanged()
 {
-  return this->file && this->file->isFileChanged();
+  if (!this->file)
+    return false;
+
+  if (!this->followGrowingFile)
+    return this->file->isFileChanged();
+
+  // Data that is appended to the file is indexed in the background (see timerEvent). Only if the
+  // already indexed data was modified, the file must be reloaded.
+  return this->file->isIndexedDataChanged();
+}
+
+bool playlistItemStatisticsFile::isFollowingGrowingFile() const
+{
+  return this->followGrowingFile && this->file && !this->file->isIndexedDataChanged() &&
+         this->hasFollowedFileGrownRecently();
 }
 
 void playlistItemStatisticsFile::updateSettings()
@@ -216,6 +233,10 @@ void playlistItemStatisticsFile::updateSettings()
   this->statisticsUIHandler.updateSettings();
   if (this->file)
     this->file->updateSettings();
+
+  this->followGrowingFile = QSettings().value("FollowGrowingFiles", false).toBool();
+  if (this->followGrowingFile && !this->timer.isActive())
+    this->timer.start(1000, this);
 }
 
 void playlistItemStatisticsFile::getSupportedFileExtensions(QStringList &allExtensions,
@@ -241,7 +262,9 @@ void playlistItemStatisticsFile::onPOCParsed(int poc)
   if (poc == this->currentDrawnFrameIdx)
     emit SignalItemChanged(true, RECACHE_NONE);
 
-  this->statisticsData.setFrameIndex(-1);
+  // Only the loaded data of this POC may be incomplete. Data of other POCs stays valid.
+  if (poc == this->statisticsData.getFrameIndex())
+    this->statisticsData.setFrameIndex(-1);
 }
 
 void playlistItemStatisticsFile::createPropertiesWidget()
@@ -295,16 +318,22 @@ void playlistItemStatisticsFile::openStatisticsFile()
           this,
           &playlistItemStatisticsFile::onPOCTypeParsed);
 
-  // Run the parsing of the file in the background
+  this->startBackgroundParsing();
+
+  DEBUG_STAT(
+      "playlistItemStatisticsFile::openStatisticsFile File opened. Background parsing started.");
+}
+
+void playlistItemStatisticsFile::startBackgroundParsing()
+{
+  // Run the parsing of the file in the background. If the file was parsed before, only the data
+  // that was appended since then is parsed.
   this->timer.start(1000, this);
   this->breakBackgroundAtomic.store(false);
   this->backgroundParserFuture = QtConcurrent::run(
       [=](stats::StatisticsFileBase *file)
       { file->readFrameAndTypePositionsFromFile(std::ref(this->breakBackgroundAtomic)); },
       this->file.get());
-
-  DEBUG_STAT(
-      "playlistItemStatisticsFile::openStatisticsFile File opened. Background parsing started.");
 }
 
 // This timer event is called regularly when the background loading process is running.
@@ -315,8 +344,21 @@ void playlistItemStatisticsFile::timerEvent(QTimerEvent *event)
 
   if (!backgroundParserFuture.isRunning())
   {
-    timer.stop();
-    DEBUG_STAT("playlistItemStatisticsFile::timerEvent Background parsing done.");
+    this->countFollowedFileCheck();
+    // While following the file, a change that does not change the file size must also be checked.
+    // Indexing again finds out if only data was appended or if indexed data was modified.
+    const auto following =
+        this->followGrowingFile && this->file && !this->file->isIndexedDataChanged();
+    if (following && (this->file->isFileChanged() || this->file->hasUnindexedData()))
+    {
+      this->resetFollowedFileChecks();
+      this->startBackgroundParsing();
+    }
+    else if (!this->followGrowingFile || !this->file || this->file->isIndexedDataChanged())
+    {
+      timer.stop();
+      DEBUG_STAT("playlistItemStatisticsFile::timerEvent Background parsing done.");
+    }
   }
 
   if (this->file)
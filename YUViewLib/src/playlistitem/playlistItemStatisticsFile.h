@@ -96,6 +96,7 @@ public:
   // ----- Detection of source/file change events -----
   virtual bool isSourceChanged() override;
   virtual void updateSettings() override;
+  virtual bool isFollowingGrowingFile() const override;
 
   static void getSupportedFileExtensions(QStringList &allExtensions, QStringList &filters);
 
@@ -109,6 +110,7 @@ protected:
   virtual void createPropertiesWidget() override;
 
   void openStatisticsFile();
+  void startBackgroundParsing();
 
   stats::StatisticUIHandler statisticsUIHandler;
   stats::StatisticsData     statisticsData;
@@ -122,7 +124,11 @@ protected:
   QFuture<void>    backgroundParserFuture;
   std::atomic_bool breakBackgroundAtomic;
 
-  // A timer is used to frequently update the status of the background process (every second)
+  // If set, the file is polled for appended data which is then indexed in the background
+  bool followGrowingFile{};
+
+  // A timer is used to frequently update the status of the background process (every second).
+  // When following a growing file, the timer keeps running to poll the file for new data.
   QBasicTimer timer;
   virtual void
   timerEvent(QTimerEvent *event) override; // Overloaded from QObject. Called when the timer fires.
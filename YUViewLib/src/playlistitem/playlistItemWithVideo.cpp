@@ -116,17 +116,20 @@ void playlistItemWithVideo::loadFrame(int  frameIdx,
   if (playing && (state == ItemLoadingState::LoadingNeeded ||
                   state == ItemLoadingState::LoadingNeededDoubleBuffer))
   {
-    // Load the next frame into the double buffer
-    int nextFrameIdx = frameIdx + 1;
-    if (nextFrameIdx <= properties().startEndRange.second)
+    // Fill the render-ahead queue with the next frames
+    const auto range              = properties().startEndRange;
+    auto       lastLoadedFrameIdx = -1;
+    while (const auto nextFrameIdx = video->getNextRenderAheadFrame(frameIdx))
     {
-      DEBUG_PLVIDEO("playlistItemWithVideo::loadFrame loading frame into double buffer %d%s%s",
-                    nextFrameIdx,
-                    playing ? " playing" : "",
-                    loadRawData ? " raw" : "");
+      if (*nextFrameIdx < range.first || *nextFrameIdx > range.second ||
+          *nextFrameIdx == lastLoadedFrameIdx)
+        break;
+      DEBUG_PLVIDEO("playlistItemWithVideo::loadFrame loading frame %d into render-ahead queue",
+                    *nextFrameIdx);
       isFrameLoadingDoubleBuffer = true;
-      video->loadFrame(nextFrameIdx, true);
+      video->loadFrame(*nextFrameIdx, true);
       isFrameLoadingDoubleBuffer = false;
+      lastLoadedFrameIdx         = *nextFrameIdx;
       if (emitSignals)
         emit signalItemDoubleBufferLoaded();
     }
@@ -54,10 +54,21 @@ public:
   // All the functions that we have to overload if we are using a video handler
   virtual QSize                getSize() const override;
   virtual video::FrameHandler *getFrameHandler() override { return this->video.get(); }
-  virtual void                 activateDoubleBuffer() override
+  virtual void                 activateDoubleBuffer(int frameIdx) override
   {
     if (video)
-      video->activateDoubleBuffer();
+      video->activateDoubleBuffer(frameIdx);
+  }
+  virtual void setPlaybackStep(int step) override
+  {
+    playlistItem::setPlaybackStep(step);
+    if (video)
+      video->setPlaybackStep(step);
+  }
+  virtual void updateSettings() override
+  {
+    if (video)
+      video->updateSettings();
   }
 
   // Do we need to load the frame first?
@@ -88,6 +99,10 @@ public:
     if (video)
       video->removeFrameFromCache(frameIdx);
   }
+  virtual uint64_t getCachedFrameLastAccess(int frameIdx) const override
+  {
+    return video ? video->getCachedFrameLastAccess(frameIdx) : 0;
+  }
   virtual void removeAllFramesFromCache() override
   {
     if (video)
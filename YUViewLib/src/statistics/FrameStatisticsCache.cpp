@@ -0,0 +1,143 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameStatisticsCache.h"
+
+#include <algorithm>
+
+namespace stats
+{
+
+namespace
+{
+
+int64_t compactAndGetMemoryUsage(FrameStatisticsCache::FrameData &frameData)
+{
+  int64_t bytes = 0;
+  for (auto &[typeID, typeData] : frameData)
+  {
+    typeData.shrinkToFit();
+    bytes += static_cast<int64_t>(typeData.getMemoryUsageInBytes());
+  }
+  return bytes;
+}
+
+} // namespace
+
+void FrameStatisticsCache::setMaxBytes(int64_t bytes)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->maxBytes = bytes;
+  this->dropLeastRecentlyUsedFramesUntilFits();
+}
+
+int64_t FrameStatisticsCache::getMaxBytes() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->maxBytes;
+}
+
+void FrameStatisticsCache::addFrame(int frameIdx, FrameData frameData)
+{
+  const auto bytes = compactAndGetMemoryUsage(frameData);
+
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  if (bytes > this->maxBytes)
+    return;
+
+  auto &cachedFrame = this->frames[frameIdx];
+  this->usedBytes += bytes - cachedFrame.bytes;
+  cachedFrame.data       = std::move(frameData);
+  cachedFrame.bytes      = bytes;
+  cachedFrame.lastAccess = ++this->accessCounter;
+  this->dropLeastRecentlyUsedFramesUntilFits();
+}
+
+std::optional<FrameStatisticsCache::FrameData> FrameStatisticsCache::getFrame(int frameIdx)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  auto                         it = this->frames.find(frameIdx);
+  if (it == this->frames.end())
+    return {};
+  it->second.lastAccess = ++this->accessCounter;
+  return it->second.data;
+}
+
+bool FrameStatisticsCache::contains(int frameIdx) const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->frames.count(frameIdx) > 0;
+}
+
+void FrameStatisticsCache::clear()
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->frames.clear();
+  this->usedBytes = 0;
+}
+
+void FrameStatisticsCache::removeFramesFrom(int frameIdx)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  for (auto it = this->frames.lower_bound(frameIdx); it != this->frames.end();)
+  {
+    this->usedBytes -= it->second.bytes;
+    it = this->frames.erase(it);
+  }
+}
+
+int FrameStatisticsCache::getNumberFrames() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return static_cast<int>(this->frames.size());
+}
+
+int64_t FrameStatisticsCache::getUsedBytes() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->usedBytes;
+}
+
+void FrameStatisticsCache::dropLeastRecentlyUsedFramesUntilFits()
+{
+  while (this->usedBytes > this->maxBytes && !this->frames.empty())
+  {
+    auto leastRecentlyUsed = std::min_element(
+        this->frames.begin(), this->frames.end(), [](const auto &lhs, const auto &rhs) {
+          return lhs.second.lastAccess < rhs.second.lastAccess;
+        });
+    this->usedBytes -= leastRecentlyUsed->second.bytes;
+    this->frames.erase(leastRecentlyUsed);
+  }
+}
+
+} // namespace stats
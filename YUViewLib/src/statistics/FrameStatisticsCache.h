@@ -0,0 +1,100 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FrameTypeData.h"
+
+#include <common/MemoryAccountant.h>
+
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace stats
+{
+
+/* A cache of the statistics of multiple frames. Decoders can only provide the statistics of the
+ * frame that was just decoded. When the caching decoder runs ahead, the statistics of every frame
+ * it decodes are kept in here so that stepping through the frames with statistics overlays does
+ * not require to seek and decode again. The data of each frame is compacted when it is added.
+ * If the byte budget is exceeded, the frames that were accessed least recently are dropped. The
+ * used memory is reported to the MemoryAccountant so the video cache budget shrinks accordingly.
+ * All functions are thread-safe.
+ */
+class FrameStatisticsCache
+{
+public:
+  // The statistics of one frame [statsTypeID]
+  using FrameData = std::map<int, FrameTypeData>;
+
+  FrameStatisticsCache() = default;
+  FrameStatisticsCache(int64_t maxBytes) : maxBytes(maxBytes) {}
+
+  void    setMaxBytes(int64_t bytes);
+  int64_t getMaxBytes() const;
+
+  // Add (or replace) the statistics of the given frame
+  void addFrame(int frameIdx, FrameData frameData);
+
+  std::optional<FrameData> getFrame(int frameIdx);
+  bool                     contains(int frameIdx) const;
+
+  void clear();
+  // Remove the statistics of all frames with an index of at least the given index
+  void removeFramesFrom(int frameIdx);
+
+  int     getNumberFrames() const;
+  int64_t getUsedBytes() const;
+
+private:
+  struct CachedFrame
+  {
+    FrameData data;
+    int64_t   bytes{};
+    uint64_t  lastAccess{};
+  };
+
+  void dropLeastRecentlyUsedFramesUntilFits();
+
+  mutable std::mutex         accessMutex;
+  std::map<int, CachedFrame> frames;
+  int64_t                    usedBytes{0};
+  int64_t                    maxBytes{0};
+  uint64_t                   accessCounter{0};
+
+  // Declared last so that it is removed before the data that it reports
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Statistics", [this] { return this->getUsedBytes(); })};
+};
+
+} // namespace stats
@@ -32,38 +32,159 @@
 
 #include "FrameTypeData.h"
 
+#include <algorithm>
+
 namespace stats
 {
 
+namespace
+{
+
+template <typename T> size_t getVectorMemoryUsage(const std::vector<T> &vector)
+{
+  return vector.capacity() * sizeof(T);
+}
+
+size_t getVectorMemoryUsage(const std::vector<bool> &vector)
+{
+  return (vector.capacity() + 7) / 8;
+}
+
+} // namespace
+
+void BlockColumns::append(unsigned short x, unsigned short y, unsigned short w, unsigned short h)
+{
+  if (this->sizeRuns.empty() || this->sizeRuns.back().width != w ||
+      this->sizeRuns.back().height != h)
+    this->sizeRuns.push_back({uint32_t(this->posX.size()), w, h});
+
+  this->posX.push_back(x);
+  this->posY.push_back(y);
+}
+
+size_t BlockColumns::findCursor(size_t index) const
+{
+  // Find the last run that starts at or before the index
+  auto run = std::upper_bound(
+      this->sizeRuns.begin(),
+      this->sizeRuns.end(),
+      index,
+      [](size_t index, const BlockSizeRun &run) { return index < run.firstIndex; });
+  return size_t(std::distance(this->sizeRuns.begin(), run)) - 1;
+}
+
+void BlockColumns::shrinkToFit()
+{
+  this->posX.shrink_to_fit();
+  this->posY.shrink_to_fit();
+  this->sizeRuns.shrink_to_fit();
+}
+
+size_t BlockColumns::getMemoryUsageInBytes() const
+{
+  return getVectorMemoryUsage(this->posX) + getVectorMemoryUsage(this->posY) +
+         getVectorMemoryUsage(this->sizeRuns);
+}
+
+void PolygonColumns::append(const Polygon &corners)
+{
+  this->vertexOffsets.push_back(uint32_t(this->vertices.size()));
+  this->vertices.insert(this->vertices.end(), corners.begin(), corners.end());
+}
+
+void PolygonColumns::shrinkToFit()
+{
+  this->vertices.shrink_to_fit();
+  this->vertexOffsets.shrink_to_fit();
+}
+
+size_t PolygonColumns::getMemoryUsageInBytes() const
+{
+  return getVectorMemoryUsage(this->vertices) + getVectorMemoryUsage(this->vertexOffsets);
+}
+
+void ValueColumns::shrinkToFit()
+{
+  BlockColumns::shrinkToFit();
+  this->values.shrink_to_fit();
+}
+
+size_t ValueColumns::getMemoryUsageInBytes() const
+{
+  return BlockColumns::getMemoryUsageInBytes() + getVectorMemoryUsage(this->values);
+}
+
+void VectorColumns::shrinkToFit()
+{
+  BlockColumns::shrinkToFit();
+  this->points.shrink_to_fit();
+  this->isLine.shrink_to_fit();
+  this->lineEndPoints.shrink_to_fit();
+}
+
+size_t VectorColumns::getMemoryUsageInBytes() const
+{
+  return BlockColumns::getMemoryUsageInBytes() + getVectorMemoryUsage(this->points) +
+         getVectorMemoryUsage(this->isLine) + getVectorMemoryUsage(this->lineEndPoints);
+}
+
+void AffineTFColumns::shrinkToFit()
+{
+  BlockColumns::shrinkToFit();
+  this->points.shrink_to_fit();
+}
+
+size_t AffineTFColumns::getMemoryUsageInBytes() const
+{
+  return BlockColumns::getMemoryUsageInBytes() + getVectorMemoryUsage(this->points);
+}
+
+void PolygonValueColumns::shrinkToFit()
+{
+  PolygonColumns::shrinkToFit();
+  this->values.shrink_to_fit();
+}
+
+size_t PolygonValueColumns::getMemoryUsageInBytes() const
+{
+  return PolygonColumns::getMemoryUsageInBytes() + getVectorMemoryUsage(this->values);
+}
+
+void PolygonVectorColumns::shrinkToFit()
+{
+  PolygonColumns::shrinkToFit();
+  this->points.shrink_to_fit();
+}
+
+size_t PolygonVectorColumns::getMemoryUsageInBytes() const
+{
+  return PolygonColumns::getMemoryUsageInBytes() + getVectorMemoryUsage(this->points);
+}
+
 void FrameTypeData::addBlockValue(
     unsigned short x, unsigned short y, unsigned short w, unsigned short h, int val)
 {
-  StatsItemValue value;
-  value.pos[0]  = x;
-  value.pos[1]  = y;
-  value.size[0] = w;
-  value.size[1] = h;
-  value.value   = val;
-
   // Always keep the biggest block size updated.
   unsigned int wh = w * h;
   if (wh > maxBlockSize)
     maxBlockSize = wh;
 
-  valueData.push_back(value);
+  auto &columns = this->valueData.columns;
+  columns.append(x, y, w, h);
+  columns.values.push_back(val);
 }
 
 void FrameTypeData::addBlockVector(
     unsigned short x, unsigned short y, unsigned short w, unsigned short h, int vecX, int vecY)
 {
-  StatsItemVector vec;
-  vec.pos[0]   = x;
-  vec.pos[1]   = y;
-  vec.size[0]  = w;
-  vec.size[1]  = h;
-  vec.point[0] = Point(vecX, vecY);
-  vec.isLine   = false;
-  vectorData.push_back(vec);
+  auto &columns = this->vectorData.columns;
+  columns.append(x, y, w, h);
+  columns.points.push_back(Point(vecX, vecY));
+  if (!columns.isLine.empty())
+  {
+    columns.isLine.push_back(false);
+    columns.lineEndPoints.push_back(Point(0, 0));
+  }
 }
 
 void FrameTypeData::addBlockAffineTF(unsigned short x,
@@ -77,15 +198,11 @@ void FrameTypeData::addBlockAffineTF(unsigned short x,
                                      int            vecX2,
                                      int            vecY2)
 {
-  StatsItemAffineTF affineTF;
-  affineTF.pos[0]   = x;
-  affineTF.pos[1]   = y;
-  affineTF.size[0]  = w;
-  affineTF.size[1]  = h;
-  affineTF.point[0] = Point(vecX0, vecY0);
-  affineTF.point[1] = Point(vecX1, vecY1);
-  affineTF.point[2] = Point(vecX2, vecY2);
-  affineTFData.push_back(affineTF);
+  auto &columns = this->affineTFData.columns;
+  columns.append(x, y, w, h);
+  columns.points.push_back(Point(vecX0, vecY0));
+  columns.points.push_back(Point(vecX1, vecY1));
+  columns.points.push_back(Point(vecX2, vecY2));
 }
 
 void FrameTypeData::addLine(unsigned short x,
@@ -97,38 +214,54 @@ void FrameTypeData::addLine(unsigned short x,
                             int            x2,
                             int            y2)
 {
-  StatsItemVector vec;
-  vec.pos[0]   = x;
-  vec.pos[1]   = y;
-  vec.size[0]  = w;
-  vec.size[1]  = h;
-  vec.point[0] = Point(x1, y1);
-  vec.point[1] = Point(x2, y2);
-  vec.isLine   = true;
-  vectorData.push_back(vec);
+  auto &columns = this->vectorData.columns;
+
+  // The line columns are only filled once the first line is added. All vectors before are no lines.
+  columns.isLine.resize(columns.size(), false);
+  columns.lineEndPoints.resize(columns.size(), Point(0, 0));
+
+  columns.append(x, y, w, h);
+  columns.points.push_back(Point(x1, y1));
+  columns.isLine.push_back(true);
+  columns.lineEndPoints.push_back(Point(x2, y2));
 }
 
 void FrameTypeData::addPolygonValue(const Polygon &points, int val)
 {
-  StatsItemPolygonValue value;
-  value.corners = points;
-  value.value   = val;
-
   // todo: how to do this nicely?
   //  // Always keep the biggest block size updated.
   //  unsigned int wh = w*h;
   //  if (wh > maxBlockSize)
   //    maxBlockSize = wh;
 
-  polygonValueData.push_back(value);
+  auto &columns = this->polygonValueData.columns;
+  columns.append(points);
+  columns.values.push_back(val);
 }
 
 void FrameTypeData::addPolygonVector(const Polygon &points, int vecX, int vecY)
 {
-  StatsItemPolygonVector vec;
-  vec.corners = points;
-  vec.point   = Point(vecX, vecY);
-  polygonVectorData.push_back(vec);
+  auto &columns = this->polygonVectorData.columns;
+  columns.append(points);
+  columns.points.push_back(Point(vecX, vecY));
+}
+
+void FrameTypeData::shrinkToFit()
+{
+  this->valueData.columns.shrinkToFit();
+  this->vectorData.columns.shrinkToFit();
+  this->affineTFData.columns.shrinkToFit();
+  this->polygonValueData.columns.shrinkToFit();
+  this->polygonVectorData.columns.shrinkToFit();
+}
+
+size_t FrameTypeData::getMemoryUsageInBytes() const
+{
+  return this->valueData.columns.getMemoryUsageInBytes() +
+         this->vectorData.columns.getMemoryUsageInBytes() +
+         this->affineTFData.columns.getMemoryUsageInBytes() +
+         this->polygonValueData.columns.getMemoryUsageInBytes() +
+         this->polygonVectorData.columns.getMemoryUsageInBytes();
 }
 
 } // namespace stats
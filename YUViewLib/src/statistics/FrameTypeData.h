@@ -34,6 +34,9 @@
 
 #include <common/Typedef.h>
 
+#include <cstdint>
+#include <stdexcept>
+
 namespace stats
 {
 
@@ -66,6 +69,29 @@ struct Line
 
 using Polygon = std::vector<Point>;
 
+// A view of the corners of a polygon which are stored in the vertex buffer of a polygon list.
+class PolygonView
+{
+public:
+  PolygonView() = default;
+  PolygonView(const Point *first, size_t count) : first(first), count(count) {}
+
+  size_t       size() const { return this->count; }
+  bool         empty() const { return this->count == 0; }
+  const Point *begin() const { return this->first; }
+  const Point *end() const { return this->first + this->count; }
+  const Point &operator[](size_t index) const { return this->first[index]; }
+  const Point &front() const { return this->first[0]; }
+  const Point &back() const { return this->first[this->count - 1]; }
+
+private:
+  const Point *first{};
+  size_t       count{};
+};
+
+// The items below are returned by value when iterating over the lists of a FrameTypeData. The
+// data itself is stored column wise in the lists.
+
 struct StatsItemValue
 {
   // The position and size of the item. (max 65535)
@@ -99,7 +125,7 @@ struct StatsItemAffineTF
 struct StatsItemPolygonValue
 {
   // The position and size of the item.
-  Polygon corners;
+  PolygonView corners;
 
   // The actual value
   int value;
@@ -108,11 +134,234 @@ struct StatsItemPolygonValue
 struct StatsItemPolygonVector
 {
   // The position and size of the item.
-  Polygon corners;
+  PolygonView corners;
 
   Point point;
 };
 
+// All blocks starting at firstIndex (up to the next run) have the same size.
+struct BlockSizeRun
+{
+  uint32_t       firstIndex;
+  unsigned short width;
+  unsigned short height;
+};
+
+// The positions and sizes of rectangular blocks. Statistics are mostly given on uniform grids (e.g.
+// all 4x4 blocks) so the sizes are run-length encoded.
+class BlockColumns
+{
+public:
+  void append(unsigned short x, unsigned short y, unsigned short w, unsigned short h);
+
+  size_t size() const { return this->posX.size(); }
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  // The cursor of a block is the index of its size run. It is advanced while iterating so that
+  // the size of a block never has to be searched.
+  size_t findCursor(size_t index) const;
+  size_t advanceCursor(size_t index, size_t cursor) const
+  {
+    const auto nextRun = cursor + 1;
+    if (nextRun < this->sizeRuns.size() && this->sizeRuns[nextRun].firstIndex <= index)
+      return nextRun;
+    return cursor;
+  }
+
+  void getBlock(size_t index, size_t cursor, unsigned short pos[2], unsigned short size[2]) const
+  {
+    pos[0]  = this->posX[index];
+    pos[1]  = this->posY[index];
+    size[0] = this->sizeRuns[cursor].width;
+    size[1] = this->sizeRuns[cursor].height;
+  }
+
+  std::vector<unsigned short> posX;
+  std::vector<unsigned short> posY;
+  std::vector<BlockSizeRun>   sizeRuns;
+};
+
+// The corners of all polygons of a list are stored in one vertex buffer. The corners of polygon i
+// start at vertexOffsets[i].
+class PolygonColumns
+{
+public:
+  void append(const Polygon &corners);
+
+  size_t size() const { return this->vertexOffsets.size(); }
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  size_t findCursor(size_t) const { return 0; }
+  size_t advanceCursor(size_t, size_t) const { return 0; }
+
+  PolygonView getPolygon(size_t index) const
+  {
+    const auto first = this->vertexOffsets[index];
+    const auto last  = (index + 1 < this->vertexOffsets.size()) ? this->vertexOffsets[index + 1]
+                                                                : this->vertices.size();
+    return PolygonView(this->vertices.data() + first, last - first);
+  }
+
+  std::vector<Point>    vertices;
+  std::vector<uint32_t> vertexOffsets;
+};
+
+struct ValueColumns : BlockColumns
+{
+  using Item = StatsItemValue;
+
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  StatsItemValue getItem(size_t index, size_t cursor) const
+  {
+    StatsItemValue item;
+    this->getBlock(index, cursor, item.pos, item.size);
+    item.value = this->values[index];
+    return item;
+  }
+
+  std::vector<int> values;
+};
+
+struct VectorColumns : BlockColumns
+{
+  using Item = StatsItemVector;
+
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  StatsItemVector getItem(size_t index, size_t cursor) const
+  {
+    StatsItemVector item;
+    this->getBlock(index, cursor, item.pos, item.size);
+    item.point[0] = this->points[index];
+    item.isLine   = !this->isLine.empty() && this->isLine[index];
+    item.point[1] = item.isLine ? this->lineEndPoints[index] : Point(0, 0);
+    return item;
+  }
+
+  std::vector<Point> points;
+  // Only filled once the first line was added
+  std::vector<bool>  isLine;
+  std::vector<Point> lineEndPoints;
+};
+
+struct AffineTFColumns : BlockColumns
+{
+  using Item = StatsItemAffineTF;
+
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  StatsItemAffineTF getItem(size_t index, size_t cursor) const
+  {
+    StatsItemAffineTF item;
+    this->getBlock(index, cursor, item.pos, item.size);
+    for (size_t i = 0; i < 3; i++)
+      item.point[i] = this->points[index * 3 + i];
+    return item;
+  }
+
+  std::vector<Point> points; // Three points per block
+};
+
+struct PolygonValueColumns : PolygonColumns
+{
+  using Item = StatsItemPolygonValue;
+
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  StatsItemPolygonValue getItem(size_t index, size_t) const
+  {
+    return {this->getPolygon(index), this->values[index]};
+  }
+
+  std::vector<int> values;
+};
+
+struct PolygonVectorColumns : PolygonColumns
+{
+  using Item = StatsItemPolygonVector;
+
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  StatsItemPolygonVector getItem(size_t index, size_t) const
+  {
+    return {this->getPolygon(index), this->points[index]};
+  }
+
+  std::vector<Point> points;
+};
+
+// A read only list of statistics items. The items are stored column wise (struct of arrays) and
+// are assembled on access.
+template <typename Columns> class ItemList
+{
+public:
+  using Item = typename Columns::Item;
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Item;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = Item;
+
+    const_iterator(const ItemList *list, size_t index, size_t cursor)
+        : list(list), index(index), cursor(cursor)
+    {
+    }
+
+    Item operator*() const { return this->list->columns.getItem(this->index, this->cursor); }
+
+    const_iterator &operator++()
+    {
+      this->index++;
+      this->cursor = this->list->columns.advanceCursor(this->index, this->cursor);
+      return *this;
+    }
+    bool operator==(const const_iterator &other) const { return this->index == other.index; }
+    bool operator!=(const const_iterator &other) const { return this->index != other.index; }
+
+  private:
+    const ItemList *list{};
+    size_t          index{};
+    size_t          cursor{};
+  };
+
+  size_t size() const { return this->columns.size(); }
+  bool   empty() const { return this->size() == 0; }
+
+  const_iterator begin() const { return const_iterator(this, 0, 0); }
+  const_iterator end() const { return const_iterator(this, this->size(), 0); }
+
+  Item operator[](size_t index) const
+  {
+    return this->columns.getItem(index, this->columns.findCursor(index));
+  }
+  Item at(size_t index) const
+  {
+    if (index >= this->size())
+      throw std::out_of_range("Statistics item index out of range");
+    return (*this)[index];
+  }
+
+  Columns columns;
+};
+
+using ValueList         = ItemList<ValueColumns>;
+using VectorList        = ItemList<VectorColumns>;
+using AffineTFList      = ItemList<AffineTFColumns>;
+using PolygonValueList  = ItemList<PolygonValueColumns>;
+using PolygonVectorList = ItemList<PolygonVectorColumns>;
+
 // A collection of statistics data (value and vector) for a certain context (for example for a
 // certain type and a certain POC).
 class FrameTypeData
@@ -144,11 +393,15 @@ public:
   void addPolygonVector(const Polygon &points, int vecX, int vecY);
   void addPolygonValue(const Polygon &points, int val);
 
-  std::vector<StatsItemValue>         valueData;
-  std::vector<StatsItemVector>        vectorData;
-  std::vector<StatsItemAffineTF>      affineTFData;
-  std::vector<StatsItemPolygonValue>  polygonValueData;
-  std::vector<StatsItemPolygonVector> polygonVectorData;
+  // Release all unused reserved memory
+  void   shrinkToFit();
+  size_t getMemoryUsageInBytes() const;
+
+  ValueList         valueData;
+  VectorList        vectorData;
+  AffineTFList      affineTFData;
+  PolygonValueList  polygonValueData;
+  PolygonVectorList polygonVectorData;
 
   // What is the size (area) of the biggest block)? This is needed for scaling the blocks according
   // to their size.
@@ -98,7 +98,7 @@ bool doesLineIntersectWithHorizontalLine(const Line side, const Point pt)
   return doLinesIntersect;
 }
 
-bool polygonContainsPoint(const stats::Polygon &polygon, const Point &pt)
+bool polygonContainsPoint(const stats::PolygonView &polygon, const Point &pt)
 {
   if (polygon.empty())
     return false;
@@ -108,7 +108,7 @@ bool polygonContainsPoint(const stats::Polygon &polygon, const Point &pt)
   unsigned intersections = 0;
   for (size_t i = 0; i < numPts - 1; i++)
   {
-    Line side = Line(polygon.at(i), polygon.at(i + 1));
+    Line side = Line(polygon[i], polygon[i + 1]);
     // Test if current side intersects with ray.
     if (doesLineIntersectWithHorizontalLine(side, pt))
       intersections++;
@@ -309,6 +309,20 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
   return valueList;
 }
 
+int64_t StatisticsData::getMemoryUsageInBytes() const
+{
+  // Don't wait for a running loading operation. Report what we know.
+  std::unique_lock<std::mutex> lock(this->accessMutex, std::try_to_lock);
+  if (!lock.owns_lock())
+    return this->lastMemoryUsage;
+
+  int64_t bytes = 0;
+  for (const auto &typeData : this->frameCache)
+    bytes += typeData.second.getMemoryUsageInBytes();
+  this->lastMemoryUsage = bytes;
+  return bytes;
+}
+
 void StatisticsData::clear()
 {
   this->frameCache.clear();
@@ -329,6 +343,19 @@ void StatisticsData::setFrameIndex(int frameIndex)
   }
 }
 
+std::map<int, FrameTypeData> StatisticsData::getFrameData() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->frameCache;
+}
+
+void StatisticsData::setFrameData(int frameIndex, std::map<int, FrameTypeData> frameData)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->frameCache = std::move(frameData);
+  this->frameIdx   = frameIndex;
+}
+
 void StatisticsData::addStatType(const StatisticsType &type)
 {
   if (type.typeID == -1)
@@ -35,6 +35,9 @@
 #include "FrameTypeData.h"
 #include "StatisticsType.h"
 
+#include <common/MemoryAccountant.h>
+
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -59,11 +62,18 @@ public:
   bool                hasDataForTypeID(int typeID) { return this->frameCache.count(typeID) > 0; }
   void                eraseDataForTypeID(int typeID) { this->frameCache.erase(typeID); }
 
+  int64_t getMemoryUsageInBytes() const;
+
   void clear();
   void setFrameSize(Size size) { this->frameSize = size; }
   void setFrameIndex(int frameIndex);
   void addStatType(const StatisticsType &type);
 
+  // Get a copy of the data of all types of the current frame or replace it (e.g. with data from a
+  // FrameStatisticsCache).
+  std::map<int, FrameTypeData> getFrameData() const;
+  void                         setFrameData(int frameIndex, std::map<int, FrameTypeData> frameData);
+
   void savePlaylist(YUViewDomElement &root) const;
   void loadPlaylist(const YUViewDomElement &root);
 
@@ -80,6 +90,12 @@ private:
   Size frameSize;
 
   StatisticsTypesVec statsTypes;
+
+  mutable std::atomic<int64_t> lastMemoryUsage{0};
+
+  // Declared last so that it is removed before the data that it reports
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Statistics", [this] { return this->getMemoryUsageInBytes(); })};
 };
 
 } // namespace stats
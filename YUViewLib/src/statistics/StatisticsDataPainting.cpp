@@ -33,6 +33,7 @@
 #include "StatisticsDataPainting.h"
 
 #include <common/FunctionsGui.h>
+#include <common/GlyphAtlas.h>
 #include <statistics/StatisticsType.h>
 
 #include <QPainter>
@@ -52,7 +53,7 @@ namespace
 #define DEBUG_PAINT(fmt, ...) ((void)0)
 #endif
 
-QPolygon convertToQPolygon(const stats::Polygon &poly)
+QPolygon convertToQPolygon(const stats::PolygonView &poly)
 {
   if (poly.empty())
     return QPolygon();
@@ -93,6 +94,7 @@ QPen styleToPen(stats::LineDrawStyle &style)
 }
 
 void paintVector(QPainter *                   painter,
+                 GlyphBatch &                 glyphBatch,
                  const stats::StatisticsType &statisticsType,
                  const double &               zoomFactor,
                  const int &                  x1,
@@ -194,8 +196,8 @@ void paintVector(QPainter *                   painter,
           auto txt1 = QString("(%1, %2)").arg(x1 / zoomFactor).arg(y1 / zoomFactor);
           auto txt2 = QString("(%1, %2)").arg(x2 / zoomFactor).arg(y2 / zoomFactor);
 
-          auto textRect1 = painter->boundingRect(QRect(), Qt::AlignLeft, txt1);
-          auto textRect2 = painter->boundingRect(QRect(), Qt::AlignLeft, txt2);
+          auto textRect1 = glyphBatch.boundingRect(Qt::AlignLeft, txt1);
+          auto textRect2 = glyphBatch.boundingRect(Qt::AlignLeft, txt2);
 
           textRect1.moveCenter(QPoint(x1, y1));
           textRect2.moveCenter(QPoint(x2, y2));
@@ -223,14 +225,14 @@ void paintVector(QPainter *                   painter,
             textRect2.moveRight(x2);
           }
 
-          painter->drawText(textRect1, Qt::AlignLeft, txt1);
-          painter->drawText(textRect2, Qt::AlignLeft, txt2);
+          glyphBatch.drawText(textRect1, Qt::AlignLeft, txt1);
+          glyphBatch.drawText(textRect2, Qt::AlignLeft, txt2);
         }
         else
         {
           // Also draw the vector value next to the arrow head
           auto txt      = QString("x %1\ny %2").arg(vx).arg(vy);
-          auto textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
+          auto textRect = glyphBatch.boundingRect(Qt::AlignLeft, txt);
           textRect.moveCenter(QPoint(x2, y2));
           int a = qRadiansToDegrees(angle);
           if (a < 45 && a > -45)
@@ -241,7 +243,7 @@ void paintVector(QPainter *                   painter,
             textRect.moveTop(y2);
           else
             textRect.moveRight(x2);
-          painter->drawText(textRect, Qt::AlignLeft, txt);
+          glyphBatch.drawText(textRect, Qt::AlignLeft, txt);
         }
       }
     }
@@ -286,6 +288,9 @@ void stats::paintStatisticsData(QPainter *             painter,
 
   painter->translate(statRect.topLeft());
 
+  // All value labels are drawn in one go from a glyph atlas
+  GlyphBatch glyphBatch(painter);
+
   auto &statsTypes = statisticsData.getStatisticsTypes();
 
   // First, get if more than one statistic that has block values is rendered.
@@ -493,10 +498,12 @@ void stats::paintStatisticsData(QPainter *             painter,
     for (int i = 0; i < drawStatPoints.count(); i++)
     {
       auto txt      = drawStatTexts[i].join("\n");
-      auto textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
+      auto textRect = glyphBatch.boundingRect(Qt::AlignLeft, txt);
       textRect.moveTopLeft(drawStatPoints[i] + QPoint(3, 1) + lineOffset);
-      painter->drawText(textRect, Qt::AlignLeft, txt);
+      glyphBatch.drawText(textRect, Qt::AlignLeft, txt);
     }
+    // The arrows are drawn on top of the values
+    glyphBatch.flush();
   }
 
   // Draw all the arrows
@@ -633,8 +640,8 @@ void stats::paintStatisticsData(QPainter *             painter,
                 auto txt1 = QString("(%1, %2)").arg(x1 / zoomFactor).arg(y1 / zoomFactor);
                 auto txt2 = QString("(%1, %2)").arg(x2 / zoomFactor).arg(y2 / zoomFactor);
 
-                auto textRect1 = painter->boundingRect(QRect(), Qt::AlignLeft, txt1);
-                auto textRect2 = painter->boundingRect(QRect(), Qt::AlignLeft, txt2);
+                auto textRect1 = glyphBatch.boundingRect(Qt::AlignLeft, txt1);
+                auto textRect2 = glyphBatch.boundingRect(Qt::AlignLeft, txt2);
 
                 textRect1.moveCenter(QPoint(x1, y1));
                 textRect2.moveCenter(QPoint(x2, y2));
@@ -663,14 +670,14 @@ void stats::paintStatisticsData(QPainter *             painter,
                   textRect2.moveRight(x2);
                 }
 
-                painter->drawText(textRect1, Qt::AlignLeft, txt1);
-                painter->drawText(textRect2, Qt::AlignLeft, txt2);
+                glyphBatch.drawText(textRect1, Qt::AlignLeft, txt1);
+                glyphBatch.drawText(textRect2, Qt::AlignLeft, txt2);
               }
               else
               {
                 // Also draw the vector value next to the arrow head
                 auto txt      = QString("x %1\ny %2").arg(vx).arg(vy);
-                auto textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
+                auto textRect = glyphBatch.boundingRect(Qt::AlignLeft, txt);
                 textRect.moveCenter(QPoint(x2, y2));
                 int a = qRadiansToDegrees(angle);
                 if (a < 45 && a > -45)
@@ -681,7 +688,7 @@ void stats::paintStatisticsData(QPainter *             painter,
                   textRect.moveTop(y2);
                 else
                   textRect.moveRight(x2);
-                painter->drawText(textRect, Qt::AlignLeft, txt);
+                glyphBatch.drawText(textRect, Qt::AlignLeft, txt);
               }
             }
           }
@@ -761,6 +768,7 @@ void stats::paintStatisticsData(QPainter *             painter,
         yLBend = yLBstart + zoomFactor * vyLB;
 
         paintVector(painter,
+                    glyphBatch,
                     *it,
                     zoomFactor,
                     xLTstart,
@@ -775,6 +783,7 @@ void stats::paintStatisticsData(QPainter *             painter,
                     yMin,
                     yMax);
         paintVector(painter,
+                    glyphBatch,
                     *it,
                     zoomFactor,
                     xRTstart,
@@ -789,6 +798,7 @@ void stats::paintStatisticsData(QPainter *             painter,
                     yMin,
                     yMax);
         paintVector(painter,
+                    glyphBatch,
                     *it,
                     zoomFactor,
                     xLBstart,
@@ -817,6 +827,9 @@ void stats::paintStatisticsData(QPainter *             painter,
         painter->drawRect(displayRect);
       }
     }
+
+    // Draw the labels of this type before the next type is drawn on top of them
+    glyphBatch.flush();
   }
 
   // Draw all polygon vector data
@@ -992,5 +1005,6 @@ void stats::paintStatisticsData(QPainter *             painter,
 
   // Restore the state the state of the painter from before this function was called.
   // This will reset the set pens and the translation.
+  glyphBatch.flush();
   painter->restore();
 }
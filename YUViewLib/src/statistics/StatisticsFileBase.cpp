@@ -52,6 +52,48 @@ StatisticsFileBase::~StatisticsFileBase()
   this->abortParsingDestroy = true;
 }
 
+bool StatisticsFileBase::hasUnindexedData() const
+{
+  if (this->error || this->indexedDataChanged.load())
+    return false;
+  const auto fileSize = this->file.getFileSize();
+  return fileSize && uint64_t(*fileSize) != this->scannedBytes.load();
+}
+
+bool StatisticsFileBase::checkIndexedDataUnchanged(FileSource &inputFile)
+{
+  const auto indexedBytes = this->indexedBytes.load();
+  if (indexedBytes == 0)
+    return true;
+
+  const auto fileSize = inputFile.getFileSize();
+  if (fileSize && uint64_t(*fileSize) >= indexedBytes)
+  {
+    const auto checksums =
+        filesource::calculateHeadTailChecksums(inputFile, int64_t(indexedBytes));
+    if (checksums && *checksums == this->indexedChecksums)
+      return true;
+  }
+
+  this->indexedDataChanged.store(true);
+  return false;
+}
+
+void StatisticsFileBase::setIndexedBytes(FileSource &inputFile,
+                                         uint64_t    indexedBytes,
+                                         uint64_t    scannedBytes)
+{
+  if (const auto checksums =
+          filesource::calculateHeadTailChecksums(inputFile, int64_t(indexedBytes)))
+  {
+    this->indexedChecksums = *checksums;
+    this->indexedBytes.store(indexedBytes);
+    this->scannedBytes.store(scannedBytes);
+  }
+  else
+    this->indexedDataChanged.store(true);
+}
+
 InfoData StatisticsFileBase::getInfo() const
 {
   InfoData info("Statistics File info");
@@ -60,6 +102,10 @@ InfoData StatisticsFileBase::getInfo() const
     info.items.append(infoItem);
   info.items.append(InfoItem("Sorted by POC"sv, this->fileSortedByPOC ? "Yes" : "No"));
   info.items.append(InfoItem("Parsing:", std::to_string(this->parsingProgress) + "..."));
+  if (this->indexedDataChanged.load())
+    info.items.append(InfoItem("Warning",
+                               "The already parsed part of the file was modified. Please reload "
+                               "the file."));
   if (this->blockOutsideOfFramePOC != -1)
     info.items.append(InfoItem("Warning",
                                "A block in frame " + std::to_string(this->blockOutsideOfFramePOC) +
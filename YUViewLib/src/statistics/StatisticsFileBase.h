@@ -33,10 +33,13 @@
 #pragma once
 
 #include "filesource/FileSource.h"
+#include "filesource/HeadTailChecksums.h"
 #include "statistics/StatisticsData.h"
 
 #include <QObject>
 
+#include <atomic>
+
 namespace stats
 {
 
@@ -52,6 +55,8 @@ public:
 
   // Parse the whole file and get the positions where a new POC/type starts and save them. Later we
   // can then seek to these positions to load data. Usually this is called in a seperate thread.
+  // If the file was indexed before, parsing resumes at the end of the already indexed data. This
+  // way, files that are still being written (e.g. by a running encoder) can be followed.
   virtual void readFrameAndTypePositionsFromFile(std::atomic_bool &breakFunction) = 0;
 
   // Load the statistics for "poc/type" from file and put it into the handlers cache.
@@ -65,6 +70,13 @@ public:
   int getMaxPoc() const { return this->maxPOC; }
 
   bool isFileChanged() { return this->file.getAndResetFileChangedFlag(); }
+
+  // True if the file size changed since the last indexing pass. An incomplete last line (without a
+  // trailing newline) is not indexed but it is also not parsed again until the file changes.
+  bool hasUnindexedData() const;
+  // Set if resuming the indexing found that already indexed data was modified. The index can not
+  // be extended anymore and the file has to be reloaded.
+  bool isIndexedDataChanged() const { return this->indexedDataChanged.load(); }
   void updateSettings() { this->file.updateFileWatchSetting(); }
 
   InfoData getInfo() const;
@@ -77,6 +89,15 @@ signals:
   void readPOC(int newPoc);
 
 protected:
+  // Before resuming the parsing at indexedBytes, check that the already indexed part of the file
+  // was not modified. If it was, indexedDataChanged is set and false is returned. Only the windows
+  // of indexedChecksums are compared. A modification in between is not detected (the settings
+  // dialog tells the user to reload the file in this case).
+  bool checkIndexedDataUnchanged(FileSource &inputFile);
+  // Set the end of the indexed data (the start of the first incomplete line) and save the
+  // checksums of the data before it. scannedBytes is the end of the data that was read in the pass.
+  void setIndexedBytes(FileSource &inputFile, uint64_t indexedBytes, uint64_t scannedBytes);
+
   FileSource file;
 
   // Set if the file is sorted by POC and the types are 'random' within this POC (true)
@@ -93,6 +114,14 @@ protected:
 
   double parsingProgress{};
   bool   abortParsingDestroy{};
+
+  // Everything before this position was parsed completely. Checksums over a window at the start
+  // and at the end of this data are used to detect if the file was modified or only appended to.
+  std::atomic<uint64_t>         indexedBytes{};
+  filesource::HeadTailChecksums indexedChecksums{};
+  // The file size that the last indexing pass read up to
+  std::atomic<uint64_t>         scannedBytes{};
+  std::atomic_bool              indexedDataChanged{};
 };
 
 } // namespace stats
\ No newline at end of file
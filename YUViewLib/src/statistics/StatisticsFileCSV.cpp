@@ -80,17 +80,23 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
     FileSource inputFile;
     if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
       return;
+    if (!this->checkIndexedDataUnchanged(inputFile))
+      return;
 
     // We perform reading using an input buffer
     QByteArray inputBuffer;
     bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
+    uint64_t   bufferStartPos = this->indexedBytes.load();
 
     QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    int      lastType           = INT_INVALID;
-    bool     sortingFixed       = false;
+    uint64_t lineBufferStartPos = bufferStartPos;
+    auto    &lastPOC            = this->lastParsedPOC;
+    auto    &lastType           = this->lastParsedType;
+    auto    &sortingFixed       = this->sortingFixed;
+
+    // If parsing is resumed, new data for the last POC may have been appended.
+    const auto resumedPOC         = (bufferStartPos > 0) ? lastPOC : INT_INVALID;
+    bool       resumedPOCExtended = false;
 
     this->parsingProgress = 0;
 
@@ -127,6 +133,9 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
               auto poc    = rowItemList[0].toInt();
               auto typeID = rowItemList[5].toInt();
 
+              if (poc == resumedPOC)
+                resumedPOCExtended = true;
+
               if (lastType == -1 && lastPOC == -1)
               {
                 // First POC/type line
@@ -214,6 +223,10 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
       bufferStartPos += bufferSize;
     }
 
+    this->setIndexedBytes(inputFile, lineBufferStartPos, bufferStartPos);
+    if (resumedPOCExtended)
+      emit readPOC(resumedPOC);
+
     this->parsingProgress = 100.0;
   }
   catch (const char *str)
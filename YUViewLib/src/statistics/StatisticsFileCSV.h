@@ -66,6 +66,11 @@ protected:
   // File positions pocTypeFileposMap[poc][typeID]
   using TypeFileposMap = std::map<int, uint64_t>;
   std::map<int, TypeFileposMap> pocTypeFileposMap;
+
+  // State of the index parser which is kept so that parsing can be resumed
+  int  lastParsedPOC{INT_INVALID};
+  int  lastParsedType{INT_INVALID};
+  bool sortingFixed{};
 };
 
 } // namespace stats
\ No newline at end of file
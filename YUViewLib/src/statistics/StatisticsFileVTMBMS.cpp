@@ -69,16 +69,22 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
     FileSource inputFile;
     if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
       return;
+    if (!this->checkIndexedDataUnchanged(inputFile))
+      return;
 
     // We perform reading using an input buffer
     QByteArray inputBuffer;
     bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
+    uint64_t   bufferStartPos = this->indexedBytes.load();
 
     QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    bool     sortingFixed       = false;
+    uint64_t lineBufferStartPos = bufferStartPos;
+    auto    &lastPOC            = this->lastParsedPOC;
+    auto    &sortingFixed       = this->sortingFixed;
+
+    // If parsing is resumed, new data for the last POC may have been appended.
+    const auto resumedPOC         = (bufferStartPos > 0) ? lastPOC : INT_INVALID;
+    bool       resumedPOCExtended = false;
 
     while (!fileAtEnd && !breakFunction.load() && !this->abortParsingDestroy)
     {
@@ -114,6 +120,8 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
             if (match.hasMatch())
             {
               auto poc = match.captured(1).toInt();
+              if (poc == resumedPOC)
+                resumedPOCExtended = true;
 
               if (lastPOC == -1)
               {
@@ -162,6 +170,10 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
       bufferStartPos += bufferSize;
     }
 
+    this->setIndexedBytes(inputFile, lineBufferStartPos, bufferStartPos);
+    if (resumedPOCExtended)
+      emit readPOC(resumedPOC);
+
     // Parsing complete
     this->parsingProgress = 100.0;
   }
@@ -57,6 +57,10 @@ private:
   void readHeaderFromFile(StatisticsData &statisticsData);
   
   std::map<int, uint64_t> pocStartList;
+
+  // State of the index parser which is kept so that parsing can be resumed
+  int  lastParsedPOC{INT_INVALID};
+  bool sortingFixed{};
 };
 
 } // namespace parser
\ No newline at end of file
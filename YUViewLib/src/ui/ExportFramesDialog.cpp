@@ -0,0 +1,203 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ExportFramesDialog.h"
+
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+namespace
+{
+
+using video::FrameExporter;
+using namespace video::yuv;
+
+const auto OUTPUT_TYPE_NAMES = QStringList() << "Raw YUV file"
+                                             << "Raw RGB file"
+                                             << "Image sequence";
+
+QStringList getCommonYUVFormatNames()
+{
+  QStringList names;
+  for (const auto subsampling : {Subsampling::YUV_420, Subsampling::YUV_422, Subsampling::YUV_444})
+    for (const auto bitDepth : {8u, 10u})
+      names.append(QString::fromStdString(PixelFormatYUV(subsampling, bitDepth).getName()));
+  const auto packedFormat = PixelFormatYUV(Subsampling::YUV_422, 8, PackingOrder::UYVY);
+  names.append(QString::fromStdString(packedFormat.getName()));
+  names.append(QString::fromStdString(PixelFormatYUV(Subsampling::YUV_400, 8).getName()));
+  return names;
+}
+
+QStringList getCommonRGBFormatNames()
+{
+  using namespace video::rgb;
+  QStringList names;
+  for (const auto bitDepth : {8u, 10u, 16u})
+    names.append(QString::fromStdString(
+        PixelFormatRGB(bitDepth, video::DataLayout::Packed, ChannelOrder::RGB).getName()));
+  names.append(QString::fromStdString(
+      PixelFormatRGB(8, video::DataLayout::Packed, ChannelOrder::BGR).getName()));
+  names.append(QString::fromStdString(
+      PixelFormatRGB(8, video::DataLayout::Planar, ChannelOrder::RGB).getName()));
+  return names;
+}
+
+} // namespace
+
+ExportFramesDialog::ExportFramesDialog(QWidget                   *parent,
+                                       indexRange                 frameLimits,
+                                       indexRange                 selectedRange,
+                                       video::yuv::PixelFormatYUV itemFormatYUV,
+                                       const QString             &lastExportPath)
+    : QDialog(parent), itemFormatYUV(itemFormatYUV)
+{
+  this->setWindowTitle("Export Frames");
+
+  this->outputTypeComboBox = new QComboBox(this);
+  this->outputTypeComboBox->addItems(OUTPUT_TYPE_NAMES);
+
+  this->formatComboBox = new QComboBox(this);
+  this->formatComboBox->setEditable(true);
+
+  this->colorConversionComboBox = new QComboBox(this);
+  for (const auto &colorConversion : ColorConversionMapper)
+    this->colorConversionComboBox->addItem(
+        QString::fromStdString(std::string(colorConversion.second)));
+
+  this->firstFrameSpinBox = new QSpinBox(this);
+  this->lastFrameSpinBox  = new QSpinBox(this);
+  for (auto spinBox : {this->firstFrameSpinBox, this->lastFrameSpinBox})
+    spinBox->setRange(frameLimits.first, frameLimits.second);
+  this->firstFrameSpinBox->setValue(selectedRange.first);
+  this->lastFrameSpinBox->setValue(selectedRange.second);
+
+  this->outputFileLineEdit = new QLineEdit(lastExportPath, this);
+  auto browseButton        = new QPushButton("...", this);
+  auto outputFileLayout    = new QHBoxLayout;
+  outputFileLayout->addWidget(this->outputFileLineEdit);
+  outputFileLayout->addWidget(browseButton);
+
+  auto formLayout = new QFormLayout;
+  formLayout->addRow("Output", this->outputTypeComboBox);
+  formLayout->addRow("Pixel Format", this->formatComboBox);
+  formLayout->addRow("Color Conversion", this->colorConversionComboBox);
+  formLayout->addRow("First Frame", this->firstFrameSpinBox);
+  formLayout->addRow("Last Frame", this->lastFrameSpinBox);
+  formLayout->addRow("Output File", outputFileLayout);
+
+  auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+
+  auto layout = new QVBoxLayout(this);
+  layout->addLayout(formLayout);
+  layout->addWidget(buttonBox);
+
+  this->connect(this->outputTypeComboBox,
+                QOverload<int>::of(&QComboBox::currentIndexChanged),
+                this,
+                &ExportFramesDialog::updateFormatList);
+  this->connect(browseButton, &QPushButton::clicked, this, &ExportFramesDialog::selectOutputFile);
+  this->connect(buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+  this->connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+  this->updateFormatList();
+}
+
+FrameExporter::Settings ExportFramesDialog::getSettings() const
+{
+  FrameExporter::Settings settings;
+  settings.outputType = this->getOutputType();
+  settings.frameRange = {this->firstFrameSpinBox->value(), this->lastFrameSpinBox->value()};
+  settings.outputPath = this->outputFileLineEdit->text();
+
+  const auto formatName = this->formatComboBox->currentText().toStdString();
+  if (settings.outputType == FrameExporter::OutputType::RawYUV)
+    settings.pixelFormatYUV = PixelFormatYUV(formatName);
+  else if (settings.outputType == FrameExporter::OutputType::RawRGB)
+    settings.pixelFormatRGB = video::rgb::PixelFormatRGB(formatName);
+
+  if (auto colorConversion = ColorConversionMapper.getValue(
+          this->colorConversionComboBox->currentText().toStdString()))
+    settings.colorConversion = *colorConversion;
+  return settings;
+}
+
+void ExportFramesDialog::updateFormatList()
+{
+  const auto outputType = this->getOutputType();
+
+  this->formatComboBox->clear();
+  if (outputType == FrameExporter::OutputType::RawYUV)
+  {
+    auto names = getCommonYUVFormatNames();
+    if (this->itemFormatYUV.isValid())
+    {
+      // Writing the format of the item needs no conversion
+      const auto itemFormatName = QString::fromStdString(this->itemFormatYUV.getName());
+      names.removeAll(itemFormatName);
+      names.prepend(itemFormatName);
+    }
+    this->formatComboBox->addItems(names);
+  }
+  else if (outputType == FrameExporter::OutputType::RawRGB)
+    this->formatComboBox->addItems(getCommonRGBFormatNames());
+
+  this->formatComboBox->setEnabled(outputType != FrameExporter::OutputType::ImageSequence);
+  this->colorConversionComboBox->setEnabled(outputType == FrameExporter::OutputType::RawYUV);
+}
+
+void ExportFramesDialog::selectOutputFile()
+{
+  const auto outputType = this->getOutputType();
+  auto       filter     = QString("Images (*.png *.bmp *.jpg *.tif)");
+  if (outputType == FrameExporter::OutputType::RawYUV)
+    filter = "YUV file (*.yuv)";
+  else if (outputType == FrameExporter::OutputType::RawRGB)
+    filter = "RGB file (*.rgb)";
+  const auto fileName = QFileDialog::getSaveFileName(
+      this, "Select Output File", this->outputFileLineEdit->text(), filter);
+  if (!fileName.isEmpty())
+    this->outputFileLineEdit->setText(fileName);
+}
+
+FrameExporter::OutputType ExportFramesDialog::getOutputType() const
+{
+  const auto index = this->outputTypeComboBox->currentIndex();
+  if (index == 1)
+    return FrameExporter::OutputType::RawRGB;
+  if (index == 2)
+    return FrameExporter::OutputType::ImageSequence;
+  return FrameExporter::OutputType::RawYUV;
+}
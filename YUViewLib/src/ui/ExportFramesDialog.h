@@ -0,0 +1,76 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <video/FrameExporter.h>
+
+#include <QComboBox>
+#include <QDialog>
+#include <QLineEdit>
+#include <QSpinBox>
+
+/* Ask the user which frames of an item should be exported and where to. The output type, the pixel
+ * format and the file are selected here. The export itself is done by the video::FrameExporter.
+ */
+class ExportFramesDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  // frameLimits: The frames that the item has. selectedRange: The range that is preselected.
+  // itemFormatYUV: The YUV format of the item (if it has one). This is preselected for raw export.
+  ExportFramesDialog(QWidget                   *parent,
+                     indexRange                 frameLimits,
+                     indexRange                 selectedRange,
+                     video::yuv::PixelFormatYUV itemFormatYUV,
+                     const QString             &lastExportPath);
+
+  video::FrameExporter::Settings getSettings() const;
+
+private slots:
+  void updateFormatList();
+  void selectOutputFile();
+
+private:
+  video::FrameExporter::OutputType getOutputType() const;
+
+  video::yuv::PixelFormatYUV itemFormatYUV;
+
+  QComboBox *outputTypeComboBox{};
+  QComboBox *formatComboBox{};
+  QComboBox *colorConversionComboBox{};
+  QSpinBox  *firstFrameSpinBox{};
+  QSpinBox  *lastFrameSpinBox{};
+  QLineEdit *outputFileLineEdit{};
+};
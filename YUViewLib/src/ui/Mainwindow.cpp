@@ -33,20 +33,31 @@
 #include "Mainwindow.h"
 
 #include <QByteArray>
+#include <QEventLoop>
 #include <QFileDialog>
+#include <QFutureWatcher>
 #include <QImageWriter>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QShortcut>
 #include <QStringList>
 #include <QTextBrowser>
 #include <QTextStream>
+#include <QtConcurrent>
+
+#include <fstream>
 
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <common/Tracing.h>
 #include <playlistitem/playlistItems.h>
+#include <ui/ExportFramesDialog.h>
 #include <ui/Mainwindow_performanceTestDialog.h>
 #include <ui/SettingsDialog.h>
 #include <ui/widgets/PlaylistTreeWidget.h>
+#include <video/FrameExporter.h>
+#include <video/videoHandler.h>
+#include <video/yuv/videoHandlerYUV.h>
 
 MainWindow::MainWindow(bool useAlternativeSources, QWidget *parent) : QMainWindow(parent)
 {
@@ -289,6 +300,7 @@ void MainWindow::createMenusAndActions()
                   Qt::CTRL | Qt::Key_S);
   fileMenu->addSeparator();
   addActionToMenu(fileMenu, "&Save Screenshot...", this, &MainWindow::saveScreenshot);
+  addActionToMenu(fileMenu, "&Export Frames...", this, &MainWindow::exportFrames);
   fileMenu->addSeparator();
   addActionToMenu(fileMenu, "&Settings...", this, &MainWindow::showSettingsWindow);
   fileMenu->addSeparator();
@@ -419,6 +431,32 @@ void MainWindow::createMenusAndActions()
                   ui.playbackController,
                   &PlaybackController::previousFrame,
                   Qt::Key_Left);
+  playbackMenu->addSeparator();
+  addActionToMenu(playbackMenu,
+                  "Toggle Reverse Playback",
+                  ui.playbackController,
+                  &PlaybackController::toggleReversePlayback);
+  addActionToMenu(playbackMenu,
+                  "Increase Playback Speed",
+                  ui.playbackController,
+                  &PlaybackController::increasePlaybackSpeed);
+  addActionToMenu(playbackMenu,
+                  "Decrease Playback Speed",
+                  ui.playbackController,
+                  &PlaybackController::decreasePlaybackSpeed);
+  playbackMenu->addSeparator();
+  addActionToMenu(playbackMenu,
+                  "Set Loop In Point",
+                  ui.playbackController,
+                  &PlaybackController::setLoopInPoint);
+  addActionToMenu(playbackMenu,
+                  "Set Loop Out Point",
+                  ui.playbackController,
+                  &PlaybackController::setLoopOutPoint);
+  addActionToMenu(playbackMenu,
+                  "Clear Loop Range",
+                  ui.playbackController,
+                  &PlaybackController::clearLoopRange);
 
   auto addLambdaActionToMenu = [](QMenu *menu, const QString name, auto lambda)
   {
@@ -470,6 +508,15 @@ void MainWindow::createMenusAndActions()
       { QDesktopServices::openUrl(QUrl("https://github.com/ChristianFeldmann/vvdec/releases")); });
   helpMenu->addSeparator();
   addLambdaActionToMenu(downloadsMenu, "Performance Tests", [this]() { this->performanceTest(); });
+  auto tracingMenu        = helpMenu->addMenu("Tracing");
+  auto recordTracingAction = new QAction("Record Trace", tracingMenu);
+  recordTracingAction->setCheckable(true);
+  QObject::connect(recordTracingAction,
+                   &QAction::toggled,
+                   [](bool checked) { Tracer::instance().setEnabled(checked); });
+  tracingMenu->addAction(recordTracingAction);
+  addActionToMenu(tracingMenu, "Save Trace...", this, &MainWindow::saveTrace);
+  addLambdaActionToMenu(tracingMenu, "Clear Trace", []() { Tracer::instance().clear(); });
   addActionToMenu(helpMenu, "Reset Window Layout", this, &MainWindow::resetWindowLayout);
   addActionToMenu(helpMenu, "Clear Settings", this, &MainWindow::closeAndClearSettings);
 
@@ -896,6 +943,68 @@ void MainWindow::saveScreenshot()
   }
 }
 
+void MainWindow::exportFrames()
+{
+  auto item  = ui.playlistTreeWidget->getSelectedItems()[0];
+  auto video = item ? dynamic_cast<video::videoHandler *>(item->getFrameHandler()) : nullptr;
+  if (video == nullptr || !item->properties().isIndexedByFrame())
+  {
+    QMessageBox::information(
+        this, "Export Frames", "Please select an item with a video to export frames from.");
+    return;
+  }
+
+  video::yuv::PixelFormatYUV itemFormatYUV;
+  if (auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(video))
+    itemFormatYUV = yuvVideo->getPixelFormatYUV();
+
+  QSettings  settings;
+  const auto frameLimits = item->properties().startEndRange;
+  const auto loopRange   = ui.playbackController->getLoopRange();
+  ExportFramesDialog dialog(this,
+                            frameLimits,
+                            loopRange.value_or(frameLimits),
+                            itemFormatYUV,
+                            settings.value("LastExportPath").toString());
+  if (dialog.exec() != QDialog::Accepted)
+    return;
+
+  const auto exportSettings = dialog.getSettings();
+  settings.setValue("LastExportPath", exportSettings.outputPath);
+
+  // Stop playback so that the export does not compete with the playback for the item
+  ui.playbackController->pausePlayback();
+
+  video::FrameExporter exporter(video, exportSettings, item->cachingThreadLimit());
+  if (auto error = exporter.checkSettings())
+  {
+    QMessageBox::critical(this, "Export Frames", *error);
+    return;
+  }
+
+  const auto      nrFrames = exportSettings.frameRange.second - exportSettings.frameRange.first + 1;
+  QProgressDialog progress("Exporting frames...", "Cancel", 0, nrFrames, this);
+  progress.setWindowModality(Qt::WindowModal);
+  progress.setMinimumDuration(0);
+  connect(&exporter,
+          &video::FrameExporter::signalFrameWritten,
+          &progress,
+          &QProgressDialog::setValue);
+  connect(&progress, &QProgressDialog::canceled, [&exporter]() { exporter.cancel(); });
+
+  // Run the export in the background and keep the UI responsive until it is done
+  QEventLoop           eventLoop;
+  QFutureWatcher<bool> exportWatcher;
+  connect(&exportWatcher, &QFutureWatcher<bool>::finished, &eventLoop, &QEventLoop::quit);
+  exportWatcher.setFuture(QtConcurrent::run([&exporter]() { return exporter.run(); }));
+  eventLoop.exec();
+  progress.reset();
+
+  if (!exportWatcher.result() && !exporter.isCanceled())
+    QMessageBox::critical(
+        this, "Export Frames", "Exporting the frames failed. " + exporter.getErrorMessage());
+}
+
 /* Show the file open dialog and open the selected files
  */
 void MainWindow::showFileOpenDialog()
@@ -1006,6 +1115,22 @@ void MainWindow::closeAndClearSettings()
   close();
 }
 
+void MainWindow::saveTrace()
+{
+  const auto filename = QFileDialog::getSaveFileName(
+      this, tr("Save Trace"), "trace.json", tr("Chrome Trace JSON (*.json)"));
+  if (filename.isEmpty())
+    return;
+
+  std::ofstream file(filename.toStdString());
+  if (!file)
+  {
+    QMessageBox::critical(this, "Error saving trace", "The file could not be opened for writing.");
+    return;
+  }
+  Tracer::instance().exportChromeTrace(file);
+}
+
 void MainWindow::performanceTest()
 {
   performanceTestDialog dialog(this);
@@ -78,6 +78,9 @@ private slots:
   void showHelp() { showAboutHelp(false); }
   void showSettingsWindow();
   void saveScreenshot();
+  void exportFrames();
+  // Write all recorded trace events in the Chrome trace JSON format (see Tracer)
+  void saveTrace();
   void showFileOpenDialog();
   void resetWindowLayout();
   void closeAndClearSettings();
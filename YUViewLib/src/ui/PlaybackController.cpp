@@ -32,10 +32,14 @@
 
 #include "PlaybackController.h"
 
+#include <array>
+
 #include <QSettings>
 
 #include <common/EnumMapper.h>
+#include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <common/Tracing.h>
 #include <common/Typedef.h>
 #include <playlistitem/playlistItem.h>
 
@@ -57,6 +61,9 @@ constexpr EnumMapper<PlaybackController::RepeatMode, 3> RepeatModeMapper = {
     std::make_pair(PlaybackController::RepeatMode::One, "One"),
     std::make_pair(PlaybackController::RepeatMode::All, "All")};
 
+constexpr std::array<double, 7> PlaybackSpeeds    = {0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0};
+constexpr auto                  DefaultSpeedIndex = 2;
+
 }
 
 CountDown::CountDown(const int ticks)
@@ -105,6 +112,13 @@ PlaybackController::PlaybackController()
   this->ui.fpsLabel->setText("0");
   this->ui.fpsLabel->setStyleSheet("");
 
+  {
+    const QSignalBlocker blocker(this->ui.speedComboBox);
+    for (const auto speed : PlaybackSpeeds)
+      this->ui.speedComboBox->addItem(QString("%1x").arg(speed));
+    this->ui.speedComboBox->setCurrentIndex(DefaultSpeedIndex);
+  }
+
   QSettings  settings;
   const auto repeatModeOffIndex = static_cast<int>(RepeatModeMapper.indexOf(RepeatMode::Off));
   auto       repeatModeIdx      = settings.value("RepeatMode", repeatModeOffIndex).toInt();
@@ -164,6 +178,7 @@ void PlaybackController::setRepeatModeAndUpdateIcons(const RepeatMode mode)
     this->ui.repeatModeButton->setIcon(this->iconRepeatOne);
   else if (mode == RepeatMode::All)
     this->ui.repeatModeButton->setIcon(this->iconRepeatAll);
+  emit signalPlayheadMoved();
 }
 
 void PlaybackController::on_stopButton_clicked()
@@ -193,8 +208,13 @@ void PlaybackController::on_playPauseButton_clicked()
   else
   {
     DEBUG_PLAYBACK("PlaybackController::on_playPauseButton_clicked Start");
-    if (this->currentFrameIdx >= this->ui.frameSlider->maximum() &&
-        this->repeatMode == RepeatMode::Off)
+    if (this->playbackDirection == PlaybackDirection::Backward)
+    {
+      if (this->currentFrameIdx <= this->ui.frameSlider->minimum())
+        this->setCurrentFrameAndUpdate(this->ui.frameSlider->maximum());
+    }
+    else if (this->currentFrameIdx >= this->ui.frameSlider->maximum() &&
+             this->repeatMode == RepeatMode::Off)
     {
       if (!this->playlist->hasNextItem())
         this->setCurrentFrameAndUpdate(this->ui.frameSlider->minimum());
@@ -239,6 +259,7 @@ void PlaybackController::itemCachingFinished(playlistItem *)
 void PlaybackController::startPlayback()
 {
   this->startOrUpdateTimer();
+  this->setPlaybackStepInItems(this->getPlaybackStep());
 
   // Tell the primary split view that playback just started. This will toggle loading
   // of the double buffer of the currently visible items (if required).
@@ -251,8 +272,9 @@ void PlaybackController::startOrUpdateTimer()
   if (this->anyItemIndexedByFrame())
   {
     const auto frameRate = this->getCurrentItemsFrameRate();
-    this->timerInterval = std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / frameRate);
-    const auto ticksToUpdateEachSecond = static_cast<int>(frameRate);
+    this->timerInterval  = this->getTimerInterval(frameRate);
+    const auto ticksToUpdateEachSecond =
+        static_cast<int>(frameRate * std::min(this->playbackSpeed, 1.0));
     this->countdownForFPSUpdate        = CountDown(ticksToUpdateEachSecond);
     DEBUG_PLAYBACK("PlaybackController::startOrUpdateTimer framerate %f", frameRate);
   }
@@ -273,6 +295,7 @@ void PlaybackController::startOrUpdateTimer()
 void PlaybackController::nextFrame()
 {
   this->pausePlayback();
+  this->setPlaybackStepInItems(1);
   if (this->currentFrameIdx < this->ui.frameSlider->maximum())
     this->setCurrentFrameAndUpdate(this->currentFrameIdx + 1);
 }
@@ -280,10 +303,109 @@ void PlaybackController::nextFrame()
 void PlaybackController::previousFrame()
 {
   this->pausePlayback();
+  // Stepping backwards frame by frame can also profit from decoding a GOP only once
+  this->setPlaybackStepInItems(-1);
   if (this->currentFrameIdx != this->ui.frameSlider->minimum())
     this->setCurrentFrameAndUpdate(this->currentFrameIdx - 1);
 }
 
+void PlaybackController::toggleReversePlayback()
+{
+  this->ui.reverseButton->toggle();
+}
+
+void PlaybackController::increasePlaybackSpeed()
+{
+  const auto index = this->ui.speedComboBox->currentIndex();
+  if (index + 1 < this->ui.speedComboBox->count())
+    this->ui.speedComboBox->setCurrentIndex(index + 1);
+}
+
+void PlaybackController::decreasePlaybackSpeed()
+{
+  const auto index = this->ui.speedComboBox->currentIndex();
+  if (index > 0)
+    this->ui.speedComboBox->setCurrentIndex(index - 1);
+}
+
+void PlaybackController::setLoopInPoint()
+{
+  if (this->currentFrameIdx < 0)
+    return;
+  auto loopOut = this->loopRange ? this->loopRange->second : this->ui.frameSlider->maximum();
+  this->setLoopRange(indexRange(this->currentFrameIdx, std::max(loopOut, this->currentFrameIdx)));
+}
+
+void PlaybackController::setLoopOutPoint()
+{
+  if (this->currentFrameIdx < 0)
+    return;
+  auto loopIn = this->loopRange ? this->loopRange->first : this->ui.frameSlider->minimum();
+  this->setLoopRange(indexRange(std::min(loopIn, this->currentFrameIdx), this->currentFrameIdx));
+}
+
+void PlaybackController::clearLoopRange()
+{
+  this->setLoopRange({});
+}
+
+void PlaybackController::setLoopRange(std::optional<indexRange> range)
+{
+  if (this->loopRange == range)
+    return;
+
+  this->loopRange = range;
+  if (range)
+  {
+    DEBUG_PLAYBACK("PlaybackController::setLoopRange %d-%d", range->first, range->second);
+    this->ui.frameSlider->setToolTip(
+        QString("Loop range %1-%2").arg(range->first).arg(range->second));
+  }
+  else
+  {
+    DEBUG_PLAYBACK("PlaybackController::setLoopRange cleared");
+    this->ui.frameSlider->setToolTip({});
+  }
+  emit signalLoopRangeChanged();
+}
+
+bool PlaybackController::isPlayingBackwards() const
+{
+  return this->playbackDirection == PlaybackDirection::Backward;
+}
+
+void PlaybackController::on_reverseButton_toggled(bool checked)
+{
+  this->playbackDirection = checked ? PlaybackDirection::Backward : PlaybackDirection::Forward;
+  DEBUG_PLAYBACK("PlaybackController::on_reverseButton_toggled %s",
+                 checked ? "backward" : "forward");
+  if (this->playbackMode == PlaybackMode::Running)
+  {
+    this->setPlaybackStepInItems(this->getPlaybackStep());
+    // The frame in the double buffer of the items is now in the wrong direction
+    if (auto nextFrameIndex = this->getNextFrameIndexInCurrentItem())
+      this->splitViewPrimary->playbackStarted(*nextFrameIndex);
+  }
+  emit signalPlayheadMoved();
+}
+
+void PlaybackController::on_speedComboBox_currentIndexChanged(int index)
+{
+  if (index < 0 || index >= static_cast<int>(PlaybackSpeeds.size()))
+    return;
+  this->playbackSpeed = PlaybackSpeeds.at(index);
+  DEBUG_PLAYBACK("PlaybackController::on_speedComboBox_currentIndexChanged speed %f",
+                 this->playbackSpeed);
+  if (this->playbackMode == PlaybackMode::Running)
+  {
+    this->startOrUpdateTimer();
+    this->setPlaybackStepInItems(this->getPlaybackStep());
+    if (auto nextFrameIndex = this->getNextFrameIndexInCurrentItem())
+      this->splitViewPrimary->playbackStarted(*nextFrameIndex);
+  }
+  emit signalPlayheadMoved();
+}
+
 void PlaybackController::on_frameSlider_valueChanged(int value)
 {
   this->pausePlayback();
@@ -309,9 +431,13 @@ void PlaybackController::currentSelectedItemsChanged(playlistItem *item1,
 
   if (this->playing() && !chageByPlayback && !continuePlayback)
     this->pausePlayback();
+  if (!chageByPlayback && item1 != this->currentItem[0])
+    this->clearLoopRange();
 
   this->currentItem[0] = item1;
   this->currentItem[1] = item2;
+  if (this->playing())
+    this->setPlaybackStepInItems(this->getPlaybackStep());
 
   if (!this->anyItemIndexedByFrame())
   {
@@ -529,14 +655,19 @@ void PlaybackController::goToNextItem()
 
 void PlaybackController::goToNextFrame(const int nextFrameIndex)
 {
-  this->waitingForItem[0] =
-      this->currentItem[0]->isLoading() || this->currentItem[0]->isLoadingDoubleBuffer();
-  this->waitingForItem[1] =
-      this->splitViewPrimary->isSplitting() && this->currentItem[1] &&
-      (this->currentItem[1]->isLoading() || this->currentItem[1]->isLoadingDoubleBuffer());
+  // While an item is filling its render-ahead queue, playback can continue as long as the next
+  // frame is already available.
+  const auto isWaitingForItem = [nextFrameIndex](playlistItem *item) {
+    return item->isLoading() ||
+           (item->isLoadingDoubleBuffer() &&
+            item->needsLoading(nextFrameIndex, false) == ItemLoadingState::LoadingNeeded);
+  };
+  this->waitingForItem[0] = isWaitingForItem(this->currentItem[0]);
+  this->waitingForItem[1] = this->splitViewPrimary->isSplitting() && this->currentItem[1] &&
+                            isWaitingForItem(this->currentItem[1]);
   if (this->waitingForItem[0] || this->waitingForItem[1])
   {
-    // The double buffer of the current item or the second item is still loading. Playback is not
+    // The next frame of the current item or the second item is still loading. Playback is not
     // fast enough. We must wait until the next frame was loaded (in both items) successfully
     // until we can display it. We must pause the timer until this happens.
     this->timer.stop();
@@ -570,10 +701,8 @@ void PlaybackController::goToNextFrame(const int nextFrameIndex)
   // Check if the time interval changed (the user changed the rate of the item)
   if (this->anyItemIndexedByFrame())
   {
-    const auto frameRate = this->getCurrentItemsFrameRate();
-
-    const auto newtimerInterval =
-        std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / frameRate);
+    const auto frameRate        = this->getCurrentItemsFrameRate();
+    const auto newtimerInterval = this->getTimerInterval(frameRate);
     if (this->timerInterval != newtimerInterval)
       this->startOrUpdateTimer();
   }
@@ -599,20 +728,60 @@ void PlaybackController::enableControls(bool enable)
 
 std::optional<int> PlaybackController::getNextFrameIndexInCurrentItem()
 {
-  const auto isSliderAtEnd = this->currentFrameIdx >= this->ui.frameSlider->maximum();
+  const auto step       = this->getPlaybackStep();
+  const auto isBackward = (step < 0);
+  const auto minimum    = this->ui.frameSlider->minimum();
+  const auto maximum    = this->ui.frameSlider->maximum();
+
+  if (this->loopRange && this->anyItemIndexedByFrame() &&
+      this->currentFrameIdx >= this->loopRange->first &&
+      this->currentFrameIdx <= this->loopRange->second)
+  {
+    // Within the loop range playback always wraps around
+    const auto nextFrameIdx = this->currentFrameIdx + step;
+    if (nextFrameIdx > this->loopRange->second)
+      return this->loopRange->first;
+    if (nextFrameIdx < this->loopRange->first)
+      return this->loopRange->second;
+    return nextFrameIdx;
+  }
+
+  const auto isSliderAtEnd =
+      isBackward ? this->currentFrameIdx <= minimum : this->currentFrameIdx >= maximum;
 
   if (isSliderAtEnd || !this->anyItemIndexedByFrame())
   {
     if (this->repeatMode == RepeatMode::One)
-      return this->ui.frameSlider->minimum();
+      return isBackward ? maximum : minimum;
 
     return {};
   }
-  return this->currentFrameIdx + 1;
+  return functions::clip(this->currentFrameIdx + step, minimum, maximum);
+}
+
+int PlaybackController::getPlaybackStep() const
+{
+  const auto framesPerTick = std::max(1, static_cast<int>(this->playbackSpeed));
+  return (this->playbackDirection == PlaybackDirection::Backward) ? -framesPerTick : framesPerTick;
+}
+
+std::chrono::milliseconds PlaybackController::getTimerInterval(const double frameRate) const
+{
+  // Speeds above 1 are realized by skipping frames (see getPlaybackStep)
+  const auto ticksPerSecond = frameRate * std::min(this->playbackSpeed, 1.0);
+  return std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / ticksPerSecond);
+}
+
+void PlaybackController::setPlaybackStepInItems(const int step)
+{
+  for (auto &item : this->currentItem)
+    if (item)
+      item->setPlaybackStep(step);
 }
 
 void PlaybackController::timerEvent(QTimerEvent *event)
 {
+  TRACE_SCOPE("playback", "PlaybackController::timerEvent", this->currentFrameIdx);
   if (event && event->timerId() != timer.timerId())
   {
     DEBUG_PLAYBACK("PlaybackController::timerEvent Different Timer IDs");
@@ -637,6 +806,18 @@ void PlaybackController::timerEvent(QTimerEvent *event)
 
   if (auto nextFrameIdx = this->getNextFrameIndexInCurrentItem())
     this->goToNextFrame(*nextFrameIdx);
+  else if (this->playbackDirection == PlaybackDirection::Backward)
+  {
+    // Reverse playback does not continue with other items. Stop at the first frame.
+    DEBUG_PLAYBACK("PlaybackController::timerEvent reverse playback reached first frame");
+    this->on_playPauseButton_clicked();
+  }
+  else if (this->currentItem[0] && this->currentItem[0]->isFollowingGrowingFile())
+  {
+    // Follow the live edge while the file is still growing. Once it stopped growing, playback
+    // continues with the next item.
+    DEBUG_PLAYBACK("PlaybackController::timerEvent waiting for new frames at the live edge");
+  }
   else
     this->goToNextItem();
 }
@@ -671,6 +852,10 @@ bool PlaybackController::setCurrentFrameAndUpdate(int frame, bool updateView)
   this->updateFrameSliderAndSpinBoxWithoutSignals(frame);
   this->currentFrameIdx = frame;
 
+  // During playback the playhead moves as predicted. Everything else is a seek.
+  if (this->playbackMode != PlaybackMode::Running)
+    emit signalPlayheadMoved();
+
   if (updateView)
   {
     // Also update the view to display the new frame
@@ -90,6 +90,10 @@ public:
 
   bool setCurrentFrameAndUpdate(int frame, bool updateView = true);
 
+  // If a loop range is set, playback stays within these frames of the current item
+  std::optional<indexRange> getLoopRange() const { return this->loopRange; }
+  bool                      isPlayingBackwards() const;
+
   enum class RepeatMode
   {
     Off,
@@ -97,6 +101,16 @@ public:
     All
   };
 
+  RepeatMode getRepeatMode() const { return this->repeatMode; }
+  // How many frames playback advances per timer tick. Negative if playing backwards.
+  int getPlaybackStep() const;
+
+  enum class PlaybackDirection
+  {
+    Forward,
+    Backward
+  };
+
 public slots:
   void on_playPauseButton_clicked();
   void on_stopButton_clicked();
@@ -105,6 +119,14 @@ public slots:
   void nextFrame();
   void previousFrame();
 
+  void toggleReversePlayback();
+  void increasePlaybackSpeed();
+  void decreasePlaybackSpeed();
+
+  void setLoopInPoint();
+  void setLoopOutPoint();
+  void clearLoopRange();
+
   // Accept the signal from the playlistTreeWidget that signals if a new (or two) item was selected.
   // The playback controller will save a pointer to this in order to get playback info from the item
   // later like the sampling or the framerate. This will also update the slider and the spin box.
@@ -132,12 +154,20 @@ signals:
 
   void signalPlaybackStarting();
 
+  void signalLoopRangeChanged();
+
+  // The user moved the playhead (seeking) or changed the direction, speed or repeat mode. The
+  // frames that will be needed next changed.
+  void signalPlayheadMoved();
+
 public slots:
   void itemCachingFinished(playlistItem *item);
 
 private slots:
   void on_frameSlider_valueChanged(int val);
   void on_frameSpinBox_valueChanged(int val) { this->on_frameSlider_valueChanged(val); }
+  void on_reverseButton_toggled(bool checked);
+  void on_speedComboBox_currentIndexChanged(int index);
 
 private:
   std::optional<int> getNextFrameIndexInCurrentItem();
@@ -160,6 +190,17 @@ private:
   RepeatMode repeatMode{RepeatMode::Off};
   void       setRepeatModeAndUpdateIcons(const RepeatMode mode);
 
+  // Playback can run backwards and at a multiple of the frame rate of the item. Speeds below 1
+  // slow down the timer. For speeds above 1 the timer runs at the frame rate and frames are skipped
+  // so that the items only have to load the frames that are actually shown.
+  PlaybackDirection         playbackDirection{PlaybackDirection::Forward};
+  double                    playbackSpeed{1.0};
+  std::chrono::milliseconds getTimerInterval(const double frameRate) const;
+  void                      setPlaybackStepInItems(const int step);
+
+  std::optional<indexRange> loopRange;
+  void                      setLoopRange(std::optional<indexRange> range);
+
   void updateFrameSliderAndSpinBoxWithoutSignals(const int                value,
                                                  const std::optional<int> sliderMaximum = {});
 
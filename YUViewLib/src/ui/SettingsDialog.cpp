@@ -40,6 +40,8 @@
 #include <decoder/decoderVTM.h>
 #include <decoder/decoderVVDec.h>
 #include <ffmpeg/FFmpegVersionHandler.h>
+#include <video/CacheEvictionPolicy.h>
+#include <video/RenderAheadQueue.h>
 
 #include <QColorDialog>
 #include <QFileDialog>
@@ -62,6 +64,7 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent)
 
   // "Generals" tab
   ui.checkBoxWatchFiles->setChecked(settings.value("WatchFiles", true).toBool());
+  ui.checkBoxFollowGrowingFiles->setChecked(settings.value("FollowGrowingFiles", false).toBool());
   ui.checkBoxAskToSave->setChecked(settings.value("AskToSaveOnExit", true).toBool());
   ui.checkBoxContinuePlaybackNewSelection->setChecked(
       settings.value("ContinuePlaybackOnSequenceSelection", false).toBool());
@@ -126,6 +129,13 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent)
   else
     ui.spinBoxNrThreads->setValue(functions::getOptimalThreadCount());
   ui.spinBoxNrThreads->setEnabled(ui.checkBoxNrThreads->isChecked());
+  ui.comboBoxEvictionPolicy->addItems(
+      functions::toQStringList(video::CacheEvictionPolicyTypeMapper.getNames()));
+  const auto evictionPolicy = video::CacheEvictionPolicyTypeMapper.getValue(
+      settings.value("EvictionPolicy").toString().toStdString());
+  ui.comboBoxEvictionPolicy->setCurrentIndex(int(video::CacheEvictionPolicyTypeMapper.indexOf(
+      evictionPolicy.value_or(video::CacheEvictionPolicyType::PlaylistOrder))));
+  ui.checkBoxPinLoopRange->setChecked(settings.value("PinLoopRange", true).toBool());
   // Playback
   ui.checkBoxPausPlaybackForCaching->setChecked(
       settings.value("PlaybackPauseCaching", true).toBool());
@@ -133,11 +143,15 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent)
   ui.checkBoxEnablePlaybackCaching->setChecked(playbackCaching);
   ui.spinBoxThreadLimit->setValue(settings.value("PlaybackCachingThreadLimit", 1).toInt());
   ui.spinBoxThreadLimit->setEnabled(playbackCaching);
+  ui.spinBoxRenderAheadFrames->setValue(
+      settings.value("RenderAheadFrames", int(video::RenderAheadQueue::DEFAULT_CAPACITY)).toInt());
   settings.endGroup();
 
   // "Decoders" tab
   settings.beginGroup("Decoders");
   ui.lineEditDecoderPath->setText(settings.value("SearchPath", "").toString());
+  ui.checkBoxDecoderCheckpoints->setChecked(settings.value("DecoderCheckpoints", true).toBool());
+  ui.checkBoxDecoderHost->setChecked(settings.value("UseDecoderHost", true).toBool());
 
   for (const auto &decoder : decoder::DecodersHEVC)
     ui.comboBoxDefaultHEVC->addItem(
@@ -428,6 +442,7 @@ void SettingsDialog::on_pushButtonSave_clicked()
 
   // "General" tab
   settings.setValue("WatchFiles", ui.checkBoxWatchFiles->isChecked());
+  settings.setValue("FollowGrowingFiles", ui.checkBoxFollowGrowingFiles->isChecked());
   settings.setValue("AskToSaveOnExit", ui.checkBoxAskToSave->isChecked());
   settings.setValue("ContinuePlaybackOnSequenceSelection",
                     ui.checkBoxContinuePlaybackNewSelection->isChecked());
@@ -464,14 +479,19 @@ void SettingsDialog::on_pushButtonSave_clicked()
   settings.setValue("ThresholdValueMB", getCacheSizeInMB());
   settings.setValue("SetNrThreads", ui.checkBoxNrThreads->isChecked());
   settings.setValue("NrThreads", ui.spinBoxNrThreads->value());
+  settings.setValue("EvictionPolicy", ui.comboBoxEvictionPolicy->currentText());
+  settings.setValue("PinLoopRange", ui.checkBoxPinLoopRange->isChecked());
   settings.setValue("PlaybackPauseCaching", ui.checkBoxPausPlaybackForCaching->isChecked());
   settings.setValue("PlaybackCachingEnabled", ui.checkBoxEnablePlaybackCaching->isChecked());
   settings.setValue("PlaybackCachingThreadLimit", ui.spinBoxThreadLimit->value());
+  settings.setValue("RenderAheadFrames", ui.spinBoxRenderAheadFrames->value());
   settings.endGroup();
 
   // "Decoders" tab
   settings.beginGroup("Decoders");
   settings.setValue("SearchPath", ui.lineEditDecoderPath->text());
+  settings.setValue("DecoderCheckpoints", ui.checkBoxDecoderCheckpoints->isChecked());
+  settings.setValue("UseDecoderHost", ui.checkBoxDecoderHost->isChecked());
   settings.setValue("DefaultDecoderHEVC", ui.comboBoxDefaultHEVC->currentText());
   settings.setValue("DefaultDecoderVVC", ui.comboBoxDefaultVVC->currentText());
   settings.setValue("DefaultDecoderAV1", ui.comboBoxDefaultAV1->currentText());
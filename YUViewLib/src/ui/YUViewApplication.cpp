@@ -33,6 +33,8 @@
 #include "YUViewApplication.h"
 
 #include <common/Typedef.h>
+#include <decoder/DecoderHostPool.h>
+#include <handler/CommandLineHandler.h>
 #include <handler/SingleInstanceHandler.h>
 #include <ui/Mainwindow.h>
 
@@ -47,7 +49,26 @@
 #define DEBUG_APP(msg) ((void)0)
 #endif
 
-YUViewApplication::YUViewApplication(int argc, char *argv[]) : QApplication(argc, argv)
+namespace
+{
+
+// Headless commands must also run on machines without a display. Unless a platform was chosen
+// explicitly, use the offscreen platform for them. The playlist items still need a GUI application
+// (e.g. for their icons) so a plain QCoreApplication is not enough.
+int &selectPlatformForCommand(int &argc, char *argv[])
+{
+  QStringList arguments;
+  for (int i = 0; i < argc; i++)
+    arguments.append(QString::fromLocal8Bit(argv[i]));
+  if (commandline::isHeadlessCommand(arguments) && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  return argc;
+}
+
+} // namespace
+
+YUViewApplication::YUViewApplication(int argc, char *argv[])
+    : QApplication(selectPlatformForCommand(argc, argv), argv)
 {
   QString versionString = QString::fromUtf8(YUVIEW_VERSION);
   setApplicationName("YUView");
@@ -63,6 +84,14 @@ YUViewApplication::YUViewApplication(int argc, char *argv[]) : QApplication(argc
   QStringList args = arguments();
   DEBUG_APP("YUViewApplication args" << args);
 
+  if (commandline::isHeadlessCommand(args))
+  {
+    // Run the command without opening the main window
+    DEBUG_APP("YUViewApplication running headless command");
+    returnCode = commandline::runHeadlessCommand(args);
+    return;
+  }
+
   std::unique_ptr<singleInstanceHandler> instance;
   if (WIN_LINUX_SINGLE_INSTANCE && (is_Q_OS_WIN || is_Q_OS_LINUX))
   {
@@ -129,4 +158,10 @@ YUViewApplication::YUViewApplication(int argc, char *argv[]) : QApplication(argc
 
   w.show();
   returnCode = exec();
-}
\ No newline at end of file
+}
+
+YUViewApplication::~YUViewApplication()
+{
+  // Quit all decoder host processes that are still running
+  decoder::host::DecoderHostPool::instance().shutDown();
+}
@@ -39,5 +39,6 @@ class YUViewApplication : public QApplication
   Q_OBJECT
 public:
   YUViewApplication(int argc, char *argv[]);
+  ~YUViewApplication();
   int returnCode{0};
 };
@@ -32,6 +32,7 @@
 
 #include "SplitViewWidget.h"
 
+#include <common/Tracing.h>
 #include <playlistitem/playlistItem.h>
 #include <ui/PlaybackController.h>
 #include <video/FrameHandler.h>
@@ -151,8 +152,9 @@ void splitViewWidget::updateSettings()
   update();
 }
 
-void splitViewWidget::paintEvent(QPaintEvent *)
+void splitViewWidget::paintEvent(QPaintEvent *event)
 {
+  TRACE_SCOPE("paint", "splitViewWidget::paintEvent");
   MoveAndZoomableView::updatePaletteIfNeeded();
 
   if (!playlist)
@@ -194,78 +196,137 @@ void splitViewWidget::paintEvent(QPaintEvent *)
   DEBUG_LOAD_DRAW("splitViewWidget::paintEvent drawing "
                   << (isMasterView ? " separate widget" : ""));
 
+  PaintState state;
+  state.drawArea_botR = drawArea_botR;
+
   // Get the current frame to draw
-  const auto frame = playback->getCurrentFrame();
+  state.frame = playback->getCurrentFrame();
 
   // Is playback running?
-  const bool playing = (playback) ? playback->playing() : false;
+  state.playing = (playback) ? playback->playing() : false;
   // If yes, is is currently stalled because we are waiting for caching of an item to finish first?
-  const bool waitingForCaching = playback->isWaitingForCaching();
+  state.waitingForCaching = playback->isWaitingForCaching();
 
   // Get the playlist item(s) to draw
-  const auto item             = playlist->getSelectedItems();
-  const bool anyItemsSelected = item[0] != nullptr || item[1] != nullptr;
+  state.item                  = playlist->getSelectedItems();
+  const bool anyItemsSelected = state.item[0] != nullptr || state.item[1] != nullptr;
 
   // The x position of the split (if splitting)
-  const int xSplit = int(drawArea_botR.x() * splittingPoint);
+  state.xSplit = int(drawArea_botR.x() * splittingPoint);
 
   // Calculate the zoom to use
-  const double zoom   = this->zoomFactor;
-  const auto   offset = this->moveOffset;
+  state.zoom   = this->zoomFactor;
+  state.offset = this->moveOffset;
 
-  const bool drawRawValues = showRawData() && !playing;
+  state.drawRawValues = showRawData() && !state.playing;
 
   // First determine the center points per of each view
-  QPoint centerPoints[2];
   if (viewSplitMode == COMPARISON || viewSplitMode == DISABLED)
   {
     // For comparison mode, both items have the same center point, in the middle of the view widget
     // This is equal to the scenario of not splitting
-    centerPoints[0] = drawArea_botR / 2;
-    centerPoints[1] = centerPoints[0];
+    state.centerPoints[0] = drawArea_botR / 2;
+    state.centerPoints[1] = state.centerPoints[0];
   }
   else
   {
     // For side by side mode, the center points are centered in each individual split view
-    int y           = drawArea_botR.y() / 2;
-    centerPoints[0] = QPoint(xSplit / 2, y);
-    centerPoints[1] = QPoint(xSplit + (drawArea_botR.x() - xSplit) / 2, y);
+    int y                 = drawArea_botR.y() / 2;
+    state.centerPoints[0] = QPoint(state.xSplit / 2, y);
+    state.centerPoints[1] = QPoint(state.xSplit + (drawArea_botR.x() - state.xSplit) / 2, y);
   }
 
-  // For the zoom box, calculate the pixel position under the cursor for each view. The following
-  // things are calculated in this function:
-  bool  pixelPosInItem[2] = {false,
-                            false}; //< Is the pixel position under the cursor within the item?
-  QRect zoomPixelRect[2];            //< A QRect around the pixel that is under the cursor
+  // For the zoom box, calculate the pixel position under the cursor for each view, whether it is
+  // within the item and a QRect around that pixel.
   if (anyItemsSelected && this->drawZoomBox)
   {
     // We now have the pixel difference value for the item under the cursor.
     // We now draw one zoom box per view
-    int viewNum = (isSplitting() && item[1]) ? 2 : 1;
+    int viewNum = (isSplitting() && state.item[1]) ? 2 : 1;
     for (int view = 0; view < viewNum; view++)
     {
       // Get the size of the item
       double itemSize[2];
-      itemSize[0] = item[view]->getSize().width();
-      itemSize[1] = item[view]->getSize().height();
+      itemSize[0] = state.item[view]->getSize().width();
+      itemSize[1] = state.item[view]->getSize().height();
 
-      // Is the pixel under the cursor within the item?
-      pixelPosInItem[view] = (zoomBoxPixelUnderCursor[view].x() >= 0 &&
-                              zoomBoxPixelUnderCursor[view].x() < itemSize[0]) &&
-                             (zoomBoxPixelUnderCursor[view].y() >= 0 &&
-                              zoomBoxPixelUnderCursor[view].y() < itemSize[1]);
+      // Is the pixel position under the cursor within the item?
+      state.pixelPosInItem[view] = (zoomBoxPixelUnderCursor[view].x() >= 0 &&
+                                    zoomBoxPixelUnderCursor[view].x() < itemSize[0]) &&
+                                   (zoomBoxPixelUnderCursor[view].y() >= 0 &&
+                                    zoomBoxPixelUnderCursor[view].y() < itemSize[1]);
 
       // Mark the pixel under the cursor with a rectangle around it.
-      if (pixelPosInItem[view])
+      if (state.pixelPosInItem[view])
       {
         int pixelPoint[2];
-        pixelPoint[0]       = -((itemSize[0] / 2 - zoomBoxPixelUnderCursor[view].x()) * zoom);
-        pixelPoint[1]       = -((itemSize[1] / 2 - zoomBoxPixelUnderCursor[view].y()) * zoom);
-        zoomPixelRect[view] = QRect(pixelPoint[0], pixelPoint[1], zoom, zoom);
+        pixelPoint[0] = -((itemSize[0] / 2 - zoomBoxPixelUnderCursor[view].x()) * state.zoom);
+        pixelPoint[1] = -((itemSize[1] / 2 - zoomBoxPixelUnderCursor[view].y()) * state.zoom);
+        state.zoomPixelRect[view] = QRect(pixelPoint[0], pixelPoint[1], state.zoom, state.zoom);
       }
     }
   }
 
+  if (this->drawZoomBox)
+  {
+    // While the zoom box is shown, moving the mouse only repaints the zoom box region. The frame
+    // layer below it is only redrawn if the whole view is repainted.
+    const auto layerSize     = this->size() * this->devicePixelRatioF();
+    const auto fullRepaint   = QRegion(this->rect()).subtracted(event->region()).isEmpty();
+    const auto layerOutdated = this->frameLayer.size() != layerSize;
+    if (fullRepaint || layerOutdated)
+    {
+      this->frameLayer = QPixmap(layerSize);
+      this->frameLayer.setDevicePixelRatio(this->devicePixelRatioF());
+      this->frameLayer.fill(this->palette().color(this->backgroundRole()));
+      QPainter layerPainter(&this->frameLayer);
+      layerPainter.setBackground(this->palette().brush(this->backgroundRole()));
+      this->paintFrameLayer(layerPainter, state);
+    }
+    painter.drawPixmap(0, 0, this->frameLayer);
+  }
+  else
+  {
+    this->frameLayer = QPixmap();
+    this->paintFrameLayer(painter, state);
+  }
+
+  const auto overlayRegion = this->paintOverlay(painter, state);
+  if (this->drawZoomBox)
+  {
+    // The new overlay may reach outside of the region that was repainted (e.g. the info panel
+    // grew). Repaint the missing part.
+    const auto missingRegion = overlayRegion.subtracted(event->region());
+    if (!missingRegion.isEmpty())
+      QWidget::update(missingRegion);
+  }
+  this->zoomBoxOverlayRegion = overlayRegion;
+
+  MoveAndZoomableView::updateMouseCursor();
+
+  if (testMode)
+  {
+    if (testLoopCount < 0)
+      testFinished(false);
+    else
+    {
+      testLoopCount--;
+      update();
+    }
+  }
+}
+
+void splitViewWidget::paintFrameLayer(QPainter &painter, const PaintState &state)
+{
+  const auto &item          = state.item;
+  const auto &drawArea_botR = state.drawArea_botR;
+  const auto  xSplit        = state.xSplit;
+  const auto  frame         = state.frame;
+  const auto  zoom          = state.zoom;
+  const auto  offset        = state.offset;
+  const auto  playing       = state.playing;
+  auto        centerPoints  = state.centerPoints;
+
   if (isSplitting())
   {
     QStringPair itemNamesToDraw = determineItemNamesToDraw(item[0], item[1]);
@@ -285,40 +346,18 @@ void splitViewWidget::paintEvent(QPaintEvent *)
       painter.translate(centerPoints[0] + offset);
 
       // Draw the item at position (0,0)
-      if (!waitingForCaching)
+      if (!state.waitingForCaching)
       {
         painter.setFont(
             QFont(SPLITVIEWWIDGET_PIXEL_VALUES_FONT, SPLITVIEWWIDGET_PIXEL_VALUES_FONTSIZE));
-        item[0]->drawItem(&painter, frame, zoom, drawRawValues);
+        item[0]->drawItem(&painter, frame, zoom, state.drawRawValues);
       }
 
       paintRegularGrid(&painter, item[0]);
 
-      if (pixelPosInItem[0])
-      {
-        // If the zoom box is active, draw a rectangle around the pixel currently under the cursor
-        if (auto vid = item[0]->getFrameHandler())
-        {
-          painter.setPen(vid->isPixelDark(zoomBoxPixelUnderCursor[0]) ? Qt::white : Qt::black);
-          painter.drawRect(zoomPixelRect[0]);
-        }
-      }
-
       // Do the inverse translation of the painter
       painter.resetTransform();
 
-      // Paint the zoom box for view 0
-      paintZoomBox(0,
-                   painter,
-                   xSplit,
-                   drawArea_botR,
-                   item[0],
-                   frame,
-                   zoomBoxPixelUnderCursor[0],
-                   pixelPosInItem[0],
-                   zoom,
-                   playing);
-
       // Paint the x pixel values ruler at the top
       paintPixelRulersX(painter, item[0], 0, xSplit, zoom, centerPoints[0], offset);
       paintPixelRulersY(painter, item[0], drawArea_botR.y(), 0, zoom, centerPoints[0], offset);
@@ -341,40 +380,18 @@ void splitViewWidget::paintEvent(QPaintEvent *)
       painter.translate(centerPoints[1] + offset);
 
       // Draw the item at position (0,0)
-      if (!waitingForCaching)
+      if (!state.waitingForCaching)
       {
         painter.setFont(
             QFont(SPLITVIEWWIDGET_PIXEL_VALUES_FONT, SPLITVIEWWIDGET_PIXEL_VALUES_FONTSIZE));
-        item[1]->drawItem(&painter, frame, zoom, drawRawValues);
+        item[1]->drawItem(&painter, frame, zoom, state.drawRawValues);
       }
 
       paintRegularGrid(&painter, item[1]);
 
-      if (pixelPosInItem[1])
-      {
-        // If the zoom box is active, draw a rectangle around the pixel currently under the cursor
-        if (auto vid = item[1]->getFrameHandler())
-        {
-          painter.setPen(vid->isPixelDark(zoomBoxPixelUnderCursor[1]) ? Qt::white : Qt::black);
-          painter.drawRect(zoomPixelRect[1]);
-        }
-      }
-
       // Do the inverse translation of the painter
       painter.resetTransform();
 
-      // Paint the zoom box for view 0
-      paintZoomBox(1,
-                   painter,
-                   xSplit,
-                   drawArea_botR,
-                   item[1],
-                   frame,
-                   zoomBoxPixelUnderCursor[1],
-                   pixelPosInItem[1],
-                   zoom,
-                   playing);
-
       // Paint the x pixel values ruler at the top
       paintPixelRulersX(painter, item[1], xSplit, drawArea_botR.x(), zoom, centerPoints[1], offset);
       // Paint another y ruler at the split line if the resolution in Y direction for the two items
@@ -406,40 +423,18 @@ void splitViewWidget::paintEvent(QPaintEvent *)
       painter.translate(centerPoints[0] + offset);
 
       // Draw the item at position (0,0)
-      if (!waitingForCaching)
+      if (!state.waitingForCaching)
       {
         painter.setFont(
             QFont(SPLITVIEWWIDGET_PIXEL_VALUES_FONT, SPLITVIEWWIDGET_PIXEL_VALUES_FONTSIZE));
-        item[0]->drawItem(&painter, frame, zoom, drawRawValues);
+        item[0]->drawItem(&painter, frame, zoom, state.drawRawValues);
       }
 
       paintRegularGrid(&painter, item[0]);
 
-      if (pixelPosInItem[0])
-      {
-        // If the zoom box is active, draw a rectangle around the pixel currently under the cursor
-        if (auto vid = item[0]->getFrameHandler())
-        {
-          painter.setPen(vid->isPixelDark(zoomBoxPixelUnderCursor[0]) ? Qt::white : Qt::black);
-          painter.drawRect(zoomPixelRect[0]);
-        }
-      }
-
       // Do the inverse translation of the painter
       painter.resetTransform();
 
-      // Paint the zoom box for view 0
-      paintZoomBox(0,
-                   painter,
-                   xSplit,
-                   drawArea_botR,
-                   item[0],
-                   frame,
-                   zoomBoxPixelUnderCursor[0],
-                   pixelPosInItem[0],
-                   zoom,
-                   playing);
-
       // Paint the x pixel values ruler at the top
       paintPixelRulersX(painter, item[0], 0, drawArea_botR.x(), zoom, centerPoints[0], offset);
       paintPixelRulersY(painter, item[0], drawArea_botR.y(), 0, zoom, centerPoints[0], offset);
@@ -479,22 +474,6 @@ void splitViewWidget::paintEvent(QPaintEvent *)
     }
   }
 
-  if (this->viewAction == ViewAction::ZOOM_RECT)
-  {
-    if (isSplitting())
-    {
-      QRegion clipping;
-      if (viewZoomingMousePosStart.x() < xSplit)
-        clipping = QRegion(0, 0, xSplit, drawArea_botR.y());
-      else
-        clipping = QRegion(xSplit, 0, drawArea_botR.x() - xSplit, drawArea_botR.y());
-      painter.setClipRegion(clipping);
-    }
-    this->drawZoomRect(painter);
-    if (isSplitting())
-      painter.setClipping(false);
-  }
-
   if (zoom != 1.0)
   {
     // Draw the zoom factor
@@ -505,26 +484,94 @@ void splitViewWidget::paintEvent(QPaintEvent *)
     painter.drawText(zoomFactorFontPos, zoomString);
   }
 
-  if (playback->isWaitingForCaching())
+  if (state.waitingForCaching)
   {
     // The playback is halted because we are waiting for the caching of the next item.
     // Draw a small indicator on the bottom left
     QPoint pos = QPoint(10, drawArea_botR.y() - 10 - waitingForCachingPixmap.height());
     painter.drawPixmap(pos, waitingForCachingPixmap);
   }
+}
 
-  MoveAndZoomableView::updateMouseCursor();
+QRegion splitViewWidget::paintOverlay(QPainter &painter, const PaintState &state)
+{
+  QRegion overlayRegion;
 
-  if (testMode)
+  const auto viewNum = (isSplitting() && state.item[1]) ? 2 : 1;
+  for (int view = 0; view < viewNum; view++)
   {
-    if (testLoopCount < 0)
-      testFinished(false);
-    else
+    const auto item = state.item[view];
+    if (!item)
+      continue;
+
+    const auto centerPoint = state.centerPoints[view];
+    if (state.pixelPosInItem[view])
     {
-      testLoopCount--;
-      update();
+      // If the zoom box is active, draw a rectangle around the pixel currently under the cursor
+      if (auto vid = item->getFrameHandler())
+      {
+        if (isSplitting())
+          painter.setClipRegion(
+              view == 0
+                  ? QRegion(0, 0, state.xSplit, state.drawArea_botR.y())
+                  : QRegion(state.xSplit,
+                            0,
+                            state.drawArea_botR.x() - state.xSplit,
+                            state.drawArea_botR.y()));
+        painter.translate(centerPoint + state.offset);
+        painter.setPen(vid->isPixelDark(zoomBoxPixelUnderCursor[view]) ? Qt::white : Qt::black);
+        painter.drawRect(state.zoomPixelRect[view]);
+        painter.resetTransform();
+        painter.setClipping(false);
+
+        const auto pixelRect = state.zoomPixelRect[view].translated(
+            (QPointF(centerPoint) + state.offset).toPoint());
+        overlayRegion += pixelRect.adjusted(-2, -2, 2, 2);
+      }
     }
+
+    overlayRegion += paintZoomBox(view,
+                                  painter,
+                                  state.xSplit,
+                                  state.drawArea_botR,
+                                  item,
+                                  state.frame,
+                                  zoomBoxPixelUnderCursor[view],
+                                  state.pixelPosInItem[view],
+                                  state.zoom,
+                                  state.playing);
   }
+
+  if (this->viewAction == ViewAction::ZOOM_RECT)
+  {
+    if (isSplitting())
+    {
+      QRegion clipping;
+      if (viewZoomingMousePosStart.x() < state.xSplit)
+        clipping = QRegion(0, 0, state.xSplit, state.drawArea_botR.y());
+      else
+        clipping = QRegion(state.xSplit,
+                           0,
+                           state.drawArea_botR.x() - state.xSplit,
+                           state.drawArea_botR.y());
+      painter.setClipRegion(clipping);
+    }
+    this->drawZoomRect(painter);
+    if (isSplitting())
+      painter.setClipping(false);
+  }
+
+  return overlayRegion;
+}
+
+void splitViewWidget::updateZoomBoxOverlay()
+{
+  // Only repaint the zoom box and the pixel marker. If the new overlay is larger, paintEvent will
+  // request a repaint of the rest.
+  if (this->zoomBoxOverlayRegion.isEmpty())
+    QWidget::update();
+  else
+    QWidget::update(this->zoomBoxOverlayRegion);
 }
 
 void splitViewWidget::updatePixelPositions()
@@ -613,22 +660,22 @@ void splitViewWidget::setZoomBoxPixelUnderCursor(QPoint posA,
   this->zoomBoxPixelUnderCursor[1] = posB;
 
   if (callUpdate)
-    update();
+    this->updateZoomBoxOverlay();
 }
 
-void splitViewWidget::paintZoomBox(int           view,
-                                   QPainter &    painter,
-                                   int           xSplit,
-                                   const QPoint &drawArea_botR,
-                                   playlistItem *item,
-                                   int           frame,
-                                   const QPoint &pixelPos,
-                                   bool          pixelPosInItem,
-                                   double        zoomFactor,
-                                   bool          playing)
+QRect splitViewWidget::paintZoomBox(int           view,
+                                    QPainter &    painter,
+                                    int           xSplit,
+                                    const QPoint &drawArea_botR,
+                                    playlistItem *item,
+                                    int           frame,
+                                    const QPoint &pixelPos,
+                                    bool          pixelPosInItem,
+                                    double        zoomFactor,
+                                    bool          playing)
 {
   if (!this->drawZoomBox)
-    return;
+    return {};
 
   const int zoomBoxWindowZoomFactor = 32;
   const int srcSize                 = 5;
@@ -638,13 +685,15 @@ void splitViewWidget::paintZoomBox(int           view,
 
   // Where will the zoom view go?
   QRect zoomViewRect(0, 0, zoomBoxSize, zoomBoxSize);
+  // The area that was painted on
+  QRect paintedRect;
 
   bool drawInfoPanel = !playing; // Do we draw the info panel?
   if (view == 1 && xSplit > (drawArea_botR.x() - margin - zoomBoxSize))
   {
     if (xSplit > drawArea_botR.x() - margin)
       // The split line is so far on the right, that the whole zoom box in view 1 is not visible
-      return;
+      return {};
 
     // The split line is so far right, that part of the zoom box is hidden.
     // Resize the zoomViewRect to the part that is visible.
@@ -694,6 +743,7 @@ void splitViewWidget::paintZoomBox(int           view,
 
     // Draw a rectangle around the zoom view
     painter.drawRect(zoomViewRect);
+    paintedRect = zoomViewRect.adjusted(0, 0, 1, 1);
   }
   else
     // If we don't draw the zoom box, consider the size to be 0.
@@ -738,17 +788,20 @@ void splitViewWidget::paintZoomBox(int           view,
     textDocument.setTextWidth(textDocument.size().width());
 
     // Translate to the position where the text box shall be
+    QPointF textBoxPos;
     if (view == 0 && isSplitting())
-      painter.translate(
-          xSplit - margin - zoomBoxSize - textDocument.size().width() - padding * 2 + 1,
-          drawArea_botR.y() - margin - textDocument.size().height() - padding * 2 + 1);
+      textBoxPos =
+          QPointF(xSplit - margin - zoomBoxSize - textDocument.size().width() - padding * 2 + 1,
+                  drawArea_botR.y() - margin - textDocument.size().height() - padding * 2 + 1);
     else
-      painter.translate(
+      textBoxPos = QPointF(
           drawArea_botR.x() - margin - zoomBoxSize - textDocument.size().width() - padding * 2 + 1,
           drawArea_botR.y() - margin - textDocument.size().height() - padding * 2 + 1);
+    painter.translate(textBoxPos);
 
     // Draw a black rectangle and then the text on top of that
     QRect  rect(QPoint(0, 0), textDocument.size().toSize() + QSize(2 * padding, 2 * padding));
+    paintedRect |= rect.translated(textBoxPos.toPoint()).adjusted(-1, -1, 2, 2);
     QBrush originalBrush;
     painter.setBrush(QColor(0, 0, 0, 70));
     painter.setPen(Qt::black);
@@ -759,6 +812,8 @@ void splitViewWidget::paintZoomBox(int           view,
 
     painter.resetTransform();
   }
+
+  return paintedRect;
 }
 
 void splitViewWidget::setDrawZoomBox(bool drawZoomBox, bool setOtherViewIfLinked, bool callUpdate)
@@ -942,13 +997,13 @@ void splitViewWidget::mouseMoveEvent(QMouseEvent *mouse_event)
 
   if (this->drawZoomBox)
   {
-    // If the mouse position changed, save the current point of the mouse and update the view (this
-    // will update the zoom box)
+    // If the mouse position changed, save the current point of the mouse and update the zoom box.
+    // The rest of the view does not change.
     if (zoomBoxMousePosition != mouse_event->pos())
     {
       zoomBoxMousePosition = mouse_event->pos();
       updatePixelPositions();
-      update();
+      this->updateZoomBoxOverlay();
     }
     mouse_event->accept();
   }
@@ -1534,10 +1589,10 @@ void splitViewWidget::update(bool newFrame, bool itemRedraw)
       }
       else if (playing && state == ItemLoadingState::LoadingNeededDoubleBuffer)
       {
-        // We can immediately draw the new frame but then we need to update the double buffer
+        // We can immediately draw the new frame but then we need to refill the render-ahead queue
         if (this->isMasterView)
         {
-          item[0]->activateDoubleBuffer();
+          item[0]->activateDoubleBuffer(frameIdx);
           cache->loadFrame(item[0], frameIdx, 0);
         }
       }
@@ -1554,10 +1609,10 @@ void splitViewWidget::update(bool newFrame, bool itemRedraw)
       }
       else if (playing && state == ItemLoadingState::LoadingNeededDoubleBuffer)
       {
-        // We can immediately draw the new frame but then we need to update the double buffer
+        // We can immediately draw the new frame but then we need to refill the render-ahead queue
         if (this->isMasterView)
         {
-          item[1]->activateDoubleBuffer();
+          item[1]->activateDoubleBuffer(frameIdx);
           cache->loadFrame(item[1], frameIdx, 1);
         }
       }
@@ -46,6 +46,7 @@
 #include <QProgressDialog>
 #include <QTimer>
 
+#include <array>
 #include <memory>
 
 class QDockWidget;
@@ -240,7 +241,8 @@ protected:
   QPoint zoomBoxMousePosition;   //!< If we are drawing the zoom box(es) we have to know where the
                                  //!< mouse currently is.
   QColor zoomBoxBackgroundColor; //!< The color of the zoom box background (read from settings)
-  void   paintZoomBox(int           view,
+  // Paint the zoom box and the info panel. Return the rect that was painted on.
+  QRect  paintZoomBox(int           view,
                       QPainter &    painter,
                       int           xSplit,
                       const QPoint &drawArea_botR,
@@ -262,6 +264,34 @@ protected:
   QPoint zoomBoxPixelUnderCursor[2]; //!< The above function will update this. (The position of the
                                      //!< pixel under the cursor (per item))
 
+  // Everything that is derived from the view state once per paintEvent
+  struct PaintState
+  {
+    std::array<playlistItem *, 2> item{};
+    QPoint                        drawArea_botR;
+    int                           xSplit{};
+    int                           frame{};
+    double                        zoom{1.0};
+    QPointF                       offset;
+    bool                          playing{false};
+    bool                          waitingForCaching{false};
+    bool                          drawRawValues{false};
+    std::array<QPoint, 2>         centerPoints;
+    std::array<bool, 2>           pixelPosInItem{false, false};
+    std::array<QRect, 2>          zoomPixelRect;
+  };
+  // Paint everything that does not change when the mouse moves (items, grid, rulers, ...)
+  void paintFrameLayer(QPainter &painter, const PaintState &state);
+  // Paint the pixel marker, the zoom boxes and the zoom rect. Return the region that was painted.
+  QRegion paintOverlay(QPainter &painter, const PaintState &state);
+  // Repaint only the region of the zoom box and the pixel marker
+  void updateZoomBoxOverlay();
+
+  // While the zoom box is shown, the frame layer is kept in this pixmap. A full repaint redraws it
+  // but a mouse move only repaints zoomBoxOverlayRegion on top of it.
+  QPixmap frameLayer;
+  QRegion zoomBoxOverlayRegion;
+
   // Regular grid
   int  regularGridSize{0}; //!< The size of each block in the regular grid in pixels
   void setRegularGridSize(const int  size,
@@ -32,6 +32,7 @@
 
 #include "BitstreamAnalysisWidget.h"
 
+#include "parser/AV1/ParserAV1OBU.h"
 #include "parser/AVC/ParserAnnexBAVC.h"
 #include "parser/AVFormat/ParserAVFormat.h"
 #include "parser/HEVC/ParserAnnexBHEVC.h"
@@ -270,6 +271,8 @@ void BitstreamAnalysisWidget::createAndConnectNewParser(InputFormat inputFormat)
     this->parser.reset(new parser::ParserAnnexBAVC(this));
   else if (inputFormat == InputFormat::Libav)
     this->parser.reset(new parser::ParserAVFormat(this));
+  else if (inputFormat == InputFormat::AV1OBU)
+    this->parser.reset(new parser::ParserAV1OBU(this));
   this->parser->enableModel();
   const bool parsingLimitSet = !this->ui.parseEntireFileCheckBox->isChecked();
   this->parser->setParsingLimitEnabled(parsingLimitSet);
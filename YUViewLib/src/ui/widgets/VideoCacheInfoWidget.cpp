@@ -34,7 +34,8 @@
 
 #include <QGroupBox>
 #include <QPainter>
-#include <QSettings>
+
+#include <algorithm>
 
 #define VIDEOCACHEINFOWIDGET_DEBUG_OUTPUT 0
 #if VIDEOCACHEINFOWIDGET_DEBUG_OUTPUT && !NDEBUG
@@ -90,17 +91,16 @@ void VideoCacheStatusWidget::paintEvent(QPaintEvent *)
   painter.drawRect(0, 0, width - 1, height - 1);
 }
 
-void VideoCacheStatusWidget::updateStatus(PlaylistTreeWidget *playlist, unsigned int cacheRate)
+void VideoCacheStatusWidget::updateStatus(PlaylistTreeWidget *playlist,
+                                          unsigned int        cacheRate,
+                                          int64_t             cacheBudget)
 {
   // Get all items from the playlist
   QList<playlistItem *> allItems = playlist->getAllPlaylistItems();
 
-  // Get if caching is enabled and how much memory we can use for the cache
-  QSettings settings;
-  settings.beginGroup("VideoCache");
-  cacheLevelMaxMB             = settings.value("ThresholdValueMB", 49).toUInt();
-  const int64_t cacheLevelMax = cacheLevelMaxMB * 1000 * 1000;
-  settings.endGroup();
+  // The budget is what the user configured minus what other buffers or the system need
+  cacheLevelMaxMB             = cacheBudget / 1000000;
+  const int64_t cacheLevelMax = std::max(cacheBudget, int64_t(1));
 
   // Clear the old percent values
   relativeValsEnd.clear();
@@ -141,6 +141,9 @@ VideoCacheInfoWidget::VideoCacheInfoWidget(QWidget *parent) : QWidget(parent)
   statusWidget = new VideoCacheStatusWidget(this);
   statusWidget->setMinimumHeight(20);
 
+  // The breakdown of the memory usage
+  memoryInfoLabel = new QLabel("", this);
+
   // Create a QGroupBox with text label inside
   QGroupBox *groupBox = new QGroupBox("Details", this);
   groupBox->setCheckable(true);
@@ -153,6 +156,7 @@ VideoCacheInfoWidget::VideoCacheInfoWidget(QWidget *parent) : QWidget(parent)
   // Add everything to a vertical layout
   QVBoxLayout *mainLayout = new QVBoxLayout(this);
   mainLayout->addWidget(statusWidget);
+  mainLayout->addWidget(memoryInfoLabel);
   mainLayout->addWidget(groupBox, 1);
 
   setLayout(mainLayout);
@@ -178,7 +182,8 @@ void VideoCacheInfoWidget::onUpdateCacheStatus()
   playlist->updateCachingStatus();
 
   DEBUG_CACHINGINFO("VideoCacheInfoWidget::updateCacheStatus");
-  statusWidget->updateStatus(playlist, cacheRateInBytesPerMs);
+  statusWidget->updateStatus(playlist, cacheRateInBytesPerMs, cache->getCacheBudget());
+  memoryInfoLabel->setText(cache->getMemoryStatusText().join("\n"));
 
   QStringList statusText = cache->getCacheStatusText();
   cachingInfoLabel->setText(statusText.join("\n"));
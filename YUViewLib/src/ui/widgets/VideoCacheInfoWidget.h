@@ -50,7 +50,9 @@ public:
   }
   // Override the paint event
   virtual void paintEvent(QPaintEvent *event) override;
-  void         updateStatus(PlaylistTreeWidget *playlistWidget, unsigned int cacheRate);
+  void         updateStatus(PlaylistTreeWidget *playlistWidget,
+                            unsigned int        cacheRate,
+                            int64_t             cacheBudget);
 
 private:
   // The floating point values (0 to 1) of the end positions of the blocks to draw
@@ -83,6 +85,7 @@ private slots:
 private:
   VideoCacheStatusWidgetNamespace::VideoCacheStatusWidget *statusWidget{nullptr};
   QLabel *                                                 cachingInfoLabel{nullptr};
+  QLabel *                                                 memoryInfoLabel{nullptr};
 
   PlaylistTreeWidget *playlist{nullptr};
   video::VideoCache * cache{nullptr};
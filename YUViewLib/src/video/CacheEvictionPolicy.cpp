@@ -0,0 +1,102 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CacheEvictionPolicy.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace video
+{
+
+namespace
+{
+
+// Frames behind the playhead are only needed again if the user seeks back or the playback loops.
+// A frame that is n frames behind the playhead is treated like a frame that is n * this factor
+// frames ahead of the playhead.
+constexpr int64_t BEHIND_PLAYHEAD_DISTANCE_FACTOR = 4;
+
+bool isPinned(const CachedFrame &frame, const EvictionContext &context)
+{
+  if (!context.pinnedRange || frame.itemID != context.playheadItemID)
+    return false;
+  return frame.frameIndex >= context.pinnedRange->first &&
+         frame.frameIndex <= context.pinnedRange->second;
+}
+
+} // namespace
+
+void CacheEvictionPolicy::orderForEviction(std::vector<CachedFrame> &frames,
+                                           const EvictionContext &   context) const
+{
+  frames.erase(std::remove_if(frames.begin(),
+                              frames.end(),
+                              [&context](const CachedFrame &f) { return isPinned(f, context); }),
+               frames.end());
+
+  std::stable_sort(
+      frames.begin(), frames.end(), [this, &context](const CachedFrame &a, const CachedFrame &b) {
+        return this->evictBefore(a, b, context);
+      });
+}
+
+int64_t DistanceFromPlayheadEvictionPolicy::getDistance(const CachedFrame &    frame,
+                                                        const EvictionContext &context)
+{
+  if (frame.itemID != context.playheadItemID)
+    return std::numeric_limits<int64_t>::max();
+
+  auto distance = int64_t(frame.frameIndex) - context.playheadFrameIndex;
+  if (context.playingBackwards)
+    distance = -distance;
+
+  if (distance < 0)
+    return -distance * BEHIND_PLAYHEAD_DISTANCE_FACTOR;
+  return distance;
+}
+
+std::unique_ptr<CacheEvictionPolicy> createCacheEvictionPolicy(CacheEvictionPolicyType type)
+{
+  switch (type)
+  {
+  case CacheEvictionPolicyType::LeastRecentlyUsed:
+    return std::make_unique<LeastRecentlyUsedEvictionPolicy>();
+  case CacheEvictionPolicyType::DistanceFromPlayhead:
+    return std::make_unique<DistanceFromPlayheadEvictionPolicy>();
+  case CacheEvictionPolicyType::PlaylistOrder:
+  default:
+    return std::make_unique<PlaylistOrderEvictionPolicy>();
+  }
+}
+
+} // namespace video
@@ -0,0 +1,157 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/EnumMapper.h>
+#include <common/Typedef.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace video
+{
+
+enum class CacheEvictionPolicyType
+{
+  PlaylistOrder,
+  LeastRecentlyUsed,
+  DistanceFromPlayhead
+};
+
+constexpr EnumMapper<CacheEvictionPolicyType, 3> CacheEvictionPolicyTypeMapper = {
+    std::make_pair(CacheEvictionPolicyType::PlaylistOrder, "Playlist order"),
+    std::make_pair(CacheEvictionPolicyType::LeastRecentlyUsed, "Least recently used"),
+    std::make_pair(CacheEvictionPolicyType::DistanceFromPlayhead, "Distance from playhead")};
+
+// A frame in the cache that could be removed
+struct CachedFrame
+{
+  int      itemID{-1};
+  int      frameIndex{-1};
+  uint64_t lastAccess{};
+};
+
+// Where is the user right now? This is what the policies base their decision on.
+struct EvictionContext
+{
+  int  playheadItemID{-1};
+  int  playheadFrameIndex{-1};
+  bool playingBackwards{false};
+  // Frames from the playhead item within this range are never evicted (e.g. the loop range)
+  std::optional<indexRange> pinnedRange;
+};
+
+/* The video cache decides which frames may be removed from the cache in order to make space for
+ * frames that are needed more urgently. An eviction policy then decides in which order these frames
+ * are actually removed.
+ */
+class CacheEvictionPolicy
+{
+public:
+  virtual ~CacheEvictionPolicy() = default;
+
+  // Remove all pinned frames from the list and sort the rest so that the frame that should be
+  // removed first is the first one in the list. Frames that the policy considers equal keep their
+  // relative order.
+  void orderForEviction(std::vector<CachedFrame> &frames, const EvictionContext &context) const;
+
+  virtual CacheEvictionPolicyType getType() const = 0;
+
+protected:
+  // Should frame a be removed from the cache before frame b?
+  virtual bool evictBefore(const CachedFrame &    a,
+                           const CachedFrame &    b,
+                           const EvictionContext &context) const = 0;
+};
+
+// Keep the order in which the video cache found the frames (which is based on the playlist order).
+class PlaylistOrderEvictionPolicy : public CacheEvictionPolicy
+{
+public:
+  CacheEvictionPolicyType getType() const override
+  {
+    return CacheEvictionPolicyType::PlaylistOrder;
+  }
+
+protected:
+  bool evictBefore(const CachedFrame &, const CachedFrame &, const EvictionContext &) const override
+  {
+    return false;
+  }
+};
+
+// Remove the frames first that were not shown for the longest time.
+class LeastRecentlyUsedEvictionPolicy : public CacheEvictionPolicy
+{
+public:
+  CacheEvictionPolicyType getType() const override
+  {
+    return CacheEvictionPolicyType::LeastRecentlyUsed;
+  }
+
+protected:
+  bool
+  evictBefore(const CachedFrame &a, const CachedFrame &b, const EvictionContext &) const override
+  {
+    return a.lastAccess < b.lastAccess;
+  }
+};
+
+// Remove the frames first that will be needed last. Frames from other items than the one at the
+// playhead go first. From the item at the playhead, frames that were already played are removed
+// before the frames that are still ahead of the playhead in playback direction.
+class DistanceFromPlayheadEvictionPolicy : public CacheEvictionPolicy
+{
+public:
+  CacheEvictionPolicyType getType() const override
+  {
+    return CacheEvictionPolicyType::DistanceFromPlayhead;
+  }
+
+  // How far away (in frames of playback) is the given frame? Higher values are evicted first.
+  static int64_t getDistance(const CachedFrame &frame, const EvictionContext &context);
+
+protected:
+  bool evictBefore(const CachedFrame &    a,
+                   const CachedFrame &    b,
+                   const EvictionContext &context) const override
+  {
+    return getDistance(a, context) > getDistance(b, context);
+  }
+};
+
+std::unique_ptr<CacheEvictionPolicy> createCacheEvictionPolicy(CacheEvictionPolicyType type);
+
+} // namespace video
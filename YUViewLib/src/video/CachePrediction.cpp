@@ -0,0 +1,153 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CachePrediction.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace video
+{
+
+namespace
+{
+
+// All calculations are done for forward playback. For backward playback the frame indices are
+// mirrored.
+struct ForwardRange
+{
+  int64_t first{};
+  int64_t last{};
+
+  bool contains(int64_t x) const { return x >= this->first && x <= this->last; }
+};
+
+ForwardRange toForwardRange(indexRange range, bool backwards)
+{
+  if (backwards)
+    return {-int64_t(range.second), -int64_t(range.first)};
+  return {range.first, range.second};
+}
+
+} // namespace
+
+int64_t getExpectedAccessTime(int frameIndex, indexRange range, const PlayheadState &state)
+{
+  const auto backwards = (state.step < 0);
+  const auto step      = std::max(int64_t(std::abs(state.step)), int64_t(1));
+  const auto mirror    = [backwards](int64_t x) { return backwards ? -x : x; };
+
+  const auto frame    = mirror(frameIndex);
+  const auto playhead = mirror(state.frameIndex);
+
+  auto playbackRange = toForwardRange(range, backwards);
+  auto wrapAround    = state.wrapAround;
+  if (state.loopRange)
+  {
+    const auto loop = toForwardRange(*state.loopRange, backwards);
+    if (loop.contains(playhead))
+    {
+      playbackRange.first = std::max(playbackRange.first, loop.first);
+      playbackRange.last  = std::min(playbackRange.last, loop.last);
+      wrapAround          = true;
+    }
+  }
+
+  if (playbackRange.contains(frame))
+  {
+    if (frame >= playhead && (frame - playhead) % step == 0)
+      return (frame - playhead) / step;
+    // After wrapping around, playback starts again exactly at the start of the range
+    if (frame < playhead && wrapAround && (frame - playbackRange.first) % step == 0)
+      return (playbackRange.last - playhead) / step + 1 + (frame - playbackRange.first) / step;
+  }
+
+  // Not reached by playback. This is more than any number of ticks of a reachable frame.
+  const auto unreachableOffset = int64_t(range.second) - range.first + 2;
+  return unreachableOffset + std::abs(frame - playhead);
+}
+
+std::vector<indexRange>
+getFramesInExpectedAccessOrder(indexRange range, const PlayheadState &state, int64_t maxNrFrames)
+{
+  if (range.second < range.first || maxNrFrames <= 0)
+    return {};
+
+  struct FrameAndTime
+  {
+    int     frameIndex;
+    int64_t accessTime;
+  };
+  std::vector<FrameAndTime> frames;
+  frames.reserve(range.second - range.first + 1);
+  for (int i = range.first; i <= range.second; i++)
+    frames.push_back({i, getExpectedAccessTime(i, range, state)});
+
+  // For equal access times (only frames that are not shown by playback) prefer the frames closer to
+  // the playhead.
+  const auto playhead = state.frameIndex;
+  std::sort(frames.begin(), frames.end(), [playhead](const FrameAndTime &a, const FrameAndTime &b) {
+    if (a.accessTime != b.accessTime)
+      return a.accessTime < b.accessTime;
+    const auto distanceA = std::abs(a.frameIndex - playhead);
+    const auto distanceB = std::abs(b.frameIndex - playhead);
+    if (distanceA != distanceB)
+      return distanceA < distanceB;
+    return a.frameIndex < b.frameIndex;
+  });
+
+  if (int64_t(frames.size()) > maxNrFrames)
+    frames.resize(maxNrFrames);
+
+  // Merge consecutive frames into segments
+  std::vector<indexRange> segments;
+  for (const auto &frame : frames)
+  {
+    if (!segments.empty())
+    {
+      auto &     segment    = segments.back();
+      const auto isSingle   = (segment.first == segment.second);
+      const auto ascending  = isSingle || segment.first < segment.second;
+      const auto descending = isSingle || segment.first > segment.second;
+      if ((ascending && frame.frameIndex == segment.second + 1) ||
+          (descending && frame.frameIndex == segment.second - 1))
+      {
+        segment.second = frame.frameIndex;
+        continue;
+      }
+    }
+    segments.push_back(indexRange(frame.frameIndex, frame.frameIndex));
+  }
+  return segments;
+}
+
+} // namespace video
@@ -0,0 +1,69 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace video
+{
+
+// The state of the playback that the order of caching is predicted from
+struct PlayheadState
+{
+  int frameIndex{0};
+  // How many frames playback advances per timer tick. Negative if playing backwards.
+  int step{1};
+  // Does playback wrap around at the end of the range (repeat one)?
+  bool wrapAround{false};
+  // If the playhead is within this range, playback stays in it and always wraps around.
+  std::optional<indexRange> loopRange;
+};
+
+// In how many playback ticks will the frame from the given range be shown? Frames that playback
+// will not reach (e.g. frames behind the playhead if playback does not wrap around or frames that
+// are skipped when playing faster) get values that are higher than the ones of all reachable
+// frames. For these, frames closer to the playhead get lower values because the user is more likely
+// to seek there.
+int64_t getExpectedAccessTime(int frameIndex, indexRange range, const PlayheadState &state);
+
+// Sort the frames of the range by their expected access time and return (at most) the first
+// maxNrFrames as segments of consecutive frames. The frames of each segment are to be cached
+// from first to second. For backwards playback first is bigger than second.
+std::vector<indexRange>
+getFramesInExpectedAccessOrder(indexRange range, const PlayheadState &state, int64_t maxNrFrames);
+
+} // namespace video
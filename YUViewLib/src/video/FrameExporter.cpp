@@ -0,0 +1,316 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameExporter.h"
+
+#include <video/FrameReorderBuffer.h>
+#include <video/PixelFormatConverter.h>
+#include <video/rgb/ConversionRGB.h>
+#include <video/videoHandler.h>
+#include <video/yuv/ConversionRGBToYUV.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#define FRAMEEXPORTER_DEBUG 0
+#if FRAMEEXPORTER_DEBUG && !NDEBUG
+#include <QDebug>
+#define DEBUG_EXPORT(msg) qDebug() << msg
+#else
+#define DEBUG_EXPORT(msg) ((void)0)
+#endif
+
+namespace video
+{
+
+namespace
+{
+
+// How many frames per loading thread may be waiting in the reorder buffer
+constexpr auto BUFFERED_FRAMES_PER_THREAD = 2;
+
+QByteArray getImageFormat(const QString &outputPath)
+{
+  return QFileInfo(outputPath).suffix().toLower().toLatin1();
+}
+
+} // namespace
+
+FrameExporter::FrameExporter(videoHandler *video, const Settings &settings, int threadLimit)
+    : video(video), settings(settings), threadLimit(threadLimit)
+{
+}
+
+bool FrameExporter::run()
+{
+  if (auto error = this->checkSettings())
+  {
+    this->setError(*error);
+    return false;
+  }
+
+  const auto firstFrame = this->settings.frameRange.first;
+  const auto lastFrame  = this->settings.frameRange.second;
+  const auto nrThreads  = this->getNumberThreads();
+  DEBUG_EXPORT("FrameExporter::run frames " << firstFrame << "-" << lastFrame << " threads "
+                                            << nrThreads);
+
+  QFile rawFile(this->settings.outputPath);
+  if (this->settings.outputType != OutputType::ImageSequence &&
+      !rawFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    this->setError("Unable to open the output file " + this->settings.outputPath);
+    return false;
+  }
+
+  FrameReorderBuffer buffer(firstFrame, nrThreads * BUFFERED_FRAMES_PER_THREAD);
+  std::atomic_int    nextFrame{firstFrame};
+
+  QThreadPool threadPool;
+  threadPool.setMaxThreadCount(nrThreads);
+  QList<QFuture<void>> loadingThreads;
+  for (int i = 0; i < nrThreads; i++)
+    loadingThreads.append(QtConcurrent::run(
+        &threadPool, [this, &buffer, &nextFrame]() { this->loadFrames(buffer, nextFrame); }));
+
+  const auto nrDigits = std::max(int(QString::number(lastFrame).size()), 4);
+  for (int frameIndex = firstFrame; frameIndex <= lastFrame && !this->canceled; frameIndex++)
+  {
+    auto data = buffer.takeNextFrame();
+    if (!data)
+      break;
+
+    bool writeOk{};
+    if (this->settings.outputType == OutputType::ImageSequence)
+    {
+      QFile imageFile(getImageFileName(this->settings.outputPath, frameIndex, nrDigits));
+      writeOk = imageFile.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+                imageFile.write(*data) == data->size();
+    }
+    else
+      writeOk = rawFile.write(*data) == data->size();
+
+    if (!writeOk)
+    {
+      this->setError(QString("Writing frame %1 failed.").arg(frameIndex));
+      break;
+    }
+
+    emit signalFrameWritten(frameIndex - firstFrame + 1);
+  }
+
+  // Wake up all loading threads that are still waiting for space in the buffer
+  buffer.abort();
+  for (auto &thread : loadingThreads)
+    thread.waitForFinished();
+
+  return !this->canceled && this->getErrorMessage().isEmpty();
+}
+
+QString FrameExporter::getErrorMessage() const
+{
+  QMutexLocker lock(&this->errorMutex);
+  return this->errorMessage;
+}
+
+std::optional<QString> FrameExporter::checkSettings() const
+{
+  if (this->video == nullptr)
+    return "The item has no video that can be exported.";
+  if (this->settings.frameRange.first < 0 ||
+      this->settings.frameRange.second < this->settings.frameRange.first)
+    return QString("The frame range %1 to %2 is not valid.")
+        .arg(this->settings.frameRange.first)
+        .arg(this->settings.frameRange.second);
+  if (this->settings.outputPath.isEmpty())
+    return "No output file given.";
+
+  if (this->settings.outputType == OutputType::RawYUV)
+  {
+    auto yuvVideo = dynamic_cast<yuv::videoHandlerYUV *>(this->video);
+    if (yuvVideo && yuvVideo->getPixelFormatYUV() == this->settings.pixelFormatYUV)
+      return {};
+
+    std::string whyNot;
+    if (!yuv::canConvertARGBToYUV(
+            this->settings.pixelFormatYUV, this->video->getFrameSize(), &whyNot))
+      return QString::fromStdString(whyNot);
+  }
+  else if (this->settings.outputType == OutputType::RawRGB)
+  {
+    if (!this->settings.pixelFormatRGB.isValid())
+      return "The RGB format is not valid.";
+  }
+  else if (!QImageWriter::supportedImageFormats().contains(
+               getImageFormat(this->settings.outputPath)))
+    return "The image format of the output file " + this->settings.outputPath +
+           " is not supported.";
+
+  return {};
+}
+
+QString FrameExporter::getImageFileName(const QString &outputPath, int frameIndex, int nrDigits)
+{
+  QFileInfo  fileInfo(outputPath);
+  const auto fileName = QString("%1_%2.%3")
+                            .arg(fileInfo.completeBaseName())
+                            .arg(frameIndex, nrDigits, 10, QChar('0'))
+                            .arg(fileInfo.suffix());
+  return QDir(fileInfo.path()).filePath(fileName);
+}
+
+void FrameExporter::loadFrames(FrameReorderBuffer &buffer, std::atomic_int &nextFrame)
+{
+  while (true)
+  {
+    if (this->canceled)
+    {
+      buffer.abort();
+      return;
+    }
+
+    const auto frameIndex = nextFrame++;
+    if (frameIndex > this->settings.frameRange.second)
+      return;
+    if (!buffer.waitForSpace(frameIndex))
+      return;
+
+    auto data = this->loadAndConvertFrame(frameIndex);
+    if (!data)
+    {
+      buffer.abort();
+      return;
+    }
+    buffer.addFrame(frameIndex, *data);
+  }
+}
+
+std::optional<QByteArray> FrameExporter::loadAndConvertFrame(int frameIndex)
+{
+  DEBUG_EXPORT("FrameExporter::loadAndConvertFrame " << frameIndex);
+
+  if (this->settings.outputType == OutputType::RawYUV)
+  {
+    // Raw YUV data can be written directly or converted to the target YUV format without the
+    // (lossy) detour over an 8 bit RGB image.
+    auto yuvVideo = dynamic_cast<yuv::videoHandlerYUV *>(this->video);
+    if (yuvVideo)
+    {
+      const auto sourceFormat = yuvVideo->getPixelFormatYUV();
+      const auto converter    = PixelFormatConverter(
+          sourceFormat, this->settings.pixelFormatYUV, this->video->getFrameSize());
+      if (sourceFormat == this->settings.pixelFormatYUV || converter.isValid())
+      {
+        auto rawData = yuvVideo->loadRawYUVDataForExport(frameIndex);
+        if (!rawData)
+        {
+          this->setError(QString("Loading frame %1 failed.").arg(frameIndex));
+          return {};
+        }
+        if (sourceFormat == this->settings.pixelFormatYUV)
+          return rawData;
+        auto convertedData = converter.convertFrame(*rawData);
+        if (convertedData.isEmpty())
+        {
+          this->setError(QString("Converting frame %1 failed.").arg(frameIndex));
+          return {};
+        }
+        return convertedData;
+      }
+    }
+  }
+
+  auto image = this->video->loadFrameForExport(frameIndex);
+  if (image.isNull())
+  {
+    this->setError(QString("Loading frame %1 failed.").arg(frameIndex));
+    return {};
+  }
+
+  QByteArray data;
+  if (this->settings.outputType == OutputType::ImageSequence)
+  {
+    QBuffer imageBuffer(&data);
+    imageBuffer.open(QIODevice::WriteOnly);
+    image.save(&imageBuffer, getImageFormat(this->settings.outputPath).constData());
+  }
+  else
+  {
+    image = image.convertToFormat(QImage::Format_ARGB32);
+    const auto frameSize =
+        Size(static_cast<unsigned>(image.width()), static_cast<unsigned>(image.height()));
+    if (this->settings.outputType == OutputType::RawYUV)
+      data = yuv::convertARGBToYUV(image.constBits(),
+                                   image.bytesPerLine(),
+                                   frameSize,
+                                   this->settings.pixelFormatYUV,
+                                   this->settings.colorConversion);
+    else
+      data = rgb::convertARGBToInputRGB(
+          image.constBits(), image.bytesPerLine(), frameSize, this->settings.pixelFormatRGB);
+  }
+
+  if (data.isEmpty())
+  {
+    this->setError(QString("Converting frame %1 failed.").arg(frameIndex));
+    return {};
+  }
+  return data;
+}
+
+int FrameExporter::getNumberThreads() const
+{
+  auto nrThreads =
+      this->settings.nrThreads > 0 ? this->settings.nrThreads : QThread::idealThreadCount();
+  if (this->threadLimit > 0)
+    nrThreads = std::min(nrThreads, this->threadLimit);
+  const auto nrFrames = this->settings.frameRange.second - this->settings.frameRange.first + 1;
+  return std::clamp(nrThreads, 1, nrFrames);
+}
+
+void FrameExporter::setError(const QString &error)
+{
+  QMutexLocker lock(&this->errorMutex);
+  if (this->errorMessage.isEmpty())
+    this->errorMessage = error;
+}
+
+} // namespace video
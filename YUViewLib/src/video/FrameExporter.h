@@ -0,0 +1,125 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+
+#include <common/Typedef.h>
+#include <video/rgb/PixelFormatRGB.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+namespace video
+{
+
+class videoHandler;
+class FrameReorderBuffer;
+
+/* Export a range of frames of a video handler to a raw YUV or RGB file or to a sequence of
+ * numbered image files. The frames are loaded and converted by multiple threads using the same
+ * path as caching (videoHandler::loadFrameForExport). The converted frames are brought back into
+ * order by a FrameReorderBuffer and written by a single writer (the thread that calls run()). The
+ * number of frames that are kept in memory is bounded by the reorder buffer.
+ * If the video handler is a YUV handler and the output format is the format of the handler, the
+ * raw data is written without conversion (e.g. the decoded frames of a compressed file).
+ */
+class FrameExporter : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class OutputType
+  {
+    RawYUV,
+    RawRGB,
+    ImageSequence
+  };
+
+  struct Settings
+  {
+    OutputType outputType{OutputType::RawYUV};
+    indexRange frameRange{0, 0};
+    // The raw output file or the name of the image files. For image sequences, the frame index is
+    // appended to the base name of the file and the image format is chosen by the suffix.
+    QString              outputPath;
+    yuv::PixelFormatYUV  pixelFormatYUV;
+    yuv::ColorConversion colorConversion{yuv::ColorConversion::BT709_LimitedRange};
+    rgb::PixelFormatRGB  pixelFormatRGB;
+    // The number of threads that load frames. 0 uses one thread per core.
+    int nrThreads{0};
+  };
+
+  // threadLimit: The limit on threads that can load frames from the item at the same time (see
+  // playlistItem::cachingThreadLimit). -1 means no limit.
+  FrameExporter(videoHandler *video, const Settings &settings, int threadLimit = -1);
+
+  // Export all frames. This blocks until all frames are written, an error occurred or the export
+  // was canceled from another thread. Returns true if all frames were written.
+  bool run();
+  void cancel() { this->canceled = true; }
+  bool isCanceled() const { return this->canceled; }
+
+  QString getErrorMessage() const;
+
+  // Check the settings without loading any frames. Returns an error message if they are invalid.
+  std::optional<QString> checkSettings() const;
+
+  // The file name for the given frame of an image sequence (e.g. out.png -> out_0042.png)
+  static QString getImageFileName(const QString &outputPath, int frameIndex, int nrDigits);
+
+signals:
+  // Emitted from the thread that runs the export after each written frame
+  void signalFrameWritten(int nrFramesWritten);
+
+private:
+  void                      loadFrames(FrameReorderBuffer &buffer, std::atomic_int &nextFrame);
+  std::optional<QByteArray> loadAndConvertFrame(int frameIndex);
+  int                       getNumberThreads() const;
+
+  void setError(const QString &error);
+
+  videoHandler *video{};
+  Settings      settings;
+  int           threadLimit{-1};
+
+  std::atomic_bool canceled{false};
+  mutable QMutex   errorMutex;
+  QString          errorMessage;
+};
+
+} // namespace video
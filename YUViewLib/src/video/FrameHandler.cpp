@@ -35,6 +35,7 @@
 #include <QPainter>
 
 #include <common/FunctionsGui.h>
+#include <common/GlyphAtlas.h>
 #include <decoder/decoderTarga.h>
 #include <playlistitem/playlistItem.h>
 
@@ -114,6 +115,9 @@ FrameHandler::frameSizePresetList FrameHandler::presetFrameSizes;
 
 FrameHandler::FrameHandler()
 {
+  this->connect(&this->imagePyramid, &ImagePyramid::levelsReady, this, [this] {
+    emit this->signalHandlerChanged(true, RECACHE_NONE);
+  });
 }
 
 QLayout *FrameHandler::createFrameHandlerControls(bool isSizeFixed)
@@ -270,7 +274,7 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   videoRect.moveCenter(QPoint(0, 0));
 
   // Draw the current image (currentFrame)
-  painter->drawImage(videoRect, this->currentImage);
+  this->drawCurrentImage(painter, videoRect, zoomFactor);
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
   {
@@ -279,6 +283,11 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   }
 }
 
+void FrameHandler::drawCurrentImage(QPainter *painter, const QRect &videoRect, double zoomFactor)
+{
+  this->imagePyramid.draw(painter, videoRect, this->currentImage, zoomFactor);
+}
+
 void FrameHandler::drawPixelValues(QPainter *painter,
                                    const int,
                                    const QRect  &videoRect,
@@ -316,6 +325,9 @@ void FrameHandler::drawPixelValues(QPainter *painter,
   // This QRect has the size of one pixel and is moved on top of each pixel to draw the text
   QRect pixelRect;
   pixelRect.setSize(QSize(zoomFactor, zoomFactor));
+
+  const int  formatBase = settings.value("ShowPixelValuesHex").toBool() ? 16 : 10;
+  GlyphBatch glyphBatch(painter);
   for (int x = xMin; x <= xMax; x++)
   {
     for (int y = yMin; y <= yMax; y++)
@@ -326,10 +338,9 @@ void FrameHandler::drawPixelValues(QPainter *painter,
       pixelRect.moveCenter(pixCenter);
 
       // Get the text to show
-      bool      drawWhite = false;
-      QRgb      pixVal;
-      QString   valText;
-      const int formatBase = settings.value("ShowPixelValuesHex").toBool() ? 16 : 10;
+      bool    drawWhite = false;
+      QRgb    pixVal;
+      QString valText;
       if (item2 != nullptr)
       {
         auto pixel1 = getPixelVal(x, y);
@@ -366,7 +377,7 @@ void FrameHandler::drawPixelValues(QPainter *painter,
       }
 
       painter->setPen(drawWhite ? Qt::white : Qt::black);
-      painter->drawText(pixelRect, Qt::AlignCenter, valText);
+      glyphBatch.drawText(pixelRect, Qt::AlignCenter, valText);
     }
   }
 }
@@ -36,6 +36,7 @@
 #include <common/SaveUi.h>
 #include <common/Typedef.h>
 #include <common/YUViewDomElement.h>
+#include <video/ImagePyramid.h>
 
 #include <QImage>
 #include <QObject>
@@ -140,6 +141,10 @@ protected:
   QImage currentImage;
   Size   frameSize;
 
+  // Draw the current image (or the visible part of a downscaled version of it)
+  void         drawCurrentImage(QPainter *painter, const QRect &videoRect, double zoomFactor);
+  ImagePyramid imagePyramid;
+
   // Get the pixel value from currentImage. Make sure that currentImage is the correct image.
   QRgb         getPixelVal(const QPoint &pos) { return getPixelVal(pos.x(), pos.y()); }
   virtual QRgb getPixelVal(int x, int y) { return currentImage.pixel(x, y); }
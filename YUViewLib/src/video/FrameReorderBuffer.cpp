@@ -0,0 +1,105 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameReorderBuffer.h"
+
+#include <algorithm>
+
+namespace video
+{
+
+FrameReorderBuffer::FrameReorderBuffer(int firstFrameIndex, int maxBufferedFrames)
+    : nextFrameIndex(firstFrameIndex), maxBufferedFrames(std::max(maxBufferedFrames, 1))
+{
+}
+
+bool FrameReorderBuffer::waitForSpace(int frameIndex)
+{
+  QMutexLocker lock(&this->accessMutex);
+  while (!this->aborted && frameIndex >= this->nextFrameIndex + this->maxBufferedFrames)
+    this->frameTaken.wait(&this->accessMutex);
+  return !this->aborted;
+}
+
+void FrameReorderBuffer::addFrame(int frameIndex, const QByteArray &data)
+{
+  QMutexLocker lock(&this->accessMutex);
+  if (this->aborted || frameIndex < this->nextFrameIndex)
+    return;
+  this->frames[frameIndex] = data;
+  this->frameAdded.wakeAll();
+}
+
+std::optional<QByteArray> FrameReorderBuffer::takeNextFrame()
+{
+  QMutexLocker lock(&this->accessMutex);
+  while (!this->aborted && this->frames.count(this->nextFrameIndex) == 0)
+    this->frameAdded.wait(&this->accessMutex);
+  if (this->aborted)
+    return {};
+
+  auto it   = this->frames.find(this->nextFrameIndex);
+  auto data = it->second;
+  this->frames.erase(it);
+  this->nextFrameIndex++;
+  this->frameTaken.wakeAll();
+  return data;
+}
+
+void FrameReorderBuffer::abort()
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->aborted = true;
+  this->frames.clear();
+  this->frameAdded.wakeAll();
+  this->frameTaken.wakeAll();
+}
+
+bool FrameReorderBuffer::isAborted() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->aborted;
+}
+
+int FrameReorderBuffer::getNextFrameIndex() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->nextFrameIndex;
+}
+
+int FrameReorderBuffer::getNumberBufferedFrames() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return static_cast<int>(this->frames.size());
+}
+
+} // namespace video
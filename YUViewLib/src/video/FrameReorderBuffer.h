@@ -0,0 +1,81 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+
+namespace video
+{
+
+/* Brings frames that are produced out of order by multiple threads back into order. Producers
+ * may only add frames that lie within a window of maxBufferedFrames after the next frame that the
+ * consumer will take. Producers that are too far ahead block in waitForSpace until the consumer
+ * catches up, so the memory needed is bounded no matter how unevenly the producers progress.
+ * All functions are thread-safe. After abort() all waiting threads return.
+ */
+class FrameReorderBuffer
+{
+public:
+  FrameReorderBuffer(int firstFrameIndex, int maxBufferedFrames);
+
+  // Block until the frame may be added (it is within the window after the next frame to take).
+  // Returns false if the buffer was aborted.
+  bool waitForSpace(int frameIndex);
+  void addFrame(int frameIndex, const QByteArray &data);
+
+  // Block until the next frame in order is available and take it. Returns nothing if the buffer
+  // was aborted.
+  std::optional<QByteArray> takeNextFrame();
+
+  void abort();
+  bool isAborted() const;
+
+  int getNextFrameIndex() const;
+  int getNumberBufferedFrames() const;
+
+private:
+  mutable QMutex            accessMutex;
+  QWaitCondition            frameAdded;
+  QWaitCondition            frameTaken;
+  std::map<int, QByteArray> frames;
+  int                       nextFrameIndex{};
+  int                       maxBufferedFrames{};
+  bool                      aborted{};
+};
+
+} // namespace video
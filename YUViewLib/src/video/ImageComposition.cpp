@@ -0,0 +1,123 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImageComposition.h"
+
+#include <QPainter>
+#include <QtConcurrent>
+
+#include <common/FunctionsGui.h>
+
+namespace video
+{
+
+QImage composeImage(const QRect                     &composedRect,
+                    const std::vector<ComposedItem> &items,
+                    QThreadPool                     *threadPool)
+{
+  if (composedRect.isEmpty())
+    return {};
+
+  QList<QFuture<QImage>> loadingImages;
+  if (threadPool != nullptr)
+    for (const auto &item : items)
+      loadingImages.append(QtConcurrent::run(threadPool, item.loadImage));
+
+  QImage composed(composedRect.size(), functionsGui::platformImageFormat(true));
+  composed.fill(Qt::transparent);
+  QPainter painter(&composed);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    const auto image =
+        (threadPool != nullptr) ? loadingImages[int(i)].result() : items[i].loadImage();
+    if (!image.isNull())
+      painter.drawImage(items[i].rect.topLeft() - composedRect.topLeft(), image);
+  }
+  return composed;
+}
+
+bool ComposedFrameCache::contains(int frameIdx) const
+{
+  QMutexLocker lock(&this->access);
+  return this->frames.contains(frameIdx);
+}
+
+std::optional<QImage> ComposedFrameCache::get(int frameIdx)
+{
+  QMutexLocker lock(&this->access);
+  auto         it = this->frames.find(frameIdx);
+  if (it == this->frames.end())
+    return {};
+  this->lastAccess[frameIdx] = ++this->accessCounter;
+  return *it;
+}
+
+void ComposedFrameCache::insert(int frameIdx, const QImage &image)
+{
+  QMutexLocker lock(&this->access);
+  this->frames.insert(frameIdx, image);
+  this->lastAccess.insert(frameIdx, ++this->accessCounter);
+}
+
+void ComposedFrameCache::remove(int frameIdx)
+{
+  QMutexLocker lock(&this->access);
+  this->frames.remove(frameIdx);
+  this->lastAccess.remove(frameIdx);
+}
+
+void ComposedFrameCache::clear()
+{
+  QMutexLocker lock(&this->access);
+  this->frames.clear();
+  this->lastAccess.clear();
+}
+
+QList<int> ComposedFrameCache::getFrameIndices() const
+{
+  QMutexLocker lock(&this->access);
+  return this->frames.keys();
+}
+
+int ComposedFrameCache::size() const
+{
+  QMutexLocker lock(&this->access);
+  return this->frames.size();
+}
+
+uint64_t ComposedFrameCache::getLastAccess(int frameIdx) const
+{
+  QMutexLocker lock(&this->access);
+  return this->lastAccess.value(frameIdx, 0);
+}
+
+} // namespace video
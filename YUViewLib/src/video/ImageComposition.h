@@ -0,0 +1,88 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <QImage>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QRect>
+
+class QThreadPool;
+
+namespace video
+{
+
+// An item of a composed image: The rect where it is drawn and a function that loads its image
+struct ComposedItem
+{
+  QRect                   rect;
+  std::function<QImage()> loadImage;
+};
+
+/* Load the images of all items and draw them into one image that covers composedRect. If a thread
+ * pool is given, the images are loaded in parallel in the pool. Otherwise they are loaded one
+ * after the other in this thread. Either way, the items are drawn in the order of the list. Areas
+ * that are not covered by any item stay transparent. Return a null image if composedRect is empty.
+ */
+QImage composeImage(const QRect                     &composedRect,
+                    const std::vector<ComposedItem> &items,
+                    QThreadPool                     *threadPool);
+
+// A thread safe cache of composed frames. The last access of each frame is counted so that the
+// video cache can evict the least recently used frames first.
+class ComposedFrameCache
+{
+public:
+  bool                  contains(int frameIdx) const;
+  std::optional<QImage> get(int frameIdx);
+  void                  insert(int frameIdx, const QImage &image);
+  void                  remove(int frameIdx);
+  void                  clear();
+
+  QList<int> getFrameIndices() const;
+  int        size() const;
+  uint64_t   getLastAccess(int frameIdx) const;
+
+private:
+  QMutex mutable      access;
+  QMap<int, QImage>   frames;
+  QMap<int, uint64_t> lastAccess;
+  uint64_t            accessCounter{};
+};
+
+} // namespace video
@@ -0,0 +1,152 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImagePool.h"
+
+#include <utility>
+
+namespace video
+{
+
+namespace
+{
+
+int64_t getImageBytes(const QImage &image)
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
+  return image.byteCount();
+#else
+  return image.sizeInBytes();
+#endif
+}
+
+} // namespace
+
+ImagePool &ImagePool::instance()
+{
+  static ImagePool pool;
+  return pool;
+}
+
+QImage ImagePool::acquire(const QSize &size, QImage::Format format)
+{
+  {
+    QMutexLocker lock(&this->accessMutex);
+    // Search from the back so that the most recently released image (which is most likely still in
+    // the CPU caches) is used first.
+    for (auto it = this->images.rbegin(); it != this->images.rend(); it++)
+    {
+      if (it->size() == size && it->format() == format)
+      {
+        auto image = std::move(*it);
+        this->images.erase(std::next(it).base());
+        this->pooledBytes -= getImageBytes(image);
+        this->counters.reuses++;
+        return image;
+      }
+    }
+    this->counters.allocations++;
+  }
+  return QImage(size, format);
+}
+
+void ImagePool::release(QImage &image)
+{
+  if (image.isNull())
+    return;
+
+  auto releasedImage = std::exchange(image, QImage());
+
+  QMutexLocker lock(&this->accessMutex);
+  if (!releasedImage.isDetached() || getImageBytes(releasedImage) > this->maxBytes)
+  {
+    this->counters.notPooled++;
+    return;
+  }
+
+  this->pooledBytes += getImageBytes(releasedImage);
+  this->images.push_back(std::move(releasedImage));
+  this->counters.released++;
+  this->dropOldestImagesUntilFits();
+}
+
+void ImagePool::replace(QImage &image, const QImage &newImage)
+{
+  auto replacedImage = std::exchange(image, newImage);
+  this->release(replacedImage);
+}
+
+void ImagePool::setMaxBytes(int64_t bytes)
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->maxBytes = bytes;
+  this->dropOldestImagesUntilFits();
+}
+
+int64_t ImagePool::getMaxBytes() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->maxBytes;
+}
+
+void ImagePool::clear()
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->images.clear();
+  this->pooledBytes = 0;
+}
+
+ImagePool::Counters ImagePool::getCounters() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  auto         counters = this->counters;
+  counters.pooledBytes    = this->pooledBytes;
+  counters.nrPooledImages = unsigned(this->images.size());
+  return counters;
+}
+
+void ImagePool::resetCounters()
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->counters = {};
+}
+
+void ImagePool::dropOldestImagesUntilFits()
+{
+  while (this->pooledBytes > this->maxBytes && !this->images.empty())
+  {
+    this->pooledBytes -= getImageBytes(this->images.front());
+    this->images.pop_front();
+  }
+}
+
+} // namespace video
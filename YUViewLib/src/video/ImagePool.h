@@ -0,0 +1,98 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include <common/MemoryAccountant.h>
+
+#include <QImage>
+#include <QMutex>
+
+namespace video
+{
+
+/* A pool of image buffers that are reused instead of allocating a new QImage for every frame.
+ * In steady state playback every converted frame allocates a full frame image and every frame that
+ * is evicted from the cache frees one. For big frames these allocations (and the page faults when
+ * the new memory is first written) are a significant part of the conversion time.
+ * Images that are not used anymore are released to the pool. An image is only kept if the caller
+ * held the last reference to it (e.g. an image that is still shown is not pooled). The pool is
+ * bounded in bytes and drops the images that were released first. All functions are thread-safe.
+ */
+class ImagePool
+{
+public:
+  ImagePool() = default;
+  ImagePool(int64_t maxBytes) : maxBytes(maxBytes) {}
+
+  static ImagePool &instance();
+
+  // Get an image of the given size and format. The content of the image is undefined.
+  QImage acquire(const QSize &size, QImage::Format format);
+  // Give an image back to the pool. The image is empty afterwards.
+  void release(QImage &image);
+  // Set the image to newImage and release the image that was replaced
+  void replace(QImage &image, const QImage &newImage);
+
+  void    setMaxBytes(int64_t bytes);
+  int64_t getMaxBytes() const;
+  void    clear();
+
+  struct Counters
+  {
+    uint64_t allocations{}; // acquire() had to allocate a new image
+    uint64_t reuses{};      // acquire() returned a pooled image
+    uint64_t released{};    // Images that were put into the pool
+    uint64_t notPooled{};   // Released images that were still used elsewhere or too big
+    int64_t  pooledBytes{};
+    unsigned nrPooledImages{};
+  };
+  Counters getCounters() const;
+  void     resetCounters();
+
+private:
+  void dropOldestImagesUntilFits();
+
+  mutable QMutex     accessMutex;
+  std::deque<QImage> images;
+  int64_t            pooledBytes{0};
+  int64_t            maxBytes{int64_t(256) * 1024 * 1024};
+  Counters           counters;
+
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Image pool", [this] { return this->getCounters().pooledBytes; })};
+};
+
+} // namespace video
@@ -0,0 +1,204 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImagePyramid.h"
+
+#include <QPainter>
+#include <QtConcurrent>
+
+#include <cmath>
+
+namespace video
+{
+
+// Activate this if you want to know when the levels are built and which level is drawn.
+#define IMAGEPYRAMID_DEBUG_OUTPUT 0
+#if IMAGEPYRAMID_DEBUG_OUTPUT && !NDEBUG
+#include <QDebug>
+#define DEBUG_PYRAMID(fmt, ...) qDebug(fmt, __VA_ARGS__)
+#else
+#define DEBUG_PYRAMID(fmt, ...) ((void)0)
+#endif
+
+ImagePyramid::ImagePyramid()
+{
+  this->connect(&this->buildWatcher,
+                &QFutureWatcher<std::vector<QImage>>::finished,
+                this,
+                &ImagePyramid::onBuildFinished);
+}
+
+ImagePyramid::~ImagePyramid()
+{
+  this->buildWatcher.waitForFinished();
+}
+
+void ImagePyramid::draw(QPainter *    painter,
+                        const QRect & targetRect,
+                        const QImage &image,
+                        double        zoomFactor)
+{
+  if (image.isNull() || targetRect.isEmpty())
+    return;
+
+  // Level 0 is the image itself. Without downscaling there is nothing to gain.
+  const auto maxLevel = getLevelForZoomFactor(zoomFactor, 32);
+  if (maxLevel == 0)
+  {
+    painter->drawImage(targetRect, image);
+    return;
+  }
+
+  if (this->levelsImageKey != image.cacheKey())
+  {
+    // Only images that are drawn more than once (panning, zooming) are worth building the levels
+    // for. During playback every frame is drawn only once.
+    if (this->lastDrawnImageKey == image.cacheKey())
+      this->requestLevels(image);
+    this->lastDrawnImageKey = image.cacheKey();
+    painter->drawImage(targetRect, image);
+    return;
+  }
+
+  const auto  level      = getLevelForZoomFactor(zoomFactor, unsigned(this->levels.size()) + 1);
+  const auto &levelImage = (level == 0) ? image : this->levels.at(level - 1);
+
+  // Get the part of the target that is visible on the device (in the coordinates of the painter)
+  QRectF visibleRect = targetRect;
+  if (auto device = painter->device())
+  {
+    bool       invertible{};
+    const auto deviceToPainter = painter->combinedTransform().inverted(&invertible);
+    if (invertible)
+      visibleRect &= deviceToPainter.mapRect(QRectF(0, 0, device->width(), device->height()));
+  }
+  if (painter->hasClipping())
+    visibleRect &= painter->clipBoundingRect();
+  if (visibleRect.isEmpty())
+    return;
+
+  // Map the visible rect to whole pixels in the level and draw these
+  const auto scaleX = double(levelImage.width()) / targetRect.width();
+  const auto scaleY = double(levelImage.height()) / targetRect.height();
+  const auto sourceRect =
+      QRectF((visibleRect.left() - targetRect.left()) * scaleX,
+             (visibleRect.top() - targetRect.top()) * scaleY,
+             visibleRect.width() * scaleX,
+             visibleRect.height() * scaleY)
+          .toAlignedRect()
+          .intersected(levelImage.rect());
+  const auto drawRect = QRectF(targetRect.left() + sourceRect.left() / scaleX,
+                               targetRect.top() + sourceRect.top() / scaleY,
+                               sourceRect.width() / scaleX,
+                               sourceRect.height() / scaleY);
+
+  DEBUG_PYRAMID("ImagePyramid::draw level %u source %d,%d %dx%d",
+                level,
+                sourceRect.x(),
+                sourceRect.y(),
+                sourceRect.width(),
+                sourceRect.height());
+  painter->drawImage(drawRect, levelImage, sourceRect);
+}
+
+void ImagePyramid::clear()
+{
+  this->levels.clear();
+  this->levelsImageKey    = 0;
+  this->lastDrawnImageKey = 0;
+  this->pendingImage      = {};
+  this->levelsBytes.store(0);
+}
+
+unsigned ImagePyramid::getLevelForZoomFactor(double zoomFactor, unsigned nrLevels)
+{
+  if (zoomFactor <= 0.0 || zoomFactor > 0.5 || nrLevels == 0)
+    return 0;
+  const auto level = unsigned(std::floor(std::log2(1.0 / zoomFactor)));
+  return std::min(level, nrLevels - 1);
+}
+
+std::vector<QImage> ImagePyramid::buildLevels(const QImage &image)
+{
+  std::vector<QImage> levels;
+  auto                previous = image;
+  while (std::min(previous.width(), previous.height()) / 2 >= MIN_LEVEL_SIZE)
+  {
+    previous = previous.scaled(previous.width() / 2,
+                               previous.height() / 2,
+                               Qt::IgnoreAspectRatio,
+                               Qt::SmoothTransformation);
+    levels.push_back(previous);
+  }
+  return levels;
+}
+
+void ImagePyramid::requestLevels(const QImage &image)
+{
+  if (this->buildWatcher.isRunning())
+  {
+    // Only build the levels for the latest image once the running build is done
+    if (this->buildingImageKey != image.cacheKey())
+      this->pendingImage = image;
+    return;
+  }
+
+  DEBUG_PYRAMID("ImagePyramid::requestLevels %dx%d", image.width(), image.height());
+  this->buildingImageKey = image.cacheKey();
+  this->pendingImage     = {};
+  this->buildWatcher.setFuture(QtConcurrent::run([image] { return buildLevels(image); }));
+}
+
+void ImagePyramid::onBuildFinished()
+{
+  this->levels         = this->buildWatcher.result();
+  this->levelsImageKey = this->buildingImageKey;
+
+  int64_t bytes = 0;
+  for (const auto &level : this->levels)
+#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
+    bytes += level.byteCount();
+#else
+    bytes += level.sizeInBytes();
+#endif
+  this->levelsBytes.store(bytes);
+
+  if (!this->pendingImage.isNull())
+  {
+    auto image = this->pendingImage;
+    this->requestLevels(image);
+  }
+  else
+    emit levelsReady();
+}
+
+} // namespace video
@@ -0,0 +1,102 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <common/MemoryAccountant.h>
+
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <QRect>
+
+class QPainter;
+
+namespace video
+{
+
+/* A pyramid of downscaled versions of an image (each level has half the width and height of the
+ * previous one). When a big frame is shown zoomed out, scaling the full resolution image on every
+ * paint (e.g. while panning) is expensive. With the pyramid, only the visible part of the level
+ * closest to the zoom factor is drawn, so the cost of a paint is bounded by the size of the
+ * viewport and not by the size of the frame.
+ * The levels are built in the background when an image is drawn zoomed out for the second time.
+ * Until they are ready the full image is drawn and levelsReady() is emitted once they are.
+ */
+class ImagePyramid : public QObject
+{
+  Q_OBJECT
+
+public:
+  ImagePyramid();
+  ~ImagePyramid();
+
+  // Draw the image into the targetRect (in the coordinates of the painter). Only the part of the
+  // image that is visible in the painter is drawn.
+  void draw(QPainter *painter, const QRect &targetRect, const QImage &image, double zoomFactor);
+
+  void clear();
+
+  // The level to draw for the zoom factor. Level n is downscaled by 2^n. Chooses the smallest
+  // level that is not smaller than the drawn size so that the image is never upscaled.
+  static unsigned getLevelForZoomFactor(double zoomFactor, unsigned nrLevels);
+
+signals:
+  void levelsReady();
+
+private:
+  // Downscale until the smaller side of the image would get below this
+  static constexpr int MIN_LEVEL_SIZE = 64;
+  static std::vector<QImage> buildLevels(const QImage &image);
+
+  void requestLevels(const QImage &image);
+  void onBuildFinished();
+
+  // The key of the image that the levels were built for (QImage::cacheKey)
+  qint64              levelsImageKey{0};
+  std::vector<QImage> levels;
+  qint64              lastDrawnImageKey{0};
+
+  qint64                               buildingImageKey{0};
+  QImage                               pendingImage;
+  QFutureWatcher<std::vector<QImage>> buildWatcher;
+
+  std::atomic<int64_t> levelsBytes{0};
+
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Image pyramids", [this] { return this->levelsBytes.load(); })};
+};
+
+} // namespace video
@@ -0,0 +1,959 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PixelFormatConverter.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+
+// Restrict is basically a promise to the compiler that for the scope of the pointer, the target of
+// the pointer will only be accessed through that pointer (and pointers copied from it).
+#if __STDC__ != 1
+#define restrict __restrict /* use implementation __ format */
+#else
+#ifndef __STDC_VERSION__
+#define restrict __restrict /* use implementation __ format */
+#else
+#if __STDC_VERSION__ < 199901L
+#define restrict __restrict /* use implementation __ format */
+#else
+#/* all ok */
+#endif
+#endif
+#endif
+
+namespace video
+{
+
+namespace
+{
+
+using yuv::PackingOrder;
+using yuv::PixelFormatYUV;
+using yuv::PlaneOrder;
+using yuv::Subsampling;
+
+// The components are always processed in this order. For RGB formats, the components 0/1/2 are
+// R/G/B. For YUV formats the components 1 and 2 (U and V) may be subsampled.
+constexpr auto NrComponents   = 4;
+constexpr auto ComponentAlpha = 3;
+
+enum class LayoutType
+{
+  Planar,        // Every component in its own plane
+  SemiPlanar,    // A luma plane and one plane with the interleaved chroma components
+  PackedPixel,   // All components of one pixel next to each other (packed 4:4:4 YUV or RGB)
+  Packed422,     // 2 pixels in a group of 4 samples (e.g. UYVY)
+  BytePacked422, // 2 pixels in a group of 4 10 bit samples which are packed into 5 bytes
+  V210           // 6 pixels in 16 bytes (3 10 bit values in each 32 bit word)
+};
+
+struct PlaneLayout
+{
+  int64_t  offset{};
+  int64_t  rowStride{};
+  unsigned verticalSubsampling{1};
+};
+
+struct FrameLayout
+{
+  LayoutType               type{LayoutType::Planar};
+  std::vector<PlaneLayout> planes;
+
+  unsigned bitDepth{};
+  unsigned bytesPerSample{};
+  bool     bigEndian{};
+  unsigned subsamplingHor{1};
+  unsigned subsamplingVer{1};
+  bool     hasChroma{};
+  bool     hasAlpha{};
+
+  // The meaning depends on the type. Planar: The plane index of each component. SemiPlanar: The
+  // position of U and V in the interleaved chroma plane. PackedPixel/Packed422/BytePacked422: The
+  // position of each component in a group of samples (-1 if not present).
+  std::array<int, NrComponents> positions{-1, -1, -1, -1};
+  unsigned                      samplesPerGroup{};
+};
+
+bool isChromaComponent(const int component)
+{
+  return component == 1 || component == 2;
+}
+
+bool hasComponent(const FrameLayout &layout, const int component)
+{
+  if (isChromaComponent(component))
+    return layout.hasChroma;
+  if (component == ComponentAlpha)
+    return layout.hasAlpha;
+  return true;
+}
+
+std::optional<FrameLayout>
+getFrameLayoutYUV(const PixelFormatYUV &format, const Size frameSize, QString &errorMessage)
+{
+  const auto w = int64_t(frameSize.width);
+  const auto h = int64_t(frameSize.height);
+
+  FrameLayout layout;
+  if (format.getPredefinedFormat())
+  {
+    if (*format.getPredefinedFormat() != yuv::PredefinedPixelFormat::V210)
+    {
+      errorMessage = "Unsupported predefined pixel format.";
+      return {};
+    }
+    // The width is rounded up to a multiple of 48 pixels (8 groups of 6 pixels)
+    const auto groupsPerRow = (w + 47) / 48 * 8;
+    layout.type             = LayoutType::V210;
+    layout.bitDepth         = 10;
+    layout.subsamplingHor   = 2;
+    layout.hasChroma        = true;
+    layout.planes.push_back({0, groupsPerRow * 16, 1});
+    return layout;
+  }
+
+  layout.bitDepth       = format.getBitsPerSample();
+  layout.bytesPerSample = (layout.bitDepth + 7) / 8;
+  layout.bigEndian      = format.isBigEndian();
+  layout.subsamplingHor = unsigned(format.getSubsamplingHor());
+  layout.subsamplingVer = unsigned(format.getSubsamplingVer());
+  layout.hasChroma      = format.getSubsampling() != Subsampling::YUV_400;
+  layout.hasAlpha       = format.hasAlpha();
+
+  if (layout.bitDepth < 8 || layout.bitDepth > 16)
+  {
+    errorMessage = "Only bit depths from 8 to 16 bit are supported.";
+    return {};
+  }
+
+  const auto bps          = int64_t(layout.bytesPerSample);
+  const auto chromaWidth  = w / layout.subsamplingHor;
+  const auto chromaHeight = h / layout.subsamplingVer;
+  const auto chromaSubV   = layout.subsamplingVer;
+
+  if (format.isPlanar())
+  {
+    const auto uFirst = format.getPlaneOrder() == PlaneOrder::YUV ||
+                        format.getPlaneOrder() == PlaneOrder::YUVA;
+
+    layout.planes.push_back({0, w * bps, 1});
+    layout.positions[0] = 0;
+    auto offset         = w * h * bps;
+
+    if (format.isUVInterleaved())
+    {
+      if (layout.hasAlpha)
+      {
+        errorMessage = "Interleaved chroma planes with an alpha component are not supported.";
+        return {};
+      }
+      layout.type = LayoutType::SemiPlanar;
+      if (layout.hasChroma)
+      {
+        layout.planes.push_back({offset, chromaWidth * 2 * bps, chromaSubV});
+        layout.positions[1] = uFirst ? 0 : 1;
+        layout.positions[2] = uFirst ? 1 : 0;
+      }
+      return layout;
+    }
+
+    layout.type = LayoutType::Planar;
+    if (layout.hasChroma)
+    {
+      const auto chromaPlaneSize = chromaWidth * chromaHeight * bps;
+      layout.planes.push_back({offset, chromaWidth * bps, chromaSubV});
+      layout.planes.push_back({offset + chromaPlaneSize, chromaWidth * bps, chromaSubV});
+      layout.positions[1] = uFirst ? 1 : 2;
+      layout.positions[2] = uFirst ? 2 : 1;
+      offset += chromaPlaneSize * 2;
+    }
+    if (layout.hasAlpha)
+    {
+      layout.positions[ComponentAlpha] = int(layout.planes.size());
+      layout.planes.push_back({offset, w * bps, 1});
+    }
+    return layout;
+  }
+
+  const auto packing = format.getPackingOrder();
+  if (format.getSubsampling() == Subsampling::YUV_422)
+  {
+    layout.positions[0] = (packing == PackingOrder::YUYV || packing == PackingOrder::YVYU) ? 0 : 1;
+    layout.positions[1] = (packing == PackingOrder::UYVY)   ? 0
+                          : (packing == PackingOrder::YUYV) ? 1
+                          : (packing == PackingOrder::VYUY) ? 2
+                                                            : 3;
+    layout.positions[2] = (packing == PackingOrder::VYUY)   ? 0
+                          : (packing == PackingOrder::YVYU) ? 1
+                          : (packing == PackingOrder::UYVY) ? 2
+                                                            : 3;
+    layout.samplesPerGroup = 4;
+
+    if (format.isBytePacking())
+    {
+      if (layout.bitDepth != 10)
+      {
+        errorMessage = "Byte packing is only supported for 10 bit 4:2:2 formats.";
+        return {};
+      }
+      layout.type = LayoutType::BytePacked422;
+      layout.planes.push_back({0, w / 2 * 5, 1});
+      return layout;
+    }
+
+    layout.type = LayoutType::Packed422;
+    layout.planes.push_back({0, w * 2 * bps, 1});
+    return layout;
+  }
+
+  if (format.getSubsampling() == Subsampling::YUV_444 && !format.isBytePacking())
+  {
+    layout.type         = LayoutType::PackedPixel;
+    layout.positions[0] = (packing == PackingOrder::AYUV)   ? 1
+                          : (packing == PackingOrder::VUYA) ? 2
+                                                            : 0;
+    layout.positions[1] = (packing == PackingOrder::YUV || packing == PackingOrder::YUVA ||
+                           packing == PackingOrder::VUYA)
+                              ? 1
+                              : 2;
+    layout.positions[2] = (packing == PackingOrder::YVU)    ? 1
+                          : (packing == PackingOrder::AYUV) ? 3
+                          : (packing == PackingOrder::VUYA) ? 0
+                                                            : 2;
+    if (layout.hasAlpha)
+      layout.positions[ComponentAlpha] = (packing == PackingOrder::AYUV) ? 0 : 3;
+    layout.samplesPerGroup = layout.hasAlpha ? 4 : 3;
+    layout.planes.push_back({0, w * layout.samplesPerGroup * bps, 1});
+    return layout;
+  }
+
+  errorMessage = "Unsupported packed YUV format.";
+  return {};
+}
+
+std::optional<FrameLayout>
+getFrameLayoutRGB(const rgb::PixelFormatRGB &format, const Size frameSize, QString &errorMessage)
+{
+  const auto w = int64_t(frameSize.width);
+  const auto h = int64_t(frameSize.height);
+
+  FrameLayout layout;
+  layout.bitDepth       = format.getBitsPerSample();
+  layout.bytesPerSample = (layout.bitDepth + 7) / 8;
+  layout.bigEndian      = format.getEndianess() == Endianness::Big;
+  layout.hasChroma      = true;
+  layout.hasAlpha       = format.hasAlpha();
+
+  if (layout.bitDepth < 8 || layout.bitDepth > 16)
+  {
+    errorMessage = "Only bit depths from 8 to 16 bit are supported.";
+    return {};
+  }
+
+  layout.positions[0] = format.getChannelPosition(rgb::Channel::Red);
+  layout.positions[1] = format.getChannelPosition(rgb::Channel::Green);
+  layout.positions[2] = format.getChannelPosition(rgb::Channel::Blue);
+  layout.positions[3] = format.getChannelPosition(rgb::Channel::Alpha);
+
+  const auto bps        = int64_t(layout.bytesPerSample);
+  const auto nrChannels = format.nrChannels();
+  if (format.getDataLayout() == DataLayout::Planar)
+  {
+    layout.type = LayoutType::Planar;
+    for (unsigned i = 0; i < nrChannels; i++)
+      layout.planes.push_back({i * w * h * bps, w * bps, 1});
+  }
+  else
+  {
+    layout.type            = LayoutType::PackedPixel;
+    layout.samplesPerGroup = nrChannels;
+    layout.planes.push_back({0, w * nrChannels * bps, 1});
+  }
+  return layout;
+}
+
+std::optional<FrameLayout>
+getFrameLayout(const RawPixelFormat &format, const Size frameSize, QString &errorMessage)
+{
+  if (const auto formatYUV = std::get_if<PixelFormatYUV>(&format))
+    return getFrameLayoutYUV(*formatYUV, frameSize, errorMessage);
+  return getFrameLayoutRGB(std::get<rgb::PixelFormatRGB>(format), frameSize, errorMessage);
+}
+
+// The values of all components of a chunk of rows. Every component is stored contiguously in its
+// own (possibly subsampled) resolution.
+struct ComponentRows
+{
+  std::array<std::vector<uint16_t>, NrComponents> values;
+  std::array<unsigned, NrComponents>              width{};
+  std::array<unsigned, NrComponents>              height{};
+};
+
+ComponentRows allocateComponentRows(const FrameLayout &layout,
+                                    const unsigned     frameWidth,
+                                    const unsigned     nrRows)
+{
+  ComponentRows rows;
+  for (int c = 0; c < NrComponents; c++)
+  {
+    if (!hasComponent(layout, c))
+      continue;
+    rows.width[c]  = isChromaComponent(c) ? frameWidth / layout.subsamplingHor : frameWidth;
+    rows.height[c] = isChromaComponent(c) ? nrRows / layout.subsamplingVer : nrRows;
+    rows.values[c].resize(std::size_t(rows.width[c]) * rows.height[c]);
+  }
+  return rows;
+}
+
+template <unsigned BytesPerSample, bool BigEndian> inline uint16_t readSample(const uint8_t *src)
+{
+  if constexpr (BytesPerSample == 1)
+    return src[0];
+  else if constexpr (BigEndian)
+    return uint16_t((src[0] << 8) | src[1]);
+  else
+    return uint16_t(src[0] | (src[1] << 8));
+}
+
+template <unsigned BytesPerSample, bool BigEndian>
+inline void writeSample(uint8_t *dst, const uint16_t value)
+{
+  if constexpr (BytesPerSample == 1)
+    dst[0] = uint8_t(value);
+  else if constexpr (BigEndian)
+  {
+    dst[0] = uint8_t(value >> 8);
+    dst[1] = uint8_t(value);
+  }
+  else
+  {
+    dst[0] = uint8_t(value);
+    dst[1] = uint8_t(value >> 8);
+  }
+}
+
+// These loops have no dependencies between the iterations and the compiler can vectorize them for
+// every combination of sample size, endianness and step.
+template <unsigned BytesPerSample, bool BigEndian>
+void readSamplesTemplate(const uint8_t *restrict src,
+                         const std::size_t       srcStep,
+                         uint16_t *restrict      dst,
+                         const std::size_t       dstStep,
+                         const std::size_t       count)
+{
+  for (std::size_t i = 0; i < count; i++)
+    dst[i * dstStep] = readSample<BytesPerSample, BigEndian>(src + i * srcStep * BytesPerSample);
+}
+
+template <unsigned BytesPerSample, bool BigEndian>
+void writeSamplesTemplate(const uint16_t *restrict src,
+                          const std::size_t        srcStep,
+                          uint8_t *restrict        dst,
+                          const std::size_t        dstStep,
+                          const std::size_t        count)
+{
+  for (std::size_t i = 0; i < count; i++)
+    writeSample<BytesPerSample, BigEndian>(dst + i * dstStep * BytesPerSample, src[i * srcStep]);
+}
+
+// Read count samples from src (every srcStep samples) to dst (every dstStep values).
+void readSamples(const FrameLayout &layout,
+                 const uint8_t     *src,
+                 const std::size_t  srcStep,
+                 uint16_t          *dst,
+                 const std::size_t  dstStep,
+                 const std::size_t  count)
+{
+  if (layout.bytesPerSample == 1)
+    readSamplesTemplate<1, false>(src, srcStep, dst, dstStep, count);
+  else if (layout.bigEndian)
+    readSamplesTemplate<2, true>(src, srcStep, dst, dstStep, count);
+  else
+    readSamplesTemplate<2, false>(src, srcStep, dst, dstStep, count);
+}
+
+void writeSamples(const FrameLayout &layout,
+                  const uint16_t    *src,
+                  const std::size_t  srcStep,
+                  uint8_t           *dst,
+                  const std::size_t  dstStep,
+                  const std::size_t  count)
+{
+  if (layout.bytesPerSample == 1)
+    writeSamplesTemplate<1, false>(src, srcStep, dst, dstStep, count);
+  else if (layout.bigEndian)
+    writeSamplesTemplate<2, true>(src, srcStep, dst, dstStep, count);
+  else
+    writeSamplesTemplate<2, false>(src, srcStep, dst, dstStep, count);
+}
+
+const uint8_t *planeData(const std::vector<QByteArray> &planes, const std::size_t i)
+{
+  return reinterpret_cast<const uint8_t *>(planes[i].constData());
+}
+
+uint8_t *planeData(std::vector<QByteArray> &planes, const std::size_t i)
+{
+  return reinterpret_cast<uint8_t *>(planes[i].data());
+}
+
+// The sample positions of the 12 values in the 4 32 bit words of a V210 group.
+// Every entry is {component, index within the group}.
+constexpr std::array<std::pair<int, unsigned>, 12> V210SampleOrder = {
+    std::make_pair(1, 0u),
+    std::make_pair(0, 0u),
+    std::make_pair(2, 0u),
+    std::make_pair(0, 1u),
+    std::make_pair(1, 1u),
+    std::make_pair(0, 2u),
+    std::make_pair(2, 1u),
+    std::make_pair(0, 3u),
+    std::make_pair(1, 2u),
+    std::make_pair(0, 4u),
+    std::make_pair(2, 2u),
+    std::make_pair(0, 5u)};
+
+ComponentRows unpackRows(const FrameLayout             &layout,
+                         const std::vector<QByteArray> &planes,
+                         const unsigned                 frameWidth,
+                         const unsigned                 nrRows)
+{
+  auto rows = allocateComponentRows(layout, frameWidth, nrRows);
+
+  switch (layout.type)
+  {
+  case LayoutType::Planar:
+    for (int c = 0; c < NrComponents; c++)
+      if (hasComponent(layout, c))
+        readSamples(layout,
+                    planeData(planes, layout.positions[c]),
+                    1,
+                    rows.values[c].data(),
+                    1,
+                    rows.values[c].size());
+    break;
+
+  case LayoutType::SemiPlanar:
+    readSamples(layout, planeData(planes, 0), 1, rows.values[0].data(), 1, rows.values[0].size());
+    for (int c = 1; c <= 2 && layout.hasChroma; c++)
+      readSamples(layout,
+                  planeData(planes, 1) + layout.positions[c] * layout.bytesPerSample,
+                  2,
+                  rows.values[c].data(),
+                  1,
+                  rows.values[c].size());
+    break;
+
+  case LayoutType::PackedPixel:
+    for (int c = 0; c < NrComponents; c++)
+      if (hasComponent(layout, c))
+        readSamples(layout,
+                    planeData(planes, 0) + layout.positions[c] * layout.bytesPerSample,
+                    layout.samplesPerGroup,
+                    rows.values[c].data(),
+                    1,
+                    rows.values[c].size());
+    break;
+
+  case LayoutType::Packed422:
+  {
+    const auto src       = planeData(planes, 0);
+    const auto bps       = layout.bytesPerSample;
+    const auto nrGroups  = rows.values[1].size();
+    const auto lumaFirst = src + layout.positions[0] * bps;
+    readSamples(layout, lumaFirst, 4, rows.values[0].data(), 2, nrGroups);
+    readSamples(layout, lumaFirst + 2 * bps, 4, rows.values[0].data() + 1, 2, nrGroups);
+    readSamples(layout, src + layout.positions[1] * bps, 4, rows.values[1].data(), 1, nrGroups);
+    readSamples(layout, src + layout.positions[2] * bps, 4, rows.values[2].data(), 1, nrGroups);
+    break;
+  }
+
+  case LayoutType::BytePacked422:
+  {
+    const uint8_t *restrict src = planeData(planes, 0);
+    uint16_t *restrict      Y   = rows.values[0].data();
+    uint16_t *restrict      U   = rows.values[1].data();
+    uint16_t *restrict      V   = rows.values[2].data();
+    for (std::size_t i = 0; i < rows.values[1].size(); i++)
+    {
+      const uint16_t values[4] = {uint16_t((src[0] << 2) | (src[1] >> 6)),
+                                  uint16_t(((src[1] & 0x3f) << 4) | (src[2] >> 4)),
+                                  uint16_t(((src[2] & 0x0f) << 6) | (src[3] >> 2)),
+                                  uint16_t(((src[3] & 0x03) << 8) | src[4])};
+      Y[2 * i]                 = values[layout.positions[0]];
+      Y[2 * i + 1]             = values[layout.positions[0] + 2];
+      U[i]                     = values[layout.positions[1]];
+      V[i]                     = values[layout.positions[2]];
+      src += 5;
+    }
+    break;
+  }
+
+  case LayoutType::V210:
+  {
+    const auto stride      = layout.planes[0].rowStride;
+    const auto chromaWidth = frameWidth / 2;
+    for (unsigned y = 0; y < nrRows; y++)
+    {
+      auto src = planeData(planes, 0) + y * stride;
+      for (unsigned group = 0; group * 6 < frameWidth; group++)
+      {
+        for (unsigned i = 0; i < 12; i++)
+        {
+          const auto word  = uint32_t(src[i / 3 * 4]) | (uint32_t(src[i / 3 * 4 + 1]) << 8) |
+                            (uint32_t(src[i / 3 * 4 + 2]) << 16) |
+                            (uint32_t(src[i / 3 * 4 + 3]) << 24);
+          const auto value = uint16_t((word >> (10 * (i % 3))) & 0x3ff);
+
+          const auto [component, index] = V210SampleOrder[i];
+          const auto x                  = group * (component == 0 ? 6 : 3) + index;
+          const auto width              = (component == 0) ? frameWidth : chromaWidth;
+          if (x < width)
+            rows.values[component][y * width + x] = value;
+        }
+        src += 16;
+      }
+    }
+    break;
+  }
+  }
+
+  return rows;
+}
+
+std::vector<QByteArray> packRows(const FrameLayout   &layout,
+                                 const ComponentRows &rows,
+                                 const unsigned       frameWidth,
+                                 const unsigned       nrRows)
+{
+  std::vector<QByteArray> planes;
+  for (const auto &plane : layout.planes)
+    planes.push_back(
+        QByteArray(int(nrRows / plane.verticalSubsampling * plane.rowStride), char(0)));
+
+  switch (layout.type)
+  {
+  case LayoutType::Planar:
+    for (int c = 0; c < NrComponents; c++)
+      if (hasComponent(layout, c))
+        writeSamples(layout,
+                     rows.values[c].data(),
+                     1,
+                     planeData(planes, layout.positions[c]),
+                     1,
+                     rows.values[c].size());
+    break;
+
+  case LayoutType::SemiPlanar:
+    writeSamples(layout, rows.values[0].data(), 1, planeData(planes, 0), 1, rows.values[0].size());
+    for (int c = 1; c <= 2 && layout.hasChroma; c++)
+      writeSamples(layout,
+                   rows.values[c].data(),
+                   1,
+                   planeData(planes, 1) + layout.positions[c] * layout.bytesPerSample,
+                   2,
+                   rows.values[c].size());
+    break;
+
+  case LayoutType::PackedPixel:
+    for (int c = 0; c < NrComponents; c++)
+      if (hasComponent(layout, c))
+        writeSamples(layout,
+                     rows.values[c].data(),
+                     1,
+                     planeData(planes, 0) + layout.positions[c] * layout.bytesPerSample,
+                     layout.samplesPerGroup,
+                     rows.values[c].size());
+    break;
+
+  case LayoutType::Packed422:
+  {
+    const auto dst       = planeData(planes, 0);
+    const auto bps       = layout.bytesPerSample;
+    const auto nrGroups  = rows.values[1].size();
+    const auto lumaFirst = dst + layout.positions[0] * bps;
+    writeSamples(layout, rows.values[0].data(), 2, lumaFirst, 4, nrGroups);
+    writeSamples(layout, rows.values[0].data() + 1, 2, lumaFirst + 2 * bps, 4, nrGroups);
+    writeSamples(layout, rows.values[1].data(), 1, dst + layout.positions[1] * bps, 4, nrGroups);
+    writeSamples(layout, rows.values[2].data(), 1, dst + layout.positions[2] * bps, 4, nrGroups);
+    break;
+  }
+
+  case LayoutType::BytePacked422:
+  {
+    uint8_t *restrict        dst = planeData(planes, 0);
+    const uint16_t *restrict Y   = rows.values[0].data();
+    const uint16_t *restrict U   = rows.values[1].data();
+    const uint16_t *restrict V   = rows.values[2].data();
+    for (std::size_t i = 0; i < rows.values[1].size(); i++)
+    {
+      uint16_t values[4];
+      values[layout.positions[0]]     = Y[2 * i];
+      values[layout.positions[0] + 2] = Y[2 * i + 1];
+      values[layout.positions[1]]     = U[i];
+      values[layout.positions[2]]     = V[i];
+
+      dst[0] = uint8_t(values[0] >> 2);
+      dst[1] = uint8_t(((values[0] & 0x03) << 6) | (values[1] >> 4));
+      dst[2] = uint8_t(((values[1] & 0x0f) << 4) | (values[2] >> 6));
+      dst[3] = uint8_t(((values[2] & 0x3f) << 2) | (values[3] >> 8));
+      dst[4] = uint8_t(values[3]);
+      dst += 5;
+    }
+    break;
+  }
+
+  case LayoutType::V210:
+  {
+    const auto stride      = layout.planes[0].rowStride;
+    const auto chromaWidth = frameWidth / 2;
+    for (unsigned y = 0; y < nrRows; y++)
+    {
+      auto dst = planeData(planes, 0) + y * stride;
+      for (unsigned group = 0; group * 6 < frameWidth; group++)
+      {
+        uint32_t words[4] = {0, 0, 0, 0};
+        for (unsigned i = 0; i < 12; i++)
+        {
+          const auto [component, index] = V210SampleOrder[i];
+          const auto x                  = group * (component == 0 ? 6 : 3) + index;
+          const auto width              = (component == 0) ? frameWidth : chromaWidth;
+          if (x < width)
+            words[i / 3] |= uint32_t(rows.values[component][y * width + x] & 0x3ff)
+                            << (10 * (i % 3));
+        }
+        for (const auto word : words)
+        {
+          *dst++ = uint8_t(word);
+          *dst++ = uint8_t(word >> 8);
+          *dst++ = uint8_t(word >> 16);
+          *dst++ = uint8_t(word >> 24);
+        }
+      }
+    }
+    break;
+  }
+  }
+
+  return planes;
+}
+
+void convertBitDepth(std::vector<uint16_t> &values,
+                     const unsigned         sourceBitDepth,
+                     const unsigned         targetBitDepth)
+{
+  uint16_t *restrict data  = values.data();
+  const auto         count = values.size();
+  if (targetBitDepth > sourceBitDepth)
+  {
+    const auto shift = targetBitDepth - sourceBitDepth;
+    for (std::size_t i = 0; i < count; i++)
+      data[i] = uint16_t(data[i] << shift);
+  }
+  else if (targetBitDepth < sourceBitDepth)
+  {
+    const auto shift    = sourceBitDepth - targetBitDepth;
+    const auto rounding = 1u << (shift - 1);
+    const auto maxValue = (1u << targetBitDepth) - 1;
+    for (std::size_t i = 0; i < count; i++)
+      data[i] = uint16_t(std::min((data[i] + rounding) >> shift, maxValue));
+  }
+}
+
+// Resample a chroma component to another subsampling. Every target sample is the average of all
+// source samples that cover the same luma area. For upsampling, this repeats the source samples.
+std::vector<uint16_t> resampleComponent(std::vector<uint16_t> &&source,
+                                        const unsigned          sourceWidth,
+                                        const unsigned          sourceHeight,
+                                        const unsigned          targetWidth,
+                                        const unsigned          targetHeight)
+{
+  if (sourceWidth == targetWidth && sourceHeight == targetHeight)
+    return std::move(source);
+
+  // The size of the luma area that one sample covers (in units of the smallest common grid)
+  const auto fullWidth  = std::max(sourceWidth, targetWidth);
+  const auto fullHeight = std::max(sourceHeight, targetHeight);
+  const auto sourceH    = fullWidth / sourceWidth;
+  const auto sourceV    = fullHeight / sourceHeight;
+  const auto targetH    = fullWidth / targetWidth;
+  const auto targetV    = fullHeight / targetHeight;
+
+  std::vector<uint16_t> target(std::size_t(targetWidth) * targetHeight);
+  for (unsigned y = 0; y < targetHeight; y++)
+  {
+    const auto y0 = y * targetV / sourceV;
+    const auto y1 = ((y + 1) * targetV - 1) / sourceV;
+    for (unsigned x = 0; x < targetWidth; x++)
+    {
+      const auto x0    = x * targetH / sourceH;
+      const auto x1    = ((x + 1) * targetH - 1) / sourceH;
+      unsigned   sum   = 0;
+      unsigned   count = 0;
+      for (auto sy = y0; sy <= y1; sy++)
+        for (auto sx = x0; sx <= x1; sx++)
+        {
+          sum += source[sy * sourceWidth + sx];
+          count++;
+        }
+      target[y * targetWidth + x] = uint16_t((sum + count / 2) / count);
+    }
+  }
+  return target;
+}
+
+ComponentRows convertComponentRows(ComponentRows     &&source,
+                                   const FrameLayout &sourceLayout,
+                                   const FrameLayout &targetLayout,
+                                   const unsigned     frameWidth,
+                                   const unsigned     nrRows)
+{
+  auto target = allocateComponentRows(targetLayout, frameWidth, nrRows);
+
+  for (int c = 0; c < NrComponents; c++)
+  {
+    if (!hasComponent(targetLayout, c))
+      continue;
+
+    if (!hasComponent(sourceLayout, c))
+    {
+      // Chroma is set to the neutral value and alpha is set to opaque
+      const auto value = (c == ComponentAlpha) ? (1u << targetLayout.bitDepth) - 1
+                                               : 1u << (targetLayout.bitDepth - 1);
+      std::fill(target.values[c].begin(), target.values[c].end(), uint16_t(value));
+      continue;
+    }
+
+    target.values[c] = resampleComponent(std::move(source.values[c]),
+                                         source.width[c],
+                                         source.height[c],
+                                         target.width[c],
+                                         target.height[c]);
+    convertBitDepth(target.values[c], sourceLayout.bitDepth, targetLayout.bitDepth);
+  }
+
+  return target;
+}
+
+bool areFormatsIdentical(const RawPixelFormat &format1, const RawPixelFormat &format2)
+{
+  if (format1.index() != format2.index())
+    return false;
+  if (const auto formatYUV = std::get_if<PixelFormatYUV>(&format1))
+    return *formatYUV == std::get<PixelFormatYUV>(format2);
+  return std::get<rgb::PixelFormatRGB>(format1) == std::get<rgb::PixelFormatRGB>(format2);
+}
+
+} // namespace
+
+PixelFormatConverter::PixelFormatConverter(const RawPixelFormat &sourceFormat,
+                                           const RawPixelFormat &targetFormat,
+                                           const Size            frameSize,
+                                           const unsigned        rowsPerChunk)
+    : sourceFormat(sourceFormat), targetFormat(targetFormat), frameSize(frameSize)
+{
+  // The chunks must contain complete rows of all subsampled components. All vertical subsamplings
+  // are divisors of 4.
+  this->rowsPerChunk = std::max((rowsPerChunk + 3) / 4 * 4, 4u);
+
+  if (sourceFormat.index() != targetFormat.index())
+  {
+    this->errorMessage = "Conversion between YUV and RGB formats is not supported.";
+    return;
+  }
+  if (!frameSize.isValid())
+  {
+    this->errorMessage = "Invalid frame size.";
+    return;
+  }
+
+  auto isFormatValid = [](const RawPixelFormat &format) {
+    return std::visit([](const auto &f) { return f.isValid(); }, format);
+  };
+  if (!isFormatValid(sourceFormat) || !isFormatValid(targetFormat))
+  {
+    this->errorMessage = "Invalid source or target pixel format.";
+    return;
+  }
+
+  for (const auto &format : {sourceFormat, targetFormat})
+  {
+    const auto layout = getFrameLayout(format, frameSize, this->errorMessage);
+    if (!layout)
+      return;
+    if (frameSize.width % layout->subsamplingHor != 0 ||
+        frameSize.height % layout->subsamplingVer != 0)
+    {
+      this->errorMessage = "The frame size must be divisible by the chroma subsampling.";
+      return;
+    }
+  }
+
+  auto getBytesPerFrame = [frameSize](const RawPixelFormat &format) {
+    return std::visit([frameSize](const auto &f) { return int64_t(f.bytesPerFrame(frameSize)); },
+                      format);
+  };
+  this->sourceBytesPerFrame = getBytesPerFrame(sourceFormat);
+  this->targetBytesPerFrame = getBytesPerFrame(targetFormat);
+}
+
+bool PixelFormatConverter::convertFrame(const ReadFunction  &readBytes,
+                                        const WriteFunction &writeBytes) const
+{
+  if (!this->isValid())
+    return false;
+
+  const auto w = this->frameSize.width;
+  const auto h = this->frameSize.height;
+
+  if (areFormatsIdentical(this->sourceFormat, this->targetFormat))
+  {
+    const auto chunkSize = std::max(this->sourceBytesPerFrame / h * this->rowsPerChunk, int64_t(1));
+    for (int64_t position = 0; position < this->sourceBytesPerFrame; position += chunkSize)
+    {
+      const auto nrBytes = std::min(chunkSize, this->sourceBytesPerFrame - position);
+      const auto data    = readBytes(position, nrBytes);
+      if (data.size() != nrBytes || !writeBytes(position, data))
+        return false;
+    }
+    return true;
+  }
+
+  QString    unusedError;
+  const auto sourceLayout = *getFrameLayout(this->sourceFormat, this->frameSize, unusedError);
+  const auto targetLayout = *getFrameLayout(this->targetFormat, this->frameSize, unusedError);
+
+  for (unsigned y = 0; y < h; y += this->rowsPerChunk)
+  {
+    const auto nrRows = std::min(this->rowsPerChunk, h - y);
+
+    std::vector<QByteArray> sourcePlanes;
+    for (const auto &plane : sourceLayout.planes)
+    {
+      const auto subV    = plane.verticalSubsampling;
+      const auto nrBytes = nrRows / subV * plane.rowStride;
+      sourcePlanes.push_back(readBytes(plane.offset + y / subV * plane.rowStride, nrBytes));
+      if (sourcePlanes.back().size() != nrBytes)
+        return false;
+    }
+
+    auto sourceRows = unpackRows(sourceLayout, sourcePlanes, w, nrRows);
+    auto targetRows =
+        convertComponentRows(std::move(sourceRows), sourceLayout, targetLayout, w, nrRows);
+    const auto targetPlanes = packRows(targetLayout, targetRows, w, nrRows);
+
+    for (std::size_t i = 0; i < targetLayout.planes.size(); i++)
+    {
+      const auto &plane = targetLayout.planes[i];
+      if (!writeBytes(plane.offset + y / plane.verticalSubsampling * plane.rowStride,
+                      targetPlanes[i]))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+QByteArray PixelFormatConverter::convertFrame(const QByteArray &source) const
+{
+  if (!this->isValid() || source.size() < this->sourceBytesPerFrame)
+    return {};
+
+  QByteArray target(int(this->targetBytesPerFrame), char(0));
+  const auto success = this->convertFrame(
+      [&source](int64_t position, int64_t nrBytes) {
+        return source.mid(int(position), int(nrBytes));
+      },
+      [&target](int64_t position, const QByteArray &data) {
+        if (position + data.size() > target.size())
+          return false;
+        std::copy(data.constData(), data.constData() + data.size(), target.data() + position);
+        return true;
+      });
+
+  if (!success)
+    return {};
+  return target;
+}
+
+bool PixelFormatConverter::convertFile(const QString          &sourceFile,
+                                       const QString          &targetFile,
+                                       const ProgressFunction &progress,
+                                       QString                *errorMessage) const
+{
+  auto setError = [errorMessage](const QString &message) {
+    if (errorMessage)
+      *errorMessage = message;
+    return false;
+  };
+
+  if (!this->isValid())
+    return setError(this->errorMessage);
+
+  QFile source(sourceFile);
+  if (!source.open(QIODevice::ReadOnly))
+    return setError("Error opening the source file " + sourceFile);
+  QFile target(targetFile);
+  if (!target.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return setError("Error opening the target file " + targetFile);
+
+  const auto nrFrames = source.size() / this->sourceBytesPerFrame;
+  for (int64_t frame = 0; frame < nrFrames; frame++)
+  {
+    const auto sourceFrameStart = frame * this->sourceBytesPerFrame;
+    const auto targetFrameStart = frame * this->targetBytesPerFrame;
+
+    const auto success = this->convertFrame(
+        [&source, sourceFrameStart](int64_t position, int64_t nrBytes) {
+          if (!source.seek(sourceFrameStart + position))
+            return QByteArray();
+          return source.read(nrBytes);
+        },
+        [&target, targetFrameStart](int64_t position, const QByteArray &data) {
+          return target.seek(targetFrameStart + position) && target.write(data) == data.size();
+        });
+    if (!success)
+      return setError(QString("Error converting frame %1").arg(frame));
+
+    if (progress)
+      progress(frame + 1, nrFrames);
+  }
+
+  return true;
+}
+
+} // namespace video
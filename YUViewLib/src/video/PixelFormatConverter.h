@@ -0,0 +1,104 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <video/rgb/PixelFormatRGB.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include <functional>
+#include <variant>
+
+namespace video
+{
+
+using RawPixelFormat = std::variant<yuv::PixelFormatYUV, rgb::PixelFormatRGB>;
+
+/* Convert raw frames from one pixel format to another without going through RGB images.
+ * YUV formats can be converted to any other YUV format (planar, semi-planar, packed, byte packed
+ * 4:2:2 10 bit and V210 with any bit depth and endianness). The chroma components are
+ * downsampled by averaging and upsampled by repetition. RGB formats can be converted to any other
+ * RGB format (channel order, alpha, bit depth, endianness, planar or packed). A conversion between
+ * YUV and RGB is not done here (see convertARGBToYUV and the YUV to RGB conversion of the
+ * videoHandlerYUV).
+ * A frame is processed in chunks of rows. Only the source and target data of one chunk is kept in
+ * memory, so even huge frames or files are converted with constant memory. All conversion
+ * functions are const and can be used from multiple threads at the same time.
+ */
+class PixelFormatConverter
+{
+public:
+  using ReadFunction     = std::function<QByteArray(int64_t position, int64_t nrBytes)>;
+  using WriteFunction    = std::function<bool(int64_t position, const QByteArray &data)>;
+  using ProgressFunction = std::function<void(int64_t nrFramesDone, int64_t nrFramesTotal)>;
+
+  PixelFormatConverter(const RawPixelFormat &sourceFormat,
+                       const RawPixelFormat &targetFormat,
+                       const Size            frameSize,
+                       const unsigned        rowsPerChunk = 16);
+
+  // Is the conversion possible? If not, the error message tells why.
+  bool    isValid() const { return this->errorMessage.isEmpty(); }
+  QString getErrorMessage() const { return this->errorMessage; }
+
+  int64_t getSourceBytesPerFrame() const { return this->sourceBytesPerFrame; }
+  int64_t getTargetBytesPerFrame() const { return this->targetBytesPerFrame; }
+
+  // Convert one frame. The source is read with readBytes and the target is written with
+  // writeBytes. The positions are relative to the start of the frame.
+  bool convertFrame(const ReadFunction &readBytes, const WriteFunction &writeBytes) const;
+  // Convert one frame in memory. Returns an empty array on failure.
+  QByteArray convertFrame(const QByteArray &source) const;
+
+  // Convert all frames of the source file and write them to the target file. Incomplete frames at
+  // the end of the source file are ignored.
+  bool convertFile(const QString          &sourceFile,
+                   const QString          &targetFile,
+                   const ProgressFunction &progress     = {},
+                   QString                *errorMessage = nullptr) const;
+
+private:
+  RawPixelFormat sourceFormat;
+  RawPixelFormat targetFormat;
+  Size           frameSize;
+  unsigned       rowsPerChunk{16};
+
+  int64_t sourceBytesPerFrame{};
+  int64_t targetBytesPerFrame{};
+  QString errorMessage;
+};
+
+} // namespace video
@@ -0,0 +1,148 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderAheadQueue.h"
+
+#include <video/ImagePool.h>
+
+#include <algorithm>
+
+namespace video
+{
+
+RenderAheadQueue::RenderAheadQueue(unsigned capacity)
+{
+  this->setCapacity(capacity);
+}
+
+void RenderAheadQueue::setCapacity(unsigned capacity)
+{
+  QMutexLocker lock(&this->accessMutex);
+  this->capacity = std::clamp(capacity, 1u, MAX_CAPACITY);
+  while (this->frames.size() > this->capacity)
+    this->dropFrontFrame();
+}
+
+unsigned RenderAheadQueue::getCapacity() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return this->capacity;
+}
+
+void RenderAheadQueue::push(int frameIndex, const QImage &image)
+{
+  QMutexLocker lock(&this->accessMutex);
+
+  auto it = std::find_if(this->frames.begin(), this->frames.end(), [frameIndex](const Frame &f) {
+    return f.frameIndex == frameIndex;
+  });
+  if (it != this->frames.end())
+  {
+    ImagePool::instance().replace(it->image, image);
+    return;
+  }
+
+  if (this->frames.size() >= this->capacity)
+    this->dropFrontFrame();
+  this->frames.push_back({frameIndex, image});
+}
+
+bool RenderAheadQueue::contains(int frameIndex) const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return std::any_of(this->frames.begin(), this->frames.end(), [frameIndex](const Frame &f) {
+    return f.frameIndex == frameIndex;
+  });
+}
+
+std::optional<QImage> RenderAheadQueue::take(int frameIndex)
+{
+  QMutexLocker lock(&this->accessMutex);
+
+  auto it = std::find_if(this->frames.begin(), this->frames.end(), [frameIndex](const Frame &f) {
+    return f.frameIndex == frameIndex;
+  });
+  if (it == this->frames.end())
+    return {};
+
+  auto       image           = std::move(it->image);
+  const auto nrSkippedFrames = std::distance(this->frames.begin(), it);
+  for (auto i = 0; i < nrSkippedFrames; i++)
+    this->dropFrontFrame();
+  this->frames.pop_front();
+  return image;
+}
+
+void RenderAheadQueue::clear()
+{
+  QMutexLocker lock(&this->accessMutex);
+  while (!this->frames.empty())
+    this->dropFrontFrame();
+}
+
+void RenderAheadQueue::removeFramesFrom(int frameIndex)
+{
+  QMutexLocker lock(&this->accessMutex);
+  for (auto it = this->frames.begin(); it != this->frames.end();)
+  {
+    if (it->frameIndex >= frameIndex)
+    {
+      ImagePool::instance().release(it->image);
+      it = this->frames.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
+int RenderAheadQueue::getNumberQueuedFrames() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  return static_cast<int>(this->frames.size());
+}
+
+int64_t RenderAheadQueue::getUsedBytes() const
+{
+  QMutexLocker lock(&this->accessMutex);
+  int64_t      bytes = 0;
+  for (const auto &frame : this->frames)
+    bytes += int64_t(frame.image.bytesPerLine()) * frame.image.height();
+  return bytes;
+}
+
+void RenderAheadQueue::dropFrontFrame()
+{
+  ImagePool::instance().release(this->frames.front().image);
+  this->frames.pop_front();
+}
+
+} // namespace video
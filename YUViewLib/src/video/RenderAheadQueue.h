@@ -0,0 +1,98 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/MemoryAccountant.h>
+
+#include <QImage>
+#include <QMutex>
+
+#include <deque>
+#include <optional>
+
+namespace video
+{
+
+/* The frames that playback will show next. While playing, the interactive loading thread renders
+ * up to capacity frames ahead of the frame on screen and the playback clock takes them out in
+ * order. A frame that takes longer than one frame interval to load (e.g. an intra frame of an
+ * expensive stream) only stalls playback once the frames that were rendered ahead are used up.
+ * The frames in the queue are kept in the order in which they were pushed. Taking a frame also
+ * drops all frames that were pushed before it (they were skipped). All functions are thread-safe.
+ */
+class RenderAheadQueue
+{
+public:
+  static constexpr unsigned DEFAULT_CAPACITY = 4;
+  static constexpr unsigned MAX_CAPACITY     = 32;
+
+  RenderAheadQueue(unsigned capacity = DEFAULT_CAPACITY);
+
+  // Set the number of frames in the queue (1 to MAX_CAPACITY). Drop the oldest frames if there are
+  // more frames in the queue.
+  void     setCapacity(unsigned capacity);
+  unsigned getCapacity() const;
+
+  // Add a frame at the end of the queue. If the frame is already queued, only the image is
+  // replaced. If the queue is full, the oldest frame is dropped.
+  void push(int frameIndex, const QImage &image);
+  bool contains(int frameIndex) const;
+
+  // Take the frame out of the queue. All frames that were pushed before it are dropped.
+  std::optional<QImage> take(int frameIndex);
+
+  void clear();
+  // Drop all frames with an index of at least the given index
+  void removeFramesFrom(int frameIndex);
+
+  int     getNumberQueuedFrames() const;
+  int64_t getUsedBytes() const;
+
+private:
+  struct Frame
+  {
+    int    frameIndex{};
+    QImage image;
+  };
+
+  void dropFrontFrame();
+
+  mutable QMutex    accessMutex;
+  std::deque<Frame> frames;
+  unsigned          capacity{DEFAULT_CAPACITY};
+
+  MemoryAccountant::Registration memoryRegistration{MemoryAccountant::instance().registerConsumer(
+      "Render-ahead queue", [this] { return this->getUsedBytes(); })};
+};
+
+} // namespace video
@@ -0,0 +1,87 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SampledRawData.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace video
+{
+
+namespace
+{
+
+// Ranges that are closer together than this are read at once
+constexpr int64_t MERGE_READ_GAP = 4096;
+
+} // namespace
+
+SampledRawData::SampledRawData(const ReadBytesFunction &readBytes, std::vector<ByteRange> ranges)
+{
+  std::sort(ranges.begin(), ranges.end(), [](const ByteRange &a, const ByteRange &b) {
+    return a.start < b.start;
+  });
+
+  std::optional<ByteRange> merged;
+  for (const auto &range : ranges)
+  {
+    if (merged && range.start <= merged->start + merged->size + MERGE_READ_GAP)
+    {
+      const auto end = std::max(merged->start + merged->size, range.start + range.size);
+      merged->size   = end - merged->start;
+      continue;
+    }
+    if (merged)
+      this->blocks.push_back({merged->start, readBytes(merged->start, merged->size)});
+    merged = range;
+  }
+  if (merged)
+    this->blocks.push_back({merged->start, readBytes(merged->start, merged->size)});
+}
+
+const unsigned char *SampledRawData::getData(const ByteRange &range) const
+{
+  auto it = std::upper_bound(
+      this->blocks.begin(), this->blocks.end(), range.start, [](int64_t pos, const Block &block) {
+        return pos < block.start;
+      });
+  if (it == this->blocks.begin())
+    return nullptr;
+  it--;
+  const auto offset = range.start - it->start;
+  if (offset + range.size > it->data.size())
+    return nullptr;
+  return reinterpret_cast<const unsigned char *>(it->data.constData()) + offset;
+}
+
+} // namespace video
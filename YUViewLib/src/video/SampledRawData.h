@@ -0,0 +1,81 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <QByteArray>
+
+namespace video
+{
+
+// Read nrBytes starting at the given position of the raw data. At the end of the data, fewer bytes
+// are returned.
+using ReadBytesFunction = std::function<QByteArray(int64_t position, int64_t nrBytes)>;
+
+struct ByteRange
+{
+  int64_t start{};
+  int64_t size{};
+};
+
+// A sample with 1 byte or 2 bytes (little endian)
+inline int getSample(const unsigned char *data, const int bytesPerSample, const int64_t index)
+{
+  if (bytesPerSample == 1)
+    return data[index];
+  return data[index * 2] | (data[index * 2 + 1] << 8);
+}
+
+// Reads the given ranges once (merging ranges that are close together) and keeps them in memory.
+// This is used by the format detection which compares a few rows of the first frames for many
+// candidate formats.
+class SampledRawData
+{
+public:
+  SampledRawData(const ReadBytesFunction &readBytes, std::vector<ByteRange> ranges);
+
+  // Return a pointer to the data of the range or nullptr if the data could not be read
+  const unsigned char *getData(const ByteRange &range) const;
+
+private:
+  struct Block
+  {
+    int64_t    start{};
+    QByteArray data;
+  };
+  std::vector<Block> blocks;
+};
+
+} // namespace video
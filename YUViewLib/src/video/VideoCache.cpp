@@ -38,10 +38,12 @@
 #include <QSettings>
 #include <QThread>
 #include <algorithm>
+#include <map>
 
 #include <common/Functions.h>
 #include <playlistitem/playlistItem.h>
 #include <ui/PlaybackController.h>
+#include <video/ImagePool.h>
 
 namespace video
 {
@@ -65,6 +67,16 @@ namespace video
 #define DEBUG_CACHING_DETAIL(fmt, ...) ((void)0)
 #endif
 
+namespace
+{
+
+constexpr auto VIDEO_CACHE_MEMORY_CATEGORY = "Video cache";
+// If the system runs low on memory, leave this much for the rest of the system
+constexpr int64_t SYSTEM_MEMORY_RESERVE_BYTES = 256 * 1000 * 1000;
+constexpr int     CACHE_BUDGET_UPDATE_INTERVAL_MS = 1000;
+
+} // namespace
+
 #define CACHING_THREAD_JOBS_OUTPUT 0
 #if CACHING_THREAD_JOBS_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -243,6 +255,9 @@ VideoCache::VideoCache(PlaylistTreeWidget *playlistTreeWidget,
     interactiveItemQueued_Idx[i] = -1;
   }
 
+  this->memoryRegistration = MemoryAccountant::instance().registerConsumer(
+      VIDEO_CACHE_MEMORY_CATEGORY, [this] { return this->cacheLevelCurrent.load(); });
+
   // Update some values from the QSettings. This will also create the correct number of threads.
   updateSettings();
 
@@ -264,7 +279,27 @@ VideoCache::VideoCache(PlaylistTreeWidget *playlistTreeWidget,
           &PlaybackController::signalPlaybackStarting,
           this,
           &VideoCache::updateCacheQueue);
+  connect(playback.data(),
+          &PlaybackController::signalLoopRangeChanged,
+          this,
+          &VideoCache::scheduleCachingListUpdate);
+  connect(playback.data(),
+          &PlaybackController::signalPlayheadMoved,
+          &playheadMovedSubsampler,
+          &EventSubsampler::postEvent);
+  connect(&playheadMovedSubsampler,
+          &EventSubsampler::subsampledEvent,
+          this,
+          &VideoCache::playheadMoved);
   connect(&statusUpdateTimer, &QTimer::timeout, this, [=] { emit updateCacheStatus(); });
+  connect(&cacheBudgetTimer, &QTimer::timeout, this, [=] {
+    this->updateCacheBudget();
+    if (this->cacheLevelCurrent > this->cacheLevelMax)
+      this->scheduleCachingListUpdate();
+    if (!this->statusUpdateTimer.isActive())
+      emit updateCacheStatus();
+  });
+  this->cacheBudgetTimer.start(CACHE_BUDGET_UPDATE_INTERVAL_MS);
   connect(&testProgrssUpdateTimer, &QTimer::timeout, this, [=] { updateTestProgress(); });
 }
 
@@ -330,15 +365,18 @@ void VideoCache::updateSettings()
   // Get if caching is enabled and how much memory we can use for the cache
   QSettings settings;
   settings.beginGroup("VideoCache");
-  cachingEnabled = settings.value("Enabled", true).toBool();
-  cacheLevelMax  = (int64_t)settings.value("ThresholdValueMB", 49).toUInt() * 1000 * 1000;
+  cachingEnabled       = settings.value("Enabled", true).toBool();
+  cacheLevelMaxSetting = (int64_t)settings.value("ThresholdValueMB", 49).toUInt() * 1000 * 1000;
+  this->updateCacheBudget();
+
+  const auto evictionPolicyName = settings.value("EvictionPolicy").toString().toStdString();
+  const auto evictionPolicyType = CacheEvictionPolicyTypeMapper.getValue(evictionPolicyName)
+                                      .value_or(CacheEvictionPolicyType::PlaylistOrder);
+  this->evictionPolicy = createCacheEvictionPolicy(evictionPolicyType);
+  this->pinLoopRange   = settings.value("PinLoopRange", true).toBool();
 
   // See if the user changed the number of threads
-  int targetNrThreads = functions::getOptimalThreadCount();
-  if (settings.value("SetNrThreads", false).toBool())
-    targetNrThreads = settings.value("NrThreads", targetNrThreads).toInt();
-  if (targetNrThreads <= 0)
-    targetNrThreads = 1;
+  int targetNrThreads = functions::getCachingThreadCount();
   if (!cachingEnabled)
     targetNrThreads = 0;
 
@@ -527,6 +565,8 @@ void VideoCache::updateCacheQueue()
   cacheQueue.clear();
   cacheDeQueue.clear();
 
+  this->updateCacheBudget();
+
   // Get all items from the playlist. There are two lists. For the caching status (how full is the
   // cache) we have to consider all items in the playlist. However, we only cache top level items
   // and no child items.
@@ -593,34 +633,33 @@ void VideoCache::updateCacheQueue()
     auto cachingFrameSize = item->getCachingFrameSize();
     cacheLevel += item->getNumberCachedFrames() * cachingFrameSize;
   }
+  // The queue can also be updated while the workers are running (see playheadMoved). The frames
+  // that are being cached right now will occupy space as well.
+  for (loadingThread *t : cachingThreadList)
+    if (t->worker()->isWorking() && t->worker()->getCacheItem() != nullptr)
+      cacheLevel += t->worker()->getCacheItem()->getCachingFrameSize();
   if (cacheLevel > cacheLevelMax)
   {
-    // The cache is overflowing (maybe the user made the cache smaller).
-    // Delete items until the cache does not overflow anymore.
-    // Start with the item before the currently selected one.
-    int initialPos = (itemPos > 0) ? itemPos - 1 : allItems.count() - 1;
-    int i          = initialPos;
-    do
+    // The cache is overflowing (maybe the user made the cache smaller or the system is running low
+    // on memory). Delete frames until the cache does not overflow anymore. All frames are
+    // candidates, starting with the item before the currently selected one and going back through
+    // the list. The eviction policy decides which ones are removed first.
+    int i = (itemPos > 0) ? itemPos - 1 : allItems.count() - 1;
+    for (int n = 0; n < allItems.count(); n++)
     {
-      // Delete cached frames from this item until the cache is free enough
-      QList<int>   cachedFrames = allItems[i]->getCachedFrames();
-      unsigned int frameSize    = allItems[i]->getCachingFrameSize();
-      for (int f : cachedFrames)
-      {
-        allItems[i]->removeFrameFromCache(f);
-        cacheLevel -= frameSize;
-        if (cacheLevel < cacheLevelMax)
-          break;
-      }
+      for (int f : allItems[i]->getCachedFrames())
+        cacheDeQueue.enqueue(plItemFrame(allItems[i], f));
+      i = (i > 0) ? i - 1 : allItems.count() - 1;
+    }
+    this->orderCacheDeQueueForEviction();
 
-      // Go to the previous item
-      i--;
-      if (i < 0)
-        i = allItems.count() - 1;
-      if (i == initialPos)
-        // We scanned all items but the cache is still not empty ...
-        break;
-    } while (cacheLevel >= cacheLevelMax);
+    while (cacheLevel >= cacheLevelMax && !cacheDeQueue.isEmpty())
+    {
+      auto frameToRemove = cacheDeQueue.dequeue();
+      frameToRemove.first->removeFrameFromCache(frameToRemove.second);
+      cacheLevel -= frameToRemove.first->getCachingFrameSize();
+    }
+    cacheDeQueue.clear();
   }
   // Save the current level of the cache
   cacheLevelCurrent = cacheLevel;
@@ -659,7 +698,10 @@ void VideoCache::updateCacheQueue()
           if (newCacheLevel + itemCacheSize <= cacheLevelMax)
           {
             // All frames of the item fit and there is even more space. We remain in "adding" mode.
-            enqueueCacheJob(allItems[i], itemRange);
+            if (i == itemPos)
+              enqueuePlayheadItemCacheJobs(allItems[i], itemRange.second - itemRange.first + 1);
+            else
+              enqueueCacheJob(allItems[i], itemRange);
             newCacheLevel += itemCacheSize;
           }
           else
@@ -669,16 +711,22 @@ void VideoCache::updateCacheQueue()
             int64_t availableSpace   = cacheLevelMax - newCacheLevel;
             int64_t nrFramesCachable = availableSpace / allItems[i]->getCachingFrameSize() + 1;
 
-            // These frames should be added...
-            indexRange addFrames =
-                indexRange(itemRange.first, itemRange.first + nrFramesCachable - 1);
-            enqueueCacheJob(allItems[i], addFrames);
             newCacheLevel += nrFramesCachable * allItems[i]->getCachingFrameSize();
-            // ... and the rest should be removed (if they are cached)
-            QList<int> cachedFrames = allItems[i]->getCachedFrames();
-            for (int f : cachedFrames)
-              if (f < addFrames.first || f > addFrames.second)
-                cacheDeQueue.enqueue(plItemFrame(allItems[i], f));
+            if (i == itemPos)
+              // The frames that will be shown next should be added. The rest should be removed.
+              enqueuePlayheadItemCacheJobs(allItems[i], nrFramesCachable);
+            else
+            {
+              // These frames should be added...
+              indexRange addFrames =
+                  indexRange(itemRange.first, itemRange.first + nrFramesCachable - 1);
+              enqueueCacheJob(allItems[i], addFrames);
+              // ... and the rest should be removed (if they are cached)
+              QList<int> cachedFrames = allItems[i]->getCachedFrames();
+              for (int f : cachedFrames)
+                if (f < addFrames.first || f > addFrames.second)
+                  cacheDeQueue.enqueue(plItemFrame(allItems[i], f));
+            }
 
             // The cache is now full. We switch to "deleting" mode.
             adding = false;
@@ -723,11 +771,9 @@ void VideoCache::updateCacheQueue()
         }
       }
 
-      // Adjust the range so that only the number of frames are cached that will fit
+      // Only cache the number of frames that will fit. Start with the ones closest to the playhead.
       int64_t nrFramesCachable = cacheLevelMax / selection[0]->getCachingFrameSize();
-      range.second             = range.first + nrFramesCachable - 1;
-
-      enqueueCacheJob(selection[0], range);
+      enqueuePlayheadItemCacheJobs(selection[0], nrFramesCachable);
     }
     else if (selection[0]->isCachable() &&
              additionalItemSpaceNeeded > (cacheLevelMax - cacheLevel) &&
@@ -831,9 +877,9 @@ void VideoCache::updateCacheQueue()
         i--;
       }
 
-      // Enqueue the job. This is the only job.
+      // Enqueue the jobs for the selected item. These are the only jobs.
       // We will not delete any frames from any other items to cache frames from other items.
-      enqueueCacheJob(selection[0], range);
+      enqueuePlayheadItemCacheJobs(selection[0], range.second - range.first + 1);
     }
     else
     {
@@ -845,7 +891,7 @@ void VideoCache::updateCacheQueue()
         // items. In case of playback, we will continue with the next items and delete all frames
         // that were already played out. Otherwise, we don't delete any frames from the cache but we
         // will cache as many items as possible.
-        enqueueCacheJob(selection[0], range);
+        enqueuePlayheadItemCacheJobs(selection[0], range.second - range.first + 1);
         cacheLevel = cacheLevel + additionalItemSpaceNeeded;
       }
 
@@ -918,6 +964,8 @@ void VideoCache::updateCacheQueue()
     }
   }
 
+  this->orderCacheDeQueueForEviction();
+
 #if CACHING_DEBUG_OUTPUT && !NDEBUG
   if (!cacheQueue.isEmpty())
   {
@@ -955,15 +1003,145 @@ void VideoCache::updateCacheQueue()
 #endif
 }
 
+void VideoCache::updateCacheBudget()
+{
+  const auto otherBuffers =
+      MemoryAccountant::instance().getTotalUsageExcludingCategory(VIDEO_CACHE_MEMORY_CATEGORY);
+  auto budget = this->cacheLevelMaxSetting - otherBuffers;
+
+  if (const auto available = functions::availableMemoryInBytes())
+  {
+    // The frames that are already in the cache are part of the used memory. So the cache can only
+    // grow by what is still available.
+    const auto systemLimit = this->cacheLevelCurrent + *available - SYSTEM_MEMORY_RESERVE_BYTES;
+    budget                 = std::min(budget, systemLimit);
+  }
+
+  budget = std::max(budget, int64_t(0));
+  if (budget != this->cacheLevelMax)
+    DEBUG_CACHING_DETAIL("VideoCache::updateCacheBudget New budget %lld (setting %lld)",
+                         budget,
+                         this->cacheLevelMaxSetting);
+  this->cacheLevelMax = budget;
+}
+
+EvictionContext VideoCache::getEvictionContext() const
+{
+  EvictionContext context;
+  auto            selection = this->playlist->getSelectedItems();
+  if (selection[0])
+  {
+    context.playheadItemID     = selection[0]->properties().id;
+    context.playheadFrameIndex = this->playback->getCurrentFrame();
+  }
+  context.playingBackwards = this->playback->isPlayingBackwards();
+  if (this->pinLoopRange)
+    context.pinnedRange = this->playback->getLoopRange();
+  return context;
+}
+
+void VideoCache::orderCacheDeQueueForEviction()
+{
+  std::vector<CachedFrame>              frames;
+  std::map<int, QPointer<playlistItem>> itemsByID;
+  for (const auto &entry : this->cacheDeQueue)
+  {
+    if (!entry.first)
+      continue;
+    const auto itemID = entry.first->properties().id;
+    itemsByID[itemID] = entry.first;
+    frames.push_back({itemID, entry.second, entry.first->getCachedFrameLastAccess(entry.second)});
+  }
+
+  this->evictionPolicy->orderForEviction(frames, this->getEvictionContext());
+
+  this->cacheDeQueue.clear();
+  for (const auto &frame : frames)
+    this->cacheDeQueue.enqueue(plItemFrame(itemsByID[frame.itemID], frame.frameIndex));
+}
+
 void VideoCache::enqueueCacheJob(playlistItem *item, indexRange range)
 {
-  // Only schedule frames for caching that were not yet cached.
-  QList<int> cachedFrames = item->getCachedFrames();
-  int        i            = range.first;
-  while (cachedFrames.contains(i) && i < range.second)
-    range.first = ++i;
-  if (range.first != range.second)
-    cacheQueue.append(cacheJob(item, range));
+  // Only schedule frames for caching that were not yet cached (or are being cached right now).
+  // The range may also be descending (range.first > range.second).
+  const auto cachedFrames = item->getCachedFrames();
+  const auto isCached     = [&](int frame) {
+    return cachedFrames.contains(frame) || this->isFrameBeingCached(item, frame);
+  };
+  const auto step = (range.first <= range.second) ? 1 : -1;
+  while (range.first != range.second && isCached(range.first))
+    range.first += step;
+  if (range.first == range.second && isCached(range.first))
+    return;
+  cacheQueue.append(cacheJob(item, range));
+}
+
+void VideoCache::enqueuePlayheadItemCacheJobs(playlistItem *item, int64_t maxNrFrames)
+{
+  const auto range = item->properties().startEndRange;
+  const auto segments =
+      getFramesInExpectedAccessOrder(range, this->getPlayheadState(), maxNrFrames);
+  for (const auto &segment : segments)
+    this->enqueueCacheJob(item, segment);
+
+  // All cached frames that are not expected to be shown soon enough can be removed
+  const auto isScheduled = [&segments](int frame) {
+    return std::any_of(segments.begin(), segments.end(), [frame](const indexRange &segment) {
+      return frame >= std::min(segment.first, segment.second) &&
+             frame <= std::max(segment.first, segment.second);
+    });
+  };
+  for (auto frame : item->getCachedFrames())
+    if (!isScheduled(frame))
+      cacheDeQueue.enqueue(plItemFrame(item, frame));
+}
+
+PlayheadState VideoCache::getPlayheadState() const
+{
+  PlayheadState state;
+  state.frameIndex = this->playback->getCurrentFrame();
+  if (this->playback->playing())
+    state.step = this->playback->getPlaybackStep();
+  else
+    // While scrubbing, the frames right next to the playhead are the most likely to be shown next
+    state.step = this->playback->isPlayingBackwards() ? -1 : 1;
+  state.wrapAround =
+      (this->playback->getRepeatMode() == PlaybackController::RepeatMode::One ||
+       (this->playback->getRepeatMode() == PlaybackController::RepeatMode::All &&
+        this->playlist->getAllPlaylistItems(true).count() == 1));
+  state.loopRange = this->playback->getLoopRange();
+  return state;
+}
+
+bool VideoCache::isFrameBeingCached(playlistItem *item, int frameIndex) const
+{
+  for (loadingThread *t : cachingThreadList)
+    if (t->worker()->isWorking() && t->worker()->getCacheItem() == item &&
+        t->worker()->getCacheFrame() == frameIndex)
+      return true;
+  return false;
+}
+
+void VideoCache::playheadMoved()
+{
+  if (!this->cachingEnabled || this->testMode)
+    return;
+
+  if (workersState != workersRunning)
+  {
+    this->scheduleCachingListUpdate();
+    return;
+  }
+
+  // The workers are running. Tearing them down (workersIntReqRestart) would mean waiting for all of
+  // them to finish before anything is cached for the new playhead position. Instead, reorder the
+  // queue right away. The running jobs finish as they are and the workers then continue with the
+  // new queue. Idle workers (e.g. because the old queue ran out of jobs) are started.
+  DEBUG_CACHING("VideoCache::playheadMoved Reordering the cache queue");
+  this->updateCacheQueue();
+  for (loadingThread *t : cachingThreadList)
+    if (!t->worker()->isWorking())
+      this->pushNextJobToCachingThread(t);
 }
 
 void VideoCache::startCaching()
@@ -1312,8 +1490,9 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
       if (range.first == range.second)
         j.remove();
       else
-        // Update the frame range of the head item in the cache queue
-        job.frameRange.first = range.first + 1;
+        // Update the frame range of the head item in the cache queue. Ranges of frames that are
+        // shown during backward playback are cached in descending order.
+        job.frameRange.first = range.first + ((range.first < range.second) ? 1 : -1);
 
       break;
     }
@@ -1506,6 +1685,28 @@ QStringList VideoCache::getCacheStatusText()
   return txt;
 }
 
+QStringList VideoCache::getMemoryStatusText() const
+{
+  QStringList txt;
+  txt.append("Memory usage:");
+  for (const auto &usage : MemoryAccountant::instance().getUsagePerCategory())
+    txt.append(QString("%1: %2")
+                   .arg(QString::fromStdString(usage.category))
+                   .arg(functions::formatDataSize(double(usage.bytes))));
+  txt.append(QString("Cache budget: %1 of %2")
+                 .arg(functions::formatDataSize(double(this->cacheLevelMax)))
+                 .arg(functions::formatDataSize(double(this->cacheLevelMaxSetting))));
+  const auto imagePoolCounters = ImagePool::instance().getCounters();
+  txt.append(QString("Image pool: %1 allocations, %2 reuses, %3 images pooled")
+                 .arg(imagePoolCounters.allocations)
+                 .arg(imagePoolCounters.reuses)
+                 .arg(imagePoolCounters.nrPooledImages));
+  if (const auto available = functions::availableMemoryInBytes())
+    txt.append(
+        QString("Available system memory: %1").arg(functions::formatDataSize(double(*available))));
+  return txt;
+}
+
 void VideoCache::updateTestProgress()
 {
   if (testProgressDialog.isNull())
@@ -32,6 +32,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
+#include <common/EventSubsampler.h>
+#include <common/MemoryAccountant.h>
+#include <video/CacheEvictionPolicy.h>
+#include <video/CachePrediction.h>
+
 #include <QDockWidget>
 #include <QElapsedTimer>
 #include <QLabel>
@@ -73,6 +81,9 @@ public:
   void testConversionSpeed();
 
   QStringList getCacheStatusText();
+  // How much memory do the cache and all other large buffers use and how much may the cache use?
+  QStringList getMemoryStatusText() const;
+  int64_t     getCacheBudget() const { return this->cacheLevelMax; }
 
 signals:
   // This will be emitted on a regular basis to update the VideoCacheInfoWidget
@@ -108,6 +119,10 @@ private slots:
   // which frames can be removed from the cache.
   void updateCacheQueue();
 
+  // The playhead was moved by the user (or the playback direction/speed changed). Reorder the
+  // queue so that the frames that will be shown next are cached first.
+  void playheadMoved();
+
 private:
   // A cache job. Has a pointer to a playlist item and a range of frames to be cached.
   struct cacheJob
@@ -138,12 +153,34 @@ private:
   // The queue with a list of frames/items that can be removed from the queue if necessary
   QQueue<plItemFrame> cacheDeQueue;
   // If a frame is removed can be determined by the following cache states:
-  int64_t cacheLevelMax;
-  int64_t cacheLevelCurrent;
+  int64_t cacheLevelMax{};
+  // Also read by the memory accountant from other threads
+  std::atomic<int64_t> cacheLevelCurrent{};
+
+  // The cache size that the user configured in the settings. The cacheLevelMax can be lower than
+  // this if other buffers (statistics, parser trees ...) use memory or if the system (or cgroup)
+  // runs low on memory. The timer periodically checks this.
+  int64_t cacheLevelMaxSetting{};
+  QTimer  cacheBudgetTimer;
+  void    updateCacheBudget();
+
+  // Decides in which order the frames in the cacheDeQueue are removed
+  std::unique_ptr<CacheEvictionPolicy> evictionPolicy;
+  // Never remove frames within the loop range of the playback controller
+  bool            pinLoopRange{true};
+  EvictionContext getEvictionContext() const;
+  void            orderCacheDeQueueForEviction();
 
   // Enqueue the job in the queue. If all frames within the range are already cached in the item, do
   // nothing.
   void enqueueCacheJob(playlistItem *item, indexRange range);
+  // Enqueue (at most) maxNrFrames of the item that the playhead is in, ordered by when playback
+  // will show them. All other cached frames of the item are added to the cacheDeQueue.
+  void          enqueuePlayheadItemCacheJobs(playlistItem *item, int64_t maxNrFrames);
+  PlayheadState getPlayheadState() const;
+  bool          isFrameBeingCached(playlistItem *item, int frameIndex) const;
+  // Seeking can create a lot of events. Don't reorder the queue for every one of them.
+  EventSubsampler playheadMovedSubsampler{20};
 
   // Start the given number of worker threads (if caching is running, also new jobs will be pushed
   // to the workers)
@@ -215,6 +252,8 @@ private:
   void   updateTestProgress();
   QElapsedTimer testDuration;   //< Used to obtain the duration of the test
   void          testFinished(); //< Report the test results and stop the testProgrssUpdateTimer
+
+  MemoryAccountant::Registration memoryRegistration;
 };
 
 } // namespace video
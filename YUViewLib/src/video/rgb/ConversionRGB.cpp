@@ -311,4 +311,51 @@ rgba_t getPixelValueFromBuffer(const QByteArray &    sourceBuffer,
     return getPixelValue<16>(sourceBuffer, srcPixelFormat, frameSize, pixelPos);
 }
 
+QByteArray convertARGBToInputRGB(const unsigned char * argbData,
+                                 const int             bytesPerLine,
+                                 const Size            frameSize,
+                                 const PixelFormatRGB &format)
+{
+  if (argbData == nullptr || !format.isValid() || !frameSize.isValid())
+    return {};
+
+  QByteArray target;
+  target.resize(static_cast<int>(format.bytesPerFrame(frameSize)));
+
+  const auto twoBytes  = format.getBitsPerSample() > 8;
+  const auto bigEndian = format.getEndianess() == Endianness::Big;
+  const auto maxValue  = (1u << format.getBitsPerSample()) - 1;
+  const auto offsetToNextValue =
+      format.getDataLayout() == DataLayout::Planar ? 1 : format.nrChannels();
+
+  const Channel channels[] = {Channel::Red, Channel::Green, Channel::Blue, Channel::Alpha};
+  const int     shifts[]   = {16, 8, 0, 24};
+  const auto    nrChannels = format.hasAlpha() ? 4 : 3;
+
+  auto dst = reinterpret_cast<unsigned char *>(target.data());
+  for (int c = 0; c < nrChannels; c++)
+  {
+    auto sampleIndex = std::size_t(getOffsetToFirstByteOfComponent(channels[c], format, frameSize));
+    for (unsigned y = 0; y < frameSize.height; y++)
+    {
+      auto line = reinterpret_cast<const uint32_t *>(argbData + std::size_t(y) * bytesPerLine);
+      for (unsigned x = 0; x < frameSize.width; x++)
+      {
+        const auto value8 = (line[x] >> shifts[c]) & 0xff;
+        const auto value  = (value8 * maxValue + 127) / 255;
+        if (twoBytes)
+        {
+          dst[sampleIndex * 2]     = static_cast<unsigned char>(bigEndian ? value >> 8 : value);
+          dst[sampleIndex * 2 + 1] = static_cast<unsigned char>(bigEndian ? value : value >> 8);
+        }
+        else
+          dst[sampleIndex] = static_cast<unsigned char>(value);
+        sampleIndex += offsetToNextValue;
+      }
+    }
+  }
+
+  return target;
+}
+
 } // namespace video::rgb
@@ -63,4 +63,12 @@ rgba_t getPixelValueFromBuffer(const QByteArray &    sourceBuffer,
                                const Size            frameSize,
                                const QPoint &        pixelPos);
 
+// Convert 8 bit ARGB data (one 32 bit 0xAARRGGBB value per pixel in native byte order like in a
+// QImage::Format_ARGB32) to raw RGB data in the given format. Values with more than 8 bit are
+// scaled to the full range of the bit depth. Returns an empty array if the format is not valid.
+QByteArray convertARGBToInputRGB(const unsigned char * argbData,
+                                 const int             bytesPerLine,
+                                 const Size            frameSize,
+                                 const PixelFormatRGB &format);
+
 } // namespace video::rgb
\ No newline at end of file
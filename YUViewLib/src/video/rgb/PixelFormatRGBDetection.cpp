@@ -0,0 +1,387 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PixelFormatRGBDetection.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <tuple>
+
+#include <QtConcurrent>
+
+#include <video/yuv/PixelFormatYUVDetection.h>
+
+namespace video::rgb
+{
+
+namespace
+{
+
+// The number of rows per frame that are compared for each candidate
+constexpr int NR_SAMPLED_ROWS = 16;
+
+// The width is detected from the beginning of the data
+constexpr int64_t WIDTH_DETECTION_BYTES = 1 << 20;
+
+constexpr int MIN_HEIGHT = 16;
+constexpr int MAX_HEIGHT = 4320;
+
+// See the YUV detection for these values
+constexpr double MAX_NORMALIZED_DIFFERENCE    = 0.2;
+constexpr double EQUIVALENT_DIFFERENCE_FACTOR = 1.5;
+constexpr double EQUIVALENT_DIFFERENCE_OFFSET = 0.01;
+// The difference to the next frame must be below this fraction of the difference to the rows in
+// the middle of the same frame
+constexpr double MAX_REFERENCE_RATIO = 0.5;
+
+const auto CommonFrameSizes = std::vector<Size>({Size(176, 144),
+                                                 Size(352, 288),
+                                                 Size(640, 480),
+                                                 Size(720, 576),
+                                                 Size(800, 600),
+                                                 Size(1024, 768),
+                                                 Size(1280, 720),
+                                                 Size(1280, 1024),
+                                                 Size(1920, 1080),
+                                                 Size(3840, 2160)});
+
+// The tested layouts in the order in which they are preferred if they can not be distinguished
+struct Layout
+{
+  DataLayout dataLayout{};
+  AlphaMode  alphaMode{};
+  int        nrChannels{};
+};
+const auto LayoutsByPrevalence =
+    std::vector<Layout>({{DataLayout::Packed, AlphaMode::None, 3},
+                         {DataLayout::Packed, AlphaMode::Last, 4},
+                         {DataLayout::Planar, AlphaMode::None, 3}});
+
+const auto CommonAspectRatios =
+    std::vector<std::pair<int, int>>({{9, 16}, {3, 4}, {10, 16}, {1, 1}});
+
+struct Candidate
+{
+  Size    frameSize;
+  size_t  layoutIndex{};
+  int     bytesPerSample{};
+  int64_t bytesPerFrame{};
+  bool    isCommonSize{};
+  bool    hasDetectedWidth{};
+
+  // Filled by evaluateCandidate
+  double normalizedDifference{std::numeric_limits<double>::max()};
+  int    bitDepth{};
+};
+
+// The number of samples from one row of the first channel to the next
+int getSampleStride(const Layout &layout)
+{
+  return (layout.dataLayout == DataLayout::Packed) ? layout.nrChannels : 1;
+}
+
+// The sampled rows of the first frame, the same rows of the second frame and the same rows shifted
+// by half a frame. For planar formats, these are rows of the first plane.
+std::vector<ByteRange> getSampledRows(const Candidate &candidate)
+{
+  const auto &layout      = LayoutsByPrevalence[candidate.layoutIndex];
+  const auto  pixelBytes  = int64_t(getSampleStride(layout)) * candidate.bytesPerSample;
+  const auto  rowBytes    = int64_t(candidate.frameSize.width) * pixelBytes;
+  const auto  halfFrame   = candidate.bytesPerFrame / 2 / pixelBytes * pixelBytes;
+  const auto  nrRows      = std::min(NR_SAMPLED_ROWS, int(candidate.frameSize.height));
+  const auto  lastRowIdx  = int64_t(candidate.frameSize.height) - 1;
+  const auto  denominator = std::max(nrRows - 1, 1);
+
+  std::vector<ByteRange> rows;
+  for (const auto offset : {int64_t(0), candidate.bytesPerFrame, halfFrame})
+    for (int i = 0; i < nrRows; i++)
+      rows.push_back({offset + (i * lastRowIdx / denominator) * rowBytes, rowBytes});
+  return rows;
+}
+
+struct Statistics
+{
+  double normalizedDifference{std::numeric_limits<double>::max()};
+  int    maxValue{};
+};
+
+// Compare the rows with the rows at the given offset in the list of rows
+std::optional<Statistics> compareRows(const std::vector<ByteRange> &rows,
+                                      const size_t                  nrRowsFrame,
+                                      const size_t                  offset,
+                                      const int                     bytesPerSample,
+                                      const SampledRawData &        sampledData)
+{
+  double     sum{};
+  double     sumSquares{};
+  double     sumSquaredDifferences{};
+  int64_t    nrSamples{};
+  Statistics statistics;
+  for (size_t i = 0; i < nrRowsFrame; i++)
+  {
+    const auto row0 = sampledData.getData(rows[i]);
+    const auto row1 = sampledData.getData(rows[i + offset]);
+    if (row0 == nullptr || row1 == nullptr)
+      return {};
+
+    const auto samplesInRow = rows[i].size / bytesPerSample;
+    for (int64_t x = 0; x < samplesInRow; x++)
+    {
+      const auto value0     = getSample(row0, bytesPerSample, x);
+      const auto value1     = getSample(row1, bytesPerSample, x);
+      const auto difference = double(value0 - value1);
+      sum += value0;
+      sumSquares += double(value0) * value0;
+      sumSquaredDifferences += difference * difference;
+      statistics.maxValue = std::max(statistics.maxValue, std::max(value0, value1));
+    }
+    nrSamples += samplesInRow;
+  }
+  if (nrSamples == 0)
+    return {};
+
+  const auto mean     = sum / nrSamples;
+  const auto variance = sumSquares / nrSamples - mean * mean;
+  const auto mse      = sumSquaredDifferences / nrSamples;
+  if (variance > 0)
+    statistics.normalizedDifference = mse / (2 * variance);
+  else if (mse == 0)
+    statistics.normalizedDifference = 0;
+  return statistics;
+}
+
+void evaluateCandidate(Candidate &candidate, const SampledRawData &sampledData)
+{
+  const auto rows        = getSampledRows(candidate);
+  const auto nrRowsFrame = rows.size() / 3;
+
+  const auto frames =
+      compareRows(rows, nrRowsFrame, nrRowsFrame, candidate.bytesPerSample, sampledData);
+  const auto reference =
+      compareRows(rows, nrRowsFrame, 2 * nrRowsFrame, candidate.bytesPerSample, sampledData);
+  if (!frames || !reference)
+    return;
+
+  // A multiple of the real frame size compares identical frames and in smooth content, data that is
+  // only a few rows apart is also similar. Only if the next frame is clearly more similar than the
+  // middle of the same frame, the frame size is plausible.
+  if (frames->normalizedDifference >= reference->normalizedDifference * MAX_REFERENCE_RATIO)
+    return;
+
+  candidate.normalizedDifference = frames->normalizedDifference;
+  if (candidate.bytesPerSample == 1)
+    candidate.bitDepth = 8;
+  else
+    candidate.bitDepth = (frames->maxValue < 1024) ? 10 : (frames->maxValue < 4096) ? 12 : 16;
+}
+
+// Same as for YUV: Prefer 10/12 bit over 8 bit over 16 bit
+int getBitDepthPriority(const int bitDepth)
+{
+  if (bitDepth == 10 || bitDepth == 12)
+    return 0;
+  if (bitDepth == 8)
+    return 1;
+  return 2;
+}
+
+int64_t getBytesPerFrame(const Size &size, const Layout &layout, const int bytesPerSample)
+{
+  return int64_t(size.width) * size.height * layout.nrChannels * bytesPerSample;
+}
+
+// Detect the width from the samples of the first channel
+std::optional<int>
+detectWidth(const QByteArray &data, const Layout &layout, const int bytesPerSample)
+{
+  const auto stride = getSampleStride(layout);
+  if (stride == 1)
+    return yuv::detectLumaWidth(data, bytesPerSample);
+
+  const auto pixelBytes = stride * bytesPerSample;
+  QByteArray firstChannel;
+  firstChannel.reserve(data.size() / stride);
+  for (int pos = 0; pos + pixelBytes <= data.size(); pos += pixelBytes)
+    firstChannel.append(data.constData() + pos, bytesPerSample);
+  return yuv::detectLumaWidth(firstChannel, bytesPerSample);
+}
+
+std::vector<int> getHeightCandidates(const int                     width,
+                                     const Layout &                layout,
+                                     const int                     bytesPerSample,
+                                     const std::optional<int64_t> &fileSize)
+{
+  std::vector<int> heights;
+  if (fileSize)
+  {
+    for (int height = MIN_HEIGHT; height <= MAX_HEIGHT; height++)
+    {
+      const auto bytesPerFrame = getBytesPerFrame(Size(width, height), layout, bytesPerSample);
+      if (bytesPerFrame * 2 > *fileSize)
+        break;
+      if (*fileSize % bytesPerFrame == 0)
+        heights.push_back(height);
+    }
+    return heights;
+  }
+
+  for (const auto &[num, den] : CommonAspectRatios)
+  {
+    const auto height = width * num / den;
+    if (height >= MIN_HEIGHT && height <= MAX_HEIGHT)
+      heights.push_back(height);
+  }
+  return heights;
+}
+
+std::vector<Candidate> getCandidates(const QByteArray &data, const std::optional<int64_t> &fileSize)
+{
+  std::vector<Candidate> candidates;
+  for (const auto bytesPerSample : {1, 2})
+    for (size_t layoutIndex = 0; layoutIndex < LayoutsByPrevalence.size(); layoutIndex++)
+    {
+      const auto &layout        = LayoutsByPrevalence[layoutIndex];
+      const auto  detectedWidth = detectWidth(data, layout, bytesPerSample);
+
+      auto addCandidate = [&](const Size &size) {
+        const auto bytesPerFrame = getBytesPerFrame(size, layout, bytesPerSample);
+        if (fileSize && (bytesPerFrame * 2 > *fileSize || *fileSize % bytesPerFrame != 0))
+          return;
+
+        Candidate candidate;
+        candidate.frameSize      = size;
+        candidate.layoutIndex    = layoutIndex;
+        candidate.bytesPerSample = bytesPerSample;
+        candidate.bytesPerFrame  = bytesPerFrame;
+        candidate.isCommonSize   = std::find(CommonFrameSizes.begin(),
+                                           CommonFrameSizes.end(),
+                                           size) != CommonFrameSizes.end();
+        candidate.hasDetectedWidth = (detectedWidth == int(size.width));
+        candidates.push_back(candidate);
+      };
+
+      for (const auto &size : CommonFrameSizes)
+        addCandidate(size);
+
+      if (!detectedWidth)
+        continue;
+      for (const auto height :
+           getHeightCandidates(*detectedWidth, layout, bytesPerSample, fileSize))
+      {
+        const auto size = Size(*detectedWidth, height);
+        if (std::find(CommonFrameSizes.begin(), CommonFrameSizes.end(), size) ==
+            CommonFrameSizes.end())
+          addCandidate(size);
+      }
+    }
+  return candidates;
+}
+
+} // namespace
+
+std::optional<DetectedFormat> detectFormatFromData(const ReadBytesFunction &    readBytes,
+                                                   const std::optional<int64_t> fileSize)
+{
+  auto candidates = getCandidates(readBytes(0, WIDTH_DETECTION_BYTES), fileSize);
+  if (candidates.empty())
+    return {};
+
+  std::vector<ByteRange> rowsToRead;
+  for (const auto &candidate : candidates)
+  {
+    const auto rows = getSampledRows(candidate);
+    rowsToRead.insert(rowsToRead.end(), rows.begin(), rows.end());
+  }
+  const SampledRawData sampledData(readBytes, std::move(rowsToRead));
+
+  QtConcurrent::blockingMap(candidates, [&sampledData](Candidate &candidate) {
+    evaluateCandidate(candidate, sampledData);
+  });
+
+  const auto best = std::min_element(
+      candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.normalizedDifference < b.normalizedDifference;
+      });
+  if (best->normalizedDifference >= MAX_NORMALIZED_DIFFERENCE)
+    return {};
+
+  // Unlike for YUV, a multiple of the real frame size is already rejected by the comparison with
+  // the middle of the frame. From the candidates that are about as good as the best one, select by
+  // bit depth, the detected width, common sizes and then the order of the layouts. Packed and
+  // planar data with the same frame size compare the same bytes. The detected width tells them
+  // apart because it is only found in the first channel of the right layout. Taking every n-th
+  // sample of planar data also finds the width divided by n, so prefer the larger width.
+  const auto equivalentLimit =
+      std::max(best->normalizedDifference * EQUIVALENT_DIFFERENCE_FACTOR,
+               best->normalizedDifference + EQUIVALENT_DIFFERENCE_OFFSET);
+  const auto getSelectionKey = [](const Candidate &c) {
+    return std::make_tuple(getBitDepthPriority(c.bitDepth),
+                           c.hasDetectedWidth ? 0 : 1,
+                           c.isCommonSize ? 0 : 1,
+                           -int(c.frameSize.width),
+                           c.layoutIndex);
+  };
+  std::optional<Candidate> selected;
+  for (const auto &candidate : candidates)
+    if (candidate.normalizedDifference <= equivalentLimit &&
+        candidate.normalizedDifference < MAX_NORMALIZED_DIFFERENCE &&
+        (!selected || getSelectionKey(candidate) < getSelectionKey(*selected)))
+      selected = candidate;
+
+  // The confidence decreases if there is another format that is almost as good. Frame sizes that
+  // are a multiple or a divisor of the selected one are not considered since they compare the same
+  // (or very close) data.
+  auto secondBestDifference = std::numeric_limits<double>::max();
+  for (const auto &candidate : candidates)
+    if (candidate.bytesPerFrame % selected->bytesPerFrame != 0 &&
+        selected->bytesPerFrame % candidate.bytesPerFrame != 0)
+      secondBestDifference = std::min(secondBestDifference, candidate.normalizedDifference);
+
+  const auto quality    = 1.0 - selected->normalizedDifference / MAX_NORMALIZED_DIFFERENCE;
+  auto       separation = 1.0;
+  if (secondBestDifference <= 0)
+    separation = 0.0;
+  else if (secondBestDifference < std::numeric_limits<double>::max())
+    separation = 1.0 - selected->normalizedDifference / secondBestDifference;
+
+  const auto &layout = LayoutsByPrevalence[selected->layoutIndex];
+
+  DetectedFormat format;
+  format.pixelFormat = PixelFormatRGB(
+      unsigned(selected->bitDepth), layout.dataLayout, ChannelOrder::RGB, layout.alphaMode);
+  format.frameSize  = selected->frameSize;
+  format.confidence = std::clamp(quality * separation, 0.0, 1.0);
+  return format;
+}
+
+} // namespace video::rgb
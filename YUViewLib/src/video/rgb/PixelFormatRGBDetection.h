@@ -0,0 +1,65 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <video/SampledRawData.h>
+
+#include "PixelFormatRGB.h"
+
+namespace video::rgb
+{
+
+struct DetectedFormat
+{
+  PixelFormatRGB pixelFormat;
+  Size           frameSize;
+  // How sure we are about the format (0 to 1). This considers how similar the first two frames are
+  // with this format and how much better the format is than the next best one.
+  double confidence{};
+};
+
+/* Detect the format (frame size, number of channels, packed/planar and bit depth) of raw RGB data.
+ * This works like the YUV detection (yuv::detectFormatFromData): For every candidate format, a few
+ * sampled rows of the first two frames are compared and the format for which the two frames are
+ * the most similar is selected. For packed formats the whole row of all channels is compared, for
+ * planar formats the row of the first plane. The rows are also compared to the rows in the middle
+ * of the first frame to reject frame sizes that only compare well because the data is smooth. The
+ * width is detected from the first channel of the data for every layout. The order of the channels
+ * can not be detected this way and is always RGB.
+ */
+std::optional<DetectedFormat> detectFormatFromData(const ReadBytesFunction &    readBytes,
+                                                   const std::optional<int64_t> fileSize);
+
+} // namespace video::rgb
@@ -37,7 +37,9 @@
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
 #include <common/InfoItemAndData.h>
+#include <video/ImagePool.h>
 #include <video/rgb/ConversionRGB.h>
+#include <video/rgb/PixelFormatRGBDetection.h>
 #include <video/rgb/PixelFormatRGBGuess.h>
 #include <video/rgb/videoHandlerRGBCustomFormatDialog.h>
 
@@ -211,8 +213,26 @@ QStringPairList videoHandlerRGB::getPixelValues(const QPoint &pixelPos,
   return values;
 }
 
-void videoHandlerRGB::setFormatFromCorrelation(const QByteArray &, int64_t)
-{ /* TODO */
+/** Try to guess the format of the raw RGB data. See rgb::detectFormatFromData for how this is
+ * done. If fileSize is -1, the test if the file size is a multiple of the frame size is skipped.
+ */
+std::optional<double> videoHandlerRGB::setFormatFromCorrelation(
+    const std::function<QByteArray(int64_t, int64_t)> &readBytes, int64_t fileSize)
+{
+  std::optional<int64_t> size;
+  if (fileSize > 0)
+    size = fileSize;
+
+  const auto detectedFormat = detectFormatFromData(readBytes, size);
+  if (!detectedFormat)
+    return {};
+
+  DEBUG_RGB("videoHandlerRGB::setFormatFromCorrelation detected "
+            << detectedFormat->pixelFormat.getName().c_str() << " confidence "
+            << detectedFormat->confidence);
+  this->setSrcPixelFormat(detectedFormat->pixelFormat);
+  this->setFrameSize(detectedFormat->frameSize);
+  return detectedFormat->confidence;
 }
 
 bool videoHandlerRGB::setFormatFromString(QString format)
@@ -467,15 +487,14 @@ void videoHandlerRGB::loadFrame(int frameIndex, bool loadToDoubleBuffer)
   {
     QImage newImage;
     convertRGBToImage(currentFrameRawData, newImage);
-    doubleBufferImage           = newImage;
-    doubleBufferImageFrameIndex = frameIndex;
+    this->renderAheadQueue.push(frameIndex, newImage);
   }
   else if (currentImageIndex != frameIndex)
   {
     QImage newImage;
     convertRGBToImage(currentFrameRawData, newImage);
     QMutexLocker writeLock(&currentImageSetMutex);
-    currentImage      = newImage;
+    ImagePool::instance().replace(currentImage, newImage);
     currentImageIndex = frameIndex;
   }
 }
@@ -540,12 +559,8 @@ void videoHandlerRGB::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   // before the RGB format can change.
   rgbFormatMutex.lock();
 
-  requestDataMutex.lock();
-  emit signalRequestRawData(frameIndex, true);
-  tmpBufferRawRGBDataCaching = rawData;
-  requestDataMutex.unlock();
-
-  if (frameIndex != rawData_frameIndex)
+  tmpBufferRawRGBDataCaching = this->requestRawDataForCaching(frameIndex);
+  if (tmpBufferRawRGBDataCaching.isEmpty())
   {
     // Loading failed
     currentImageIndex = -1;
@@ -630,7 +645,7 @@ void videoHandlerRGB::convertRGBToImage(const QByteArray &sourceBuffer, QImage &
     return;
   }
 
-  outputImage = QImage(curFrameSize, format);
+  outputImage = ImagePool::instance().acquire(curFrameSize, format);
 
   // Check the image buffer size before we write to it
 #if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
@@ -85,8 +85,9 @@ public:
 
   // Try to guess and set the format (frameSize/srcPixelFormat) from the raw RGB data.
   // If a file size is given, it is tested if the RGB format and the file size match.
-  virtual void setFormatFromCorrelation(const QByteArray &rawRGBData,
-                                        int64_t           fileSize = -1) override;
+  virtual std::optional<double>
+  setFormatFromCorrelation(const std::function<QByteArray(int64_t, int64_t)> &readBytes,
+                           int64_t fileSize = -1) override;
 
   virtual QString getFormatAsString() const override
   {
@@ -33,12 +33,26 @@
 #include "videoHandler.h"
 
 #include <QPainter>
+#include <QSettings>
+
+#include <atomic>
 
 #include <common/FunctionsGui.h>
+#include <common/Tracing.h>
+#include <video/ImagePool.h>
 
 namespace video
 {
 
+namespace
+{
+
+// Counts up for every access to a cached frame (of any item). Used for least recently used
+// eviction from the cache.
+std::atomic<uint64_t> cacheAccessCounter{0};
+
+} // namespace
+
 // Activate this if you want to know when which buffer is loaded/converted to image and so on.
 #define VIDEOHANDLER_DEBUG_LOADING 0
 #if VIDEOHANDLER_DEBUG_LOADING && !NDEBUG
@@ -49,6 +63,16 @@ namespace video
 
 videoHandler::videoHandler()
 {
+  this->updateSettings();
+}
+
+void videoHandler::updateSettings()
+{
+  QSettings settings;
+  const auto nrFrames = settings.value("VideoCache/RenderAheadFrames",
+                                       RenderAheadQueue::DEFAULT_CAPACITY)
+                            .toUInt();
+  this->renderAheadQueue.setCapacity(nrFrames);
 }
 
 void videoHandler::slotVideoControlChanged()
@@ -59,7 +83,7 @@ void videoHandler::slotVideoControlChanged()
   // Set the current frame in the buffer to be invalid
   this->currentImageIndex = -1;
 
-  // The cache is invalid until the item is recached
+  // The cache and the render-ahead queue are invalid until the item is recached
   setCacheInvalid();
 
   if (newSize != frameSize && newSize.isValid())
@@ -97,105 +121,83 @@ ItemLoadingState videoHandler::needsLoading(int frameIdx, bool loadRawValues)
   QMutexLocker lock(&imageCacheAccess);
 
   // The raw values are not needed.
-  if (frameIdx == currentImageIndex)
+  if (frameIdx != currentImageIndex && !this->isFrameQueuedOrCached(frameIdx))
   {
-    if (doubleBufferImageFrameIndex == frameIdx + 1)
-    {
-      DEBUG_VIDEO("videoHandler::needsLoading %d is current and %d found in double buffer",
-                  frameIdx,
-                  frameIdx + 1);
-      return ItemLoadingState::LoadingNotNeeded;
-    }
-    else if (cacheValid && imageCache.contains(frameIdx + 1))
-    {
-      DEBUG_VIDEO(
-          "videoHandler::needsLoading %d is current and %d found in cache", frameIdx, frameIdx + 1);
-      return ItemLoadingState::LoadingNotNeeded;
-    }
-    else
-    {
-      // The next frame is not in the double buffer so that needs to be loaded.
-      DEBUG_VIDEO("videoHandler::needsLoading %d is current but %d not found in double buffer",
-                  frameIdx,
-                  frameIdx + 1);
-      return ItemLoadingState::LoadingNeededDoubleBuffer;
-    }
+    // Frame not in buffer. Request the background loading thread to load the frame.
+    DEBUG_VIDEO("videoHandler::needsLoading %d not found in cache - request load", frameIdx);
+    return ItemLoadingState::LoadingNeeded;
   }
 
-  // Check the double buffer
-  if (doubleBufferImageFrameIndex == frameIdx)
+  // The frames that playback will show after this one must be queued or cached
+  const auto nrFramesAhead = int(this->renderAheadQueue.getCapacity());
+  for (int i = 1; i <= nrFramesAhead; i++)
   {
-    // The frame in question is in the double buffer...
-    if (cacheValid && imageCache.contains(frameIdx + 1))
+    const auto nextFrameIdx = frameIdx + i * this->getRenderAheadStep();
+    if (!this->isFrameQueuedOrCached(nextFrameIdx))
     {
-      // ... and the one after that is in the cache.
-      DEBUG_VIDEO("videoHandler::needsLoading %d found in double buffer. Next frame in cache.",
-                  frameIdx);
-      return ItemLoadingState::LoadingNotNeeded;
-    }
-    else
-    {
-      // .. and the one after that is not in the cache.
-      // Loading of the given frame index is not needed because it is in the double buffer but if
-      // you draw it, the double buffer needs an update.
-      DEBUG_VIDEO("videoHandler::needsLoading %d found in double buffer", frameIdx);
+      DEBUG_VIDEO("videoHandler::needsLoading %d available but %d not rendered ahead",
+                  frameIdx,
+                  nextFrameIdx);
       return ItemLoadingState::LoadingNeededDoubleBuffer;
     }
   }
 
-  // Check the cache
-  if (cacheValid && imageCache.contains(frameIdx))
+  DEBUG_VIDEO("videoHandler::needsLoading %d available and %d frames rendered ahead",
+              frameIdx,
+              nrFramesAhead);
+  return ItemLoadingState::LoadingNotNeeded;
+}
+
+bool videoHandler::isFrameQueuedOrCached(int frameIndex) const
+{
+  return this->renderAheadQueue.contains(frameIndex) ||
+         (this->cacheValid && this->imageCache.contains(frameIndex));
+}
+
+std::optional<int> videoHandler::getNextRenderAheadFrame(int frameIndex) const
+{
+  // If playback already moved on, the queue is filled ahead of the frame on screen
+  auto       startFrameIdx = frameIndex;
+  const auto shownFrameIdx = this->currentImageIndex;
+  if (shownFrameIdx != -1 && (this->getRenderAheadStep() > 0 ? shownFrameIdx > frameIndex
+                                                              : shownFrameIdx < frameIndex))
+    startFrameIdx = shownFrameIdx;
+
+  QMutexLocker lock(&imageCacheAccess);
+  const auto   nrFramesAhead = int(this->renderAheadQueue.getCapacity());
+  for (int i = 1; i <= nrFramesAhead; i++)
   {
-    // What about the next frame? Is it also in the cache or in the double buffer?
-    if (doubleBufferImageFrameIndex == frameIdx + 1)
-    {
-      DEBUG_VIDEO("videoHandler::needsLoading %d in cache and %d found in double buffer",
-                  frameIdx,
-                  frameIdx + 1);
-      return ItemLoadingState::LoadingNotNeeded;
-    }
-    else if (cacheValid && imageCache.contains(frameIdx + 1))
-    {
-      DEBUG_VIDEO(
-          "videoHandler::needsLoading %d in cache and %d found in cache", frameIdx, frameIdx + 1);
-      return ItemLoadingState::LoadingNotNeeded;
-    }
-    else
-    {
-      // The next frame is not in the double buffer so that needs to be loaded.
-      DEBUG_VIDEO("videoHandler::needsLoading %d found in cache but %d not found in double buffer",
-                  frameIdx,
-                  frameIdx + 1);
-      return ItemLoadingState::LoadingNeededDoubleBuffer;
-    }
+    const auto nextFrameIdx = startFrameIdx + i * this->getRenderAheadStep();
+    if (!this->isFrameQueuedOrCached(nextFrameIdx))
+      return nextFrameIdx;
   }
-
-  // Frame not in buffer. Return false and request the background loading thread to load the frame.
-  DEBUG_VIDEO("videoHandler::needsLoading %d not found in cache - request load", frameIdx);
-  return ItemLoadingState::LoadingNeeded;
+  return {};
 }
 
 void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor, bool drawRawValues)
 {
+  TRACE_SCOPE("paint", "videoHandler::drawFrame", frameIdx);
+
   // Check if the frameIdx changed and if we have to load a new frame
   if (frameIdx != currentImageIndex)
   {
     // The current buffer is out of date. Update it.
 
-    // Check the double buffer
-    if (frameIdx == doubleBufferImageFrameIndex)
+    // Check the render-ahead queue
+    if (auto queuedImage = this->renderAheadQueue.take(frameIdx))
     {
-      currentImage      = doubleBufferImage;
+      currentImage      = *queuedImage;
       currentImageIndex = frameIdx;
-      DEBUG_VIDEO("videoHandler::drawFrame %d loaded from double buffer", frameIdx);
+      DEBUG_VIDEO("videoHandler::drawFrame %d loaded from render-ahead queue", frameIdx);
     }
     else
     {
       QMutexLocker lock(&imageCacheAccess);
       if (cacheValid && imageCache.contains(frameIdx))
       {
-        currentImage      = imageCache[frameIdx];
-        currentImageIndex = frameIdx;
+        currentImage                   = imageCache[frameIdx];
+        currentImageIndex              = frameIdx;
+        imageCacheLastAccess[frameIdx] = ++cacheAccessCounter;
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
     }
@@ -211,7 +213,7 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  this->drawCurrentImage(painter, videoRect, zoomFactor);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
@@ -268,6 +270,7 @@ int videoHandler::getNrFramesCached() const
 // Put the frame into the cache (if it is not already in there)
 void videoHandler::cacheFrame(int frameIdx, bool testMode)
 {
+  TRACE_SCOPE("cache", "videoHandler::cacheFrame", frameIdx);
   DEBUG_VIDEO("videoHandler::cacheFrame %d %s", frameIdx, testMode ? "testMode" : "");
 
   if (cacheValid && isInCache(frameIdx) && !testMode)
@@ -285,14 +288,26 @@ void videoHandler::cacheFrame(int frameIdx, bool testMode)
   if (!cacheImage.isNull())
   {
     DEBUG_VIDEO("videoHandler::cacheFrame insert frame %i into cache", frameIdx);
+    TRACE_SCOPE("cache", "videoHandler::insertIntoCache", frameIdx);
     QMutexLocker imageCacheLock(&imageCacheAccess);
     if (cacheValid && !testMode)
+    {
       imageCache.insert(frameIdx, cacheImage);
+      imageCacheLastAccess.insert(frameIdx, ++cacheAccessCounter);
+    }
   }
   else
     DEBUG_VIDEO("videoHandler::cacheFrame loading frame %i for caching failed", frameIdx);
 }
 
+QImage videoHandler::loadFrameForExport(int frameIndex)
+{
+  DEBUG_VIDEO("videoHandler::loadFrameForExport %d", frameIndex);
+  QImage image;
+  this->loadFrameForCaching(frameIndex, image);
+  return image;
+}
+
 unsigned videoHandler::getCachingFrameSize() const
 {
   const auto hasAlpha = false;
@@ -312,6 +327,12 @@ int videoHandler::getNumberCachedFrames() const
   return imageCache.size();
 }
 
+uint64_t videoHandler::getCachedFrameLastAccess(int frameIdx) const
+{
+  QMutexLocker lock(&imageCacheAccess);
+  return imageCacheLastAccess.value(frameIdx, 0);
+}
+
 bool videoHandler::isInCache(int idx) const
 {
   QMutexLocker lock(&imageCacheAccess);
@@ -321,9 +342,14 @@ bool videoHandler::isInCache(int idx) const
 void videoHandler::removeFrameFromCache(int frameIdx)
 {
   DEBUG_VIDEO("removeFrameFromCache %d", frameIdx);
+  TRACE_SCOPE("cache", "videoHandler::removeFrameFromCache", frameIdx);
   QMutexLocker lock(&imageCacheAccess);
-  imageCache.remove(frameIdx);
+  auto         image = imageCache.take(frameIdx);
+  imageCacheLastAccess.remove(frameIdx);
   lock.unlock();
+
+  // If the image is not shown anymore, its memory can be reused for the next converted frame
+  ImagePool::instance().release(image);
 }
 
 void videoHandler::removeAllFrameFromCache()
@@ -331,6 +357,7 @@ void videoHandler::removeAllFrameFromCache()
   DEBUG_VIDEO("removeAllFrameFromCache");
   QMutexLocker lock(&imageCacheAccess);
   imageCache.clear();
+  imageCacheLastAccess.clear();
   cacheValid = true;
   lock.unlock();
 }
@@ -356,15 +383,14 @@ void videoHandler::loadFrame(int frameIndex, bool loadToDoubleBuffer)
 
   if (loadToDoubleBuffer)
   {
-    // Save the requested frame in the double buffer
-    doubleBufferImage           = requestedFrame;
-    doubleBufferImageFrameIndex = frameIndex;
+    // Add the requested frame to the render-ahead queue
+    this->renderAheadQueue.push(frameIndex, requestedFrame);
   }
   else
   {
     // Set the requested frame as the current frame
     QMutexLocker imageLock(&currentImageSetMutex);
-    currentImage      = requestedFrame;
+    ImagePool::instance().replace(currentImage, requestedFrame);
     currentImageIndex = frameIndex;
   }
 }
@@ -385,6 +411,21 @@ void videoHandler::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   frameToCache = requestedFrame;
 }
 
+QByteArray videoHandler::requestRawDataForCaching(int frameIndex)
+{
+  TRACE_SCOPE("file", "videoHandler::requestRawData", frameIndex);
+
+  if (this->concurrentRawDataReader)
+    if (auto data = this->concurrentRawDataReader(frameIndex))
+      return *data;
+
+  QMutexLocker lock(&this->requestDataMutex);
+  emit         signalRequestRawData(frameIndex, true);
+  if (frameIndex != this->rawData_frameIndex)
+    return {};
+  return this->rawData;
+}
+
 void videoHandler::invalidateAllBuffers()
 {
   currentFrameRawData_frameIndex = -1;
@@ -397,18 +438,50 @@ void videoHandler::invalidateAllBuffers()
   currentImage = QImage();
   currentImageSetMutex.unlock();
   requestedFrame_idx = -1;
+  this->renderAheadQueue.clear();
 
   imageCache.clear();
+  imageCacheLastAccess.clear();
   cacheValid = true;
 }
 
-void videoHandler::activateDoubleBuffer()
+void videoHandler::invalidateBuffersFrom(int frameIndex)
 {
-  if (doubleBufferImageFrameIndex != -1)
+  if (currentFrameRawData_frameIndex >= frameIndex)
+    currentFrameRawData_frameIndex = -1;
+  if (rawData_frameIndex >= frameIndex)
+    rawData_frameIndex = -1;
+  if (requestedFrame_idx >= frameIndex)
+    requestedFrame_idx = -1;
+  if (currentImageIndex >= frameIndex)
+  {
+    currentImageIndex       = -1;
+    currentImage_frameIndex = -1;
+    currentImageSetMutex.lock();
+    currentImage = QImage();
+    currentImageSetMutex.unlock();
+  }
+  this->renderAheadQueue.removeFramesFrom(frameIndex);
+
+  QMutexLocker lock(&imageCacheAccess);
+  for (auto it = imageCache.lowerBound(frameIndex); it != imageCache.end();)
   {
-    currentImage      = doubleBufferImage;
-    currentImageIndex = doubleBufferImageFrameIndex;
-    DEBUG_VIDEO("videoHandler::drawFrame %d loaded from double buffer", currentImageIndex);
+    ImagePool::instance().release(it.value());
+    imageCacheLastAccess.remove(it.key());
+    it = imageCache.erase(it);
+  }
+}
+
+void videoHandler::activateDoubleBuffer(int frameIndex)
+{
+  if (frameIndex == currentImageIndex)
+    return;
+  if (auto queuedImage = this->renderAheadQueue.take(frameIndex))
+  {
+    QMutexLocker imageLock(&currentImageSetMutex);
+    currentImage      = *queuedImage;
+    currentImageIndex = frameIndex;
+    DEBUG_VIDEO("videoHandler::activateDoubleBuffer %d loaded from render-ahead queue", frameIndex);
   }
 }
 
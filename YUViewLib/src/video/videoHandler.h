@@ -36,11 +36,15 @@
 
 #include "FrameHandler.h"
 #include "PixelFormat.h"
+#include "RenderAheadQueue.h"
 
 #include <QBasicTimer>
 #include <QFileInfo>
 #include <QMutex>
 
+#include <functional>
+#include <optional>
+
 namespace video
 {
 
@@ -65,9 +69,14 @@ public:
   QList<int>       getCachedFrames() const;
   int              getNumberCachedFrames() const;
   bool             isInCache(int idx) const;
+  uint64_t         getCachedFrameLastAccess(int frameIdx) const;
   virtual void     removeFrameFromCache(int frameIndex);
   virtual void     removeAllFrameFromCache();
 
+  // Load the given frame without touching the cache or the frame on screen. This uses the same
+  // path as caching and can be called from multiple threads at the same time (e.g. for export).
+  QImage loadFrameForExport(int frameIndex);
+
   // Get the number of bytes for one frame (RGB or YUV) with the current format (if this video
   // handler uses raw data)
   virtual int64_t getBytesPerFrame() const { return -1; }
@@ -85,11 +94,17 @@ public:
                                      const bool       markDifference) override;
 
   // Try to guess and set the format (frameSize/srcPixelFormat) from the raw data in the right raw
-  // format. If a file size is given, it is tested if the guessed format and the file size match.
+  // format. Only the parts of the data that are needed are read using readBytes (position, number
+  // of bytes). If a file size is given, it is tested if the guessed format and the file size match.
+  // If a format was set, return the confidence of the guess (0 to 1).
   // You can overload this for any specific raw format. The default implementation does nothing.
-  virtual void setFormatFromCorrelation(const QByteArray &, int64_t fileSize = -1)
+  virtual std::optional<double>
+  setFormatFromCorrelation(const std::function<QByteArray(int64_t, int64_t)> &readBytes,
+                           int64_t                                           fileSize = -1)
   {
+    (void)readBytes;
     (void)fileSize;
+    return {};
   }
 
   virtual void
@@ -104,6 +119,9 @@ public:
   // If reloading a raw file (because it changed), this function will clear all buffers (also the
   // cache). With the next drawFrame(), the data will be reloaded from file.
   void invalidateAllBuffers();
+  // Frames were inserted or changed from the given frame index on. Only the buffers and cached
+  // frames from this index on are cleared.
+  void invalidateBuffersFrom(int frameIndex);
 
   // The user changed the frame. Do we need to load something before we can draw it? Do we need to
   // update the double buffer? loadRawValues: Do we also need to update the buffer of the raw values
@@ -113,14 +131,28 @@ public:
   // The video handler want's to draw a frame but it's not cached yet and has to be loaded.
   // A sub class can change this implementation to request raw data of a certain format instead of
   // an image. After this function was called, currentFrame should contain the requested frame and
-  // currentFrameIndex should be equal to frameIndex.
+  // currentFrameIndex should be equal to frameIndex. If loadToDoubleBuffer is set, the frame is
+  // added to the render-ahead queue instead.
   virtual void loadFrame(int frameIndex, bool loadToDoubleBuffer = false);
 
   virtual int getCurrentImageIndex() const { return currentImageIndex; }
 
-  // Set the image in the double buffer as the current image. After this, a new image can be loaded
-  // to the double buffer.
-  void activateDoubleBuffer();
+  // During playback, the frames at frameIndex + playbackStep, frameIndex + 2 * playbackStep, ...
+  // are loaded into the render-ahead queue. The step is negative for reverse playback and larger
+  // than 1 if frames are skipped (N x playback).
+  void setPlaybackStep(int step) { this->playbackStep = (step == 0) ? 1 : step; }
+  int  getPlaybackStep() const { return this->playbackStep; }
+
+  // Get the next frame that should be loaded into the render-ahead queue while playback shows the
+  // given frame (or a later one that is already on screen). Return nothing if all frames that fit
+  // into the queue are queued or cached.
+  virtual std::optional<int> getNextRenderAheadFrame(int frameIndex) const;
+
+  // If the given frame is in the render-ahead queue, take it out and make it the current image.
+  virtual void activateDoubleBuffer(int frameIndex);
+
+  // Read the number of frames to render ahead from the settings
+  void updateSettings();
 
   // Create the controls for this videoHandler and return a pointer to the layout (nullptr if the
   // handler has no controls). isSizeFixed: For example a YUV file does not have a fixed format (the
@@ -134,6 +166,17 @@ public:
   QByteArray rawData;
   int        rawData_frameIndex{-1};
 
+  // Sources that can read the raw data of any frame from multiple threads at the same time (e.g.
+  // raw files) can set this function. The caching threads then use it instead of
+  // signalRequestRawData so that several frames can be loaded and converted in parallel. The
+  // function must be thread safe and return an empty array if loading failed. If it returns no
+  // value, signalRequestRawData is used for the frame.
+  using ConcurrentRawDataReader = std::function<std::optional<QByteArray>(int frameIndex)>;
+  void setConcurrentRawDataReader(ConcurrentRawDataReader reader)
+  {
+    this->concurrentRawDataReader = std::move(reader);
+  }
+
   // Do we need to load the raw values (because they are drawn on screen?)
   // The videoHandler will draw the pixel values (drawPixelValues()) using the 8bit QImage
   // currentImage so no loading is needed. However, the videoHandlerRGB or YUV may have to load the
@@ -173,15 +216,26 @@ protected:
   // Only one thread at a time should request something to be loaded.
   QMutex requestDataMutex;
 
+  // Get the raw data of the given frame for caching or exporting. If a concurrent reader is set,
+  // the data is read without locking. Otherwise signalRequestRawData is emitted while holding the
+  // requestDataMutex. Return an empty array if loading failed.
+  QByteArray              requestRawDataForCaching(int frameIndex);
+  ConcurrentRawDataReader concurrentRawDataReader;
+
   // We might need to update the currentImage
   int currentImage_frameIndex{-1};
 
   // Don't let the background loading thread set the image while we are drawing it.
   QMutex currentImageSetMutex;
 
-  // Double buffering
-  QImage doubleBufferImage;
-  int    doubleBufferImageFrameIndex{-1};
+  // The frames that playback will show next
+  RenderAheadQueue renderAheadQueue;
+  int              playbackStep{1};
+
+  // Is the frame in the render-ahead queue or in the cache? imageCacheAccess must be locked.
+  bool isFrameQueuedOrCached(int frameIndex) const;
+  // The distance between two frames in the render-ahead queue
+  virtual int getRenderAheadStep() const { return this->playbackStep; }
 
   // The buffer of the raw data (RGB or YUV) of the current frame (and its frame index)
   // Before using the currentFrameRawData, you have to check if the currentFrameRawData_frameIndex
@@ -190,11 +244,17 @@ protected:
   int        currentFrameRawData_frameIndex{-1};
 
   // Set the cache to be invalid until a call to removefromCache(-1) clears it.
-  void setCacheInvalid() { cacheValid = false; }
+  void setCacheInvalid()
+  {
+    cacheValid = false;
+    this->renderAheadQueue.clear();
+  }
 
   // --- Caching
   QMutex mutable imageCacheAccess;
   QMap<int, QImage> imageCache;
+  // When was the cached frame last drawn (see getCachedFrameLastAccess)
+  QMap<int, uint64_t> imageCacheLastAccess;
   // Is the cache valid? The cache can be ivalid in the following scenario:
   // Somethign about how an item is shown changes (e.g. the resolution) but caching of the item is
   // currently performed. If we just cleared the cache, the wrong (currently being cached) frames
@@ -69,12 +69,12 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
   {
     // The current buffer is out of date. Update it.
 
-    // Check the double buffer
-    if (frameIdx == doubleBufferImageFrameIndex)
+    // Check the render-ahead queue
+    if (auto queuedImage = this->renderAheadQueue.take(frameIdx))
     {
-      currentImage      = doubleBufferImage;
+      currentImage      = *queuedImage;
       currentImageIndex = frameIdx;
-      DEBUG_VIDEO("videoHandler::drawFrame %d loaded from double buffer", frameIdx);
+      DEBUG_VIDEO("videoHandler::drawFrame %d loaded from render-ahead queue", frameIdx);
     }
     else
     {
@@ -95,7 +95,7 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  this->drawCurrentImage(painter, videoRect, zoomFactor);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
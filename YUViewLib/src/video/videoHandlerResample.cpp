@@ -32,6 +32,7 @@
 
 #include "videoHandlerResample.h"
 
+#include <video/ImagePool.h>
 #include <video/yuv/videoHandlerYUV.h>
 
 #include <QPainter>
@@ -84,6 +85,20 @@ ItemLoadingState videoHandlerResample::needsLoading(int frameIndex, bool loadRaw
   return videoHandler::needsLoading(mappedIndex, loadRawValues);
 }
 
+std::optional<int> videoHandlerResample::getNextRenderAheadFrame(int frameIndex) const
+{
+  const auto nextMappedIndex =
+      videoHandler::getNextRenderAheadFrame(this->mapFrameIndex(frameIndex));
+  if (!nextMappedIndex)
+    return {};
+  return (*nextMappedIndex - this->cutRange.first) / this->sampling;
+}
+
+void videoHandlerResample::activateDoubleBuffer(int frameIndex)
+{
+  videoHandler::activateDoubleBuffer(this->mapFrameIndex(frameIndex));
+}
+
 void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleBuffer)
 {
   if (!this->inputValid())
@@ -108,16 +123,16 @@ void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleB
 
   if (loadToDoubleBuffer)
   {
-    doubleBufferImage           = newFrame;
-    doubleBufferImageFrameIndex = mappedIndex;
-    DEBUG_RESAMPLE("videoHandlerResample::loadResampledFrame Loaded frame %d to double buffer",
-                   mappedIndex);
+    this->renderAheadQueue.push(mappedIndex, newFrame);
+    DEBUG_RESAMPLE(
+        "videoHandlerResample::loadResampledFrame Loaded frame %d to render-ahead queue",
+        mappedIndex);
   }
   else
   {
     // The new difference frame is ready
     QMutexLocker lock(&this->currentImageSetMutex);
-    currentImage      = newFrame;
+    ImagePool::instance().replace(currentImage, newFrame);
     currentImageIndex = mappedIndex;
     DEBUG_RESAMPLE("videoHandlerResample::loadResampledFrame Loaded frame %d to current buffer",
                    mappedIndex);
@@ -181,7 +196,7 @@ void videoHandlerResample::guessAndSetPixelFormat(
   assert(false);
 }
 
-int videoHandlerResample::mapFrameIndex(int frameIndex)
+int videoHandlerResample::mapFrameIndex(int frameIndex) const
 {
   auto mappedIndex = (frameIndex * this->sampling) + this->cutRange.first;
   DEBUG_RESAMPLE(
@@ -63,7 +63,9 @@ public:
                                        QList<InfoItem> &differenceInfoList,
                                        const int        amplificationFactor,
                                        const bool       markDifference) override;
-  ItemLoadingState needsLoading(int frameIndex, bool loadRawValues) override;
+  ItemLoadingState   needsLoading(int frameIndex, bool loadRawValues) override;
+  std::optional<int> getNextRenderAheadFrame(int frameIndex) const override;
+  void               activateDoubleBuffer(int frameIndex) override;
 
   void loadResampledFrame(int frameIndex, bool loadToDoubleBuffer = false);
   bool inputValid() const;
@@ -82,8 +84,11 @@ public:
 
   QList<InfoItem> resampleInfoList;
 
+protected:
+  int getRenderAheadStep() const override { return this->playbackStep * this->sampling; }
+
 private:
-  int mapFrameIndex(int frameIndex);
+  int mapFrameIndex(int frameIndex) const;
 
   // The input video we will resample
   QPointer<FrameHandler> inputVideo;
@@ -0,0 +1,338 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConversionRGBToYUV.h"
+
+#include <common/Functions.h>
+
+#include <cmath>
+#include <vector>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+struct ConversionCoefficients
+{
+  double kr{};
+  double kb{};
+  bool   fullRange{};
+};
+
+ConversionCoefficients getConversionCoefficients(const ColorConversion colorConversion)
+{
+  switch (colorConversion)
+  {
+  case ColorConversion::BT709_FullRange:
+    return {0.2126, 0.0722, true};
+  case ColorConversion::BT601_LimitedRange:
+    return {0.299, 0.114, false};
+  case ColorConversion::BT601_FullRange:
+    return {0.299, 0.114, true};
+  case ColorConversion::BT2020_LimitedRange:
+    return {0.2627, 0.0593, false};
+  case ColorConversion::BT2020_FullRange:
+    return {0.2627, 0.0593, true};
+  default:
+    return {0.2126, 0.0722, false};
+  }
+}
+
+// The components in the output bit depth. Y and A in full resolution, U and V subsampled.
+struct ComponentPlanes
+{
+  std::vector<unsigned> Y;
+  std::vector<unsigned> U;
+  std::vector<unsigned> V;
+  std::vector<unsigned> A;
+};
+
+ComponentPlanes convertToComponentPlanes(const unsigned char  *argbData,
+                                         const int             bytesPerLine,
+                                         const Size            frameSize,
+                                         const PixelFormatYUV &format,
+                                         const ColorConversion colorConversion)
+{
+  const auto w        = frameSize.width;
+  const auto h        = frameSize.height;
+  const auto bitDepth = format.getBitsPerSample();
+  const auto maxValue = double((1u << bitDepth) - 1);
+  const auto coeffs   = getConversionCoefficients(colorConversion);
+  const auto kg       = 1.0 - coeffs.kr - coeffs.kb;
+
+  // Scale from the normalized values in the range of 0..255 (-127.5..127.5 for chroma)
+  const auto rangeScale   = double(1u << (bitDepth - 8));
+  const auto lumaScale    = coeffs.fullRange ? maxValue / 255.0 : 219.0 / 255.0 * rangeScale;
+  const auto lumaOffset   = coeffs.fullRange ? 0.0 : 16.0 * rangeScale;
+  const auto chromaScale  = coeffs.fullRange ? maxValue / 255.0 : 224.0 / 255.0 * rangeScale;
+  const auto chromaOffset = double(1u << (bitDepth - 1));
+
+  auto toOutputValue = [maxValue](const double value) {
+    return static_cast<unsigned>(functions::clip(std::lround(value), 0l, long(maxValue)));
+  };
+
+  ComponentPlanes planes;
+  planes.Y.resize(w * h);
+  if (format.hasAlpha())
+    planes.A.resize(w * h);
+
+  const auto hasChroma = format.getSubsampling() != Subsampling::YUV_400;
+  std::vector<double> fullResU, fullResV;
+  if (hasChroma)
+  {
+    fullResU.resize(w * h);
+    fullResV.resize(w * h);
+  }
+
+  for (unsigned y = 0; y < h; y++)
+  {
+    auto line = reinterpret_cast<const uint32_t *>(argbData + std::size_t(y) * bytesPerLine);
+    for (unsigned x = 0; x < w; x++)
+    {
+      const auto pixel = line[x];
+      const auto a     = double((pixel >> 24) & 0xff);
+      const auto r     = double((pixel >> 16) & 0xff);
+      const auto g     = double((pixel >> 8) & 0xff);
+      const auto b     = double(pixel & 0xff);
+
+      const auto luma = coeffs.kr * r + kg * g + coeffs.kb * b;
+      const auto i    = y * w + x;
+      planes.Y[i]     = toOutputValue(lumaOffset + luma * lumaScale);
+      if (!planes.A.empty())
+        planes.A[i] = toOutputValue(a * maxValue / 255.0);
+      if (hasChroma)
+      {
+        fullResU[i] = chromaOffset + (b - luma) / (2.0 * (1.0 - coeffs.kb)) * chromaScale;
+        fullResV[i] = chromaOffset + (r - luma) / (2.0 * (1.0 - coeffs.kr)) * chromaScale;
+      }
+    }
+  }
+
+  if (hasChroma)
+  {
+    const auto subH = unsigned(format.getSubsamplingHor());
+    const auto subV = unsigned(format.getSubsamplingVer());
+    const auto wC   = w / subH;
+    const auto hC   = h / subV;
+    planes.U.resize(wC * hC);
+    planes.V.resize(wC * hC);
+    for (unsigned yC = 0; yC < hC; yC++)
+    {
+      for (unsigned xC = 0; xC < wC; xC++)
+      {
+        double sumU = 0, sumV = 0;
+        for (unsigned dy = 0; dy < subV; dy++)
+        {
+          for (unsigned dx = 0; dx < subH; dx++)
+          {
+            const auto i = (yC * subV + dy) * w + xC * subH + dx;
+            sumU += fullResU[i];
+            sumV += fullResV[i];
+          }
+        }
+        planes.U[yC * wC + xC] = toOutputValue(sumU / (subH * subV));
+        planes.V[yC * wC + xC] = toOutputValue(sumV / (subH * subV));
+      }
+    }
+  }
+
+  return planes;
+}
+
+class SampleWriter
+{
+public:
+  SampleWriter(QByteArray &target, const PixelFormatYUV &format)
+      : data(reinterpret_cast<unsigned char *>(target.data())),
+        twoBytes(format.getBitsPerSample() > 8), bigEndian(format.isBigEndian())
+  {
+  }
+
+  void write(const std::size_t sampleIndex, const unsigned value)
+  {
+    if (!this->twoBytes)
+    {
+      this->data[sampleIndex] = static_cast<unsigned char>(value);
+      return;
+    }
+    auto dst = this->data + sampleIndex * 2;
+    if (this->bigEndian)
+    {
+      dst[0] = static_cast<unsigned char>(value >> 8);
+      dst[1] = static_cast<unsigned char>(value & 0xff);
+    }
+    else
+    {
+      dst[0] = static_cast<unsigned char>(value & 0xff);
+      dst[1] = static_cast<unsigned char>(value >> 8);
+    }
+  }
+
+private:
+  unsigned char *data{};
+  bool           twoBytes{};
+  bool           bigEndian{};
+};
+
+void writePlanar(const ComponentPlanes &planes, const PixelFormatYUV &format, QByteArray &target)
+{
+  SampleWriter writer(target, format);
+
+  std::size_t pos = 0;
+  for (const auto value : planes.Y)
+    writer.write(pos++, value);
+
+  const auto uFirst =
+      format.getPlaneOrder() == PlaneOrder::YUV || format.getPlaneOrder() == PlaneOrder::YUVA;
+  const auto &first  = uFirst ? planes.U : planes.V;
+  const auto &second = uFirst ? planes.V : planes.U;
+  if (format.isUVInterleaved())
+  {
+    for (std::size_t i = 0; i < first.size(); i++)
+    {
+      writer.write(pos++, first[i]);
+      writer.write(pos++, second[i]);
+    }
+  }
+  else
+  {
+    for (const auto value : first)
+      writer.write(pos++, value);
+    for (const auto value : second)
+      writer.write(pos++, value);
+  }
+
+  for (const auto value : planes.A)
+    writer.write(pos++, value);
+}
+
+void writePacked(const ComponentPlanes &planes, const PixelFormatYUV &format, QByteArray &target)
+{
+  SampleWriter writer(target, format);
+
+  const auto packing = format.getPackingOrder();
+  if (format.getSubsampling() == Subsampling::YUV_422)
+  {
+    // The same offsets within the 4 samples (for 2 pixels) as in convertYUVPackedToPlanar
+    const int oY = (packing == PackingOrder::YUYV || packing == PackingOrder::YVYU) ? 0 : 1;
+    const int oU = (packing == PackingOrder::UYVY)   ? 0
+                   : (packing == PackingOrder::YUYV) ? 1
+                   : (packing == PackingOrder::VYUY) ? 2
+                                                     : 3;
+    const int oV = (packing == PackingOrder::VYUY)   ? 0
+                   : (packing == PackingOrder::YVYU) ? 1
+                   : (packing == PackingOrder::UYVY) ? 2
+                                                     : 3;
+
+    for (std::size_t i = 0; i < planes.U.size(); i++)
+    {
+      writer.write(i * 4 + oY, planes.Y[i * 2]);
+      writer.write(i * 4 + oY + 2, planes.Y[i * 2 + 1]);
+      writer.write(i * 4 + oU, planes.U[i]);
+      writer.write(i * 4 + oV, planes.V[i]);
+    }
+  }
+  else
+  {
+    const int oY = (packing == PackingOrder::AYUV) ? 1 : (packing == PackingOrder::VUYA) ? 2 : 0;
+    const int oU = (packing == PackingOrder::YUV || packing == PackingOrder::YUVA ||
+                    packing == PackingOrder::VUYA)
+                       ? 1
+                       : 2;
+    const int oV = (packing == PackingOrder::YVU)    ? 1
+                   : (packing == PackingOrder::AYUV) ? 3
+                   : (packing == PackingOrder::VUYA) ? 0
+                                                     : 2;
+    const int oA         = (packing == PackingOrder::AYUV) ? 0 : 3;
+    const int offsetNext = (packing == PackingOrder::YUV || packing == PackingOrder::YVU ? 3 : 4);
+
+    for (std::size_t i = 0; i < planes.Y.size(); i++)
+    {
+      writer.write(i * offsetNext + oY, planes.Y[i]);
+      writer.write(i * offsetNext + oU, planes.U[i]);
+      writer.write(i * offsetNext + oV, planes.V[i]);
+      if (offsetNext == 4)
+        writer.write(i * offsetNext + oA, planes.A[i]);
+    }
+  }
+}
+
+} // namespace
+
+bool canConvertARGBToYUV(const PixelFormatYUV &format, const Size frameSize, std::string *whyNot)
+{
+  auto setReason = [whyNot](const std::string &reason) {
+    if (whyNot)
+      *whyNot = reason;
+    return false;
+  };
+
+  if (!format.isValid())
+    return setReason("The YUV format is not valid.");
+  if (format.getPredefinedFormat())
+    return setReason("Writing predefined YUV formats is not supported.");
+  if (!format.isPlanar() && format.isBytePacking())
+    return setReason("Writing packed YUV formats with byte packing is not supported.");
+  if (format.getBitsPerSample() < 8 || format.getBitsPerSample() > 16)
+    return setReason("Only bit depths from 8 to 16 bit are supported.");
+  if (format.isPlanar() && format.isUVInterleaved() && format.hasAlpha())
+    return setReason("Writing interleaved UV planes with alpha is not supported.");
+  if (!frameSize.isValid() || frameSize.width % format.getSubsamplingHor() != 0 ||
+      frameSize.height % format.getSubsamplingVer() != 0)
+    return setReason("The frame size must be divisible by the chroma subsampling.");
+  return true;
+}
+
+QByteArray convertARGBToYUV(const unsigned char  *argbData,
+                            const int             bytesPerLine,
+                            const Size            frameSize,
+                            const PixelFormatYUV &format,
+                            const ColorConversion colorConversion)
+{
+  if (argbData == nullptr || !canConvertARGBToYUV(format, frameSize))
+    return {};
+
+  const auto planes =
+      convertToComponentPlanes(argbData, bytesPerLine, frameSize, format, colorConversion);
+
+  QByteArray target;
+  target.resize(static_cast<int>(format.bytesPerFrame(frameSize)));
+  if (format.isPlanar())
+    writePlanar(planes, format, target);
+  else
+    writePacked(planes, format, target);
+  return target;
+}
+
+} // namespace video::yuv
@@ -0,0 +1,60 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+#include <string>
+
+namespace video::yuv
+{
+
+// Can convertARGBToYUV write the given format? Byte packing and predefined formats (V210) are not
+// supported. The frame size must be divisible by the chroma subsampling.
+bool canConvertARGBToYUV(const PixelFormatYUV &format,
+                         const Size            frameSize,
+                         std::string          *whyNot = nullptr);
+
+// Convert 8 bit ARGB data (one 32 bit 0xAARRGGBB value per pixel in native byte order like in a
+// QImage::Format_ARGB32) to raw YUV data in the given format using the given color conversion.
+// The chroma components are downsampled by averaging all pixels that a chroma sample covers.
+// Returns an empty array if the format is not supported.
+QByteArray convertARGBToYUV(const unsigned char  *argbData,
+                            const int             bytesPerLine,
+                            const Size            frameSize,
+                            const PixelFormatYUV &format,
+                            const ColorConversion colorConversion);
+
+} // namespace video::yuv
@@ -100,6 +100,11 @@ public:
   }
   // Do we need to apply any transform to the raw YUV data before conversion to RGB?
   bool mathRequired() const { return scale != 1 || invert; }
+  bool operator==(const MathParameters &other) const
+  {
+    return this->scale == other.scale && this->offset == other.offset &&
+           this->invert == other.invert;
+  }
 
   int  scale{1};
   int  offset{128};
@@ -0,0 +1,385 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PixelFormatYUVDetection.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+#include <QtConcurrent>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+// The number of luma rows per frame that are compared for each candidate
+constexpr int NR_SAMPLED_ROWS = 16;
+
+// The width is detected from the beginning of the data
+constexpr int64_t WIDTH_DETECTION_BYTES  = 1 << 20;
+constexpr int     NR_COMPARISONS_PER_LAG = 4096;
+// A shift is a width candidate if the difference is below this fraction of the median difference
+constexpr double WIDTH_DIFFERENCE_RATIO = 0.5;
+
+constexpr int MIN_WIDTH  = 16;
+constexpr int MAX_WIDTH  = 8192;
+constexpr int MIN_HEIGHT = 16;
+constexpr int MAX_HEIGHT = 4320;
+
+// The difference of the compared rows is normalized by the variance of the samples. Formats with a
+// higher normalized difference are rejected.
+constexpr double MAX_NORMALIZED_DIFFERENCE = 0.2;
+// Candidates with a normalized difference close to the best one are considered equally good. From
+// these, the one with the smallest frame is selected (a frame size that is a multiple of the real
+// frame size also compares identical frames).
+constexpr double EQUIVALENT_DIFFERENCE_FACTOR = 1.5;
+constexpr double EQUIVALENT_DIFFERENCE_OFFSET = 0.01;
+
+const auto CommonFrameSizes = std::vector<Size>({Size(176, 144),
+                                                 Size(352, 240),
+                                                 Size(352, 288),
+                                                 Size(480, 480),
+                                                 Size(480, 576),
+                                                 Size(704, 480),
+                                                 Size(720, 480),
+                                                 Size(704, 576),
+                                                 Size(720, 576),
+                                                 Size(1024, 768),
+                                                 Size(1280, 720),
+                                                 Size(1280, 960),
+                                                 Size(1920, 1072),
+                                                 Size(1920, 1080)});
+
+// Some formats have the same frame size in bytes (e.g. 4:2:2 1920x1080 and 4:2:0 1920x1440). These
+// can not be distinguished by comparing frames. Prefer common sizes and subsamplings in this order.
+const auto SubsamplingsByPrevalence = std::vector<Subsampling>({Subsampling::YUV_420,
+                                                                Subsampling::YUV_422,
+                                                                Subsampling::YUV_444,
+                                                                Subsampling::YUV_400,
+                                                                Subsampling::YUV_440,
+                                                                Subsampling::YUV_411,
+                                                                Subsampling::YUV_410});
+
+// If the file size is not known, these aspect ratios (height / width) are tested for the detected
+// width.
+const auto CommonAspectRatios =
+    std::vector<std::pair<int, int>>({{9, 16}, {3, 4}, {10, 16}, {1, 1}});
+
+struct Candidate
+{
+  Size        frameSize;
+  Subsampling subsampling{};
+  int         bytesPerSample{};
+  int64_t     bytesPerFrame{};
+  bool        isCommonSize{};
+  bool        hasDetectedWidth{};
+
+  // Filled by evaluateCandidate
+  double normalizedDifference{std::numeric_limits<double>::max()};
+  int    bitDepth{};
+};
+
+// The sampled rows of the first frame followed by the same rows of the second frame
+std::vector<ByteRange> getSampledRows(const Candidate &candidate)
+{
+  const auto rowBytes    = int64_t(candidate.frameSize.width) * candidate.bytesPerSample;
+  const auto nrRows      = std::min(NR_SAMPLED_ROWS, int(candidate.frameSize.height));
+  const auto lastRowIdx  = int64_t(candidate.frameSize.height) - 1;
+  const auto denominator = std::max(nrRows - 1, 1);
+
+  std::vector<ByteRange> rows;
+  for (const auto frameStart : {int64_t(0), candidate.bytesPerFrame})
+    for (int i = 0; i < nrRows; i++)
+      rows.push_back({frameStart + (i * lastRowIdx / denominator) * rowBytes, rowBytes});
+  return rows;
+}
+
+void evaluateCandidate(Candidate &candidate, const SampledRawData &sampledData)
+{
+  const auto rows         = getSampledRows(candidate);
+  const auto nrRowsFrame  = rows.size() / 2;
+  const auto samplesInRow = int64_t(candidate.frameSize.width);
+
+  double  sum{};
+  double  sumSquares{};
+  double  sumSquaredDifferences{};
+  int64_t nrSamples{};
+  int     maxValue{};
+  for (size_t i = 0; i < nrRowsFrame; i++)
+  {
+    const auto row0 = sampledData.getData(rows[i]);
+    const auto row1 = sampledData.getData(rows[i + nrRowsFrame]);
+    if (row0 == nullptr || row1 == nullptr)
+      return;
+
+    for (int64_t x = 0; x < samplesInRow; x++)
+    {
+      const auto value0     = getSample(row0, candidate.bytesPerSample, x);
+      const auto value1     = getSample(row1, candidate.bytesPerSample, x);
+      const auto difference = double(value0 - value1);
+      sum += value0;
+      sumSquares += double(value0) * value0;
+      sumSquaredDifferences += difference * difference;
+      maxValue = std::max(maxValue, std::max(value0, value1));
+    }
+    nrSamples += samplesInRow;
+  }
+  if (nrSamples == 0)
+    return;
+
+  const auto mean     = sum / nrSamples;
+  const auto variance = sumSquares / nrSamples - mean * mean;
+  const auto mse      = sumSquaredDifferences / nrSamples;
+  if (variance > 0)
+    candidate.normalizedDifference = mse / (2 * variance);
+  else if (mse == 0)
+    candidate.normalizedDifference = 0;
+
+  if (candidate.bytesPerSample == 1)
+    candidate.bitDepth = 8;
+  else
+    candidate.bitDepth = (maxValue < 1024) ? 10 : (maxValue < 4096) ? 12 : 16;
+}
+
+// For candidates that compare equally well, prefer high bit depths that use only part of the 16 bit
+// (10 or 12 bit) over 8 bit over 16 bit. Interpreting 8 bit data as 16 bit (or the other way
+// around) with half (double) the width gives the same frame size in bytes.
+int getBitDepthPriority(const int bitDepth)
+{
+  if (bitDepth == 10 || bitDepth == 12)
+    return 0;
+  if (bitDepth == 8)
+    return 1;
+  return 2;
+}
+
+std::vector<int> getHeightCandidates(const int                     width,
+                                     const Subsampling             subsampling,
+                                     const int                     bytesPerSample,
+                                     const std::optional<int64_t> &fileSize)
+{
+  const PixelFormatYUV format(subsampling, bytesPerSample * 8, PlaneOrder::YUV);
+  const auto           heightStep = format.getSubsamplingVer();
+
+  std::vector<int> heights;
+  if (fileSize)
+  {
+    for (int height = MIN_HEIGHT; height <= MAX_HEIGHT; height += heightStep)
+    {
+      const auto bytesPerFrame = format.bytesPerFrame(Size(width, height));
+      if (bytesPerFrame * 2 > *fileSize)
+        break;
+      if (*fileSize % bytesPerFrame == 0)
+        heights.push_back(height);
+    }
+    return heights;
+  }
+
+  for (const auto &[num, den] : CommonAspectRatios)
+  {
+    const auto height = (width * num / den) / heightStep * heightStep;
+    if (height >= MIN_HEIGHT && height <= MAX_HEIGHT)
+      heights.push_back(height);
+  }
+  return heights;
+}
+
+std::vector<Candidate> getCandidates(const std::array<std::optional<int>, 2> &detectedWidths,
+                                     const std::optional<int64_t> &           fileSize)
+{
+  std::vector<Candidate> candidates;
+  auto                   addCandidate =
+      [&](const Size &size, const Subsampling subsampling, const int bytesPerSample) {
+        const PixelFormatYUV format(subsampling, bytesPerSample * 8, PlaneOrder::YUV);
+        if (size.width % format.getSubsamplingHor() != 0 ||
+            size.height % format.getSubsamplingVer() != 0)
+          return;
+
+        const auto bytesPerFrame = format.bytesPerFrame(size);
+        if (fileSize && (bytesPerFrame * 2 > *fileSize || *fileSize % bytesPerFrame != 0))
+          return;
+
+        Candidate candidate;
+        candidate.frameSize      = size;
+        candidate.subsampling    = subsampling;
+        candidate.bytesPerSample = bytesPerSample;
+        candidate.bytesPerFrame  = bytesPerFrame;
+        candidate.isCommonSize   = std::find(CommonFrameSizes.begin(),
+                                           CommonFrameSizes.end(),
+                                           size) != CommonFrameSizes.end();
+        candidate.hasDetectedWidth = (detectedWidths[bytesPerSample - 1] == int(size.width));
+        candidates.push_back(candidate);
+      };
+
+  for (const auto bytesPerSample : {1, 2})
+    for (const auto subsampling : SubsamplingsByPrevalence)
+    {
+      for (const auto &size : CommonFrameSizes)
+        addCandidate(size, subsampling, bytesPerSample);
+
+      if (const auto width = detectedWidths[bytesPerSample - 1])
+        for (const auto height : getHeightCandidates(*width, subsampling, bytesPerSample, fileSize))
+        {
+          const auto size = Size(*width, height);
+          if (std::find(CommonFrameSizes.begin(), CommonFrameSizes.end(), size) ==
+              CommonFrameSizes.end())
+            addCandidate(size, subsampling, bytesPerSample);
+        }
+    }
+  return candidates;
+}
+
+} // namespace
+
+std::optional<int> detectLumaWidth(const QByteArray &data, const int bytesPerSample)
+{
+  const auto samples   = reinterpret_cast<const unsigned char *>(data.constData());
+  const auto nrSamples = int64_t(data.size()) / bytesPerSample;
+  const auto maxLag    = int(std::min(int64_t(MAX_WIDTH), nrSamples / 4));
+  if (maxLag <= MIN_WIDTH)
+    return {};
+
+  // The mean absolute difference between each sample and the sample shifted by lag
+  std::vector<double> differences(maxLag + 2);
+  for (int lag = MIN_WIDTH - 1; lag <= maxLag + 1; lag++)
+  {
+    const auto nrComparisons = std::min(int64_t(NR_COMPARISONS_PER_LAG), nrSamples - lag);
+    const auto step          = (nrSamples - lag) / nrComparisons;
+    int64_t    sum{};
+    for (int64_t i = 0; i < nrComparisons; i++)
+    {
+      const auto pos = i * step;
+      sum += std::abs(getSample(samples, bytesPerSample, pos) -
+                      getSample(samples, bytesPerSample, pos + lag));
+    }
+    differences[lag] = double(sum) / nrComparisons;
+  }
+
+  auto sorted = std::vector<double>(differences.begin() + MIN_WIDTH, differences.end() - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+  const auto median = sorted[sorted.size() / 2];
+
+  for (int lag = MIN_WIDTH; lag <= maxLag; lag++)
+  {
+    const auto difference = differences[lag];
+    if (difference < median * WIDTH_DIFFERENCE_RATIO && difference <= differences[lag - 1] &&
+        difference <= differences[lag + 1])
+      return lag;
+  }
+  return {};
+}
+
+std::optional<DetectedFormat> detectFormatFromData(const ReadBytesFunction &    readBytes,
+                                                   const std::optional<int64_t> fileSize)
+{
+  std::array<std::optional<int>, 2> detectedWidths;
+  {
+    const auto data   = readBytes(0, WIDTH_DETECTION_BYTES);
+    detectedWidths[0] = detectLumaWidth(data, 1);
+    detectedWidths[1] = detectLumaWidth(data, 2);
+  }
+
+  auto candidates = getCandidates(detectedWidths, fileSize);
+  if (candidates.empty())
+    return {};
+
+  std::vector<ByteRange> rowsToRead;
+  for (const auto &candidate : candidates)
+  {
+    const auto rows = getSampledRows(candidate);
+    rowsToRead.insert(rowsToRead.end(), rows.begin(), rows.end());
+  }
+  const SampledRawData sampledData(readBytes, std::move(rowsToRead));
+
+  QtConcurrent::blockingMap(candidates, [&sampledData](Candidate &candidate) {
+    evaluateCandidate(candidate, sampledData);
+  });
+
+  const auto best = std::min_element(
+      candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.normalizedDifference < b.normalizedDifference;
+      });
+  if (best->normalizedDifference >= MAX_NORMALIZED_DIFFERENCE)
+    return {};
+
+  // A frame size in bytes that is a multiple of the real one also compares identical frames. So
+  // from the candidates that are about as good as the best one, use the smallest frame size in
+  // bytes.
+  const auto equivalentLimit =
+      std::max(best->normalizedDifference * EQUIVALENT_DIFFERENCE_FACTOR,
+               best->normalizedDifference + EQUIVALENT_DIFFERENCE_OFFSET);
+  auto bytesPerFrame = best->bytesPerFrame;
+  for (const auto &candidate : candidates)
+    if (candidate.normalizedDifference <= equivalentLimit &&
+        candidate.normalizedDifference < MAX_NORMALIZED_DIFFERENCE)
+      bytesPerFrame = std::min(bytesPerFrame, candidate.bytesPerFrame);
+
+  // All candidates with this frame size in bytes compare the same two frames. Select by bit depth,
+  // common sizes, the detected width and then the order of the candidates.
+  const auto getSelectionKey = [](const Candidate &c) {
+    return std::make_tuple(
+        getBitDepthPriority(c.bitDepth), c.isCommonSize ? 0 : 1, c.hasDetectedWidth ? 0 : 1);
+  };
+  std::optional<Candidate> selected;
+  for (const auto &candidate : candidates)
+    if (candidate.bytesPerFrame == bytesPerFrame &&
+        candidate.normalizedDifference < MAX_NORMALIZED_DIFFERENCE &&
+        (!selected || getSelectionKey(candidate) < getSelectionKey(*selected)))
+      selected = candidate;
+
+  // The confidence decreases if the two frames are not very similar or if there is another format
+  // (that is not just a multiple of the selected frame size) that is almost as good.
+  auto secondBestDifference = std::numeric_limits<double>::max();
+  for (const auto &candidate : candidates)
+    if (candidate.bytesPerFrame % selected->bytesPerFrame != 0)
+      secondBestDifference = std::min(secondBestDifference, candidate.normalizedDifference);
+
+  const auto quality    = 1.0 - selected->normalizedDifference / MAX_NORMALIZED_DIFFERENCE;
+  auto       separation = 1.0;
+  if (secondBestDifference <= 0)
+    separation = 0.0;
+  else if (secondBestDifference < std::numeric_limits<double>::max())
+    separation = 1.0 - selected->normalizedDifference / secondBestDifference;
+
+  DetectedFormat format;
+  format.pixelFormat = PixelFormatYUV(selected->subsampling, selected->bitDepth, PlaneOrder::YUV);
+  format.frameSize   = selected->frameSize;
+  format.confidence  = std::clamp(quality * separation, 0.0, 1.0);
+  return format;
+}
+
+} // namespace video::yuv
@@ -0,0 +1,71 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <QByteArray>
+
+#include <video/SampledRawData.h>
+
+#include "PixelFormatYUV.h"
+
+namespace video::yuv
+{
+
+struct DetectedFormat
+{
+  PixelFormatYUV pixelFormat;
+  Size           frameSize;
+  // How sure we are about the format (0 to 1). This considers how similar the first two frames are
+  // with this format and how much better the format is than the next best one.
+  double confidence{};
+};
+
+/* Detect the format (frame size, subsampling and bit depth) of raw planar YUV data.
+ * For every candidate format, a few sampled luma rows of the first two frames are compared. Only
+ * these rows are read. The candidates are evaluated in parallel and the format for which the two
+ * frames are the most similar is selected. Besides a list of common frame sizes, the width of the
+ * luma plane is detected from the data (detectLumaWidth) and frame sizes with this width are
+ * tested as well. If a file size is given, only formats for which the file size is a multiple of
+ * the frame size are tested.
+ */
+std::optional<DetectedFormat> detectFormatFromData(const ReadBytesFunction &    readBytes,
+                                                   const std::optional<int64_t> fileSize);
+
+// Detect the width of the luma plane from the autocorrelation of the samples. Each row is similar
+// to the row above, so the smallest horizontal shift for which the difference of the samples has a
+// distinct minimum is the width. Samples with 2 bytes are little endian.
+std::optional<int> detectLumaWidth(const QByteArray &data, const int bytesPerSample);
+
+} // namespace video::yuv
@@ -36,6 +36,7 @@
 #include <cmath>
 #include <cstdio>
 #include <iomanip>
+#include <optional>
 #include <sstream>
 #include <type_traits>
 #include <vector>
@@ -46,8 +47,12 @@
 #include <common/Formatting.h>
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <common/GlyphAtlas.h>
 #include <common/InfoItemAndData.h>
+#include <common/Tracing.h>
+#include <video/ImagePool.h>
 #include <video/LimitedRangeToFullRange.h>
+#include <video/yuv/PixelFormatYUVDetection.h>
 #include <video/yuv/PixelFormatYUVGuess.h>
 #include <video/yuv/videoHandlerYUVCustomFormatDialog.h>
 
@@ -98,22 +103,6 @@ void initClippingTable()
   clp_buf_initialized = true;
 }
 
-// Compute the MSE between the given char sources for numPixels bytes
-template <typename T> double computeMSE(T ptr, T ptr2, int numPixels)
-{
-  if (numPixels <= 0)
-    return 0.0;
-
-  uint64_t sad = 0;
-  for (int i = 0; i < numPixels; i++)
-  {
-    int diff = (int)ptr[i] - (int)ptr2[i];
-    sad += diff * diff;
-  }
-
-  return (double)sad / numPixels;
-}
-
 std::string formatMSEandPSNR(const double mse, const int bps_out)
 {
   const auto maxSquared = ((1 << bps_out) - 1) * ((1 << bps_out) - 1);
@@ -434,7 +423,7 @@ yuv_t getPixelValueV210(const QByteArray &sourceBuffer,
 template <int bitDepth>
 bool convertYUV420ToRGB(const QByteArray         &sourceBuffer,
                         unsigned char            *targetBuffer,
-                        const Size               &size,
+                        const Size                size,
                         const PixelFormatYUV     &format,
                         const ConversionSettings &conversionSettings)
 {
@@ -2278,115 +2267,151 @@ bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
   return true;
 }
 
-// Convert the given raw YUV data in sourceBuffer (using srcPixelFormat) to image (RGB-888), using
-// the buffer tmpRGBBuffer for intermediate RGB values.
-void convertYUVToImage(const QByteArray         &sourceBuffer,
-                       QImage                   &outputImage,
-                       const PixelFormatYUV     &yuvFormat,
-                       const Size               &curFrameSize,
-                       const ConversionSettings &conversionSettings)
+} // namespace
+
+/* The conversion of raw YUV data to an image for one pixel format, frame size and conversion
+ * settings. All decisions (which conversion function, which image format) are made once when the
+ * plan is created, so converting a frame is a call of the resolved conversion function.
+ * The output images are taken from the ImagePool. Images that are removed from the cache or
+ * replaced by the next frame are released to the pool so that their memory is reused.
+ */
+class ConversionPlan
 {
-  if (!yuvFormat.canConvertToRGB(curFrameSize) || sourceBuffer.isEmpty())
-  {
-    outputImage = QImage();
+public:
+  ConversionPlan(const PixelFormatYUV     &format,
+                 const Size                frameSize,
+                 const ConversionSettings &settings);
+
+  bool isFor(const PixelFormatYUV     &format,
+             const Size                frameSize,
+             const ConversionSettings &settings) const
+  {
+    return this->frameSize == frameSize && this->format == format && this->settings == settings;
+  }
+
+  // Convert the raw YUV data to an image (RGB-888). Returns a null image if conversion is not
+  // possible.
+  QImage convert(const QByteArray &sourceBuffer);
+
+private:
+  using PlanarConversionFunction = bool (*)(const QByteArray &,
+                                            unsigned char *,
+                                            const Size,
+                                            const PixelFormatYUV &,
+                                            const ConversionSettings &);
+  using PackedToPlanarFunction   = std::pair<bool, PixelFormatYUV> (*)(const QByteArray &,
+                                                                     QByteArray &,
+                                                                     const Size,
+                                                                     const PixelFormatYUV &);
+
+  const PixelFormatYUV     format;
+  const Size               frameSize;
+  const ConversionSettings settings;
+
+  bool                     canConvert{};
+  PackedToPlanarFunction   packedToPlanar{};
+  PlanarConversionFunction planarConversion{};
+  QImage::Format           imageFormat{QImage::Format_RGB32};
+  // On linux, the image may have to be converted to the platform image format afterwards
+  std::optional<QImage::Format> platformImageFormat;
+};
+
+ConversionPlan::ConversionPlan(const PixelFormatYUV     &format,
+                               const Size                frameSize,
+                               const ConversionSettings &settings)
+    : format(format), frameSize(frameSize), settings(settings)
+{
+  this->canConvert = format.canConvertToRGB(frameSize);
+  if (!this->canConvert)
     return;
-  }
-
-  DEBUG_YUV("videoHandlerYUV::convertYUVToImage");
 
   // Create the output image in the right format.
   // In both cases, we will set the alpha channel to 255. The format of the raw buffer is: BGRA
   // (each 8 bit). Internally, this is how QImage allocates the number of bytes per line (with depth
   // = 32): const int bytes_per_line = ((width * depth + 31) >> 5) << 2; // bytes per scanline (must
   // be multiple of 4)
-  auto qFrameSize          = QSize(int(curFrameSize.width), int(curFrameSize.height));
-  auto platformImageFormat = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
-  if (is_Q_OS_WIN || is_Q_OS_MAC)
-    outputImage = QImage(qFrameSize, platformImageFormat);
-  else if (is_Q_OS_LINUX)
+  const auto platformFormat = functionsGui::platformImageFormat(format.hasAlpha());
+  if (is_Q_OS_WIN || is_Q_OS_MAC || platformFormat == QImage::Format_ARGB32_Premultiplied ||
+      platformFormat == QImage::Format_ARGB32)
+    this->imageFormat = platformFormat;
+  else if (platformFormat != QImage::Format_RGB32)
+    this->platformImageFormat = platformFormat;
+
+  if (format.isPlanar())
   {
-    if (platformImageFormat == QImage::Format_ARGB32_Premultiplied ||
-        platformImageFormat == QImage::Format_ARGB32)
-      outputImage = QImage(qFrameSize, platformImageFormat);
+    // 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
+    // displayed and no yuv math. We can use a specialized function for this.
+    const auto useSpecialized420 =
+        (format.getBitsPerSample() == 8 || format.getBitsPerSample() == 10) &&
+        format.getSubsampling() == Subsampling::YUV_420 &&
+        settings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
+        format.getChromaOffset().x == 0 && format.getChromaOffset().y == 1 &&
+        settings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
+        !format.isUVInterleaved() && !settings.mathParameters.at(Component::Luma).mathRequired() &&
+        !settings.mathParameters.at(Component::Chroma).mathRequired();
+
+    if (useSpecialized420 && format.getBitsPerSample() == 8)
+      this->planarConversion = convertYUV420ToRGB<8>;
+    else if (useSpecialized420)
+      this->planarConversion = convertYUV420ToRGB<10>;
     else
-      outputImage = QImage(qFrameSize, QImage::Format_RGB32);
+      this->planarConversion = convertYUVPlanarToRGB;
+    return;
   }
 
-  // Check the image buffer size before we write to it
-#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
-  assert(functions::clipToUnsigned(outputImage.byteCount()) >=
-         curFrameSize.width * curFrameSize.height * 4);
-#else
-  assert(functions::clipToUnsigned(outputImage.sizeInBytes()) >=
-         curFrameSize.width * curFrameSize.height * 4);
-#endif
-
-  auto convOK = false;
-  if (yuvFormat.isPlanar())
+  // Packed formats are converted to a planar format first
+  this->planarConversion = convertYUVPlanarToRGB;
+  if (auto predefinedFormat = format.getPredefinedFormat())
   {
-    if ((yuvFormat.getBitsPerSample() == 8 || yuvFormat.getBitsPerSample() == 10) &&
-        yuvFormat.getSubsampling() == Subsampling::YUV_420 &&
-        conversionSettings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
-        yuvFormat.getChromaOffset().x == 0 && yuvFormat.getChromaOffset().y == 1 &&
-        conversionSettings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
-        !yuvFormat.isUVInterleaved() &&
-        !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
-        !conversionSettings.mathParameters.at(Component::Chroma).mathRequired())
-    // 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
-    // displayed and no yuv math. We can use a specialized function for this.
-    {
-      if (yuvFormat.getBitsPerSample() == 8)
-        convOK = convertYUV420ToRGB<8>(
-            sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
-      else if (yuvFormat.getBitsPerSample() == 10)
-        convOK = convertYUV420ToRGB<10>(
-            sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
-    }
+    if (*predefinedFormat == PredefinedPixelFormat::V210)
+      this->packedToPlanar = [](const QByteArray &sourceBuffer,
+                                QByteArray       &targetBuffer,
+                                const Size        curFrameSize,
+                                const PixelFormatYUV &) {
+        return convertV210PackedToPlanar(sourceBuffer, targetBuffer, curFrameSize);
+      };
     else
-      convOK = convertYUVPlanarToRGB(
-          sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
+      this->canConvert = false;
   }
   else
-  {
-    // Convert to a planar format first
-    QByteArray tmpPlanarYUVSource;
-    // This is the current format of the buffer. The conversion function will change this.
-    PixelFormatYUV newPixelFormat;
+    this->packedToPlanar = convertYUVPackedToPlanar;
+}
 
-    if (auto predefinedFormat = yuvFormat.getPredefinedFormat())
-    {
-      if (*predefinedFormat == PredefinedPixelFormat::V210)
-        std::tie(convOK, newPixelFormat) =
-            convertV210PackedToPlanar(sourceBuffer, tmpPlanarYUVSource, curFrameSize);
-      else
-        convOK = false;
-    }
-    else
-      std::tie(convOK, newPixelFormat) =
-          convertYUVPackedToPlanar(sourceBuffer, tmpPlanarYUVSource, curFrameSize, yuvFormat);
+QImage ConversionPlan::convert(const QByteArray &sourceBuffer)
+{
+  if (!this->canConvert || sourceBuffer.isEmpty())
+    return {};
+
+  DEBUG_YUV("ConversionPlan::convert");
 
+  auto image  = ImagePool::instance().acquire(
+      QSize(int(this->frameSize.width), int(this->frameSize.height)), this->imageFormat);
+  auto convOK = false;
+  if (this->packedToPlanar)
+  {
+    QByteArray     tmpPlanarYUVSource;
+    PixelFormatYUV planarFormat;
+    std::tie(convOK, planarFormat) =
+        this->packedToPlanar(sourceBuffer, tmpPlanarYUVSource, this->frameSize, this->format);
     if (convOK)
-      convOK &= convertYUVPlanarToRGB(
-          tmpPlanarYUVSource, outputImage.bits(), curFrameSize, newPixelFormat, conversionSettings);
+      convOK = this->planarConversion(
+          tmpPlanarYUVSource, image.bits(), this->frameSize, planarFormat, this->settings);
   }
+  else
+    convOK = this->planarConversion(
+        sourceBuffer, image.bits(), this->frameSize, this->format, this->settings);
 
   assert(convOK);
 
-  if (is_Q_OS_LINUX)
+  if (this->platformImageFormat)
   {
-    // On linux, we may have to convert the image to the platform image format if it is not one of
-    // the RGBA formats.
-    auto format = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
-    if (format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_ARGB32 &&
-        format != QImage::Format_RGB32)
-      outputImage = outputImage.convertToFormat(format);
+    auto platformImage = image.convertToFormat(*this->platformImageFormat);
+    ImagePool::instance().release(image);
+    return platformImage;
   }
-
-  DEBUG_YUV("videoHandlerYUV::convertYUVToImage Done");
+  return image;
 }
 
-} // namespace
-
 std::vector<PixelFormatYUV> videoHandlerYUV::formatPresetList = {
     PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV),
     PixelFormatYUV(Subsampling::YUV_420, 10, PlaneOrder::YUV),
@@ -2923,6 +2948,8 @@ void videoHandlerYUV::drawPixelValues(QPainter     *painter,
 
   const auto mathParameters = this->conversionSettings.mathParameters;
 
+  const int  formatBase = settings.value("ShowPixelValuesHex").toBool() ? 16 : 10;
+  GlyphBatch glyphBatch(painter);
   for (int x = xMin; x <= xMax; x++)
   {
     for (int y = yMin; y <= yMax; y++)
@@ -2983,10 +3010,9 @@ void videoHandlerYUV::drawPixelValues(QPainter     *painter,
             (mathParameters.at(Component::Luma).invert) ? (Y > whiteLimit) : (Y < whiteLimit);
       }
 
-      const int     formatBase = settings.value("ShowPixelValuesHex").toBool() ? 16 : 10;
-      const QString YString    = ((Y < 0) ? "-" : "") + QString::number(std::abs(Y), formatBase);
-      const QString UString    = ((U < 0) ? "-" : "") + QString::number(std::abs(U), formatBase);
-      const QString VString    = ((V < 0) ? "-" : "") + QString::number(std::abs(V), formatBase);
+      const QString YString = ((Y < 0) ? "-" : "") + QString::number(std::abs(Y), formatBase);
+      const QString UString = ((U < 0) ? "-" : "") + QString::number(std::abs(U), formatBase);
+      const QString VString = ((V < 0) ? "-" : "") + QString::number(std::abs(V), formatBase);
 
       painter->setPen(drawWhite ? Qt::white : Qt::black);
 
@@ -3000,7 +3026,7 @@ void videoHandlerYUV::drawPixelValues(QPainter     *painter,
         else
           // We also draw the U and V value at this position
           valText = QString("Y%1\nU%2\nV%3").arg(YString, UString, VString);
-        painter->drawText(pixelRect, Qt::AlignCenter, valText);
+        glyphBatch.drawText(pixelRect, Qt::AlignCenter, valText);
 
         if (chromaOffsetHalfX || chromaOffsetHalfY)
         {
@@ -3013,19 +3039,20 @@ void videoHandlerYUV::drawPixelValues(QPainter     *painter,
           if (chromaOffsetHalfY)
             pixelRect.translate(0, zoomFactor / 2);
 
-          painter->drawText(pixelRect, Qt::AlignCenter, valText);
+          glyphBatch.drawText(pixelRect, Qt::AlignCenter, valText);
         }
       }
       else
       {
         // We only draw the luma value for this pixel
         QString valText = QString("Y%1").arg(YString);
-        painter->drawText(pixelRect, Qt::AlignCenter, valText);
+        glyphBatch.drawText(pixelRect, Qt::AlignCenter, valText);
       }
     }
   }
 
-  // Reset pen
+  // Draw all values before the pen is reset
+  glyphBatch.flush();
   painter->setPen(backupPen);
 }
 
@@ -3040,131 +3067,28 @@ void videoHandlerYUV::guessAndSetPixelFormat(
     this->setSrcPixelFormat(PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV));
 }
 
-/** Try to guess the format of the raw YUV data. A list of candidates is tried (candidateModes) and
- * it is checked if the file size matches and if the correlation of the first two frames is below a
- * threshold. radData must contain at least two frames of the video sequence. Only formats that two
- * frames of could fit into rawData are tested. E.g. the biggest format that is tested here is 1080p
- * YUV 4:2:2 8 bit which is 4147200 bytes per frame. So make sure rawData contains 8294400 bytes so
- * that all formats are tested. If a file size is given, we test if the candidates frame size is a
- * multiple of the fileSize. If fileSize is -1, this test is skipped.
+/** Try to guess the format of the raw YUV data. See detectFormatFromData for how this is done.
+ * Only sampled rows of the first two frames are read. If a file size is given, only formats where
+ * the file size is a multiple of the frame size are tested. If fileSize is -1, this test is
+ * skipped.
  */
-void videoHandlerYUV::setFormatFromCorrelation(const QByteArray &rawYUVData, int64_t fileSize)
+std::optional<double> videoHandlerYUV::setFormatFromCorrelation(
+    const std::function<QByteArray(int64_t, int64_t)> &readBytes, int64_t fileSize)
 {
-  if (rawYUVData.size() < 1)
-    return;
-
-  class testFormatAndSize
-  {
-  public:
-    testFormatAndSize(const Size &size, PixelFormatYUV format) : size(size), format(format)
-    {
-      interesting = false;
-      mse         = 0;
-    }
-    Size           size;
-    PixelFormatYUV format;
-    bool           interesting;
-    double         mse;
-  };
-
-  // The candidates for the size
-  const auto testSizes = std::vector<Size>({Size(176, 144),
-                                            Size(352, 240),
-                                            Size(352, 288),
-                                            Size(480, 480),
-                                            Size(480, 576),
-                                            Size(704, 480),
-                                            Size(720, 480),
-                                            Size(704, 576),
-                                            Size(720, 576),
-                                            Size(1024, 768),
-                                            Size(1280, 720),
-                                            Size(1280, 960),
-                                            Size(1920, 1072),
-                                            Size(1920, 1080)});
-
-  // Test bit depths 8, 10 and 16
-  std::vector<testFormatAndSize> formatList;
-  for (int b = 0; b < 3; b++)
-  {
-    int bits = (b == 0) ? 8 : (b == 1) ? 10 : 16;
-    // Test all subsampling modes
-    for (const auto &subsampling : SubsamplingMapper.getValues())
-      for (const auto &size : testSizes)
-        formatList.push_back(
-            testFormatAndSize(size, PixelFormatYUV(subsampling, bits, PlaneOrder::YUV)));
-  }
-
+  std::optional<int64_t> size;
   if (fileSize > 0)
-  {
-    // if any candidate exceeds file size for two frames, discard
-    // if any candidate does not represent a multiple of file size, discard
-    bool fileSizeMatchFound = false;
+    size = fileSize;
 
-    for (testFormatAndSize &testFormat : formatList)
-    {
-      auto picSize = testFormat.format.bytesPerFrame(testFormat.size);
-
-      const bool atLeastTwoPictureInInput = fileSize >= (picSize * 2);
-      if (atLeastTwoPictureInInput)
-      {
-        if ((fileSize % picSize) == 0) // important: file size must be multiple of the picture size
-        {
-          testFormat.interesting = true;
-          fileSizeMatchFound     = true;
-        }
-      }
-    }
-
-    if (!fileSizeMatchFound)
-      return;
-  }
-
-  // calculate max. correlation for first two frames, use max. candidate frame size
-  for (testFormatAndSize &testFormat : formatList)
-  {
-    if (testFormat.interesting)
-    {
-      auto picSize     = testFormat.format.bytesPerFrame(testFormat.size);
-      int  lumaSamples = testFormat.size.width * testFormat.size.height;
-
-      // Calculate the MSE for 2 frames
-      if (testFormat.format.getBitsPerSample() == 8)
-      {
-        auto ptr       = (unsigned char *)rawYUVData.data();
-        testFormat.mse = computeMSE(ptr, ptr + picSize, lumaSamples);
-      }
-      else if (testFormat.format.getBitsPerSample() > 8 &&
-               testFormat.format.getBitsPerSample() <= 16)
-      {
-        auto ptr       = (unsigned short *)rawYUVData.data();
-        testFormat.mse = computeMSE(ptr, ptr + picSize / 2, lumaSamples);
-      }
-      else
-        continue;
-    }
-  }
-
-  // step3: select best candidate
-  double         leastMSE = std::numeric_limits<double>::max();
-  PixelFormatYUV bestFormat;
-  Size           bestSize;
-  for (const testFormatAndSize &testFormat : formatList)
-  {
-    if (testFormat.interesting && testFormat.mse < leastMSE)
-    {
-      bestFormat = testFormat.format;
-      bestSize   = testFormat.size;
-      leastMSE   = testFormat.mse;
-    }
-  }
+  const auto detectedFormat = detectFormatFromData(readBytes, size);
+  if (!detectedFormat)
+    return {};
 
-  const double mseThreshold = 400;
-  if (leastMSE < mseThreshold)
-  {
-    setSrcPixelFormat(bestFormat, false);
-    setFrameSize(bestSize);
-  }
+  DEBUG_YUV("videoHandlerYUV::setFormatFromCorrelation detected "
+            << detectedFormat->pixelFormat.getName().c_str() << " confidence "
+            << detectedFormat->confidence);
+  this->setSrcPixelFormat(detectedFormat->pixelFormat, false);
+  this->setFrameSize(detectedFormat->frameSize);
+  return detectedFormat->confidence;
 }
 
 bool videoHandlerYUV::setFormatFromString(QString format)
@@ -3201,27 +3125,18 @@ void videoHandlerYUV::loadFrame(int frameIndex, bool loadToDoubleBuffer)
 
   // The data in currentFrameRawData is now up to date. If necessary
   // convert the data to RGB.
+  TRACE_SCOPE("conversion", "videoHandlerYUV::convert", frameIndex);
+  const auto conversionPlan =
+      this->getConversionPlan(this->srcPixelFormat, this->frameSize, this->conversionSettings);
   if (loadToDoubleBuffer)
   {
-    QImage newImage;
-    convertYUVToImage(this->currentFrameRawData,
-                      newImage,
-                      this->srcPixelFormat,
-                      this->frameSize,
-                      this->conversionSettings);
-    doubleBufferImage           = newImage;
-    doubleBufferImageFrameIndex = frameIndex;
+    this->renderAheadQueue.push(frameIndex, conversionPlan->convert(this->currentFrameRawData));
   }
   else if (currentImageIndex != frameIndex)
   {
-    QImage newImage;
-    convertYUVToImage(this->currentFrameRawData,
-                      newImage,
-                      this->srcPixelFormat,
-                      this->frameSize,
-                      this->conversionSettings);
+    auto         newImage = conversionPlan->convert(this->currentFrameRawData);
     QMutexLocker setLock(&currentImageSetMutex);
-    currentImage      = newImage;
+    ImagePool::instance().replace(currentImage, newImage);
     currentImageIndex = frameIndex;
   }
 }
@@ -3236,12 +3151,10 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   const auto curFrameSize       = this->frameSize;
   const auto conversionSettings = this->conversionSettings;
 
-  requestDataMutex.lock();
-  emit       signalRequestRawData(frameIndex, true);
-  QByteArray tmpBufferRawYUVDataCaching = rawData;
-  requestDataMutex.unlock();
-
-  if (frameIndex != rawData_frameIndex)
+  // Every caching thread reads into its own buffer. With a concurrent reader, multiple frames are
+  // read and converted at the same time.
+  const auto rawYUVData = this->requestRawDataForCaching(frameIndex);
+  if (rawYUVData.isEmpty())
   {
     // Loading failed
     DEBUG_YUV("videoHandlerYUV::loadFrameForCaching Loading failed");
@@ -3249,8 +3162,30 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   }
 
   // Convert YUV to image. This can then be cached.
-  convertYUVToImage(
-      tmpBufferRawYUVDataCaching, frameToCache, yuvFormat, curFrameSize, conversionSettings);
+  TRACE_SCOPE("conversion", "videoHandlerYUV::convert", frameIndex);
+  frameToCache = this->getConversionPlan(yuvFormat, curFrameSize, conversionSettings)
+                     ->convert(rawYUVData);
+}
+
+std::shared_ptr<ConversionPlan>
+videoHandlerYUV::getConversionPlan(const PixelFormatYUV     &format,
+                                   const Size                frameSize,
+                                   const ConversionSettings &settings)
+{
+  QMutexLocker lock(&this->conversionPlanMutex);
+  if (!this->conversionPlan || !this->conversionPlan->isFor(format, frameSize, settings))
+    this->conversionPlan = std::make_shared<ConversionPlan>(format, frameSize, settings);
+  return this->conversionPlan;
+}
+
+std::optional<QByteArray> videoHandlerYUV::loadRawYUVDataForExport(int frameIndex)
+{
+  DEBUG_YUV("videoHandlerYUV::loadRawYUVDataForExport " << frameIndex);
+
+  auto rawYUVData = this->requestRawDataForCaching(frameIndex);
+  if (rawYUVData.isEmpty())
+    return {};
+  return rawYUVData;
 }
 
 // Load the raw YUV data for the given frame index into currentFrameRawData.
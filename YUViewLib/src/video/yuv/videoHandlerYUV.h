@@ -39,6 +39,7 @@
 #include "ui_videoHandlerYUV.h"
 
 #include <map>
+#include <memory>
 
 namespace video::yuv
 {
@@ -70,8 +71,19 @@ struct ConversionSettings
   // Parameters for the YUV transformation (like scaling, invert, offset). For Luma ([0]) and
   // chroma([1]).
   std::map<Component, MathParameters> mathParameters;
+
+  bool operator==(const ConversionSettings &other) const
+  {
+    return this->chromaInterpolation == other.chromaInterpolation &&
+           this->componentDisplayMode == other.componentDisplayMode &&
+           this->colorConversion == other.colorConversion &&
+           this->mathParameters == other.mathParameters;
+  }
 };
 
+// The resolved conversion of raw YUV data to an image (see videoHandlerYUV.cpp)
+class ConversionPlan;
+
 /** The videoHandlerYUV can be used in any playlistItem to read/display YUV data. A playlistItem
  * could even provide multiple YUV videos. A videoHandlerYUV supports handling of YUV data and can
  * return a specific frame as a image by calling getOneFrame. All conversions from the various YUV
@@ -130,8 +142,9 @@ public:
 
   // Try to guess and set the format (frameSize/srcPixelFormat) from the raw YUV data.
   // If a file size is given, it is tested if the YUV format and the file size match.
-  virtual void setFormatFromCorrelation(const QByteArray &rawYUVData,
-                                        int64_t           fileSize = -1) override;
+  virtual std::optional<double>
+  setFormatFromCorrelation(const std::function<QByteArray(int64_t, int64_t)> &readBytes,
+                           int64_t fileSize = -1) override;
 
   virtual QString getFormatAsString() const override
   {
@@ -150,6 +163,11 @@ public:
   {
     return QString::fromStdString(srcPixelFormat.getName());
   }
+  PixelFormatYUV getPixelFormatYUV() const { return this->srcPixelFormat; }
+
+  // Get the raw YUV data (in the current pixel format) of the given frame without touching the
+  // buffers of the frame on screen. Like loadFrameForExport, this uses the caching path.
+  std::optional<QByteArray> loadRawYUVDataForExport(int frameIndex);
   // Set the current YUV format and update the control. Only emit a signalHandlerChanged signal
   // if emitSignal is true.
   virtual void setPixelFormatYUV(const PixelFormatYUV &fmt, bool emitSignal = false);
@@ -219,6 +237,14 @@ private:
   bool setFormatFromSizeAndNamePacked(
       QString name, const Size size, int bitDepth, Subsampling subsampling, int64_t fileSize);
 
+  // The conversion to an image is resolved once for a pixel format, frame size and conversion
+  // settings. The plan is reused for all frames until one of these changes.
+  std::shared_ptr<ConversionPlan> getConversionPlan(const PixelFormatYUV     &format,
+                                                    const Size                frameSize,
+                                                    const ConversionSettings &settings);
+  std::shared_ptr<ConversionPlan> conversionPlan;
+  QMutex                          conversionPlanMutex;
+
   bool markDifferencesYUVPlanarToRGB(const QByteArray     &sourceBuffer,
                                      unsigned char        *targetBuffer,
                                      const Size            frameSize,
@@ -1,4 +1,4 @@
-QT += core xml 
+QT += core xml widgets concurrent
 
 TARGET = YUViewUnitTest
 TEMPLATE = app
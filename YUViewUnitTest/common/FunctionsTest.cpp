@@ -34,6 +34,8 @@
 
 #include <common/Functions.h>
 
+#include <sstream>
+
 namespace
 {
 
@@ -67,4 +69,32 @@ TEST(FunctionsTest, toInt)
   EXPECT_FALSE(functions::toInt("NotANumber"));
 }
 
+TEST(FunctionsTest, parseMemAvailableFromMeminfo)
+{
+  std::istringstream meminfo("MemTotal:       32768000 kB\n"
+                             "MemFree:         1024000 kB\n"
+                             "MemAvailable:    2048000 kB\n"
+                             "Buffers:          512000 kB\n");
+  EXPECT_EQ(functions::parseMemAvailableFromMeminfo(meminfo), int64_t(2048000) * 1024);
+
+  std::istringstream meminfoWithoutAvailable("MemTotal:       32768000 kB\n"
+                                             "MemFree:         1024000 kB\n");
+  EXPECT_FALSE(functions::parseMemAvailableFromMeminfo(meminfoWithoutAvailable));
+}
+
+TEST(FunctionsTest, parseCGroupMemoryValue)
+{
+  std::istringstream limit("1073741824\n");
+  EXPECT_EQ(functions::parseCGroupMemoryValue(limit), 1073741824);
+
+  std::istringstream noLimitV2("max\n");
+  EXPECT_FALSE(functions::parseCGroupMemoryValue(noLimitV2));
+
+  std::istringstream noLimitV1("9223372036854771712\n");
+  EXPECT_FALSE(functions::parseCGroupMemoryValue(noLimitV1));
+
+  std::istringstream empty("");
+  EXPECT_FALSE(functions::parseCGroupMemoryValue(empty));
+}
+
 } // namespace
@@ -0,0 +1,101 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <common/MemoryAccountant.h>
+
+namespace
+{
+
+int64_t getUsageOfCategory(const std::string &category)
+{
+  for (const auto &usage : MemoryAccountant::instance().getUsagePerCategory())
+    if (usage.category == category)
+      return usage.bytes;
+  return 0;
+}
+
+TEST(MemoryAccountantTest, UsageIsSummedPerCategory)
+{
+  auto &accountant = MemoryAccountant::instance();
+
+  int64_t    firstUsage  = 100;
+  int64_t    secondUsage = 50;
+  const auto first =
+      accountant.registerConsumer("TestCategoryA", [&firstUsage] { return firstUsage; });
+  const auto second =
+      accountant.registerConsumer("TestCategoryA", [&secondUsage] { return secondUsage; });
+  const auto other = accountant.registerConsumer("TestCategoryB", [] { return int64_t(7); });
+
+  EXPECT_EQ(getUsageOfCategory("TestCategoryA"), 150);
+  EXPECT_EQ(getUsageOfCategory("TestCategoryB"), 7);
+
+  firstUsage = 200;
+  EXPECT_EQ(getUsageOfCategory("TestCategoryA"), 250);
+  EXPECT_EQ(accountant.getTotalUsage() - accountant.getTotalUsageExcludingCategory("TestCategoryA"),
+            250);
+}
+
+TEST(MemoryAccountantTest, DestroyedRegistrationIsRemoved)
+{
+  auto &accountant = MemoryAccountant::instance();
+
+  {
+    const auto registration =
+        accountant.registerConsumer("TestCategoryC", [] { return int64_t(1000); });
+    EXPECT_EQ(getUsageOfCategory("TestCategoryC"), 1000);
+  }
+  EXPECT_EQ(getUsageOfCategory("TestCategoryC"), 0);
+
+  MemoryAccountant::Registration movedRegistration;
+  {
+    auto registration = accountant.registerConsumer("TestCategoryC", [] { return int64_t(10); });
+    movedRegistration = std::move(registration);
+  }
+  EXPECT_EQ(getUsageOfCategory("TestCategoryC"), 10);
+}
+
+TEST(MemoryAccountantTest, UsageFunctionIsCalledWithoutTheAccountantLock)
+{
+  auto &accountant = MemoryAccountant::instance();
+
+  // A usage function may use the accountant itself (or locks that are held while registering)
+  const auto registration = accountant.registerConsumer("TestCategoryD", [] {
+    return MemoryAccountant::instance().getTotalUsageExcludingCategory("TestCategoryD") > 0 ? 1 : 2;
+  });
+  const auto other = accountant.registerConsumer("TestCategoryE", [] { return int64_t(5); });
+
+  EXPECT_EQ(getUsageOfCategory("TestCategoryD"), 1);
+}
+
+} // namespace
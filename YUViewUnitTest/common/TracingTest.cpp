@@ -0,0 +1,152 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include <common/Tracing.h>
+
+namespace
+{
+
+size_t countOccurrences(const std::string &text, const std::string &pattern)
+{
+  size_t count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+    count++;
+  return count;
+}
+
+std::string exportTrace()
+{
+  std::stringstream stream;
+  Tracer::instance().exportChromeTrace(stream);
+  return stream.str();
+}
+
+class TracingTest : public testing::Test
+{
+protected:
+  void SetUp() override { Tracer::instance().clear(); }
+  void TearDown() override
+  {
+    Tracer::instance().setEnabled(false);
+    Tracer::instance().clear();
+  }
+};
+
+TEST_F(TracingTest, NoEventsAreRecordedWhenDisabled)
+{
+  {
+    TRACE_SCOPE("test", "disabledEvent");
+  }
+  EXPECT_EQ(countOccurrences(exportTrace(), "disabledEvent"), 0u);
+}
+
+TEST_F(TracingTest, ExportScopedEventsOfMultipleThreads)
+{
+  Tracer::instance().setEnabled(true);
+  {
+    TRACE_SCOPE("test", "mainThreadEvent", 17);
+  }
+  std::thread otherThread([]() {
+    for (int i = 0; i < 3; i++)
+    {
+      TRACE_SCOPE("test", "otherThreadEvent");
+    }
+  });
+  otherThread.join();
+
+  const auto trace = exportTrace();
+  EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_EQ(countOccurrences(trace, "\"name\":\"mainThreadEvent\""), 1u);
+  EXPECT_EQ(countOccurrences(trace, "\"name\":\"otherThreadEvent\""), 3u);
+  EXPECT_EQ(countOccurrences(trace, "\"args\":{\"frame\":17}"), 1u);
+  EXPECT_EQ(countOccurrences(trace, "\"ph\":\"X\""), 4u);
+}
+
+TEST_F(TracingTest, RingBufferKeepsNewestEvents)
+{
+  Tracer::instance().setEnabled(true);
+  for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD; i++)
+    Tracer::instance().addEvent("test", "oldEvent", 0, 1);
+  for (int i = 0; i < 10; i++)
+    Tracer::instance().addEvent("test", "newEvent", 0, 1);
+
+  const auto trace = exportTrace();
+  EXPECT_EQ(countOccurrences(trace, "\"name\":\"newEvent\""), 10u);
+  EXPECT_EQ(countOccurrences(trace, "\"name\":\"oldEvent\""), Tracer::EVENTS_PER_THREAD - 10);
+}
+
+TEST_F(TracingTest, ExportWhileAnotherThreadIsWriting)
+{
+  Tracer::instance().setEnabled(true);
+  std::atomic_bool stopWriting{false};
+  std::thread      writer([&stopWriting]() {
+    while (!stopWriting.load())
+      Tracer::instance().addEvent("test", "concurrentEvent", 0, 1);
+  });
+
+  for (int i = 0; i < 5; i++)
+  {
+    const auto trace = exportTrace();
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"concurrentEvent\""),
+              countOccurrences(trace, "\"ph\":\"X\""));
+  }
+  stopWriting.store(true);
+  writer.join();
+}
+
+TEST_F(TracingTest, BuffersOfFinishedThreadsAreReused)
+{
+  Tracer::instance().setEnabled(true);
+  for (int i = 0; i < 10; i++)
+  {
+    std::thread thread([]() { TRACE_SCOPE("test", "shortLivedThreadEvent"); });
+    thread.join();
+  }
+  const auto nrBuffers = Tracer::instance().getNrThreadBuffers();
+
+  for (int i = 0; i < 10; i++)
+  {
+    std::thread thread([]() { TRACE_SCOPE("test", "shortLivedThreadEvent"); });
+    thread.join();
+  }
+
+  EXPECT_EQ(Tracer::instance().getNrThreadBuffers(), nrBuffers);
+  EXPECT_EQ(countOccurrences(exportTrace(), "\"name\":\"shortLivedThreadEvent\""), 20u);
+}
+
+} // namespace
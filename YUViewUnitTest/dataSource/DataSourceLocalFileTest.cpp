@@ -35,6 +35,8 @@
 #include <TemporaryFile.h>
 #include <dataSource/DataSourceLocalFile.h>
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 
 namespace datasource::test
@@ -153,6 +155,63 @@ TEST(DataSourceLocalFileTest, OpenFileThatExists_TestSeekingFromEOF)
   EXPECT_FALSE(file.atEnd());
 }
 
+TEST(DataSourceLocalFileTest, OpenFileThatExists_TestReadAtDoesNotChangePosition)
+{
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+  ByteVector                buffer;
+
+  DataSourceLocalFile file(tempFile.getFilePath());
+  EXPECT_TRUE(file);
+
+  EXPECT_EQ(file.readAt(buffer, 4, 3), 3);
+  EXPECT_THAT(buffer, ElementsAre('d', 'a', 't'));
+  EXPECT_EQ(file.readAt(buffer, 6, 100), 2);
+  EXPECT_THAT(buffer, ElementsAre('t', 'a'));
+  EXPECT_EQ(file.readAt(buffer, 20, 4), 0);
+  EXPECT_EQ(buffer.size(), 0u);
+
+  EXPECT_EQ(file.getPosition(), 0);
+  EXPECT_EQ(file.read(buffer, 4), 4);
+  EXPECT_THAT(buffer, ElementsAre('t', 'e', 's', 't'));
+}
+
+TEST(DataSourceLocalFileTest, OpenFileThatExists_TestConcurrentReadAt)
+{
+  constexpr auto NR_THREADS     = 8;
+  constexpr auto BLOCK_SIZE     = 4096;
+  constexpr auto NR_BLOCKS      = 64;
+  constexpr auto NR_REPETITIONS = 20;
+
+  ByteVector data(BLOCK_SIZE * NR_BLOCKS);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<unsigned char>((i * 31 + i / BLOCK_SIZE) % 251);
+  yuviewTest::TemporaryFile tempFile(data);
+
+  DataSourceLocalFile file(tempFile.getFilePath());
+  EXPECT_TRUE(file);
+
+  std::atomic_int          nrMismatches{};
+  std::vector<std::thread> threads;
+  for (int threadIndex = 0; threadIndex < NR_THREADS; ++threadIndex)
+    threads.emplace_back([&, threadIndex]() {
+      ByteVector buffer;
+      for (int repetition = 0; repetition < NR_REPETITIONS; ++repetition)
+      {
+        for (int block = threadIndex; block < NR_BLOCKS; block += NR_THREADS)
+        {
+          const auto start = block * BLOCK_SIZE;
+          if (file.readAt(buffer, start, BLOCK_SIZE) != BLOCK_SIZE ||
+              !std::equal(buffer.begin(), buffer.end(), data.begin() + start))
+            ++nrMismatches;
+        }
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(nrMismatches, 0);
+}
+
 TEST(DataSourceLocalFileTest, ModifyOpenedFileExternally_ShouldBeDetected)
 {
   yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
@@ -0,0 +1,117 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <decoder/BackwardDecodeBuffer.h>
+
+namespace
+{
+
+QByteArray createFrameData(const int size, const char value)
+{
+  return QByteArray(size, value);
+}
+
+TEST(BackwardDecodeBufferTest, FramesCanBeRetrievedInReverseOrder)
+{
+  decoder::BackwardDecodeBuffer buffer(1000);
+
+  for (int frameIdx = 8; frameIdx < 16; ++frameIdx)
+    buffer.addFrame(frameIdx, createFrameData(100, static_cast<char>(frameIdx)));
+
+  EXPECT_EQ(buffer.getNumberFrames(), 8);
+  EXPECT_EQ(buffer.getUsedBytes(), 800);
+
+  for (int frameIdx = 15; frameIdx >= 8; --frameIdx)
+  {
+    const auto frame = buffer.getFrame(frameIdx);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->at(0), static_cast<char>(frameIdx));
+  }
+  EXPECT_FALSE(buffer.getFrame(7));
+  EXPECT_FALSE(buffer.getFrame(16));
+}
+
+TEST(BackwardDecodeBufferTest, FirstAddedFramesAreDroppedWhenFull)
+{
+  decoder::BackwardDecodeBuffer buffer(350);
+
+  for (int frameIdx = 0; frameIdx < 8; ++frameIdx)
+    buffer.addFrame(frameIdx, createFrameData(100, 0));
+
+  EXPECT_EQ(buffer.getNumberFrames(), 3);
+  EXPECT_LE(buffer.getUsedBytes(), 350);
+  EXPECT_FALSE(buffer.contains(4));
+  EXPECT_TRUE(buffer.contains(5));
+  EXPECT_TRUE(buffer.contains(6));
+  EXPECT_TRUE(buffer.contains(7));
+}
+
+TEST(BackwardDecodeBufferTest, ShrinkingTheBudgetDropsFrames)
+{
+  decoder::BackwardDecodeBuffer buffer(1000);
+  for (int frameIdx = 0; frameIdx < 5; ++frameIdx)
+    buffer.addFrame(frameIdx, createFrameData(100, 0));
+
+  buffer.setMaxBytes(200);
+  EXPECT_EQ(buffer.getNumberFrames(), 2);
+  EXPECT_TRUE(buffer.contains(3));
+  EXPECT_TRUE(buffer.contains(4));
+
+  buffer.clear();
+  EXPECT_EQ(buffer.getNumberFrames(), 0);
+  EXPECT_EQ(buffer.getUsedBytes(), 0);
+}
+
+TEST(BackwardDecodeBufferTest, RemoveFramesFromKeepsTheLowerFrames)
+{
+  decoder::BackwardDecodeBuffer buffer(1000);
+  for (int frameIdx = 0; frameIdx < 6; ++frameIdx)
+    buffer.addFrame(frameIdx, createFrameData(100, 0));
+
+  buffer.removeFramesFrom(4);
+  EXPECT_EQ(buffer.getNumberFrames(), 4);
+  EXPECT_EQ(buffer.getUsedBytes(), 400);
+  EXPECT_TRUE(buffer.contains(3));
+  EXPECT_FALSE(buffer.contains(4));
+  EXPECT_FALSE(buffer.contains(5));
+}
+
+TEST(BackwardDecodeBufferTest, FramesLargerThanTheBudgetAreNotAdded)
+{
+  decoder::BackwardDecodeBuffer buffer(100);
+  buffer.addFrame(0, createFrameData(101, 0));
+  EXPECT_EQ(buffer.getNumberFrames(), 0);
+}
+
+} // namespace
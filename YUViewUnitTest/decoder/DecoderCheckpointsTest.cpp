@@ -0,0 +1,152 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <decoder/DecoderCheckpoints.h>
+
+namespace decoder::test
+{
+
+namespace
+{
+
+using Checkpoint = DecoderCheckpoints::Checkpoint;
+
+Checkpoint createCheckpoint(int frameIdx)
+{
+  Checkpoint checkpoint;
+  checkpoint.frameIdx                    = frameIdx;
+  checkpoint.filePos                     = uint64_t(frameIdx) * 1000;
+  checkpoint.readFrameCounterCodingOrder = frameIdx + 1;
+  return checkpoint;
+}
+
+// Decoding continues in display order from the parked frame to the target frame
+DecoderCheckpoints::DecodeCostFunction decodeCostTo(int targetFrameIdx)
+{
+  return [targetFrameIdx](int frameIdx) -> std::optional<unsigned> {
+    if (frameIdx >= targetFrameIdx)
+      return {};
+    return unsigned(targetFrameIdx - frameIdx);
+  };
+}
+
+TEST(DecoderCheckpointsTest, TakeCheckpointWithLowestDecodeCost)
+{
+  DecoderCheckpoints checkpoints;
+  checkpoints.setMaxCheckpoints(4);
+
+  EXPECT_FALSE(checkpoints.park({0, 1}, createCheckpoint(20)));
+  EXPECT_FALSE(checkpoints.park({0, 3}, createCheckpoint(52)));
+  EXPECT_FALSE(checkpoints.park({0, 5}, createCheckpoint(84)));
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 3u);
+
+  // Frame 60 is closest to the checkpoint at frame 52. The checkpoint at 84 can not be used.
+  const auto checkpoint = checkpoints.take(decodeCostTo(60), 100);
+  ASSERT_TRUE(checkpoint);
+  EXPECT_EQ(checkpoint->frameIdx, 52);
+  EXPECT_EQ(checkpoint->filePos, 52000u);
+  EXPECT_EQ(checkpoint->readFrameCounterCodingOrder, 53);
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 2u);
+
+  // Taking removes the checkpoint
+  const auto nextCheckpoint = checkpoints.take(decodeCostTo(60), 100);
+  ASSERT_TRUE(nextCheckpoint);
+  EXPECT_EQ(nextCheckpoint->frameIdx, 20);
+}
+
+TEST(DecoderCheckpointsTest, CheckpointMustBeCheaperThanMaxDecodeCost)
+{
+  DecoderCheckpoints checkpoints;
+  checkpoints.setMaxCheckpoints(4);
+  checkpoints.park({0, 1}, createCheckpoint(20));
+
+  EXPECT_FALSE(checkpoints.take(decodeCostTo(30), 10));
+  EXPECT_FALSE(checkpoints.take(decodeCostTo(10), 100));
+
+  const auto checkpoint = checkpoints.take(decodeCostTo(30), 11);
+  ASSERT_TRUE(checkpoint);
+  EXPECT_EQ(checkpoint->frameIdx, 20);
+}
+
+TEST(DecoderCheckpointsTest, OnlyOneCheckpointPerInterval)
+{
+  DecoderCheckpoints checkpoints;
+  checkpoints.setMaxCheckpoints(4);
+
+  EXPECT_FALSE(checkpoints.park({8, 1}, createCheckpoint(30)));
+  const auto replacedCheckpoint = checkpoints.park({8, 1}, createCheckpoint(35));
+  ASSERT_TRUE(replacedCheckpoint);
+  EXPECT_EQ(replacedCheckpoint->frameIdx, 30);
+
+  // The same interval in another GOP is a different checkpoint
+  EXPECT_FALSE(checkpoints.park({64, 1}, createCheckpoint(90)));
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 2u);
+}
+
+TEST(DecoderCheckpointsTest, FirstParkedCheckpointIsDropped)
+{
+  DecoderCheckpoints checkpoints;
+  checkpoints.setMaxCheckpoints(2);
+
+  EXPECT_FALSE(checkpoints.park({0, 3}, createCheckpoint(50)));
+  EXPECT_FALSE(checkpoints.park({0, 1}, createCheckpoint(20)));
+  const auto droppedCheckpoint = checkpoints.park({0, 2}, createCheckpoint(40));
+  ASSERT_TRUE(droppedCheckpoint);
+  EXPECT_EQ(droppedCheckpoint->frameIdx, 50);
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 2u);
+
+  checkpoints.setMaxCheckpoints(1);
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 1u);
+  const auto checkpoint = checkpoints.take(decodeCostTo(100), 100);
+  ASSERT_TRUE(checkpoint);
+  EXPECT_EQ(checkpoint->frameIdx, 40);
+
+  checkpoints.park({0, 1}, createCheckpoint(20));
+  checkpoints.clear();
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 0u);
+}
+
+TEST(DecoderCheckpointsTest, NothingIsParkedWithoutCheckpoints)
+{
+  DecoderCheckpoints checkpoints;
+
+  const auto checkpoint = checkpoints.park({0, 1}, createCheckpoint(20));
+  ASSERT_TRUE(checkpoint);
+  EXPECT_EQ(checkpoint->frameIdx, 20);
+  EXPECT_EQ(checkpoints.getNumberCheckpoints(), 0u);
+}
+
+} // namespace
+
+} // namespace decoder::test
@@ -0,0 +1,264 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include "FakeDecoderHost.h"
+
+#include <decoder/DecoderHostPool.h>
+#include <decoder/decoderRemote.h>
+
+#include <chrono>
+
+namespace decoder::host::test
+{
+
+namespace
+{
+
+using yuviewTest::decoder::FakeDecoderHost;
+
+using Clock = std::chrono::steady_clock;
+
+int64_t getElapsedMs(const Clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+TEST(DecoderHostConnectionTest, MissingHostExecutable)
+{
+  DecoderHostConnection connection(DecoderEngine::HM, DecoderHostConnection::HostSettings());
+  EXPECT_FALSE(connection.isOk());
+  EXPECT_EQ(connection.getErrorString(), "The decoder host executable was not found.");
+  EXPECT_FALSE(connection.request(Command::ResetDecoder));
+}
+
+TEST(DecoderHostConnectionTest, HostThatExitsRightAway)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost      host;
+  DecoderHostConnection connection(DecoderEngine::HM, host.createScript("exit.sh", "exit 1"));
+  EXPECT_FALSE(connection.isOk());
+  EXPECT_EQ(connection.getErrorString(), "The decoder host process could not be started.");
+  EXPECT_FALSE(connection.request(Command::ResetDecoder));
+}
+
+TEST(DecoderHostConnectionTest, HostThatDoesNotReplyIsKilledAfterTheReplyTimeout)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  auto            settings = host.createScript("hang.sh", "exec sleep 30");
+  settings.replyTimeoutMs  = 300;
+
+  const auto            start = Clock::now();
+  DecoderHostConnection connection(DecoderEngine::HM, settings);
+  const auto            elapsedMs = getElapsedMs(start);
+
+  EXPECT_FALSE(connection.isOk());
+  EXPECT_EQ(connection.getErrorString(), "The decoder host process could not be started.");
+  EXPECT_GE(elapsedMs, settings.replyTimeoutMs);
+  EXPECT_LT(elapsedMs, 10000);
+}
+
+TEST(DecoderHostConnectionTest, HostThatDoesNotQuitIsKilledAfterTheQuitTimeout)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  auto            connection = host.connect(DecoderEngine::HM);
+  ASSERT_TRUE(connection->isOk());
+
+  // The server quits but the script of the fake host keeps on running
+  const auto start = Clock::now();
+  connection.reset();
+  const auto elapsedMs = getElapsedMs(start);
+  EXPECT_GE(elapsedMs, 200);
+  EXPECT_LT(elapsedMs, 10000);
+}
+
+TEST(DecoderHostConnectionTest, DecoderInfo)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  const auto      connection = host.connect(DecoderEngine::VTM);
+  ASSERT_TRUE(connection->isOk());
+  EXPECT_EQ(connection->getDecoderEngine(), DecoderEngine::VTM);
+
+  const auto &info = connection->getDecoderInfo();
+  EXPECT_EQ(info.decoderName, "TestDecoder");
+  EXPECT_EQ(info.codecName, "Test");
+  EXPECT_EQ(info.signalNames, QStringList({"Reconstruction", "Prediction"}));
+  EXPECT_TRUE(info.statisticsSupported);
+}
+
+TEST(DecoderHostConnectionTest, DecodeFrames)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  const auto      connection = host.connect(DecoderEngine::HM);
+  ASSERT_TRUE(connection->isOk());
+
+  for (const auto data : {"PS", "frame 0"})
+  {
+    const auto reply = connection->request(Command::PushData, 0, data);
+    ASSERT_TRUE(reply);
+    EXPECT_TRUE(reply->success);
+  }
+  const auto pushReply = connection->request(Command::PushData, 0, "frame 1");
+  ASSERT_TRUE(pushReply);
+  EXPECT_FALSE(pushReply->success);
+  EXPECT_EQ(pushReply->decoderState, DecoderState::RetrieveFrames);
+
+  const auto decodeReply = connection->request(Command::DecodeNextFrame);
+  ASSERT_TRUE(decodeReply);
+  EXPECT_TRUE(decodeReply->success);
+  EXPECT_EQ(decodeReply->frameSize, Size(4, 2));
+  EXPECT_FALSE(decodeReply->pixelFormatName.empty());
+
+  const auto dataReply = connection->request(Command::GetRawFrameData);
+  ASSERT_TRUE(dataReply);
+  EXPECT_TRUE(dataReply->success);
+  EXPECT_EQ(dataReply->data, QByteArray("frame 0"));
+
+  const auto resetReply = connection->request(Command::ResetDecoder);
+  ASSERT_TRUE(resetReply);
+  EXPECT_EQ(resetReply->decoderState, DecoderState::NeedsMoreData);
+}
+
+TEST(DecoderHostConnectionTest, DecoderErrorsAreTransferred)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  const auto      connection = host.connect(DecoderEngine::HM);
+  ASSERT_TRUE(connection->isOk());
+
+  const auto reply = connection->request(Command::PushData, 0, "ERR");
+  ASSERT_TRUE(reply);
+  EXPECT_FALSE(reply->success);
+  EXPECT_EQ(reply->decoderState, DecoderState::Error);
+  EXPECT_EQ(reply->errorString, "Invalid data");
+}
+
+TEST(DecoderHostConnectionTest, SharedMemoryIsEnlargedForLargeFrames)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  const auto      connection = host.connect(DecoderEngine::HM);
+  ASSERT_TRUE(connection->isOk());
+
+  QByteArray largeFrame(int(INITIAL_DATA_CAPACITY) + 1024, 'x');
+  const auto pushReply = connection->request(Command::PushData, 0, largeFrame);
+  ASSERT_TRUE(pushReply);
+  EXPECT_TRUE(pushReply->success);
+  ASSERT_TRUE(connection->request(Command::DecodeNextFrame));
+
+  const auto dataReply = connection->request(Command::GetRawFrameData);
+  ASSERT_TRUE(dataReply);
+  EXPECT_TRUE(dataReply->success);
+  EXPECT_EQ(dataReply->data, largeFrame);
+}
+
+TEST(DecoderHostConnectionTest, Statistics)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  const auto      connection = host.connect(DecoderEngine::HM);
+  ASSERT_TRUE(connection->isOk());
+
+  ASSERT_TRUE(connection->request(Command::EnableStatistics, 1));
+  ASSERT_TRUE(connection->request(Command::PushData, 0, "frame 0"));
+  ASSERT_TRUE(connection->request(Command::DecodeNextFrame));
+
+  const auto reply = connection->request(Command::GetStatistics);
+  ASSERT_TRUE(reply);
+  EXPECT_TRUE(reply->success);
+
+  const auto statistics = deserializeFrameStatistics(reply->data);
+  ASSERT_TRUE(statistics);
+  ASSERT_EQ(statistics->count(0), 1u);
+  const auto &values = statistics->at(0).valueData;
+  ASSERT_EQ(values.size(), 1u);
+  EXPECT_EQ(values[0].value, 7);
+}
+
+TEST(DecoderHostConnectionTest, RemoteDecoderRetrievesStatistics)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  FakeDecoderHost host;
+  auto            connection = host.connect(DecoderEngine::HM);
+  ASSERT_TRUE(connection->isOk());
+
+  {
+    decoderRemote decoder(std::move(connection), true);
+    EXPECT_TRUE(decoder.statisticsSupported());
+    EXPECT_EQ(decoder.getDecoderName(), "TestDecoder");
+
+    stats::StatisticsData statisticsData;
+    decoder.enableStatisticsRetrieval(&statisticsData);
+    statisticsData.setFrameIndex(3);
+
+    QByteArray data("frame 0");
+    EXPECT_TRUE(decoder.pushData(data));
+    ASSERT_TRUE(decoder.decodeNextFrame());
+    EXPECT_EQ(decoder.getRawFrameData(), QByteArray("frame 0"));
+
+    EXPECT_EQ(statisticsData.getFrameIndex(), 3);
+    const auto frameData = statisticsData.getFrameData();
+    ASSERT_EQ(frameData.count(0), 1u);
+    EXPECT_EQ(frameData.at(0).valueData.size(), 1u);
+  }
+
+  // The remote decoder released its host to the pool. Take it back so that it quits before the
+  // fake host ends.
+  DecoderHostPool::instance().acquire(DecoderEngine::HM);
+}
+
+} // namespace
+
+} // namespace decoder::host::test
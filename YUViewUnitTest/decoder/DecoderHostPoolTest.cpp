@@ -0,0 +1,158 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include "FakeDecoderHost.h"
+
+#include <decoder/DecoderHostPool.h>
+
+namespace decoder::host::test
+{
+
+namespace
+{
+
+using yuviewTest::decoder::FakeDecoderHost;
+
+// A pool that starts fake hosts and counts how many were started
+struct TestPool
+{
+  TestPool(const size_t maxIdleConnections)
+      : pool(
+            [this](const DecoderEngine engine) {
+              this->nrHostsStarted++;
+              return this->host.connect(engine);
+            },
+            maxIdleConnections)
+  {
+  }
+
+  // The pool quits its hosts before the fake host ends
+  FakeDecoderHost host;
+  unsigned        nrHostsStarted{};
+  DecoderHostPool pool;
+};
+
+TEST(DecoderHostPoolTest, ReleasedHostsAreReused)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  TestPool test(2);
+  auto     connection = test.pool.acquire(DecoderEngine::HM);
+  ASSERT_TRUE(connection);
+  EXPECT_TRUE(connection->isOk());
+  EXPECT_EQ(test.nrHostsStarted, 1u);
+
+  const auto releasedConnection = connection.get();
+  test.pool.release(std::move(connection));
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 1u);
+
+  connection = test.pool.acquire(DecoderEngine::HM);
+  EXPECT_EQ(connection.get(), releasedConnection);
+  EXPECT_EQ(test.nrHostsStarted, 1u);
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 0u);
+}
+
+TEST(DecoderHostPoolTest, HostsAreOnlyReusedForTheSameEngine)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  TestPool test(2);
+  test.pool.release(test.pool.acquire(DecoderEngine::HM));
+
+  const auto connection = test.pool.acquire(DecoderEngine::VTM);
+  ASSERT_TRUE(connection);
+  EXPECT_EQ(connection->getDecoderEngine(), DecoderEngine::VTM);
+  EXPECT_EQ(test.nrHostsStarted, 2u);
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 1u);
+}
+
+TEST(DecoderHostPoolTest, NumberOfIdleHostsIsLimited)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  TestPool test(1);
+  auto     first  = test.pool.acquire(DecoderEngine::HM);
+  auto     second = test.pool.acquire(DecoderEngine::HM);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(test.nrHostsStarted, 2u);
+
+  // The oldest idle host is quit
+  test.pool.release(std::move(first));
+  const auto secondConnection = second.get();
+  test.pool.release(std::move(second));
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 1u);
+  EXPECT_EQ(test.pool.acquire(DecoderEngine::HM).get(), secondConnection);
+}
+
+TEST(DecoderHostPoolTest, NoHostsAfterShutDown)
+{
+  if (is_Q_OS_WIN)
+    GTEST_SKIP() << "The fake decoder hosts are shell scripts";
+
+  TestPool test(2);
+  auto     connection = test.pool.acquire(DecoderEngine::HM);
+  ASSERT_TRUE(connection);
+  test.pool.release(test.pool.acquire(DecoderEngine::HM));
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 1u);
+
+  test.pool.shutDown();
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 0u);
+  EXPECT_FALSE(test.pool.acquire(DecoderEngine::HM));
+
+  // Hosts that are released after the shut down are quit right away
+  test.pool.release(std::move(connection));
+  EXPECT_EQ(test.pool.getNumberIdleConnections(), 0u);
+  EXPECT_EQ(test.nrHostsStarted, 2u);
+}
+
+TEST(DecoderHostPoolTest, HostsThatFailedAreNotHandedOut)
+{
+  // Without a program, the host can not be started
+  const auto startHost = [](const DecoderEngine engine) {
+    return std::make_unique<DecoderHostConnection>(engine, DecoderHostConnection::HostSettings());
+  };
+  DecoderHostPool pool(startHost, 2);
+  EXPECT_FALSE(pool.acquire(DecoderEngine::HM));
+
+  pool.release(startHost(DecoderEngine::HM));
+  EXPECT_EQ(pool.getNumberIdleConnections(), 0u);
+}
+
+} // namespace
+
+} // namespace decoder::host::test
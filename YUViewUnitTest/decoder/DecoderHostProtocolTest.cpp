@@ -0,0 +1,145 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <decoder/DecoderHostProtocol.h>
+
+namespace decoder::host::test
+{
+
+namespace
+{
+
+std::map<int, stats::FrameTypeData> createFrameStatistics()
+{
+  std::map<int, stats::FrameTypeData> frameData;
+
+  auto &blocks = frameData[0];
+  blocks.addBlockValue(0, 0, 8, 8, -3);
+  blocks.addBlockValue(8, 0, 16, 16, 7);
+  blocks.addBlockVector(0, 0, 8, 8, 12, -4);
+  blocks.addLine(8, 0, 16, 16, 1, 2, 3, 4);
+
+  auto &shapes = frameData[5];
+  shapes.addBlockAffineTF(16, 16, 4, 4, 1, 2, 3, 4, 5, 6);
+  shapes.addPolygonValue({{0, 0}, {10, 0}, {5, 5}}, 42);
+  shapes.addPolygonVector({{1, 1}, {2, 2}, {3, 1}, {2, 0}}, -7, 9);
+
+  return frameData;
+}
+
+TEST(DecoderHostProtocolTest, TextIsTruncatedToTheHeader)
+{
+  SharedHeader header;
+  setText(header, "Decoder error");
+  EXPECT_EQ(getText(header), "Decoder error");
+
+  const auto longText = std::string(3000, 'x');
+  setText(header, longText);
+  EXPECT_EQ(getText(header), longText.substr(0, sizeof(header.text) - 1));
+}
+
+TEST(DecoderHostProtocolTest, KeysAreDistinct)
+{
+  const std::string baseKey = "YUViewDecoderHost_1_0";
+  EXPECT_NE(getRequestSemaphoreKey(baseKey), getReplySemaphoreKey(baseKey));
+  EXPECT_NE(getSharedMemoryKey(baseKey, 0), getSharedMemoryKey(baseKey, 1));
+  EXPECT_NE(getSharedMemoryKey(baseKey, 0), getRequestSemaphoreKey(baseKey));
+}
+
+TEST(DecoderHostProtocolTest, FrameStatisticsRoundTrip)
+{
+  const auto original     = createFrameStatistics();
+  const auto deserialized = deserializeFrameStatistics(serializeFrameStatistics(original));
+  ASSERT_TRUE(deserialized);
+  ASSERT_EQ(deserialized->size(), 2u);
+
+  const auto &blocks = deserialized->at(0);
+  ASSERT_EQ(blocks.valueData.size(), 2u);
+  EXPECT_EQ(blocks.valueData[0].value, -3);
+  EXPECT_EQ(blocks.valueData[1].pos[0], 8);
+  EXPECT_EQ(blocks.valueData[1].size[1], 16);
+  EXPECT_EQ(blocks.valueData[1].value, 7);
+  EXPECT_EQ(blocks.maxBlockSize, 256u);
+
+  ASSERT_EQ(blocks.vectorData.size(), 2u);
+  EXPECT_FALSE(blocks.vectorData[0].isLine);
+  EXPECT_EQ(blocks.vectorData[0].point[0], stats::Point(12, -4));
+  EXPECT_TRUE(blocks.vectorData[1].isLine);
+  EXPECT_EQ(blocks.vectorData[1].point[0], stats::Point(1, 2));
+  EXPECT_EQ(blocks.vectorData[1].point[1], stats::Point(3, 4));
+
+  const auto &shapes = deserialized->at(5);
+  ASSERT_EQ(shapes.affineTFData.size(), 1u);
+  EXPECT_EQ(shapes.affineTFData[0].pos[0], 16);
+  EXPECT_EQ(shapes.affineTFData[0].point[2], stats::Point(5, 6));
+
+  ASSERT_EQ(shapes.polygonValueData.size(), 1u);
+  const auto polygonValue = shapes.polygonValueData[0];
+  ASSERT_EQ(polygonValue.corners.size(), 3u);
+  EXPECT_EQ(polygonValue.corners[1], stats::Point(10, 0));
+  EXPECT_EQ(polygonValue.value, 42);
+
+  ASSERT_EQ(shapes.polygonVectorData.size(), 1u);
+  const auto polygonVector = shapes.polygonVectorData[0];
+  EXPECT_EQ(polygonVector.corners.size(), 4u);
+  EXPECT_EQ(polygonVector.point, stats::Point(-7, 9));
+}
+
+TEST(DecoderHostProtocolTest, EmptyFrameStatistics)
+{
+  const auto deserialized = deserializeFrameStatistics(serializeFrameStatistics({}));
+  ASSERT_TRUE(deserialized);
+  EXPECT_TRUE(deserialized->empty());
+}
+
+TEST(DecoderHostProtocolTest, InvalidFrameStatisticsAreRejected)
+{
+  const auto data = serializeFrameStatistics(createFrameStatistics());
+
+  EXPECT_FALSE(deserializeFrameStatistics({}));
+  EXPECT_FALSE(deserializeFrameStatistics(data.mid(0, data.size() - 4)));
+
+  auto withTrailingData = data;
+  withTrailingData.append(QByteArray(4, 0));
+  EXPECT_FALSE(deserializeFrameStatistics(withTrailingData));
+
+  // A count that is larger than the remaining data
+  const int32_t nrTypes = 1000;
+  EXPECT_FALSE(
+      deserializeFrameStatistics(QByteArray(reinterpret_cast<const char *>(&nrTypes), 4)));
+}
+
+} // namespace
+
+} // namespace decoder::host::test
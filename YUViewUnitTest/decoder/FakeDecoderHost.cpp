@@ -0,0 +1,128 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FakeDecoderHost.h"
+
+#include "TestDecoder.h"
+
+#include <decoder/DecoderHostServer.h>
+
+#include <QCoreApplication>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+namespace yuviewTest::decoder
+{
+
+namespace
+{
+
+constexpr auto REPLY_TIMEOUT_MS = 5000;
+constexpr auto QUIT_TIMEOUT_MS  = 200;
+
+constexpr auto ARGUMENTS_TIMEOUT = std::chrono::seconds(10);
+
+} // namespace
+
+FakeDecoderHost::FakeDecoderHost()
+{
+  static std::atomic_uint hostCounter{0};
+  this->directory = std::filesystem::temp_directory_path() /
+                    ("YUViewFakeDecoderHost_" + std::to_string(QCoreApplication::applicationPid()) +
+                     "_" + std::to_string(hostCounter++));
+  std::filesystem::create_directories(this->directory);
+
+  const auto argumentsFile = (this->directory / "arguments").string();
+  this->serveSettings =
+      this->createScript("serve.sh",
+                         "echo \"$@\" > \"" + argumentsFile + ".tmp\" && mv \"" + argumentsFile +
+                             ".tmp\" \"" + argumentsFile + "\"\nexec sleep 30");
+}
+
+FakeDecoderHost::~FakeDecoderHost()
+{
+  // The servers return when their connection sends Quit
+  for (auto &thread : this->serverThreads)
+    thread.join();
+  std::filesystem::remove_all(this->directory);
+}
+
+std::unique_ptr<DecoderHostConnection> FakeDecoderHost::connect(DecoderEngine engine)
+{
+  const auto argumentsFile = this->directory / "arguments";
+  this->serverThreads.emplace_back([argumentsFile]() {
+    const auto deadline = std::chrono::steady_clock::now() + ARGUMENTS_TIMEOUT;
+    while (!std::filesystem::exists(argumentsFile))
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+        return;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    QStringList arguments;
+    {
+      std::ifstream file(argumentsFile);
+      std::string   argument;
+      while (file >> argument)
+        arguments.append(QString::fromStdString(argument));
+    }
+    std::filesystem::remove(argumentsFile);
+
+    ::decoder::host::DecoderHostServer::run(
+        arguments, [](DecoderEngine) { return std::make_unique<TestDecoder>(true); });
+  });
+
+  return std::make_unique<DecoderHostConnection>(engine, this->serveSettings);
+}
+
+DecoderHostConnection::HostSettings FakeDecoderHost::createScript(const std::string &name,
+                                                                  const std::string &commands) const
+{
+  const auto path = this->directory / name;
+  {
+    std::ofstream file(path);
+    file << "#!/bin/sh\n" << commands << "\n";
+  }
+  std::filesystem::permissions(path,
+                               std::filesystem::perms::owner_exec,
+                               std::filesystem::perm_options::add);
+
+  DecoderHostConnection::HostSettings settings;
+  settings.program        = QString::fromStdString(path.string());
+  settings.replyTimeoutMs = REPLY_TIMEOUT_MS;
+  settings.quitTimeoutMs  = QUIT_TIMEOUT_MS;
+  return settings;
+}
+
+} // namespace yuviewTest::decoder
@@ -0,0 +1,73 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <decoder/DecoderHostConnection.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace yuviewTest::decoder
+{
+
+using ::decoder::DecoderEngine;
+using ::decoder::host::DecoderHostConnection;
+
+// Decoder hosts for tests of the decoder host connection. Instead of the host executable, the
+// connections start shell scripts (so this only works on unix). For a served connection, the
+// script writes its arguments to a file and waits. The host server is then run with these
+// arguments in a thread of the test process and serves the connection with a TestDecoder. The
+// script is killed by the connection after the quit timeout.
+class FakeDecoderHost
+{
+public:
+  FakeDecoderHost();
+  ~FakeDecoderHost();
+
+  // Start a connection that is served by a TestDecoder
+  std::unique_ptr<DecoderHostConnection> connect(DecoderEngine engine);
+
+  // Write a script with the given commands. The returned settings start the script.
+  DecoderHostConnection::HostSettings createScript(const std::string &name,
+                                                   const std::string &commands) const;
+
+private:
+  std::filesystem::path                directory;
+  DecoderHostConnection::HostSettings serveSettings;
+  std::vector<std::thread>             serverThreads;
+};
+
+} // namespace yuviewTest::decoder
@@ -0,0 +1,237 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include "TestDecoder.h"
+
+#include <decoder/ParallelGOPDecoder.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace decoder::test
+{
+
+namespace
+{
+
+using GOP = ParallelGOPDecoder::GOP;
+
+constexpr auto GOP_SIZE  = 8;
+constexpr auto NR_FRAMES = 40;
+
+QByteArray getFrameData(int frameIdx)
+{
+  return QByteArray::fromStdString("frame " + std::to_string(frameIdx));
+}
+
+// Every GOP starts with the parameter sets. Frame 27 can not be decoded.
+class TestReader : public ParallelGOPDecoder::BitstreamReader
+{
+public:
+  std::optional<QByteArrayList> seekToGOP(const GOP &gop) override
+  {
+    this->nextFrame = gop.firstFrame;
+    return QByteArrayList() << "PS";
+  }
+
+  QByteArray getNextUnit(bool getLastUnitAgain) override
+  {
+    if (!getLastUnitAgain)
+    {
+      this->lastUnit.clear();
+      if (this->nextFrame < NR_FRAMES)
+        this->lastUnit = (this->nextFrame == 27) ? "ERR" : getFrameData(this->nextFrame);
+      this->nextFrame++;
+    }
+    return this->lastUnit;
+  }
+
+private:
+  int        nextFrame{};
+  QByteArray lastUnit;
+};
+
+struct TestBitstream
+{
+  std::atomic_int nrReaders{0};
+  std::atomic_int nrDecodingThreads{0};
+  std::atomic_int maxDecodingThreads{0};
+  std::chrono::milliseconds decodeDelay{0};
+
+  ParallelGOPDecoder::Bitstream create()
+  {
+    ParallelGOPDecoder::Bitstream bitstream;
+    bitstream.getGOP = [](int frameIdx) -> std::optional<GOP> {
+      if (frameIdx < 0 || frameIdx >= NR_FRAMES)
+        return {};
+      const auto firstFrame = frameIdx - frameIdx % GOP_SIZE;
+      return GOP{firstFrame, firstFrame + GOP_SIZE - 1};
+    };
+    bitstream.createReader = [this]() {
+      this->nrReaders++;
+      return std::make_unique<TestReader>();
+    };
+    bitstream.createDecoder = [this]() {
+      auto decoder           = std::make_unique<yuviewTest::decoder::TestDecoder>(true);
+      decoder->onDecodeFrame = [this]() {
+        const auto nrThreads = ++this->nrDecodingThreads;
+        auto       maxThreads = this->maxDecodingThreads.load();
+        while (nrThreads > maxThreads &&
+               !this->maxDecodingThreads.compare_exchange_weak(maxThreads, nrThreads))
+          ;
+        std::this_thread::sleep_for(this->decodeDelay);
+        this->nrDecodingThreads--;
+      };
+      return decoder;
+    };
+    return bitstream;
+  }
+};
+
+TEST(ParallelGOPDecoderTest, FramesAreDecodedInDisplayOrder)
+{
+  TestBitstream      bitstream;
+  ParallelGOPDecoder decoder(bitstream.create(), 3, 1024 * 1024);
+  EXPECT_EQ(decoder.getNumberDecoders(), 3u);
+
+  for (int frameIdx = 0; frameIdx < 24; frameIdx++)
+  {
+    const auto frame = decoder.getFrame(frameIdx);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data, getFrameData(frameIdx));
+    EXPECT_FALSE(frame->statistics);
+  }
+}
+
+TEST(ParallelGOPDecoderTest, FollowingGOPsAreDecodedInParallel)
+{
+  TestBitstream bitstream;
+  bitstream.decodeDelay = std::chrono::milliseconds(5);
+  ParallelGOPDecoder decoder(bitstream.create(), 3, 1024 * 1024);
+
+  for (int frameIdx = 0; frameIdx < 24; frameIdx++)
+    ASSERT_TRUE(decoder.getFrame(frameIdx));
+  EXPECT_GE(bitstream.maxDecodingThreads.load(), 2);
+  EXPECT_LE(bitstream.maxDecodingThreads.load(), 3);
+}
+
+TEST(ParallelGOPDecoderTest, RandomAccess)
+{
+  TestBitstream      bitstream;
+  ParallelGOPDecoder decoder(bitstream.create(), 2, 1024 * 1024);
+
+  for (const auto frameIdx : {21, 3, 39, 22, 0})
+  {
+    const auto frame = decoder.getFrame(frameIdx);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data, getFrameData(frameIdx));
+  }
+
+  EXPECT_FALSE(decoder.getFrame(NR_FRAMES));
+  EXPECT_FALSE(decoder.getFrame(-1));
+}
+
+TEST(ParallelGOPDecoderTest, DecodersOfFollowingGOPsPauseAtTheBudget)
+{
+  TestBitstream      bitstream;
+  ParallelGOPDecoder decoder(bitstream.create(), 3, 0);
+
+  // Only the requested GOP is decoded. It stops once the requested frame was taken.
+  ASSERT_TRUE(decoder.getFrame(0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(decoder.getBufferedBytes(), getFrameData(0).size());
+
+  for (int frameIdx = 1; frameIdx < 24; frameIdx++)
+  {
+    const auto frame = decoder.getFrame(frameIdx);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data, getFrameData(frameIdx));
+  }
+}
+
+TEST(ParallelGOPDecoderTest, DecodingErrorOnlyAffectsItsGOP)
+{
+  TestBitstream      bitstream;
+  ParallelGOPDecoder decoder(bitstream.create(), 2, 1024 * 1024);
+
+  // Frame 27 is broken. The frames before it in the same GOP can be decoded.
+  EXPECT_TRUE(decoder.getFrame(26));
+  EXPECT_FALSE(decoder.getFrame(27));
+  EXPECT_FALSE(decoder.getFrame(28));
+
+  const auto frame = decoder.getFrame(32);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->data, getFrameData(32));
+}
+
+TEST(ParallelGOPDecoderTest, RetrieveStatistics)
+{
+  TestBitstream      bitstream;
+  ParallelGOPDecoder decoder(bitstream.create(), 2, 1024 * 1024);
+  decoder.setRetrieveStatistics(true);
+
+  for (int frameIdx = 0; frameIdx < 10; frameIdx++)
+  {
+    const auto frame = decoder.getFrame(frameIdx);
+    ASSERT_TRUE(frame);
+    ASSERT_TRUE(frame->statistics);
+    ASSERT_EQ(frame->statistics->count(0), 1u);
+    const auto &values = frame->statistics->at(0).valueData;
+    ASSERT_EQ(values.size(), 1u);
+    EXPECT_EQ(values[0].value, getFrameData(frameIdx).size());
+  }
+}
+
+TEST(ParallelGOPDecoderTest, ClearRecreatesTheReaders)
+{
+  TestBitstream      bitstream;
+  ParallelGOPDecoder decoder(bitstream.create(), 2, 1024 * 1024);
+
+  ASSERT_TRUE(decoder.getFrame(0));
+  const auto nrReaders = bitstream.nrReaders.load();
+  EXPECT_GE(nrReaders, 1);
+
+  decoder.clear();
+  EXPECT_EQ(decoder.getBufferedBytes(), 0);
+
+  const auto frame = decoder.getFrame(1);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->data, getFrameData(1));
+  EXPECT_GT(bitstream.nrReaders.load(), nrReaders);
+}
+
+} // namespace
+
+} // namespace decoder::test
@@ -0,0 +1,114 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestDecoder.h"
+
+namespace yuviewTest::decoder
+{
+
+using ::decoder::DecoderState;
+
+TestDecoder::TestDecoder(bool cachingDecoder) : decoderBase(cachingDecoder)
+{
+  this->internalsSupported = true;
+}
+
+void TestDecoder::resetDecoder()
+{
+  decoderBase::resetDecoder();
+  this->pendingFrames.clear();
+  this->currentFrame.clear();
+  this->endOfBitstream = false;
+}
+
+QStringList TestDecoder::getSignalNames() const
+{
+  return QStringList() << "Reconstruction"
+                       << "Prediction";
+}
+
+bool TestDecoder::decodeNextFrame()
+{
+  if (this->decoderState != DecoderState::RetrieveFrames)
+    return false;
+
+  if (this->pendingFrames.empty())
+  {
+    this->decoderState =
+        this->endOfBitstream ? DecoderState::EndOfBitstream : DecoderState::NeedsMoreData;
+    return false;
+  }
+
+  if (this->onDecodeFrame)
+    this->onDecodeFrame();
+
+  this->currentFrame = this->pendingFrames.front();
+  this->pendingFrames.pop_front();
+  this->statisticsRetrieved = false;
+  this->frameSize           = Size(4, 2);
+  this->rawFormat           = video::RawFormat::YUV;
+  this->formatYUV           = video::yuv::PixelFormatYUV(video::yuv::Subsampling::YUV_420, 8);
+  return true;
+}
+
+QByteArray TestDecoder::getRawFrameData()
+{
+  if (this->decoderState != DecoderState::RetrieveFrames)
+    return {};
+
+  if (this->statisticsEnabled() && !this->statisticsRetrieved)
+  {
+    this->statisticsData->at(0).addBlockValue(0, 0, 4, 4, this->currentFrame.size());
+    this->statisticsRetrieved = true;
+  }
+  return this->currentFrame;
+}
+
+bool TestDecoder::pushData(QByteArray &data)
+{
+  if (this->decoderState != DecoderState::NeedsMoreData)
+    return false;
+
+  if (data.isEmpty())
+    this->endOfBitstream = true;
+  else if (data.startsWith("ERR"))
+    return this->setErrorB("Invalid data");
+  else if (!data.startsWith("PS"))
+    // The data may be a view into the buffer of the reader
+    this->pendingFrames.push_back(QByteArray(data.constData(), data.size()));
+
+  if (!this->pendingFrames.empty() || this->endOfBitstream)
+    this->decoderState = DecoderState::RetrieveFrames;
+  return true;
+}
+
+} // namespace yuviewTest::decoder
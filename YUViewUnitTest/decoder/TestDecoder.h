@@ -0,0 +1,75 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <decoder/decoderBase.h>
+
+#include <deque>
+#include <functional>
+
+namespace yuviewTest::decoder
+{
+
+// A decoder for tests. Every pushed unit is one frame and the raw data of the frame is the unit.
+// Units that start with "PS" are parameter sets and units that start with "ERR" put the decoder
+// into the error state. If statistics are retrieved, every frame has one block value (type 0) with
+// the size of the frame.
+class TestDecoder : public ::decoder::decoderBase
+{
+public:
+  TestDecoder(bool cachingDecoder = false);
+
+  void resetDecoder() override;
+
+  int         nrSignalsSupported() const override { return 2; }
+  QStringList getSignalNames() const override;
+
+  bool       decodeNextFrame() override;
+  QByteArray getRawFrameData() override;
+  bool       pushData(QByteArray &data) override;
+
+  QStringList getLibraryPaths() const override { return {}; }
+  QString     getDecoderName() const override { return "TestDecoder"; }
+  QString     getCodecName() const override { return "Test"; }
+
+  // Called whenever a frame is decoded (e.g. to slow decoding down)
+  std::function<void()> onDecodeFrame;
+
+private:
+  std::deque<QByteArray> pendingFrames;
+  QByteArray             currentFrame;
+  bool                   endOfBitstream{};
+  bool                   statisticsRetrieved{};
+};
+
+} // namespace yuviewTest::decoder
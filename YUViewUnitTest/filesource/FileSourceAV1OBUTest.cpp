@@ -0,0 +1,332 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/FileSourceAV1OBUFile.h>
+
+namespace
+{
+
+using FileFormat = FileSourceAV1OBUFile::FileFormat;
+
+constexpr unsigned OBU_SEQUENCE_HEADER    = 1;
+constexpr unsigned OBU_TEMPORAL_DELIMITER = 2;
+constexpr unsigned OBU_FRAME              = 6;
+
+class BitWriter
+{
+public:
+  void writeBits(const unsigned value, const unsigned nrBits)
+  {
+    for (unsigned i = nrBits; i > 0; i--)
+    {
+      if (this->bitPos == 0)
+        this->data.push_back(0);
+      if ((value >> (i - 1)) & 1)
+        this->data.back() |= (0x80 >> this->bitPos);
+      this->bitPos = (this->bitPos + 1) % 8;
+    }
+  }
+
+  ByteVector data;
+
+private:
+  unsigned bitPos{};
+};
+
+// A sequence header for a 64x48, 8 bit, 4:2:0 sequence (profile 0, level 4)
+ByteVector createSequenceHeaderPayload()
+{
+  BitWriter writer;
+  writer.writeBits(0, 3);   // seq_profile
+  writer.writeBits(0, 1);   // still_picture
+  writer.writeBits(0, 1);   // reduced_still_picture_header
+  writer.writeBits(0, 1);   // timing_info_present_flag
+  writer.writeBits(0, 1);   // initial_display_delay_present_flag
+  writer.writeBits(0, 5);   // operating_points_cnt_minus_1
+  writer.writeBits(0, 12);  // operating_point_idc[0]
+  writer.writeBits(4, 5);   // seq_level_idx[0]
+  writer.writeBits(15, 4);  // frame_width_bits_minus_1
+  writer.writeBits(15, 4);  // frame_height_bits_minus_1
+  writer.writeBits(63, 16); // max_frame_width_minus_1
+  writer.writeBits(47, 16); // max_frame_height_minus_1
+  writer.writeBits(0, 1);   // frame_id_numbers_present_flag
+  writer.writeBits(0, 3);   // use_128x128_superblock, enable_filter_intra, enable_intra_edge_filter
+  writer.writeBits(0, 5);   // interintra, masked, warped motion, dual filter, order hint
+  writer.writeBits(1, 1);   // seq_choose_screen_content_tools
+  writer.writeBits(1, 1);   // seq_choose_integer_mv
+  writer.writeBits(0, 3);   // enable_superres, enable_cdef, enable_restoration
+  writer.writeBits(0, 4);   // high_bitdepth, mono_chrome, color_description_present, color_range
+  writer.writeBits(0, 3);   // chroma_sample_position, separate_uv_delta_q
+  writer.writeBits(0, 1);   // film_grain_params_present
+  writer.writeBits(1, 1);   // trailing_one_bit
+  return writer.data;
+}
+
+ByteVector createFramePayload(const bool keyFrame)
+{
+  // show_existing_frame = 0, frame_type (KEY_FRAME or INTER_FRAME), show_frame = 1
+  const auto firstByte = static_cast<unsigned char>(keyFrame ? 0x10 : 0x30);
+  return {firstByte, 0x81, 0x42, 0x00, 0x17};
+}
+
+struct OBU
+{
+  unsigned   type{};
+  ByteVector payload;
+};
+using TemporalUnit = std::vector<OBU>;
+
+// Two coded video sequences with a key frame followed by inter frames
+std::vector<TemporalUnit> createTemporalUnits()
+{
+  const auto sequenceHeader = OBU({OBU_SEQUENCE_HEADER, createSequenceHeaderPayload()});
+  const auto delimiter      = OBU({OBU_TEMPORAL_DELIMITER, {}});
+  const auto keyFrame       = OBU({OBU_FRAME, createFramePayload(true)});
+  const auto interFrame     = OBU({OBU_FRAME, createFramePayload(false)});
+
+  return {{delimiter, sequenceHeader, keyFrame},
+          {delimiter, interFrame},
+          {delimiter, interFrame},
+          {delimiter, sequenceHeader, keyFrame},
+          {delimiter, interFrame}};
+}
+
+void appendLEB128(ByteVector &data, size_t value)
+{
+  do
+  {
+    auto byte = static_cast<unsigned char>(value & 0x7f);
+    value >>= 7;
+    if (value > 0)
+      byte |= 0x80;
+    data.push_back(byte);
+  } while (value > 0);
+}
+
+void appendLittleEndian(ByteVector &data, const uint64_t value, const unsigned nrBytes)
+{
+  for (unsigned i = 0; i < nrBytes; i++)
+    data.push_back(static_cast<unsigned char>((value >> (i * 8)) & 0xff));
+}
+
+ByteVector encodeOBU(const OBU &obu, const bool withSizeField)
+{
+  ByteVector data;
+  data.push_back(static_cast<unsigned char>((obu.type << 3) | (withSizeField ? 0x02 : 0x00)));
+  if (withSizeField)
+    appendLEB128(data, obu.payload.size());
+  data.insert(data.end(), obu.payload.begin(), obu.payload.end());
+  return data;
+}
+
+ByteVector encodeLowOverheadTemporalUnit(const TemporalUnit &temporalUnit)
+{
+  ByteVector data;
+  for (const auto &obu : temporalUnit)
+  {
+    const auto encoded = encodeOBU(obu, true);
+    data.insert(data.end(), encoded.begin(), encoded.end());
+  }
+  return data;
+}
+
+ByteVector createFile(const FileFormat format, const std::vector<TemporalUnit> &temporalUnits)
+{
+  ByteVector data;
+  if (format == FileFormat::IVF)
+  {
+    data = {'D', 'K', 'I', 'F', 0, 0, 32, 0, 'A', 'V', '0', '1'};
+    appendLittleEndian(data, 64, 2);
+    appendLittleEndian(data, 48, 2);
+    appendLittleEndian(data, 50, 4); // Time base denominator
+    appendLittleEndian(data, 1, 4);  // Time base numerator
+    appendLittleEndian(data, temporalUnits.size(), 4);
+    appendLittleEndian(data, 0, 4);
+
+    uint64_t pts = 0;
+    for (const auto &temporalUnit : temporalUnits)
+    {
+      const auto frameData = encodeLowOverheadTemporalUnit(temporalUnit);
+      appendLittleEndian(data, frameData.size(), 4);
+      appendLittleEndian(data, pts, 8);
+      data.insert(data.end(), frameData.begin(), frameData.end());
+      pts += 2;
+    }
+  }
+  else if (format == FileFormat::LowOverhead)
+  {
+    for (const auto &temporalUnit : temporalUnits)
+    {
+      const auto frameData = encodeLowOverheadTemporalUnit(temporalUnit);
+      data.insert(data.end(), frameData.begin(), frameData.end());
+    }
+  }
+  else if (format == FileFormat::AnnexB)
+  {
+    // One frame unit per temporal unit. The OBUs have no size fields.
+    for (const auto &temporalUnit : temporalUnits)
+    {
+      ByteVector frameUnit;
+      for (const auto &obu : temporalUnit)
+      {
+        const auto encoded = encodeOBU(obu, false);
+        appendLEB128(frameUnit, encoded.size());
+        frameUnit.insert(frameUnit.end(), encoded.begin(), encoded.end());
+      }
+      ByteVector frameUnitWithSize;
+      appendLEB128(frameUnitWithSize, frameUnit.size());
+      frameUnitWithSize.insert(frameUnitWithSize.end(), frameUnit.begin(), frameUnit.end());
+
+      appendLEB128(data, frameUnitWithSize.size());
+      data.insert(data.end(), frameUnitWithSize.begin(), frameUnitWithSize.end());
+    }
+  }
+  return data;
+}
+
+QByteArray toQByteArray(const ByteVector &data)
+{
+  return QByteArray(reinterpret_cast<const char *>(data.data()), static_cast<int>(data.size()));
+}
+
+class FileSourceAV1OBUTest : public TestWithParam<FileFormat>
+{
+};
+
+std::string getTestName(const testing::TestParamInfo<FileFormat> &testParam)
+{
+  switch (testParam.param)
+  {
+  case FileFormat::IVF:
+    return "IVF";
+  case FileFormat::LowOverhead:
+    return "LowOverhead";
+  case FileFormat::AnnexB:
+    return "AnnexB";
+  default:
+    return "Unknown";
+  }
+}
+
+TEST_P(FileSourceAV1OBUTest, IndexAndReadTemporalUnits)
+{
+  const auto format        = GetParam();
+  const auto temporalUnits = createTemporalUnits();
+  yuviewTest::TemporaryFile temporaryFile(createFile(format, temporalUnits));
+
+  EXPECT_EQ(FileSourceAV1OBUFile::detectFileFormat(temporaryFile.getFilePath()), format);
+
+  FileSourceAV1OBUFile file(temporaryFile.getFilePath());
+  ASSERT_TRUE(file.isOk());
+  EXPECT_EQ(file.getFileFormat(), format);
+  ASSERT_EQ(file.getNumberFrames(), temporalUnits.size());
+  EXPECT_EQ(file.getNumberOBUs(), 12u);
+
+  EXPECT_EQ(file.getSequenceSizeSamples(), Size(64, 48));
+  EXPECT_EQ(file.getPixelFormatYUV(),
+            video::yuv::PixelFormatYUV(video::yuv::Subsampling::YUV_420, 8));
+  EXPECT_EQ(file.getProfileLevel(), IntPair({0, 4}));
+
+  std::vector<bool> randomAccessPoints;
+  for (size_t i = 0; i < file.getNumberFrames(); i++)
+    randomAccessPoints.push_back(file.getTemporalUnit(i)->randomAccessPoint);
+  EXPECT_THAT(randomAccessPoints, ElementsAre(true, false, false, true, false));
+
+  EXPECT_EQ(file.getClosestSeekableFrameBefore(2)->frame, 0u);
+  EXPECT_EQ(file.getClosestSeekableFrameBefore(4)->frame, 3u);
+
+  const auto sequenceHeader = toQByteArray(encodeOBU(temporalUnits[0][1], true));
+  EXPECT_EQ(file.getSequenceHeader(4), sequenceHeader);
+
+  // All formats are returned in the low overhead format
+  for (size_t i = 0; i < temporalUnits.size(); i++)
+    EXPECT_EQ(file.getNextTemporalUnit(),
+              toQByteArray(encodeLowOverheadTemporalUnit(temporalUnits[i])));
+  EXPECT_TRUE(file.atEnd());
+  EXPECT_TRUE(file.getNextTemporalUnit().isEmpty());
+
+  ASSERT_TRUE(file.seekToFrame(3));
+  const auto expectedUnit = toQByteArray(encodeLowOverheadTemporalUnit(temporalUnits[3]));
+  EXPECT_EQ(file.getNextTemporalUnit(), expectedUnit);
+  EXPECT_EQ(file.getNextTemporalUnit(true), expectedUnit);
+  EXPECT_FALSE(file.atEnd());
+
+  // A second instance shares the index with the first one
+  FileSourceAV1OBUFile otherFile;
+  ASSERT_TRUE(otherFile.openFile(temporaryFile.getFilePath(), file));
+  EXPECT_EQ(otherFile.getNumberFrames(), temporalUnits.size());
+  EXPECT_EQ(otherFile.getNextTemporalUnit(),
+            toQByteArray(encodeLowOverheadTemporalUnit(temporalUnits[0])));
+}
+
+INSTANTIATE_TEST_SUITE_P(FilesourceTest,
+                         FileSourceAV1OBUTest,
+                         Values(FileFormat::IVF, FileFormat::LowOverhead, FileFormat::AnnexB),
+                         getTestName);
+
+TEST(FileSourceAV1OBUTest, FramerateFromIVFTimeBase)
+{
+  yuviewTest::TemporaryFile temporaryFile(createFile(FileFormat::IVF, createTemporalUnits()));
+
+  // The time base is 1/50 and the pts increases by 2 per frame
+  FileSourceAV1OBUFile file(temporaryFile.getFilePath());
+  EXPECT_DOUBLE_EQ(file.getFramerate(), 25.0);
+}
+
+TEST(FileSourceAV1OBUTest, SplitTemporalUnitIntoOBUs)
+{
+  const auto temporalUnit = createTemporalUnits().at(0);
+  const auto data         = toQByteArray(encodeLowOverheadTemporalUnit(temporalUnit));
+
+  const auto obus = FileSourceAV1OBUFile::splitIntoOBUs(data);
+  ASSERT_EQ(obus.size(), 3u);
+  EXPECT_EQ(obus[0], std::make_pair(size_t(0), size_t(2)));
+  EXPECT_EQ(obus[1].first, size_t(2));
+  EXPECT_EQ(obus[1].second, encodeOBU(temporalUnit[1], true).size());
+  EXPECT_EQ(obus[2].first + obus[2].second, static_cast<size_t>(data.size()));
+}
+
+TEST(FileSourceAV1OBUTest, RejectUnknownData)
+{
+  yuviewTest::TemporaryFile temporaryFile(ByteVector(1000, 0xff));
+
+  EXPECT_EQ(FileSourceAV1OBUFile::detectFileFormat(temporaryFile.getFilePath()),
+            FileFormat::Unknown);
+  FileSourceAV1OBUFile file;
+  EXPECT_FALSE(file.openFile(temporaryFile.getFilePath()));
+  EXPECT_EQ(file.getNumberFrames(), 0u);
+}
+
+} // namespace
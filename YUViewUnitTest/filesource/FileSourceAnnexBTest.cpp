@@ -117,10 +117,30 @@ TEST_P(FileSourceAnnexBTest, TestNalUnitParsing)
   while (nalData.size() > 0)
   {
     EXPECT_EQ(nalSizes.at(counter++), static_cast<int>(nalData.size()));
+    EXPECT_EQ(nalData.at(testParameters.startCodeLength - 1), char(1));
     nalData = annexBFile.getNextNALUnit();
   }
 }
 
+TEST_P(FileSourceAnnexBTest, TestContinueReadingFromNextNalUnitPos)
+{
+  const auto testParameters = GetParam();
+
+  const auto data = generateAnnexBStream(testParameters).second;
+  yuviewTest::TemporaryFile temporaryFile(data);
+
+  // A second reader that seeks to the position of the next NAL unit must continue with the same
+  // NAL unit as the first reader.
+  FileSourceAnnexBFile annexBFile(temporaryFile.getFilePath());
+  FileSourceAnnexBFile seekingAnnexBFile(temporaryFile.getFilePath());
+  while (!annexBFile.atEnd())
+  {
+    EXPECT_TRUE(seekingAnnexBFile.seek(int64_t(annexBFile.getNextNALUnitPos())));
+    const auto nalData = annexBFile.getNextNALUnit();
+    EXPECT_EQ(seekingAnnexBFile.getNextNALUnit(), nalData);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     FilesourceTest,
     FileSourceAnnexBTest,
@@ -0,0 +1,107 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/HeadTailChecksums.h>
+
+#include <fstream>
+
+namespace
+{
+
+constexpr int64_t FILE_SIZE = 200000;
+
+ByteVector createData()
+{
+  ByteVector data(FILE_SIZE);
+  for (int64_t i = 0; i < FILE_SIZE; i++)
+    data[i] = static_cast<unsigned char>(i * 7);
+  return data;
+}
+
+void writeToFile(const std::filesystem::path &filePath, const ByteVector &data, bool append)
+{
+  const auto mode = std::ios::binary | (append ? std::ios::app : std::ios::trunc);
+  std::ofstream stream(filePath, mode);
+  stream.write(reinterpret_cast<const char *>(data.data()), std::streamsize(data.size()));
+}
+
+TEST(HeadTailChecksumsTest, ChecksumsAreUnchangedWhenDataIsAppended)
+{
+  const auto                data = createData();
+  yuviewTest::TemporaryFile file(data);
+
+  FileSource fileSource;
+  ASSERT_TRUE(fileSource.openFile(file.getFilePath()));
+  const auto checksums = filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE);
+  ASSERT_TRUE(checksums);
+
+  writeToFile(file.getFilePath(), ByteVector(100, 1), true);
+  EXPECT_EQ(filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE), checksums);
+  EXPECT_NE(filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE + 100), checksums);
+}
+
+TEST(HeadTailChecksumsTest, ModificationsAtTheStartAndTheEndAreDetected)
+{
+  auto                      data = createData();
+  yuviewTest::TemporaryFile file(data);
+
+  FileSource fileSource;
+  ASSERT_TRUE(fileSource.openFile(file.getFilePath()));
+  const auto checksums = filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE);
+  ASSERT_TRUE(checksums);
+
+  data[10]++;
+  writeToFile(file.getFilePath(), data, false);
+  EXPECT_NE(filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE), checksums);
+
+  data[10]--;
+  data[FILE_SIZE - 10]++;
+  writeToFile(file.getFilePath(), data, false);
+  EXPECT_NE(filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE), checksums);
+}
+
+TEST(HeadTailChecksumsTest, NoChecksumsForTruncatedFile)
+{
+  const auto                data = createData();
+  yuviewTest::TemporaryFile file(data);
+
+  FileSource fileSource;
+  ASSERT_TRUE(fileSource.openFile(file.getFilePath()));
+
+  writeToFile(file.getFilePath(), ByteVector(100, 1), false);
+  EXPECT_FALSE(filesource::calculateHeadTailChecksums(fileSource, FILE_SIZE));
+}
+
+} // namespace
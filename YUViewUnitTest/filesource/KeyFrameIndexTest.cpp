@@ -0,0 +1,96 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <filesource/KeyFrameIndex.h>
+
+namespace filesource::test
+{
+
+namespace
+{
+
+// 30 frames with a keyframe every 8 frames starting at frame 2. The DTS is 10 times the frame
+// index.
+void fillIndex(KeyFrameIndex &index)
+{
+  for (int frame = 0; frame < 30; frame++)
+    index.addFrame(frame * 10, frame >= 2 && (frame - 2) % 8 == 0);
+}
+
+} // namespace
+
+TEST(KeyFrameIndexTest, EmptyIndexHasNoLimitsAndNoSeekPoints)
+{
+  KeyFrameIndex index;
+  EXPECT_EQ(index.getNumberFrames(), 0u);
+  EXPECT_FALSE(index.getDecodableFrameLimits());
+  EXPECT_FALSE(index.getClosestSeekableFrameBefore(10));
+  EXPECT_FALSE(index.isComplete());
+}
+
+TEST(KeyFrameIndexTest, CountFramesAndKeyframes)
+{
+  KeyFrameIndex index;
+  fillIndex(index);
+  index.setComplete();
+
+  EXPECT_EQ(index.getNumberFrames(), 30u);
+  EXPECT_EQ(index.getNumberKeyframes(), 4u);
+  EXPECT_TRUE(index.isComplete());
+
+  const auto limits = index.getDecodableFrameLimits();
+  ASSERT_TRUE(limits);
+  EXPECT_EQ(limits->first, 2);
+  EXPECT_EQ(limits->second, 30);
+}
+
+TEST(KeyFrameIndexTest, ClosestSeekableFrameBefore)
+{
+  KeyFrameIndex index;
+  fillIndex(index);
+
+  // Pairs of (requested frame, expected keyframe)
+  const std::vector<std::pair<int, size_t>> testValues(
+      {{-1, 2}, {0, 2}, {2, 2}, {9, 2}, {10, 10}, {17, 10}, {18, 18}, {29, 26}, {100, 26}});
+
+  for (const auto &[frameIdx, expectedKeyframe] : testValues)
+  {
+    const auto seekPoint = index.getClosestSeekableFrameBefore(frameIdx);
+    ASSERT_TRUE(seekPoint) << "Frame " << frameIdx;
+    EXPECT_EQ(seekPoint->frame, expectedKeyframe) << "Frame " << frameIdx;
+    EXPECT_EQ(seekPoint->dts, int64_t(expectedKeyframe * 10)) << "Frame " << frameIdx;
+  }
+}
+
+} // namespace filesource::test
@@ -0,0 +1,135 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/Y4MFrameIndex.h>
+
+#include <fstream>
+
+namespace
+{
+
+constexpr int64_t FRAME_SIZE = 96; // 8x8 4:2:0
+
+const std::string Y4M_HEADER = "YUV4MPEG2 W8 H8 F25:1 C420jpeg\n";
+
+ByteVector createFrame(const std::string &frameHeader = "FRAME\n")
+{
+  ByteVector frame(frameHeader.begin(), frameHeader.end());
+  frame.insert(frame.end(), FRAME_SIZE, char(128));
+  return frame;
+}
+
+void appendToFile(const std::filesystem::path &filePath, const ByteVector &data)
+{
+  std::ofstream stream(filePath, std::ios::binary | std::ios::app);
+  stream.write(reinterpret_cast<const char *>(data.data()), std::streamsize(data.size()));
+}
+
+TEST(Y4MFrameIndexTest, FramesWithParametersAreIndexed)
+{
+  ByteVector data(Y4M_HEADER.begin(), Y4M_HEADER.end());
+  for (const auto &frameHeader : {"FRAME\n", "FRAME Ixyz\n", "FRAME\n"})
+  {
+    const auto frame = createFrame(frameHeader);
+    data.insert(data.end(), frame.begin(), frame.end());
+  }
+  yuviewTest::TemporaryFile y4mFile(data);
+
+  FileSource file;
+  ASSERT_TRUE(file.openFile(y4mFile.getFilePath()));
+
+  filesource::Y4MFrameIndex index;
+  index.reset(int64_t(Y4M_HEADER.size()), FRAME_SIZE);
+  EXPECT_FALSE(index.indexFrames(file, false));
+
+  const auto headerSize = int64_t(Y4M_HEADER.size());
+  ASSERT_EQ(index.getNumberFrames(), 3u);
+  EXPECT_EQ(index.getFrameDataOffset(0), headerSize + 6);
+  EXPECT_EQ(index.getFrameDataOffset(1), headerSize + 6 + FRAME_SIZE + 11);
+  EXPECT_EQ(index.getFrameDataOffset(2), headerSize + 6 + FRAME_SIZE + 11 + FRAME_SIZE + 6);
+  EXPECT_FALSE(index.getFrameDataOffset(3));
+  EXPECT_FALSE(index.getFrameDataOffset(-1));
+}
+
+TEST(Y4MFrameIndexTest, IndexingResumesWhenFramesAreAppended)
+{
+  const auto frame = createFrame();
+
+  ByteVector data(Y4M_HEADER.begin(), Y4M_HEADER.end());
+  data.insert(data.end(), frame.begin(), frame.end());
+  // Only a part of the frame indicator of the second frame was written
+  data.insert(data.end(), frame.begin(), frame.begin() + 3);
+  yuviewTest::TemporaryFile y4mFile(data);
+
+  FileSource file;
+  ASSERT_TRUE(file.openFile(y4mFile.getFilePath()));
+
+  filesource::Y4MFrameIndex index;
+  index.reset(int64_t(Y4M_HEADER.size()), FRAME_SIZE);
+  EXPECT_FALSE(index.indexFrames(file, true));
+  EXPECT_EQ(index.getNumberFrames(), 1u);
+
+  // The second frame is complete but only a part of the data of the third frame is written
+  appendToFile(y4mFile.getFilePath(), ByteVector(frame.begin() + 3, frame.end()));
+  appendToFile(y4mFile.getFilePath(), ByteVector(frame.begin(), frame.begin() + 50));
+  EXPECT_FALSE(index.indexFrames(file, true));
+  EXPECT_EQ(index.getNumberFrames(), 2u);
+
+  appendToFile(y4mFile.getFilePath(), ByteVector(frame.begin() + 50, frame.end()));
+  EXPECT_FALSE(index.indexFrames(file, true));
+  ASSERT_EQ(index.getNumberFrames(), 3u);
+  EXPECT_EQ(index.getFrameDataOffset(2), int64_t(Y4M_HEADER.size() + 2 * frame.size() + 6));
+
+  // Nothing new
+  EXPECT_FALSE(index.indexFrames(file, true));
+  EXPECT_EQ(index.getNumberFrames(), 3u);
+}
+
+TEST(Y4MFrameIndexTest, MissingFrameIndicatorIsAnError)
+{
+  ByteVector data(Y4M_HEADER.begin(), Y4M_HEADER.end());
+  data.insert(data.end(), 200, char(128));
+  yuviewTest::TemporaryFile y4mFile(data);
+
+  FileSource file;
+  ASSERT_TRUE(file.openFile(y4mFile.getFilePath()));
+
+  filesource::Y4MFrameIndex index;
+  index.reset(int64_t(Y4M_HEADER.size()), FRAME_SIZE);
+  EXPECT_TRUE(index.indexFrames(file, false));
+  EXPECT_EQ(index.getNumberFrames(), 0u);
+}
+
+} // namespace
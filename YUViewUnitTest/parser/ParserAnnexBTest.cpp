@@ -0,0 +1,177 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <parser/ParserAnnexB.h>
+
+#include <fstream>
+
+namespace
+{
+
+constexpr auto NAL_PAYLOAD_SIZE = 50;
+
+// A NAL unit of the test bitstream: A start code, the POC, the size of the payload and the payload.
+ByteVector createNALUnit(int poc)
+{
+  ByteVector nal = {0, 0, 1, static_cast<unsigned char>(poc), NAL_PAYLOAD_SIZE};
+  nal.insert(nal.end(), NAL_PAYLOAD_SIZE, 128);
+  return nal;
+}
+
+ByteVector createNALUnits(const std::vector<int> &pocs)
+{
+  ByteVector data;
+  for (const auto poc : pocs)
+  {
+    const auto nal = createNALUnit(poc);
+    data.insert(data.end(), nal.begin(), nal.end());
+  }
+  return data;
+}
+
+void appendToFile(const std::filesystem::path &filePath, const ByteVector &data)
+{
+  std::ofstream stream(filePath, std::ios::binary | std::ios::app);
+  stream.write(reinterpret_cast<const char *>(data.data()), std::streamsize(data.size()));
+}
+
+// Every NAL unit is a frame (a random access point). Like the real parsers, a frame is only added
+// to the frame list once the next frame starts or the end of the file is reached.
+class ParserAnnexBTestStream : public parser::ParserAnnexB
+{
+public:
+  ParseResult parseAndAddNALUnit(int                                           nalID,
+                                 ByteSpan                                      data,
+                                 std::optional<BitratePlotModel::BitrateEntry> bitrateEntry,
+                                 std::optional<pairUint64>                     nalStartEndPosFile,
+                                 std::shared_ptr<TreeItem>                     parent) override
+  {
+    (void)bitrateEntry;
+    (void)parent;
+
+    ParseResult result;
+    result.success = true;
+    if (nalID == -1 && data.empty())
+    {
+      if (this->currentFrame)
+        this->addFrameToList(this->currentFrame->first, this->currentFrame->second, true, 0);
+      return result;
+    }
+
+    if (data.size() < 5 || data.size() != size_t(5 + data[4]))
+    {
+      this->nrIncompleteNALUnits++;
+      return result;
+    }
+
+    if (this->currentFrame)
+      this->addFrameToList(this->currentFrame->first, this->currentFrame->second, true, 0);
+    this->currentFrame = {int(data[3]), *nalStartEndPosFile};
+    return result;
+  }
+
+  double                     getFramerate() const override { return 25.0; }
+  Size                       getSequenceSizeSamples() const override { return {}; }
+  video::yuv::PixelFormatYUV getPixelFormat() const override { return {}; }
+  std::optional<SeekData>    getSeekData(int) override { return {}; }
+  QByteArray                 getExtradata() override { return {}; }
+  IntPair                    getProfileLevel() override { return {}; }
+  Ratio                      getSampleAspectRatio() override { return {1, 1}; }
+
+  int nrIncompleteNALUnits{};
+
+private:
+  std::optional<std::pair<int, pairUint64>> currentFrame;
+};
+
+TEST(ParserAnnexBTest, ParsingResumesWhenDataIsAppendedWithinANALUnit)
+{
+  const auto nalSize = int(createNALUnit(0).size());
+
+  auto data = createNALUnits({0, 1, 2});
+  data.resize(data.size() - 30);
+  yuviewTest::TemporaryFile annexBFile(data);
+
+  ParserAnnexBTestStream parser;
+  {
+    auto file = std::make_unique<FileSourceAnnexBFile>(annexBFile.getFilePath());
+    parser.parseAnnexBFile(file, nullptr, true);
+  }
+  // The incomplete last NAL unit is held back
+  EXPECT_EQ(parser.getNumberPOCs(), 2u);
+  EXPECT_EQ(parser.nrIncompleteNALUnits, 0);
+
+  const auto fullData = createNALUnits({0, 1, 2, 3});
+  appendToFile(annexBFile.getFilePath(),
+               ByteVector(fullData.begin() + data.size(), fullData.end()));
+
+  // The now complete NAL unit is parsed. The last NAL unit could still be incomplete.
+  auto firstChangedFrame = parser.resumeParsingAnnexBFile(annexBFile.getFilePath(), true);
+  ASSERT_TRUE(firstChangedFrame);
+  EXPECT_EQ(*firstChangedFrame, 2u);
+  EXPECT_EQ(parser.getNumberPOCs(), 3u);
+  EXPECT_EQ(parser.getFrameStartEndPos(2)->first, uint64_t(2 * nalSize));
+
+  // The file did not grow anymore so the last NAL unit is complete
+  firstChangedFrame = parser.resumeParsingAnnexBFile(annexBFile.getFilePath(), false);
+  ASSERT_TRUE(firstChangedFrame);
+  EXPECT_EQ(*firstChangedFrame, 3u);
+  EXPECT_EQ(parser.getNumberPOCs(), 4u);
+  EXPECT_EQ(parser.getFrameStartEndPos(3)->first, uint64_t(3 * nalSize));
+  EXPECT_EQ(parser.nrIncompleteNALUnits, 0);
+
+  EXPECT_FALSE(parser.resumeParsingAnnexBFile(annexBFile.getFilePath(), false));
+  EXPECT_EQ(parser.getNumberPOCs(), 4u);
+}
+
+TEST(ParserAnnexBTest, ResumingReportsFramesInsertedInDisplayOrder)
+{
+  yuviewTest::TemporaryFile annexBFile(createNALUnits({0, 3}));
+
+  ParserAnnexBTestStream parser;
+  {
+    auto file = std::make_unique<FileSourceAnnexBFile>(annexBFile.getFilePath());
+    parser.parseAnnexBFile(file);
+  }
+  EXPECT_EQ(parser.getNumberPOCs(), 2u);
+
+  appendToFile(annexBFile.getFilePath(), createNALUnits({1, 2}));
+  const auto firstChangedFrame = parser.resumeParsingAnnexBFile(annexBFile.getFilePath(), false);
+  ASSERT_TRUE(firstChangedFrame);
+  EXPECT_EQ(*firstChangedFrame, 1u);
+  EXPECT_EQ(parser.getNumberPOCs(), 4u);
+}
+
+} // namespace
@@ -0,0 +1,156 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <parser/common/SeekIndex.h>
+
+namespace parser::test
+{
+
+namespace
+{
+
+using CodedFrames = std::vector<SeekIndex::CodedFrame>;
+
+TEST(SeekIndexTest, ClosedGOPs)
+{
+  // I0 P4 B2 B1 B3 | I8 P12 B10 B9 B11 (coding order)
+  const CodedFrames frames = {{0, true},
+                              {4, false},
+                              {2, false},
+                              {1, false},
+                              {3, false},
+                              {8, true},
+                              {12, false},
+                              {10, false},
+                              {9, false},
+                              {11, false}};
+  const SeekIndex   index(frames);
+  EXPECT_EQ(index.getNumberFrames(), 10u);
+
+  // Display order: 0 1 2 3 4 8 9 10 11 12
+  const auto poc3 = index.getEntry(3);
+  ASSERT_TRUE(poc3);
+  EXPECT_EQ(poc3->codingIndex, 4u);
+  EXPECT_EQ(poc3->seekPointDisplayIndex, 0u);
+  EXPECT_EQ(poc3->decodeCost, 5u);
+
+  const auto poc8 = index.getEntry(5);
+  ASSERT_TRUE(poc8);
+  EXPECT_EQ(poc8->seekPointDisplayIndex, 5u);
+  EXPECT_EQ(poc8->seekPointCodingIndex, 5u);
+  EXPECT_EQ(poc8->decodeCost, 1u);
+
+  const auto poc9 = index.getEntry(6);
+  ASSERT_TRUE(poc9);
+  EXPECT_EQ(poc9->seekPointDisplayIndex, 5u);
+  EXPECT_EQ(poc9->decodeCost, 4u);
+
+  EXPECT_FALSE(index.getEntry(10));
+}
+
+TEST(SeekIndexTest, LeadingPicturesUsePreviousRandomAccessPoint)
+{
+  // Open GOP: The CRA with POC 8 is followed by leading pictures 5, 6 and 7
+  const CodedFrames frames = {
+      {0, true}, {4, false}, {2, false}, {8, true}, {6, false}, {5, false}, {7, false}};
+  const SeekIndex index(frames);
+
+  // Display order: 0 2 4 5 6 7 8
+  const auto poc5 = index.getEntry(3);
+  ASSERT_TRUE(poc5);
+  EXPECT_EQ(poc5->seekPointDisplayIndex, 0u);
+  EXPECT_EQ(poc5->decodeCost, 6u);
+
+  const auto poc8 = index.getEntry(6);
+  ASSERT_TRUE(poc8);
+  EXPECT_EQ(poc8->seekPointDisplayIndex, 6u);
+  EXPECT_EQ(poc8->seekPointCodingIndex, 3u);
+  EXPECT_EQ(poc8->decodeCost, 1u);
+}
+
+TEST(SeekIndexTest, GOPsEndBeforeTheNextRandomAccessPoint)
+{
+  // Open GOP: The leading pictures 5, 6 and 7 of the CRA with POC 8 belong to the first GOP
+  const CodedFrames frames = {{0, true},
+                              {4, false},
+                              {2, false},
+                              {8, true},
+                              {6, false},
+                              {5, false},
+                              {7, false},
+                              {12, false},
+                              {10, false}};
+  const SeekIndex   index(frames);
+
+  // Display order: 0 2 4 5 6 7 8 10 12
+  for (const unsigned frame : {0u, 3u, 5u})
+  {
+    const auto gop = index.getGOP(frame);
+    ASSERT_TRUE(gop);
+    EXPECT_EQ(gop->firstFrame, 0u);
+    EXPECT_EQ(gop->lastFrame, 5u);
+  }
+
+  for (const unsigned frame : {6u, 8u})
+  {
+    const auto gop = index.getGOP(frame);
+    ASSERT_TRUE(gop);
+    EXPECT_EQ(gop->firstFrame, 6u);
+    EXPECT_EQ(gop->lastFrame, 8u);
+  }
+
+  EXPECT_FALSE(index.getGOP(9));
+}
+
+TEST(SeekIndexTest, DecodeCostFromCurrentFrame)
+{
+  const CodedFrames frames = {{0, true}, {4, false}, {2, false}, {1, false}, {3, false},
+                              {8, true}, {6, false}, {5, false}, {7, false}};
+  const SeekIndex   index(frames);
+
+  // Display order: 0 1 2 3 4 5 6 7 8
+  // When POC 2 is output, POC 1 (coding index 3) was decoded so POC 4 is also decoded
+  EXPECT_EQ(index.getDecodeCostFromFrame(2, 4), 0u);
+  EXPECT_EQ(index.getDecodeCostFromFrame(1, 3), 1u);
+  EXPECT_EQ(index.getDecodeCostFromFrame(4, 7), 4u);
+
+  // Decoding can not go backwards
+  EXPECT_FALSE(index.getDecodeCostFromFrame(4, 4));
+  EXPECT_FALSE(index.getDecodeCostFromFrame(4, 2));
+  EXPECT_FALSE(index.getDecodeCostFromFrame(4, 9));
+}
+
+} // namespace
+
+} // namespace parser::test
@@ -37,8 +37,8 @@
 namespace yuviewTest::statistics
 {
 
-void checkVectorList(const std::vector<stats::StatsItemVector> &vectors,
-                     const std::vector<CheckStatsItem>         &checkItems)
+void checkVectorList(const stats::VectorList           &vectors,
+                     const std::vector<CheckStatsItem> &checkItems)
 {
   EXPECT_EQ(vectors.size(), checkItems.size());
   for (unsigned i = 0; i < vectors.size(); i++)
@@ -54,8 +54,8 @@ void checkVectorList(const std::vector<stats::StatsItemVector> &vectors,
   }
 }
 
-void checkValueList(const std::vector<stats::StatsItemValue> &values,
-                    const std::vector<CheckStatsItem>        &checkItems)
+void checkValueList(const stats::ValueList            &values,
+                    const std::vector<CheckStatsItem> &checkItems)
 {
   EXPECT_EQ(values.size(), checkItems.size());
   for (unsigned i = 0; i < values.size(); i++)
@@ -70,8 +70,8 @@ void checkValueList(const std::vector<stats::StatsItemValue> &values,
   }
 }
 
-void checkAffineTFVectorList(const std::vector<stats::StatsItemAffineTF> &affineTFvectors,
-                             const std::vector<CheckAffineTFItem>        &checkItems)
+void checkAffineTFVectorList(const stats::AffineTFList            &affineTFvectors,
+                             const std::vector<CheckAffineTFItem> &checkItems)
 {
   EXPECT_EQ(affineTFvectors.size(), checkItems.size());
   for (unsigned i = 0; i < affineTFvectors.size(); i++)
@@ -91,8 +91,8 @@ void checkAffineTFVectorList(const std::vector<stats::StatsItemAffineTF> &affine
   }
 }
 
-void checkLineList(const std::vector<stats::StatsItemVector> &lines,
-                   const std::vector<CheckLineItem>          &checkItems)
+void checkLineList(const stats::VectorList          &lines,
+                   const std::vector<CheckLineItem> &checkItems)
 {
   EXPECT_EQ(lines.size(), checkItems.size());
   for (unsigned i = 0; i < lines.size(); i++)
@@ -110,8 +110,8 @@ void checkLineList(const std::vector<stats::StatsItemVector> &lines,
   }
 }
 
-void checkPolygonvectorList(const std::vector<stats::StatsItemPolygonVector> &polygonList,
-                            const std::vector<CheckPolygonVectorItem>        &checkItems)
+void checkPolygonvectorList(const stats::PolygonVectorList            &polygonList,
+                            const std::vector<CheckPolygonVectorItem> &checkItems)
 {
   EXPECT_EQ(polygonList.size(), checkItems.size());
   for (unsigned i = 0; i < polygonList.size(); i++)
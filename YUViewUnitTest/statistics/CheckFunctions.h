@@ -62,19 +62,19 @@ struct CheckPolygonVectorItem
   unsigned y[5];
 };
 
-void checkValueList(const std::vector<stats::StatsItemValue> &values,
-                    const std::vector<CheckStatsItem>        &checkItems);
+void checkValueList(const stats::ValueList            &values,
+                    const std::vector<CheckStatsItem> &checkItems);
 
-void checkVectorList(const std::vector<stats::StatsItemVector> &vectors,
-                     const std::vector<CheckStatsItem>         &checkItems);
+void checkVectorList(const stats::VectorList           &vectors,
+                     const std::vector<CheckStatsItem> &checkItems);
 
-void checkAffineTFVectorList(const std::vector<stats::StatsItemAffineTF> &affineTFvectors,
-                             const std::vector<CheckAffineTFItem>        &checkItems);
+void checkAffineTFVectorList(const stats::AffineTFList            &affineTFvectors,
+                             const std::vector<CheckAffineTFItem> &checkItems);
 
-void checkLineList(const std::vector<stats::StatsItemVector> &lines,
-                   const std::vector<CheckLineItem>          &checkItems);
+void checkLineList(const stats::VectorList          &lines,
+                   const std::vector<CheckLineItem> &checkItems);
 
-void checkPolygonvectorList(const std::vector<stats::StatsItemPolygonVector> &polygonList,
-                            const std::vector<CheckPolygonVectorItem>        &checkItems);
+void checkPolygonvectorList(const stats::PolygonVectorList            &polygonList,
+                            const std::vector<CheckPolygonVectorItem> &checkItems);
 
 } // namespace yuviewTest::statistics
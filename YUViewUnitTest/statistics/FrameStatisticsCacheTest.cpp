@@ -0,0 +1,136 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/FrameStatisticsCache.h>
+
+namespace
+{
+
+stats::FrameStatisticsCache::FrameData createFrameData(const int nrBlocks, const int value)
+{
+  stats::FrameStatisticsCache::FrameData frameData;
+  for (int i = 0; i < nrBlocks; ++i)
+    frameData[0].addBlockValue(i * 8, 0, 8, 8, value);
+  frameData[1].addBlockVector(0, 0, 16, 16, value, -value);
+  return frameData;
+}
+
+int64_t getFrameDataSize(const int nrBlocks)
+{
+  // All blocks have the same size so there is only one size run per type
+  const auto valueBytes  = nrBlocks * (2 * sizeof(unsigned short) + sizeof(int));
+  const auto vectorBytes = 2 * sizeof(unsigned short) + sizeof(stats::Point);
+  return valueBytes + vectorBytes + 2 * sizeof(stats::BlockSizeRun);
+}
+
+TEST(FrameStatisticsCacheTest, FramesCanBeRetrieved)
+{
+  stats::FrameStatisticsCache cache(1024 * 1024);
+
+  for (int frameIdx = 0; frameIdx < 8; ++frameIdx)
+    cache.addFrame(frameIdx, createFrameData(10, frameIdx));
+
+  EXPECT_EQ(cache.getNumberFrames(), 8);
+  EXPECT_EQ(cache.getUsedBytes(), 8 * getFrameDataSize(10));
+
+  for (int frameIdx = 7; frameIdx >= 0; --frameIdx)
+  {
+    const auto frameData = cache.getFrame(frameIdx);
+    ASSERT_TRUE(frameData);
+    ASSERT_EQ(frameData->size(), 2u);
+    ASSERT_EQ(frameData->at(0).valueData.size(), 10u);
+    EXPECT_EQ(frameData->at(0).valueData.at(3).value, frameIdx);
+    EXPECT_EQ(frameData->at(1).vectorData.at(0).point[0].y, -frameIdx);
+  }
+  EXPECT_FALSE(cache.getFrame(8));
+}
+
+TEST(FrameStatisticsCacheTest, ReplacingAFrameUpdatesTheUsedBytes)
+{
+  stats::FrameStatisticsCache cache(1024 * 1024);
+
+  cache.addFrame(3, createFrameData(10, 1));
+  cache.addFrame(3, createFrameData(2, 2));
+
+  EXPECT_EQ(cache.getNumberFrames(), 1);
+  EXPECT_EQ(cache.getUsedBytes(), getFrameDataSize(2));
+  EXPECT_EQ(cache.getFrame(3)->at(0).valueData.at(0).value, 2);
+
+  cache.clear();
+  EXPECT_EQ(cache.getNumberFrames(), 0);
+  EXPECT_EQ(cache.getUsedBytes(), 0);
+}
+
+TEST(FrameStatisticsCacheTest, LeastRecentlyUsedFramesAreDroppedWhenFull)
+{
+  const auto                  frameSize = getFrameDataSize(10);
+  stats::FrameStatisticsCache cache(frameSize * 3);
+
+  cache.addFrame(0, createFrameData(10, 0));
+  cache.addFrame(1, createFrameData(10, 1));
+  cache.addFrame(2, createFrameData(10, 2));
+  EXPECT_TRUE(cache.getFrame(0));
+
+  cache.addFrame(3, createFrameData(10, 3));
+  EXPECT_EQ(cache.getNumberFrames(), 3);
+  EXPECT_TRUE(cache.contains(0));
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_TRUE(cache.contains(2));
+  EXPECT_TRUE(cache.contains(3));
+
+  cache.setMaxBytes(frameSize);
+  EXPECT_EQ(cache.getNumberFrames(), 1);
+  EXPECT_TRUE(cache.contains(3));
+
+  // A frame that is larger than the whole budget is not added
+  cache.addFrame(4, createFrameData(20, 4));
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_TRUE(cache.contains(3));
+}
+
+TEST(FrameStatisticsCacheTest, RemoveFramesFromKeepsTheLowerFrames)
+{
+  stats::FrameStatisticsCache cache(1024 * 1024);
+  for (int frameIdx = 0; frameIdx < 6; ++frameIdx)
+    cache.addFrame(frameIdx, createFrameData(10, frameIdx));
+
+  cache.removeFramesFrom(4);
+  EXPECT_EQ(cache.getNumberFrames(), 4);
+  EXPECT_EQ(cache.getUsedBytes(), 4 * getFrameDataSize(10));
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_FALSE(cache.contains(5));
+}
+
+} // namespace
@@ -0,0 +1,99 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/FrameTypeData.h>
+
+namespace
+{
+
+TEST(FrameTypeDataTest, BlockSizesOfMixedGridsAreRestored)
+{
+  stats::FrameTypeData data;
+  for (unsigned short i = 0; i < 4; ++i)
+    data.addBlockValue(i * 4, 0, 4, 4, i);
+  data.addBlockValue(16, 0, 16, 8, 10);
+  data.addBlockValue(32, 0, 4, 4, 11);
+
+  ASSERT_EQ(data.valueData.size(), 6u);
+  EXPECT_EQ(data.valueData.columns.sizeRuns.size(), 3u);
+
+  const std::vector<unsigned short> expectedWidths = {4, 4, 4, 4, 16, 4};
+  size_t                            index          = 0;
+  for (const auto &valueItem : data.valueData)
+  {
+    const auto randomAccessItem = data.valueData.at(index);
+    EXPECT_EQ(valueItem.size[0], expectedWidths[index]);
+    EXPECT_EQ(randomAccessItem.size[0], expectedWidths[index]);
+    EXPECT_EQ(valueItem.pos[0], randomAccessItem.pos[0]);
+    EXPECT_EQ(valueItem.value, randomAccessItem.value);
+    ++index;
+  }
+  EXPECT_EQ(index, 6u);
+  EXPECT_EQ(data.valueData.at(4).size[1], 8);
+  EXPECT_EQ(data.maxBlockSize, 128u);
+  EXPECT_THROW(data.valueData.at(6), std::out_of_range);
+}
+
+TEST(FrameTypeDataTest, VectorsAndLinesCanBeMixed)
+{
+  stats::FrameTypeData data;
+  data.addBlockVector(0, 0, 8, 8, 1, 2);
+  data.addLine(8, 0, 8, 8, 3, 4, 5, 6);
+  data.addBlockVector(16, 0, 8, 8, 7, 8);
+
+  ASSERT_EQ(data.vectorData.size(), 3u);
+  EXPECT_FALSE(data.vectorData.at(0).isLine);
+  EXPECT_TRUE(data.vectorData.at(1).isLine);
+  EXPECT_FALSE(data.vectorData.at(2).isLine);
+  EXPECT_EQ(data.vectorData.at(1).point[1], stats::Point(5, 6));
+  EXPECT_EQ(data.vectorData.at(2).point[0], stats::Point(7, 8));
+}
+
+TEST(FrameTypeDataTest, PolygonsShareOneVertexBuffer)
+{
+  stats::FrameTypeData data;
+  data.addPolygonValue({{0, 0}, {4, 0}, {4, 4}}, 3);
+  data.addPolygonValue({{8, 8}, {12, 8}, {12, 12}, {8, 12}}, 7);
+
+  ASSERT_EQ(data.polygonValueData.size(), 2u);
+  EXPECT_EQ(data.polygonValueData.columns.vertices.size(), 7u);
+
+  const auto square = data.polygonValueData.at(1);
+  ASSERT_EQ(square.corners.size(), 4u);
+  EXPECT_EQ(square.corners.front(), stats::Point(8, 8));
+  EXPECT_EQ(square.corners.back(), stats::Point(8, 12));
+  EXPECT_EQ(square.value, 7);
+}
+
+} // namespace
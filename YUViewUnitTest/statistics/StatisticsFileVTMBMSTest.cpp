@@ -37,6 +37,8 @@
 #include <TemporaryFile.h>
 #include <statistics/StatisticsFileVTMBMS.h>
 
+#include <fstream>
+
 namespace
 {
 
@@ -217,4 +219,58 @@ TEST(StatisticsFileCSV, testCSVFileParsing)
       });
 }
 
+TEST(StatisticsFileVTMBMS, testResumeParsingOfAppendedData)
+{
+  yuviewTest::TemporaryFile vtmbmsFile(getVTMBSTestData());
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileVTMBMS statFile(QString::fromStdString(vtmbmsFile.getFilePathString()),
+                                       statData);
+
+  std::atomic_bool breakAtomic;
+  breakAtomic.store(false);
+  statFile.readFrameAndTypePositionsFromFile(std::ref(breakAtomic));
+  EXPECT_EQ(statFile.getMaxPoc(), 8);
+  EXPECT_FALSE(statFile.hasUnindexedData());
+
+  {
+    std::ofstream stream(vtmbmsFile.getFilePath(), std::ios::binary | std::ios::app);
+    stream << "BlockStat: POC 9 @(   0,   0) [64x64] PredMode=3\n";
+    stream << "BlockStat: POC 9 @(  64,   0) [64x64] PredMode=2\n";
+    // An incomplete line must not be indexed yet
+    stream << "BlockStat: POC 10 @(   0,   0) [64x";
+  }
+  EXPECT_TRUE(statFile.hasUnindexedData());
+
+  statFile.readFrameAndTypePositionsFromFile(std::ref(breakAtomic));
+  EXPECT_FALSE(statFile.isIndexedDataChanged());
+  EXPECT_EQ(statFile.getMaxPoc(), 9);
+  // The incomplete line is not parsed again as long as the file does not change
+  EXPECT_FALSE(statFile.hasUnindexedData());
+
+  statFile.loadStatisticData(statData, 9, 1);
+  EXPECT_EQ(statData.getFrameIndex(), 9);
+  yuviewTest::statistics::checkValueList(statData[1].valueData,
+                                         {{0, 0, 64, 64, 3}, {64, 0, 64, 64, 2}});
+
+  {
+    std::ofstream stream(vtmbmsFile.getFilePath(), std::ios::binary | std::ios::app);
+    stream << "64] PredMode=1\n";
+  }
+  EXPECT_TRUE(statFile.hasUnindexedData());
+  statFile.readFrameAndTypePositionsFromFile(std::ref(breakAtomic));
+  EXPECT_EQ(statFile.getMaxPoc(), 10);
+  EXPECT_FALSE(statFile.hasUnindexedData());
+
+  // Rewriting the already indexed data can not be handled by resuming
+  {
+    std::ofstream stream(vtmbmsFile.getFilePath(), std::ios::binary | std::ios::trunc);
+    stream << "# VTMBMS Block Statistics\n";
+  }
+  EXPECT_TRUE(statFile.hasUnindexedData());
+  statFile.readFrameAndTypePositionsFromFile(std::ref(breakAtomic));
+  EXPECT_TRUE(statFile.isIndexedDataChanged());
+  EXPECT_FALSE(statFile.hasUnindexedData());
+}
+
 } // namespace
@@ -0,0 +1,124 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/CacheEvictionPolicy.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+std::vector<int> getFrameIndices(const std::vector<CachedFrame> &frames)
+{
+  std::vector<int> indices;
+  for (const auto &frame : frames)
+    indices.push_back(frame.frameIndex);
+  return indices;
+}
+
+} // namespace
+
+TEST(CacheEvictionPolicyTest, PlaylistOrderKeepsOrder)
+{
+  std::vector<CachedFrame> frames = {{0, 5, 3}, {0, 1, 1}, {1, 3, 2}};
+
+  PlaylistOrderEvictionPolicy policy;
+  policy.orderForEviction(frames, EvictionContext());
+
+  EXPECT_EQ(getFrameIndices(frames), std::vector<int>({5, 1, 3}));
+}
+
+TEST(CacheEvictionPolicyTest, LeastRecentlyUsedRemovesOldestAccessFirst)
+{
+  std::vector<CachedFrame> frames = {{0, 0, 30}, {0, 1, 10}, {0, 2, 20}};
+
+  LeastRecentlyUsedEvictionPolicy policy;
+  policy.orderForEviction(frames, EvictionContext());
+
+  EXPECT_EQ(getFrameIndices(frames), std::vector<int>({1, 2, 0}));
+}
+
+TEST(CacheEvictionPolicyTest, DistanceFromPlayheadRemovesFarFramesFirst)
+{
+  std::vector<CachedFrame> frames = {{0, 11, 0}, {0, 30, 0}, {0, 8, 0}, {1, 10, 0}, {0, 10, 0}};
+
+  EvictionContext context;
+  context.playheadItemID     = 0;
+  context.playheadFrameIndex = 10;
+
+  DistanceFromPlayheadEvictionPolicy policy;
+  policy.orderForEviction(frames, context);
+
+  // The frame from the other item first. Frame 8 is behind the playhead which counts more than 2
+  // frames ahead.
+  EXPECT_EQ(getFrameIndices(frames), std::vector<int>({10, 30, 8, 11, 10}));
+  EXPECT_EQ(frames.front().itemID, 1);
+}
+
+TEST(CacheEvictionPolicyTest, DistanceFromPlayheadBackwards)
+{
+  std::vector<CachedFrame> frames = {{0, 9, 0}, {0, 12, 0}, {0, 4, 0}};
+
+  EvictionContext context;
+  context.playheadItemID     = 0;
+  context.playheadFrameIndex = 10;
+  context.playingBackwards   = true;
+
+  DistanceFromPlayheadEvictionPolicy policy;
+  policy.orderForEviction(frames, context);
+
+  EXPECT_EQ(getFrameIndices(frames), std::vector<int>({12, 4, 9}));
+}
+
+TEST(CacheEvictionPolicyTest, PinnedFramesAreNeverEvicted)
+{
+  std::vector<CachedFrame> frames = {{0, 1, 0}, {0, 5, 0}, {0, 6, 0}, {1, 5, 0}, {0, 9, 0}};
+
+  EvictionContext context;
+  context.playheadItemID = 0;
+  context.pinnedRange    = indexRange(4, 8);
+
+  for (const auto type : CacheEvictionPolicyTypeMapper.getValues())
+  {
+    auto framesToOrder = frames;
+    createCacheEvictionPolicy(type)->orderForEviction(framesToOrder, context);
+
+    EXPECT_EQ(framesToOrder.size(), std::size_t(3));
+    for (const auto &frame : framesToOrder)
+      EXPECT_FALSE(frame.itemID == 0 && frame.frameIndex >= 4 && frame.frameIndex <= 8);
+  }
+}
+
+} // namespace video::test
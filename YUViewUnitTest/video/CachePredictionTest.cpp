@@ -0,0 +1,98 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/CachePrediction.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+PlayheadState createState(int frameIndex, int step)
+{
+  PlayheadState state;
+  state.frameIndex = frameIndex;
+  state.step       = step;
+  return state;
+}
+
+} // namespace
+
+TEST(CachePredictionTest, ForwardPlaybackCachesFramesAheadFirst)
+{
+  const auto segments = getFramesInExpectedAccessOrder(indexRange(0, 9), createState(4, 1), 10);
+  EXPECT_EQ(segments, std::vector<indexRange>({{4, 9}, {3, 0}}));
+}
+
+TEST(CachePredictionTest, BackwardPlaybackCachesFramesBehindFirst)
+{
+  const auto segments = getFramesInExpectedAccessOrder(indexRange(0, 9), createState(4, -1), 3);
+  EXPECT_EQ(segments, std::vector<indexRange>({{4, 2}}));
+}
+
+TEST(CachePredictionTest, WrapAroundContinuesAtStartOfRange)
+{
+  auto state       = createState(7, 1);
+  state.wrapAround = true;
+
+  const auto segments = getFramesInExpectedAccessOrder(indexRange(0, 9), state, 5);
+  EXPECT_EQ(segments, std::vector<indexRange>({{7, 9}, {0, 1}}));
+}
+
+TEST(CachePredictionTest, LoopRangeIsCachedBeforeFramesOutsideOfIt)
+{
+  auto state      = createState(5, 1);
+  state.loopRange = indexRange(3, 6);
+
+  const auto segments = getFramesInExpectedAccessOrder(indexRange(0, 9), state, 10);
+  EXPECT_EQ(segments,
+            std::vector<indexRange>(
+                {{5, 6}, {3, 4}, {7, 7}, {2, 2}, {8, 8}, {1, 1}, {9, 9}, {0, 0}}));
+}
+
+TEST(CachePredictionTest, FastPlaybackCachesShownFramesFirst)
+{
+  const auto state = createState(0, 4);
+
+  EXPECT_EQ(getExpectedAccessTime(0, indexRange(0, 20), state), 0);
+  EXPECT_EQ(getExpectedAccessTime(8, indexRange(0, 20), state), 2);
+  EXPECT_GT(getExpectedAccessTime(1, indexRange(0, 20), state),
+            getExpectedAccessTime(20, indexRange(0, 20), state));
+
+  const auto segments = getFramesInExpectedAccessOrder(indexRange(0, 20), state, 3);
+  EXPECT_EQ(segments, std::vector<indexRange>({{0, 0}, {4, 4}, {8, 8}}));
+}
+
+} // namespace video::test
@@ -0,0 +1,139 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <video/FrameReorderBuffer.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+QByteArray createFrameData(const int frameIndex)
+{
+  return QByteArray(4, static_cast<char>(frameIndex));
+}
+
+TEST(FrameReorderBufferTest, FramesAddedOutOfOrderAreTakenInOrder)
+{
+  FrameReorderBuffer buffer(10, 4);
+
+  buffer.addFrame(12, createFrameData(12));
+  buffer.addFrame(11, createFrameData(11));
+  buffer.addFrame(10, createFrameData(10));
+  EXPECT_EQ(buffer.getNumberBufferedFrames(), 3);
+
+  for (int frameIndex = 10; frameIndex <= 12; frameIndex++)
+  {
+    const auto frame = buffer.takeNextFrame();
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->at(0), static_cast<char>(frameIndex));
+  }
+  EXPECT_EQ(buffer.getNextFrameIndex(), 13);
+  EXPECT_EQ(buffer.getNumberBufferedFrames(), 0);
+}
+
+TEST(FrameReorderBufferTest, AbortWakesUpWaitingThreads)
+{
+  FrameReorderBuffer buffer(0, 2);
+
+  bool spaceAvailable{true};
+  bool frameTaken{true};
+  auto producer = std::thread([&]() { spaceAvailable = buffer.waitForSpace(5); });
+  auto consumer = std::thread([&]() { frameTaken = buffer.takeNextFrame().has_value(); });
+
+  buffer.abort();
+  producer.join();
+  consumer.join();
+
+  EXPECT_FALSE(spaceAvailable);
+  EXPECT_FALSE(frameTaken);
+  EXPECT_TRUE(buffer.isAborted());
+}
+
+TEST(FrameReorderBufferTest, ParallelProducersStayWithinTheWindow)
+{
+  constexpr auto NR_FRAMES    = 200;
+  constexpr auto MAX_BUFFERED = 4;
+
+  FrameReorderBuffer buffer(0, MAX_BUFFERED);
+  std::atomic_int    nextFrame{0};
+  std::atomic_int    maxBufferedFrames{0};
+
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 4; i++)
+    producers.emplace_back([&, i]() {
+      std::mt19937                       randomGenerator(i);
+      std::uniform_int_distribution<int> delay(0, 200);
+      while (true)
+      {
+        const auto frameIndex = nextFrame++;
+        if (frameIndex >= NR_FRAMES || !buffer.waitForSpace(frameIndex))
+          return;
+        std::this_thread::sleep_for(std::chrono::microseconds(delay(randomGenerator)));
+        buffer.addFrame(frameIndex, createFrameData(frameIndex));
+
+        auto bufferedFrames = buffer.getNumberBufferedFrames();
+        auto currentMax     = maxBufferedFrames.load();
+        while (bufferedFrames > currentMax &&
+               !maxBufferedFrames.compare_exchange_weak(currentMax, bufferedFrames))
+          ;
+      }
+    });
+
+  for (int frameIndex = 0; frameIndex < NR_FRAMES; frameIndex++)
+  {
+    const auto frame = buffer.takeNextFrame();
+    EXPECT_TRUE(frame);
+    if (!frame)
+      break;
+    EXPECT_EQ(frame->at(0), static_cast<char>(frameIndex));
+  }
+
+  // All producers are done. If a frame was missing, this wakes them up.
+  buffer.abort();
+  for (auto &producer : producers)
+    producer.join();
+  EXPECT_LE(maxBufferedFrames.load(), MAX_BUFFERED);
+}
+
+} // namespace
+
+} // namespace video::test
@@ -0,0 +1,149 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <chrono>
+#include <thread>
+
+#include <QThreadPool>
+
+#include <video/ImageComposition.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+// Overlapping items so that the drawing order matters. The first items take the longest to load
+// so that they finish last when they are loaded in parallel.
+std::vector<ComposedItem> createItems()
+{
+  const QList<QRect>  rects  = {QRect(-8, -4, 32, 16), QRect(0, 0, 32, 16), QRect(16, 8, 8, 8)};
+  const QList<QColor> colors = {Qt::red, Qt::green, Qt::blue};
+
+  std::vector<ComposedItem> items;
+  for (int i = 0; i < rects.size(); i++)
+  {
+    const auto size     = rects[i].size();
+    const auto color    = colors[i];
+    const auto delay    = std::chrono::milliseconds(10 * (rects.size() - i));
+    const auto pattern  = i * 32;
+    const auto loadItem = [=]() {
+      std::this_thread::sleep_for(delay);
+      QImage image(size, QImage::Format_ARGB32_Premultiplied);
+      image.fill(color);
+      // A pattern per item so that the images are not just plain colors
+      for (int x = 0; x < size.width(); x += 2)
+        image.setPixel(x, 0, qRgb(pattern, x, 255 - pattern));
+      return image;
+    };
+    items.push_back({rects[i], loadItem});
+  }
+  return items;
+}
+
+const auto COMPOSED_RECT = QRect(-8, -4, 40, 24);
+
+TEST(ImageCompositionTest, ParallelLoadingEqualsSerialComposition)
+{
+  const auto items = createItems();
+
+  QThreadPool threadPool;
+  threadPool.setMaxThreadCount(int(items.size()));
+
+  const auto serial   = composeImage(COMPOSED_RECT, items, nullptr);
+  const auto parallel = composeImage(COMPOSED_RECT, items, &threadPool);
+
+  ASSERT_FALSE(serial.isNull());
+  EXPECT_EQ(serial.size(), COMPOSED_RECT.size());
+  EXPECT_EQ(parallel, serial);
+
+  // The last item is drawn on top and areas outside of all items stay transparent
+  EXPECT_EQ(QColor(serial.pixel(24 + 1, 12 + 1)), QColor(Qt::blue));
+  EXPECT_EQ(qAlpha(serial.pixel(39, 0)), 0);
+}
+
+TEST(ImageCompositionTest, EmptyRectGivesNullImage)
+{
+  EXPECT_TRUE(composeImage(QRect(), createItems(), nullptr).isNull());
+}
+
+TEST(ImageCompositionTest, CachedFrameEqualsSerialComposition)
+{
+  const auto items = createItems();
+
+  QThreadPool threadPool;
+  threadPool.setMaxThreadCount(2);
+
+  ComposedFrameCache cache;
+  cache.insert(3, composeImage(COMPOSED_RECT, items, &threadPool));
+
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_FALSE(cache.get(4));
+
+  const auto cachedImage = cache.get(3);
+  ASSERT_TRUE(cachedImage);
+  EXPECT_EQ(*cachedImage, composeImage(COMPOSED_RECT, items, nullptr));
+}
+
+TEST(ImageCompositionTest, GetUpdatesLastAccess)
+{
+  ComposedFrameCache cache;
+  QImage             image(QSize(4, 4), QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::red);
+
+  cache.insert(0, image);
+  cache.insert(1, image);
+  cache.insert(2, image);
+  EXPECT_LT(cache.getLastAccess(0), cache.getLastAccess(1));
+  EXPECT_LT(cache.getLastAccess(1), cache.getLastAccess(2));
+
+  // Frame 0 is now the most recently used one and frame 1 the least recently used one
+  EXPECT_TRUE(cache.get(0));
+  EXPECT_GT(cache.getLastAccess(0), cache.getLastAccess(2));
+  EXPECT_LT(cache.getLastAccess(1), cache.getLastAccess(2));
+
+  cache.remove(1);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.getLastAccess(1), 0u);
+  EXPECT_EQ(cache.getFrameIndices(), QList<int>({0, 2}));
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+} // namespace
+
+} // namespace video::test
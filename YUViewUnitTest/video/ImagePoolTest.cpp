@@ -0,0 +1,136 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <vector>
+
+#include <video/ImagePool.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+constexpr auto IMAGE_BYTES = int64_t(16 * 8 * 4);
+
+TEST(ImagePoolTest, ReleasedImageIsReused)
+{
+  ImagePool pool;
+
+  auto       image = pool.acquire(QSize(16, 8), QImage::Format_RGB32);
+  const auto bits  = image.constBits();
+  pool.release(image);
+  EXPECT_TRUE(image.isNull());
+
+  const auto reusedImage = pool.acquire(QSize(16, 8), QImage::Format_RGB32);
+  EXPECT_EQ(reusedImage.constBits(), bits);
+
+  const auto counters = pool.getCounters();
+  EXPECT_EQ(counters.allocations, 1u);
+  EXPECT_EQ(counters.reuses, 1u);
+  EXPECT_EQ(counters.nrPooledImages, 0u);
+}
+
+TEST(ImagePoolTest, SizeAndFormatMustMatch)
+{
+  ImagePool pool;
+
+  auto image = pool.acquire(QSize(16, 8), QImage::Format_RGB32);
+  pool.release(image);
+
+  const auto otherSize   = pool.acquire(QSize(8, 16), QImage::Format_RGB32);
+  const auto otherFormat = pool.acquire(QSize(16, 8), QImage::Format_ARGB32);
+  EXPECT_EQ(otherFormat.format(), QImage::Format_ARGB32);
+
+  const auto counters = pool.getCounters();
+  EXPECT_EQ(counters.allocations, 3u);
+  EXPECT_EQ(counters.reuses, 0u);
+  EXPECT_EQ(counters.nrPooledImages, 1u);
+  EXPECT_EQ(counters.pooledBytes, IMAGE_BYTES);
+}
+
+TEST(ImagePoolTest, SharedImagesAreNotPooled)
+{
+  ImagePool pool;
+
+  auto       image       = pool.acquire(QSize(16, 8), QImage::Format_RGB32);
+  const auto cachedImage = image;
+  pool.release(image);
+
+  const auto counters = pool.getCounters();
+  EXPECT_EQ(counters.released, 0u);
+  EXPECT_EQ(counters.notPooled, 1u);
+  EXPECT_EQ(counters.nrPooledImages, 0u);
+  EXPECT_FALSE(cachedImage.isNull());
+}
+
+TEST(ImagePoolTest, ReplaceReleasesThePreviousImage)
+{
+  ImagePool pool;
+
+  auto       currentImage = pool.acquire(QSize(16, 8), QImage::Format_RGB32);
+  const auto newImage     = pool.acquire(QSize(16, 8), QImage::Format_RGB32);
+  pool.replace(currentImage, newImage);
+
+  EXPECT_EQ(currentImage.constBits(), newImage.constBits());
+  EXPECT_EQ(pool.getCounters().released, 1u);
+}
+
+TEST(ImagePoolTest, OldestImagesAreDroppedWhenFull)
+{
+  ImagePool pool(IMAGE_BYTES * 2);
+
+  auto images = std::vector<QImage>();
+  for (int i = 0; i < 3; i++)
+    images.push_back(pool.acquire(QSize(16, 8), QImage::Format_RGB32));
+  const auto newestBits = images.back().constBits();
+  for (auto &image : images)
+    pool.release(image);
+
+  auto counters = pool.getCounters();
+  EXPECT_EQ(counters.released, 3u);
+  EXPECT_EQ(counters.nrPooledImages, 2u);
+  EXPECT_EQ(counters.pooledBytes, IMAGE_BYTES * 2);
+
+  EXPECT_EQ(pool.acquire(QSize(16, 8), QImage::Format_RGB32).constBits(), newestBits);
+
+  pool.setMaxBytes(0);
+  counters = pool.getCounters();
+  EXPECT_EQ(counters.nrPooledImages, 0u);
+  EXPECT_EQ(counters.pooledBytes, 0);
+}
+
+} // namespace
+
+} // namespace video::test
@@ -0,0 +1,243 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <vector>
+
+#include <video/PixelFormatConverter.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+using yuv::PackingOrder;
+using yuv::PixelFormatYUV;
+using yuv::PlaneOrder;
+using yuv::Subsampling;
+
+QByteArray createFrame(const int64_t nrBytes)
+{
+  QByteArray data(int(nrBytes), char(0));
+  for (int i = 0; i < data.size(); i++)
+    data[i] = char((i * 7 + 3) % 251);
+  return data;
+}
+
+// Create a frame with 16 bit little endian samples that only use the lower bitDepth bits
+QByteArray createFrame16Bit(const int64_t nrBytes, const unsigned bitDepth)
+{
+  QByteArray data(int(nrBytes), char(0));
+  for (int i = 0; i < data.size() / 2; i++)
+  {
+    const auto value = (i * 37 + 11) % (1 << bitDepth);
+    data[i * 2]      = char(value & 0xff);
+    data[i * 2 + 1]  = char(value >> 8);
+  }
+  return data;
+}
+
+unsigned getByte(const QByteArray &data, const int index)
+{
+  return static_cast<unsigned char>(data.at(index));
+}
+
+QByteArray convert(const QByteArray     &data,
+                   const RawPixelFormat &sourceFormat,
+                   const RawPixelFormat &targetFormat,
+                   const Size            frameSize)
+{
+  const auto converter = PixelFormatConverter(sourceFormat, targetFormat, frameSize);
+  EXPECT_TRUE(converter.isValid()) << converter.getErrorMessage().toStdString();
+  return converter.convertFrame(data);
+}
+
+TEST(PixelFormatConverterTest, RoundTripPlanarToSemiPlanarAndPacked)
+{
+  const auto frameSize = Size(8, 6);
+  const auto planar    = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto nv12 =
+      PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV, false, Offset(), true);
+  const auto uyvy = PixelFormatYUV(Subsampling::YUV_422, 8, PackingOrder::UYVY);
+
+  const auto original = createFrame(planar.bytesPerFrame(frameSize));
+
+  const auto semiPlanar = convert(original, planar, nv12, frameSize);
+  ASSERT_EQ(semiPlanar.size(), original.size());
+  // The first chroma value of the NV12 plane is U followed by V
+  EXPECT_EQ(getByte(semiPlanar, 48), getByte(original, 48));
+  EXPECT_EQ(getByte(semiPlanar, 49), getByte(original, 48 + 12));
+  EXPECT_EQ(convert(semiPlanar, nv12, planar, frameSize), original);
+
+  // Upsampling to 4:2:2 repeats the chroma rows. Averaging them again is lossless.
+  const auto packed = convert(original, planar, uyvy, frameSize);
+  ASSERT_EQ(packed.size(), 8 * 6 * 2);
+  EXPECT_EQ(getByte(packed, 0), getByte(original, 48));
+  EXPECT_EQ(getByte(packed, 1), getByte(original, 0));
+  EXPECT_EQ(getByte(packed, 2), getByte(original, 48 + 12));
+  EXPECT_EQ(getByte(packed, 3), getByte(original, 1));
+  EXPECT_EQ(getByte(packed, 16), getByte(original, 48));
+  EXPECT_EQ(convert(packed, uyvy, planar, frameSize), original);
+}
+
+TEST(PixelFormatConverterTest, EndiannessAndBitDepth)
+{
+  const auto frameSize    = Size(4, 2);
+  const auto littleEndian = PixelFormatYUV(Subsampling::YUV_444, 10);
+  const auto bigEndian    = PixelFormatYUV(Subsampling::YUV_444, 10, PlaneOrder::YUV, true);
+  const auto eightBit     = PixelFormatYUV(Subsampling::YUV_444, 8);
+
+  const auto original = createFrame16Bit(littleEndian.bytesPerFrame(frameSize), 10);
+
+  const auto swapped = convert(original, littleEndian, bigEndian, frameSize);
+  ASSERT_EQ(swapped.size(), original.size());
+  for (int i = 0; i < original.size(); i += 2)
+  {
+    EXPECT_EQ(getByte(swapped, i), getByte(original, i + 1));
+    EXPECT_EQ(getByte(swapped, i + 1), getByte(original, i));
+  }
+
+  const auto reduced = convert(original, littleEndian, eightBit, frameSize);
+  ASSERT_EQ(reduced.size(), original.size() / 2);
+  for (int i = 0; i < reduced.size(); i++)
+  {
+    const auto value = getByte(original, i * 2) + (getByte(original, i * 2 + 1) << 8);
+    EXPECT_EQ(getByte(reduced, i), std::min((value + 2) >> 2, 255u));
+  }
+
+  const auto expanded = convert(reduced, eightBit, littleEndian, frameSize);
+  EXPECT_EQ(getByte(expanded, 0) + (getByte(expanded, 1) << 8), getByte(reduced, 0) << 2);
+}
+
+TEST(PixelFormatConverterTest, RoundTripV210AndBytePacking)
+{
+  const auto frameSize  = Size(12, 2);
+  const auto planar     = PixelFormatYUV(Subsampling::YUV_422, 10);
+  const auto v210       = PixelFormatYUV(yuv::PredefinedPixelFormat::V210);
+  const auto bytePacked = PixelFormatYUV(Subsampling::YUV_422, 10, PackingOrder::UYVY, true);
+
+  const auto original = createFrame16Bit(planar.bytesPerFrame(frameSize), 10);
+
+  const auto packedV210 = convert(original, planar, v210, frameSize);
+  ASSERT_EQ(packedV210.size(), v210.bytesPerFrame(frameSize));
+  // The first 32 bit word contains Cb0, Y0 and Cr0
+  const auto word = getByte(packedV210, 0) | (getByte(packedV210, 1) << 8) |
+                    (getByte(packedV210, 2) << 16) | (getByte(packedV210, 3) << 24);
+  const auto sample = [&original](const int i) {
+    return getByte(original, i * 2) | (getByte(original, i * 2 + 1) << 8);
+  };
+  EXPECT_EQ(word & 0x3ff, sample(24));
+  EXPECT_EQ((word >> 10) & 0x3ff, sample(0));
+  EXPECT_EQ((word >> 20) & 0x3ff, sample(36));
+  EXPECT_EQ(convert(packedV210, v210, planar, frameSize), original);
+
+  const auto packedBytes = convert(original, planar, bytePacked, frameSize);
+  ASSERT_EQ(packedBytes.size(), 12 * 2 / 2 * 5);
+  EXPECT_EQ(convert(packedBytes, bytePacked, planar, frameSize), original);
+}
+
+TEST(PixelFormatConverterTest, ChromaUpAndDownsampling)
+{
+  const auto frameSize = Size(2, 2);
+  const auto yuv420    = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto yuv444    = PixelFormatYUV(Subsampling::YUV_444, 8);
+  const auto yuv400    = PixelFormatYUV(Subsampling::YUV_400, 8);
+
+  const auto original  = QByteArray("\x01\x02\x03\x04\x50\x60", 6);
+  const auto upsampled = convert(original, yuv420, yuv444, frameSize);
+  EXPECT_EQ(upsampled, QByteArray("\x01\x02\x03\x04\x50\x50\x50\x50\x60\x60\x60\x60", 12));
+
+  const auto full        = QByteArray("\x01\x02\x03\x04\x10\x20\x30\x41\x00\x00\x02\x02", 12);
+  const auto downsampled = convert(full, yuv444, yuv420, frameSize);
+  EXPECT_EQ(downsampled, QByteArray("\x01\x02\x03\x04\x28\x01", 6));
+
+  EXPECT_EQ(convert(original, yuv420, yuv400, frameSize), original.mid(0, 4));
+  EXPECT_EQ(convert(original.mid(0, 4), yuv400, yuv420, frameSize),
+            QByteArray("\x01\x02\x03\x04\x80\x80", 6));
+}
+
+TEST(PixelFormatConverterTest, RGBChannelOrderAndAlpha)
+{
+  const auto frameSize = Size(2, 1);
+  const auto rgb       = rgb::PixelFormatRGB(8, DataLayout::Packed, rgb::ChannelOrder::RGB);
+  const auto bgraPlanar =
+      rgb::PixelFormatRGB(8, DataLayout::Planar, rgb::ChannelOrder::BGR, rgb::AlphaMode::Last);
+
+  const auto original  = QByteArray("\x01\x02\x03\x04\x05\x06", 6);
+  const auto converted = convert(original, rgb, bgraPlanar, frameSize);
+  EXPECT_EQ(converted, QByteArray("\x03\x06\x02\x05\x01\x04\xff\xff", 8));
+  EXPECT_EQ(convert(converted, bgraPlanar, rgb, frameSize), original);
+}
+
+TEST(PixelFormatConverterTest, InvalidConversions)
+{
+  const auto yuv420 = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto rgb    = rgb::PixelFormatRGB(8, DataLayout::Packed, rgb::ChannelOrder::RGB);
+
+  EXPECT_FALSE(PixelFormatConverter(yuv420, rgb, Size(4, 4)).isValid());
+  EXPECT_FALSE(PixelFormatConverter(yuv420, yuv420, Size(3, 4)).isValid());
+  EXPECT_FALSE(PixelFormatConverter(yuv420, PixelFormatYUV(), Size(4, 4)).isValid());
+  EXPECT_TRUE(PixelFormatConverter(yuv420, PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YVU),
+                                   Size(4, 4))
+                  .isValid());
+}
+
+TEST(PixelFormatConverterTest, ChunksOfRowsAreReadSeparately)
+{
+  const auto frameSize = Size(16, 32);
+  const auto planar    = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto yuyv      = PixelFormatYUV(Subsampling::YUV_422, 8, PackingOrder::YUYV);
+
+  const auto original  = createFrame(planar.bytesPerFrame(frameSize));
+  const auto converter = PixelFormatConverter(planar, yuyv, frameSize, 8);
+
+  int64_t    maxReadSize = 0;
+  QByteArray target(int(converter.getTargetBytesPerFrame()), char(0));
+  const auto success = converter.convertFrame(
+      [&](int64_t position, int64_t nrBytes) {
+        maxReadSize = std::max(maxReadSize, nrBytes);
+        return original.mid(int(position), int(nrBytes));
+      },
+      [&](int64_t position, const QByteArray &data) {
+        std::copy(data.constData(), data.constData() + data.size(), target.data() + position);
+        return true;
+      });
+  ASSERT_TRUE(success);
+  EXPECT_EQ(maxReadSize, 16 * 8);
+  EXPECT_EQ(target, PixelFormatConverter(planar, yuyv, frameSize, 32).convertFrame(original));
+}
+
+} // namespace
+
+} // namespace video::test
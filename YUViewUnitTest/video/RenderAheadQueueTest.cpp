@@ -0,0 +1,120 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/RenderAheadQueue.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+QImage createImage()
+{
+  return QImage(QSize(16, 8), QImage::Format_RGB32);
+}
+
+TEST(RenderAheadQueueTest, TakeDropsSkippedFrames)
+{
+  RenderAheadQueue queue(4);
+  for (int frameIndex = 10; frameIndex < 14; frameIndex++)
+    queue.push(frameIndex, createImage());
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 4);
+  EXPECT_EQ(queue.getUsedBytes(), int64_t(4 * 16 * 8 * 4));
+
+  EXPECT_TRUE(queue.take(10));
+  EXPECT_FALSE(queue.contains(10));
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 3);
+
+  // Frame 11 was skipped by playback
+  EXPECT_TRUE(queue.take(12));
+  EXPECT_FALSE(queue.contains(11));
+  EXPECT_TRUE(queue.contains(13));
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 1);
+
+  EXPECT_FALSE(queue.take(20));
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 1);
+
+  queue.clear();
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 0);
+  EXPECT_EQ(queue.getUsedBytes(), 0);
+}
+
+TEST(RenderAheadQueueTest, FullQueueDropsOldestFrame)
+{
+  RenderAheadQueue queue(2);
+  queue.push(0, createImage());
+  queue.push(1, createImage());
+  queue.push(1, createImage());
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 2);
+
+  queue.push(2, createImage());
+  EXPECT_FALSE(queue.contains(0));
+  EXPECT_TRUE(queue.contains(1));
+  EXPECT_TRUE(queue.contains(2));
+}
+
+TEST(RenderAheadQueueTest, RemoveFramesFromKeepsTheLowerFrames)
+{
+  RenderAheadQueue queue(4);
+  for (int frameIndex = 10; frameIndex < 14; frameIndex++)
+    queue.push(frameIndex, createImage());
+
+  queue.removeFramesFrom(12);
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 2);
+  EXPECT_TRUE(queue.contains(11));
+  EXPECT_FALSE(queue.contains(12));
+  EXPECT_FALSE(queue.contains(13));
+}
+
+TEST(RenderAheadQueueTest, SetCapacity)
+{
+  RenderAheadQueue queue;
+  EXPECT_EQ(queue.getCapacity(), RenderAheadQueue::DEFAULT_CAPACITY);
+  for (int frameIndex = 0; frameIndex < 4; frameIndex++)
+    queue.push(frameIndex, createImage());
+
+  queue.setCapacity(1);
+  EXPECT_EQ(queue.getNumberQueuedFrames(), 1);
+  EXPECT_TRUE(queue.contains(3));
+
+  queue.setCapacity(0);
+  EXPECT_EQ(queue.getCapacity(), 1u);
+  queue.setCapacity(1000);
+  EXPECT_EQ(queue.getCapacity(), RenderAheadQueue::MAX_CAPACITY);
+}
+
+} // namespace
+
+} // namespace video::test
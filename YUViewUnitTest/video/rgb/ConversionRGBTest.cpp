@@ -288,4 +288,22 @@ TEST(ConversionRGBTest, TestConversionOfSinglePlaneToRGBA)
   runTestForAllParameters(testConversionToRGBASinglePlane);
 }
 
+TEST(ConversionRGBTest, TestConversionFromARGB)
+{
+  const std::array<uint32_t, 2> argb      = {0x80ff4000, 0xff0010ff};
+  const auto                    data      = reinterpret_cast<const unsigned char *>(argb.data());
+  const auto                    frameSize = Size(2, 1);
+
+  const auto bgra   = PixelFormatRGB(8, DataLayout::Packed, ChannelOrder::BGR, AlphaMode::Last);
+  const auto packed = convertARGBToInputRGB(data, 8, frameSize, bgra);
+  EXPECT_EQ(packed, QByteArray("\x00\x40\xff\x80\xff\x10\x00\xff", 8));
+
+  const auto rgb16BigEndianPlanar =
+      PixelFormatRGB(16, DataLayout::Planar, ChannelOrder::RGB, AlphaMode::None, Endianness::Big);
+  const auto planar16 = convertARGBToInputRGB(data, 8, frameSize, rgb16BigEndianPlanar);
+  EXPECT_EQ(planar16, QByteArray("\xff\xff\x00\x00\x40\x40\x10\x10\x00\x00\xff\xff", 12));
+
+  EXPECT_TRUE(convertARGBToInputRGB(data, 8, frameSize, PixelFormatRGB()).isEmpty());
+}
+
 } // namespace video::rgb::test
@@ -0,0 +1,149 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <cmath>
+#include <random>
+
+#include <video/rgb/PixelFormatRGBDetection.h>
+
+namespace video::rgb::test
+{
+
+namespace
+{
+
+// A smooth pattern per channel that moves a bit from frame to frame plus some noise
+QByteArray generateFrames(const Size &size, const PixelFormatRGB &format, const int nrFrames)
+{
+  std::mt19937                       randomGenerator(42);
+  std::uniform_int_distribution<int> noise(-2, 2);
+
+  const auto bytesPerSample = (format.getBitsPerSample() + 7) / 8;
+  const auto maxValue       = (1 << format.getBitsPerSample()) - 1;
+  const auto scale          = double(1 << (format.getBitsPerSample() - 8));
+  const auto nrChannels     = int(format.nrChannels());
+
+  QByteArray data;
+  auto       appendSample = [&](double value) {
+    const auto sample = std::clamp(int(value * scale) + noise(randomGenerator), 0, maxValue);
+    data.append(char(sample & 0xff));
+    if (bytesPerSample == 2)
+      data.append(char(sample >> 8));
+  };
+  auto getValue = [](int x, int y, int channel, int frame) {
+    return 128 + 60 * std::sin(x * 0.05 + frame * 0.1 + channel) * std::cos(y * 0.07) +
+           30 * std::sin(x * 0.013 + y * 0.021);
+  };
+
+  for (int frame = 0; frame < nrFrames; frame++)
+  {
+    if (format.getDataLayout() == DataLayout::Packed)
+    {
+      for (int y = 0; y < int(size.height); y++)
+        for (int x = 0; x < int(size.width); x++)
+          for (int channel = 0; channel < nrChannels; channel++)
+            appendSample(getValue(x, y, channel, frame));
+    }
+    else
+    {
+      for (int channel = 0; channel < nrChannels; channel++)
+        for (int y = 0; y < int(size.height); y++)
+          for (int x = 0; x < int(size.width); x++)
+            appendSample(getValue(x, y, channel, frame));
+    }
+  }
+  return data;
+}
+
+ReadBytesFunction getReadFunction(const QByteArray &data)
+{
+  return [&data](int64_t position, int64_t nrBytes) {
+    if (position >= data.size())
+      return QByteArray();
+    return data.mid(int(position), int(std::min(nrBytes, data.size() - position)));
+  };
+}
+
+} // namespace
+
+TEST(PixelFormatRGBDetectionTest, DetectCommonPackedFormat)
+{
+  const PixelFormatRGB format(8, DataLayout::Packed, ChannelOrder::RGB);
+  const auto           size = Size(352, 288);
+  const auto           data = generateFrames(size, format, 3);
+
+  const auto detected = detectFormatFromData(getReadFunction(data), data.size());
+  ASSERT_TRUE(detected);
+  EXPECT_EQ(detected->frameSize, size);
+  EXPECT_EQ(detected->pixelFormat, format);
+  EXPECT_GT(detected->confidence, 0.5);
+}
+
+TEST(PixelFormatRGBDetectionTest, DetectPackedFormatWithAlpha)
+{
+  const PixelFormatRGB format(8, DataLayout::Packed, ChannelOrder::RGB, AlphaMode::Last);
+  const auto           size = Size(352, 288);
+  const auto           data = generateFrames(size, format, 3);
+
+  const auto detected = detectFormatFromData(getReadFunction(data), data.size());
+  ASSERT_TRUE(detected);
+  EXPECT_EQ(detected->frameSize, size);
+  EXPECT_EQ(detected->pixelFormat, format);
+}
+
+TEST(PixelFormatRGBDetectionTest, DetectPlanarNonStandardSizeAndHighBitDepth)
+{
+  const PixelFormatRGB format(10, DataLayout::Planar, ChannelOrder::RGB);
+  const auto           size = Size(200, 120);
+  const auto           data = generateFrames(size, format, 3);
+
+  const auto detected = detectFormatFromData(getReadFunction(data), data.size());
+  ASSERT_TRUE(detected);
+  EXPECT_EQ(detected->frameSize, size);
+  EXPECT_EQ(detected->pixelFormat, format);
+}
+
+TEST(PixelFormatRGBDetectionTest, RandomDataIsNotDetected)
+{
+  std::mt19937                       randomGenerator(42);
+  std::uniform_int_distribution<int> distribution(0, 255);
+
+  QByteArray data;
+  for (int i = 0; i < 352 * 288 * 3 * 3; i++)
+    data.append(char(distribution(randomGenerator)));
+
+  EXPECT_FALSE(detectFormatFromData(getReadFunction(data), data.size()));
+}
+
+} // namespace video::rgb::test
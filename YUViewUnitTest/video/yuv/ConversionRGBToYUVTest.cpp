@@ -0,0 +1,144 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <vector>
+
+#include <video/yuv/ConversionRGBToYUV.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+constexpr uint32_t WHITE = 0xffffffff;
+constexpr uint32_t BLACK = 0xff000000;
+constexpr uint32_t RED   = 0xffff0000;
+constexpr uint32_t BLUE  = 0xff0000ff;
+
+QByteArray convert(const std::vector<uint32_t> &argb,
+                   const Size                   frameSize,
+                   const PixelFormatYUV        &format,
+                   const ColorConversion conversion = ColorConversion::BT709_LimitedRange)
+{
+  return convertARGBToYUV(reinterpret_cast<const unsigned char *>(argb.data()),
+                          int(frameSize.width * 4),
+                          frameSize,
+                          format,
+                          conversion);
+}
+
+unsigned getSample(const QByteArray &data, const int index, const bool twoBytes, bool bigEndian)
+{
+  if (!twoBytes)
+    return static_cast<unsigned char>(data.at(index));
+  const auto first  = static_cast<unsigned char>(data.at(index * 2));
+  const auto second = static_cast<unsigned char>(data.at(index * 2 + 1));
+  return bigEndian ? (first << 8) + second : (second << 8) + first;
+}
+
+TEST(ConversionRGBToYUVTest, LimitedRangeValuesOfPlanar420)
+{
+  // 2x2 block of white and black averages to mid grey in the chroma components
+  const auto format = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto data   = convert({WHITE, BLACK, BLACK, WHITE}, Size(2, 2), format);
+  ASSERT_EQ(data.size(), 6);
+  EXPECT_EQ(getSample(data, 0, false, false), 235u);
+  EXPECT_EQ(getSample(data, 1, false, false), 16u);
+  EXPECT_EQ(getSample(data, 2, false, false), 16u);
+  EXPECT_EQ(getSample(data, 3, false, false), 235u);
+  EXPECT_EQ(getSample(data, 4, false, false), 128u);
+  EXPECT_EQ(getSample(data, 5, false, false), 128u);
+}
+
+TEST(ConversionRGBToYUVTest, ColorsAndPlaneOrderOf444)
+{
+  // BT709 limited range: Red is (63, 102, 240), blue is (32, 240, 118)
+  const auto format = PixelFormatYUV(Subsampling::YUV_444, 8, PlaneOrder::YVU);
+  const auto data   = convert({RED, BLUE}, Size(2, 1), format);
+  ASSERT_EQ(data.size(), 6);
+  const auto expected = std::vector<unsigned>({63, 32, 240, 118, 102, 240});
+  for (int i = 0; i < 6; i++)
+    EXPECT_EQ(getSample(data, i, false, false), expected[i]) << "Sample " << i;
+}
+
+TEST(ConversionRGBToYUVTest, HighBitDepthFullRangeAndEndianness)
+{
+  const auto littleEndian = PixelFormatYUV(Subsampling::YUV_400, 10);
+  const auto bigEndian    = PixelFormatYUV(Subsampling::YUV_400, 10, PlaneOrder::YUV, true);
+
+  const auto dataLE = convert({WHITE, BLACK}, Size(2, 1), littleEndian);
+  ASSERT_EQ(dataLE.size(), 4);
+  EXPECT_EQ(getSample(dataLE, 0, true, false), 940u);
+  EXPECT_EQ(getSample(dataLE, 1, true, false), 64u);
+
+  const auto dataBE =
+      convert({WHITE, BLACK}, Size(2, 1), bigEndian, ColorConversion::BT709_FullRange);
+  ASSERT_EQ(dataBE.size(), 4);
+  EXPECT_EQ(getSample(dataBE, 0, true, true), 1023u);
+  EXPECT_EQ(getSample(dataBE, 1, true, true), 0u);
+}
+
+TEST(ConversionRGBToYUVTest, PackedAndInterleavedLayouts)
+{
+  const auto uyvy = PixelFormatYUV(Subsampling::YUV_422, 8, PackingOrder::UYVY);
+  const auto data = convert({WHITE, BLACK}, Size(2, 1), uyvy);
+  ASSERT_EQ(data.size(), 4);
+  EXPECT_EQ(getSample(data, 0, false, false), 128u);
+  EXPECT_EQ(getSample(data, 1, false, false), 235u);
+  EXPECT_EQ(getSample(data, 2, false, false), 128u);
+  EXPECT_EQ(getSample(data, 3, false, false), 16u);
+
+  // NV12 like: Y plane followed by interleaved U and V
+  const auto nv12 = PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV, false, {}, true);
+  const auto nv12Data = convert({BLUE, BLUE, BLUE, BLUE}, Size(2, 2), nv12);
+  ASSERT_EQ(nv12Data.size(), 6);
+  EXPECT_EQ(getSample(nv12Data, 4, false, false), 240u);
+  EXPECT_EQ(getSample(nv12Data, 5, false, false), 118u);
+}
+
+TEST(ConversionRGBToYUVTest, UnsupportedFormats)
+{
+  std::string whyNot;
+  EXPECT_FALSE(canConvertARGBToYUV(PixelFormatYUV(PredefinedPixelFormat::V210), Size(48, 2)));
+  EXPECT_FALSE(
+      canConvertARGBToYUV(PixelFormatYUV(Subsampling::YUV_420, 8), Size(3, 2), &whyNot));
+  EXPECT_FALSE(whyNot.empty());
+  EXPECT_TRUE(convert({WHITE, WHITE, WHITE}, Size(3, 1), PixelFormatYUV(Subsampling::YUV_420, 8))
+                  .isEmpty());
+}
+
+} // namespace
+
+} // namespace video::yuv::test
@@ -0,0 +1,138 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <cmath>
+#include <random>
+
+#include <video/yuv/PixelFormatYUVDetection.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+// A smooth pattern that moves a bit from frame to frame plus some noise
+QByteArray generateFrames(const Size &size, const PixelFormatYUV &format, const int nrFrames)
+{
+  std::mt19937                       randomGenerator(42);
+  std::uniform_int_distribution<int> noise(-2, 2);
+
+  const auto bytesPerSample = (format.getBitsPerSample() + 7) / 8;
+  const auto maxValue       = (1 << format.getBitsPerSample()) - 1;
+  const auto scale          = double(1 << (format.getBitsPerSample() - 8));
+
+  QByteArray data;
+  auto       appendSample = [&](double value) {
+    const auto sample = std::clamp(int(value * scale) + noise(randomGenerator), 0, maxValue);
+    data.append(char(sample & 0xff));
+    if (bytesPerSample == 2)
+      data.append(char(sample >> 8));
+  };
+
+  const auto chromaWidth  = int(size.width) / format.getSubsamplingHor();
+  const auto chromaHeight = int(size.height) / format.getSubsamplingVer();
+  for (int frame = 0; frame < nrFrames; frame++)
+  {
+    for (int y = 0; y < int(size.height); y++)
+      for (int x = 0; x < int(size.width); x++)
+        appendSample(128 + 60 * std::sin(x * 0.05 + frame * 0.1) * std::cos(y * 0.07) +
+                     30 * std::sin(x * 0.013 + y * 0.021));
+    for (int plane = 0; plane < 2; plane++)
+      for (int y = 0; y < chromaHeight; y++)
+        for (int x = 0; x < chromaWidth; x++)
+          appendSample(128 + 20 * std::sin(x * 0.09 + plane) * std::cos(y * 0.05 + frame * 0.1));
+  }
+  return data;
+}
+
+ReadBytesFunction getReadFunction(const QByteArray &data)
+{
+  return [&data](int64_t position, int64_t nrBytes) {
+    if (position >= data.size())
+      return QByteArray();
+    return data.mid(int(position), int(std::min(nrBytes, data.size() - position)));
+  };
+}
+
+} // namespace
+
+TEST(PixelFormatYUVDetectionTest, DetectLumaWidthOfNonStandardWidth)
+{
+  const PixelFormatYUV format(Subsampling::YUV_420, 8, PlaneOrder::YUV);
+  const auto           data = generateFrames(Size(200, 120), format, 1);
+
+  const auto width = detectLumaWidth(data, 1);
+  ASSERT_TRUE(width);
+  EXPECT_EQ(*width, 200);
+}
+
+TEST(PixelFormatYUVDetectionTest, DetectCommonFormat)
+{
+  const PixelFormatYUV format(Subsampling::YUV_420, 8, PlaneOrder::YUV);
+  const auto           size = Size(352, 288);
+  const auto           data = generateFrames(size, format, 3);
+
+  const auto detected = detectFormatFromData(getReadFunction(data), data.size());
+  ASSERT_TRUE(detected);
+  EXPECT_EQ(detected->frameSize, size);
+  EXPECT_EQ(detected->pixelFormat, format);
+  EXPECT_GT(detected->confidence, 0.5);
+}
+
+TEST(PixelFormatYUVDetectionTest, DetectNonStandardSizeAndHighBitDepth)
+{
+  const PixelFormatYUV format(Subsampling::YUV_420, 10, PlaneOrder::YUV);
+  const auto           size = Size(200, 120);
+  const auto           data = generateFrames(size, format, 3);
+
+  const auto detected = detectFormatFromData(getReadFunction(data), data.size());
+  ASSERT_TRUE(detected);
+  EXPECT_EQ(detected->frameSize, size);
+  EXPECT_EQ(detected->pixelFormat, format);
+}
+
+TEST(PixelFormatYUVDetectionTest, RandomDataIsNotDetected)
+{
+  std::mt19937                       randomGenerator(42);
+  std::uniform_int_distribution<int> distribution(0, 255);
+
+  QByteArray data;
+  for (int i = 0; i < 352 * 288 * 3 / 2 * 3; i++)
+    data.append(char(distribution(randomGenerator)));
+
+  EXPECT_FALSE(detectFormatFromData(getReadFunction(data), data.size()));
+}
+
+} // namespace video::yuv::test